@@ -44,6 +44,10 @@ option(ENABLE_OPENCL "Use the OpenCL backend" ON)
 
 option(ENABLE_OPENMP "Use OpenMP acceleration" OFF)
 
+# Compiles the built-in profiler (viennacl/tools/profiler.hpp) into all
+# targets. Recording still needs to be enabled at runtime.
+option(ENABLE_PROFILING "Compile in the built-in profiler" OFF)
+
 # If you are interested in the impact of different kernel parameters on
 # performance, you may want to give ViennaProfiler a try (see
 # http://sourceforge.net/projects/viennaprofiler/) Set your connection
@@ -106,6 +110,10 @@ if (ENABLE_OPENMP)
    set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} ${OpenMP_EXE_LINKER_FLAGS}")
 endif(ENABLE_OPENMP)
 
+if (ENABLE_PROFILING)
+   set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DVIENNACL_WITH_PROFILING")
+endif(ENABLE_PROFILING)
+
 if(ENABLE_VIENNAPROFILER)
    find_package(ViennaProfiler REQUIRED)
 endif()
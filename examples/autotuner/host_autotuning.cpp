@@ -0,0 +1,307 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/*
+*   Tunes the blocking and threading parameters of the host-based kernels for the running machine.
+*   The best values found are written to a profile, which is loaded by the host backend on first use.
+*   See viennacl/linalg/host_based/tuning_profile.hpp for the location of the profile file.
+*/
+
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <map>
+
+#ifndef _WIN32
+  #include <sys/stat.h>
+#endif
+
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/lu.hpp"
+#include "viennacl/linalg/cholesky.hpp"
+#include "viennacl/linalg/qr.hpp"
+#include "viennacl/linalg/host_based/eig_operations.hpp"
+#include "viennacl/linalg/host_based/tuning_profile.hpp"
+#include "viennacl/tools/timer.hpp"
+
+#include "command-line-utils.hpp"
+
+typedef double ScalarType;
+
+using viennacl::linalg::host_based::tuning_profile;
+using viennacl::linalg::host_based::current_tuning_profile;
+
+struct autotuner_options{
+    std::string output_name;
+    unsigned int matrix_size;
+    unsigned int grid_size;
+    unsigned int n_runs;
+};
+
+autotuner_options get_options(int argc, char* argv[]){
+    try{
+        autotuner_options options;
+
+        TCLAP::CmdLine cmd("Host Autotuner", ' ', "0.1");
+
+        //Output profile file
+        TCLAP::ValueArg<std::string> output_name_arg("o","output","Name of the profile file. Defaults to the profile of the running machine",false,viennacl::linalg::host_based::default_tuning_profile_filename(),"string",cmd);
+
+        TCLAP::ValueArg<unsigned int> matrix_size_arg("","matrix-size","Size of the dense matrices used for tuning the matrix-matrix product and the factorizations",false,512,"unsigned int",cmd);
+        TCLAP::ValueArg<unsigned int> grid_size_arg("","grid-size","Grid size of the 2D Laplacian used for tuning the sparse matrix-vector product",false,512,"unsigned int",cmd);
+        TCLAP::ValueArg<unsigned int> n_runs_arg("","runs","Number of runs per configuration",false,3,"unsigned int",cmd);
+
+        cmd.parse(argc,argv);
+        options.output_name = output_name_arg.getValue();
+        options.matrix_size = matrix_size_arg.getValue();
+        options.grid_size = grid_size_arg.getValue();
+        options.n_runs = std::max(n_runs_arg.getValue(), 1u);
+        return options;
+    }
+    catch (TCLAP::ArgException &e){
+        std::cerr << "error: " << "\"" << e.error() << "\"" << " [for arg " << e.argId() << "]" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
+/** @brief Returns the best of n_runs timings of the supplied operation. The operation is executed once before for warming up. */
+template<typename OperationT>
+double benchmark(OperationT & op, unsigned int n_runs){
+    op();
+    double best_time = 0;
+    viennacl::tools::timer timer;
+    for(unsigned int r = 0 ; r < n_runs ; ++r){
+        timer.start();
+        op();
+        double time = timer.get();
+        if(r == 0 || time < best_time)
+            best_time = time;
+    }
+    return best_time;
+}
+
+/** @brief Sets each candidate value of the parameter, runs the operation, and keeps the fastest value in the profile */
+template<typename OperationT>
+std::size_t tune(std::string const & name, std::size_t tuning_profile::* parameter, std::vector<std::size_t> const & candidates, OperationT & op, unsigned int n_runs){
+    std::cout << "# " << name << std::endl;
+    tuning_profile & profile = current_tuning_profile();
+    std::size_t best_value = profile.*parameter;
+    double best_time = 0;
+    for(std::size_t i = 0 ; i < candidates.size() ; ++i){
+        profile.*parameter = candidates[i];
+        double time = benchmark(op, n_runs);
+        std::cout << "  " << candidates[i] << ": " << time << " s" << std::endl;
+        if(i == 0 || time < best_time){
+            best_time = time;
+            best_value = candidates[i];
+        }
+    }
+    profile.*parameter = best_value;
+    std::cout << "  -> " << best_value << std::endl;
+    return best_value;
+}
+
+std::vector<std::size_t> make_candidates(std::size_t const * values, std::size_t num_values){
+    return std::vector<std::size_t>(values, values + num_values);
+}
+
+//
+// Operations to be tuned
+//
+
+struct vector_operation{
+    vector_operation(std::size_t size) : x(size), y(size), z(size) { y = viennacl::scalar_vector<ScalarType>(size, 1); z = viennacl::scalar_vector<ScalarType>(size, 2); }
+    void operator()(){
+        for(unsigned int r = 0 ; r < 100 ; ++r)
+            x = y + ScalarType(2) * z;
+    }
+    viennacl::vector<ScalarType> x, y, z;
+};
+
+struct gemm_operation{
+    gemm_operation(std::size_t size) : A(size, size), B(size, size), C(size, size), At(size, size), Bt(size, size), Ct(size, size) {
+        for(std::size_t i = 0 ; i < size ; ++i)
+            for(std::size_t j = 0 ; j < size ; ++j){
+                ScalarType value = ScalarType((i * 7 + j * 3) % 11) / ScalarType(11);
+                A(i, j) = value; B(i, j) = value;
+                At(i, j) = value; Bt(i, j) = value;
+            }
+    }
+    void operator()(){
+        C = viennacl::linalg::prod(A, B);
+        Ct = viennacl::linalg::prod(At, Bt);
+    }
+    viennacl::matrix<ScalarType, viennacl::row_major> A, B, C;
+    viennacl::matrix<ScalarType, viennacl::column_major> At, Bt, Ct;
+};
+
+struct spmv_operation{
+    spmv_operation(std::size_t grid_size) : A(grid_size * grid_size, grid_size * grid_size), x(grid_size * grid_size), y(grid_size * grid_size) {
+        std::size_t n = grid_size * grid_size;
+        std::vector<std::map<unsigned int, ScalarType> > cpu_A(n);
+        for(std::size_t i = 0 ; i < grid_size ; ++i)
+            for(std::size_t j = 0 ; j < grid_size ; ++j){
+                std::size_t row = i * grid_size + j;
+                cpu_A[row][static_cast<unsigned int>(row)] = 4;
+                if(i > 0)             cpu_A[row][static_cast<unsigned int>(row - grid_size)] = -1;
+                if(i + 1 < grid_size) cpu_A[row][static_cast<unsigned int>(row + grid_size)] = -1;
+                if(j > 0)             cpu_A[row][static_cast<unsigned int>(row - 1)] = -1;
+                if(j + 1 < grid_size) cpu_A[row][static_cast<unsigned int>(row + 1)] = -1;
+            }
+        viennacl::copy(cpu_A, A);
+        x = viennacl::scalar_vector<ScalarType>(n, 1);
+    }
+    void operator()(){
+        for(unsigned int r = 0 ; r < 10 ; ++r)
+            y = viennacl::linalg::prod(A, x);
+    }
+    viennacl::compressed_matrix<ScalarType> A;
+    viennacl::vector<ScalarType> x, y;
+};
+
+template<typename MatrixType>
+void fill_diagonally_dominant(MatrixType & A){
+    for(std::size_t i = 0 ; i < A.size1() ; ++i)
+        for(std::size_t j = 0 ; j < A.size2() ; ++j)
+            A(i, j) = (i == j) ? ScalarType(A.size1()) : ScalarType((i * 7 + j * 3) % 11) / ScalarType(11);
+}
+
+struct lu_operation{
+    lu_operation(std::size_t size) : A(size, size), LU(size, size) { fill_diagonally_dominant(A); }
+    void operator()(){
+        LU = A;
+        viennacl::linalg::lu_factorize(LU);
+    }
+    viennacl::matrix<ScalarType> A, LU;
+};
+
+struct cholesky_operation{
+    cholesky_operation(std::size_t size) : A(size, size), L(size, size) { fill_diagonally_dominant(A); }
+    void operator()(){
+        L = A;
+        viennacl::linalg::cholesky_factorize(L);
+    }
+    viennacl::matrix<ScalarType> A, L;
+};
+
+struct qr_operation{
+    qr_operation(std::size_t size) : A(size, size), QR(size, size) { fill_diagonally_dominant(A); }
+    void operator()(){
+        QR = A;
+        viennacl::linalg::inplace_qr(QR);
+    }
+    viennacl::matrix<ScalarType> A, QR;
+};
+
+struct eig_operation{
+    eig_operation(std::size_t size) : A(size, size) {
+        for(std::size_t i = 0 ; i < size ; ++i)
+            for(std::size_t j = 0 ; j < size ; ++j)
+                A(i, j) = ScalarType((std::min(i, j) * 7 + std::max(i, j) * 3) % 11) / ScalarType(11);
+    }
+    void operator()(){ viennacl::linalg::host_based::eig_sym(A, D); }
+    viennacl::matrix<ScalarType, viennacl::column_major> A;
+    std::vector<ScalarType> D;
+};
+
+/** @brief Determines the smallest vector size for which the OpenMP-parallel vector operations are faster than the sequential ones */
+std::size_t tune_vector_min_size(unsigned int n_runs){
+    std::cout << "# vector_min_size" << std::endl;
+    tuning_profile & profile = current_tuning_profile();
+#ifdef VIENNACL_WITH_OPENMP
+    static const std::size_t sizes[] = {500, 1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000};
+    std::size_t num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    std::size_t best_value = sizes[num_sizes - 1];
+    for(std::size_t i = num_sizes ; i > 0 ; --i){
+        vector_operation op(sizes[i - 1]);
+        profile.vector_min_size = sizes[num_sizes - 1] + 1;
+        double sequential_time = benchmark(op, n_runs);
+        profile.vector_min_size = 0;
+        double parallel_time = benchmark(op, n_runs);
+        std::cout << "  " << sizes[i - 1] << ": " << sequential_time << " s sequential, " << parallel_time << " s parallel" << std::endl;
+        if(parallel_time >= sequential_time)
+            break;
+        best_value = sizes[i - 1];
+    }
+    profile.vector_min_size = best_value;
+#else
+    std::cout << "  not built with OpenMP, keeping the default" << std::endl;
+    (void)n_runs;
+#endif
+    std::cout << "  -> " << profile.vector_min_size << std::endl;
+    return profile.vector_min_size;
+}
+
+int main(int argc, char* argv[]){
+    autotuner_options options = get_options(argc, argv);
+
+    std::cout << "# ---- HOST AUTOTUNING ----" << std::endl;
+    if(!current_tuning_profile().filename().empty())
+        std::cout << "# Starting from " << current_tuning_profile().filename() << std::endl;
+
+    tune_vector_min_size(options.n_runs);
+
+    {
+        static const std::size_t values[] = {16, 32, 48, 64, 96, 128, 192, 256};
+        gemm_operation op(options.matrix_size);
+        tune("gemm_block_size", &tuning_profile::gemm_block_size, make_candidates(values, sizeof(values) / sizeof(values[0])), op, options.n_runs);
+    }
+#ifdef VIENNACL_WITH_OPENMP
+    {
+        static const std::size_t values[] = {0, 16, 64, 256, 1024, 4096};
+        spmv_operation op(options.grid_size);
+        tune("spmv_chunk_size", &tuning_profile::spmv_chunk_size, make_candidates(values, sizeof(values) / sizeof(values[0])), op, options.n_runs);
+    }
+#endif
+    {
+        static const std::size_t values[] = {8, 16, 32, 48, 64, 128};
+        lu_operation op(options.matrix_size);
+        tune("lu_block_size", &tuning_profile::lu_block_size, make_candidates(values, sizeof(values) / sizeof(values[0])), op, options.n_runs);
+    }
+    {
+        static const std::size_t values[] = {16, 32, 48, 64, 96, 128};
+        cholesky_operation op(options.matrix_size);
+        tune("cholesky_block_size", &tuning_profile::cholesky_block_size, make_candidates(values, sizeof(values) / sizeof(values[0])), op, options.n_runs);
+    }
+    {
+        static const std::size_t values[] = {8, 16, 32, 64};
+        qr_operation op(options.matrix_size);
+        tune("qr_block_size", &tuning_profile::qr_block_size, make_candidates(values, sizeof(values) / sizeof(values[0])), op, options.n_runs);
+    }
+    {
+        static const std::size_t values[] = {1, 4, 8, 16, 32};
+        eig_operation op(options.matrix_size);
+        tune("tred2_block_size", &tuning_profile::tred2_block_size, make_candidates(values, sizeof(values) / sizeof(values[0])), op, options.n_runs);
+    }
+
+#ifndef _WIN32
+    //create the directory of the profile, if it does not exist yet:
+    std::string::size_type pos = options.output_name.rfind('/');
+    if(pos != std::string::npos && pos > 0)
+        mkdir(options.output_name.substr(0, pos).c_str(), 0755);
+#endif
+    if(!current_tuning_profile().save(options.output_name)){
+        std::cerr << "error: cannot write " << options.output_name << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "# Profile written to " << options.output_name << std::endl;
+    return EXIT_SUCCESS;
+}
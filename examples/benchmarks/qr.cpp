@@ -9,100 +9,162 @@
                             -----------------
 
    Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
-               
+
    (A list of authors and contributors can be found in the PDF manual)
 
    License:         MIT (X11), see file LICENSE in the base directory
 ============================================================================= */
 
-#define VIENNACL_WITH_UBLAS
+/*
+*
+*   Benchmark: QR factorization of tall-skinny matrices, blocked Householder QR (inplace_qr) versus TSQR
+*
+*/
+
+//disable debug mechanisms to have a fair benchmark environment
 #ifndef NDEBUG
  #define NDEBUG
 #endif
 
-#include <utility>
+//
+// include necessary system headers
+//
 #include <iostream>
-#include <fstream>
-#include <string>
+#include <vector>
 #include <cmath>
 #include <algorithm>
-#include <stdio.h>
-#include <sys/time.h>
-#include <time.h>
-#include "benchmark-utils.hpp"
-/*#include "viennacl/scalar.hpp"
+
+//
+// ViennaCL includes
+//
 #include "viennacl/matrix.hpp"
-#include "viennacl/compressed_matrix.hpp"
-#include "viennacl/linalg/cg.hpp"
-#include "viennacl/linalg/prod.hpp"
-#include "viennacl/linalg/inner_prod.hpp"
-#include "viennacl/linalg/ilu.hpp"
-#include "viennacl/linalg/norm_2.hpp"
-#include "viennacl/io/matrix_market.hpp"*/
+#include "viennacl/vector.hpp"
 #include "viennacl/linalg/qr.hpp"
-#include "boost/numeric/ublas/vector.hpp"
-#include "boost/numeric/ublas/matrix.hpp"
-#include "boost/numeric/ublas/io.hpp"
+#include "viennacl/linalg/tsqr.hpp"
 
-           
-//typedef viennacl::compressed_matrix<float> SparseMatrix;
-using namespace boost::numeric::ublas;
-//using namespace viennacl::linalg;
+// Some helper functions for this tutorial:
+#include "../tutorial/Random.hpp"
 
 
-int main (int argc, const char * argv[])
+#include "benchmark-utils.hpp"
+
+
+template<typename ScalarType>
+void run_qr(std::size_t rows, std::size_t cols)
 {
-    typedef float               ScalarType;
-    typedef boost::numeric::ublas::matrix<ScalarType, boost::numeric::ublas::column_major>        MatrixType;
-    typedef boost::numeric::ublas::vector<ScalarType>                   VectorType;
-    Timer timer;
-    double elapsed;
-
-    std::size_t rows = 1800;
-    std::size_t cols = 1800;
-    double num_ops_qr = 2.0 * cols * cols * (rows - cols/3.0);
-    double num_ops_recovery = 4.0 * (rows*rows*cols - rows*cols*cols + cols*cols*cols);
-    
-    MatrixType A(rows, cols);
-    MatrixType Q(rows, rows);
-    MatrixType R(rows, cols);
-    
-    for (std::size_t i=0; i<rows; ++i)
-    {
-      for (std::size_t j=0; j<cols; ++j)
-      {
-        A(i,j) = 1.0 + (i + 1)*(j+1);
-        R(i,j) = 0.0;
-      }
-      for (std::size_t j=0; j<rows; ++j)
-      {
-        Q(i,j) = 0.0;
-      }
-    }
-    
-    //std::cout << "A: " << A << std::endl;
-    timer.start();
-    std::vector<ScalarType> betas = viennacl::linalg::block_qr(A);
-    //std::vector<ScalarType> betas = viennacl::linalg::qr(A);
-    elapsed = timer.get();
-    std::cout << "Time for QR on CPU: " << elapsed << std::endl;
-    std::cout << "Estimated GFLOPs: " << 2e-9 * num_ops_qr/ elapsed << std::endl;
-    
-    
-    //std::cout << "Inplace QR-factored A: " << A << std::endl;
-
-    timer.start();
-    viennacl::linalg::recoverQ(A, betas, Q, R); 
-    elapsed = timer.get();
-    std::cout << "Time for Q-recovery on CPU: " << elapsed << std::endl;
-    std::cout << "Estimated GFLOPs: " << 2e-9 * num_ops_recovery / elapsed << std::endl;
-
-    /*std::cout << "R after recovery: " << R << std::endl;
-    std::cout << "Q after recovery: " << Q << std::endl;
-    std::cout << "Q*Q^T: " << prod(Q, trans(Q)) << std::endl;
-    
-    std::cout << "Q * R: " << prod(Q, R) << std::endl;*/
-    
-    return EXIT_SUCCESS;
+  Timer timer;
+  double exec_time;
+  double num_ops_qr = 2.0 * double(cols) * double(cols) * (double(rows) - double(cols) / 3.0);
+
+  viennacl::matrix<ScalarType> vcl_A(rows, cols), vcl_A_backup(rows, cols), vcl_Q(rows, cols), vcl_R(cols, cols);
+  viennacl::vector<ScalarType> vcl_b(rows);
+
+  std::vector<ScalarType> stl_A(vcl_A.internal_size());
+  for (std::size_t i = 0; i < stl_A.size(); ++i)
+    stl_A[i] = random<ScalarType>();
+  viennacl::fast_copy(&(stl_A[0]), &(stl_A[0]) + stl_A.size(), vcl_A_backup);
+
+  std::vector<ScalarType> stl_b(rows);
+  for (std::size_t i = 0; i < stl_b.size(); ++i)
+    stl_b[i] = random<ScalarType>();
+  viennacl::copy(stl_b, vcl_b);
+
+  std::cout << " - Size: " << rows << " x " << cols << std::endl;
+
+  vcl_A = vcl_A_backup;
+  viennacl::backend::finish();
+  timer.start();
+  std::vector<ScalarType> betas = viennacl::linalg::inplace_qr(vcl_A);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "   inplace_qr:                  " << exec_time << " sec, " << 1e-9 * num_ops_qr / exec_time << " GFLOPs" << std::endl;
+
+  viennacl::backend::finish();
+  timer.start();
+  viennacl::linalg::tsqr(vcl_A_backup, vcl_R);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "   tsqr (R only):               " << exec_time << " sec, " << 1e-9 * num_ops_qr / exec_time << " GFLOPs" << std::endl;
+
+  viennacl::linalg::host_based::tsqr_factors<ScalarType> Q_implicit;
+  viennacl::backend::finish();
+  timer.start();
+  viennacl::linalg::tsqr(vcl_A_backup, vcl_R, Q_implicit);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "   tsqr (implicit Q):           " << exec_time << " sec" << std::endl;
+
+  viennacl::backend::finish();
+  timer.start();
+  viennacl::linalg::tsqr(vcl_A_backup, vcl_Q, vcl_R);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "   tsqr (explicit Q):           " << exec_time << " sec" << std::endl;
+
+  viennacl::backend::finish();
+  timer.start();
+  viennacl::vector<ScalarType> vcl_x = viennacl::linalg::tsqr_least_squares(vcl_A_backup, vcl_b);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "   tsqr_least_squares:          " << exec_time << " sec" << std::endl;
+
+  vcl_A = vcl_A_backup;
+  viennacl::backend::finish();
+  timer.start();
+  betas = viennacl::linalg::inplace_qr(vcl_A);
+  viennacl::linalg::inplace_qr_apply_trans_Q(vcl_A, betas, vcl_b);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "   inplace_qr + apply Q^T:      " << exec_time << " sec" << std::endl;
+}
+
+template<typename ScalarType>
+int run_benchmark()
+{
+  std::cout << " ------ Benchmark 1: Few columns ------ " << std::endl;
+  run_qr<ScalarType>(100000,   8);
+  run_qr<ScalarType>(100000,  32);
+  std::cout << std::endl;
+
+  std::cout << " ------ Benchmark 2: Many columns ------ " << std::endl;
+  run_qr<ScalarType>( 50000,  64);
+  run_qr<ScalarType>( 20000, 200);
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
 }
 
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "               Device Info" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+
+#ifdef VIENNACL_WITH_OPENCL
+  std::cout << viennacl::ocl::current_device().info() << std::endl;
+#endif
+
+
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Benchmark :: QR factorization of tall-skinny matrices " << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  std::cout << "   # benchmarking single-precision" << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  run_benchmark<float>();
+#ifdef VIENNACL_WITH_OPENCL
+  if( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    std::cout << std::endl;
+    std::cout << "   -------------------------------" << std::endl;
+    std::cout << "   # benchmarking double-precision" << std::endl;
+    std::cout << "   -------------------------------" << std::endl;
+    run_benchmark<double>();
+  }
+  return 0;
+}
@@ -33,6 +33,7 @@
 #include "viennacl/linalg/inner_prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/scheduler/execute.hpp"
+#include "viennacl/scheduler/compiled_statement.hpp"
 
 #include <iostream>
 #include <vector>
@@ -113,6 +114,104 @@ int run_benchmark()
   std::cout << "Execution time per operation, only execution: " << exec_time / BENCHMARK_RUNS << " sec" << std::endl;
   std::cout << "Result: " << vcl_vec2[0] << std::endl;
 
+  viennacl::scheduler::compiled_statement   my_compiled_statement(my_statement);
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+  {
+    viennacl::scheduler::statement   my_statement2(vcl_vec2, viennacl::op_assign(), alpha * vcl_vec1 + beta * vcl_vec2);
+    my_compiled_statement.rebind(my_statement2);
+    my_compiled_statement.execute();
+  }
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "Execution time per operation, compiled statement including statement generation and rebinding: " << exec_time / BENCHMARK_RUNS << " sec" << std::endl;
+  std::cout << "Result: " << vcl_vec2[0] << std::endl;
+
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+  {
+    my_compiled_statement.execute();
+  }
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "Execution time per operation, compiled statement, only execution: " << exec_time / BENCHMARK_RUNS << " sec" << std::endl;
+  std::cout << "Result: " << vcl_vec2[0] << std::endl;
+
+  return 0;
+}
+
+#define BENCHMARK_FUSED_VECTOR_SIZE   1000000
+#define BENCHMARK_FUSED_RUNS          20
+
+template<typename ScalarType>
+int run_fused_benchmark()
+{
+  Timer timer;
+  double exec_time;
+
+  std::vector<ScalarType> std_vec(BENCHMARK_FUSED_VECTOR_SIZE);
+  for (std::size_t i=0; i<std_vec.size(); ++i)
+    std_vec[i] = ScalarType(1) + ScalarType(i % 100) / ScalarType(100);
+
+  viennacl::vector<ScalarType> x(BENCHMARK_FUSED_VECTOR_SIZE);
+  viennacl::vector<ScalarType> y(BENCHMARK_FUSED_VECTOR_SIZE);
+  viennacl::vector<ScalarType> z(BENCHMARK_FUSED_VECTOR_SIZE);
+  viennacl::vector<ScalarType> u(BENCHMARK_FUSED_VECTOR_SIZE);
+  viennacl::vector<ScalarType> v(BENCHMARK_FUSED_VECTOR_SIZE);
+  viennacl::vector<ScalarType> w(BENCHMARK_FUSED_VECTOR_SIZE);
+  viennacl::vector<ScalarType> temp1(BENCHMARK_FUSED_VECTOR_SIZE);
+  viennacl::vector<ScalarType> temp2(BENCHMARK_FUSED_VECTOR_SIZE);
+  viennacl::copy(std_vec, y);
+  viennacl::copy(std_vec, z);
+  viennacl::copy(std_vec, u);
+  viennacl::copy(std_vec, v);
+  viennacl::copy(std_vec, w);
+  ScalarType alpha = ScalarType(1.1415);
+  ScalarType beta  = ScalarType(0.97172);
+  ScalarType gamma = ScalarType(0.5);
+
+  std::cout << std::endl << "Benchmarking x = alpha * y + beta * z - gamma * element_prod(u, v) + element_exp(w):" << std::endl;
+
+  // one operation at a time:
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_FUSED_RUNS; ++runs)
+  {
+    temp1 = viennacl::linalg::element_prod(u, v);
+    temp2 = viennacl::linalg::element_exp(w);
+    x = alpha * y + beta * z;
+    x -= gamma * temp1;
+    x += temp2;
+  }
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "Execution time per operation, separate operations: " << exec_time / BENCHMARK_FUSED_RUNS << " sec" << std::endl;
+  std::cout << "Result: " << x[0] << std::endl;
+
+  // operator overloads:
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_FUSED_RUNS; ++runs)
+    x = alpha * y + beta * z - gamma * viennacl::linalg::element_prod(u, v) + viennacl::linalg::element_exp(w);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "Execution time per operation, no scheduler: " << exec_time / BENCHMARK_FUSED_RUNS << " sec" << std::endl;
+  std::cout << "Result: " << x[0] << std::endl;
+
+  // scheduler, evaluated in a single pass:
+  viennacl::scheduler::statement   my_statement(x, viennacl::op_assign(), alpha * y + beta * z - gamma * viennacl::linalg::element_prod(u, v) + viennacl::linalg::element_exp(w));
+  viennacl::scheduler::execute(my_statement);
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_FUSED_RUNS; ++runs)
+    viennacl::scheduler::execute(my_statement);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "Execution time per operation, fused by scheduler: " << exec_time / BENCHMARK_FUSED_RUNS << " sec" << std::endl;
+  std::cout << "Result: " << x[0] << std::endl;
+
   return 0;
 }
 
@@ -137,6 +236,7 @@ int main()
   std::cout << "   # benchmarking single-precision" << std::endl;
   std::cout << "   -------------------------------" << std::endl;
   run_benchmark<float>();
+  run_fused_benchmark<float>();
 #ifdef VIENNACL_WITH_OPENCL
   if( viennacl::ocl::current_device().double_support() )
 #endif
@@ -146,6 +246,7 @@ int main()
     std::cout << "   # benchmarking double-precision" << std::endl;
     std::cout << "   -------------------------------" << std::endl;
     run_benchmark<double>();
+    run_fused_benchmark<double>();
   }
   return 0;
 }
@@ -222,6 +222,21 @@ int run_benchmark(viennacl::context ctx)
   exec_time = timer.get();
   std::cout << "ViennaCL time: " << exec_time << std::endl;
 
+  std::cout << "------- ICHOL0 with ViennaCL (parallel sweeps, Jacobi substitution) ----------" << std::endl;
+
+  timer.start();
+  viennacl::linalg::ichol0_precond< viennacl::compressed_matrix<ScalarType> > vcl_ichol0_sweeps(vcl_compressed_matrix, viennacl::linalg::ichol0_tag(3, 3));
+  exec_time = timer.get();
+  std::cout << "Setup time: " << exec_time << std::endl;
+
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+    vcl_ichol0_sweeps.apply(vcl_vec1);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "ViennaCL time: " << exec_time << std::endl;
+
 
   ///////////////////////////////////////////////////////////////////////////////
   //////////////////////           ILU preconditioner         //////////////////
@@ -268,6 +283,19 @@ int run_benchmark(viennacl::context ctx)
   exec_time = timer.get();
   std::cout << "ViennaCL ILU0 substitution time (with level scheduling): " << exec_time << std::endl;
 
+  timer.start();
+  viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<ScalarType> > vcl_ilu0_sweeps(vcl_compressed_matrix, viennacl::linalg::ilu0_tag(false, 3, 3));
+  exec_time = timer.get();
+  std::cout << "Setup time (parallel sweeps): " << exec_time << std::endl;
+
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+    vcl_ilu0_sweeps.apply(vcl_vec1);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "ViennaCL ILU0 substitution time (Jacobi substitution): " << exec_time << std::endl;
+
 
 
   ////////////////////////////////////////////
@@ -431,6 +459,9 @@ int run_benchmark(viennacl::context ctx)
   std::cout << "------- CG solver (ICHOL0 preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
   run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, cg_solver, vcl_ichol0, cg_ops);
 
+  std::cout << "------- CG solver (ICHOL0 preconditioner, parallel sweeps) via ViennaCL, compressed_matrix ----------" << std::endl;
+  run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, cg_solver, vcl_ichol0_sweeps, cg_ops);
+
 
   std::cout << "------- CG solver (ILU0 preconditioner) using ublas ----------" << std::endl;
   run_solver(ublas_matrix, ublas_vec2, ublas_result, cg_solver, ublas_ilu0, cg_ops);
@@ -504,6 +535,9 @@ int run_benchmark(viennacl::context ctx)
   std::cout << "------- BiCGStab solver (ILUT preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
   run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, bicgstab_solver, vcl_ilut, bicgstab_ops);
 
+  std::cout << "------- BiCGStab solver (ILU0 preconditioner, parallel sweeps) via ViennaCL, compressed_matrix ----------" << std::endl;
+  run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, bicgstab_solver, vcl_ilu0_sweeps, bicgstab_ops);
+
   std::cout << "------- BiCGStab solver (Block-ILUT preconditioner) using ublas ----------" << std::endl;
   run_solver(ublas_matrix, ublas_vec2, ublas_result, bicgstab_solver, ublas_block_ilut, bicgstab_ops);
 
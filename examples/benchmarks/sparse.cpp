@@ -35,6 +35,7 @@
 
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
 #include "viennacl/coordinate_matrix.hpp"
 #include "viennacl/compressed_matrix.hpp"
 #include "viennacl/ell_matrix.hpp"
@@ -281,6 +282,41 @@ int run_benchmark()
   std::cout << vcl_vec1[0] << std::endl;
 
 
+  std::cout << "------- Matrix-Matrix product with dense matrix of 64 columns ----------" << std::endl;
+  std::size_t spmm_cols = 64;
+  viennacl::matrix<ScalarType, viennacl::row_major>    vcl_rhs_row = viennacl::scalar_matrix<ScalarType>(ublas_matrix.size2(), spmm_cols, ScalarType(1));
+  viennacl::matrix<ScalarType, viennacl::row_major>    vcl_result_row(ublas_matrix.size1(), spmm_cols);
+  viennacl::matrix<ScalarType, viennacl::column_major> vcl_rhs_col = viennacl::scalar_matrix<ScalarType>(ublas_matrix.size2(), spmm_cols, ScalarType(1));
+  viennacl::matrix<ScalarType, viennacl::column_major> vcl_result_col(ublas_matrix.size1(), spmm_cols);
+
+  vcl_result_row = viennacl::linalg::prod(vcl_compressed_matrix_1, vcl_rhs_row); //startup calculation
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+    vcl_result_row = viennacl::linalg::prod(vcl_compressed_matrix_1, vcl_rhs_row);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "GPU compressed_matrix, row-major: "; printOps(2.0 * static_cast<double>(ublas_matrix.nnz() * spmm_cols), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+
+  vcl_result_col = viennacl::linalg::prod(vcl_compressed_matrix_1, vcl_rhs_col); //startup calculation
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+    vcl_result_col = viennacl::linalg::prod(vcl_compressed_matrix_1, vcl_rhs_col);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "GPU compressed_matrix, column-major: "; printOps(2.0 * static_cast<double>(ublas_matrix.nnz() * spmm_cols), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+
+  vcl_result_row = viennacl::linalg::prod(vcl_ell_matrix_1, vcl_rhs_row); //startup calculation
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+    vcl_result_row = viennacl::linalg::prod(vcl_ell_matrix_1, vcl_rhs_row);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "GPU ell_matrix, row-major: "; printOps(2.0 * static_cast<double>(ublas_matrix.nnz() * spmm_cols), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+
+
   return EXIT_SUCCESS;
 }
 
@@ -0,0 +1,920 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/*
+*
+*   Benchmark suite: BLAS levels 1-3, sparse matrix-vector products for each sparse format, sparse matrix - dense matrix products,
+*   iterative solvers, preconditioner setup, and factorizations.
+*
+*   Each benchmark is run a few times for warming up and then repeatedly. The median, the 95th percentile, the minimum, and the mean
+*   of the execution times are reported. Operations faster than --min-sample-time are executed several times per sample.
+*   Where the number of floating point operations and the memory traffic of an operation are known, the achieved GFLOP/s and GB/s are
+*   reported together with the efficiency relative to a roofline of the host, which is given by the bandwidth of a STREAM triad
+*   and the throughput of a multiply-add kernel, both measured at startup. Data fitting into the caches may exceed the roofline (efficiency > 1).
+*
+*   Results are written as JSON (default) or CSV, either to stdout or to the file given by -o. Progress is written to stderr.
+*
+*   Example: suitebench-cpu --vector-sizes 1000000,10000000 --matrix-sizes 512,1024 --mtx ../examples/testdata/mat65k.mtx --format csv -o results.csv
+*
+*/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include <tclap/CmdLine.h>
+
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/coordinate_matrix.hpp"
+#include "viennacl/ell_matrix.hpp"
+#include "viennacl/hyb_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/lu.hpp"
+#include "viennacl/linalg/qr.hpp"
+#include "viennacl/linalg/cholesky.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/gmres.hpp"
+#include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/ichol.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/sparse_cholesky.hpp"
+#include "viennacl/io/matrix_market.hpp"
+#include "viennacl/tools/timer.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+
+//
+// Options
+//
+
+struct suite_options
+{
+  std::vector<std::size_t> vector_sizes;
+  std::vector<std::size_t> matrix_sizes;
+  std::vector<std::string> mtx_files;
+  std::size_t grid_size;
+  std::size_t spmm_cols;
+  std::size_t solver_iterations;
+  std::size_t stream_size;
+  unsigned int warmup;
+  unsigned int runs;
+  double min_sample_time;
+  std::string filter;
+  std::string format;
+  std::string output;
+  std::string precision;
+};
+
+std::vector<std::size_t> parse_sizes(std::string const & s)
+{
+  std::vector<std::size_t> sizes;
+  std::istringstream stream(s);
+  std::string item;
+  while (std::getline(stream, item, ','))
+    if (!item.empty())
+      sizes.push_back(static_cast<std::size_t>(std::atol(item.c_str())));
+  return sizes;
+}
+
+suite_options get_options(int argc, char* argv[])
+{
+  try
+  {
+    suite_options options;
+
+    TCLAP::CmdLine cmd("ViennaCL benchmark suite", ' ', "0.1");
+
+    TCLAP::ValueArg<std::string> vector_sizes_arg("", "vector-sizes", "Comma-separated sizes for the vector operations", false, "100000,10000000", "string", cmd);
+    TCLAP::ValueArg<std::string> matrix_sizes_arg("", "matrix-sizes", "Comma-separated sizes of the square dense matrices", false, "256,512", "string", cmd);
+    TCLAP::MultiArg<std::string> mtx_arg("", "mtx", "Matrix Market file for the sparse benchmarks (may be given several times). Defaults to a 2D Laplacian", false, "file", cmd);
+    TCLAP::ValueArg<std::size_t> grid_size_arg("", "grid-size", "Grid size of the 2D Laplacian used if no Matrix Market file is given", false, 256, "unsigned int", cmd);
+    TCLAP::ValueArg<std::size_t> spmm_cols_arg("", "spmm-cols", "Number of columns of the dense matrix in sparse matrix - dense matrix products", false, 64, "unsigned int", cmd);
+    TCLAP::ValueArg<std::size_t> solver_iterations_arg("", "solver-iterations", "Number of iterations of the iterative solvers", false, 100, "unsigned int", cmd);
+    TCLAP::ValueArg<std::size_t> stream_size_arg("", "stream-size", "Number of entries of each array in the STREAM triad. Should exceed the last level cache several times", false, 1 << 22, "unsigned int", cmd);
+    TCLAP::ValueArg<unsigned int> warmup_arg("", "warmup", "Number of warm-up runs of each benchmark", false, 2, "unsigned int", cmd);
+    TCLAP::ValueArg<unsigned int> runs_arg("", "runs", "Number of timed runs of each benchmark", false, 10, "unsigned int", cmd);
+    TCLAP::ValueArg<double> min_sample_time_arg("", "min-sample-time", "Minimum duration of a timed sample in seconds. Faster operations are repeated within a sample", false, 1e-3, "double", cmd);
+    TCLAP::ValueArg<std::string> filter_arg("", "filter", "Only run benchmarks whose name (e.g. spmv/csr) contains this string", false, "", "string", cmd);
+
+    std::vector<std::string> formats; formats.push_back("json"); formats.push_back("csv");
+    TCLAP::ValuesConstraint<std::string> format_constraint(formats);
+    TCLAP::ValueArg<std::string> format_arg("", "format", "Output format", false, "json", &format_constraint, cmd);
+
+    std::vector<std::string> precisions; precisions.push_back("float"); precisions.push_back("double");
+    TCLAP::ValuesConstraint<std::string> precision_constraint(precisions);
+    TCLAP::ValueArg<std::string> precision_arg("", "precision", "Floating point type", false, "double", &precision_constraint, cmd);
+
+    TCLAP::ValueArg<std::string> output_arg("o", "output", "Output file. Defaults to stdout", false, "", "string", cmd);
+
+    cmd.parse(argc, argv);
+
+    options.vector_sizes      = parse_sizes(vector_sizes_arg.getValue());
+    options.matrix_sizes      = parse_sizes(matrix_sizes_arg.getValue());
+    options.mtx_files         = mtx_arg.getValue();
+    options.grid_size         = std::max<std::size_t>(grid_size_arg.getValue(), 2);
+    options.spmm_cols         = std::max<std::size_t>(spmm_cols_arg.getValue(), 1);
+    options.solver_iterations = std::max<std::size_t>(solver_iterations_arg.getValue(), 1);
+    options.stream_size       = std::max<std::size_t>(stream_size_arg.getValue(), 1024);
+    options.warmup            = warmup_arg.getValue();
+    options.runs              = std::max(runs_arg.getValue(), 1u);
+    options.min_sample_time   = min_sample_time_arg.getValue();
+    options.filter            = filter_arg.getValue();
+    options.format            = format_arg.getValue();
+    options.output            = output_arg.getValue();
+    options.precision         = precision_arg.getValue();
+    return options;
+  }
+  catch (TCLAP::ArgException &e)
+  {
+    std::cerr << "error: " << "\"" << e.error() << "\"" << " [for arg " << e.argId() << "]" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+
+//
+// Measurement and statistics
+//
+
+/** @brief Statistics of the execution times of a benchmark in seconds per execution */
+struct benchmark_statistics
+{
+  benchmark_statistics() : runs(0), batch(1), min(0), median(0), p95(0), mean(0) {}
+
+  std::size_t runs;
+  std::size_t batch;   //executions per timed sample
+  double min;
+  double median;
+  double p95;
+  double mean;
+};
+
+/** @brief Runs the operation options.warmup times, then takes options.runs timed samples. Each sample executes the operation 'batch' times, where 'batch' is chosen such that a sample takes at least options.min_sample_time. */
+template <typename OperationT>
+benchmark_statistics measure(OperationT & op, suite_options const & options)
+{
+  viennacl::tools::timer timer;
+  benchmark_statistics stats;
+
+  double warmup_time = 0;
+  for (unsigned int i = 0; i < options.warmup; ++i)
+  {
+    timer.start();
+    op();
+    viennacl::backend::finish();
+    warmup_time = timer.get();
+  }
+  if (options.warmup > 0 && warmup_time < options.min_sample_time)
+    stats.batch = static_cast<std::size_t>(std::ceil(options.min_sample_time / std::max(warmup_time, 1e-9)));
+
+  std::vector<double> times(options.runs);
+  for (std::size_t r = 0; r < times.size(); ++r)
+  {
+    timer.start();
+    for (std::size_t b = 0; b < stats.batch; ++b)
+      op();
+    viennacl::backend::finish();
+    times[r] = timer.get() / static_cast<double>(stats.batch);
+  }
+
+  std::sort(times.begin(), times.end());
+  std::size_t n = times.size();
+  stats.runs   = n;
+  stats.min    = times[0];
+  stats.median = (n % 2) ? times[n / 2] : (times[n / 2 - 1] + times[n / 2]) / 2;
+  stats.p95    = times[std::min(n - 1, static_cast<std::size_t>(std::ceil(0.95 * static_cast<double>(n))) - 1)];
+  for (std::size_t r = 0; r < n; ++r)
+    stats.mean += times[r] / static_cast<double>(n);
+  return stats;
+}
+
+
+//
+// Roofline of the host
+//
+
+/** @brief Memory bandwidth (bytes per second) and floating point throughput (operations per second) of the host */
+struct roofline
+{
+  roofline() : bandwidth(0), peak_flops(0) {}
+
+  double attainable_time(double flops, double bytes) const { return std::max(flops / peak_flops, bytes / bandwidth); }
+
+  double bandwidth;
+  double peak_flops;
+};
+
+/** @brief Returns the best bandwidth of the STREAM triad a = b + s * c over the supplied number of runs */
+template <typename ScalarType>
+double measure_stream_triad(std::size_t n, unsigned int runs)
+{
+  std::vector<ScalarType> a(n), b(n, ScalarType(1)), c(n, ScalarType(2));
+  ScalarType * pa = &(a[0]);
+  ScalarType const * pb = &(b[0]);
+  ScalarType const * pc = &(c[0]);
+  ScalarType s = ScalarType(3);
+  long size = static_cast<long>(n);
+
+  double best_time = 0;
+  viennacl::tools::timer timer;
+  for (unsigned int r = 0; r <= runs; ++r)  //first run for warming up
+  {
+    timer.start();
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long i = 0; i < size; ++i)
+      pa[i] = pb[i] + s * pc[i];
+    double time = timer.get();
+    if (r == 1 || (r > 1 && time < best_time))
+      best_time = time;
+  }
+  return 3.0 * sizeof(ScalarType) * static_cast<double>(n) / best_time;
+}
+
+/** @brief Throughput of independent multiply-add chains on all threads. An estimate of the attainable floating point throughput for vectorized code. */
+template <typename ScalarType>
+double measure_peak_flops(unsigned int runs)
+{
+  std::size_t const num_chains = 32;
+  std::size_t const iterations = 1 << 22;
+  double best_rate = 0;
+  ScalarType sink = 0;
+
+  for (unsigned int r = 0; r <= runs; ++r)
+  {
+    std::size_t num_threads = 1;
+    viennacl::tools::timer timer;
+    timer.start();
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel reduction(+: sink)
+#endif
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp single
+      num_threads = static_cast<std::size_t>(omp_get_num_threads());
+#endif
+      ScalarType acc[num_chains];
+      for (std::size_t k = 0; k < num_chains; ++k)
+        acc[k] = ScalarType(k) / ScalarType(num_chains);
+      ScalarType alpha = ScalarType(0.999999), beta = ScalarType(1e-6);
+      for (std::size_t i = 0; i < iterations; ++i)
+        for (std::size_t k = 0; k < num_chains; ++k)
+          acc[k] = acc[k] * alpha + beta;
+      for (std::size_t k = 0; k < num_chains; ++k)
+        sink += acc[k];
+    }
+    double time = timer.get();
+    double rate = 2.0 * static_cast<double>(num_chains * iterations * num_threads) / time;
+    if (r > 0)
+      best_rate = std::max(best_rate, rate);
+  }
+  if (sink == ScalarType(-1))  //keeps the compiler from removing the kernel
+    std::cerr << sink << std::endl;
+  return best_rate;
+}
+
+
+//
+// Results
+//
+
+/** @brief A benchmark result. Operation counts and memory traffic are zero where no model is available. */
+struct benchmark_record
+{
+  benchmark_record() : size1(0), size2(0), nnz(0), flops(0), bytes(0) {}
+
+  std::string group;
+  std::string name;
+  std::string instance;
+  std::size_t size1, size2, nnz;
+  double flops;
+  double bytes;
+  benchmark_statistics stats;
+};
+
+class result_writer
+{
+  public:
+    result_writer(suite_options const & options, roofline const & host, std::string const & backend, std::size_t threads)
+      : options_(options), host_(host), backend_(backend), threads_(threads) {}
+
+    void add(benchmark_record const & record)
+    {
+      records_.push_back(record);
+      std::cerr << "  " << record.group << "/" << record.name << " [" << record.instance << "]: median " << record.stats.median << " s";
+      if (record.flops > 0)
+        std::cerr << ", " << record.flops / record.stats.median * 1e-9 << " GFLOP/s";
+      if (record.bytes > 0)
+        std::cerr << ", " << record.bytes / record.stats.median * 1e-9 << " GB/s";
+      std::cerr << std::endl;
+    }
+
+    void write(std::ostream & stream) const
+    {
+      if (options_.format == "csv")
+        write_csv(stream);
+      else
+        write_json(stream);
+    }
+
+  private:
+    static std::string number(double value)
+    {
+      if (!(value == value) || value > 1e300 || value < -1e300)   //NaN or infinity
+        return "";
+      std::ostringstream ss;
+      ss.precision(6);
+      ss << value;
+      return ss.str();
+    }
+
+    static std::string json_number(double value, bool available = true)
+    {
+      std::string s = number(value);
+      return (available && !s.empty()) ? s : "null";
+    }
+
+    static std::string json_string(std::string const & s)
+    {
+      std::string result = "\"";
+      for (std::size_t i = 0; i < s.size(); ++i)
+      {
+        if (s[i] == '"' || s[i] == '\\')
+          result += '\\';
+        if (static_cast<unsigned char>(s[i]) >= 0x20)
+          result += s[i];
+      }
+      return result + "\"";
+    }
+
+    static std::string csv_string(std::string const & s)
+    {
+      if (s.find_first_of(",\"") == std::string::npos)
+        return s;
+      std::string result = "\"";
+      for (std::size_t i = 0; i < s.size(); ++i)
+      {
+        if (s[i] == '"')
+          result += '"';
+        result += s[i];
+      }
+      return result + "\"";
+    }
+
+    double efficiency(benchmark_record const & r) const
+    {
+      if (r.flops <= 0 && r.bytes <= 0)
+        return 0;
+      return host_.attainable_time(r.flops, r.bytes) / r.stats.median;
+    }
+
+    void write_json(std::ostream & stream) const
+    {
+      stream << "{" << std::endl;
+      stream << "  \"machine\": {" << std::endl;
+      stream << "    \"backend\": " << json_string(backend_) << "," << std::endl;
+      stream << "    \"threads\": " << threads_ << "," << std::endl;
+      stream << "    \"precision\": " << json_string(options_.precision) << "," << std::endl;
+      stream << "    \"stream_triad_gbs\": " << json_number(host_.bandwidth * 1e-9) << "," << std::endl;
+      stream << "    \"peak_gflops\": " << json_number(host_.peak_flops * 1e-9) << std::endl;
+      stream << "  }," << std::endl;
+      stream << "  \"benchmarks\": [" << std::endl;
+      for (std::size_t i = 0; i < records_.size(); ++i)
+      {
+        benchmark_record const & r = records_[i];
+        bool has_flops = r.flops > 0;
+        bool has_bytes = r.bytes > 0;
+        stream << "    {"
+               << "\"group\": " << json_string(r.group)
+               << ", \"name\": " << json_string(r.name)
+               << ", \"instance\": " << json_string(r.instance)
+               << ", \"size1\": " << r.size1
+               << ", \"size2\": " << r.size2
+               << ", \"nnz\": " << r.nnz
+               << ", \"runs\": " << r.stats.runs
+               << ", \"batch\": " << r.stats.batch
+               << ", \"min_s\": " << json_number(r.stats.min)
+               << ", \"median_s\": " << json_number(r.stats.median)
+               << ", \"p95_s\": " << json_number(r.stats.p95)
+               << ", \"mean_s\": " << json_number(r.stats.mean)
+               << ", \"gflops\": " << json_number(r.flops / r.stats.median * 1e-9, has_flops)
+               << ", \"gbs\": " << json_number(r.bytes / r.stats.median * 1e-9, has_bytes)
+               << ", \"intensity\": " << json_number(r.flops / r.bytes, has_flops && has_bytes)
+               << ", \"roofline_efficiency\": " << json_number(efficiency(r), has_flops || has_bytes)
+               << "}" << (i + 1 < records_.size() ? "," : "") << std::endl;
+      }
+      stream << "  ]" << std::endl;
+      stream << "}" << std::endl;
+    }
+
+    void write_csv(std::ostream & stream) const
+    {
+      stream << "# backend: " << backend_ << ", threads: " << threads_ << ", precision: " << options_.precision
+             << ", stream_triad_gbs: " << number(host_.bandwidth * 1e-9) << ", peak_gflops: " << number(host_.peak_flops * 1e-9) << std::endl;
+      stream << "group,name,instance,size1,size2,nnz,runs,batch,min_s,median_s,p95_s,mean_s,gflops,gbs,intensity,roofline_efficiency" << std::endl;
+      for (std::size_t i = 0; i < records_.size(); ++i)
+      {
+        benchmark_record const & r = records_[i];
+        stream << csv_string(r.group) << "," << csv_string(r.name) << "," << csv_string(r.instance) << ","
+               << r.size1 << "," << r.size2 << "," << r.nnz << "," << r.stats.runs << "," << r.stats.batch << ","
+               << number(r.stats.min) << "," << number(r.stats.median) << "," << number(r.stats.p95) << "," << number(r.stats.mean) << ","
+               << (r.flops > 0 ? number(r.flops / r.stats.median * 1e-9) : "") << ","
+               << (r.bytes > 0 ? number(r.bytes / r.stats.median * 1e-9) : "") << ","
+               << (r.flops > 0 && r.bytes > 0 ? number(r.flops / r.bytes) : "") << ","
+               << (r.flops > 0 || r.bytes > 0 ? number(efficiency(r)) : "") << std::endl;
+      }
+    }
+
+    suite_options const & options_;
+    roofline host_;
+    std::string backend_;
+    std::size_t threads_;
+    std::vector<benchmark_record> records_;
+};
+
+/** @brief Runs the operation if its name passes the filter and records the result */
+template <typename OperationT>
+void run(OperationT & op, benchmark_record record, suite_options const & options, result_writer & writer)
+{
+  if ((record.group + "/" + record.name).find(options.filter) == std::string::npos)
+    return;
+  record.stats = measure(op, options);
+  writer.add(record);
+}
+
+std::string size_string(std::size_t n)
+{
+  std::ostringstream ss;
+  ss << "n=" << n;
+  return ss.str();
+}
+
+
+//
+// Operations
+//
+
+template <typename ScalarType>
+struct vector_operation
+{
+  enum operation_type { COPY, AXPY, INNER_PROD, NORM_2 };
+
+  vector_operation(operation_type type, std::size_t n)
+    : type_(type), x(n), y(viennacl::scalar_vector<ScalarType>(n, ScalarType(1))), z(viennacl::scalar_vector<ScalarType>(n, ScalarType(2))), s(0) {}
+
+  void operator()()
+  {
+    switch (type_)
+    {
+      case COPY:       x = y; break;
+      case AXPY:       x = y + ScalarType(2) * z; break;
+      case INNER_PROD: s = viennacl::linalg::inner_prod(y, z); break;
+      case NORM_2:     s = viennacl::linalg::norm_2(y); break;
+    }
+  }
+
+  operation_type type_;
+  viennacl::vector<ScalarType> x, y, z;
+  viennacl::scalar<ScalarType> s;
+};
+
+template <typename ScalarType>
+void fill_matrix(viennacl::matrix<ScalarType> & A)
+{
+  std::vector<ScalarType> values(A.internal_size());
+  for (std::size_t i = 0; i < A.size1(); ++i)
+    for (std::size_t j = 0; j < A.size2(); ++j)
+      values[i * A.internal_size2() + j] = (i == j) ? ScalarType(A.size1()) : ScalarType((i * 7 + j * 3) % 11) / ScalarType(11);
+  viennacl::fast_copy(&(values[0]), &(values[0]) + values.size(), A);
+}
+
+template <typename ScalarType>
+struct dense_operation
+{
+  enum operation_type { GEMV, GEMM, LU, CHOLESKY, QR };
+
+  dense_operation(operation_type type, std::size_t n) : type_(type), A(n, n), B(n, n), C(n, n), x(viennacl::scalar_vector<ScalarType>(n, ScalarType(1))), y(n)
+  {
+    fill_matrix(A);
+    fill_matrix(B);
+  }
+
+  void operator()()
+  {
+    switch (type_)
+    {
+      case GEMV: y = viennacl::linalg::prod(A, x); break;
+      case GEMM: C = viennacl::linalg::prod(A, B); break;
+      case LU:   C = A; viennacl::linalg::lu_factorize(C); break;
+      case CHOLESKY: C = A; viennacl::linalg::cholesky_factorize(C); break;
+      case QR:   C = A; viennacl::linalg::inplace_qr(C); break;
+    }
+  }
+
+  operation_type type_;
+  viennacl::matrix<ScalarType> A, B, C;
+  viennacl::vector<ScalarType> x, y;
+};
+
+template <typename MatrixType, typename ScalarType>
+struct spmv_operation
+{
+  spmv_operation(MatrixType const & mat) : A(mat), x(viennacl::scalar_vector<ScalarType>(mat.size2(), ScalarType(1))), y(mat.size1()) {}
+
+  void operator()() { y = viennacl::linalg::prod(A, x); }
+
+  MatrixType const & A;
+  viennacl::vector<ScalarType> x, y;
+};
+
+template <typename ScalarType>
+struct spmm_operation
+{
+  spmm_operation(viennacl::compressed_matrix<ScalarType> const & mat, std::size_t cols)
+    : A(mat), B(viennacl::scalar_matrix<ScalarType>(mat.size2(), cols, ScalarType(1))), C(mat.size1(), cols) {}
+
+  void operator()() { C = viennacl::linalg::prod(A, B); }
+
+  viennacl::compressed_matrix<ScalarType> const & A;
+  viennacl::matrix<ScalarType> B, C;
+};
+
+template <typename ScalarType, typename SolverTag>
+struct solver_operation
+{
+  solver_operation(viennacl::compressed_matrix<ScalarType> const & mat, SolverTag const & solver_tag)
+    : A(mat), rhs(viennacl::scalar_vector<ScalarType>(mat.size1(), ScalarType(1))), tag(solver_tag) {}
+
+  void operator()() { result = viennacl::linalg::solve(A, rhs, tag); }
+
+  viennacl::compressed_matrix<ScalarType> const & A;
+  viennacl::vector<ScalarType> rhs, result;
+  SolverTag tag;
+};
+
+/** @brief Sets up a preconditioner or a factorization from the matrix and the tag */
+template <typename PrecondType, typename ScalarType, typename TagType>
+struct setup_operation
+{
+  setup_operation(viennacl::compressed_matrix<ScalarType> const & mat, TagType const & precond_tag) : A(mat), tag(precond_tag) {}
+
+  void operator()() { PrecondType precond(A, tag); }
+
+  viennacl::compressed_matrix<ScalarType> const & A;
+  TagType tag;
+};
+
+/** @brief Numerical factorization of a sparse Cholesky factorization, reusing the ordering and the symbolic analysis */
+template <typename ScalarType>
+struct sparse_cholesky_refactorization
+{
+  sparse_cholesky_refactorization(viennacl::compressed_matrix<ScalarType> const & mat) : A(mat), chol(mat) {}
+
+  void operator()() { chol.factorize(A); }
+
+  viennacl::compressed_matrix<ScalarType> const & A;
+  viennacl::linalg::sparse_cholesky<ScalarType> chol;
+};
+
+
+//
+// Memory traffic of the sparse matrix-vector products: matrix entries and indices, x and y once.
+//
+
+template <typename ScalarType, unsigned int A>
+double spmv_bytes(viennacl::compressed_matrix<ScalarType, A> const & mat)
+{
+  return static_cast<double>(mat.nnz() * (sizeof(ScalarType) + sizeof(unsigned int)) + (mat.size1() + 1) * sizeof(unsigned int) + (mat.size1() + mat.size2()) * sizeof(ScalarType));
+}
+
+template <typename ScalarType, unsigned int A>
+double spmv_bytes(viennacl::coordinate_matrix<ScalarType, A> const & mat)
+{
+  return static_cast<double>(mat.nnz() * (sizeof(ScalarType) + 2 * sizeof(unsigned int)) + (mat.size1() + mat.size2()) * sizeof(ScalarType));
+}
+
+template <typename ScalarType, unsigned int A>
+double spmv_bytes(viennacl::ell_matrix<ScalarType, A> const & mat)
+{
+  return static_cast<double>(mat.size1() * mat.maxnnz() * (sizeof(ScalarType) + sizeof(unsigned int)) + (mat.size1() + mat.size2()) * sizeof(ScalarType));
+}
+
+template <typename ScalarType, unsigned int A>
+double spmv_bytes(viennacl::hyb_matrix<ScalarType, A> const & mat)
+{
+  return static_cast<double>((mat.size1() * mat.ell_nnz() + mat.csr_nnz()) * (sizeof(ScalarType) + sizeof(unsigned int))
+                             + (mat.size1() + 1) * sizeof(unsigned int) + (mat.size1() + mat.size2()) * sizeof(ScalarType));
+}
+
+
+//
+// Benchmark groups
+//
+
+template <typename ScalarType>
+void run_vector_benchmarks(suite_options const & options, result_writer & writer)
+{
+  typedef vector_operation<ScalarType> op_type;
+  double s = sizeof(ScalarType);
+
+  for (std::size_t i = 0; i < options.vector_sizes.size(); ++i)
+  {
+    std::size_t n = options.vector_sizes[i];
+    double dn = static_cast<double>(n);
+    benchmark_record record;
+    record.group = "blas1";
+    record.instance = size_string(n);
+    record.size1 = n;
+
+    { op_type op(op_type::COPY, n);       record.name = "copy";       record.flops = 0;      record.bytes = 2 * dn * s; run(op, record, options, writer); }
+    { op_type op(op_type::AXPY, n);       record.name = "axpy";       record.flops = 2 * dn; record.bytes = 3 * dn * s; run(op, record, options, writer); }
+    { op_type op(op_type::INNER_PROD, n); record.name = "inner_prod"; record.flops = 2 * dn; record.bytes = 2 * dn * s; run(op, record, options, writer); }
+    { op_type op(op_type::NORM_2, n);     record.name = "norm_2";     record.flops = 2 * dn; record.bytes = dn * s;     run(op, record, options, writer); }
+  }
+}
+
+template <typename ScalarType>
+void run_dense_benchmarks(suite_options const & options, result_writer & writer)
+{
+  typedef dense_operation<ScalarType> op_type;
+  double s = sizeof(ScalarType);
+
+  for (std::size_t i = 0; i < options.matrix_sizes.size(); ++i)
+  {
+    std::size_t n = options.matrix_sizes[i];
+    double dn = static_cast<double>(n);
+    benchmark_record record;
+    record.instance = size_string(n);
+    record.size1 = n;
+    record.size2 = n;
+
+    record.group = "blas2";
+    { op_type op(op_type::GEMV, n); record.name = "gemv"; record.flops = 2 * dn * dn; record.bytes = (dn * dn + 2 * dn) * s; run(op, record, options, writer); }
+
+    record.group = "blas3";
+    { op_type op(op_type::GEMM, n); record.name = "gemm"; record.flops = 2 * dn * dn * dn; record.bytes = 3 * dn * dn * s; run(op, record, options, writer); }
+
+    record.group = "factorization";
+    { op_type op(op_type::LU, n); record.name = "lu";  record.flops = 2.0 / 3.0 * dn * dn * dn; record.bytes = 2 * dn * dn * s; run(op, record, options, writer); }
+    { op_type op(op_type::CHOLESKY, n); record.name = "cholesky"; record.flops = 1.0 / 3.0 * dn * dn * dn; record.bytes = 2 * dn * dn * s; run(op, record, options, writer); }
+    { op_type op(op_type::QR, n); record.name = "qr";  record.flops = 4.0 / 3.0 * dn * dn * dn; record.bytes = 2 * dn * dn * s; run(op, record, options, writer); }
+  }
+}
+
+template <typename MatrixType, typename ScalarType>
+void run_spmv(std::string const & format, std::vector< std::map<unsigned int, ScalarType> > const & cpu_matrix, std::size_t cols,
+              benchmark_record record, suite_options const & options, result_writer & writer)
+{
+  record.group = "spmv";
+  record.name  = format;
+  if ((record.group + "/" + record.name).find(options.filter) == std::string::npos)
+    return;
+
+  MatrixType A;
+  viennacl::copy(viennacl::tools::const_sparse_matrix_adapter<ScalarType>(cpu_matrix, cpu_matrix.size(), cols), A);
+  spmv_operation<MatrixType, ScalarType> op(A);
+  record.bytes = spmv_bytes(A);
+  run(op, record, options, writer);
+}
+
+template <typename ScalarType>
+void run_sparse_benchmarks(std::string const & instance, std::vector< std::map<unsigned int, ScalarType> > const & cpu_matrix, std::size_t cols,
+                           suite_options const & options, result_writer & writer)
+{
+  std::size_t rows = cpu_matrix.size();
+  std::size_t nnz = 0;
+  for (std::size_t i = 0; i < rows; ++i)
+    nnz += cpu_matrix[i].size();
+  double s = sizeof(ScalarType);
+  double dn = static_cast<double>(rows);
+
+  benchmark_record record;
+  record.instance = instance;
+  record.size1 = rows;
+  record.size2 = cols;
+  record.nnz   = nnz;
+  record.flops = 2.0 * static_cast<double>(nnz);
+
+  // sparse matrix-vector products for each format:
+  run_spmv<viennacl::compressed_matrix<ScalarType>, ScalarType>("csr", cpu_matrix, cols, record, options, writer);
+  run_spmv<viennacl::coordinate_matrix<ScalarType>, ScalarType>("coo", cpu_matrix, cols, record, options, writer);
+  run_spmv<viennacl::ell_matrix<ScalarType>,        ScalarType>("ell", cpu_matrix, cols, record, options, writer);
+  run_spmv<viennacl::hyb_matrix<ScalarType>,        ScalarType>("hyb", cpu_matrix, cols, record, options, writer);
+
+  viennacl::compressed_matrix<ScalarType> A(rows, cols);
+  viennacl::copy(viennacl::tools::const_sparse_matrix_adapter<ScalarType>(cpu_matrix, rows, cols), A);
+  double csr_bytes = spmv_bytes(A);
+
+  // sparse matrix - dense matrix product:
+  {
+    double k = static_cast<double>(options.spmm_cols);
+    spmm_operation<ScalarType> op(A, options.spmm_cols);
+    record.group = "spmm";
+    record.name  = "csr";
+    record.flops = 2.0 * static_cast<double>(nnz) * k;
+    record.bytes = csr_bytes + (static_cast<double>(rows + cols) * (k - 1)) * s;
+    run(op, record, options, writer);
+  }
+
+  if (rows != cols)
+    return;
+
+  // iterative solvers with a fixed number of iterations. Operation counts: CG: 1 SpMV, 2 inner products, 3 vector updates per iteration. BiCGStab: 2 SpMVs, about 5 reductions and 6 vector updates.
+  double iterations = static_cast<double>(options.solver_iterations);
+  record.group = "solver";
+  {
+    solver_operation<ScalarType, viennacl::linalg::cg_tag> op(A, viennacl::linalg::cg_tag(1e-30, static_cast<unsigned int>(options.solver_iterations)));
+    record.name  = "cg";
+    record.flops = iterations * (2.0 * static_cast<double>(nnz) + 10 * dn);
+    record.bytes = iterations * (csr_bytes + 13 * dn * s);
+    run(op, record, options, writer);
+  }
+  {
+    solver_operation<ScalarType, viennacl::linalg::bicgstab_tag> op(A, viennacl::linalg::bicgstab_tag(1e-30, options.solver_iterations));
+    record.name  = "bicgstab";
+    record.flops = iterations * (4.0 * static_cast<double>(nnz) + 22 * dn);
+    record.bytes = iterations * (2 * csr_bytes + 28 * dn * s);
+    run(op, record, options, writer);
+  }
+  {
+    solver_operation<ScalarType, viennacl::linalg::gmres_tag> op(A, viennacl::linalg::gmres_tag(1e-30, options.solver_iterations, 20));
+    record.name  = "gmres";
+    record.flops = 0;  //depends on the Krylov space dimension in each iteration
+    record.bytes = 0;
+    run(op, record, options, writer);
+  }
+
+  // preconditioner setup and sparse factorizations (no operation count models):
+  record.flops = 0;
+  record.bytes = 0;
+  record.group = "precond";
+  {
+    setup_operation<viennacl::linalg::jacobi_precond< viennacl::compressed_matrix<ScalarType> >, ScalarType, viennacl::linalg::jacobi_tag> op(A, viennacl::linalg::jacobi_tag());
+    record.name = "jacobi";
+    run(op, record, options, writer);
+  }
+  {
+    setup_operation<viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<ScalarType> >, ScalarType, viennacl::linalg::ilu0_tag> op(A, viennacl::linalg::ilu0_tag());
+    record.name = "ilu0";
+    run(op, record, options, writer);
+  }
+  {
+    setup_operation<viennacl::linalg::ilut_precond< viennacl::compressed_matrix<ScalarType> >, ScalarType, viennacl::linalg::ilut_tag> op(A, viennacl::linalg::ilut_tag());
+    record.name = "ilut";
+    run(op, record, options, writer);
+  }
+  {
+    setup_operation<viennacl::linalg::ichol0_precond< viennacl::compressed_matrix<ScalarType> >, ScalarType, viennacl::linalg::ichol0_tag> op(A, viennacl::linalg::ichol0_tag());
+    record.name = "ichol0";
+    run(op, record, options, writer);
+  }
+
+  record.group = "factorization";
+  if (std::string("factorization/sparse_cholesky").find(options.filter) != std::string::npos)
+  {
+    viennacl::linalg::sparse_cholesky<ScalarType> chol(A);
+    if (!chol.factorized())
+    {
+      std::cerr << "  factorization/sparse_cholesky [" << instance << "]: skipped, matrix is not positive definite" << std::endl;
+      return;
+    }
+  }
+  {
+    setup_operation<viennacl::linalg::sparse_cholesky<ScalarType>, ScalarType, viennacl::linalg::sparse_cholesky_tag> op(A, viennacl::linalg::sparse_cholesky_tag());
+    record.name = "sparse_cholesky";
+    run(op, record, options, writer);
+  }
+  if (std::string("factorization/sparse_cholesky_numeric").find(options.filter) != std::string::npos)
+  {
+    sparse_cholesky_refactorization<ScalarType> op(A);
+    record.name = "sparse_cholesky_numeric";
+    run(op, record, options, writer);
+  }
+}
+
+/** @brief Sets up the 5-point finite difference Laplace operator on an n x n grid */
+template <typename ScalarType>
+void laplace_2d(std::size_t n, std::vector< std::map<unsigned int, ScalarType> > & A)
+{
+  A.clear();
+  A.resize(n * n);
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      unsigned int row = static_cast<unsigned int>(i * n + j);
+      A[row][row] = ScalarType(4);
+      if (i > 0)     A[row][static_cast<unsigned int>(row - n)] = ScalarType(-1);
+      if (i + 1 < n) A[row][static_cast<unsigned int>(row + n)] = ScalarType(-1);
+      if (j > 0)     A[row][row - 1] = ScalarType(-1);
+      if (j + 1 < n) A[row][row + 1] = ScalarType(-1);
+    }
+}
+
+template <typename ScalarType>
+int run_suite(suite_options const & options)
+{
+  std::size_t threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+  threads = static_cast<std::size_t>(omp_get_max_threads());
+#endif
+
+  std::cerr << "# Measuring the roofline of the host..." << std::endl;
+  roofline host;
+  host.bandwidth  = measure_stream_triad<ScalarType>(options.stream_size, 5);
+  host.peak_flops = measure_peak_flops<ScalarType>(3);
+  std::cerr << "  STREAM triad: " << host.bandwidth * 1e-9 << " GB/s, multiply-add throughput: " << host.peak_flops * 1e-9 << " GFLOP/s" << std::endl;
+
+#if defined(VIENNACL_WITH_OPENCL)
+  std::string backend = "opencl";
+#elif defined(VIENNACL_WITH_CUDA)
+  std::string backend = "cuda";
+#else
+  std::string backend = "host";
+#endif
+  result_writer writer(options, host, backend, threads);
+
+  std::cerr << "# Vector operations" << std::endl;
+  run_vector_benchmarks<ScalarType>(options, writer);
+
+  std::cerr << "# Dense matrix operations" << std::endl;
+  run_dense_benchmarks<ScalarType>(options, writer);
+
+  std::cerr << "# Sparse matrix operations" << std::endl;
+  std::vector< std::map<unsigned int, ScalarType> > cpu_matrix;
+  if (options.mtx_files.empty())
+  {
+    laplace_2d(options.grid_size, cpu_matrix);
+    std::ostringstream instance;
+    instance << "laplace2d-" << options.grid_size;
+    run_sparse_benchmarks(instance.str(), cpu_matrix, cpu_matrix.size(), options, writer);
+  }
+  for (std::size_t i = 0; i < options.mtx_files.size(); ++i)
+  {
+    cpu_matrix.clear();
+    if (!viennacl::io::read_matrix_market_file(cpu_matrix, options.mtx_files[i]))
+    {
+      std::cerr << "error: cannot read " << options.mtx_files[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::size_t cols = 0;
+    for (std::size_t row = 0; row < cpu_matrix.size(); ++row)
+      if (!cpu_matrix[row].empty())
+        cols = std::max<std::size_t>(cols, cpu_matrix[row].rbegin()->first + 1);
+    run_sparse_benchmarks(options.mtx_files[i], cpu_matrix, std::max(cols, cpu_matrix.size()), options, writer);
+  }
+
+  if (options.output.empty())
+    writer.write(std::cout);
+  else
+  {
+    std::ofstream file(options.output.c_str());
+    if (!file)
+    {
+      std::cerr << "error: cannot write " << options.output << std::endl;
+      return EXIT_FAILURE;
+    }
+    writer.write(file);
+    std::cerr << "# Results written to " << options.output << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
+
+
+int main(int argc, char* argv[])
+{
+  suite_options options = get_options(argc, argv);
+
+  if (options.precision == "float")
+    return run_suite<float>(options);
+  return run_suite<double>(options);
+}
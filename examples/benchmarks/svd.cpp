@@ -0,0 +1,187 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/*
+*
+*   Benchmark: Singular value decomposition for tall-skinny and square dense matrices,
+*              full versus randomized SVD for matrices with decaying singular values
+*
+*/
+
+//disable debug mechanisms to have a fair benchmark environment
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+//
+// include necessary system headers
+//
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+//
+// ViennaCL includes
+//
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/svd.hpp"
+#include "viennacl/linalg/randomized_svd.hpp"
+#include "viennacl/rand/gaussian.hpp"
+
+// Some helper functions for this tutorial:
+#include "../tutorial/Random.hpp"
+
+
+#include "benchmark-utils.hpp"
+
+
+template<typename ScalarType>
+void run_svd(std::size_t size1, std::size_t size2)
+{
+  Timer timer;
+  double exec_time;
+
+  std::vector<ScalarType> stl_A(size1 * size2);
+  for (std::size_t i = 0; i < stl_A.size(); ++i)
+    stl_A[i] = random<ScalarType>();
+
+  viennacl::matrix<ScalarType> vcl_A(size1, size2), vcl_QL(size1, size1), vcl_QR(size2, size2);
+
+  std::cout << " - Size: " << size1 << " x " << size2 << std::endl;
+
+  // full decomposition:
+  viennacl::fast_copy(&(stl_A[0]), &(stl_A[0]) + stl_A.size(), vcl_A);
+  viennacl::backend::finish();
+  timer.start();
+  viennacl::linalg::svd(vcl_A, vcl_QL, vcl_QR);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "   Singular values and vectors: " << exec_time << " sec" << std::endl;
+
+  // singular values only:
+  std::vector<ScalarType> sigma;
+  viennacl::fast_copy(&(stl_A[0]), &(stl_A[0]) + stl_A.size(), vcl_A);
+  viennacl::backend::finish();
+  timer.start();
+  viennacl::linalg::svd(vcl_A, sigma);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "   Singular values only:        " << exec_time << " sec" << std::endl;
+}
+
+template<typename ScalarType>
+void run_randomized_svd(std::size_t size1, std::size_t size2, std::size_t rank)
+{
+  Timer timer;
+  double exec_time;
+
+  // A = X * diag(d) * Y with geometrically decaying weights d:
+  std::size_t inner_size = 4 * rank;
+  viennacl::matrix<ScalarType> vcl_X = viennacl::random_matrix<ScalarType>(size1, inner_size, viennacl::rand::gaussian_tag(0, 1, 1));
+  viennacl::matrix<ScalarType> vcl_Y = viennacl::random_matrix<ScalarType>(inner_size, size2, viennacl::rand::gaussian_tag(0, 1, 2));
+  std::vector<std::vector<ScalarType> > stl_Y(inner_size, std::vector<ScalarType>(size2));
+  viennacl::copy(vcl_Y, stl_Y);
+  for (std::size_t i = 0; i < inner_size; ++i)
+    for (std::size_t j = 0; j < size2; ++j)
+      stl_Y[i][j] *= ScalarType(std::pow(0.97, double(i)));
+  viennacl::copy(stl_Y, vcl_Y);
+  viennacl::matrix<ScalarType> vcl_A = viennacl::linalg::prod(vcl_X, vcl_Y);
+
+  std::cout << " - Size: " << size1 << " x " << size2 << ", rank " << rank << std::endl;
+
+  std::vector<ScalarType> sigma_ref;
+  viennacl::backend::finish();
+  timer.start();
+  viennacl::linalg::svd(vcl_A, sigma_ref);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "   Full SVD (values only):   " << exec_time << " sec" << std::endl;
+
+  viennacl::matrix<ScalarType, viennacl::column_major> vcl_U(size1, rank), vcl_V(size2, rank);
+  for (std::size_t q = 0; q <= 2; q += 2)
+  {
+    viennacl::backend::finish();
+    timer.start();
+    std::vector<ScalarType> sigma = viennacl::linalg::svd(vcl_A, vcl_U, vcl_V, viennacl::linalg::randomized_svd_tag(rank, 10, q));
+    viennacl::backend::finish();
+    exec_time = timer.get();
+
+    double max_rel_error = 0;
+    for (std::size_t i = 0; i < rank; ++i)
+      max_rel_error = std::max(max_rel_error, std::fabs(double(sigma[i]) - double(sigma_ref[i])) / double(sigma_ref[i]));
+    std::cout << "   Randomized SVD (q = " << q << "):   " << exec_time << " sec, max. relative error of singular values: " << max_rel_error << std::endl;
+  }
+}
+
+template<typename ScalarType>
+int run_benchmark()
+{
+  std::cout << " ------ Benchmark 1: Tall-skinny matrices ------ " << std::endl;
+  run_svd<ScalarType>(2048,  64);
+  run_svd<ScalarType>(4096, 128);
+  run_svd<ScalarType>(4096, 512);
+  std::cout << std::endl;
+
+  std::cout << " ------ Benchmark 2: Square matrices ------ " << std::endl;
+  run_svd<ScalarType>( 256,  256);
+  run_svd<ScalarType>( 512,  512);
+  run_svd<ScalarType>(1024, 1024);
+  std::cout << std::endl;
+
+  std::cout << " ------ Benchmark 3: Full vs. randomized SVD ------ " << std::endl;
+  run_randomized_svd<ScalarType>(1024, 1024,  50);
+  run_randomized_svd<ScalarType>(2048, 1024, 100);
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "               Device Info" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+
+#ifdef VIENNACL_WITH_OPENCL
+  std::cout << viennacl::ocl::current_device().info() << std::endl;
+#endif
+
+
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Benchmark :: Singular Value Decomposition " << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  std::cout << "   # benchmarking single-precision" << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  run_benchmark<float>();
+#ifdef VIENNACL_WITH_OPENCL
+  if( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    std::cout << std::endl;
+    std::cout << "   -------------------------------" << std::endl;
+    std::cout << "   # benchmarking double-precision" << std::endl;
+    std::cout << "   -------------------------------" << std::endl;
+    run_benchmark<double>();
+  }
+  return 0;
+}
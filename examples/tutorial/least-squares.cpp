@@ -112,14 +112,14 @@ int main (int, const char **)
 
   std::cout << "Result: " << ublas_b2 << std::endl;
 
-  //////////// Part 2: Use ViennaCL types for BLAS 3 computations, but use Boost.uBLAS for the panel factorization ////////////////
+  //////////// Part 2: Use ViennaCL types throughout ////////////////
 
-  std::cout << "--- ViennaCL (hybrid implementation)  ---" << std::endl;
-  std::vector<ScalarType> hybrid_betas = viennacl::linalg::inplace_qr(vcl_A);
+  std::cout << "--- ViennaCL ---" << std::endl;
+  std::vector<ScalarType> vcl_betas = viennacl::linalg::inplace_qr(vcl_A);
 
   // compute modified RHS of the minimization problem:
   // b := Q^T b
-  viennacl::linalg::inplace_qr_apply_trans_Q(vcl_A, hybrid_betas, vcl_b);
+  viennacl::linalg::inplace_qr_apply_trans_Q(vcl_A, vcl_betas, vcl_b);
 
   // Final step: triangular solve: Rx = b'.
   // We only need the upper part of A such that R is a square matrix
@@ -137,8 +137,7 @@ int main (int, const char **)
   viennacl::copy(ublas_A, vcl_A);
 
   //
-  // Compute QR factorization of A. A is overwritten with Householder vectors. Coefficients are returned and a block size of 3 is used.
-  // Note that at the moment the number of columns of A must be divisible by the block size
+  // Compute QR factorization of A. A is overwritten with Householder vectors. Coefficients are returned.
   //
 
   std::cout << "--- Boost.uBLAS ---" << std::endl;
@@ -153,11 +152,11 @@ int main (int, const char **)
   std::cout << "Max rel error (ublas): " << ublas_error << std::endl;
 
   //
-  // QR factorization in ViennaCL using Boost.uBLAS for the panel factorization
+  // QR factorization in ViennaCL, operating directly on the ViennaCL matrix
   //
-  std::cout << "--- Hybrid (default) ---" << std::endl;
+  std::cout << "--- ViennaCL ---" << std::endl;
   viennacl::copy(ublas_A_backup, vcl_A);
-  std::vector<ScalarType> hybrid_betas = viennacl::linalg::inplace_qr(vcl_A);
+  std::vector<ScalarType> vcl_betas = viennacl::linalg::inplace_qr(vcl_A);
 
 
   //
@@ -165,9 +164,10 @@ int main (int, const char **)
   //
   viennacl::copy(vcl_A, ublas_A);
   Q.clear(); R.clear();
-  viennacl::linalg::recoverQ(ublas_A, hybrid_betas, Q, R);
-  double hybrid_error = check(ublas_QR, ublas_A_backup);
-  std::cout << "Max rel error (hybrid): " << hybrid_error << std::endl;
+  viennacl::linalg::recoverQ(ublas_A, vcl_betas, Q, R);
+  ublas_QR = prod(Q, R);
+  double vcl_error = check(ublas_QR, ublas_A_backup);
+  std::cout << "Max rel error (ViennaCL): " << vcl_error << std::endl;
 
 
   //
@@ -0,0 +1,267 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+//
+// *** System
+//
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <map>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/block_cg.hpp"
+#include "viennacl/linalg/block_gmres.hpp"
+
+/** @brief Sets up the five-point stencil of a 2D convection-diffusion operator, which is symmetric if convection is zero */
+template <typename ScalarType>
+void setup_system(std::size_t points_per_dim, ScalarType convection, viennacl::compressed_matrix<ScalarType> & A)
+{
+  std::size_t size = points_per_dim * points_per_dim;
+  std::vector< std::map<unsigned int, ScalarType> > stl_A(size);
+  for (std::size_t i=0; i<points_per_dim; ++i)
+    for (std::size_t j=0; j<points_per_dim; ++j)
+    {
+      unsigned int row = static_cast<unsigned int>(i * points_per_dim + j);
+      stl_A[row][row] = ScalarType(4);
+      if (i > 0)                  stl_A[row][row - points_per_dim] = ScalarType(-1) - convection;
+      if (j > 0)                  stl_A[row][row - 1]              = ScalarType(-1) - convection;
+      if (j < points_per_dim - 1) stl_A[row][row + 1]              = ScalarType(-1) + convection;
+      if (i < points_per_dim - 1) stl_A[row][row + points_per_dim] = ScalarType(-1) + convection;
+    }
+
+  viennacl::copy(stl_A, A);
+}
+
+/** @brief Sets up right hand sides with random columns, a zero column and a column which duplicates another one */
+template <typename ScalarType, typename F>
+void setup_rhs(viennacl::matrix<ScalarType, F> & B)
+{
+  std::vector< std::vector<ScalarType> > stl_B(B.size1(), std::vector<ScalarType>(B.size2()));
+  for (std::size_t i=0; i<B.size1(); ++i)
+  {
+    for (std::size_t j=0; j<B.size2(); ++j)
+      stl_B[i][j] = ScalarType(rand()) / ScalarType(RAND_MAX);
+    stl_B[i][1] = 0;
+    stl_B[i][B.size2() - 1] = stl_B[i][0];
+  }
+  viennacl::copy(stl_B, B);
+}
+
+/** @brief Returns the largest relative residual ||b_j - A x_j|| / ||b_j|| of all columns */
+template <typename ScalarType, typename F>
+ScalarType relative_residual(viennacl::compressed_matrix<ScalarType> const & A, viennacl::matrix<ScalarType, F> const & X, viennacl::matrix<ScalarType, F> const & B)
+{
+  viennacl::matrix<ScalarType, F> R(B.size1(), B.size2());
+  R = viennacl::linalg::prod(A, X);
+  R = B - R;
+
+  std::vector< std::vector<ScalarType> > stl_R(B.size1(), std::vector<ScalarType>(B.size2()));
+  std::vector< std::vector<ScalarType> > stl_B(B.size1(), std::vector<ScalarType>(B.size2()));
+  viennacl::copy(R, stl_R);
+  viennacl::copy(B, stl_B);
+
+  ScalarType max_residual = 0;
+  for (std::size_t j=0; j<B.size2(); ++j)
+  {
+    ScalarType norm_r = 0;
+    ScalarType norm_b = 0;
+    for (std::size_t i=0; i<B.size1(); ++i)
+    {
+      norm_r += stl_R[i][j] * stl_R[i][j];
+      norm_b += stl_B[i][j] * stl_B[i][j];
+    }
+    ScalarType rel = (norm_b > 0) ? std::sqrt(norm_r / norm_b) : std::sqrt(norm_r);
+    max_residual = std::max(max_residual, rel);
+  }
+  return max_residual;
+}
+
+template <typename ScalarType, typename F>
+int test_block_krylov(std::size_t points_per_dim, std::size_t num_rhs, double tolerance)
+{
+  std::size_t size = points_per_dim * points_per_dim;
+  std::cout << "  System of size " << size << ", " << num_rhs << " right hand sides" << std::endl;
+
+  viennacl::compressed_matrix<ScalarType> A_spd(size, size);
+  viennacl::compressed_matrix<ScalarType> A_nonsym(size, size);
+  setup_system(points_per_dim, ScalarType(0),   A_spd);
+  setup_system(points_per_dim, ScalarType(0.3), A_nonsym);
+
+  viennacl::matrix<ScalarType, F> B(size, num_rhs);
+  setup_rhs(B);
+
+  // block CG:
+  viennacl::linalg::block_cg_tag cg_tag(tolerance, 500);
+  viennacl::matrix<ScalarType, F> X = viennacl::linalg::solve(A_spd, B, cg_tag);
+  ScalarType residual = relative_residual(A_spd, X, B);
+  std::cout << "   Block CG: " << cg_tag.iters() << " iterations, relative residual " << residual << std::endl;
+  if (residual > 10 * tolerance || cg_tag.error() > tolerance)
+  {
+    std::cout << "# Error: Block CG did not converge" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (cg_tag.column_iters()[1] != 0)
+  {
+    std::cout << "# Error: Block CG iterated on zero right hand side" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // block GMRES:
+  viennacl::linalg::block_gmres_tag gmres_tag(tolerance, 500, 10);
+  X = viennacl::linalg::solve(A_nonsym, B, gmres_tag);
+  residual = relative_residual(A_nonsym, X, B);
+  std::cout << "   Block GMRES: " << gmres_tag.iters() << " iterations, relative residual " << residual << std::endl;
+  if (residual > 10 * tolerance || gmres_tag.error() > tolerance)
+  {
+    std::cout << "# Error: Block GMRES did not converge" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief Solves a tridiagonal system with right hand sides that converge at different iterations, so that the block is deflated several times */
+template <typename ScalarType, typename F>
+int test_staggered_convergence(std::size_t size, double tolerance)
+{
+  std::size_t num_rhs = 4;
+  std::cout << "  Tridiagonal system of size " << size << ", right hand sides converging at different iterations" << std::endl;
+
+  std::vector< std::map<unsigned int, ScalarType> > stl_A(size);
+  for (unsigned int i=0; i<size; ++i)
+  {
+    stl_A[i][i] = ScalarType(2.5);
+    if (i > 0)        stl_A[i][i-1] = ScalarType(-1);
+    if (i < size - 1) stl_A[i][i+1] = ScalarType(-1);
+  }
+  viennacl::compressed_matrix<ScalarType> A(size, size);
+  viennacl::copy(stl_A, A);
+
+  // columns 0, 1, 2 are combinations of 1, 3, and 10 eigenvectors sin(pi k (i+1) / (size+1)) of A, column 3 has components along all eigenvectors:
+  std::size_t num_eigenvectors[] = {1, 3, 10};
+  ScalarType pi = ScalarType(3.14159265358979323846);
+  std::vector< std::vector<ScalarType> > stl_B(size, std::vector<ScalarType>(num_rhs));
+  for (std::size_t i=0; i<size; ++i)
+  {
+    for (std::size_t j=0; j<3; ++j)
+      for (std::size_t k=1; k<=num_eigenvectors[j]; ++k)
+        stl_B[i][j] += std::sin(pi * ScalarType(k * (i+1)) / ScalarType(size + 1));
+    stl_B[i][3] = ScalarType(i % 7 + 1);
+  }
+  viennacl::matrix<ScalarType, F> B(size, num_rhs);
+  viennacl::copy(stl_B, B);
+
+  // the solvers reuse the host buffers of the small matrices while the block shrinks:
+  std::vector< std::vector<ScalarType> > G(num_rhs + 2, std::vector<ScalarType>(num_rhs + 3));
+  viennacl::linalg::detail::block_krylov_gram(B, B, G);
+  if (G.size() != num_rhs || G[0].size() != num_rhs)
+  {
+    std::cout << "# Error: Gram matrix has wrong size" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  viennacl::linalg::block_cg_tag cg_tag(tolerance, 2 * size);
+  viennacl::matrix<ScalarType, F> X = viennacl::linalg::solve(A, B, cg_tag);
+  ScalarType residual = relative_residual(A, X, B);
+  std::cout << "   Block CG: " << cg_tag.iters() << " iterations, relative residual " << residual << std::endl;
+  if (residual > 10 * tolerance || cg_tag.error() > tolerance)
+  {
+    std::cout << "# Error: Block CG did not converge" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::vector<unsigned int> const & column_iters = cg_tag.column_iters();
+  if (column_iters[0] >= column_iters[1] || column_iters[1] >= column_iters[2] || column_iters[2] >= column_iters[3])
+  {
+    std::cout << "# Error: Block CG did not deflate converged right hand sides" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  viennacl::linalg::block_gmres_tag gmres_tag(tolerance, 2 * size, 10);
+  X = viennacl::linalg::solve(A, B, gmres_tag);
+  residual = relative_residual(A, X, B);
+  std::cout << "   Block GMRES: " << gmres_tag.iters() << " iterations, relative residual " << residual << std::endl;
+  if (residual > 10 * tolerance || gmres_tag.error() > tolerance)
+  {
+    std::cout << "# Error: Block GMRES did not converge" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+template <typename ScalarType>
+int test(double tolerance)
+{
+  std::cout << " Row-major:" << std::endl;
+  if (test_block_krylov<ScalarType, viennacl::row_major>(20, 8, tolerance) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_block_krylov<ScalarType, viennacl::row_major>(7, 3, tolerance) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_staggered_convergence<ScalarType, viennacl::row_major>(200, tolerance) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << " Column-major:" << std::endl;
+  if (test_block_krylov<ScalarType, viennacl::column_major>(20, 8, tolerance) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_staggered_convergence<ScalarType, viennacl::column_major>(200, tolerance) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Block Krylov solvers" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: float" << std::endl;
+  if (test<float>(1e-4) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if ( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    if (test<double>(1e-8) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,173 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+//
+// *** System
+//
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <map>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/ocl/command_batch.hpp"
+
+typedef double   NumericT;
+
+/** @brief State of a conjugate gradient solver with all coefficients residing on the device */
+struct cg_state
+{
+  cg_state(viennacl::vector<NumericT> const & rhs)
+    : x(rhs.size()), r(rhs), p(rhs), Ap(rhs.size()), rr(0), pAp(0), rr_new(0), alpha(0), beta(0)
+  {
+    rr = viennacl::linalg::inner_prod(r, r);
+  }
+
+  viennacl::vector<NumericT> x, r, p, Ap;
+  viennacl::scalar<NumericT> rr, pAp, rr_new, alpha, beta;
+};
+
+void cg_iteration(viennacl::compressed_matrix<NumericT> const & A, cg_state & s)
+{
+  s.Ap = viennacl::linalg::prod(A, s.p);
+  s.pAp = viennacl::linalg::inner_prod(s.p, s.Ap);
+  s.alpha = s.rr / s.pAp;
+  s.x += s.alpha * s.p;
+  s.r -= s.alpha * s.Ap;
+  s.rr_new = viennacl::linalg::inner_prod(s.r, s.r);
+  s.beta = s.rr_new / s.rr;
+  s.p = s.r + s.beta * s.p;
+  s.rr = s.rr_new;
+}
+
+int test()
+{
+  std::size_t N = 1000;
+  std::size_t iterations = 20;
+
+  std::vector< std::map<unsigned int, NumericT> > std_A(N);
+  for (std::size_t i=0; i<N; ++i)
+  {
+    std_A[i][static_cast<unsigned int>(i)] = 4.0;
+    if (i > 0)     std_A[i][static_cast<unsigned int>(i - 1)] = -1.0;
+    if (i + 1 < N) std_A[i][static_cast<unsigned int>(i + 1)] = -1.0;
+  }
+  viennacl::compressed_matrix<NumericT> A(N, N);
+  viennacl::copy(std_A, A);
+
+  std::vector<NumericT> std_b(N);
+  for (std::size_t i=0; i<N; ++i)
+    std_b[i] = NumericT(1) + NumericT(i % 7);
+  viennacl::vector<NumericT> b(N);
+  viennacl::copy(std_b, b);
+
+  //
+  // Reference: iterations issued operation by operation
+  //
+  std::cout << " Running reference iterations..." << std::endl;
+  cg_state reference(b);
+  for (std::size_t i=0; i<iterations; ++i)
+    cg_iteration(A, reference);
+
+  //
+  // Record the first iteration, replay the others
+  //
+  std::cout << " Recording and replaying iterations..." << std::endl;
+  cg_state replayed(b);
+  viennacl::ocl::command_batch batch;
+  batch.start_recording();
+  cg_iteration(A, replayed);
+  batch.stop_recording();
+
+  if (batch.size() == 0)
+  {
+    std::cout << "# Error: Nothing recorded" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (std::size_t i=1; i<iterations; ++i)
+    batch.replay();
+
+  viennacl::vector<NumericT> diff = reference.x - replayed.x;
+  NumericT error = viennacl::linalg::norm_2(diff) / viennacl::linalg::norm_2(reference.x);
+  std::cout << " Relative difference of solutions: " << error << std::endl;
+  if (error > 1e-10)
+  {
+    std::cout << "# Error: Replayed iterations differ from reference" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  NumericT residual = NumericT(reference.rr);
+  NumericT residual_replayed = NumericT(replayed.rr);
+  if (std::fabs(residual - residual_replayed) > 1e-10 * std::fabs(residual) + 1e-30)
+  {
+    std::cout << "# Error: Replayed residual differs from reference" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // Replaying after clear() does nothing
+  //
+  batch.clear();
+  batch.replay();
+  diff = reference.x - replayed.x;
+  if (viennacl::linalg::norm_2(diff) / viennacl::linalg::norm_2(reference.x) > 1e-10)
+  {
+    std::cout << "# Error: Cleared batch modified data" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Command Batches" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  if (viennacl::ocl::current_device().double_support())
+  {
+    if (test() != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+  else
+    std::cout << "No double precision support, skipping test..." << std::endl;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -53,13 +53,13 @@
 #include "viennacl/linalg/gmres.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
 #include "viennacl/linalg/qr.hpp"
+#include "viennacl/linalg/svd.hpp"
 
 #include "viennacl/misc/bandwidth_reduction.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
   #include "viennacl/linalg/amg.hpp"
   #include "viennacl/linalg/spai.hpp"
-  #include "viennacl/linalg/svd.hpp"
   #include "viennacl/fft.hpp"
   #include "viennacl/generator/generate.hpp"
 #endif
@@ -0,0 +1,422 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// *** System
+//
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cmath>
+#include <cstdlib>
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <dirent.h>
+
+//
+// *** Boost
+//
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+
+//
+// *** ViennaCL
+//
+#define VIENNACL_WITH_UBLAS 1
+
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/generator/host_generate.hpp"
+
+using namespace boost::numeric;
+
+#define CHECK_RESULT(cpu, vcl, op) \
+    if ( diff(cpu, vcl) > epsilon ) { \
+        std::cout << "# Error at operation: " #op << std::endl; \
+        std::cout << "  diff: " << diff(cpu, vcl) << std::endl; \
+        return EXIT_FAILURE; \
+    }
+
+template <typename ScalarType>
+ScalarType diff(ScalarType s1, viennacl::scalar<ScalarType> const & s2)
+{
+  ScalarType other = s2;
+  return std::fabs(s1 - other) / std::max(std::fabs(s1), std::fabs(other));
+}
+
+template <typename ScalarType, typename VCLVectorType>
+ScalarType diff(ublas::vector<ScalarType> const & v1, VCLVectorType const & v2)
+{
+  ublas::vector<ScalarType> v2_cpu(v2.size());
+  viennacl::copy(v2.begin(), v2.end(), v2_cpu.begin());
+  ScalarType ret = 0;
+  for (std::size_t i=0; i<v1.size(); ++i)
+    ret = std::max(ret, std::fabs(v2_cpu[i] - v1[i]) / std::max(std::fabs(v2_cpu[i]), std::fabs(v1[i])));
+  return ret;
+}
+
+template <typename ScalarType, typename VCLMatrixType>
+ScalarType diff(ublas::matrix<ScalarType> const & m1, VCLMatrixType const & m2)
+{
+  ublas::matrix<ScalarType> m2_cpu(m2.size1(), m2.size2());
+  viennacl::copy(m2, m2_cpu);
+  ScalarType ret = 0;
+  for (std::size_t i=0; i<m1.size1(); ++i)
+    for (std::size_t j=0; j<m1.size2(); ++j)
+      ret = std::max(ret, std::fabs(m2_cpu(i,j) - m1(i,j)) / std::max(std::fabs(m2_cpu(i,j)), std::fabs(m1(i,j))));
+  return ret;
+}
+
+template <typename NumericT, typename Epsilon>
+int test_vector(Epsilon const & epsilon)
+{
+  std::size_t size = 7001;
+
+  ublas::vector<NumericT> cw(size), cx(size), cy(size), cz(size);
+  for (std::size_t i=0; i<size; ++i)
+  {
+    cx[i] = NumericT(1) + NumericT(std::rand()) / NumericT(RAND_MAX);
+    cy[i] = NumericT(1) + NumericT(std::rand()) / NumericT(RAND_MAX);
+    cz[i] = NumericT(1) + NumericT(std::rand()) / NumericT(RAND_MAX);
+  }
+  cw = cx;
+
+  viennacl::vector<NumericT> w(size), x(size), y(size), z(size);
+  viennacl::copy(cw, w);
+  viennacl::copy(cx, x);
+  viennacl::copy(cy, y);
+  viennacl::copy(cz, z);
+  viennacl::scalar<NumericT> gs(0), gt(0);
+
+  NumericT alpha = NumericT(3.14);
+  NumericT beta  = NumericT(0.51);
+  viennacl::scalar<NumericT> gpu_beta = beta;
+
+  {
+  std::cout << "w = alpha*x + beta*y - element_prod(x, z) + element_exp(y / 4) ..." << std::endl;
+  for (std::size_t i=0; i<size; ++i)
+    cw[i] = alpha * cx[i] + beta * cy[i] - cx[i] * cz[i] + std::exp(cy[i] / NumericT(4));
+  viennacl::scheduler::statement statement(w, viennacl::op_assign(), alpha*x + gpu_beta*y - viennacl::linalg::element_prod(x, z) + viennacl::linalg::element_exp(y / NumericT(4)));
+  if (!viennacl::generator::host::generate_enqueue_statement(statement))
+  {
+    std::cout << "# Error: Statement not supported" << std::endl;
+    return EXIT_FAILURE;
+  }
+  CHECK_RESULT(cw, w, w = alpha*x + beta*y - element_prod(x, z) + element_exp(y / 4));
+  }
+
+  {
+  std::cout << "Multiple statements fused: x += w; z = element_div(x, y); ..." << std::endl;
+  cx += cw;
+  cz = element_div(cx, cy);
+  viennacl::scheduler::statement s1(x, viennacl::op_inplace_add(), w);
+  viennacl::scheduler::statement s2(z, viennacl::op_assign(), viennacl::linalg::element_div(x, y));
+  viennacl::generator::host::code_generator gen;
+  gen.add(s1, s1.array()[0]);
+  gen.add(s2, s2.array()[0]);
+  if (gen.num_kernels() != 1)
+  {
+    std::cout << "# Error: Statements not fused into a single kernel" << std::endl;
+    return EXIT_FAILURE;
+  }
+  viennacl::generator::host::enqueue(gen);
+  CHECK_RESULT(cx, x, x += w);
+  CHECK_RESULT(cz, z, z = element_div(x, y));
+  }
+
+  {
+  std::cout << "s = inner_prod(x, y); t = inner_prod(x - y, z) ..." << std::endl;
+  NumericT s = 0, t = 0;
+  for (std::size_t i=0; i<size; ++i)
+  {
+    s += cx[i] * cy[i];
+    t += (cx[i] - cy[i]) * cz[i];
+  }
+  viennacl::scheduler::statement s1(gs, viennacl::op_assign(), viennacl::linalg::inner_prod(x, y));
+  viennacl::scheduler::statement s2(gt, viennacl::op_assign(), viennacl::linalg::inner_prod(x - y, z));
+  viennacl::generator::host::code_generator gen;
+  gen.add(s1, s1.array()[0]);
+  gen.add(s2, s2.array()[0]);
+  if (gen.num_kernels() != 1)
+  {
+    std::cout << "# Error: Inner products not fused into a single kernel" << std::endl;
+    return EXIT_FAILURE;
+  }
+  viennacl::generator::host::enqueue(gen);
+  CHECK_RESULT(s, gs, s = inner_prod(x, y));
+  CHECK_RESULT(t, gt, t = inner_prod(x - y, z));
+  }
+
+  {
+  std::cout << "Ranges and slices ..." << std::endl;
+  ublas::range r(size / 4, size / 4 + size / 3);
+  ublas::slice sl(size / 3, 2, size / 3);
+  ublas::vector_range<ublas::vector<NumericT> > cr(cw, r);
+  ublas::vector_slice<ublas::vector<NumericT> > cs(cx, sl);
+  viennacl::range vr(size / 4, size / 4 + size / 3);
+  viennacl::slice vs(size / 3, 2, size / 3);
+  viennacl::vector_range<viennacl::vector<NumericT> > gr(w, vr);
+  viennacl::vector_slice<viennacl::vector<NumericT> > gsl(x, vs);
+
+  cr = cs - alpha * element_prod(cs, cs);
+  viennacl::scheduler::statement statement(gr, viennacl::op_assign(), gsl - alpha * viennacl::linalg::element_prod(gsl, gsl));
+  viennacl::generator::host::generate_enqueue_statement(statement);
+  CHECK_RESULT(cw, w, w(r) = x(s) - alpha * element_prod(x(s), x(s)));
+  }
+
+  return EXIT_SUCCESS;
+}
+
+template <typename NumericT, typename F, typename Epsilon>
+int test_matrix(Epsilon const & epsilon)
+{
+  std::size_t M = 131, N = 67, K = 43;
+
+  ublas::matrix<NumericT> cA(M, K), cB(K, N), cC(M, N), cD(M, N), cBt(N, K);
+  for (std::size_t i=0; i<cA.size1(); ++i)
+    for (std::size_t j=0; j<cA.size2(); ++j)
+      cA(i,j) = NumericT(1) + NumericT(std::rand()) / NumericT(RAND_MAX);
+  for (std::size_t i=0; i<cB.size1(); ++i)
+    for (std::size_t j=0; j<cB.size2(); ++j)
+      cB(i,j) = NumericT(1) + NumericT(std::rand()) / NumericT(RAND_MAX);
+  for (std::size_t i=0; i<cC.size1(); ++i)
+    for (std::size_t j=0; j<cC.size2(); ++j)
+      cC(i,j) = NumericT(1) + NumericT(std::rand()) / NumericT(RAND_MAX);
+  cBt = trans(cB);
+  cD = cC;
+
+  viennacl::matrix<NumericT, F> A(M, K), B(K, N), C(M, N), D(M, N);
+  viennacl::matrix<NumericT, viennacl::row_major> Bt(N, K);
+  viennacl::copy(cA, A);
+  viennacl::copy(cB, B);
+  viennacl::copy(cBt, Bt);
+  viennacl::copy(cC, C);
+  viennacl::copy(cD, D);
+
+  ublas::vector<NumericT> cx(K), cy(M), cz(N);
+  for (std::size_t i=0; i<K; ++i)
+    cx[i] = NumericT(1) + NumericT(i % 7);
+  for (std::size_t i=0; i<M; ++i)
+    cy[i] = NumericT(1) + NumericT(i % 5);
+  viennacl::vector<NumericT> x(K), y(M), z(N);
+  viennacl::copy(cx, x);
+  viennacl::copy(cy, y);
+
+  NumericT alpha = NumericT(0.25);
+
+  {
+  std::cout << "D = alpha * C - element_sqrt(element_prod(C, C)) ..." << std::endl;
+  for (std::size_t i=0; i<M; ++i)
+    for (std::size_t j=0; j<N; ++j)
+      cD(i,j) = alpha * cC(i,j) - std::sqrt(cC(i,j) * cC(i,j));
+  viennacl::scheduler::statement statement(D, viennacl::op_assign(), alpha * C - viennacl::linalg::element_sqrt(viennacl::linalg::element_prod(C, C)));
+  viennacl::generator::host::generate_enqueue_statement(statement);
+  CHECK_RESULT(cD, D, D = alpha * C - element_sqrt(element_prod(C, C)));
+  }
+
+  {
+  std::cout << "y = prod(A, x) ..." << std::endl;
+  cy = prod(cA, cx);
+  viennacl::scheduler::statement statement(y, viennacl::op_assign(), viennacl::linalg::prod(A, x));
+  if (!viennacl::generator::host::generate_enqueue_statement(statement))
+  {
+    std::cout << "# Error: Statement not supported" << std::endl;
+    return EXIT_FAILURE;
+  }
+  CHECK_RESULT(cy, y, y = prod(A, x));
+  }
+
+  {
+  std::cout << "x -= prod(trans(A), y) ..." << std::endl;
+  cx -= prod(trans(cA), cy);
+  viennacl::scheduler::statement statement(x, viennacl::op_inplace_sub(), viennacl::linalg::prod(trans(A), y));
+  if (!viennacl::generator::host::generate_enqueue_statement(statement))
+  {
+    std::cout << "# Error: Statement not supported" << std::endl;
+    return EXIT_FAILURE;
+  }
+  CHECK_RESULT(cx, x, x -= prod(trans(A), y));
+  }
+
+  {
+  std::cout << "C = prod(A, B) ..." << std::endl;
+  cC = prod(cA, cB);
+  viennacl::scheduler::statement statement(C, viennacl::op_assign(), viennacl::linalg::prod(A, B));
+  if (!viennacl::generator::host::generate_enqueue_statement(statement))
+  {
+    std::cout << "# Error: Statement not supported" << std::endl;
+    return EXIT_FAILURE;
+  }
+  CHECK_RESULT(cC, C, C = prod(A, B));
+  }
+
+  {
+  std::cout << "C += prod(A, trans(Bt)) ..." << std::endl;
+  cC += prod(cA, trans(cBt));
+  viennacl::scheduler::statement statement(C, viennacl::op_inplace_add(), viennacl::linalg::prod(A, trans(Bt)));
+  viennacl::generator::host::generate_enqueue_statement(statement);
+  CHECK_RESULT(cC, C, C += prod(A, trans(Bt)));
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief The program cache must not load shared objects from directories writable by other users */
+int test_untrusted_cache_directory()
+{
+  char path[] = "/tmp/viennacl_host_test_XXXXXX";
+  if (mkdtemp(path) == NULL || chmod(path, 0777) != 0)
+  {
+    std::cout << "# Error: cannot create temporary directory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  viennacl::generator::host::program_cache cache;
+  cache.path(path);
+  bool exception_thrown = false;
+  try
+  {
+    cache.add_program("untrusted", "extern \"C\" void kernel_0(void * const *, long const *) {}", 1);
+  }
+  catch (viennacl::generator::host::jit_exception const &)
+  {
+    exception_thrown = true;
+  }
+  rmdir(path);
+
+  if (!exception_thrown || cache.num_compilations() != 0)
+  {
+    std::cout << "# Error: program cache uses a world-writable directory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int test_cache_directory_reuse()
+{
+  char path[] = "/tmp/viennacl_host_test_XXXXXX";
+  if (mkdtemp(path) == NULL)
+  {
+    std::cout << "# Error: cannot create temporary directory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::string source = "extern \"C\" void kernel_0(void * const *, long const *) {}";
+
+  viennacl::generator::host::program_cache first_cache;
+  first_cache.path(path);
+  first_cache.add_program("reused", source, 1);
+
+  //a second cache finds the shared object on disk:
+  viennacl::generator::host::program_cache second_cache;
+  second_cache.path(path);
+  second_cache.add_program("reused", source, 1);
+
+  //a different source file under the same name, as after a hash collision, must not be taken for the program:
+  std::vector<std::string> files;
+  if (DIR * dir = opendir(path))
+  {
+    while (dirent * entry = readdir(dir))
+      if (entry->d_name[0] != '.')
+        files.push_back(std::string(path) + "/" + entry->d_name);
+    closedir(dir);
+  }
+  for (std::size_t i = 0; i < files.size(); ++i)
+    if (files[i].size() > 4 && files[i].substr(files[i].size() - 4) == ".cpp")
+      std::ofstream(files[i].c_str(), std::ios::app) << "\n//other program\n";
+
+  viennacl::generator::host::program_cache third_cache;
+  third_cache.path(path);
+  third_cache.add_program("reused", source, 1);
+
+  std::size_t num_files = 0;
+  if (DIR * dir = opendir(path))
+  {
+    while (dirent * entry = readdir(dir))
+      if (entry->d_name[0] != '.')
+      {
+        std::remove((std::string(path) + "/" + entry->d_name).c_str());
+        ++num_files;
+      }
+    closedir(dir);
+  }
+  rmdir(path);
+
+  if (first_cache.num_compilations() != 1 || second_cache.num_compilations() != 0)
+  {
+    std::cout << "# Error: program cache does not reuse shared objects on disk" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (third_cache.num_compilations() != 1 || num_files != 4)
+  {
+    std::cout << "# Error: program cache loads a shared object compiled from a different source" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Host Kernel Generator" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << "# Testing untrusted cache directory" << std::endl;
+  if (test_untrusted_cache_directory() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "# Testing reuse of the cache directory" << std::endl;
+  if (test_cache_directory_reuse() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: float" << std::endl;
+  if (test_vector<float>(1e-4f) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_matrix<float, viennacl::row_major>(1e-4f) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_matrix<float, viennacl::column_major>(1e-4f) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: double" << std::endl;
+  if (test_vector<double>(1e-10) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_matrix<double, viennacl::row_major>(1e-10) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_matrix<double, viennacl::column_major>(1e-10) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
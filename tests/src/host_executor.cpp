@@ -0,0 +1,320 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+#define VIENNACL_WITH_HOST_ASYNC
+
+//
+// *** System
+//
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <map>
+#include <stdexcept>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/symmetric_compressed_matrix.hpp"
+#include "viennacl/coordinate_matrix.hpp"
+#include "viennacl/ell_matrix.hpp"
+#include "viennacl/hyb_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_1.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/norm_inf.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/backend/host_executor.hpp"
+
+/** @brief Sets up the finite difference Laplace operator on a structured nx x ny grid */
+template <typename ScalarType>
+void laplace(std::size_t nx, std::size_t ny, std::vector< std::map<unsigned int, ScalarType> > & A)
+{
+  A.clear();
+  A.resize(nx * ny);
+  for (std::size_t j=0; j<ny; ++j)
+    for (std::size_t i=0; i<nx; ++i)
+    {
+      unsigned int row = static_cast<unsigned int>(j * nx + i);
+      A[row][row] = ScalarType(4);
+      if (i > 0)      A[row][row - 1] = ScalarType(-1);
+      if (i + 1 < nx) A[row][row + 1] = ScalarType(-1);
+      if (j > 0)      A[row][static_cast<unsigned int>(row - nx)] = ScalarType(-1);
+      if (j + 1 < ny) A[row][static_cast<unsigned int>(row + nx)] = ScalarType(-1);
+    }
+}
+
+template <typename ScalarType>
+bool check(std::vector<ScalarType> const & reference, viennacl::vector<ScalarType> const & result, double epsilon, char const * name)
+{
+  std::vector<ScalarType> host_result(result.size());
+  viennacl::copy(result, host_result);   //waits for pending tasks writing to 'result'
+
+  double max_diff = 0;
+  for (std::size_t i=0; i<reference.size(); ++i)
+  {
+    double diff = std::fabs(static_cast<double>(reference[i] - host_result[i])) / std::max<double>(1.0, std::fabs(static_cast<double>(reference[i])));
+    max_diff = std::max(max_diff, diff);
+  }
+  if (max_diff > epsilon)
+  {
+    std::cout << "# Error in " << name << ": relative difference " << max_diff << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/** @brief Runs a sequence of operations with independent and dependent parts. Results are stored in the vectors passed. */
+template <typename ScalarType>
+void run_operations(viennacl::compressed_matrix<ScalarType> const & A,
+                    viennacl::matrix<ScalarType> const & B,
+                    std::vector<ScalarType> const & std_x,
+                    std::vector< std::vector<ScalarType> > & results)
+{
+  std::size_t N = std_x.size();
+  viennacl::vector<ScalarType> x(N);
+  viennacl::copy(std_x, x);
+
+  viennacl::vector<ScalarType> y1(N), y2(N), y3(N), w(N), v(N), u(B.size1());
+  viennacl::scalar<ScalarType> s1 = 0, s2 = 0, s3 = 0;
+
+  for (std::size_t iter=0; iter<5; ++iter)
+  {
+    //independent sparse matrix-vector products:
+    y1 = viennacl::linalg::prod(A, x);
+    y2 = viennacl::linalg::prod(A, y1);
+    {
+      viennacl::vector<ScalarType> tmp = x + y1;
+      y3 = viennacl::linalg::prod(A, tmp);           //'tmp' is destroyed before the product has completed
+    }
+
+    //reductions into device scalars, followed by operations using them:
+    s1 = viennacl::linalg::inner_prod(y1, y2);
+    s2 = viennacl::linalg::norm_2(y3);
+    s3 = viennacl::linalg::norm_1(y1);
+    w  = y1 / s2 - y2 / s1;
+    w += s3 / s1 * y3;
+    v  = ScalarType(0.5) * w;
+    v += w + ScalarType(2) * y1;
+    s2 = viennacl::linalg::norm_inf(v);
+    x  = v / s2;
+
+    //dense matrix-vector product:
+    u  = viennacl::linalg::prod(B, x);
+  }
+
+  results.resize(4);
+  viennacl::vector<ScalarType> const * vectors[4] = { &x, &y3, &w, &u };
+  for (std::size_t i=0; i<4; ++i)
+  {
+    results[i].resize(vectors[i]->size());
+    viennacl::copy(*vectors[i], results[i]);
+  }
+}
+
+
+/** @brief Runs a product with a sparse matrix which is destroyed before the product has completed */
+template <typename MatrixType, typename ScalarType>
+bool check_temporary_sparse_matrix(std::vector< std::map<unsigned int, ScalarType> > const & std_A,
+                                   std::vector<ScalarType> const & reference, viennacl::vector<ScalarType> const & x,
+                                   double epsilon, char const * name)
+{
+  viennacl::vector<ScalarType> y(x.size());
+  for (std::size_t repeat=0; repeat<5; ++repeat)
+  {
+    {
+      MatrixType A;
+      viennacl::tools::const_sparse_matrix_adapter<ScalarType> adapted_A(std_A, std_A.size(), std_A.size());
+      viennacl::copy(adapted_A, A);
+      y = viennacl::linalg::prod(A, x);
+    }
+    if (!check(reference, y, epsilon, name))
+      return false;
+  }
+  return true;
+}
+
+template <typename ScalarType>
+int test(double epsilon)
+{
+  viennacl::backend::host_executor & executor = viennacl::backend::current_host_executor();
+
+  std::vector< std::map<unsigned int, ScalarType> > std_A;
+  laplace<ScalarType>(60, 50, std_A);
+  std::size_t N = std_A.size();
+  viennacl::compressed_matrix<ScalarType> A(N, N);
+  viennacl::copy(std_A, A);
+
+  std::vector< std::vector<ScalarType> > std_B(37, std::vector<ScalarType>(N));
+  for (std::size_t i=0; i<std_B.size(); ++i)
+    for (std::size_t j=0; j<N; ++j)
+      std_B[i][j] = ScalarType((i + 3 * j) % 11) / ScalarType(11);
+  viennacl::matrix<ScalarType> B(std_B.size(), N);
+  viennacl::copy(std_B, B);
+
+  std::vector<ScalarType> std_x(N);
+  for (std::size_t i=0; i<N; ++i)
+    std_x[i] = ScalarType(1) + ScalarType(i % 13) / ScalarType(13);
+
+  //
+  // synchronous reference:
+  //
+  std::vector< std::vector<ScalarType> > reference;
+  run_operations(A, B, std_x, reference);
+
+  viennacl::vector<ScalarType> rhs(N);
+  viennacl::copy(std_x, rhs);
+  viennacl::linalg::bicgstab_tag bicgstab_tag(ScalarType(epsilon), 300);
+  viennacl::vector<ScalarType> reference_solution = viennacl::linalg::solve(A, rhs, bicgstab_tag);
+
+  //
+  // asynchronous execution:
+  //
+  executor.start(4);
+  std::cout << " Testing asynchronous operations with " << executor.num_workers() << " workers..." << std::endl;
+  for (std::size_t repeat=0; repeat<10; ++repeat)  //repeated to expose races
+  {
+    std::vector< std::vector<ScalarType> > results;
+    run_operations(A, B, std_x, results);
+
+    viennacl::vector<ScalarType> result(N);
+    char const * names[4] = { "x", "y3", "w", "u" };
+    for (std::size_t i=0; i<4; ++i)
+    {
+      result.resize(results[i].size(), false);
+      viennacl::copy(results[i], result);
+      if (!check(reference[i], result, epsilon, names[i]))
+        return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << " Testing BiCGStab solver..." << std::endl;
+  viennacl::vector<ScalarType> solution = viennacl::linalg::solve(A, rhs, bicgstab_tag);
+  std::vector<ScalarType> std_reference_solution(N);
+  viennacl::copy(reference_solution, std_reference_solution);
+  if (!check(std_reference_solution, solution, 100 * epsilon, "BiCGStab"))
+    return EXIT_FAILURE;
+
+  std::cout << " Testing sparse matrices destroyed before the products have completed..." << std::endl;
+  viennacl::vector<ScalarType> y_reference = viennacl::linalg::prod(A, rhs);
+  std::vector<ScalarType> std_y_reference(N);
+  viennacl::copy(y_reference, std_y_reference);
+  if (   !check_temporary_sparse_matrix< viennacl::compressed_matrix<ScalarType> >(std_A, std_y_reference, rhs, epsilon, "compressed_matrix")
+      || !check_temporary_sparse_matrix< viennacl::symmetric_compressed_matrix<ScalarType> >(std_A, std_y_reference, rhs, epsilon, "symmetric_compressed_matrix")
+      || !check_temporary_sparse_matrix< viennacl::coordinate_matrix<ScalarType> >(std_A, std_y_reference, rhs, epsilon, "coordinate_matrix")
+      || !check_temporary_sparse_matrix< viennacl::ell_matrix<ScalarType> >(std_A, std_y_reference, rhs, epsilon, "ell_matrix")
+      || !check_temporary_sparse_matrix< viennacl::hyb_matrix<ScalarType> >(std_A, std_y_reference, rhs, epsilon, "hyb_matrix"))
+    return EXIT_FAILURE;
+
+  std::cout << " Testing finish()..." << std::endl;
+  viennacl::vector<ScalarType> z(N);
+  viennacl::copy(std_x, z);
+  for (std::size_t i=0; i<20; ++i)
+    z = viennacl::linalg::prod(A, z) / ScalarType(8);
+  viennacl::backend::finish();
+  viennacl::vector<ScalarType> z_copy = z;   //host-based copy, no wait required after finish()
+  executor.stop();
+
+  viennacl::copy(std_x, z);
+  for (std::size_t i=0; i<20; ++i)
+    z = viennacl::linalg::prod(A, z) / ScalarType(8);
+  std::vector<ScalarType> std_z(N);
+  viennacl::copy(z, std_z);
+  if (!check(std_z, z_copy, epsilon, "finish()"))
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief A task which writes a buffer and fails */
+class failing_task : public viennacl::backend::host_task
+{
+  public:
+    failing_task(void const * buffer) { writes(buffer); }
+    void run() { throw std::runtime_error("failing_task"); }
+};
+
+int test_task_errors()
+{
+  viennacl::backend::host_executor & executor = viennacl::backend::current_host_executor();
+  executor.start();
+  if (executor.num_workers() < 2)
+  {
+    std::cout << "# Error: executor started with " << executor.num_workers() << " workers" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  int buffer = 0;
+  int other_buffer = 0;
+  executor.enqueue(new failing_task(&buffer));
+
+  bool thrown_for_other_buffer = false;
+  bool thrown_for_buffer = false;
+  bool thrown_again = false;
+  try { executor.wait(&other_buffer); } catch (std::exception const &) { thrown_for_other_buffer = true; }
+  try { executor.wait(&buffer); } catch (std::exception const &) { thrown_for_buffer = true; }
+  try { executor.wait_all(); } catch (std::exception const &) { thrown_again = true; }
+  executor.stop();
+
+  if (thrown_for_other_buffer || !thrown_for_buffer || thrown_again)
+  {
+    std::cout << "# Error: error of a task not reported by wait() for its buffer" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Asynchronous Host Execution" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << "# Testing errors of tasks" << std::endl;
+  if (test_task_errors() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: float" << std::endl;
+  if (test<float>(1e-4) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: double" << std::endl;
+  if (test<double>(1e-10) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
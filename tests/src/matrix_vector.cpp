@@ -44,6 +44,7 @@
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
 #include "viennacl/linalg/lu.hpp"
+#include "viennacl/linalg/cholesky.hpp"
 #include "examples/tutorial/Random.hpp"
 
 //
@@ -1042,6 +1043,80 @@ int test(Epsilon const& epsilon)
       retval = EXIT_FAILURE;
    }
 
+   //full solver with partial pivoting (zero diagonal, several panels):
+   std::cout << "Full solver with pivoting" << std::endl;
+   unsigned int piv_dim = 150;
+   ublas::matrix<NumericT> piv_matrix(piv_dim, piv_dim);
+   ublas::vector<NumericT> piv_rhs(piv_dim);
+   viennacl::matrix<NumericT, F> vcl_piv_matrix(piv_dim, piv_dim);
+   viennacl::vector<NumericT> vcl_piv_rhs(piv_dim);
+
+   //put weight on a cyclically shifted diagonal, so that pivoting is required:
+   for (std::size_t i=0; i<piv_dim; ++i)
+   {
+     for (std::size_t j=0; j<piv_dim; ++j)
+       piv_matrix(i,j) = (i == j) ? NumericT(0) : random<NumericT>() - static_cast<NumericT>(0.5);
+     piv_matrix(i, (i + 7) % piv_dim) = static_cast<NumericT>(20.0) + random<NumericT>();
+     piv_rhs(i) = random<NumericT>();
+   }
+
+   viennacl::copy(piv_matrix, vcl_piv_matrix);
+   viennacl::copy(piv_rhs, vcl_piv_rhs);
+
+   //ublas::
+   ublas::permutation_matrix<std::size_t> ublas_permutation(piv_dim);
+   ublas::lu_factorize(piv_matrix, ublas_permutation);
+   ublas::lu_substitute(piv_matrix, ublas_permutation, piv_rhs);
+
+   // ViennaCL:
+   std::vector<std::size_t> vcl_permutation;
+   viennacl::linalg::lu_factorize(vcl_piv_matrix, vcl_permutation);
+   viennacl::linalg::lu_substitute(vcl_piv_matrix, vcl_permutation, vcl_piv_rhs);
+
+   if( fabs(diff(piv_rhs, vcl_piv_rhs)) > epsilon )
+   {
+      std::cout << "# Error at operation: dense solver with pivoting" << std::endl;
+      std::cout << "  diff: " << fabs(diff(piv_rhs, vcl_piv_rhs)) << std::endl;
+      retval = EXIT_FAILURE;
+   }
+
+   //Cholesky solver (symmetric positive definite, several panels):
+   std::cout << "Cholesky solver" << std::endl;
+   ublas::matrix<NumericT> spd_matrix(piv_dim, piv_dim);
+   ublas::vector<NumericT> spd_rhs(piv_dim);
+   ublas::vector<NumericT> spd_result(piv_dim);
+   viennacl::matrix<NumericT, F> vcl_spd_matrix(piv_dim, piv_dim);
+   viennacl::vector<NumericT> vcl_spd_rhs(piv_dim);
+
+   for (std::size_t i=0; i<piv_dim; ++i)
+   {
+     for (std::size_t j=0; j<=i; ++j)
+       spd_matrix(i,j) = spd_matrix(j,i) = random<NumericT>() - static_cast<NumericT>(0.5);
+     spd_matrix(i,i) = static_cast<NumericT>(piv_dim);
+     spd_rhs(i) = random<NumericT>();
+   }
+
+   viennacl::copy(spd_matrix, vcl_spd_matrix);
+   viennacl::copy(spd_rhs, vcl_spd_rhs);
+
+   if (!viennacl::linalg::cholesky_factorize(vcl_spd_matrix))
+   {
+      std::cout << "# Error at operation: Cholesky factorization failed" << std::endl;
+      retval = EXIT_FAILURE;
+   }
+   viennacl::linalg::cholesky_substitute(vcl_spd_matrix, vcl_spd_rhs);
+
+   // check residual:
+   viennacl::copy(vcl_spd_rhs, spd_result);
+   spd_result = ublas::prod(spd_matrix, spd_result);
+   viennacl::copy(spd_result, vcl_spd_rhs);
+   if( fabs(diff(spd_rhs, vcl_spd_rhs)) > epsilon )
+   {
+      std::cout << "# Error at operation: Cholesky solver" << std::endl;
+      std::cout << "  diff: " << fabs(diff(spd_rhs, vcl_spd_rhs)) << std::endl;
+      retval = EXIT_FAILURE;
+   }
+
 
 
    return retval;
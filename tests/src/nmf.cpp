@@ -19,8 +19,12 @@
 #include <cmath>
 
 
+#include <map>
+#include <vector>
+
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/nmf.hpp"
+#include "viennacl/compressed_matrix.hpp"
 
 typedef float ScalarType;
 
@@ -57,7 +61,7 @@ void fill_random(std::vector< std::vector<ScalarType> >& v)
 }
 
 
-void test_nmf(std::size_t m, std::size_t k, std::size_t n)
+void test_nmf(std::size_t m, std::size_t k, std::size_t n, bool sparse_V)
 {
     std::vector< std::vector<ScalarType> > stl_w(m, std::vector<ScalarType>(k));
     std::vector< std::vector<ScalarType> > stl_h(k, std::vector<ScalarType>(n));
@@ -85,7 +89,25 @@ void test_nmf(std::size_t m, std::size_t k, std::size_t n)
     viennacl::copy(stl_h, h_nmf);
 
     viennacl::linalg::nmf_config conf;
-    viennacl::linalg::nmf(v_ref, w_nmf, h_nmf, conf);
+    if (sparse_V)
+    {
+      std::vector< std::vector<ScalarType> > stl_v(m, std::vector<ScalarType>(n));
+      viennacl::copy(v_ref, stl_v);
+
+      std::vector< std::map<unsigned int, ScalarType> > stl_v_sparse(m);
+      for (std::size_t i = 0; i < m; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+          if (stl_v[i][j] != 0)
+            stl_v_sparse[i][static_cast<unsigned int>(j)] = stl_v[i][j];
+
+      viennacl::compressed_matrix<ScalarType> v_sparse(m, n);
+      viennacl::tools::const_sparse_matrix_adapter<ScalarType> adapted_v(stl_v_sparse, m, n);
+      viennacl::copy(adapted_v, v_sparse);
+
+      viennacl::linalg::nmf(v_sparse, w_nmf, h_nmf, conf);
+    }
+    else
+      viennacl::linalg::nmf(v_ref, w_nmf, h_nmf, conf);
 
     viennacl::matrix<ScalarType> v_nmf = viennacl::linalg::prod(w_nmf, h_nmf);
 
@@ -93,7 +115,7 @@ void test_nmf(std::size_t m, std::size_t k, std::size_t n)
     bool diff_ok = fabs(diff) < EPS;
 
     long iterations = static_cast<long>(conf.iters());
-    printf("%6s [%lux%lux%lu] diff = %.6f (%ld iterations)\n", diff_ok ? "[[OK]]":"[FAIL]", m, k, n, diff, iterations);
+    printf("%6s [%lux%lux%lu]%s diff = %.6f (%ld iterations)\n", diff_ok ? "[[OK]]":"[FAIL]", m, k, n, sparse_V ? " (sparse)" : "", diff, iterations);
 
     if (!diff_ok)
       exit(EXIT_FAILURE);
@@ -103,11 +125,14 @@ int main()
 {
   //srand(time(NULL));  //let's use deterministic tests, so keep the default srand() initialization
 
-  test_nmf(3, 3, 3);
-  test_nmf(3, 2, 3);
-  test_nmf(16, 7, 12);
-  test_nmf(160, 73, 200);
-  test_nmf(687, 15, 713);
+  test_nmf(3, 3, 3, false);
+  test_nmf(3, 2, 3, false);
+  test_nmf(16, 7, 12, false);
+  test_nmf(160, 73, 200, false);
+  test_nmf(687, 15, 713, false);
+
+  test_nmf(16, 7, 12, true);
+  test_nmf(160, 73, 200, true);
 
   std::cout << std::endl;
   std::cout << "------- Test completed --------" << std::endl;
@@ -0,0 +1,189 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+#ifndef VIENNACL_WITH_PROFILING
+ #define VIENNACL_WITH_PROFILING
+#endif
+
+//
+// *** System
+//
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <vector>
+#include <map>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/tools/profiler.hpp"
+
+typedef std::vector<viennacl::tools::profiler_record> record_list;
+
+std::size_t count_records(record_list const & records, std::string const & name)
+{
+  std::size_t count = 0;
+  for (std::size_t i=0; i<records.size(); ++i)
+    if (records[i].name == name)
+      ++count;
+  return count;
+}
+
+viennacl::tools::profiler_record const * find_record(record_list const & records, std::string const & name)
+{
+  for (std::size_t i=0; i<records.size(); ++i)
+    if (records[i].name == name)
+      return &records[i];
+  return NULL;
+}
+
+bool check(bool condition, char const * message)
+{
+  if (!condition)
+    std::cout << "# Error: " << message << std::endl;
+  return condition;
+}
+
+int test()
+{
+  viennacl::tools::profiler & profiler = viennacl::tools::current_profiler();
+  std::size_t N = 1000;
+
+  std::vector< std::map<unsigned int, double> > std_A(N);
+  for (std::size_t i=0; i<N; ++i)
+  {
+    std_A[i][static_cast<unsigned int>(i)] = 2.0;
+    if (i > 0)     std_A[i][static_cast<unsigned int>(i - 1)] = -1.0;
+    if (i + 1 < N) std_A[i][static_cast<unsigned int>(i + 1)] = -1.0;
+  }
+  viennacl::compressed_matrix<double> A(N, N);
+  viennacl::copy(std_A, A);
+
+  viennacl::vector<double> x = viennacl::scalar_vector<double>(N, 1.0);
+  viennacl::vector<double> y(N);
+  viennacl::matrix<double> B(50, N);
+  viennacl::vector<double> z(50);
+
+  //
+  // Nothing is recorded while the profiler is disabled
+  //
+  std::cout << " Testing disabled profiler..." << std::endl;
+  profiler.reset();
+  y = viennacl::linalg::prod(A, x);
+  if (!check(profiler.records().empty(), "records of a disabled profiler"))
+    return EXIT_FAILURE;
+
+  //
+  // Operations are recorded with sizes and operation counts
+  //
+  std::cout << " Testing records..." << std::endl;
+  profiler.enable();
+  y = viennacl::linalg::prod(A, x);
+  y = y + 2.0 * x;
+  double s = viennacl::linalg::inner_prod(x, y);
+  s += viennacl::linalg::norm_2(y);
+  z = viennacl::linalg::prod(B, x);
+  profiler.disable();
+
+  record_list const & records = profiler.records();
+  if (!check(count_records(records, "spmv") == 1, "spmv record") || !check(count_records(records, "gemv") == 1, "gemv record"))
+    return EXIT_FAILURE;
+
+  viennacl::tools::profiler_record const * spmv = find_record(records, "spmv");
+  if (   !check(spmv->backend == "host", "backend of spmv")
+      || !check(spmv->size1 == N && spmv->size2 == N, "sizes of spmv")
+      || !check(spmv->flops == 2.0 * static_cast<double>(3 * N - 2), "flops of spmv")
+      || !check(spmv->bytes > 0 && spmv->duration >= 0 && spmv->depth == 0, "record of spmv"))
+    return EXIT_FAILURE;
+
+  viennacl::tools::profiler_record const * gemv = find_record(records, "gemv");
+  if (!check(gemv->start >= spmv->start + spmv->duration, "time line"))
+    return EXIT_FAILURE;
+
+  //
+  // Operations within a solver
+  //
+  std::cout << " Testing solver..." << std::endl;
+  profiler.reset();
+  profiler.enable();
+  viennacl::linalg::cg_tag tag(1e-30, 10);
+  y = viennacl::linalg::solve(A, x, tag);
+  profiler.disable();
+  if (!check(tag.iters() > 0 && count_records(profiler.records(), "spmv") >= tag.iters(), "spmv records of CG"))
+    return EXIT_FAILURE;
+
+  //
+  // Summary table and Chrome trace
+  //
+  std::cout << " Testing output..." << std::endl;
+  std::ostringstream table;
+  profiler.dump(table);
+  if (!check(table.str().find("spmv") != std::string::npos && table.str().find("host") != std::string::npos, "summary table"))
+    return EXIT_FAILURE;
+
+  std::ostringstream trace;
+  profiler.write_chrome_trace(trace);
+  std::string trace_str = trace.str();
+  if (   !check(trace_str.find("{\"traceEvents\": [") == 0, "beginning of Chrome trace")
+      || !check(trace_str.find("\"name\": \"spmv\"") != std::string::npos, "spmv in Chrome trace")
+      || !check(trace_str.find("\"ph\": \"X\"") != std::string::npos, "complete events in Chrome trace")
+      || !check(trace_str.find("], \"displayTimeUnit\": \"ms\"}") != std::string::npos, "end of Chrome trace"))
+    return EXIT_FAILURE;
+
+  profiler.reset();
+  if (!check(profiler.records().empty(), "reset"))
+    return EXIT_FAILURE;
+
+  if (s < 0)   //use result
+    std::cout << s << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Profiler" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  if (test() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,262 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+//
+// *** System
+//
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+//
+// *** Boost
+//
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/qr.hpp"
+#include "viennacl/linalg/tsqr.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+template <typename ScalarType>
+ScalarType diff(ublas::matrix<ScalarType> const & A, ublas::matrix<ScalarType> const & B)
+{
+  ScalarType max_diff = 0;
+  for (std::size_t i=0; i<A.size1(); ++i)
+    for (std::size_t j=0; j<A.size2(); ++j)
+      max_diff = std::max(max_diff, std::fabs(A(i,j) - B(i,j)));
+  return max_diff;
+}
+
+template <typename ScalarType>
+ScalarType diff(ublas::vector<ScalarType> const & v1, ublas::vector<ScalarType> const & v2)
+{
+  ScalarType max_diff = 0;
+  for (std::size_t i=0; i<v1.size(); ++i)
+    max_diff = std::max(max_diff, std::fabs(v1[i] - v2[i]));
+  return max_diff;
+}
+
+template <typename ScalarType, typename F>
+int test_qr(std::size_t rows, std::size_t cols, std::size_t block_size, ScalarType epsilon)
+{
+  std::cout << "  Matrix of size " << rows << "x" << cols << ", block size " << block_size << std::endl;
+
+  ublas::matrix<ScalarType> ublas_A(rows, cols);
+  for (std::size_t i=0; i<rows; ++i)
+    for (std::size_t j=0; j<cols; ++j)
+      ublas_A(i,j) = ScalarType(rand()) / ScalarType(RAND_MAX) - ScalarType(0.5) + ((i == j) ? ScalarType(2) : ScalarType(0));
+
+  ublas::vector<ScalarType> ublas_b(rows);
+  for (std::size_t i=0; i<rows; ++i)
+    ublas_b[i] = ScalarType(rand()) / ScalarType(RAND_MAX);
+
+  viennacl::matrix<ScalarType, F> vcl_A(rows, cols);
+  viennacl::matrix<ScalarType, F> vcl_Q(rows, rows);
+  viennacl::matrix<ScalarType, F> vcl_R(rows, cols);
+  viennacl::vector<ScalarType> vcl_b(rows);
+  viennacl::copy(ublas_A, vcl_A);
+  viennacl::copy(ublas_b, vcl_b);
+
+  std::vector<ScalarType> betas = viennacl::linalg::inplace_qr(vcl_A, block_size);
+  viennacl::linalg::recoverQ(vcl_A, betas, vcl_Q, vcl_R, block_size);
+  viennacl::linalg::inplace_qr_apply_trans_Q(vcl_A, betas, vcl_b, block_size);
+
+  ublas::matrix<ScalarType> Q(rows, rows);
+  ublas::matrix<ScalarType> R(rows, cols);
+  ublas::vector<ScalarType> result_b(rows);
+  viennacl::copy(vcl_Q, Q);
+  viennacl::copy(vcl_R, R);
+  viennacl::copy(vcl_b, result_b);
+
+  // R must be upper triangular:
+  for (std::size_t i=0; i<rows; ++i)
+    for (std::size_t j=0; j<std::min(i, cols); ++j)
+      if (R(i,j) != 0)
+      {
+        std::cout << "# Error: R is not upper triangular at (" << i << ", " << j << ")" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+  ublas::matrix<ScalarType> QR = ublas::prod(Q, R);
+  ScalarType qr_diff = diff(QR, ublas_A);
+  if (qr_diff > epsilon)
+  {
+    std::cout << "# Error: Q * R does not match A, diff: " << qr_diff << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ublas::matrix<ScalarType> QTQ = ublas::prod(ublas::trans(Q), Q);
+  ublas::matrix<ScalarType> identity = ublas::identity_matrix<ScalarType>(rows);
+  ScalarType orthogonality_diff = diff(QTQ, identity);
+  if (orthogonality_diff > epsilon)
+  {
+    std::cout << "# Error: Q is not orthogonal, diff: " << orthogonality_diff << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ublas::vector<ScalarType> ref_b = ublas::prod(ublas::trans(Q), ublas_b);
+  ScalarType b_diff = diff(ref_b, result_b);
+  if (b_diff > epsilon)
+  {
+    std::cout << "# Error: Q^T b does not match, diff: " << b_diff << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+template <typename ScalarType, typename F>
+int test_tsqr(std::size_t rows, std::size_t cols, std::size_t num_blocks, ScalarType epsilon)
+{
+  std::cout << "  TSQR of matrix of size " << rows << "x" << cols << ", " << num_blocks << " blocks" << std::endl;
+
+  ublas::matrix<ScalarType> ublas_A(rows, cols);
+  for (std::size_t i=0; i<rows; ++i)
+    for (std::size_t j=0; j<cols; ++j)
+      ublas_A(i,j) = ScalarType(rand()) / ScalarType(RAND_MAX) - ScalarType(0.5) + ((i == j) ? ScalarType(2) : ScalarType(0));
+
+  ublas::vector<ScalarType> ublas_b(rows);
+  for (std::size_t i=0; i<rows; ++i)
+    ublas_b[i] = ScalarType(rand()) / ScalarType(RAND_MAX);
+
+  viennacl::matrix<ScalarType, F> vcl_A(rows, cols);
+  viennacl::matrix<ScalarType, F> vcl_Q(rows, cols);
+  viennacl::matrix<ScalarType, F> vcl_R(cols, cols);
+  viennacl::vector<ScalarType> vcl_b(rows);
+  viennacl::copy(ublas_A, vcl_A);
+  viennacl::copy(ublas_b, vcl_b);
+
+  viennacl::linalg::tsqr(vcl_A, vcl_Q, vcl_R, num_blocks);
+
+  ublas::matrix<ScalarType> Q(rows, cols);
+  ublas::matrix<ScalarType> R(cols, cols);
+  viennacl::copy(vcl_Q, Q);
+  viennacl::copy(vcl_R, R);
+
+  ublas::matrix<ScalarType> QR = ublas::prod(Q, R);
+  ScalarType qr_diff = diff(QR, ublas_A);
+  if (qr_diff > epsilon)
+  {
+    std::cout << "# Error: Q * R does not match A, diff: " << qr_diff << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ublas::matrix<ScalarType> QTQ = ublas::prod(ublas::trans(Q), Q);
+  ublas::matrix<ScalarType> identity = ublas::identity_matrix<ScalarType>(cols);
+  ScalarType orthogonality_diff = diff(QTQ, identity);
+  if (orthogonality_diff > epsilon)
+  {
+    std::cout << "# Error: Q is not orthogonal, diff: " << orthogonality_diff << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // least-squares solution satisfies the normal equations A^T (A x - b) = 0:
+  viennacl::vector<ScalarType> vcl_x = viennacl::linalg::tsqr_least_squares(vcl_A, vcl_b, num_blocks);
+  ublas::vector<ScalarType> x(cols);
+  viennacl::copy(vcl_x, x);
+
+  ublas::vector<ScalarType> residual = ublas::prod(ublas_A, x) - ublas_b;
+  ublas::vector<ScalarType> normal_residual = ublas::prod(ublas::trans(ublas_A), residual);
+  ublas::vector<ScalarType> zero = ublas::zero_vector<ScalarType>(cols);
+  ScalarType ls_diff = diff(normal_residual, zero);
+  if (ls_diff > epsilon * ScalarType(rows))
+  {
+    std::cout << "# Error: least-squares solution does not satisfy the normal equations, diff: " << ls_diff << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+template <typename ScalarType>
+int test(ScalarType epsilon)
+{
+  std::cout << " Row-major:" << std::endl;
+  if (test_qr<ScalarType, viennacl::row_major>(113, 54, 16, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_qr<ScalarType, viennacl::row_major>(40, 70, 32, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_qr<ScalarType, viennacl::row_major>(150, 150, 32, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << " Column-major:" << std::endl;
+  if (test_qr<ScalarType, viennacl::column_major>(113, 54, 16, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_qr<ScalarType, viennacl::column_major>(40, 70, 32, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_qr<ScalarType, viennacl::column_major>(150, 150, 7, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_qr<ScalarType, viennacl::column_major>(97, 61, 0, epsilon) != EXIT_SUCCESS)   // panel width from the tuning profile
+    return EXIT_FAILURE;
+
+  std::cout << " TSQR:" << std::endl;
+  if (test_tsqr<ScalarType, viennacl::row_major>(1000, 20, 1, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_tsqr<ScalarType, viennacl::row_major>(1000, 20, 5, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_tsqr<ScalarType, viennacl::column_major>(1003, 17, 8, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_tsqr<ScalarType, viennacl::column_major>(60, 20, 4, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: QR factorization" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: float" << std::endl;
+  if (test<float>(1e-3f) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if ( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    if (test<double>(1e-10) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -156,7 +156,7 @@ ScalarType vector_compare(ublas::vector<ScalarType>& res,
     return diff / mx;
 }
 
-void test_eigen(const std::string& fn, bool is_symm)
+bool test_eigen(const std::string& fn, bool is_symm)
 {
     std::cout << "Reading..." << "\n";
     std::size_t sz;
@@ -218,6 +218,14 @@ void test_eigen(const std::string& fn, bool is_symm)
     is_ok = is_ok && (eigen_diff < EPS);
     is_ok = is_ok && (prods_diff < EPS);
 
+    if(is_symm)
+    {
+        // eigenvalues only:
+        ublas::vector<ScalarType> eigen_only(sz, 0);
+        viennacl::linalg::qr_method_sym(A_ref, eigen_only);
+        is_ok = is_ok && (vector_compare(eigen_ref_re, eigen_only) < EPS);
+    }
+
     // std::cout << A_ref << "\n";
     // std::cout << A_input << "\n";
     // std::cout << Q << "\n";
@@ -233,18 +241,25 @@ void test_eigen(const std::string& fn, bool is_symm)
 
     printf("%6s [%dx%d] %40s time = %.4f\n", is_ok?"[[OK]]":"[FAIL]", (int)A_ref.size1(), (int)A_ref.size2(), fn.c_str(), time_spend);
     printf("tridiagonal = %d, hessenberg = %d prod-diff = %f eigen-diff = %f\n", is_tridiag, is_hessenberg, prods_diff, eigen_diff);
+
+    return is_ok;
 }
 
 int main()
 {
-  // test_eigen("../../examples/testdata/eigen/symm1.example", true);
-  // test_eigen("../../examples/testdata/eigen/symm2.example", true);
-  // test_eigen("../../examples/testdata/eigen/symm3.example", true);
-
+  if (!test_eigen("../../examples/testdata/eigen/symm1.example", true))
+    return EXIT_FAILURE;
+  if (!test_eigen("../../examples/testdata/eigen/symm2.example", true))
+    return EXIT_FAILURE;
+  if (!test_eigen("../../examples/testdata/eigen/symm3.example", true))
+    return EXIT_FAILURE;
+
+#ifdef VIENNACL_WITH_OPENCL
+  // the QR method for nonsymmetric matrices is only available with OpenCL:
   test_eigen("../../examples/testdata/eigen/nsm1.example", false);
   test_eigen("../../examples/testdata/eigen/nsm2.example", false);
   test_eigen("../../examples/testdata/eigen/nsm3.example", false);
-  test_eigen("../../examples/testdata/eigen/nsm4.example", false);
+#endif
 
   std::cout << std::endl;
   std::cout << "------- Test completed --------" << std::endl;
@@ -0,0 +1,212 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/rand/uniform.hpp"
+#include "viennacl/rand/gaussian.hpp"
+
+
+template <typename NumericT>
+bool check_moments(std::vector<NumericT> const & x, double mean, double variance, double tolerance, std::string const & name)
+{
+  double sum = 0;
+  for (std::size_t i=0; i<x.size(); ++i)
+    sum += x[i];
+  double computed_mean = sum / x.size();
+
+  double sum_sq = 0;
+  for (std::size_t i=0; i<x.size(); ++i)
+    sum_sq += (x[i] - computed_mean) * (x[i] - computed_mean);
+  double computed_variance = sum_sq / (x.size() - 1);
+
+  std::cout << "  " << name << ": mean " << computed_mean << " (expected " << mean << "), variance " << computed_variance << " (expected " << variance << ")" << std::endl;
+  if (std::fabs(computed_mean - mean) > tolerance || std::fabs(computed_variance - variance) > tolerance * (1.0 + variance))
+  {
+    std::cout << "# Error: moments of " << name << " do not match!" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template <typename NumericT>
+bool check_equal(std::vector<NumericT> const & x, std::vector<NumericT> const & y, std::string const & name)
+{
+  for (std::size_t i=0; i<x.size(); ++i)
+  {
+    if (x[i] != y[i])
+    {
+      std::cout << "# Error: " << name << " differ at index " << i << ": " << x[i] << " vs. " << y[i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename NumericT, typename F>
+std::vector<NumericT> to_row_major_std(viennacl::matrix<NumericT, F> const & A)
+{
+  std::vector<NumericT> result(A.size1() * A.size2());
+  for (std::size_t i=0; i<A.size1(); ++i)
+    for (std::size_t j=0; j<A.size2(); ++j)
+      result[i * A.size2() + j] = A(i, j);
+  return result;
+}
+
+template <typename NumericT>
+int test(double tolerance)
+{
+  std::size_t N = 100000;
+
+  //
+  // Distribution of the values:
+  //
+  std::cout << "Testing moments of distributions..." << std::endl;
+  viennacl::vector<NumericT> v_uniform = viennacl::random_vector<NumericT>(N, viennacl::rand::uniform_tag(-1.0f, 3.0f, 42));
+  std::vector<NumericT> std_uniform(N);
+  viennacl::copy(v_uniform, std_uniform);
+  if (!check_moments(std_uniform, 1.0, 16.0 / 12.0, tolerance, "uniform(-1, 3)"))
+    return EXIT_FAILURE;
+  for (std::size_t i=0; i<N; ++i)
+  {
+    if (std_uniform[i] < NumericT(-1) || std_uniform[i] > NumericT(3))
+    {
+      std::cout << "# Error: uniform value " << std_uniform[i] << " outside of interval!" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  viennacl::vector<NumericT> v_gaussian = viennacl::random_vector<NumericT>(N, viennacl::rand::gaussian_tag(2.0f, 0.5f, 42));
+  std::vector<NumericT> std_gaussian(N);
+  viennacl::copy(v_gaussian, std_gaussian);
+  if (!check_moments(std_gaussian, 2.0, 0.25, tolerance, "gaussian(2, 0.5)"))
+    return EXIT_FAILURE;
+
+  //
+  // Reproducibility:
+  //
+  std::cout << "Testing reproducibility..." << std::endl;
+  viennacl::vector<NumericT> v_uniform2(N);
+  viennacl::rand::generate(v_uniform2, viennacl::rand::uniform_tag(-1.0f, 3.0f, 42));
+  std::vector<NumericT> std_uniform2(N);
+  viennacl::copy(v_uniform2, std_uniform2);
+  if (!check_equal(std_uniform, std_uniform2, "uniform vectors with same seed"))
+    return EXIT_FAILURE;
+
+  viennacl::rand::generate(v_uniform2, viennacl::rand::uniform_tag(-1.0f, 3.0f, 43));
+  viennacl::copy(v_uniform2, std_uniform2);
+  std::size_t num_equal = 0;
+  for (std::size_t i=0; i<N; ++i)
+    if (std_uniform[i] == std_uniform2[i])
+      ++num_equal;
+  if (num_equal > N / 100)
+  {
+    std::cout << "# Error: Different seeds produce the same stream!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // Independence of memory layout:
+  //
+  std::cout << "Testing independence of memory layout..." << std::endl;
+  std::size_t size1 = 123;
+  std::size_t size2 = 77;
+  viennacl::matrix<NumericT, viennacl::row_major>    A_row = viennacl::random_matrix<NumericT>(size1, size2, viennacl::rand::gaussian_tag(0.0f, 1.0f, 7));
+  viennacl::matrix<NumericT, viennacl::column_major> A_col = viennacl::random_matrix<NumericT>(size1, size2, viennacl::rand::gaussian_tag(0.0f, 1.0f, 7));
+  std::vector<NumericT> std_A_row = to_row_major_std(A_row);
+  std::vector<NumericT> std_A_col = to_row_major_std(A_col);
+  if (!check_equal(std_A_row, std_A_col, "row- and column-major matrices"))
+    return EXIT_FAILURE;
+
+  viennacl::vector<NumericT> v_flat(size1 * size2);
+  viennacl::rand::generate(v_flat, viennacl::rand::gaussian_tag(0.0f, 1.0f, 7));
+  std::vector<NumericT> std_v_flat(size1 * size2);
+  viennacl::copy(v_flat, std_v_flat);
+  if (!check_equal(std_A_row, std_v_flat, "matrix and vector"))
+    return EXIT_FAILURE;
+
+  // filling a submatrix must not touch the surrounding entries:
+  viennacl::matrix<NumericT, viennacl::column_major> B = viennacl::scalar_matrix<NumericT>(size1, size2, NumericT(5));
+  viennacl::matrix_slice<viennacl::matrix<NumericT, viennacl::column_major> > B_sub(B, viennacl::slice(10, 1, 30), viennacl::slice(3, 2, 20));
+  viennacl::rand::generate(B_sub, viennacl::rand::uniform_tag(0.0f, 1.0f, 3));
+  viennacl::matrix<NumericT, viennacl::row_major> C(30, 20);
+  viennacl::rand::generate(C, viennacl::rand::uniform_tag(0.0f, 1.0f, 3));
+  for (std::size_t i=0; i<size1; ++i)
+  {
+    for (std::size_t j=0; j<size2; ++j)
+    {
+      bool inside = (i >= 10 && i < 40 && j >= 3 && j < 43 && (j - 3) % 2 == 0);
+      NumericT expected = inside ? NumericT(C(i - 10, (j - 3) / 2)) : NumericT(5);
+      if (NumericT(B(i, j)) != expected)
+      {
+        std::cout << "# Error: submatrix fill wrong at (" << i << ", " << j << "): " << B(i, j) << " vs. " << expected << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Random Numbers" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: float" << std::endl;
+  if (test<float>(0.02) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::cout << std::endl;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if ( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    if (test<double>(0.02) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
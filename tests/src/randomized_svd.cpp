@@ -0,0 +1,199 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/randomized_svd.hpp"
+
+
+/** @brief Sets up the m x n matrix A = U0 * diag(s) * V0^T, where U0 and V0 are Householder reflections */
+template <typename NumericT>
+std::vector<std::vector<NumericT> > setup_matrix(std::size_t m, std::size_t n, std::vector<NumericT> const & s)
+{
+  std::vector<double> u(m), v(n);
+  double u_norm = 0, v_norm = 0;
+  for (std::size_t i=0; i<m; ++i) { u[i] = std::sin(1.0 + 0.7 * i); u_norm += u[i] * u[i]; }
+  for (std::size_t j=0; j<n; ++j) { v[j] = std::cos(0.3 + 1.3 * j); v_norm += v[j] * v[j]; }
+
+  std::vector<std::vector<NumericT> > A(m, std::vector<NumericT>(n));
+  for (std::size_t i=0; i<m; ++i)
+    for (std::size_t j=0; j<n; ++j)
+    {
+      double temp = 0;
+      for (std::size_t r=0; r<s.size(); ++r)
+      {
+        double U0_ir = (i == r ? 1.0 : 0.0) - 2.0 * u[i] * u[r] / u_norm;
+        double V0_jr = (j == r ? 1.0 : 0.0) - 2.0 * v[j] * v[r] / v_norm;
+        temp += U0_ir * s[r] * V0_jr;
+      }
+      A[i][j] = NumericT(temp);
+    }
+  return A;
+}
+
+template <typename NumericT>
+bool check_singular_values(std::vector<NumericT> const & computed, std::vector<NumericT> const & reference, double tolerance)
+{
+  for (std::size_t i=0; i<computed.size(); ++i)
+  {
+    if (std::fabs(computed[i] - reference[i]) > tolerance * reference[0])
+    {
+      std::cout << "# Error: singular value " << i << " is " << computed[i] << ", expected " << reference[i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename NumericT>
+bool check_orthonormal(viennacl::matrix<NumericT, viennacl::column_major> const & Q, double tolerance)
+{
+  viennacl::matrix<NumericT, viennacl::column_major> QtQ = viennacl::linalg::prod(trans(Q), Q);
+  std::vector<std::vector<NumericT> > host_QtQ(QtQ.size1(), std::vector<NumericT>(QtQ.size2()));
+  viennacl::copy(QtQ, host_QtQ);
+  for (std::size_t i=0; i<host_QtQ.size(); ++i)
+    for (std::size_t j=0; j<host_QtQ[i].size(); ++j)
+      if (std::fabs(host_QtQ[i][j] - ((i == j) ? 1 : 0)) > tolerance)
+      {
+        std::cout << "# Error: singular vectors not orthonormal, entry (" << i << ", " << j << ") of Q^T Q is " << host_QtQ[i][j] << std::endl;
+        return false;
+      }
+  return true;
+}
+
+template <typename NumericT>
+int test(double tolerance)
+{
+  std::size_t m = 300;
+  std::size_t n = 200;
+  std::size_t rank = 10;
+
+  std::vector<NumericT> s(n);
+  for (std::size_t i=0; i<n; ++i)
+    s[i] = NumericT(std::pow(0.5, double(i)));
+
+  //
+  // dense matrix:
+  //
+  std::cout << "Testing dense matrix..." << std::endl;
+  std::vector<std::vector<NumericT> > host_A = setup_matrix(m, n, s);
+  viennacl::matrix<NumericT> A(m, n);
+  viennacl::copy(host_A, A);
+
+  viennacl::matrix<NumericT, viennacl::column_major> U(m, rank);
+  viennacl::matrix<NumericT, viennacl::column_major> V(n, rank);
+  std::vector<NumericT> sigma = viennacl::linalg::svd(A, U, V, viennacl::linalg::randomized_svd_tag(rank, 10, 2));
+
+  if (sigma.size() != rank)
+  {
+    std::cout << "# Error: wrong number of singular values: " << sigma.size() << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!check_singular_values(sigma, s, tolerance))
+    return EXIT_FAILURE;
+  if (!check_orthonormal(U, tolerance) || !check_orthonormal(V, tolerance))
+    return EXIT_FAILURE;
+
+  // A * v_i = sigma_i * u_i:
+  viennacl::matrix<NumericT, viennacl::column_major> AV = viennacl::linalg::prod(A, V);
+  std::vector<std::vector<NumericT> > host_AV(m, std::vector<NumericT>(rank));
+  std::vector<std::vector<NumericT> > host_U(m, std::vector<NumericT>(rank));
+  viennacl::copy(AV, host_AV);
+  viennacl::copy(U, host_U);
+  for (std::size_t i=0; i<m; ++i)
+    for (std::size_t j=0; j<rank; ++j)
+      if (std::fabs(host_AV[i][j] - sigma[j] * host_U[i][j]) > tolerance)
+      {
+        std::cout << "# Error: A * V != U * Sigma at entry (" << i << ", " << j << ")" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+  std::vector<NumericT> sigma_only = viennacl::linalg::svd(A, viennacl::linalg::randomized_svd_tag(rank, 10, 2));
+  if (!check_singular_values(sigma_only, s, tolerance))
+    return EXIT_FAILURE;
+
+  //
+  // sparse matrix with singular values s, placed on a permuted diagonal:
+  //
+  std::cout << "Testing sparse matrix..." << std::endl;
+  std::vector<std::map<unsigned int, NumericT> > host_B(m);
+  for (std::size_t i=0; i<n; ++i)
+    host_B[(7 * i + 3) % m][static_cast<unsigned int>((11 * i) % n)] = (i % 2) ? s[i] : -s[i];
+  viennacl::compressed_matrix<NumericT> B(m, n);
+  viennacl::copy(host_B, B);
+
+  sigma = viennacl::linalg::svd(B, U, V, viennacl::linalg::randomized_svd_tag(rank, 10, 2, 5));
+  if (!check_singular_values(sigma, s, tolerance))
+    return EXIT_FAILURE;
+  if (!check_orthonormal(U, tolerance) || !check_orthonormal(V, tolerance))
+    return EXIT_FAILURE;
+
+  sigma_only = viennacl::linalg::svd(B, viennacl::linalg::randomized_svd_tag(rank, 10, 2, 5));
+  if (!check_singular_values(sigma_only, s, tolerance))
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Randomized SVD" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: float" << std::endl;
+  if (test<float>(1e-3) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::cout << std::endl;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if ( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    if (test<double>(1e-8) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,380 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// *** System
+//
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+
+//
+// *** Boost
+//
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+
+//
+// *** ViennaCL
+//
+#define VIENNACL_WITH_UBLAS 1
+#include "viennacl/vector.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+
+#include "viennacl/scheduler/compiled_statement.hpp"
+
+#include "Random.hpp"
+
+using namespace boost::numeric;
+
+
+//
+// -------------------------------------------------------------
+//
+template <typename ScalarType>
+ScalarType diff(ScalarType const & s1, viennacl::scalar<ScalarType> const & s2)
+{
+   viennacl::backend::finish();
+   if (s1 != s2)
+      return (s1 - s2) / std::max(std::fabs(s1), std::fabs(s2));
+   return 0;
+}
+
+template <typename ScalarType>
+ScalarType diff(ublas::vector<ScalarType> const & v1, viennacl::vector<ScalarType> const & vcl_vec)
+{
+   ublas::vector<ScalarType> v2_cpu(vcl_vec.size());
+   viennacl::backend::finish();
+   viennacl::copy(vcl_vec, v2_cpu);
+
+   for (std::size_t i=0;i<v1.size(); ++i)
+   {
+      if ( std::max( std::fabs(v2_cpu[i]), std::fabs(v1[i]) ) > 0 )
+         v2_cpu[i] = std::fabs(v2_cpu[i] - v1[i]) / std::max( std::fabs(v2_cpu[i]), std::fabs(v1[i]) );
+      else
+         v2_cpu[i] = 0.0;
+   }
+
+   return ublas::norm_inf(v2_cpu);
+}
+
+template <typename ScalarType>
+ScalarType diff(ublas::matrix<ScalarType> const & mat1, viennacl::matrix<ScalarType> const & mat2)
+{
+   ublas::matrix<ScalarType> mat2_cpu(mat2.size1(), mat2.size2());
+   viennacl::backend::finish();
+   viennacl::copy(mat2, mat2_cpu);
+
+   ScalarType ret = 0;
+   for (std::size_t i = 0; i < mat2_cpu.size1(); ++i)
+   {
+     for (std::size_t j = 0; j < mat2_cpu.size2(); ++j)
+     {
+       ScalarType act = std::fabs(mat2_cpu(i,j) - mat1(i,j)) / std::max( std::fabs(mat2_cpu(i, j)), std::fabs(mat1(i,j)) );
+       if (act > ret)
+         ret = act;
+     }
+   }
+   return ret;
+}
+
+
+template <typename T1, typename T2>
+int check(T1 const & t1, T2 const & t2, double epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  double temp = std::fabs(diff(t1, t2));
+  if (temp > epsilon)
+  {
+    std::cout << "# Error! Relative difference: " << temp << std::endl;
+    retval = EXIT_FAILURE;
+  }
+  else
+    std::cout << "PASSED!" << std::endl;
+  return retval;
+}
+
+
+//
+// -------------------------------------------------------------
+//
+template< typename NumericT, typename Epsilon >
+int test(Epsilon const& epsilon)
+{
+  std::size_t size = 1234;
+  std::size_t mat_size = 67;
+
+  ublas::vector<NumericT> ublas_v1(size), ublas_v2(size), ublas_v3(size), ublas_v4(size);
+  for (std::size_t i=0; i<size; ++i)
+  {
+    ublas_v1[i] = NumericT(1.0) + random<NumericT>();
+    ublas_v2[i] = NumericT(1.0) + random<NumericT>();
+    ublas_v3[i] = NumericT(1.0) + random<NumericT>();
+    ublas_v4[i] = NumericT(1.0) + random<NumericT>();
+  }
+
+  viennacl::vector<NumericT> vcl_v1(size), vcl_v2(size), vcl_v3(size), vcl_v4(size);
+  viennacl::copy(ublas_v1, vcl_v1);
+  viennacl::copy(ublas_v2, vcl_v2);
+  viennacl::copy(ublas_v3, vcl_v3);
+  viennacl::copy(ublas_v4, vcl_v4);
+
+  NumericT alpha = NumericT(3.1415);
+  NumericT beta  = NumericT(2.7172);
+
+  std::cout << "Testing vector additions with rebinding of host scalars..." << std::endl;
+  {
+    viennacl::scheduler::compiled_statement cs(viennacl::scheduler::statement(vcl_v1, viennacl::op_assign(), alpha * vcl_v2 - vcl_v3 / beta));
+    if (cs.num_steps() != 1 || cs.num_temporaries() != 0)
+    {
+      std::cout << "# Error! Unexpected plan with " << cs.num_steps() << " steps and " << cs.num_temporaries() << " temporaries" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    for (std::size_t k=0; k<3; ++k)
+    {
+      alpha += NumericT(0.5);
+      beta  -= NumericT(0.25);
+      ublas_v1 = alpha * ublas_v2 - ublas_v3 / beta;
+      cs.rebind(viennacl::scheduler::statement(vcl_v1, viennacl::op_assign(), alpha * vcl_v2 - vcl_v3 / beta));
+      cs.execute();
+      if (check(ublas_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Testing nested expressions with inplace-add..." << std::endl;
+  {
+    ublas_v1 += alpha * ublas_v1 - beta * ublas_v2 + ublas_v1 / beta - ublas_v2 / alpha;
+    viennacl::scheduler::compiled_statement cs(viennacl::scheduler::statement(vcl_v1, viennacl::op_inplace_add(), alpha * vcl_v1 - beta * vcl_v2 + vcl_v1 / beta - vcl_v2 / alpha));
+    cs.execute();
+    if (check(ublas_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing element-wise operations with inplace-sub..." << std::endl;
+  {
+    viennacl::scheduler::compiled_statement cs(viennacl::scheduler::statement(vcl_v1, viennacl::op_inplace_sub(), viennacl::linalg::element_prod(vcl_v2, vcl_v3)));
+    for (std::size_t k=0; k<2; ++k)
+    {
+      ublas_v1 -= ublas::element_prod(ublas_v2, ublas_v3);
+      cs.execute();
+      if (check(ublas_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Testing rebinding of vectors..." << std::endl;
+  {
+    ublas_v1 = ublas_v2 + ublas::element_prod(ublas_v3, ublas_v2);
+    viennacl::scheduler::compiled_statement cs(viennacl::scheduler::statement(vcl_v1, viennacl::op_assign(), vcl_v2 + viennacl::linalg::element_prod(vcl_v3, vcl_v2)));
+    cs.execute();
+    if (check(ublas_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    ublas_v1 = ublas_v4 + ublas::element_prod(ublas_v3, ublas_v4);
+    cs.rebind(viennacl::scheduler::statement(vcl_v1, viennacl::op_assign(), vcl_v4 + viennacl::linalg::element_prod(vcl_v3, vcl_v4)));
+    cs.execute();
+    if (check(ublas_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    // different size, hence the statement is compiled again:
+    ublas::vector<NumericT> ublas_short(size / 2), ublas_short2(size / 2);
+    for (std::size_t i=0; i<ublas_short2.size(); ++i)
+      ublas_short2[i] = NumericT(1.0) + random<NumericT>();
+    viennacl::vector<NumericT> vcl_short(size / 2), vcl_short2(size / 2);
+    viennacl::copy(ublas_short2, vcl_short2);
+
+    ublas_short = ublas_short2 + ublas::element_prod(ublas_short2, ublas_short2);
+    cs.rebind(viennacl::scheduler::statement(vcl_short, viennacl::op_assign(), vcl_short2 + viennacl::linalg::element_prod(vcl_short2, vcl_short2)));
+    cs.execute();
+    if (check(ublas_short, vcl_short, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing fused element-wise expressions with rebinding of scalars and ranges..." << std::endl;
+  {
+    ublas_v1 = alpha * ublas::element_prod(ublas_v2 + ublas_v3, ublas_v4) - ublas_v2 / beta;
+    viennacl::scheduler::compiled_statement cs(viennacl::scheduler::statement(vcl_v1, viennacl::op_assign(), alpha * viennacl::linalg::element_prod(vcl_v2 + vcl_v3, vcl_v4) - vcl_v2 / beta));
+    if (cs.num_steps() != 1 || cs.num_temporaries() != 0)
+    {
+      std::cout << "# Error! Unexpected plan with " << cs.num_steps() << " steps and " << cs.num_temporaries() << " temporaries" << std::endl;
+      return EXIT_FAILURE;
+    }
+    cs.execute();
+    if (check(ublas_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    // new values of the operands are seen without rebinding:
+    ublas_v4 *= NumericT(0.5);
+    vcl_v4   *= NumericT(0.5);
+    ublas_v1 = alpha * ublas::element_prod(ublas_v2 + ublas_v3, ublas_v4) - ublas_v2 / beta;
+    cs.execute();
+    if (check(ublas_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    alpha -= NumericT(0.75);
+    ublas_v1 = alpha * ublas::element_prod(ublas_v3 + ublas_v2, ublas_v4) - ublas_v3 / beta;
+    cs.rebind(viennacl::scheduler::statement(vcl_v1, viennacl::op_assign(), alpha * viennacl::linalg::element_prod(vcl_v3 + vcl_v2, vcl_v4) - vcl_v3 / beta));
+    cs.execute();
+    if (check(ublas_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    // same size, but different offset and stride:
+    ublas::vector<NumericT> ublas_long(3 * size);
+    for (std::size_t i=0; i<ublas_long.size(); ++i)
+      ublas_long[i] = NumericT(1.0) + random<NumericT>();
+    viennacl::vector<NumericT> vcl_long(3 * size);
+    viennacl::copy(ublas_long, vcl_long);
+    ublas::vector<NumericT> ublas_slice = ublas::project(ublas_long, ublas::slice(1, 2, size));
+    viennacl::vector_slice<viennacl::vector<NumericT> > vcl_slice(vcl_long, viennacl::slice(1, 2, size));
+
+    ublas_v1 = alpha * ublas::element_prod(ublas_slice + ublas_v3, ublas_v4) - ublas_slice / beta;
+    cs.rebind(viennacl::scheduler::statement(vcl_v1, viennacl::op_assign(), alpha * viennacl::linalg::element_prod(vcl_slice + vcl_v3, vcl_v4) - vcl_slice / beta));
+    cs.execute();
+    if (check(ublas_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing reductions..." << std::endl;
+  {
+    NumericT cpu_result = inner_prod(ublas_v1 + ublas_v2, ublas_v3);
+    viennacl::scalar<NumericT> gpu_result = 0;
+    viennacl::scheduler::compiled_statement cs(viennacl::scheduler::statement(gpu_result, viennacl::op_assign(), viennacl::linalg::inner_prod(vcl_v1 + vcl_v2, vcl_v3)));
+    if (cs.num_temporaries() != 1)
+    {
+      std::cout << "# Error! Expected one temporary, got " << cs.num_temporaries() << std::endl;
+      return EXIT_FAILURE;
+    }
+    cs.execute();
+    if (check(cpu_result, gpu_result, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    cpu_result += ublas::norm_2(ublas_v2);
+    viennacl::scheduler::compiled_statement cs2(viennacl::scheduler::statement(gpu_result, viennacl::op_inplace_add(), viennacl::linalg::norm_2(vcl_v2)));
+    cs2.execute();
+    if (check(cpu_result, gpu_result, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing matrix products..." << std::endl;
+  {
+    ublas::matrix<NumericT> ublas_A(mat_size, mat_size), ublas_B(mat_size, mat_size), ublas_C(mat_size, mat_size);
+    for (std::size_t i=0; i<mat_size; ++i)
+      for (std::size_t j=0; j<mat_size; ++j)
+      {
+        ublas_A(i,j) = NumericT(0.1) + random<NumericT>();
+        ublas_B(i,j) = NumericT(0.1) + random<NumericT>();
+        ublas_C(i,j) = NumericT(0.1) + random<NumericT>();
+      }
+    viennacl::matrix<NumericT> vcl_A(mat_size, mat_size), vcl_B(mat_size, mat_size), vcl_C(mat_size, mat_size);
+    viennacl::copy(ublas_A, vcl_A);
+    viennacl::copy(ublas_B, vcl_B);
+    viennacl::copy(ublas_C, vcl_C);
+
+    ublas::vector<NumericT> ublas_x(mat_size), ublas_y(mat_size);
+    for (std::size_t i=0; i<mat_size; ++i)
+    {
+      ublas_x[i] = NumericT(1.0) + random<NumericT>();
+      ublas_y[i] = NumericT(1.0) + random<NumericT>();
+    }
+    viennacl::vector<NumericT> vcl_x(mat_size), vcl_y(mat_size);
+    viennacl::copy(ublas_x, vcl_x);
+    viennacl::copy(ublas_y, vcl_y);
+
+    ublas_y -= ublas::prod(trans(ublas_A), ublas_x);
+    viennacl::scheduler::compiled_statement cs1(viennacl::scheduler::statement(vcl_y, viennacl::op_inplace_sub(), viennacl::linalg::prod(trans(vcl_A), vcl_x)));
+    cs1.execute();
+    if (check(ublas_y, vcl_y, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    ublas_C += ublas::prod(ublas_A, ublas_B);
+    viennacl::scheduler::compiled_statement cs2(viennacl::scheduler::statement(vcl_C, viennacl::op_inplace_add(), viennacl::linalg::prod(vcl_A, vcl_B)));
+    cs2.execute();
+    if (check(ublas_C, vcl_C, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    ublas_C = ublas_B - ublas::prod(ublas_A, trans(ublas_B));
+    viennacl::scheduler::compiled_statement cs3(viennacl::scheduler::statement(vcl_C, viennacl::op_assign(), vcl_B - viennacl::linalg::prod(vcl_A, trans(vcl_B))));
+    cs3.execute();
+    if (check(ublas_C, vcl_C, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+   std::cout << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << "## Test :: Compiled Statements" << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << std::endl;
+
+   int retval = EXIT_SUCCESS;
+
+   {
+      typedef float NumericT;
+      NumericT epsilon = static_cast<NumericT>(1.0E-3);
+      std::cout << "# Testing setup:" << std::endl;
+      std::cout << "  eps:     " << epsilon << std::endl;
+      std::cout << "  numeric: float" << std::endl;
+      retval = test<NumericT>(epsilon);
+      if( retval == EXIT_SUCCESS )
+         std::cout << "# Test passed" << std::endl;
+      else
+         return retval;
+   }
+   std::cout << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << std::endl;
+#ifdef VIENNACL_WITH_OPENCL
+   if( viennacl::ocl::current_device().double_support() )
+#endif
+   {
+      typedef double NumericT;
+      NumericT epsilon = 1.0E-10;
+      std::cout << "# Testing setup:" << std::endl;
+      std::cout << "  eps:     " << epsilon << std::endl;
+      std::cout << "  numeric: double" << std::endl;
+      retval = test<NumericT>(epsilon);
+      if( retval == EXIT_SUCCESS )
+        std::cout << "# Test passed" << std::endl;
+      else
+        return retval;
+   }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+   return retval;
+}
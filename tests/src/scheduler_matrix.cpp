@@ -369,6 +369,19 @@ int run_test(double epsilon,
 
 #undef GENERATE_UNARY_OP_TEST
 
+  std::cout << "--- Testing complicated composite operations ---" << std::endl;
+  std::cout << "x = alpha * y - beta * element_prod(x, y) + element_exp(y / 2)... ";
+  {
+  for (std::size_t i=0; i<ublas_C.size1(); ++i)
+    for (std::size_t j=0; j<ublas_C.size2(); ++j)
+      ublas_C(i,j) = alpha * ublas_B(i,j) - beta * ublas_A(i,j) * ublas_B(i,j) + std::exp(ublas_B(i,j) / cpu_value_type(2));
+  viennacl::scheduler::statement   my_statement(vcl_C, viennacl::op_assign(), alpha * vcl_B - beta * viennacl::linalg::element_prod(vcl_A, vcl_B) + viennacl::linalg::element_exp(vcl_B / cpu_value_type(2)));
+  viennacl::scheduler::execute(my_statement);
+
+  if (!check_for_equality(ublas_C, vcl_C, epsilon))
+    return EXIT_FAILURE;
+  }
+
 
   std::cout << std::endl;
   std::cout << "----------------------------------------------" << std::endl;
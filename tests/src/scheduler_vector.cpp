@@ -476,6 +476,28 @@ int test(Epsilon const& epsilon,
     return EXIT_FAILURE;
   }
 
+  std::cout << "x = alpha * y - beta * element_prod(x, y) + element_exp(y / 2)..." << std::endl;
+  {
+  for (std::size_t i=0; i<ublas_v1.size(); ++i)
+    ublas_v1[i] = alpha * ublas_v2[i] - beta * ublas_v1[i] * ublas_v2[i] + std::exp(ublas_v2[i] / NumericT(2));
+  viennacl::scheduler::statement   my_statement(vcl_v1, viennacl::op_assign(), alpha * vcl_v2 - beta * viennacl::linalg::element_prod(vcl_v1, vcl_v2) + viennacl::linalg::element_exp(vcl_v2 / NumericT(2)));
+  viennacl::scheduler::execute(my_statement);
+
+  if (check(ublas_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "x -= element_div(x + y, alpha * y) - element_sqrt(element_prod(y, y))..." << std::endl;
+  {
+  for (std::size_t i=0; i<ublas_v1.size(); ++i)
+    ublas_v1[i] -= (ublas_v1[i] + ublas_v2[i]) / (alpha * ublas_v2[i]) - std::sqrt(ublas_v2[i] * ublas_v2[i]);
+  viennacl::scheduler::statement   my_statement(vcl_v1, viennacl::op_inplace_sub(), viennacl::linalg::element_div(vcl_v1 + vcl_v2, alpha * vcl_v2) - viennacl::linalg::element_sqrt(viennacl::linalg::element_prod(vcl_v2, vcl_v2)));
+  viennacl::scheduler::execute(my_statement);
+
+  if (check(ublas_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  }
+
 
   // --------------------------------------------------------------------------
   return retval;
@@ -23,6 +23,8 @@
 // *** System
 //
 #include <iostream>
+#include <vector>
+#include <map>
 
 //
 // *** Boost
@@ -44,6 +46,7 @@
 #include "viennacl/scalar.hpp"
 #include "viennacl/compressed_matrix.hpp"
 #include "viennacl/compressed_compressed_matrix.hpp"
+#include "viennacl/symmetric_compressed_matrix.hpp"
 #include "viennacl/coordinate_matrix.hpp"
 #include "viennacl/ell_matrix.hpp"
 #include "viennacl/hyb_matrix.hpp"
@@ -52,6 +55,10 @@
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/ichol.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
 #include "viennacl/linalg/detail/ilu/common.hpp"
 #include "viennacl/io/matrix_market.hpp"
 #include "examples/tutorial/Random.hpp"
@@ -104,6 +111,21 @@ ScalarType diff(ublas::vector<ScalarType> & v1, viennacl::vector<ScalarType> & v
 }
 
 
+template <typename ScalarType>
+ScalarType norm_relative_diff(ublas::vector<ScalarType> & v1, viennacl::vector<ScalarType> & v2)
+{
+   ublas::vector<ScalarType> v2_cpu(v2.size());
+   viennacl::backend::finish();
+   viennacl::copy(v2.begin(), v2.end(), v2_cpu.begin());
+
+   ScalarType ref_norm = norm_2(v1);
+   ScalarType diff_norm = norm_2(v2_cpu - v1);
+   if (ref_norm > 0)
+     return diff_norm / ref_norm;
+   return diff_norm;
+}
+
+
 template <typename ScalarType, typename VCL_MATRIX>
 ScalarType diff(ublas::compressed_matrix<ScalarType> & cpu_matrix, VCL_MATRIX & gpu_matrix)
 {
@@ -382,11 +404,278 @@ int resize_test(Epsilon const& epsilon)
 //
 // -------------------------------------------------------------
 //
+template< typename NumericT, typename Epsilon >
+int ilu_sweeps_test(Epsilon const& epsilon)
+{
+  // 2D five-point Laplacian: Both the parallel sweeps and the Jacobi substitutions are exact after at most as many iterations as there are unknowns
+  std::size_t points_per_dim = 12;
+  std::size_t size = points_per_dim * points_per_dim;
+  std::size_t iterations = size;
+
+  std::vector< std::map<unsigned int, NumericT> > stl_matrix(size);
+  for (std::size_t i=0; i<points_per_dim; ++i)
+    for (std::size_t j=0; j<points_per_dim; ++j)
+    {
+      unsigned int row = static_cast<unsigned int>(i * points_per_dim + j);
+      stl_matrix[row][row] = NumericT(4);
+      if (i > 0)                  stl_matrix[row][row - points_per_dim] = NumericT(-1);
+      if (j > 0)                  stl_matrix[row][row - 1]              = NumericT(-1);
+      if (j < points_per_dim - 1) stl_matrix[row][row + 1]              = NumericT(-1);
+      if (i < points_per_dim - 1) stl_matrix[row][row + points_per_dim] = NumericT(-1);
+    }
+
+  viennacl::compressed_matrix<NumericT> vcl_matrix(size, size);
+  viennacl::copy(stl_matrix, vcl_matrix);
+
+  ublas::vector<NumericT> rhs(size);
+  for (std::size_t i=0; i<size; ++i)
+    rhs[i] = NumericT(1) + random<NumericT>();
+
+  ublas::vector<NumericT> result(size);
+  viennacl::vector<NumericT> vcl_result(size);
+
+  // ILU0:
+  viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> > vcl_ilu0(vcl_matrix, viennacl::linalg::ilu0_tag());
+  viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> > vcl_ilu0_sweeps(vcl_matrix, viennacl::linalg::ilu0_tag(false, iterations, iterations));
+
+  viennacl::copy(rhs, vcl_result);
+  vcl_ilu0.apply(vcl_result);
+  viennacl::copy(vcl_result, result);
+
+  viennacl::copy(rhs, vcl_result);
+  vcl_ilu0_sweeps.apply(vcl_result);
+
+  if ( std::fabs(diff(result, vcl_result)) > epsilon )
+  {
+    std::cout << "# Error at operation: ILU0 with parallel sweeps" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // ICHOL0:
+  viennacl::linalg::ichol0_precond< viennacl::compressed_matrix<NumericT> > vcl_ichol0(vcl_matrix, viennacl::linalg::ichol0_tag());
+  viennacl::linalg::ichol0_precond< viennacl::compressed_matrix<NumericT> > vcl_ichol0_sweeps(vcl_matrix, viennacl::linalg::ichol0_tag(iterations, iterations));
+
+  viennacl::copy(rhs, vcl_result);
+  vcl_ichol0.apply(vcl_result);
+  viennacl::copy(vcl_result, result);
+
+  viennacl::copy(rhs, vcl_result);
+  vcl_ichol0_sweeps.apply(vcl_result);
+
+  if ( std::fabs(diff(result, vcl_result)) > epsilon )
+  {
+    std::cout << "# Error at operation: ICHOL0 with parallel sweeps" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+//
+// -------------------------------------------------------------
+//
+template< typename NumericT, typename Epsilon >
+int symmetric_matrix_test(Epsilon const& epsilon)
+{
+  // 2D five-point Laplacian with additional long-range couplings, so that the row block coloring is nontrivial:
+  std::size_t points_per_dim = 20;
+  std::size_t size = points_per_dim * points_per_dim;
+
+  std::vector< std::map<unsigned int, NumericT> > stl_full(size);
+  for (std::size_t i=0; i<points_per_dim; ++i)
+    for (std::size_t j=0; j<points_per_dim; ++j)
+    {
+      unsigned int row = static_cast<unsigned int>(i * points_per_dim + j);
+      stl_full[row][row] = NumericT(5);
+      if (i > 0)                  stl_full[row][row - points_per_dim] = NumericT(-1);
+      if (j > 0)                  stl_full[row][row - 1]              = NumericT(-1);
+      if (j < points_per_dim - 1) stl_full[row][row + 1]              = NumericT(-1);
+      if (i < points_per_dim - 1) stl_full[row][row + points_per_dim] = NumericT(-1);
+    }
+  for (unsigned int row = 0; row < size; row += 7)
+  {
+    unsigned int col = static_cast<unsigned int>((row * 13 + 5) % size);
+    if (col != row)
+    {
+      stl_full[row][col] = NumericT(-0.25);
+      stl_full[col][row] = NumericT(-0.25);
+    }
+  }
+
+  std::vector< std::map<unsigned int, NumericT> > stl_upper(size);
+  std::vector< std::map<unsigned int, NumericT> > stl_lower(size);
+  for (std::size_t row = 0; row < size; ++row)
+    for (typename std::map<unsigned int, NumericT>::const_iterator it = stl_full[row].begin(); it != stl_full[row].end(); ++it)
+    {
+      if (it->first >= row)
+        stl_upper[row][it->first] = it->second;
+      if (it->first <= row)
+        stl_lower[row][it->first] = it->second;
+    }
+
+  ublas::compressed_matrix<NumericT> ublas_matrix(size, size);
+  for (std::size_t row = 0; row < size; ++row)
+    for (typename std::map<unsigned int, NumericT>::const_iterator it = stl_full[row].begin(); it != stl_full[row].end(); ++it)
+      ublas_matrix(row, it->first) = it->second;
+
+  viennacl::compressed_matrix<NumericT> vcl_compressed_matrix(size, size);
+  viennacl::symmetric_compressed_matrix<NumericT> vcl_sym_full(size, size);
+  viennacl::symmetric_compressed_matrix<NumericT> vcl_sym_upper(size, size);
+  viennacl::symmetric_compressed_matrix<NumericT> vcl_sym_lower(size, size);
+  viennacl::copy(stl_full, vcl_compressed_matrix);
+  viennacl::copy(ublas_matrix, vcl_sym_full);
+  viennacl::copy(stl_upper, vcl_sym_upper);
+  viennacl::copy(stl_lower, vcl_sym_lower);
+
+  if (vcl_sym_full.nnz() != (ublas_matrix.nnz() + size) / 2 || vcl_sym_upper.nnz() != vcl_sym_full.nnz() || vcl_sym_lower.nnz() != vcl_sym_full.nnz())
+  {
+    std::cout << "# Error at operation: copy to symmetric_compressed_matrix (wrong number of nonzeros)" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if ( std::fabs(diff(ublas_matrix, vcl_sym_full)) > epsilon || std::fabs(diff(ublas_matrix, vcl_sym_lower)) > epsilon )
+  {
+    std::cout << "# Error at operation: copy back from symmetric_compressed_matrix" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ublas::vector<NumericT> rhs(size);
+  for (std::size_t i=0; i<size; ++i)
+    rhs[i] = NumericT(1) + random<NumericT>();
+  ublas::vector<NumericT> result = ublas::prod(ublas_matrix, rhs);
+
+  viennacl::vector<NumericT> vcl_rhs(size);
+  viennacl::vector<NumericT> vcl_result(size);
+  viennacl::copy(rhs, vcl_rhs);
+
+  vcl_result = viennacl::linalg::prod(vcl_sym_full, vcl_rhs);
+  if ( norm_relative_diff(result, vcl_result) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product with symmetric_compressed_matrix" << std::endl;
+    std::cout << "  diff: " << norm_relative_diff(result, vcl_result) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vcl_result = viennacl::linalg::prod(vcl_sym_upper, vcl_rhs);
+  if ( norm_relative_diff(result, vcl_result) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product with symmetric_compressed_matrix (from upper triangular part)" << std::endl;
+    std::cout << "  diff: " << norm_relative_diff(result, vcl_result) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // strided vectors:
+  ublas::vector<NumericT> rhs_strided(2 * size);
+  for (std::size_t i=0; i<size; ++i)
+    rhs_strided[2*i+1] = rhs[i];
+  viennacl::vector<NumericT> vcl_rhs_strided(2 * size);
+  viennacl::vector<NumericT> vcl_result_strided(3 * size);
+  viennacl::copy(rhs_strided, vcl_rhs_strided);
+  vcl_result_strided.clear();
+
+  viennacl::project(vcl_result_strided, viennacl::slice(2, 3, size)) = viennacl::linalg::prod(vcl_sym_lower, viennacl::project(vcl_rhs_strided, viennacl::slice(1, 2, size)));
+  ublas::vector<NumericT> result_strided(3 * size);
+  viennacl::copy(vcl_result_strided, result_strided);
+  viennacl::copy(ublas::vector<NumericT>(ublas::project(result_strided, ublas::slice(2, 3, size))), vcl_result);
+  if ( norm_relative_diff(result, vcl_result) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product with symmetric_compressed_matrix and strided vectors" << std::endl;
+    std::cout << "  diff: " << norm_relative_diff(result, vcl_result) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // row information used by Jacobi and row scaling preconditioners:
+  viennacl::vector<NumericT> vcl_info_ref(size);
+  viennacl::vector<NumericT> vcl_info(size);
+  ublas::vector<NumericT> info_ref(size);
+  for (int info = 0; info < 4; ++info)
+  {
+    viennacl::linalg::detail::row_info_types info_selector = static_cast<viennacl::linalg::detail::row_info_types>(info);
+    viennacl::linalg::detail::row_info(vcl_compressed_matrix, vcl_info_ref, info_selector);
+    viennacl::linalg::detail::row_info(vcl_sym_full, vcl_info, info_selector);
+    viennacl::copy(vcl_info_ref, info_ref);
+    if ( norm_relative_diff(info_ref, vcl_info) > epsilon )
+    {
+      std::cout << "# Error at operation: row information " << info << " of symmetric_compressed_matrix" << std::endl;
+      std::cout << "  diff: " << norm_relative_diff(info_ref, vcl_info) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // ICHOL0 must agree with the one computed from the full matrix:
+  viennacl::linalg::ichol0_precond< viennacl::compressed_matrix<NumericT> >           vcl_ichol0(vcl_compressed_matrix, viennacl::linalg::ichol0_tag());
+  viennacl::linalg::ichol0_precond< viennacl::symmetric_compressed_matrix<NumericT> > vcl_ichol0_sym(vcl_sym_full, viennacl::linalg::ichol0_tag());
+
+  viennacl::copy(rhs, vcl_result);
+  vcl_ichol0.apply(vcl_result);
+  viennacl::copy(vcl_result, result);
+
+  viennacl::copy(rhs, vcl_result);
+  vcl_ichol0_sym.apply(vcl_result);
+
+  if ( norm_relative_diff(result, vcl_result) > epsilon )
+  {
+    std::cout << "# Error at operation: ICHOL0 for symmetric_compressed_matrix" << std::endl;
+    std::cout << "  diff: " << norm_relative_diff(result, vcl_result) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // CG with Jacobi preconditioner:
+  viennacl::linalg::jacobi_precond< viennacl::symmetric_compressed_matrix<NumericT> > vcl_jacobi(vcl_sym_full, viennacl::linalg::jacobi_tag());
+  vcl_result = viennacl::linalg::solve(vcl_sym_full, vcl_rhs, viennacl::linalg::cg_tag(epsilon, 2 * size), vcl_jacobi);
+  viennacl::vector<NumericT> vcl_residual = viennacl::linalg::prod(vcl_compressed_matrix, vcl_result);
+  vcl_residual -= vcl_rhs;
+  if ( viennacl::linalg::norm_2(vcl_residual) > 10 * epsilon * viennacl::linalg::norm_2(vcl_rhs) )
+  {
+    std::cout << "# Error at operation: CG with Jacobi preconditioner for symmetric_compressed_matrix" << std::endl;
+    std::cout << "  residual norm: " << viennacl::linalg::norm_2(vcl_residual) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // CG and BiCGStab with convergence checks at every fifth iteration only:
+  viennacl::linalg::cg_tag cg_interval_tag(epsilon, 2 * size, 5);
+  vcl_result = viennacl::linalg::solve(vcl_sym_full, vcl_rhs, cg_interval_tag, vcl_jacobi);
+  vcl_residual = viennacl::linalg::prod(vcl_compressed_matrix, vcl_result);
+  vcl_residual -= vcl_rhs;
+  if (   viennacl::linalg::norm_2(vcl_residual) > 10 * epsilon * viennacl::linalg::norm_2(vcl_rhs)
+      || (cg_interval_tag.iters() % 5 != 0 && cg_interval_tag.iters() != cg_interval_tag.max_iterations()) )
+  {
+    std::cout << "# Error at operation: CG with check interval for symmetric_compressed_matrix" << std::endl;
+    std::cout << "  residual norm: " << viennacl::linalg::norm_2(vcl_residual) << ", iterations: " << cg_interval_tag.iters() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  viennacl::linalg::bicgstab_tag bicgstab_interval_tag(epsilon, 2 * size, 200, 5);
+  vcl_result = viennacl::linalg::solve(vcl_compressed_matrix, vcl_rhs, bicgstab_interval_tag);
+  vcl_residual = viennacl::linalg::prod(vcl_compressed_matrix, vcl_result);
+  vcl_residual -= vcl_rhs;
+  if ( viennacl::linalg::norm_2(vcl_residual) > 10 * epsilon * viennacl::linalg::norm_2(vcl_rhs) )
+  {
+    std::cout << "# Error at operation: BiCGStab with check interval for compressed_matrix" << std::endl;
+    std::cout << "  residual norm: " << viennacl::linalg::norm_2(vcl_residual) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
 template< typename NumericT, typename Epsilon >
 int test(Epsilon const& epsilon)
 {
   std::cout << "Testing resizing of compressed_matrix..." << std::endl;
   int retval = resize_test<NumericT, viennacl::compressed_matrix<NumericT> >(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing incomplete factorizations with parallel sweeps..." << std::endl;
+  retval = ilu_sweeps_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing symmetric_compressed_matrix..." << std::endl;
+  retval = symmetric_matrix_test<NumericT>(epsilon);
   if (retval != EXIT_SUCCESS)
     return retval;
   std::cout << "Testing resizing of coordinate_matrix..." << std::endl;
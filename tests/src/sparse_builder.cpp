@@ -0,0 +1,215 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+//
+// *** System
+//
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <map>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/sparse_builder.hpp"
+
+/** @brief Assembles the element matrices of bilinear quadrilateral elements on a structured grid with points_per_dim x points_per_dim vertices.
+*
+* Neighboring elements contribute to the same entries, so the triplets contain duplicates. Both the builder and a reference in std::map format are filled.
+*/
+template <typename ScalarType>
+void assemble(std::size_t points_per_dim, ScalarType scale, bool use_buffer_ids,
+              viennacl::sparse_builder<ScalarType> & builder,
+              std::vector< std::map<unsigned int, ScalarType> > & reference)
+{
+  std::size_t elements_per_dim = points_per_dim - 1;
+  long num_elements = static_cast<long>(elements_per_dim * elements_per_dim);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for schedule(static) if (!use_buffer_ids)
+#endif
+  for (long e = 0; e < num_elements; ++e)
+  {
+    std::size_t i = static_cast<std::size_t>(e) / elements_per_dim;
+    std::size_t j = static_cast<std::size_t>(e) % elements_per_dim;
+    unsigned int vertices[4];
+    vertices[0] = static_cast<unsigned int>( i      * points_per_dim + j);
+    vertices[1] = static_cast<unsigned int>( i      * points_per_dim + j + 1);
+    vertices[2] = static_cast<unsigned int>((i + 1) * points_per_dim + j);
+    vertices[3] = static_cast<unsigned int>((i + 1) * points_per_dim + j + 1);
+
+    for (std::size_t k=0; k<4; ++k)
+      for (std::size_t l=0; l<4; ++l)
+      {
+        ScalarType value = scale * ((k == l) ? ScalarType(4) : ScalarType(-1)) / ScalarType(1 + e % 3);
+        if (use_buffer_ids)
+          builder.add(builder.num_buffers() - 1, vertices[k], vertices[l], value); //single-threaded use of an explicit buffer
+        else
+          builder.add(vertices[k], vertices[l], value);
+      }
+  }
+
+  // reference:
+  for (long e = 0; e < num_elements; ++e)
+  {
+    std::size_t i = static_cast<std::size_t>(e) / elements_per_dim;
+    std::size_t j = static_cast<std::size_t>(e) % elements_per_dim;
+    unsigned int vertices[4];
+    vertices[0] = static_cast<unsigned int>( i      * points_per_dim + j);
+    vertices[1] = static_cast<unsigned int>( i      * points_per_dim + j + 1);
+    vertices[2] = static_cast<unsigned int>((i + 1) * points_per_dim + j);
+    vertices[3] = static_cast<unsigned int>((i + 1) * points_per_dim + j + 1);
+
+    for (std::size_t k=0; k<4; ++k)
+      for (std::size_t l=0; l<4; ++l)
+        reference[vertices[k]][vertices[l]] += scale * ((k == l) ? ScalarType(4) : ScalarType(-1)) / ScalarType(1 + e % 3);
+  }
+}
+
+/** @brief Compares the sparsity pattern and the entries of a compressed_matrix with a reference */
+template <typename ScalarType>
+bool check(viennacl::compressed_matrix<ScalarType> const & A, std::vector< std::map<unsigned int, ScalarType> > const & reference, double epsilon)
+{
+  std::vector< std::map<unsigned int, ScalarType> > stl_A(A.size1());
+  viennacl::copy(A, stl_A);
+
+  std::size_t nonzeros = 0;
+  for (std::size_t i=0; i<reference.size(); ++i)
+    nonzeros += reference[i].size();
+  if (A.nnz() != nonzeros)
+  {
+    std::cout << "# Error: Number of nonzeros mismatch: " << A.nnz() << " vs. " << nonzeros << std::endl;
+    return false;
+  }
+
+  for (std::size_t i=0; i<reference.size(); ++i)
+  {
+    if (stl_A[i].size() != reference[i].size())
+    {
+      std::cout << "# Error: Sparsity pattern mismatch in row " << i << std::endl;
+      return false;
+    }
+    for (typename std::map<unsigned int, ScalarType>::const_iterator it = reference[i].begin(); it != reference[i].end(); ++it)
+    {
+      typename std::map<unsigned int, ScalarType>::const_iterator it_A = stl_A[i].find(it->first);
+      if (it_A == stl_A[i].end() || std::fabs(it_A->second - it->second) > epsilon * std::fabs(it->second))
+      {
+        std::cout << "# Error: Entry mismatch at (" << i << ", " << it->first << ")" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename ScalarType>
+int test(double epsilon)
+{
+  std::size_t points_per_dim = 30;
+  std::size_t size = points_per_dim * points_per_dim;
+
+  // assembly from within a parallel region:
+  std::cout << " Testing assembly..." << std::endl;
+  viennacl::sparse_builder<ScalarType> builder(size, size);
+  builder.reserve(16 * size / builder.num_buffers());
+  std::vector< std::map<unsigned int, ScalarType> > reference(size);
+  assemble(points_per_dim, ScalarType(1), false, builder, reference);
+
+  viennacl::compressed_matrix<ScalarType> A(size, size);
+  builder.finalize(A);
+  if (!check(A, reference, epsilon))
+    return EXIT_FAILURE;
+  if (builder.num_triplets() != 0 || !builder.has_pattern() || builder.nnz() != A.nnz())
+  {
+    std::cout << "# Error: Builder state after finalize() incorrect" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // reassembly with new values into the same pattern:
+  std::cout << " Testing reassembly..." << std::endl;
+  std::vector< std::map<unsigned int, ScalarType> > reference2(size);
+  assemble(points_per_dim, ScalarType(2.5), false, builder, reference2);
+  builder.reassemble(A);
+  if (!check(A, reference2, epsilon))
+    return EXIT_FAILURE;
+
+  // explicit buffer ids and a matrix with empty rows:
+  std::cout << " Testing explicit buffers..." << std::endl;
+  viennacl::sparse_builder<ScalarType> builder2(size + 7, size + 7, 3);
+  std::vector< std::map<unsigned int, ScalarType> > reference3(size + 7);
+  assemble(points_per_dim, ScalarType(-1), true, builder2, reference3);
+  builder2.add(0, static_cast<unsigned int>(size + 5), static_cast<unsigned int>(size + 2), ScalarType(3));
+  builder2.add(1, static_cast<unsigned int>(size + 5), static_cast<unsigned int>(size + 2), ScalarType(4));
+  reference3[size + 5][static_cast<unsigned int>(size + 2)] = ScalarType(7);
+
+  viennacl::compressed_matrix<ScalarType> B;
+  builder2.finalize(B);
+  if (B.size1() != size + 7 || B.size2() != size + 7 || !check(B, reference3, epsilon))
+    return EXIT_FAILURE;
+
+  // empty builder:
+  std::cout << " Testing empty builder..." << std::endl;
+  viennacl::sparse_builder<ScalarType> builder3(5, 5);
+  viennacl::compressed_matrix<ScalarType> C;
+  builder3.finalize(C);
+  if (C.size1() != 5 || C.size2() != 5 || C.nnz() != 1)
+  {
+    std::cout << "# Error: Matrix from empty builder incorrect" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Sparse Matrix Builder" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: float" << std::endl;
+  if (test<float>(1e-5) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if ( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    if (test<double>(1e-12) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
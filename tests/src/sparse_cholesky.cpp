@@ -0,0 +1,223 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+//
+// *** System
+//
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <map>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/sparse_cholesky.hpp"
+
+/** @brief Sets up the finite difference Laplace operator on a structured grid with nx x ny x nz points, shifted by 'shift' on the diagonal.
+*
+* Points with an index offset are placed in a second, disconnected grid of the same size if 'two_parts' is set.
+*/
+template <typename ScalarType>
+void laplace(std::size_t nx, std::size_t ny, std::size_t nz, ScalarType shift, bool two_parts,
+             std::vector< std::map<unsigned int, ScalarType> > & A)
+{
+  std::size_t points = nx * ny * nz;
+  std::size_t parts = two_parts ? 2 : 1;
+  A.clear();
+  A.resize(parts * points);
+
+  for (std::size_t p=0; p<parts; ++p)
+    for (std::size_t k=0; k<nz; ++k)
+      for (std::size_t j=0; j<ny; ++j)
+        for (std::size_t i=0; i<nx; ++i)
+        {
+          unsigned int row = static_cast<unsigned int>(p * points + (k * ny + j) * nx + i);
+          A[row][row] = ScalarType(nz > 1 ? 6 : 4) + shift;
+          if (i > 0)      A[row][row - 1] = ScalarType(-1);
+          if (i + 1 < nx) A[row][row + 1] = ScalarType(-1);
+          if (j > 0)      A[row][static_cast<unsigned int>(row - nx)] = ScalarType(-1);
+          if (j + 1 < ny) A[row][static_cast<unsigned int>(row + nx)] = ScalarType(-1);
+          if (k > 0)      A[row][static_cast<unsigned int>(row - nx * ny)] = ScalarType(-1);
+          if (k + 1 < nz) A[row][static_cast<unsigned int>(row + nx * ny)] = ScalarType(-1);
+        }
+}
+
+/** @brief Solves with the factorization and checks the relative residual */
+template <typename ScalarType>
+bool check_solve(viennacl::compressed_matrix<ScalarType> const & A, viennacl::linalg::sparse_cholesky<ScalarType> const & chol, double epsilon)
+{
+  std::vector<ScalarType> std_rhs(A.size1());
+  for (std::size_t i=0; i<std_rhs.size(); ++i)
+    std_rhs[i] = ScalarType(1) + ScalarType(i % 7) / ScalarType(7);
+
+  viennacl::vector<ScalarType> rhs(A.size1());
+  viennacl::copy(std_rhs, rhs);
+  viennacl::vector<ScalarType> x = rhs;
+  chol.apply(x);
+
+  viennacl::vector<ScalarType> residual = viennacl::linalg::prod(A, x);
+  residual -= rhs;
+  double relative_residual = static_cast<double>(viennacl::linalg::norm_2(residual)) / static_cast<double>(viennacl::linalg::norm_2(rhs));
+  if (relative_residual > epsilon)
+  {
+    std::cout << "# Error: Relative residual too large: " << relative_residual << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template <typename ScalarType>
+int test(double epsilon)
+{
+  std::vector< std::map<unsigned int, ScalarType> > std_A;
+
+  //
+  // 2d Laplace, both orderings:
+  //
+  std::cout << " Testing 2d Laplace operator..." << std::endl;
+  laplace<ScalarType>(40, 30, 1, ScalarType(0), false, std_A);
+  viennacl::compressed_matrix<ScalarType> A(std_A.size(), std_A.size());
+  viennacl::copy(std_A, A);
+
+  viennacl::linalg::sparse_cholesky<ScalarType> chol_nd(A);
+  if (!chol_nd.factorized() || !check_solve(A, chol_nd, epsilon))
+    return EXIT_FAILURE;
+
+  viennacl::linalg::sparse_cholesky<ScalarType> chol_natural(A, viennacl::linalg::sparse_cholesky_tag(viennacl::linalg::SPARSE_CHOLESKY_NATURAL_ORDERING, 64, false));
+  if (!chol_natural.factorized() || !check_solve(A, chol_natural, epsilon))
+    return EXIT_FAILURE;
+  if (chol_nd.nnz() >= chol_natural.nnz())
+  {
+    std::cout << "# Error: Nested dissection does not reduce fill: " << chol_nd.nnz() << " vs. " << chol_natural.nnz() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // 3d Laplace with two disconnected parts:
+  //
+  std::cout << " Testing 3d Laplace operator..." << std::endl;
+  laplace<ScalarType>(11, 10, 9, ScalarType(0), true, std_A);
+  viennacl::compressed_matrix<ScalarType> B(std_A.size(), std_A.size());
+  viennacl::copy(std_A, B);
+
+  viennacl::linalg::sparse_cholesky<ScalarType> chol(B, viennacl::linalg::sparse_cholesky_tag(viennacl::linalg::SPARSE_CHOLESKY_NESTED_DISSECTION_ORDERING, 16));
+  if (!chol.factorized() || !check_solve(B, chol, epsilon))
+    return EXIT_FAILURE;
+
+  //
+  // refactorization with new values, reusing the analysis:
+  //
+  std::cout << " Testing refactorization..." << std::endl;
+  laplace<ScalarType>(11, 10, 9, ScalarType(0.5), true, std_A);
+  viennacl::copy(std_A, B);
+  if (!chol.factorize(B) || !check_solve(B, chol, epsilon))
+    return EXIT_FAILURE;
+
+  //
+  // free solve() and preconditioned CG:
+  //
+  std::cout << " Testing solve() and CG with sparse Cholesky preconditioner..." << std::endl;
+  viennacl::vector<ScalarType> rhs = viennacl::scalar_vector<ScalarType>(B.size1(), ScalarType(1));
+  viennacl::vector<ScalarType> x = viennacl::linalg::solve(B, rhs, viennacl::linalg::sparse_cholesky_tag());
+  viennacl::vector<ScalarType> residual = viennacl::linalg::prod(B, x);
+  residual -= rhs;
+  if (viennacl::linalg::norm_2(residual) > epsilon * viennacl::linalg::norm_2(rhs))
+  {
+    std::cout << "# Error: solve() failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  viennacl::linalg::cg_tag cg_tag(epsilon, 10);
+  x = viennacl::linalg::solve(B, rhs, cg_tag, chol);
+  if (cg_tag.iters() > 2)
+  {
+    std::cout << "# Error: CG with exact preconditioner needs " << cg_tag.iters() << " iterations" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // indefinite matrix:
+  //
+  std::cout << " Testing detection of indefinite matrix..." << std::endl;
+  laplace<ScalarType>(11, 10, 9, ScalarType(-3), true, std_A);
+  viennacl::copy(std_A, B);
+  if (chol.factorize(B) || chol.factorized())
+  {
+    std::cout << "# Error: Indefinite matrix not detected" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  bool exception_thrown = false;
+  try
+  {
+    x = viennacl::linalg::solve(B, rhs, viennacl::linalg::sparse_cholesky_tag());
+  }
+  catch (viennacl::numerical_exception const &)
+  {
+    exception_thrown = true;
+  }
+  if (!exception_thrown)
+  {
+    std::cout << "# Error: solve() did not report the indefinite matrix" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Sparse Cholesky Factorization" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: float" << std::endl;
+  if (test<float>(1e-4) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if ( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    if (test<double>(1e-10) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
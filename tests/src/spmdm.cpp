@@ -68,33 +68,46 @@ int check_matrices(const ublas::matrix< ScalarType >& ref_mat, const ublas::matr
 }
 
 
-int main()
+template <typename ScalarType, typename SparseMatrixType, typename F>
+int check_product(SparseMatrixType const & sp_lhs,
+                  viennacl::matrix<ScalarType, F> const & rhs, viennacl::matrix<ScalarType, F> const & rhs_trans,
+                  ublas::matrix<ScalarType> const & ublas_result)
+{
+  ublas::matrix<ScalarType> temp(ublas_result.size1(), ublas_result.size2());
+  viennacl::matrix<ScalarType, F> result;
+
+  result = viennacl::linalg::prod(sp_lhs, rhs);
+  viennacl::copy(result, temp);
+  if (check_matrices(ublas_result, temp) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "  transposed dense rhs: ";
+  result.clear();
+  result = viennacl::linalg::prod(sp_lhs, viennacl::trans(rhs_trans));
+  temp.clear();
+  viennacl::copy(result, temp);
+  return check_matrices(ublas_result, temp);
+}
+
+/** @brief Tests the products of a sparse matrix in all formats with a dense matrix with 'rhs_cols' columns and layout F */
+template <typename F>
+int run_test(std::size_t rhs_cols)
 {
   typedef float       ScalarType;
-  
+
   std::size_t size = 1024, size1, size2;
-  int retVal = EXIT_SUCCESS;
 
   ublas::compressed_matrix<ScalarType> ublas_lhs(size/2, size);
   viennacl::compressed_matrix<ScalarType> compressed_lhs(size/2, size);
   viennacl::ell_matrix<ScalarType> ell_lhs;
   viennacl::coordinate_matrix<ScalarType> coo_lhs;
+  viennacl::hyb_matrix<ScalarType> hyb_lhs;
 
-  ublas::matrix<ScalarType> ublas_rhs1(size, size/2);
-  viennacl::matrix<ScalarType> rhs1(size, size/2);
+  ublas::matrix<ScalarType> ublas_rhs1(size, rhs_cols);
+  viennacl::matrix<ScalarType, F> rhs1(size, rhs_cols);
 
-//  ublas::matrix<ScalarType> ublas_rhs2(size/2, size);
-//  viennacl::matrix<ScalarType> rhs2(size/2, size);
   ublas::matrix<ScalarType> ublas_rhs2;
-  viennacl::matrix<ScalarType> rhs2;
-
-//  ublas::matrix<ScalarType> ublas_result( size/2, size/2);
-//  viennacl::matrix<ScalarType> result( size/2, size/2);
-  ublas::matrix<ScalarType> ublas_result;
-  viennacl::matrix<ScalarType> result;
-
-  ublas::matrix<ScalarType> temp( size/2, size/2);
-
+  viennacl::matrix<ScalarType, F> rhs2;
 
   size1 = size/2;
   size2 = size;
@@ -103,87 +116,64 @@ int main()
   for (unsigned int i = 2; i < size1; i++) {
     ublas_lhs(i, i-2) = -1.1f; ublas_lhs(i, i-1) = -2.2f; ublas_lhs(i, i) = 3.3f; ublas_lhs(i, i+1) = 2.2f; ublas_lhs(i, i+2) = 1.1f;
   }
+  for (unsigned int i = 0; i < size1; i += 7)   // a few longer rows for the CSR part of the HYB format
+    for (unsigned int j = size/2; j < size; j += 37)
+      ublas_lhs(i, j) = 0.5f;
 
   viennacl::copy( ublas_lhs, compressed_lhs);
   viennacl::copy( ublas_lhs, ell_lhs);
   viennacl::copy( ublas_lhs, coo_lhs);
+  viennacl::copy( ublas_lhs, hyb_lhs);
 
-  size1 = size;
-  size2 = size/2;
-  for (unsigned int i = 0; i < size1; i++)
-    for (unsigned int j = 0; j < size2; j++)
+  for (unsigned int i = 0; i < size2; i++)
+    for (unsigned int j = 0; j < rhs_cols; j++)
       ublas_rhs1(i,j) = random<ScalarType>();
   viennacl::copy( ublas_rhs1, rhs1);
 
   ublas_rhs2 = ublas::trans( ublas_rhs1);
+  rhs2.resize(rhs_cols, size2, false);
   viennacl::copy( ublas_rhs2, rhs2);
 
   /* gold result */
-  ublas_result = ublas::prod( ublas_lhs, ublas_rhs1);
-
-  /******************************************************************/
-  std::cout << "Testing compressed(CSR) lhs * dense rhs" << std::endl;
-  result = viennacl::linalg::prod( compressed_lhs, rhs1);
-
-  temp.clear();
-  viennacl::copy( result, temp);
-  retVal = check_matrices(ublas_result, temp);
-
-  /******************************************************************/
-  std::cout << "Testing compressed(ELL) lhs * dense rhs" << std::endl;
-  result.clear();
-  result = viennacl::linalg::prod( ell_lhs, rhs1);
-
-  temp.clear();
-  viennacl::copy( result, temp);
-  check_matrices(ublas_result, temp);
+  ublas::matrix<ScalarType> ublas_result = ublas::prod( ublas_lhs, ublas_rhs1);
 
-  /******************************************************************/
-
-//  std::cout << "Testing compressed(COO) lhs * dense rhs" << std::endl;
-//  result.clear();
-//  result = viennacl::linalg::prod( coo_lhs, rhs1);
-//
-//  temp.clear();
-//  viennacl::copy( result, temp);
-//  check_matrices(ublas_result, temp);
+  std::cout << "Testing compressed(CSR) lhs * dense rhs: ";
+  if (check_product(compressed_lhs, rhs1, rhs2, ublas_result) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
 
-  /******************************************************************/
+  std::cout << "Testing compressed(ELL) lhs * dense rhs: ";
+  if (check_product(ell_lhs, rhs1, rhs2, ublas_result) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
 
-  /* gold result */
-  ublas_result = ublas::prod( ublas_lhs, ublas::trans(ublas_rhs2));
+#if !defined(VIENNACL_WITH_OPENCL) && !defined(VIENNACL_WITH_CUDA)
+  std::cout << "Testing compressed(COO) lhs * dense rhs: ";
+  if (check_product(coo_lhs, rhs1, rhs2, ublas_result) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
 
-  /******************************************************************/
-  std::cout << std::endl << "Testing compressed(CSR) lhs * transposed dense rhs:" << std::endl;
-  result.clear();
-  result = viennacl::linalg::prod( compressed_lhs, viennacl::trans(rhs2));
+  std::cout << "Testing compressed(HYB) lhs * dense rhs: ";
+  if (check_product(hyb_lhs, rhs1, rhs2, ublas_result) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+#endif
 
-  temp.clear();
-  viennacl::copy( result, temp);
-  retVal = check_matrices(ublas_result, temp);
+  return EXIT_SUCCESS;
+}
 
-  /******************************************************************/
-  std::cout << "Testing compressed(ELL) lhs * transposed dense rhs" << std::endl;
-  result.clear();
-  result = viennacl::linalg::prod( ell_lhs, viennacl::trans(rhs2));
 
-  temp.clear();
-  viennacl::copy( result, temp);
-  check_matrices(ublas_result, temp);
+int main()
+{
+  std::cout << "# Row-major dense matrices" << std::endl;
+  if (run_test<viennacl::row_major>(512) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (run_test<viennacl::row_major>(37) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
 
-  /******************************************************************/
-//  std::cout << "Testing compressed(COO) lhs * transposed dense rhs" << std::endl;
-//  result.clear();
-//  result = viennacl::linalg::prod( coo_lhs, viennacl::trans(rhs2));
-//
-//  temp.clear();
-//  viennacl::copy( result, temp);
-//  check_matrices(ublas_result, temp);
+  std::cout << "# Column-major dense matrices" << std::endl;
+  if (run_test<viennacl::column_major>(512) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (run_test<viennacl::column_major>(37) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
 
-  /******************************************************************/
-  if(retVal == EXIT_SUCCESS) {
-    std::cout << "Tests passed successfully" << std::endl;
-  }
+  std::cout << "Tests passed successfully" << std::endl;
 
-  return retVal;
+  return EXIT_SUCCESS;
 }
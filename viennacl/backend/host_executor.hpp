@@ -0,0 +1,437 @@
+#ifndef VIENNACL_BACKEND_HOST_EXECUTOR_HPP
+#define VIENNACL_BACKEND_HOST_EXECUTOR_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/backend/host_executor.hpp
+    @brief Asynchronous execution of operations in main memory on a pool of worker threads.
+
+    Enabled by defining VIENNACL_WITH_HOST_ASYNC (requires POSIX threads). Once started via current_host_executor().start(),
+    vector operations, inner products, norms, and matrix-vector products in main memory are enqueued as tasks and return immediately.
+    Dependencies between tasks are derived from the buffers they read and write, hence independent operations run concurrently.
+    Synchronous operations and data transfers wait for pending tasks on the buffers they access, viennacl::backend::finish() waits for all tasks.
+
+    Objects passed to asynchronous operations, including sparse matrices, are kept alive by the tasks, hence they may be destroyed right after the call.
+    Sparse matrix types without asynchronous support, such as coordinate_matrix, are processed synchronously.
+    An error of a task is rethrown by the next wait for one of the buffers accessed by the task, or else by the next wait for all tasks.
+*/
+
+#include <vector>
+#include <deque>
+#include <map>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include <pthread.h>
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+  namespace backend
+  {
+    /** @brief Base class of the tasks run by the host executor */
+    class host_task
+    {
+      public:
+        host_task() : num_predecessors_(0) {}
+        virtual ~host_task() {}
+
+        /** @brief Runs the operation */
+        virtual void run() = 0;
+
+        /** @brief Registers a buffer read by the task */
+        void reads(void const * buffer)  { if (buffer) { buffers_.push_back(buffer); is_write_.push_back(false); } }
+        /** @brief Registers a buffer written by the task */
+        void writes(void const * buffer) { if (buffer) { buffers_.push_back(buffer); is_write_.push_back(true); } }
+
+      private:
+        friend class host_executor;
+
+        std::vector<void const *> buffers_;
+        std::vector<bool>         is_write_;
+        std::vector<host_task *>  successors_;
+        std::size_t               num_predecessors_;
+    };
+
+
+    /** @brief Runs tasks on a pool of worker threads in the order given by their buffer dependencies.
+    *
+    * Each worker has its own queue of ready tasks. Successors of a finished task are put into the queue of the worker which ran the task,
+    * idle workers steal from the other queues.
+    */
+    class host_executor
+    {
+        struct buffer_state
+        {
+          buffer_state() : last_writer(NULL), pending(0) {}
+
+          host_task *              last_writer;
+          std::vector<host_task *> readers;      //readers since the last write
+          std::size_t              pending;      //number of unfinished tasks accessing the buffer
+        };
+
+        struct worker_queue
+        {
+          worker_queue() { pthread_mutex_init(&mutex, NULL); }
+          ~worker_queue() { pthread_mutex_destroy(&mutex); }
+
+          pthread_mutex_t         mutex;
+          std::deque<host_task *> tasks;
+        };
+
+        struct worker_argument
+        {
+          host_executor * executor;
+          std::size_t     id;
+        };
+
+      public:
+        host_executor() : active_(false), shutdown_(false), num_ready_(0), num_running_(0), num_pending_(0), next_queue_(0), num_threads_(1), threads_per_worker_(1)
+        {
+          pthread_mutex_init(&mutex_, NULL);
+          pthread_cond_init(&work_cond_, NULL);
+          pthread_cond_init(&done_cond_, NULL);
+          pthread_key_create(&worker_key_, NULL);
+        }
+
+        ~host_executor()
+        {
+          try { stop(); } catch (...) {} //errors of tasks are reported by finish()
+          pthread_key_delete(worker_key_);
+          pthread_cond_destroy(&done_cond_);
+          pthread_cond_destroy(&work_cond_);
+          pthread_mutex_destroy(&mutex_);
+        }
+
+        /** @brief Starts the worker threads. Operations are executed asynchronously from now on.
+        *
+        * Each worker uses its share of the OpenMP threads within a task, a task running while no other task is running or ready uses all OpenMP threads.
+        *
+        * @param num_workers   Number of worker threads. If zero, one worker per four OpenMP threads, but at least two workers, are used.
+        */
+        void start(std::size_t num_workers = 0)
+        {
+          stop();
+
+#ifdef VIENNACL_WITH_OPENMP
+          std::size_t num_threads = static_cast<std::size_t>(omp_get_max_threads());
+#else
+          std::size_t num_threads = 2;
+#endif
+          if (num_workers == 0)
+            num_workers = std::max<std::size_t>(num_threads / 4, 2);
+          num_threads_        = num_threads;
+          threads_per_worker_ = std::max<std::size_t>(num_threads / num_workers, 1); //OpenMP threads used within each task
+
+          shutdown_ = false;
+          queues_.resize(num_workers);
+          for (std::size_t i=0; i<num_workers; ++i)
+            queues_[i] = new worker_queue();
+          arguments_.resize(num_workers);
+          threads_.resize(num_workers);
+          for (std::size_t i=0; i<num_workers; ++i)
+          {
+            arguments_[i].executor = this;
+            arguments_[i].id       = i;
+            pthread_create(&threads_[i], NULL, &host_executor::worker_main, &arguments_[i]);
+          }
+          active_ = true;
+        }
+
+        /** @brief Waits for all tasks and stops the worker threads. Operations are executed synchronously afterwards. */
+        void stop()
+        {
+          if (!active_)
+            return;
+
+          wait_all();
+          active_ = false;
+
+          pthread_mutex_lock(&mutex_);
+          shutdown_ = true;
+          pthread_cond_broadcast(&work_cond_);
+          pthread_mutex_unlock(&mutex_);
+
+          for (std::size_t i=0; i<threads_.size(); ++i)
+            pthread_join(threads_[i], NULL);
+          for (std::size_t i=0; i<queues_.size(); ++i)
+            delete queues_[i];
+          threads_.clear();
+          queues_.clear();
+          arguments_.clear();
+        }
+
+        /** @brief Returns true if operations are executed asynchronously */
+        bool active() const { return active_; }
+
+        /** @brief Returns the number of worker threads */
+        std::size_t num_workers() const { return threads_.size(); }
+
+        /** @brief Returns true if operations issued by the calling thread are to be enqueued, i.e. if the executor is active and the calling thread is not one of its workers */
+        bool enqueues() const { return active_ && !pthread_getspecific(worker_key_); }
+
+        /** @brief Enqueues a task. The executor takes ownership of the task. */
+        void enqueue(host_task * task)
+        {
+          pthread_mutex_lock(&mutex_);
+
+          for (std::size_t i=0; i<task->buffers_.size(); ++i)
+          {
+            buffer_state & state = buffers_[task->buffers_[i]];
+            if (state.last_writer)
+              add_dependency(state.last_writer, task);
+            if (task->is_write_[i])
+            {
+              for (std::size_t j=0; j<state.readers.size(); ++j)
+                add_dependency(state.readers[j], task);
+              state.readers.clear();
+              state.last_writer = task;
+            }
+            else
+              state.readers.push_back(task);
+            ++state.pending;
+          }
+
+          ++num_pending_;
+          if (task->num_predecessors_ == 0)
+          {
+            push_ready(task, next_queue_);
+            next_queue_ = (next_queue_ + 1) % queues_.size();
+          }
+
+          pthread_mutex_unlock(&mutex_);
+        }
+
+        /** @brief Waits for all tasks accessing the supplied buffer. Rethrows the error of a failed task which accessed the buffer, if any. Returns immediately when called from a worker thread. */
+        void wait(void const * buffer)
+        {
+          if (!enqueues())
+            return;
+
+          pthread_mutex_lock(&mutex_);
+          std::map<void const *, buffer_state>::iterator it;
+          while ( (it = buffers_.find(buffer)) != buffers_.end() )
+            pthread_cond_wait(&done_cond_, &mutex_);
+          std::string error;
+          if (std::find(error_buffers_.begin(), error_buffers_.end(), buffer) != error_buffers_.end())
+          {
+            error.swap(error_);
+            error_buffers_.clear();
+          }
+          pthread_mutex_unlock(&mutex_);
+
+          if (error.size() > 0)
+            throw std::runtime_error("Asynchronous host task failed: " + error);
+        }
+
+        /** @brief Waits for all tasks. Rethrows the error of a failed task, if any. */
+        void wait_all()
+        {
+          if (!enqueues())
+            return;
+
+          pthread_mutex_lock(&mutex_);
+          while (num_pending_ > 0)
+            pthread_cond_wait(&done_cond_, &mutex_);
+          std::string error;
+          error.swap(error_);
+          error_buffers_.clear();
+          pthread_mutex_unlock(&mutex_);
+
+          if (error.size() > 0)
+            throw std::runtime_error("Asynchronous host task failed: " + error);
+        }
+
+      private:
+        host_executor(host_executor const &);
+        host_executor & operator=(host_executor const &);
+
+        // requires mutex_
+        void add_dependency(host_task * predecessor, host_task * task)
+        {
+          if (predecessor == task || (predecessor->successors_.size() > 0 && predecessor->successors_.back() == task))
+            return;
+          predecessor->successors_.push_back(task);
+          ++task->num_predecessors_;
+        }
+
+        // requires mutex_
+        void push_ready(host_task * task, std::size_t queue_id)
+        {
+          worker_queue & queue = *queues_[queue_id];
+          pthread_mutex_lock(&queue.mutex);
+          queue.tasks.push_back(task);
+          pthread_mutex_unlock(&queue.mutex);
+
+          ++num_ready_;
+          pthread_cond_signal(&work_cond_);
+        }
+
+        /** @brief Takes the most recent task from the own queue, or the oldest task from one of the other queues */
+        host_task * pop(std::size_t id)
+        {
+          host_task * task = NULL;
+          for (std::size_t i=0; i<queues_.size() && !task; ++i)
+          {
+            worker_queue & queue = *queues_[(id + i) % queues_.size()];
+            pthread_mutex_lock(&queue.mutex);
+            if (queue.tasks.size() > 0)
+            {
+              if (i == 0)
+              {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+              }
+              else
+              {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+              }
+            }
+            pthread_mutex_unlock(&queue.mutex);
+          }
+          return task;
+        }
+
+        void complete(host_task * task, std::size_t id)
+        {
+          pthread_mutex_lock(&mutex_);
+
+          for (std::size_t i=0; i<task->buffers_.size(); ++i)
+          {
+            std::map<void const *, buffer_state>::iterator it = buffers_.find(task->buffers_[i]);
+            buffer_state & state = it->second;
+            if (state.last_writer == task)
+              state.last_writer = NULL;
+            state.readers.erase(std::remove(state.readers.begin(), state.readers.end(), task), state.readers.end());
+            if (--state.pending == 0)
+              buffers_.erase(it);
+          }
+
+          for (std::size_t i=0; i<task->successors_.size(); ++i)
+            if (--task->successors_[i]->num_predecessors_ == 0)
+              push_ready(task->successors_[i], id);
+
+          --num_running_;
+          --num_pending_;
+          pthread_cond_broadcast(&done_cond_);
+          pthread_mutex_unlock(&mutex_);
+
+          delete task;
+        }
+
+        void work(std::size_t id)
+        {
+          pthread_setspecific(worker_key_, this);
+
+          while (true)
+          {
+            host_task * task = pop(id);
+            if (task)
+            {
+              pthread_mutex_lock(&mutex_);
+              --num_ready_;
+              ++num_running_;
+              bool alone = (num_running_ == 1 && num_ready_ == 0);
+              pthread_mutex_unlock(&mutex_);
+
+#ifdef VIENNACL_WITH_OPENMP
+              omp_set_num_threads(static_cast<int>(alone ? num_threads_ : threads_per_worker_)); //a lone task, e.g. within a chain of dependent operations, uses all threads
+#else
+              (void)alone;
+#endif
+
+              try
+              {
+                task->run();
+              }
+              catch (std::exception const & e)
+              {
+                pthread_mutex_lock(&mutex_);
+                if (error_.size() == 0)
+                {
+                  error_         = e.what();
+                  error_buffers_ = task->buffers_;
+                }
+                pthread_mutex_unlock(&mutex_);
+              }
+              complete(task, id);
+              continue;
+            }
+
+            pthread_mutex_lock(&mutex_);
+            while (num_ready_ == 0 && !shutdown_)
+              pthread_cond_wait(&work_cond_, &mutex_);
+            bool done = (num_ready_ == 0 && shutdown_);
+            pthread_mutex_unlock(&mutex_);
+            if (done)
+              return;
+          }
+        }
+
+        static void * worker_main(void * argument)
+        {
+          worker_argument * arg = static_cast<worker_argument *>(argument);
+          arg->executor->work(arg->id);
+          return NULL;
+        }
+
+        bool active_;
+        bool shutdown_;
+
+        pthread_mutex_t mutex_;       //protects everything below except for the worker queues
+        pthread_cond_t  work_cond_;
+        pthread_cond_t  done_cond_;
+        pthread_key_t   worker_key_;
+
+        std::map<void const *, buffer_state> buffers_;
+        std::size_t num_ready_;
+        std::size_t num_running_;
+        std::size_t num_pending_;
+        std::size_t next_queue_;
+        std::string error_;
+        std::vector<void const *> error_buffers_;   //buffers accessed by the failed task
+
+        std::size_t                   num_threads_;
+        std::size_t                   threads_per_worker_;
+        std::vector<worker_queue *>   queues_;
+        std::vector<worker_argument>  arguments_;
+        std::vector<pthread_t>        threads_;
+    };
+
+    /** @brief Returns the executor used for operations in main memory */
+    inline host_executor & current_host_executor()
+    {
+      static host_executor executor;
+      return executor;
+    }
+
+    /** @brief Waits for the pending tasks accessing the buffer starting at the supplied address, if the host executor is active */
+    inline void host_executor_wait(void const * buffer)
+    {
+      host_executor & executor = current_host_executor();
+      if (executor.active())
+        executor.wait(buffer);
+    }
+
+  } //backend
+} //viennacl
+#endif
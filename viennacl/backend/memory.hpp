@@ -32,6 +32,10 @@
 
 #include "viennacl/backend/cpu_ram.hpp"
 
+#ifdef VIENNACL_WITH_HOST_ASYNC
+  #include "viennacl/backend/host_executor.hpp"
+#endif
+
 #ifdef VIENNACL_WITH_OPENCL
   #include "viennacl/backend/opencl.hpp"
   #include "viennacl/ocl/backend.hpp"
@@ -49,9 +53,12 @@ namespace viennacl
 
 
 // if a user compiles with CUDA, it is reasonable to expect that CUDA should be the default
-    /** @brief Synchronizes the execution. finish() will only return after all compute kernels (CUDA, OpenCL) have completed. */
+    /** @brief Synchronizes the execution. finish() will only return after all compute kernels (CUDA, OpenCL) and all asynchronous host tasks have completed. */
     inline void finish()
     {
+#ifdef VIENNACL_WITH_HOST_ASYNC
+      viennacl::backend::current_host_executor().wait_all();
+#endif
 #ifdef VIENNACL_WITH_CUDA
       cudaDeviceSynchronize();
 #endif
@@ -149,6 +156,10 @@ namespace viennacl
         switch(src_buffer.get_active_handle_id())
         {
           case MAIN_MEMORY:
+#ifdef VIENNACL_WITH_HOST_ASYNC
+            host_executor_wait(src_buffer.ram_handle().get());
+            host_executor_wait(dst_buffer.ram_handle().get());
+#endif
             cpu_ram::memory_copy(src_buffer.ram_handle(), dst_buffer.ram_handle(), src_offset, dst_offset, bytes_to_copy);
             break;
 #ifdef VIENNACL_WITH_OPENCL
@@ -227,6 +238,9 @@ namespace viennacl
         switch(dst_buffer.get_active_handle_id())
         {
           case MAIN_MEMORY:
+#ifdef VIENNACL_WITH_HOST_ASYNC
+            host_executor_wait(dst_buffer.ram_handle().get());
+#endif
             cpu_ram::memory_write(dst_buffer.ram_handle(), dst_offset, bytes_to_write, ptr, async);
             break;
 #ifdef VIENNACL_WITH_OPENCL
@@ -270,6 +284,9 @@ namespace viennacl
         switch(src_buffer.get_active_handle_id())
         {
           case MAIN_MEMORY:
+#ifdef VIENNACL_WITH_HOST_ASYNC
+            host_executor_wait(src_buffer.ram_handle().get());
+#endif
             cpu_ram::memory_read(src_buffer.ram_handle(), src_offset, bytes_to_read, ptr, async);
             break;
 #ifdef VIENNACL_WITH_OPENCL
@@ -26,6 +26,7 @@
 #include <vector>
 #include "viennacl/ocl/handle.hpp"
 #include "viennacl/ocl/backend.hpp"
+#include "viennacl/ocl/command_batch.hpp"
 
 namespace viennacl
 {
@@ -55,7 +56,16 @@ namespace viennacl
       inline cl_mem memory_create(viennacl::ocl::context const & ctx, std::size_t size_in_bytes, const void * host_ptr = NULL)
       {
         //std::cout << "Creating buffer (" << size_in_bytes << " bytes) host buffer " << host_ptr << " in context " << &ctx << std::endl;
-        return ctx.create_memory_without_smart_handle(CL_MEM_READ_WRITE, size_in_bytes, const_cast<void *>(host_ptr));
+        cl_mem mem = ctx.create_memory_without_smart_handle(CL_MEM_READ_WRITE, size_in_bytes, const_cast<void *>(host_ptr));
+
+        viennacl::ocl::command_batch * batch = viennacl::ocl::detail::recording_batch();
+        if (batch && host_ptr)   //the initial data needs to be written again on replay
+        {
+          viennacl::ocl::handle<cl_mem> temp(mem, ctx);
+          temp.inc();  //ownership remains with the caller
+          batch->record_write(temp, 0, size_in_bytes, host_ptr, ctx.get_queue());
+        }
+        return mem;
       }
 
       /** @brief Copies 'bytes_to_copy' bytes from address 'src_buffer + src_offset' in the OpenCL context to memory starting at address 'dst_buffer + dst_offset' in the same OpenCL context.
@@ -83,6 +93,10 @@ namespace viennacl
                                          bytes_to_copy,
                                          0, NULL, NULL);  //events
         VIENNACL_ERR_CHECK(err);
+
+        viennacl::ocl::command_batch * batch = viennacl::ocl::detail::recording_batch();
+        if (batch)
+          batch->record_copy(src_buffer, dst_buffer, src_offset, dst_offset, bytes_to_copy, memory_context.get_queue());
       }
 
 
@@ -110,6 +124,10 @@ namespace viennacl
                                           ptr,
                                           0, NULL, NULL);      //events
         VIENNACL_ERR_CHECK(err);
+
+        viennacl::ocl::command_batch * batch = viennacl::ocl::detail::recording_batch();
+        if (batch)
+          batch->record_write(dst_buffer, dst_offset, bytes_to_copy, ptr, memory_context.get_queue());
       }
 
 
@@ -283,6 +283,9 @@ namespace viennacl
   template<class SCALARTYPE>
   class compressed_compressed_matrix;
 
+  template<class SCALARTYPE>
+  class symmetric_compressed_matrix;
+
 
   template<class SCALARTYPE, unsigned int ALIGNMENT = 128>
   class coordinate_matrix;
@@ -421,6 +424,20 @@ namespace viennacl
     std::string message_;
   };
 
+  /** @brief Exception class in case a numerical algorithm fails, e.g. if a factorization breaks down or an iteration does not converge */
+  class numerical_exception : public std::exception
+  {
+  public:
+    numerical_exception() : message_() {}
+    numerical_exception(std::string message) : message_("ViennaCL: Numerical error: " + message) {}
+
+    virtual const char* what() const throw() { return message_.c_str(); }
+
+    virtual ~numerical_exception() throw() {}
+  private:
+    std::string message_;
+  };
+
 
   class context;
 
@@ -597,6 +614,20 @@ namespace viennacl
                                  >::type
     prod_impl(const SparseMatrixType & mat,
               const vector<SCALARTYPE, ALIGNMENT> & vec);
+
+    template<typename SparseMatrixType, class ScalarType, typename F1>
+    typename viennacl::enable_if< viennacl::is_any_sparse_matrix<SparseMatrixType>::value>::type
+    prod_impl(const SparseMatrixType & sp_mat,
+              const viennacl::matrix_base<ScalarType, F1> & d_mat,
+                    viennacl::matrix_base<ScalarType, F1> & result);
+
+    template<typename SparseMatrixType, class ScalarType, typename F1>
+    typename viennacl::enable_if< viennacl::is_any_sparse_matrix<SparseMatrixType>::value>::type
+    prod_impl(const SparseMatrixType & sp_mat,
+              const viennacl::matrix_expression<const viennacl::matrix_base<ScalarType, F1>,
+                                                const viennacl::matrix_base<ScalarType, F1>,
+                                                viennacl::op_trans>& d_mat,
+                    viennacl::matrix_base<ScalarType, F1> & result);
 #endif
 
     namespace detail
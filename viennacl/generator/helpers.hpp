@@ -55,6 +55,22 @@ namespace viennacl{
         switch(type){
           case OPERATION_UNARY_ABS_TYPE : return "abs";
           case OPERATION_UNARY_TRANS_TYPE : return "trans";
+          case OPERATION_UNARY_ACOS_TYPE : return "acos";
+          case OPERATION_UNARY_ASIN_TYPE : return "asin";
+          case OPERATION_UNARY_ATAN_TYPE : return "atan";
+          case OPERATION_UNARY_CEIL_TYPE : return "ceil";
+          case OPERATION_UNARY_COS_TYPE : return "cos";
+          case OPERATION_UNARY_COSH_TYPE : return "cosh";
+          case OPERATION_UNARY_EXP_TYPE : return "exp";
+          case OPERATION_UNARY_FABS_TYPE : return "fabs";
+          case OPERATION_UNARY_FLOOR_TYPE : return "floor";
+          case OPERATION_UNARY_LOG_TYPE : return "log";
+          case OPERATION_UNARY_LOG10_TYPE : return "log10";
+          case OPERATION_UNARY_SIN_TYPE : return "sin";
+          case OPERATION_UNARY_SINH_TYPE : return "sinh";
+          case OPERATION_UNARY_SQRT_TYPE : return "sqrt";
+          case OPERATION_UNARY_TAN_TYPE : return "tan";
+          case OPERATION_UNARY_TANH_TYPE : return "tanh";
           case OPERATION_BINARY_ASSIGN_TYPE : return "=";
           case OPERATION_BINARY_INPLACE_ADD_TYPE : return "+=";
           case OPERATION_BINARY_INPLACE_SUB_TYPE : return "-=";
@@ -62,6 +78,8 @@ namespace viennacl{
           case OPERATION_BINARY_SUB_TYPE : return "-";
           case OPERATION_BINARY_MULT_TYPE : return "*";
           case OPERATION_BINARY_DIV_TYPE : return "/";
+          case OPERATION_BINARY_ELEMENT_PROD_TYPE : return "*";
+          case OPERATION_BINARY_ELEMENT_DIV_TYPE : return "/";
           case OPERATION_BINARY_INNER_PROD_TYPE : return "iprod";
           case OPERATION_BINARY_MAT_MAT_PROD_TYPE : return "mmprod";
           case OPERATION_BINARY_MAT_VEC_PROD_TYPE : return "mvprod";
@@ -93,6 +111,15 @@ namespace viennacl{
 
       }
 
+      /** @brief checks whether an operator is a function applied to each entry, e.g. exp() */
+      inline bool is_elementwise_function(scheduler::statement_node const & node) {
+        return node.op.type_family == scheduler::OPERATION_UNARY_TYPE_FAMILY
+            && node.op.type != scheduler::OPERATION_UNARY_TRANS_TYPE
+            && node.op.type != scheduler::OPERATION_UNARY_NORM_1_TYPE
+            && node.op.type != scheduler::OPERATION_UNARY_NORM_2_TYPE
+            && node.op.type != scheduler::OPERATION_UNARY_NORM_INF_TYPE;
+      }
+
       /** @brief Recursively execute a functor on a statement */
       template<class Fun>
       static void traverse(scheduler::statement const & statement, scheduler::statement_node const & root_node, Fun const & fun, bool recurse_binary_leaf /* see forwards.h for default argument */){
@@ -235,7 +262,7 @@ namespace viennacl{
             {
               if(is_binary_leaf_operator(root_node->op.type))
                 str_ += generate(index_string_, vector_element_, *mapping_.at(std::make_pair(root_node, node_type)));
-              else if(is_arithmetic_operator(root_node->op.type))
+              else if(is_arithmetic_operator(root_node->op.type) || is_elementwise_function(*root_node))
                 str_ += generate(root_node->op.type);
             }
             else{
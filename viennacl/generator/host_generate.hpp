@@ -0,0 +1,926 @@
+#ifndef VIENNACL_GENERATOR_HOST_GENERATE_HPP
+#define VIENNACL_GENERATOR_HOST_GENERATE_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/generator/host_generate.hpp
+    @brief Generation of C++ kernels with OpenMP pragmas from scheduler statements, for operands in main memory.
+
+    This is the host counterpart of the OpenCL kernel generator in generate.hpp and covers the same kinds of operations:
+    element-wise operations on vectors and matrices (saxpy), inner products (scalar reduction), matrix-vector products (vector reduction)
+    and matrix-matrix products. Consecutive element-wise statements and consecutive inner products over vectors of the same size
+    are fused into a single loop. The kernels are compiled at runtime and cached, see host_program_cache.hpp.
+*/
+
+#include <string>
+#include <vector>
+#include <sstream>
+
+#include "viennacl/forwards.h"
+#include "viennacl/scheduler/forwards.h"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/generator/host_program_cache.hpp"
+#include "viennacl/linalg/host_based/tuning_profile.hpp"
+
+#ifdef VIENNACL_WITH_HOST_ASYNC
+  #include "viennacl/backend/host_executor.hpp"
+#endif
+
+namespace viennacl{
+
+  namespace generator{
+
+    namespace host{
+
+      /** @brief Kernel templates of the host backend */
+      enum kernel_type_family{
+        SAXPY_KERNEL_FAMILY,          //x = element-wise expression, x being a vector or a matrix
+        SCALAR_REDUCE_KERNEL_FAMILY,  //s = inner_prod(x, y), x and y being element-wise vector expressions
+        VECTOR_REDUCE_KERNEL_FAMILY,  //y = prod(A, x)
+        MATRIX_PRODUCT_KERNEL_FAMILY, //C = prod(A, B)
+        INVALID_KERNEL_FAMILY
+      };
+
+      namespace detail{
+
+        using namespace viennacl::scheduler;
+
+        /** @brief Location of the entries of a vector or matrix in main memory: Entry (i,j) is found at data[offset + i*inc1 + j*inc2]. A vector is a single row. */
+        struct tensor_layout{
+          tensor_layout() : data(NULL), offset(0), inc1(0), inc2(0), size1(0), size2(0) {}
+
+          void * data;
+          long offset;
+          long inc1;
+          long inc2;
+          long size1;
+          long size2;
+        };
+
+        template<typename NumericT>
+        bool get_layout(viennacl::vector_base<NumericT> const & vec, tensor_layout & layout){
+          if(viennacl::traits::active_handle_id(vec) != viennacl::MAIN_MEMORY)
+            return false;
+          layout.data   = viennacl::traits::ram_handle(vec).get();
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          viennacl::backend::host_executor_wait(layout.data); //the generated kernel accesses the buffer directly
+#endif
+          layout.offset = static_cast<long>(viennacl::traits::start(vec));
+          layout.inc1   = 0;
+          layout.inc2   = static_cast<long>(viennacl::traits::stride(vec));
+          layout.size1  = 1;
+          layout.size2  = static_cast<long>(vec.size());
+          return true;
+        }
+
+        template<typename NumericT>
+        bool get_layout(viennacl::matrix_base<NumericT, viennacl::row_major> const & mat, tensor_layout & layout){
+          if(viennacl::traits::active_handle_id(mat) != viennacl::MAIN_MEMORY)
+            return false;
+          layout.data   = viennacl::traits::ram_handle(mat).get();
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          viennacl::backend::host_executor_wait(layout.data); //the generated kernel accesses the buffer directly
+#endif
+          layout.offset = static_cast<long>(viennacl::traits::start1(mat) * mat.internal_size2() + viennacl::traits::start2(mat));
+          layout.inc1   = static_cast<long>(viennacl::traits::stride1(mat) * mat.internal_size2());
+          layout.inc2   = static_cast<long>(viennacl::traits::stride2(mat));
+          layout.size1  = static_cast<long>(mat.size1());
+          layout.size2  = static_cast<long>(mat.size2());
+          return true;
+        }
+
+        template<typename NumericT>
+        bool get_layout(viennacl::matrix_base<NumericT, viennacl::column_major> const & mat, tensor_layout & layout){
+          if(viennacl::traits::active_handle_id(mat) != viennacl::MAIN_MEMORY)
+            return false;
+          layout.data   = viennacl::traits::ram_handle(mat).get();
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          viennacl::backend::host_executor_wait(layout.data); //the generated kernel accesses the buffer directly
+#endif
+          layout.offset = static_cast<long>(viennacl::traits::start1(mat) + viennacl::traits::start2(mat) * mat.internal_size1());
+          layout.inc1   = static_cast<long>(viennacl::traits::stride1(mat));
+          layout.inc2   = static_cast<long>(viennacl::traits::stride2(mat) * mat.internal_size1());
+          layout.size1  = static_cast<long>(mat.size1());
+          layout.size2  = static_cast<long>(mat.size2());
+          return true;
+        }
+
+        /** @brief Fills the layout of a vector or matrix operand. Returns false if the operand is not a dense vector or matrix in main memory. */
+        inline bool get_layout(lhs_rhs_element const & e, tensor_layout & layout){
+          if(e.numeric_type == FLOAT_TYPE){
+            switch(e.subtype){
+              case DENSE_VECTOR_TYPE:     return get_layout(*e.vector_float, layout);
+              case DENSE_ROW_MATRIX_TYPE: return get_layout(*e.matrix_row_float, layout);
+              case DENSE_COL_MATRIX_TYPE: return get_layout(*e.matrix_col_float, layout);
+              default: return false;
+            }
+          }
+          else if(e.numeric_type == DOUBLE_TYPE){
+            switch(e.subtype){
+              case DENSE_VECTOR_TYPE:     return get_layout(*e.vector_double, layout);
+              case DENSE_ROW_MATRIX_TYPE: return get_layout(*e.matrix_row_double, layout);
+              case DENSE_COL_MATRIX_TYPE: return get_layout(*e.matrix_col_double, layout);
+              default: return false;
+            }
+          }
+          return false;
+        }
+
+        /** @brief Returns a pointer to the value of a scalar operand, or NULL if the scalar is not available in main memory */
+        inline void * get_scalar_pointer(lhs_rhs_element const & e){
+          if(e.subtype == HOST_SCALAR_TYPE){
+            if(e.numeric_type == FLOAT_TYPE)
+              return const_cast<float *>(&e.host_float);
+            if(e.numeric_type == DOUBLE_TYPE)
+              return const_cast<double *>(&e.host_double);
+          }
+          else if(e.subtype == DEVICE_SCALAR_TYPE){
+#ifdef VIENNACL_WITH_HOST_ASYNC
+            if(e.numeric_type == FLOAT_TYPE)
+              viennacl::backend::host_executor_wait(viennacl::traits::ram_handle(*e.scalar_float).get());
+            if(e.numeric_type == DOUBLE_TYPE)
+              viennacl::backend::host_executor_wait(viennacl::traits::ram_handle(*e.scalar_double).get());
+#endif
+            if(e.numeric_type == FLOAT_TYPE && viennacl::traits::active_handle_id(*e.scalar_float) == viennacl::MAIN_MEMORY)
+              return viennacl::traits::ram_handle(*e.scalar_float).get();
+            if(e.numeric_type == DOUBLE_TYPE && viennacl::traits::active_handle_id(*e.scalar_double) == viennacl::MAIN_MEMORY)
+              return viennacl::traits::ram_handle(*e.scalar_double).get();
+          }
+          return NULL;
+        }
+
+        inline char const * numeric_type_string(statement_node_numeric_type type){
+          switch(type){
+            case FLOAT_TYPE: return "float";
+            case DOUBLE_TYPE: return "double";
+            default: return NULL;
+          }
+        }
+
+        inline char const * assign_string(operation_node_type type){
+          switch(type){
+            case OPERATION_BINARY_ASSIGN_TYPE: return "=";
+            case OPERATION_BINARY_INPLACE_ADD_TYPE: return "+=";
+            case OPERATION_BINARY_INPLACE_SUB_TYPE: return "-=";
+            default: return NULL;
+          }
+        }
+
+        /** @brief C++ operator for an element-wise binary operation, NULL otherwise */
+        inline char const * operator_string(operation_node_type type){
+          switch(type){
+            case OPERATION_BINARY_ADD_TYPE: return "+";
+            case OPERATION_BINARY_SUB_TYPE: return "-";
+            case OPERATION_BINARY_MULT_TYPE:
+            case OPERATION_BINARY_ELEMENT_PROD_TYPE: return "*";
+            case OPERATION_BINARY_DIV_TYPE:
+            case OPERATION_BINARY_ELEMENT_DIV_TYPE: return "/";
+            default: return NULL;
+          }
+        }
+
+        /** @brief C++ function for an element-wise unary operation, NULL otherwise */
+        inline char const * function_string(operation_node_type type){
+          switch(type){
+            case OPERATION_UNARY_ABS_TYPE:
+            case OPERATION_UNARY_FABS_TYPE: return "std::fabs";
+            case OPERATION_UNARY_ACOS_TYPE: return "std::acos";
+            case OPERATION_UNARY_ASIN_TYPE: return "std::asin";
+            case OPERATION_UNARY_ATAN_TYPE: return "std::atan";
+            case OPERATION_UNARY_CEIL_TYPE: return "std::ceil";
+            case OPERATION_UNARY_COS_TYPE: return "std::cos";
+            case OPERATION_UNARY_COSH_TYPE: return "std::cosh";
+            case OPERATION_UNARY_EXP_TYPE: return "std::exp";
+            case OPERATION_UNARY_FLOOR_TYPE: return "std::floor";
+            case OPERATION_UNARY_LOG_TYPE: return "std::log";
+            case OPERATION_UNARY_LOG10_TYPE: return "std::log10";
+            case OPERATION_UNARY_SIN_TYPE: return "std::sin";
+            case OPERATION_UNARY_SINH_TYPE: return "std::sinh";
+            case OPERATION_UNARY_SQRT_TYPE: return "std::sqrt";
+            case OPERATION_UNARY_TAN_TYPE: return "std::tan";
+            case OPERATION_UNARY_TANH_TYPE: return "std::tanh";
+            default: return NULL;
+          }
+        }
+
+        /** @brief Checks that 'e' is an element-wise expression with vector or matrix operands of the given family and size, and scalars available in main memory.
+        *
+        * If 'result' is supplied, operands sharing memory with the result must be accessed at the same location, since the kernels do not use temporaries.
+        */
+        inline bool check_elementwise(statement const & s, lhs_rhs_element const & e, statement_node_type_family family, statement_node_numeric_type numeric_type,
+                                      long size1, long size2, tensor_layout const * result){
+          if(e.type_family == COMPOSITE_OPERATION_FAMILY){
+            statement_node const & node = s.array()[e.node_index];
+            if(function_string(node.op.type))
+              return check_elementwise(s, node.lhs, family, numeric_type, size1, size2, result);
+            return operator_string(node.op.type)
+                && check_elementwise(s, node.lhs, family, numeric_type, size1, size2, result)
+                && check_elementwise(s, node.rhs, family, numeric_type, size1, size2, result);
+          }
+
+          if(e.numeric_type != numeric_type)
+            return false;
+          if(e.type_family == SCALAR_TYPE_FAMILY)
+            return get_scalar_pointer(e) != NULL;
+          if(e.type_family != family)
+            return false;
+
+          tensor_layout layout;
+          if(!get_layout(e, layout) || layout.size1 != size1 || layout.size2 != size2)
+            return false;
+          if(result && layout.data == result->data)
+            return layout.offset == result->offset && layout.inc1 == result->inc1 && layout.inc2 == result->inc2;
+          return true;
+        }
+
+        /** @brief Returns true if the expression has a scalar operand located in device memory */
+        inline bool has_device_scalar(statement const & s, lhs_rhs_element const & e){
+          if(e.type_family == COMPOSITE_OPERATION_FAMILY){
+            statement_node const & node = s.array()[e.node_index];
+            return has_device_scalar(s, node.lhs) || (node.op.type_family == OPERATION_BINARY_TYPE_FAMILY && has_device_scalar(s, node.rhs));
+          }
+          return e.type_family == SCALAR_TYPE_FAMILY && e.subtype == DEVICE_SCALAR_TYPE;
+        }
+
+        /** @brief Returns the matrix operand of a product, which is either a matrix or the transpose of a matrix. */
+        inline lhs_rhs_element const * get_matrix_operand(statement const & s, lhs_rhs_element const & e, bool & transposed){
+          transposed = false;
+          lhs_rhs_element const * matrix = &e;
+          if(e.type_family == COMPOSITE_OPERATION_FAMILY){
+            statement_node const & node = s.array()[e.node_index];
+            if(node.op.type != OPERATION_UNARY_TRANS_TYPE)
+              return NULL;
+            matrix = &node.lhs;
+            transposed = true;
+          }
+          return (matrix->type_family == MATRIX_TYPE_FAMILY) ? matrix : NULL;
+        }
+
+        inline bool get_matrix_layout(statement const & s, lhs_rhs_element const & e, tensor_layout & layout){
+          bool transposed;
+          lhs_rhs_element const * matrix = get_matrix_operand(s, e, transposed);
+          if(matrix == NULL || !get_layout(*matrix, layout))
+            return false;
+          if(transposed){
+            std::swap(layout.inc1, layout.inc2);
+            std::swap(layout.size1, layout.size2);
+          }
+          return true;
+        }
+
+        inline std::string to_string(std::size_t value){
+          std::ostringstream str;
+          str << value;
+          return str.str();
+        }
+
+        /** @brief Access patterns for the entries of vector and matrix operands inside the generated loops */
+        enum access_type{
+          STRIDED_ACCESS,
+          UNIT_ROW_ACCESS,  //inc1 is known to be one
+          UNIT_COL_ACCESS   //inc2 is known to be one
+        };
+
+        /** @brief Generates the code and collects the arguments of a kernel.
+        *
+        * All operands are numbered in the order of registration. Vector and matrix operands are available as xK with layout oK, aK, bK inside the kernel,
+        * scalar operands as xK. The generated code only depends on the structure of the statements, sizes and layouts are supplied at runtime.
+        */
+        class kernel_builder{
+            enum operand_type { TENSOR_OPERAND, SCALAR_OPERAND, RESULT_SCALAR_OPERAND };
+
+          public:
+            kernel_builder() : numeric_type_(NULL), integers_(4, 0) {}
+
+            void numeric_type(char const * type) { numeric_type_ = type; }
+
+            void size(std::size_t i, long value) { integers_[i] = value; }
+
+            std::size_t num_operands() const { return operands_.size(); }
+
+            /** @brief Registers a vector or matrix operand. Transposed matrices are handled by swapping the increments. */
+            std::size_t add_tensor(tensor_layout const & layout, bool is_vector, bool is_result){
+              std::size_t id = operands_.size();
+              std::ostringstream str;
+              str << "  " << numeric_type_ << (is_result ? " * x" : " const * x") << id << " = static_cast<" << numeric_type_ << (is_result ? " *" : " const *") << ">(p[" << id << "]);"
+                  << " long const o" << id << " = n[" << integers_.size() << "], a" << id << " = n[" << integers_.size() + 1 << "], b" << id << " = n[" << integers_.size() + 2 << "];\n";
+              prologue_ += str.str();
+              signature_ += is_vector ? 'v' : 'm';
+
+              operands_.push_back(is_vector ? 'v' : 'm');
+              pointers_.push_back(layout.data);
+              integers_.push_back(layout.offset);
+              integers_.push_back(layout.inc1);
+              integers_.push_back(layout.inc2);
+              return id;
+            }
+
+            /** @brief Registers a scalar operand. Its value is read once at the beginning of the kernel. */
+            std::size_t add_scalar(lhs_rhs_element const & e){
+              std::size_t id = operands_.size();
+              char const * type = numeric_type_string(e.numeric_type);
+              std::ostringstream str;
+              str << "  " << numeric_type_ << " const x" << id << " = static_cast<" << numeric_type_ << ">(*static_cast<" << type << " const *>(p[" << id << "]));\n";
+              prologue_ += str.str();
+              signature_ += (e.subtype == HOST_SCALAR_TYPE) ? 'h' : 'd';
+              signature_ += type[0];
+
+              operands_.push_back('s');
+              pointers_.push_back(get_scalar_pointer(e));
+              return id;
+            }
+
+            /** @brief Registers a scalar holding the result of a reduction */
+            std::size_t add_result_scalar(lhs_rhs_element const & e){
+              std::size_t id = operands_.size();
+              std::ostringstream str;
+              str << "  " << numeric_type_ << " * x" << id << " = static_cast<" << numeric_type_ << " *>(p[" << id << "]);\n";
+              prologue_ += str.str();
+              signature_ += 'r';
+
+              operands_.push_back('s');
+              pointers_.push_back(get_scalar_pointer(e));
+              return id;
+            }
+
+            /** @brief Registers all operands of an element-wise expression in depth-first order */
+            void add_expression(statement const & s, lhs_rhs_element const & e){
+              if(e.type_family == COMPOSITE_OPERATION_FAMILY){
+                statement_node const & node = s.array()[e.node_index];
+                std::ostringstream str;
+                str << "(" << node.op.type;
+                signature_ += str.str();
+                add_expression(s, node.lhs);
+                if(node.op.type_family == OPERATION_BINARY_TYPE_FAMILY)
+                  add_expression(s, node.rhs);
+                signature_ += ')';
+              }
+              else if(e.type_family == SCALAR_TYPE_FAMILY)
+                add_scalar(e);
+              else{
+                tensor_layout layout;
+                get_layout(e, layout);
+                add_tensor(layout, e.type_family == VECTOR_TYPE_FAMILY, false);
+              }
+            }
+
+            /** @brief Returns the code for entry (row, col) of the operand 'id' */
+            std::string access(std::size_t id, std::string const & row, std::string const & col, access_type access) const{
+              std::ostringstream str;
+              str << "x" << id;
+              if(operands_[id] == 's')
+                return str.str();
+              str << "[o" << id;
+              if(operands_[id] == 'm'){
+                if(access == UNIT_ROW_ACCESS)
+                  str << " + " << row;
+                else
+                  str << " + " << row << "*a" << id;
+              }
+              if(access == UNIT_COL_ACCESS)
+                str << " + " << col << "]";
+              else
+                str << " + " << col << "*b" << id << "]";
+              return str.str();
+            }
+
+            /** @brief Returns the code for entry (row, col) of an element-wise expression, whose operands were registered starting with 'id' */
+            std::string expression(statement const & s, lhs_rhs_element const & e, std::size_t & id, std::string const & row, std::string const & col, access_type access) const{
+              if(e.type_family != COMPOSITE_OPERATION_FAMILY)
+                return this->access(id++, row, col, access);
+
+              statement_node const & node = s.array()[e.node_index];
+              if(char const * fun = function_string(node.op.type))
+                return std::string(fun) + "(" + expression(s, node.lhs, id, row, col, access) + ")";
+              std::string lhs = expression(s, node.lhs, id, row, col, access);
+              std::string rhs = expression(s, node.rhs, id, row, col, access);
+              return "(" + lhs + " " + operator_string(node.op.type) + " " + rhs + ")";
+            }
+
+            /** @brief Condition for all vector and matrix operands in [first, last) having unit increment inc1 ('a') or inc2 ('b') */
+            std::string unit_condition(char increment, std::size_t first, std::size_t last) const{
+              std::string condition;
+              for(std::size_t id = first ; id < last ; ++id){
+                if(operands_[id] == 's')
+                  continue;
+                std::ostringstream str;
+                str << (condition.empty() ? "" : " && ") << increment << id << " == 1";
+                condition += str.str();
+              }
+              return condition.empty() ? "true" : condition;
+            }
+
+            void append_signature(std::string const & str) { signature_ += str; }
+
+            std::string const & signature() const { return signature_; }
+            std::string const & prologue() const { return prologue_; }
+            char const * numeric_type() const { return numeric_type_; }
+
+            std::vector<void *> const & pointers() const { return pointers_; }
+            std::vector<long> const & integers() const { return integers_; }
+
+          private:
+            char const * numeric_type_;
+            std::string signature_;
+            std::string prologue_;
+            std::vector<char> operands_;
+            std::vector<void *> pointers_;
+            std::vector<long> integers_;
+        };
+
+      }
+
+      /** @brief Generates, compiles and runs C++ kernels for statements with operands in main memory.
+      *
+      * Usage is the same as for the OpenCL code generator: Statements are added one after another and executed by enqueue().
+      * The statements must stay alive until then.
+      */
+      class code_generator{
+          struct kernel_descriptor{
+            kernel_type_family family;
+            scheduler::statement_node_numeric_type numeric_type;
+            long size1;
+            long size2;
+            bool row_loop;        //true if the result is traversed row by row
+            bool fusable;         //true if further statements may be appended
+            std::vector<std::size_t> statements;
+          };
+
+          typedef std::vector<std::pair<scheduler::statement const *, scheduler::statement_node const *> > statements_type;
+
+        public:
+          /** @brief Adds a statement with the given root node
+          *   @return Whether or not the operation could be handled by the generator
+          */
+          bool add(scheduler::statement const & s, scheduler::statement_node const & root_node){
+            using namespace detail;
+
+            if(assign_string(root_node.op.type) == NULL || numeric_type_string(root_node.lhs.numeric_type) == NULL)
+              return false;
+
+            statement_node const * rhs_node = (root_node.rhs.type_family == COMPOSITE_OPERATION_FAMILY) ? &s.array()[root_node.rhs.node_index] : NULL;
+
+            kernel_descriptor descriptor;
+            descriptor.numeric_type = root_node.lhs.numeric_type;
+            descriptor.row_loop = (root_node.lhs.subtype != DENSE_COL_MATRIX_TYPE);
+            descriptor.fusable = false;
+
+            if(root_node.lhs.type_family == VECTOR_TYPE_FAMILY || root_node.lhs.type_family == MATRIX_TYPE_FAMILY){
+              tensor_layout result;
+              if(!get_layout(root_node.lhs, result))
+                return false;
+              descriptor.size1 = result.size1;
+              descriptor.size2 = result.size2;
+
+              if(rhs_node && rhs_node->op.type == OPERATION_BINARY_MAT_VEC_PROD_TYPE){
+                tensor_layout A;
+                descriptor.family = VECTOR_REDUCE_KERNEL_FAMILY;
+                if(!get_matrix_layout(s, rhs_node->lhs, A) || A.data == result.data || A.size1 != result.size2
+                   || !check_elementwise(s, rhs_node->rhs, VECTOR_TYPE_FAMILY, descriptor.numeric_type, 1, A.size2, NULL)
+                   || numeric_type_of_matrix(s, rhs_node->lhs) != descriptor.numeric_type)
+                  return false;
+                //the result must not be read while it is written:
+                if(references(s, rhs_node->rhs, result.data))
+                  return false;
+                descriptor.size1 = A.size1;
+                descriptor.size2 = A.size2;
+              }
+              else if(rhs_node && rhs_node->op.type == OPERATION_BINARY_MAT_MAT_PROD_TYPE){
+                tensor_layout A, B;
+                descriptor.family = MATRIX_PRODUCT_KERNEL_FAMILY;
+                if(!get_matrix_layout(s, rhs_node->lhs, A) || !get_matrix_layout(s, rhs_node->rhs, B)
+                   || A.data == result.data || B.data == result.data
+                   || A.size1 != result.size1 || B.size2 != result.size2 || A.size2 != B.size1)
+                  return false;
+                if(numeric_type_of_matrix(s, rhs_node->lhs) != descriptor.numeric_type || numeric_type_of_matrix(s, rhs_node->rhs) != descriptor.numeric_type)
+                  return false;
+              }
+              else{
+                descriptor.family = SAXPY_KERNEL_FAMILY;
+                descriptor.fusable = true;
+                if(!check_elementwise(s, root_node.rhs, root_node.lhs.type_family, descriptor.numeric_type, result.size1, result.size2, &result))
+                  return false;
+              }
+            }
+            else if(root_node.lhs.type_family == SCALAR_TYPE_FAMILY && root_node.lhs.subtype == DEVICE_SCALAR_TYPE
+                    && rhs_node && rhs_node->op.type == OPERATION_BINARY_INNER_PROD_TYPE){
+              descriptor.family = SCALAR_REDUCE_KERNEL_FAMILY;
+              descriptor.size1 = 1;
+              descriptor.size2 = vector_size(s, rhs_node->lhs);
+              if(get_scalar_pointer(root_node.lhs) == NULL
+                 || !check_elementwise(s, rhs_node->lhs, VECTOR_TYPE_FAMILY, descriptor.numeric_type, 1, descriptor.size2, NULL)
+                 || !check_elementwise(s, rhs_node->rhs, VECTOR_TYPE_FAMILY, descriptor.numeric_type, 1, descriptor.size2, NULL))
+                return false;
+              //scalars are read at the beginning of a kernel, hence they must not be the result of a reduction fused into the same kernel:
+              descriptor.fusable = !has_device_scalar(s, rhs_node->lhs) && !has_device_scalar(s, rhs_node->rhs);
+            }
+            else
+              return false;
+
+            statements_.push_back(std::make_pair(&s, &root_node));
+
+            if(descriptor.fusable && !kernels_.empty()){
+              kernel_descriptor & last = kernels_.back();
+              if(last.fusable && last.family == descriptor.family && last.numeric_type == descriptor.numeric_type
+                 && last.size1 == descriptor.size1 && last.size2 == descriptor.size2 && last.row_loop == descriptor.row_loop){
+                last.statements.push_back(statements_.size() - 1);
+                return true;
+              }
+            }
+            descriptor.statements.push_back(statements_.size() - 1);
+            kernels_.push_back(descriptor);
+            return true;
+          }
+
+          /** @brief Number of kernels for the statements added so far */
+          std::size_t num_kernels() const { return kernels_.size(); }
+
+          /** @brief Creates the signature identifying the generated program. Statements with the same signature share the generated code. */
+          std::string make_program_name() const{
+            std::vector<detail::kernel_builder> builders(kernels_.size());
+            std::string name;
+            for(std::size_t k = 0 ; k < kernels_.size() ; ++k){
+              build(k, builders[k], NULL);
+              name += builders[k].signature() + ";";
+            }
+            return name;
+          }
+
+          /** @brief Creates the C++ source code of the program */
+          std::string make_program_string() const{
+            std::vector<detail::kernel_builder> builders(kernels_.size());
+            std::string source = "#include <cmath>\n#include <vector>\n#include <algorithm>\n\n";
+            for(std::size_t k = 0 ; k < kernels_.size() ; ++k)
+              build(k, builders[k], &source);
+            return source;
+          }
+
+          /** @brief Compiles the program if necessary and runs the kernels */
+          void enqueue(program_cache & cache = current_program_cache()) const{
+            std::vector<detail::kernel_builder> builders(kernels_.size());
+            std::string name;
+            for(std::size_t k = 0 ; k < kernels_.size() ; ++k){
+              build(k, builders[k], NULL);
+              name += builders[k].signature() + ";";
+            }
+
+            if(!cache.has_program(name))
+              cache.add_program(name, make_program_string(), kernels_.size());
+            program const & p = cache.get_program(name);
+
+            for(std::size_t k = 0 ; k < kernels_.size() ; ++k)
+              p.kernel(k)(&(builders[k].pointers()[0]), &(builders[k].integers()[0]));
+          }
+
+        private:
+          static long vector_size(scheduler::statement const & s, scheduler::lhs_rhs_element const & e){
+            if(e.type_family == scheduler::COMPOSITE_OPERATION_FAMILY){
+              scheduler::statement_node const & node = s.array()[e.node_index];
+              long size = vector_size(s, node.lhs);
+              if(size < 0 && node.op.type_family == scheduler::OPERATION_BINARY_TYPE_FAMILY)
+                size = vector_size(s, node.rhs);
+              return size;
+            }
+            detail::tensor_layout layout;
+            if(e.type_family == scheduler::VECTOR_TYPE_FAMILY && detail::get_layout(e, layout))
+              return layout.size2;
+            return -1;
+          }
+
+          static scheduler::statement_node_numeric_type numeric_type_of_matrix(scheduler::statement const & s, scheduler::lhs_rhs_element const & e){
+            bool transposed;
+            return detail::get_matrix_operand(s, e, transposed)->numeric_type;
+          }
+
+          /** @brief Returns true if a vector or matrix operand of the expression is located in the given buffer */
+          static bool references(scheduler::statement const & s, scheduler::lhs_rhs_element const & e, void * data){
+            if(e.type_family == scheduler::COMPOSITE_OPERATION_FAMILY){
+              scheduler::statement_node const & node = s.array()[e.node_index];
+              return references(s, node.lhs, data) || (node.op.type_family == scheduler::OPERATION_BINARY_TYPE_FAMILY && references(s, node.rhs, data));
+            }
+            detail::tensor_layout layout;
+            return e.type_family != scheduler::SCALAR_TYPE_FAMILY && detail::get_layout(e, layout) && layout.data == data;
+          }
+
+          /** @brief Registers the operands of kernel k and, if 'source' is supplied, appends the kernel code */
+          void build(std::size_t k, detail::kernel_builder & builder, std::string * source) const{
+            using namespace detail;
+            kernel_descriptor const & kernel = kernels_[k];
+
+            builder.numeric_type(numeric_type_string(kernel.numeric_type));
+            std::ostringstream header;
+            header << kernel.family << builder.numeric_type()[0] << (kernel.row_loop ? 'r' : 'c');
+            builder.append_signature(header.str());
+            builder.size(0, kernel.size1);
+            builder.size(1, kernel.size2);
+
+            std::ostringstream body;
+            switch(kernel.family){
+              case SAXPY_KERNEL_FAMILY:          build_saxpy(kernel, builder, body); break;
+              case SCALAR_REDUCE_KERNEL_FAMILY:  build_scalar_reduce(kernel, builder, body); break;
+              case VECTOR_REDUCE_KERNEL_FAMILY:  build_vector_reduce(kernel, builder, body); break;
+              case MATRIX_PRODUCT_KERNEL_FAMILY: build_matrix_product(kernel, builder, body); break;
+              default: break;
+            }
+
+            if(source){
+              std::ostringstream str;
+              str << "extern \"C\" void kernel_" << k << "(void * const * p, long const * n)\n{\n";
+              str << "  long const M = n[0], N = n[1], K = n[2];\n";
+              str << "  (void)M; (void)N; (void)K;\n";
+              str << builder.prologue() << "\n" << body.str() << "}\n\n";
+              *source += str.str();
+            }
+          }
+
+          /** @brief x_i = expression_i for all statements in a single loop */
+          void build_saxpy(kernel_descriptor const & kernel, detail::kernel_builder & builder, std::ostream & stream) const{
+            using namespace detail;
+            std::vector<std::size_t> results;
+            std::vector<std::size_t> operands;
+            for(std::size_t i = 0 ; i < kernel.statements.size() ; ++i){
+              statement const & s = *statements_[kernel.statements[i]].first;
+              statement_node const & root_node = *statements_[kernel.statements[i]].second;
+              tensor_layout layout;
+              get_layout(root_node.lhs, layout);
+              builder.append_signature(assign_string(root_node.op.type));
+              results.push_back(builder.add_tensor(layout, root_node.lhs.type_family == VECTOR_TYPE_FAMILY, true));
+              operands.push_back(builder.num_operands());
+              builder.add_expression(s, root_node.rhs);
+            }
+
+            bool is_vector = (kernel.size1 == 1 && statements_[kernel.statements[0]].second->lhs.type_family == VECTOR_TYPE_FAMILY);
+            char increment = (is_vector || kernel.row_loop) ? 'b' : 'a';
+            std::string outer = kernel.row_loop ? "i" : "j";
+            std::string inner = kernel.row_loop ? "j" : "i";
+
+            for(int unit = 1 ; unit >= 0 ; --unit){
+              access_type access = unit ? ((increment == 'b') ? UNIT_COL_ACCESS : UNIT_ROW_ACCESS) : STRIDED_ACCESS;
+              if(unit)
+                stream << "  if (" << builder.unit_condition(increment, 0, builder.num_operands()) << ")\n  {\n";
+              else
+                stream << "  else\n  {\n";
+
+              if(is_vector)
+                stream << "    #pragma omp parallel for if (N > " << viennacl::linalg::host_based::current_tuning_profile().vector_min_size << ")\n"
+                       << "    for (long j = 0; j < N; ++j)\n";
+              else
+                stream << "    #pragma omp parallel for if (M * N > " << viennacl::linalg::host_based::current_tuning_profile().vector_min_size << ")\n"
+                       << "    for (long " << outer << " = 0; " << outer << " < " << (kernel.row_loop ? "M" : "N") << "; ++" << outer << ")\n"
+                       << "    for (long " << inner << " = 0; " << inner << " < " << (kernel.row_loop ? "N" : "M") << "; ++" << inner << ")\n";
+              stream << "    {\n";
+              for(std::size_t i = 0 ; i < kernel.statements.size() ; ++i){
+                statement const & s = *statements_[kernel.statements[i]].first;
+                statement_node const & root_node = *statements_[kernel.statements[i]].second;
+                std::size_t id = operands[i];
+                stream << "      " << builder.access(results[i], "i", "j", access) << " " << assign_string(root_node.op.type) << " "
+                       << builder.expression(s, root_node.rhs, id, "i", "j", access) << ";\n";
+              }
+              stream << "    }\n  }\n";
+            }
+          }
+
+          /** @brief s_i = inner_prod(x_i, y_i) for all statements in a single loop */
+          void build_scalar_reduce(kernel_descriptor const & kernel, detail::kernel_builder & builder, std::ostream & stream) const{
+            using namespace detail;
+            std::vector<std::size_t> results;
+            std::vector<std::size_t> operands;
+            std::ostringstream sums;
+            for(std::size_t i = 0 ; i < kernel.statements.size() ; ++i){
+              statement const & s = *statements_[kernel.statements[i]].first;
+              statement_node const & root_node = *statements_[kernel.statements[i]].second;
+              statement_node const & prod = s.array()[root_node.rhs.node_index];
+              builder.append_signature(assign_string(root_node.op.type));
+              results.push_back(builder.add_result_scalar(root_node.lhs));
+              operands.push_back(builder.num_operands());
+              builder.add_expression(s, prod.lhs);
+              builder.append_signature(",");
+              builder.add_expression(s, prod.rhs);
+              sums << (i > 0 ? ", " : "") << "sum" << i;
+            }
+
+            for(std::size_t i = 0 ; i < kernel.statements.size() ; ++i)
+              stream << "  " << builder.numeric_type() << " sum" << i << " = 0;\n";
+
+            for(int unit = 1 ; unit >= 0 ; --unit){
+              access_type access = unit ? UNIT_COL_ACCESS : STRIDED_ACCESS;
+              if(unit)
+                stream << "  if (" << builder.unit_condition('b', 0, builder.num_operands()) << ")\n  {\n";
+              else
+                stream << "  else\n  {\n";
+              stream << "    #pragma omp parallel for reduction(+: " << sums.str() << ") if (N > " << viennacl::linalg::host_based::current_tuning_profile().vector_min_size << ")\n"
+                     << "    for (long j = 0; j < N; ++j)\n"
+                     << "    {\n";
+              for(std::size_t i = 0 ; i < kernel.statements.size() ; ++i){
+                statement const & s = *statements_[kernel.statements[i]].first;
+                statement_node const & prod = s.array()[statements_[kernel.statements[i]].second->rhs.node_index];
+                std::size_t id = operands[i];
+                std::string lhs = builder.expression(s, prod.lhs, id, "", "j", access);
+                std::string rhs = builder.expression(s, prod.rhs, id, "", "j", access);
+                stream << "      sum" << i << " += " << lhs << " * " << rhs << ";\n";
+              }
+              stream << "    }\n  }\n";
+            }
+
+            for(std::size_t i = 0 ; i < kernel.statements.size() ; ++i)
+              stream << "  *x" << results[i] << " " << assign_string(statements_[kernel.statements[i]].second->op.type) << " sum" << i << ";\n";
+          }
+
+          /** @brief y = prod(A, x) with x being an element-wise vector expression */
+          void build_vector_reduce(kernel_descriptor const & kernel, detail::kernel_builder & builder, std::ostream & stream) const{
+            using namespace detail;
+            statement const & s = *statements_[kernel.statements[0]].first;
+            statement_node const & root_node = *statements_[kernel.statements[0]].second;
+            statement_node const & prod = s.array()[root_node.rhs.node_index];
+            char const * assign = assign_string(root_node.op.type);
+            char const * T = builder.numeric_type();
+
+            tensor_layout y, A;
+            get_layout(root_node.lhs, y);
+            get_matrix_layout(s, prod.lhs, A);
+            builder.append_signature(assign);
+            std::size_t r = builder.add_tensor(y, true, true);
+            std::size_t m = builder.add_tensor(A, false, false);
+            std::size_t x = builder.num_operands();
+            builder.add_expression(s, prod.rhs);
+
+            std::size_t id;
+            std::string a = "a" + to_string(m);
+            std::string b = "b" + to_string(m);
+
+            //entries of a row of A are adjacent: dot products
+            stream << "  if (" << b << " <= " << a << ")\n  {\n";
+            for(int unit = 1 ; unit >= 0 ; --unit){
+              access_type access = unit ? UNIT_COL_ACCESS : STRIDED_ACCESS;
+              if(unit)
+                stream << "    if (" << builder.unit_condition('b', m, builder.num_operands()) << ")\n    {\n";
+              else
+                stream << "    else\n    {\n";
+              id = x;
+              stream << "      #pragma omp parallel for if (M * N > " << viennacl::linalg::host_based::current_tuning_profile().vector_min_size << ")\n"
+                     << "      for (long i = 0; i < M; ++i)\n"
+                     << "      {\n"
+                     << "        " << T << " sum = 0;\n"
+                     << "        for (long j = 0; j < N; ++j)\n"
+                     << "          sum += " << builder.access(m, "i", "j", access) << " * " << builder.expression(s, prod.rhs, id, "", "j", access) << ";\n"
+                     << "        " << builder.access(r, "", "i", STRIDED_ACCESS) << " " << assign << " sum;\n"
+                     << "      }\n"
+                     << "    }\n";
+            }
+            stream << "  }\n";
+
+            //entries of a column of A are adjacent: linear combination of the columns, for blocks of rows
+            id = x;
+            stream << "  else\n  {\n"
+                   << "    #pragma omp parallel for if (M * N > " << viennacl::linalg::host_based::current_tuning_profile().vector_min_size << ")\n"
+                   << "    for (long block = 0; block < M; block += 128)\n"
+                   << "    {\n"
+                   << "      long const block_end = std::min(M, block + 128);\n"
+                   << "      " << T << " sum[128];\n"
+                   << "      for (long i = block; i < block_end; ++i)\n"
+                   << "        sum[i - block] = 0;\n"
+                   << "      for (long j = 0; j < N; ++j)\n"
+                   << "      {\n"
+                   << "        " << T << " const xj = " << builder.expression(s, prod.rhs, id, "", "j", STRIDED_ACCESS) << ";\n"
+                   << "        if (" << a << " == 1)\n"
+                   << "          for (long i = block; i < block_end; ++i)\n"
+                   << "            sum[i - block] += " << builder.access(m, "i", "j", UNIT_ROW_ACCESS) << " * xj;\n"
+                   << "        else\n"
+                   << "          for (long i = block; i < block_end; ++i)\n"
+                   << "            sum[i - block] += " << builder.access(m, "i", "j", STRIDED_ACCESS) << " * xj;\n"
+                   << "      }\n"
+                   << "      for (long i = block; i < block_end; ++i)\n"
+                   << "        " << builder.access(r, "", "i", STRIDED_ACCESS) << " " << assign << " sum[i - block];\n"
+                   << "    }\n"
+                   << "  }\n";
+          }
+
+          /** @brief C = prod(A, B) */
+          void build_matrix_product(kernel_descriptor const & kernel, detail::kernel_builder & builder, std::ostream & stream) const{
+            using namespace detail;
+            statement const & s = *statements_[kernel.statements[0]].first;
+            statement_node const & root_node = *statements_[kernel.statements[0]].second;
+            statement_node const & prod = s.array()[root_node.rhs.node_index];
+            char const * assign = assign_string(root_node.op.type);
+            char const * T = builder.numeric_type();
+
+            tensor_layout C, A, B;
+            get_layout(root_node.lhs, C);
+            get_matrix_layout(s, prod.lhs, A);
+            get_matrix_layout(s, prod.rhs, B);
+            builder.size(2, A.size2);
+            builder.append_signature(assign);
+            std::size_t c = builder.add_tensor(C, false, true);
+            std::size_t a = builder.add_tensor(A, false, false);
+            std::size_t b = builder.add_tensor(B, false, false);
+
+            std::string sa = to_string(a);
+            std::string sb = to_string(b);
+
+            //entries of a row of B are adjacent: C(i,:) = sum_k A(i,k) B(k,:)
+            stream << "  if (b" << sb << " <= a" << sb << ")\n  {\n"
+                   << "    #pragma omp parallel if (M * N > " << viennacl::linalg::host_based::current_tuning_profile().vector_min_size << ")\n"
+                   << "    {\n"
+                   << "      std::vector<" << T << "> row(N + 1);\n"
+                   << "      #pragma omp for\n"
+                   << "      for (long i = 0; i < M; ++i)\n"
+                   << "      {\n"
+                   << "        for (long j = 0; j < N; ++j)\n"
+                   << "          row[j] = 0;\n"
+                   << "        for (long k = 0; k < K; ++k)\n"
+                   << "        {\n"
+                   << "          " << T << " const aik = " << builder.access(a, "i", "k", STRIDED_ACCESS) << ";\n"
+                   << "          if (b" << sb << " == 1)\n"
+                   << "            for (long j = 0; j < N; ++j)\n"
+                   << "              row[j] += aik * " << builder.access(b, "k", "j", UNIT_COL_ACCESS) << ";\n"
+                   << "          else\n"
+                   << "            for (long j = 0; j < N; ++j)\n"
+                   << "              row[j] += aik * " << builder.access(b, "k", "j", STRIDED_ACCESS) << ";\n"
+                   << "        }\n"
+                   << "        for (long j = 0; j < N; ++j)\n"
+                   << "          " << builder.access(c, "i", "j", STRIDED_ACCESS) << " " << assign << " row[j];\n"
+                   << "      }\n"
+                   << "    }\n"
+                   << "  }\n";
+
+            //entries of a column of B are adjacent: C(:,j) = sum_k A(:,k) B(k,j)
+            stream << "  else\n  {\n"
+                   << "    #pragma omp parallel if (M * N > " << viennacl::linalg::host_based::current_tuning_profile().vector_min_size << ")\n"
+                   << "    {\n"
+                   << "      std::vector<" << T << "> column(M + 1);\n"
+                   << "      #pragma omp for\n"
+                   << "      for (long j = 0; j < N; ++j)\n"
+                   << "      {\n"
+                   << "        for (long i = 0; i < M; ++i)\n"
+                   << "          column[i] = 0;\n"
+                   << "        for (long k = 0; k < K; ++k)\n"
+                   << "        {\n"
+                   << "          " << T << " const bkj = " << builder.access(b, "k", "j", STRIDED_ACCESS) << ";\n"
+                   << "          if (a" << sa << " == 1)\n"
+                   << "            for (long i = 0; i < M; ++i)\n"
+                   << "              column[i] += " << builder.access(a, "i", "k", UNIT_ROW_ACCESS) << " * bkj;\n"
+                   << "          else\n"
+                   << "            for (long i = 0; i < M; ++i)\n"
+                   << "              column[i] += " << builder.access(a, "i", "k", STRIDED_ACCESS) << " * bkj;\n"
+                   << "        }\n"
+                   << "        for (long i = 0; i < M; ++i)\n"
+                   << "          " << builder.access(c, "i", "j", STRIDED_ACCESS) << " " << assign << " column[i];\n"
+                   << "      }\n"
+                   << "    }\n"
+                   << "  }\n";
+          }
+
+          statements_type statements_;
+          std::vector<kernel_descriptor> kernels_;
+      };
+
+      /** @brief Compiles (if necessary) and runs the kernels of a generator object */
+      inline void enqueue(code_generator const & generator){
+        generator.enqueue();
+      }
+
+      /** @brief Convenience function to get the C++ source code for a single statement */
+      inline std::string get_program_string(viennacl::scheduler::statement const & s){
+        code_generator gen;
+        gen.add(s, s.array()[0]);
+        return gen.make_program_string();
+      }
+
+      /** @brief Generates and runs a statement+root_node. Returns false if the statement is not supported by the host generator. */
+      inline bool generate_enqueue_statement(viennacl::scheduler::statement const & s, scheduler::statement_node const & root_node){
+        code_generator gen;
+        if(!gen.add(s, root_node))
+          return false;
+        gen.enqueue();
+        return true;
+      }
+
+      /** @brief Generates and runs a statement, assumes the root_node is the first node of the statement */
+      inline bool generate_enqueue_statement(viennacl::scheduler::statement const & s){
+        return generate_enqueue_statement(s, s.array()[0]);
+      }
+
+    }
+
+  }
+
+}
+#endif
@@ -0,0 +1,417 @@
+#ifndef VIENNACL_GENERATOR_HOST_PROGRAM_CACHE_HPP
+#define VIENNACL_GENERATOR_HOST_PROGRAM_CACHE_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/generator/host_program_cache.hpp
+    @brief Compilation of generated C++ kernels into shared objects with the system compiler, and caching of the shared objects in memory and on disk.
+
+    The compiler, the compiler flags and the cache directory are taken from the environment variables VIENNACL_HOST_JIT_CXX, VIENNACL_HOST_JIT_FLAGS
+    and VIENNACL_HOST_JIT_CACHE_PATH, if set. Otherwise, the per-user directory $XDG_CACHE_HOME/viennacl or $HOME/.cache/viennacl is used.
+    Shared objects on disk are named after a hash of the source code, the compiler, the flags and the processor, hence they are reused by later runs of the same or of other programs
+    on machines with the same processor. The source code is stored next to each shared object, led by a comment holding the compiler, the flags and the processor,
+    and a shared object is only loaded if this file matches exactly. Hash collisions thus lead to a different file name rather than to a wrong program.
+    Since loading a shared object executes its code, the cache directory and the shared objects are only used if they are owned by the effective user
+    and are neither group- nor world-writable.
+*/
+
+#include <map>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iterator>
+
+#include <set>
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "viennacl/forwards.h"
+
+namespace viennacl{
+
+  namespace generator{
+
+    namespace host{
+
+      /** @brief Exception thrown if a generated program cannot be compiled or loaded */
+      class jit_exception : public std::exception{
+        public:
+          jit_exception() : message_() {}
+          jit_exception(std::string message) : message_("ViennaCL: Host JIT error: " + message) {}
+
+          virtual const char* what() const throw() { return message_.c_str(); }
+
+          virtual ~jit_exception() throw() {}
+        private:
+          std::string message_;
+      };
+
+      /** @brief Signature of all generated kernels. The arguments are the data pointers and the integers (sizes, offsets, increments) of the operands */
+      typedef void (*kernel_function_type)(void * const * pointers, long const * integers);
+
+      /** @brief A loaded shared object with the kernels kernel_0, kernel_1, ... of a generated program */
+      class program{
+        public:
+          program() {}
+
+          program(void * handle, std::size_t num_kernels, std::string const & filename){
+            for(std::size_t i = 0 ; i < num_kernels ; ++i){
+              std::ostringstream name;
+              name << "kernel_" << i;
+              void * symbol = dlsym(handle, name.str().c_str());
+              if(symbol == NULL)
+                throw jit_exception("Kernel " + name.str() + " not found in " + filename);
+              kernel_function_type fun;
+              *reinterpret_cast<void **>(&fun) = symbol; //conversion of object pointer to function pointer as recommended by POSIX
+              kernels_.push_back(fun);
+            }
+          }
+
+          kernel_function_type kernel(std::size_t i) const { return kernels_.at(i); }
+
+          std::size_t num_kernels() const { return kernels_.size(); }
+
+        private:
+          std::vector<kernel_function_type> kernels_;
+      };
+
+      namespace detail{
+
+        inline std::string get_environment(char const * name, std::string const & default_value){
+          char const * value = std::getenv(name);
+          return (value != NULL && *value != '\0') ? std::string(value) : default_value;
+        }
+
+        /** @brief 64-bit hash of a string in hexadecimal notation, obtained from two 32-bit FNV-1a hashes with different seeds */
+        inline std::string hash_string(std::string const & str){
+          unsigned int h1 = 2166136261u;
+          unsigned int h2 = 3735928559u;
+          for(std::size_t i = 0 ; i < str.size() ; ++i){
+            h1 = (h1 ^ static_cast<unsigned char>(str[i])) * 16777619u;
+            h2 = (h2 ^ static_cast<unsigned char>(str[i])) * 16777619u;
+          }
+          char buffer[32];
+          std::sprintf(buffer, "%08x%08x", h1, h2);
+          return buffer;
+        }
+
+        /** @brief Identifies the processor, since shared objects compiled with -march=native may use instructions not available on other processors.
+        *
+        * On Linux, the vendor, model and feature flags of the first processor listed in /proc/cpuinfo are used. Otherwise, the host name is used.
+        */
+        inline std::string cpu_identity(){
+          static char const * keys[] = {"vendor_id", "cpu family", "model", "model name", "stepping", "flags",
+                                        "CPU implementer", "CPU architecture", "CPU variant", "CPU part", "CPU revision", "Features", "cpu", "isa"};
+          std::set<std::string> relevant_keys(keys, keys + sizeof(keys) / sizeof(keys[0]));
+
+          std::ifstream cpuinfo("/proc/cpuinfo");
+          std::string line;
+          std::string identity;
+          while(std::getline(cpuinfo, line)){
+            std::string::size_type colon = line.find(':');
+            if(colon == std::string::npos){
+              if(!identity.empty()) //end of the first processor
+                break;
+              continue;
+            }
+            std::string key = line.substr(0, colon);
+            key.erase(key.find_last_not_of(" \t") + 1);
+            if(relevant_keys.find(key) != relevant_keys.end())
+              identity += line + "\n";
+          }
+          if(!identity.empty())
+            return hash_string(identity);
+
+          char hostname[256];
+          if(gethostname(hostname, sizeof(hostname)) != 0)
+            return "unknown";
+          hostname[sizeof(hostname) - 1] = '\0';
+          return std::string("host ") + hostname;
+        }
+
+        /** @brief Returns true if the file exists and holds exactly the given content */
+        inline bool file_has_content(std::string const & filename, std::string const & content){
+          std::ifstream stream(filename.c_str(), std::ios::binary);
+          if(!stream)
+            return false;
+          std::string file_content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+          return file_content == content;
+        }
+
+        /** @brief Per-user cache directory: $XDG_CACHE_HOME/viennacl or $HOME/.cache/viennacl. Empty if neither variable is set. */
+        inline std::string default_cache_path(){
+          std::string xdg_cache = get_environment("XDG_CACHE_HOME", "");
+          if(!xdg_cache.empty())
+            return xdg_cache + "/viennacl";
+          std::string home = get_environment("HOME", "");
+          if(!home.empty())
+            return home + "/.cache/viennacl";
+          return "";
+        }
+
+        /** @brief Returns true if the file is owned by the effective user and is neither group- nor world-writable */
+        inline bool is_private(struct stat const & info){
+          return info.st_uid == geteuid() && (info.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+        }
+
+        /** @brief Creates the directory and missing parent directories with mode 0700, then checks that the directory may be trusted */
+        inline void create_private_directory(std::string const & path){
+          if(path.empty())
+            throw jit_exception("No cache directory: set VIENNACL_HOST_JIT_CACHE_PATH, XDG_CACHE_HOME or HOME");
+
+          for(std::string::size_type pos = path.find('/', 1) ; ; pos = path.find('/', pos + 1)){
+            std::string prefix = path.substr(0, pos);
+            if(mkdir(prefix.c_str(), S_IRWXU) != 0 && errno != EEXIST)
+              throw jit_exception("Cannot create directory " + prefix);
+            if(pos == std::string::npos)
+              break;
+          }
+
+          struct stat info;
+          if(lstat(path.c_str(), &info) != 0 || !S_ISDIR(info.st_mode))
+            throw jit_exception("Cache path " + path + " is not a directory");
+          if(!is_private(info))
+            throw jit_exception("Cache directory " + path + " is not owned by the current user or is writable by others");
+        }
+
+        /** @brief Creates a unique file from the template name, which has to end with XXXXXX, and returns its name */
+        inline std::string create_temporary_file(std::string const & name_template){
+          std::vector<char> name(name_template.begin(), name_template.end());
+          name.push_back('\0');
+          int fd = mkstemp(&(name[0]));
+          if(fd < 0)
+            throw jit_exception("Cannot create temporary file " + name_template);
+          close(fd);
+          return &(name[0]);
+        }
+
+        /** @brief Unlocks the mutex when leaving the scope */
+        class scoped_lock{
+          public:
+            explicit scoped_lock(pthread_mutex_t & mutex) : mutex_(mutex) { pthread_mutex_lock(&mutex_); }
+            ~scoped_lock() { pthread_mutex_unlock(&mutex_); }
+          private:
+            scoped_lock(scoped_lock const &);
+            scoped_lock & operator=(scoped_lock const &);
+
+            pthread_mutex_t & mutex_;
+        };
+
+        inline std::string default_flags(){
+          std::string flags = "-O3 -march=native -fPIC -shared";
+#ifdef VIENNACL_WITH_OPENMP
+          flags += " -fopenmp";
+#endif
+          return flags;
+        }
+
+      }
+
+      /** @brief Compiles generated programs and keeps the loaded shared objects.
+      *
+      * Programs are identified by their signature, which is the same for all statements sharing the structure of the generated code.
+      * Shared objects are never unloaded, since kernels may be retrieved by the caller at any time.
+      * All member functions are guarded by a mutex, hence a cache may be shared by several threads.
+      */
+      class program_cache{
+          typedef std::map<std::string, program> programs_type;
+        public:
+          program_cache() : compiler_(detail::get_environment("VIENNACL_HOST_JIT_CXX", "c++")),
+                            flags_(detail::get_environment("VIENNACL_HOST_JIT_FLAGS", detail::default_flags())),
+                            path_(detail::get_environment("VIENNACL_HOST_JIT_CACHE_PATH", detail::default_cache_path())),
+                            cpu_(detail::cpu_identity()),
+                            num_compilations_(0) { pthread_mutex_init(&mutex_, NULL); }
+
+          ~program_cache() { pthread_mutex_destroy(&mutex_); }
+
+          /** @brief Returns true if the program with the given signature is already loaded */
+          bool has_program(std::string const & signature) const{
+            detail::scoped_lock lock(mutex_);
+            return programs_.find(signature) != programs_.end();
+          }
+
+          /** @brief Returns a program previously added */
+          program const & get_program(std::string const & signature) const{
+            detail::scoped_lock lock(mutex_);
+            programs_type::const_iterator it = programs_.find(signature);
+            if(it == programs_.end())
+              throw jit_exception("Program not found: " + signature);
+            return it->second;
+          }
+
+          /** @brief Loads the program from the disk cache, or compiles it if not available there.
+          *
+          * If the program was added already, possibly by another thread, the loaded program is returned.
+          * A program whose compilation failed is not compiled again, a jit_exception is thrown instead.
+          */
+          program const & add_program(std::string const & signature, std::string const & source, std::size_t num_kernels){
+            detail::scoped_lock lock(mutex_);
+            programs_type::const_iterator it = programs_.find(signature);
+            if(it != programs_.end())
+              return it->second;
+            if(failed_.find(signature) != failed_.end())
+              throw jit_exception("Compilation failed previously: " + signature);
+
+            try{
+              std::string library;
+              void * handle = load_or_compile(source, library);
+              programs_[signature] = program(handle, num_kernels, library);
+            }
+            catch(...){
+              failed_.insert(signature);
+              throw;
+            }
+            return programs_[signature];
+          }
+
+          std::string compiler() const { detail::scoped_lock lock(mutex_); return compiler_; }
+          void compiler(std::string const & new_compiler) { detail::scoped_lock lock(mutex_); compiler_ = new_compiler; }
+
+          std::string flags() const { detail::scoped_lock lock(mutex_); return flags_; }
+          void flags(std::string const & new_flags) { detail::scoped_lock lock(mutex_); flags_ = new_flags; }
+
+          /** @brief Directory where sources and shared objects are stored */
+          std::string path() const { detail::scoped_lock lock(mutex_); return path_; }
+          void path(std::string const & new_path) { detail::scoped_lock lock(mutex_); path_ = new_path; }
+
+          /** @brief Number of invocations of the compiler so far, for diagnostic purposes */
+          std::size_t num_compilations() const { detail::scoped_lock lock(mutex_); return num_compilations_; }
+
+          /** @brief Forgets all programs loaded so far and all failed compilations. The shared objects on disk are kept. */
+          void clear(){
+            detail::scoped_lock lock(mutex_);
+            programs_.clear();
+            failed_.clear();
+          }
+
+        private:
+          program_cache(program_cache const &);
+          program_cache & operator=(program_cache const &);
+
+          /** @brief Returns the handle of the shared object for the source code, compiles the shared object if it is not in the cache directory */
+          void * load_or_compile(std::string const & source, std::string & library){
+            detail::create_private_directory(path_);
+
+            //the comment identifies the build configuration, it must not contain line breaks:
+            std::string header = "// ViennaCL host program, compiled by " + compiler_ + " " + flags_ + " for processor " + cpu_;
+            for(std::string::iterator it = header.begin() ; it != header.end() ; ++it)
+              if(*it == '\n' || *it == '\r')
+                *it = ' ';
+            std::string content = header + "\n" + source;
+
+            //find the file name for the content: a source file with different content indicates a hash collision, in which case the next name is tried.
+            std::string basename = path_ + "/viennacl_host_" + detail::hash_string(content);
+            for(std::size_t index = 1 ; ; ++index){
+              struct stat info;
+              if(lstat((basename + ".cpp").c_str(), &info) != 0 || detail::file_has_content(basename + ".cpp", content))
+                break;
+              std::ostringstream next_basename;
+              next_basename << path_ << "/viennacl_host_" << detail::hash_string(content) << "_" << index;
+              basename = next_basename.str();
+            }
+            library = basename + ".so";
+
+            struct stat info;
+            if(lstat(library.c_str(), &info) == 0 && detail::file_has_content(basename + ".cpp", content)){
+              if(!S_ISREG(info.st_mode) || !detail::is_private(info))
+                throw jit_exception("Refusing to load " + library + ", which is not a regular file owned by the current user or is writable by others");
+              void * handle = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+              if(handle != NULL)
+                return handle;
+            }
+
+            //files are created under unique names first, since concurrent processes may compile the same program.
+            //The source file has no .cpp suffix, hence the language is passed explicitly:
+            std::string source_file = detail::create_temporary_file(basename + ".src.XXXXXX");
+            std::string object_file = detail::create_temporary_file(basename + ".so.XXXXXX");
+            std::string log_file    = detail::create_temporary_file(basename + ".log.XXXXXX");
+
+            std::ofstream stream(source_file.c_str(), std::ios::binary);
+            stream << content;
+            stream.close();
+            if(!stream){
+              std::remove(source_file.c_str());
+              std::remove(object_file.c_str());
+              std::remove(log_file.c_str());
+              throw jit_exception("Cannot write " + source_file);
+            }
+
+#ifdef VIENNACL_DEBUG_BUILD
+            std::cout << "Building " << library << "..." << std::endl;
+            std::cout << source << std::endl;
+#endif
+            std::string command = compiler_ + " " + flags_ + " -o " + object_file + " -x c++ " + source_file + " > " + log_file + " 2>&1";
+            ++num_compilations_;
+            if(std::system(command.c_str()) != 0){
+              std::remove(object_file.c_str());
+              throw jit_exception("Compilation failed: " + command + ", see " + log_file);
+            }
+            std::remove(log_file.c_str());
+
+            //the linker may recreate the output file with permissions derived from the umask:
+            if(chmod(object_file.c_str(), S_IRWXU) != 0){
+              std::remove(object_file.c_str());
+              throw jit_exception("Cannot set permissions of " + object_file);
+            }
+
+            //rename() is atomic, hence other processes never load an incomplete shared object. The source file is moved first, since it validates the shared object:
+            std::rename(source_file.c_str(), (basename + ".cpp").c_str());
+            if(std::rename(object_file.c_str(), library.c_str()) != 0){
+              std::remove(object_file.c_str());
+              throw jit_exception("Cannot move " + object_file + " to " + library);
+            }
+
+            void * handle = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+            if(handle == NULL)
+              throw jit_exception(std::string("Cannot load ") + library + ": " + dlerror());
+            return handle;
+          }
+
+          std::string compiler_;
+          std::string flags_;
+          std::string path_;
+          std::string cpu_;
+          programs_type programs_;
+          std::set<std::string> failed_;
+          std::size_t num_compilations_;
+          mutable pthread_mutex_t mutex_;
+      };
+
+      /** @brief Returns the program cache used by default */
+      inline program_cache & current_program_cache(){
+        static program_cache cache;
+        return cache;
+      }
+
+    }
+
+  }
+
+}
+#endif
@@ -29,7 +29,9 @@
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/inner_prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/scalar_operations.hpp"
 #include "viennacl/traits/clear.hpp"
+#include "viennacl/traits/handle.hpp"
 #include "viennacl/traits/size.hpp"
 #include "viennacl/meta/result_of.hpp"
 
@@ -48,9 +50,10 @@ namespace viennacl
         * @param tol              Relative tolerance for the residual (solver quits if ||r|| < tol * ||r_initial||)
         * @param max_iters        The maximum number of iterations
         * @param max_iters_before_restart   The maximum number of iterations before BiCGStab is reinitialized (to avoid accumulation of round-off errors)
+        * @param check_interval   Number of iterations between two convergence checks. Only used for viennacl::vector, where each check requires a transfer of scalars to the host.
         */
-        bicgstab_tag(double tol = 1e-8, std::size_t max_iters = 400, std::size_t max_iters_before_restart = 200)
-          : tol_(tol), iterations_(max_iters), iterations_before_restart_(max_iters_before_restart) {};
+        bicgstab_tag(double tol = 1e-8, std::size_t max_iters = 400, std::size_t max_iters_before_restart = 200, std::size_t check_interval = 1)
+          : tol_(tol), iterations_(max_iters), iterations_before_restart_(max_iters_before_restart), check_interval_(check_interval > 0 ? check_interval : 1) {};
 
         /** @brief Returns the relative tolerance */
         double tolerance() const { return tol_; }
@@ -58,6 +61,8 @@ namespace viennacl
         std::size_t max_iterations() const { return iterations_; }
         /** @brief Returns the maximum number of iterations before a restart*/
         std::size_t max_iterations_before_restart() const { return iterations_before_restart_; }
+        /** @brief Returns the number of iterations between two convergence checks */
+        std::size_t check_interval() const { return check_interval_; }
 
         /** @brief Return the number of solver iterations: */
         std::size_t iters() const { return iters_taken_; }
@@ -72,6 +77,7 @@ namespace viennacl
         double tol_;
         std::size_t iterations_;
         std::size_t iterations_before_restart_;
+        std::size_t check_interval_;
 
         //return values from solver
         mutable std::size_t iters_taken_;
@@ -79,6 +85,117 @@ namespace viennacl
     };
 
 
+    namespace detail
+    {
+      /** @brief Implementation of the (preconditioned) stabilized Bi-conjugate gradient solver for viennacl::vector
+      *
+      * All coefficients are kept in device scalars. The residual norm as well as the conditions for a restart are transferred to the host only at every tag.check_interval()-th iteration.
+      * Divisions by zero in iterations between two checks result in vanishing coefficients, cf. viennacl::linalg::safe_div(). A breakdown is then detected and resolved by a restart at the next check.
+      *
+      * @param matrix     The system matrix
+      * @param rhs        The load vector
+      * @param tag        Solver configuration tag
+      * @param precond    A preconditioner. Precondition operation is done via member function apply()
+      * @return The result vector
+      */
+      template <typename MatrixType, typename T, unsigned int A, typename PreconditionerType>
+      viennacl::vector<T, A> bicgstab_solve_on_device(MatrixType const & matrix, viennacl::vector<T, A> const & rhs, bicgstab_tag const & tag, PreconditionerType const & precond)
+      {
+        viennacl::vector<T, A> result = rhs;
+        viennacl::traits::clear(result);
+
+        viennacl::vector<T, A> residual = rhs;
+        viennacl::vector<T, A> p = rhs;
+        viennacl::vector<T, A> r0star = rhs;
+        viennacl::vector<T, A> tmp0 = rhs;
+        viennacl::vector<T, A> tmp1 = rhs;
+        viennacl::vector<T, A> s = rhs;
+
+        T norm_rhs_host = viennacl::linalg::norm_2(residual);
+        T residual_norm = norm_rhs_host;
+
+        viennacl::context ctx = viennacl::traits::context(rhs);
+        viennacl::scalar<T> ip_rr0star(0, ctx);
+        viennacl::scalar<T> new_ip_rr0star(0, ctx);
+        viennacl::scalar<T> ip_tmp0_r0star(0, ctx);
+        viennacl::scalar<T> ip_tmp1_s(0, ctx);
+        viennacl::scalar<T> ip_tmp1_tmp1(0, ctx);
+        viennacl::scalar<T> alpha(0, ctx);
+        viennacl::scalar<T> omega(0, ctx);
+        viennacl::scalar<T> alpha_over_omega(0, ctx);
+        viennacl::scalar<T> rr0star_ratio(0, ctx);
+
+        if (norm_rhs_host == 0) //solution is zero if RHS norm is zero
+          return result;
+
+        bool restart_flag = true;
+        std::size_t last_restart = 0;
+        for (std::size_t i = 0; i < tag.max_iterations(); ++i)
+        {
+          if (restart_flag)
+          {
+            residual = rhs;
+            residual -= viennacl::linalg::prod(matrix, result);
+            precond.apply(residual);
+            p = residual;
+            r0star = residual;
+            ip_rr0star = viennacl::linalg::inner_prod(residual, residual);
+            restart_flag = false;
+            last_restart = i;
+          }
+
+          tag.iters(i+1);
+          tmp0 = viennacl::linalg::prod(matrix, p);
+          precond.apply(tmp0);
+          ip_tmp0_r0star = viennacl::linalg::inner_prod(tmp0, r0star);
+          viennacl::linalg::safe_div(alpha, ip_rr0star, ip_tmp0_r0star);
+
+          s = residual - alpha*tmp0;
+
+          tmp1 = viennacl::linalg::prod(matrix, s);
+          precond.apply(tmp1);
+          ip_tmp1_s    = viennacl::linalg::inner_prod(tmp1, s);
+          ip_tmp1_tmp1 = viennacl::linalg::inner_prod(tmp1, tmp1);
+          viennacl::linalg::safe_div(omega, ip_tmp1_s, ip_tmp1_tmp1);
+
+          result += alpha * p + omega * s;
+          residual = s - omega * tmp1;
+
+          new_ip_rr0star = viennacl::linalg::inner_prod(residual, r0star);
+
+          if ((i+1) % tag.check_interval() == 0 || i+1 == tag.max_iterations())
+          {
+            residual_norm = viennacl::linalg::norm_2(residual);
+            if (std::fabs(residual_norm / norm_rhs_host) < tag.tolerance())
+              break;
+
+            if (T(new_ip_rr0star) == 0 || T(omega) == 0) //search direction degenerate. A restart might help
+              restart_flag = true;
+          }
+
+          if (i - last_restart > tag.max_iterations_before_restart())
+            restart_flag = true;
+
+          // Execution of
+          //  p = residual + beta * (p - omega*tmp0);
+          // with beta = new_ip_rr0star / ip_rr0star * alpha / omega, written as
+          //  p = residual + new_ip_rr0star / ip_rr0star * (alpha / omega * p - alpha * tmp0);
+          // so that no coefficients need to be multiplied:
+          viennacl::linalg::safe_div(rr0star_ratio, new_ip_rr0star, ip_rr0star);
+          viennacl::linalg::safe_div(alpha_over_omega, alpha, omega);
+          ip_rr0star.handle().swap(new_ip_rr0star.handle());
+
+          p = alpha_over_omega * p - alpha * tmp0;
+          p = residual + rr0star_ratio * p;
+        }
+
+        //store last error estimate:
+        tag.error(residual_norm / norm_rhs_host);
+
+        return result;
+      }
+    }
+
     /** @brief Implementation of the stabilized Bi-conjugate gradient solver
     *
     * Following the description in "Iterative Methods for Sparse Linear Systems" by Y. Saad
@@ -168,12 +285,25 @@ namespace viennacl
       return result;
     }
 
+    /** @brief Stabilized Bi-conjugate gradient solver without preconditioner for viennacl::vector. Convergence is checked every tag.check_interval() iterations. */
+    template <typename MatrixType, typename T, unsigned int A>
+    viennacl::vector<T, A> solve(const MatrixType & matrix, viennacl::vector<T, A> const & rhs, bicgstab_tag const & tag)
+    {
+      return detail::bicgstab_solve_on_device(matrix, rhs, tag, viennacl::linalg::no_precond());
+    }
+
     template <typename MatrixType, typename VectorType>
     VectorType solve(const MatrixType & matrix, VectorType const & rhs, bicgstab_tag const & tag, viennacl::linalg::no_precond)
     {
       return solve(matrix, rhs, tag);
     }
 
+    template <typename MatrixType, typename T, unsigned int A>
+    viennacl::vector<T, A> solve(const MatrixType & matrix, viennacl::vector<T, A> const & rhs, bicgstab_tag const & tag, viennacl::linalg::no_precond)
+    {
+      return solve(matrix, rhs, tag);
+    }
+
     /** @brief Implementation of the preconditioned stabilized Bi-conjugate gradient solver
     *
     * Following the description of the unpreconditioned case in "Iterative Methods for Sparse Linear Systems" by Y. Saad
@@ -270,6 +400,13 @@ namespace viennacl
       return result;
     }
 
+    /** @brief Preconditioned stabilized Bi-conjugate gradient solver for viennacl::vector. Convergence is checked every tag.check_interval() iterations. */
+    template <typename MatrixType, typename T, unsigned int A, typename PreconditionerType>
+    viennacl::vector<T, A> solve(const MatrixType & matrix, viennacl::vector<T, A> const & rhs, bicgstab_tag const & tag, PreconditionerType const & precond)
+    {
+      return detail::bicgstab_solve_on_device(matrix, rhs, tag, precond);
+    }
+
   }
 }
 
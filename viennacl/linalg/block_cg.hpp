@@ -0,0 +1,218 @@
+#ifndef VIENNACL_LINALG_BLOCK_CG_HPP_
+#define VIENNACL_LINALG_BLOCK_CG_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/block_cg.hpp
+    @brief The block conjugate gradient method for multiple right hand sides is implemented here
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/detail/block_krylov.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+
+    /** @brief A tag for the block conjugate gradient method. Used for supplying solver parameters and for dispatching the solve() function
+    */
+    class block_cg_tag
+    {
+      public:
+        /** @brief The constructor
+        *
+        * @param tol              Relative tolerance for the residual of each right hand side (a column is converged if ||r|| < tol * ||b||)
+        * @param max_iterations   The maximum number of iterations
+        */
+        block_cg_tag(double tol = 1e-8, unsigned int max_iterations = 300) : tol_(tol), iterations_(max_iterations), iters_taken_(0), last_error_(0) {};
+
+        /** @brief Returns the relative tolerance */
+        double tolerance() const { return tol_; }
+        /** @brief Returns the maximum number of iterations */
+        unsigned int max_iterations() const { return iterations_; }
+
+        /** @brief Return the number of solver iterations: */
+        unsigned int iters() const { return iters_taken_; }
+        void iters(unsigned int i) const { iters_taken_ = i; }
+
+        /** @brief Returns the largest estimated relative error of all right hand sides at the end of the solver run */
+        double error() const { return last_error_; }
+        /** @brief Sets the estimated relative error at the end of the solver run */
+        void error(double e) const { last_error_ = e; }
+
+        /** @brief Returns the number of iterations after which each right hand side was converged */
+        std::vector<unsigned int> const & column_iters() const { return column_iters_; }
+        void column_iters(std::vector<unsigned int> const & i) const { column_iters_ = i; }
+
+        /** @brief Returns the estimated relative error for each right hand side at the end of the solver run */
+        std::vector<double> const & column_errors() const { return column_errors_; }
+        void column_errors(std::vector<double> const & e) const { column_errors_ = e; }
+
+      private:
+        double tol_;
+        unsigned int iterations_;
+
+        //return values from solver
+        mutable unsigned int iters_taken_;
+        mutable double last_error_;
+        mutable std::vector<unsigned int> column_iters_;
+        mutable std::vector<double> column_errors_;
+    };
+
+
+    /** @brief Implementation of the block conjugate gradient solver without preconditioner
+    *
+    * All right hand sides share the Krylov space, so the system matrix is read once per iteration for all columns.
+    * The search directions are A-orthonormalized in each iteration, dropping directions which have become linearly dependent.
+    * Right hand sides are removed from the block (deflated) as soon as they are converged.
+    *
+    * @param matrix     The sparse system matrix, must be symmetric positive definite
+    * @param rhs        The right hand sides, one per column
+    * @param tag        Solver configuration tag
+    * @return The result matrix, one solution per column
+    */
+    template <typename MatrixType, typename ScalarType, typename F>
+    viennacl::matrix<ScalarType, F> solve(MatrixType const & matrix, viennacl::matrix<ScalarType, F> const & rhs, block_cg_tag const & tag)
+    {
+      std::size_t size = rhs.size1();
+      std::size_t num_rhs = rhs.size2();
+      viennacl::context ctx = viennacl::traits::context(rhs);
+
+      viennacl::matrix<ScalarType, F> result(size, num_rhs, ctx);
+
+      std::vector<unsigned int> column_iters(num_rhs);
+      std::vector<double> column_errors(num_rhs);
+      tag.iters(0);
+      tag.error(0);
+
+      std::vector<ScalarType> norms_rhs = viennacl::linalg::detail::block_krylov_column_norms_squared(rhs);
+      std::vector<std::size_t> active;   //columns of rhs not yet converged
+      for (std::size_t j=0; j<num_rhs; ++j)
+      {
+        norms_rhs[j] = std::sqrt(norms_rhs[j]);
+        if (norms_rhs[j] > 0) //solution is zero if RHS norm is zero
+        {
+          active.push_back(j);
+          column_errors[j] = 1;
+        }
+      }
+
+      if (active.size() == 0)
+      {
+        tag.column_iters(column_iters);
+        tag.column_errors(column_errors);
+        return result;
+      }
+
+      viennacl::matrix<ScalarType, F> residual(size, active.size(), ctx);
+      viennacl::linalg::detail::block_krylov_multiply(rhs, viennacl::linalg::detail::block_krylov_selection<ScalarType>(num_rhs, active), residual, ScalarType(1), ScalarType(0));
+
+      viennacl::matrix<ScalarType, F> p = residual;
+
+      std::vector< std::vector<ScalarType> > G, R, T, alpha, beta;
+      for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+      {
+        tag.iters(i+1);
+        std::size_t k = active.size();
+
+        // A-orthonormalize search directions: P <- P T, Q <- A P T, such that P^T A P = I
+        viennacl::matrix<ScalarType, F> q(size, k, ctx);
+        q = viennacl::linalg::prod(matrix, p);
+
+        viennacl::linalg::detail::block_krylov_gram(p, q, G);
+        viennacl::linalg::detail::block_krylov_cholesky(G, R, T);
+
+        viennacl::matrix<ScalarType, F> temp(size, k, ctx);
+        viennacl::linalg::detail::block_krylov_multiply(p, T, temp, ScalarType(1), ScalarType(0));
+        p = temp;
+        viennacl::linalg::detail::block_krylov_multiply(q, T, temp, ScalarType(1), ScalarType(0));
+        q = temp;
+
+        // alpha = P^T R,  X += P alpha,  R -= Q alpha
+        viennacl::linalg::detail::block_krylov_gram(p, residual, alpha);
+
+        std::vector< std::vector<ScalarType> > alpha_full(k, std::vector<ScalarType>(num_rhs));
+        for (std::size_t r=0; r<k; ++r)
+          for (std::size_t j=0; j<k; ++j)
+            alpha_full[r][active[j]] = alpha[r][j];
+        viennacl::linalg::detail::block_krylov_multiply(p, alpha_full, result, ScalarType(1), ScalarType(1));
+        viennacl::linalg::detail::block_krylov_multiply(q, alpha, residual, ScalarType(-1), ScalarType(1));
+
+        // convergence check and deflation of converged columns:
+        std::vector<ScalarType> norms_residual = viennacl::linalg::detail::block_krylov_column_norms_squared(residual);
+        std::vector<std::size_t> still_active;
+        std::vector<std::size_t> still_active_local;
+        for (std::size_t j=0; j<k; ++j)
+        {
+          double rel_error = std::sqrt(static_cast<double>(norms_residual[j])) / norms_rhs[active[j]];
+          column_errors[active[j]] = rel_error;
+          column_iters[active[j]] = i+1;
+          if (rel_error >= tag.tolerance())
+          {
+            still_active.push_back(active[j]);
+            still_active_local.push_back(j);
+          }
+        }
+
+        if (still_active.size() == 0)
+          break;
+
+        if (still_active.size() < k)
+        {
+          viennacl::matrix<ScalarType, F> deflated_residual(size, still_active.size(), ctx);
+          viennacl::linalg::detail::block_krylov_multiply(residual, viennacl::linalg::detail::block_krylov_selection<ScalarType>(k, still_active_local), deflated_residual, ScalarType(1), ScalarType(0));
+          residual.resize(size, still_active.size(), false);
+          residual = deflated_residual;
+          active = still_active;
+        }
+
+        // beta = -Q^T R,  P <- R + P beta
+        viennacl::linalg::detail::block_krylov_gram(q, residual, beta);
+        viennacl::matrix<ScalarType, F> new_p = residual;
+        viennacl::linalg::detail::block_krylov_multiply(p, beta, new_p, ScalarType(-1), ScalarType(1));
+        p.resize(size, active.size(), false);
+        p = new_p;
+      }
+
+      //store last error estimate:
+      double max_error = 0;
+      for (std::size_t j=0; j<num_rhs; ++j)
+        max_error = std::max(max_error, column_errors[j]);
+      tag.error(max_error);
+      tag.column_iters(column_iters);
+      tag.column_errors(column_errors);
+
+      return result;
+    }
+
+    template <typename MatrixType, typename ScalarType, typename F>
+    viennacl::matrix<ScalarType, F> solve(MatrixType const & matrix, viennacl::matrix<ScalarType, F> const & rhs, block_cg_tag const & tag, viennacl::linalg::no_precond)
+    {
+      return solve(matrix, rhs, tag);
+    }
+
+  }
+}
+
+#endif
@@ -0,0 +1,250 @@
+#ifndef VIENNACL_LINALG_BLOCK_GMRES_HPP_
+#define VIENNACL_LINALG_BLOCK_GMRES_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/block_gmres.hpp
+    @brief The restarted block generalized minimum residual method for multiple right hand sides is implemented here
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/detail/block_krylov.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+
+    /** @brief A tag for the block GMRES method. Used for supplying solver parameters and for dispatching the solve() function
+    */
+    class block_gmres_tag
+    {
+      public:
+        /** @brief The constructor
+        *
+        * @param tol            Relative tolerance for the residual of each right hand side (a column is converged if ||r|| < tol * ||b||)
+        * @param max_iterations The maximum number of iterations (including restarts)
+        * @param krylov_dim     The maximum number of blocks in the Krylov space before restart
+        */
+        block_gmres_tag(double tol = 1e-10, unsigned int max_iterations = 300, unsigned int krylov_dim = 20)
+         : tol_(tol), iterations_(max_iterations), krylov_dim_(krylov_dim), iters_taken_(0), last_error_(0) {};
+
+        /** @brief Returns the relative tolerance */
+        double tolerance() const { return tol_; }
+        /** @brief Returns the maximum number of iterations */
+        unsigned int max_iterations() const { return iterations_; }
+        /** @brief Returns the maximum number of blocks in the Krylov space before restart */
+        unsigned int krylov_dim() const { return krylov_dim_; }
+
+        /** @brief Return the number of solver iterations: */
+        unsigned int iters() const { return iters_taken_; }
+        /** @brief Set the number of solver iterations (should only be modified by the solver) */
+        void iters(unsigned int i) const { iters_taken_ = i; }
+
+        /** @brief Returns the largest estimated relative error of all right hand sides at the end of the solver run */
+        double error() const { return last_error_; }
+        /** @brief Sets the estimated relative error at the end of the solver run */
+        void error(double e) const { last_error_ = e; }
+
+        /** @brief Returns the number of iterations after which each right hand side was converged */
+        std::vector<unsigned int> const & column_iters() const { return column_iters_; }
+        void column_iters(std::vector<unsigned int> const & i) const { column_iters_ = i; }
+
+        /** @brief Returns the relative residual of each right hand side at the last restart */
+        std::vector<double> const & column_errors() const { return column_errors_; }
+        void column_errors(std::vector<double> const & e) const { column_errors_ = e; }
+
+      private:
+        double tol_;
+        unsigned int iterations_;
+        unsigned int krylov_dim_;
+
+        //return values from solver
+        mutable unsigned int iters_taken_;
+        mutable double last_error_;
+        mutable std::vector<unsigned int> column_iters_;
+        mutable std::vector<double> column_errors_;
+    };
+
+
+    /** @brief Implementation of the restarted block GMRES solver without preconditioner
+    *
+    * All right hand sides share the block Krylov space, so the system matrix is read once per iteration for all columns.
+    * The block Arnoldi process uses block Gram-Schmidt with reorthogonalization and Cholesky-based orthonormalization of the new block.
+    * Converged right hand sides are removed from the block (deflated) at each restart.
+    *
+    * @param matrix     The sparse system matrix
+    * @param rhs        The right hand sides, one per column
+    * @param tag        Solver configuration tag
+    * @return The result matrix, one solution per column
+    */
+    template <typename MatrixType, typename ScalarType, typename F>
+    viennacl::matrix<ScalarType, F> solve(MatrixType const & matrix, viennacl::matrix<ScalarType, F> const & rhs, block_gmres_tag const & tag)
+    {
+      typedef std::vector< std::vector<ScalarType> >   HostMatrixType;
+
+      std::size_t size = rhs.size1();
+      std::size_t num_rhs = rhs.size2();
+      std::size_t krylov_dim = std::max<std::size_t>(1, tag.krylov_dim());
+      viennacl::context ctx = viennacl::traits::context(rhs);
+
+      viennacl::matrix<ScalarType, F> result(size, num_rhs, ctx);
+      viennacl::matrix<ScalarType, F> residual = rhs;
+
+      std::vector<unsigned int> column_iters(num_rhs);
+      std::vector<double> column_errors(num_rhs);
+      tag.iters(0);
+
+      std::vector<ScalarType> norms_rhs = viennacl::linalg::detail::block_krylov_column_norms_squared(rhs);
+      for (std::size_t j=0; j<num_rhs; ++j)
+        norms_rhs[j] = std::sqrt(norms_rhs[j]);
+
+      unsigned int iters = 0;
+      while (true)
+      {
+        // determine non-converged columns from the true residual:
+        std::vector<ScalarType> norms_residual = viennacl::linalg::detail::block_krylov_column_norms_squared(residual);
+        std::vector<std::size_t> active;
+        for (std::size_t j=0; j<num_rhs; ++j)
+        {
+          if (norms_rhs[j] == 0) //solution is zero if RHS norm is zero
+            continue;
+
+          column_errors[j] = std::sqrt(static_cast<double>(norms_residual[j])) / norms_rhs[j];
+          if (column_errors[j] >= tag.tolerance())
+            active.push_back(j);
+        }
+
+        if (active.size() == 0 || iters >= tag.max_iterations())
+          break;
+
+        std::size_t k = active.size();
+
+        // V_0 R_0 = R(:, active):
+        std::vector< viennacl::matrix<ScalarType, F> > V(krylov_dim + 1, viennacl::matrix<ScalarType, F>(size, k, ctx));
+        viennacl::linalg::detail::block_krylov_multiply(residual, viennacl::linalg::detail::block_krylov_selection<ScalarType>(num_rhs, active), V[0], ScalarType(1), ScalarType(0));
+
+        HostMatrixType G, R0, T;
+        viennacl::linalg::detail::block_krylov_gram(V[0], V[0], G);
+        viennacl::linalg::detail::block_krylov_cholesky(G, R0, T);
+        viennacl::matrix<ScalarType, F> temp(size, k, ctx);
+        viennacl::linalg::detail::block_krylov_multiply(V[0], T, temp, ScalarType(1), ScalarType(0));
+        V[0] = temp;
+
+        // block Hessenberg matrix, stored densely:
+        HostMatrixType H((krylov_dim + 1) * k, std::vector<ScalarType>(krylov_dim * k));
+        HostMatrixType Y;
+        std::size_t num_blocks = 0;
+
+        for (std::size_t j=0; j<krylov_dim && iters < tag.max_iterations(); ++j)
+        {
+          ++iters;
+          for (std::size_t l=0; l<k; ++l)
+            column_iters[active[l]] = iters;
+
+          viennacl::matrix<ScalarType, F> & w = V[j+1];
+          w = viennacl::linalg::prod(matrix, V[j]);
+
+          // block Gram-Schmidt, two passes:
+          HostMatrixType H_ij;
+          for (std::size_t pass = 0; pass < 2; ++pass)
+          {
+            for (std::size_t i=0; i<=j; ++i)
+            {
+              viennacl::linalg::detail::block_krylov_gram(V[i], w, H_ij);
+              viennacl::linalg::detail::block_krylov_multiply(V[i], H_ij, w, ScalarType(-1), ScalarType(1));
+              for (std::size_t r=0; r<k; ++r)
+                for (std::size_t c=0; c<k; ++c)
+                  H[i*k + r][j*k + c] += H_ij[r][c];
+            }
+          }
+
+          // V_{j+1} H_{j+1,j} = W
+          HostMatrixType R;
+          viennacl::linalg::detail::block_krylov_gram(w, w, G);
+          viennacl::linalg::detail::block_krylov_cholesky(G, R, T);
+          viennacl::linalg::detail::block_krylov_multiply(w, T, temp, ScalarType(1), ScalarType(0));
+          w = temp;
+          for (std::size_t r=0; r<k; ++r)
+            for (std::size_t c=0; c<k; ++c)
+              H[(j+1)*k + r][j*k + c] = R[r][c];
+
+          num_blocks = j + 1;
+
+          // least-squares problem min || E_1 R_0 - H Y ||:
+          HostMatrixType H_j((num_blocks + 1) * k, std::vector<ScalarType>(num_blocks * k));
+          HostMatrixType E((num_blocks + 1) * k, std::vector<ScalarType>(k));
+          for (std::size_t r=0; r<H_j.size(); ++r)
+            for (std::size_t c=0; c<H_j[r].size(); ++c)
+              H_j[r][c] = H[r][c];
+          for (std::size_t r=0; r<k; ++r)
+            for (std::size_t c=0; c<k; ++c)
+              E[r][c] = R0[r][c];
+
+          std::vector<ScalarType> residual_norms;
+          viennacl::linalg::detail::block_krylov_least_squares(H_j, E, Y, residual_norms);
+
+          bool all_converged = true;
+          for (std::size_t l=0; l<k; ++l)
+            if (residual_norms[l] >= tag.tolerance() * norms_rhs[active[l]])
+              all_converged = false;
+          if (all_converged)
+            break;
+        }
+
+        // X(:, active) += [V_0, ..., V_{m-1}] Y
+        for (std::size_t i=0; i<num_blocks; ++i)
+        {
+          HostMatrixType Y_i(k, std::vector<ScalarType>(num_rhs));
+          for (std::size_t r=0; r<k; ++r)
+            for (std::size_t c=0; c<k; ++c)
+              Y_i[r][active[c]] = Y[i*k + r][c];
+          viennacl::linalg::detail::block_krylov_multiply(V[i], Y_i, result, ScalarType(1), ScalarType(1));
+        }
+
+        // true residual for restart:
+        residual = viennacl::linalg::prod(matrix, result);
+        residual = rhs - residual;
+      }
+
+      tag.iters(iters);
+      double max_error = 0;
+      for (std::size_t j=0; j<num_rhs; ++j)
+        max_error = std::max(max_error, column_errors[j]);
+      tag.error(max_error);
+      tag.column_iters(column_iters);
+      tag.column_errors(column_errors);
+
+      return result;
+    }
+
+    template <typename MatrixType, typename ScalarType, typename F>
+    viennacl::matrix<ScalarType, F> solve(MatrixType const & matrix, viennacl::matrix<ScalarType, F> const & rhs, block_gmres_tag const & tag, viennacl::linalg::no_precond)
+    {
+      return solve(matrix, rhs, tag);
+    }
+
+  }
+}
+
+#endif
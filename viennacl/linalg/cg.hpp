@@ -31,7 +31,9 @@
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/inner_prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/scalar_operations.hpp"
 #include "viennacl/traits/clear.hpp"
+#include "viennacl/traits/handle.hpp"
 #include "viennacl/traits/size.hpp"
 #include "viennacl/meta/result_of.hpp"
 
@@ -49,13 +51,17 @@ namespace viennacl
         *
         * @param tol              Relative tolerance for the residual (solver quits if ||r|| < tol * ||r_initial||)
         * @param max_iterations   The maximum number of iterations
+        * @param check_interval   Number of iterations between two convergence checks. Only used for viennacl::vector, where each check requires a transfer of the residual norm to the host.
         */
-        cg_tag(double tol = 1e-8, unsigned int max_iterations = 300) : tol_(tol), iterations_(max_iterations) {};
+        cg_tag(double tol = 1e-8, unsigned int max_iterations = 300, unsigned int check_interval = 1)
+          : tol_(tol), iterations_(max_iterations), check_interval_(check_interval > 0 ? check_interval : 1) {};
 
         /** @brief Returns the relative tolerance */
         double tolerance() const { return tol_; }
         /** @brief Returns the maximum number of iterations */
         unsigned int max_iterations() const { return iterations_; }
+        /** @brief Returns the number of iterations between two convergence checks */
+        unsigned int check_interval() const { return check_interval_; }
 
         /** @brief Return the number of solver iterations: */
         unsigned int iters() const { return iters_taken_; }
@@ -70,6 +76,7 @@ namespace viennacl
       private:
         double tol_;
         unsigned int iterations_;
+        unsigned int check_interval_;
 
         //return values from solver
         mutable unsigned int iters_taken_;
@@ -77,6 +84,93 @@ namespace viennacl
     };
 
 
+    namespace detail
+    {
+      /** @brief Returns the preconditioned residual z. Without preconditioner, the residual itself is returned and 'z' remains unused. */
+      template <typename VectorType, typename PreconditionerType>
+      VectorType const & cg_apply_precond(VectorType const & residual, VectorType & z, PreconditionerType const & precond)
+      {
+        z = residual;
+        precond.apply(z);
+        return z;
+      }
+
+      template <typename VectorType>
+      VectorType const & cg_apply_precond(VectorType const & residual, VectorType &, viennacl::linalg::no_precond)
+      {
+        return residual;
+      }
+
+      /** @brief Implementation of the (preconditioned) conjugate gradient solver for viennacl::vector
+      *
+      * All coefficients are kept in device scalars, so the only transfer to the host is the residual norm at every tag.check_interval()-th iteration.
+      * Thus, the device (or the asynchronous host executor) is kept busy with the operations of the next iterations while the host waits for a convergence check.
+      * Divisions by zero in exactly converged iterations between two checks result in vanishing coefficients, cf. viennacl::linalg::safe_div().
+      *
+      * @param matrix     The system matrix
+      * @param rhs        The load vector
+      * @param tag        Solver configuration tag
+      * @param precond    A preconditioner. Precondition operation is done via member function apply()
+      * @return The result vector
+      */
+      template <typename MatrixType, typename T, unsigned int A, typename PreconditionerType>
+      viennacl::vector<T, A> cg_solve_on_device(MatrixType const & matrix, viennacl::vector<T, A> const & rhs, cg_tag const & tag, PreconditionerType const & precond)
+      {
+        viennacl::vector<T, A> result = rhs;
+        viennacl::traits::clear(result);
+
+        viennacl::vector<T, A> residual = rhs;
+        viennacl::vector<T, A> tmp = rhs;
+        viennacl::vector<T, A> z = rhs;
+        viennacl::vector<T, A> p = cg_apply_precond(residual, z, precond);
+
+        viennacl::context ctx = viennacl::traits::context(rhs);
+        viennacl::scalar<T> ip_rr = viennacl::linalg::inner_prod(residual, p);
+        viennacl::scalar<T> new_ip_rr(0, ctx);
+        viennacl::scalar<T> ip_pAp(0, ctx);
+        viennacl::scalar<T> alpha(0, ctx);
+        viennacl::scalar<T> beta(0, ctx);
+
+        T norm_rhs_squared = ip_rr;
+        T new_ip_rr_host = norm_rhs_squared;
+
+        if (norm_rhs_squared == 0) //solution is zero if RHS norm is zero
+          return result;
+
+        for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+        {
+          tag.iters(i+1);
+          tmp = viennacl::linalg::prod(matrix, p);
+
+          ip_pAp = viennacl::linalg::inner_prod(tmp, p);
+          viennacl::linalg::safe_div(alpha, ip_rr, ip_pAp);
+
+          result += alpha * p;
+          residual -= alpha * tmp;
+
+          viennacl::vector<T, A> const & precond_residual = cg_apply_precond(residual, z, precond);
+          new_ip_rr = viennacl::linalg::inner_prod(residual, precond_residual);
+
+          if ((i+1) % tag.check_interval() == 0 || i+1 == tag.max_iterations())
+          {
+            new_ip_rr_host = new_ip_rr;
+            if (std::fabs(new_ip_rr_host / norm_rhs_squared) < tag.tolerance() * tag.tolerance())    //squared norms involved here
+              break;
+          }
+
+          viennacl::linalg::safe_div(beta, new_ip_rr, ip_rr);
+          ip_rr.handle().swap(new_ip_rr.handle());
+
+          p = precond_residual + beta * p;
+        }
+
+        //store last error estimate:
+        tag.error(std::sqrt(std::fabs(new_ip_rr_host / norm_rhs_squared)));
+
+        return result;
+      }
+    }
+
     /** @brief Implementation of the conjugate gradient solver without preconditioner
     *
     * Following the algorithm in the book by Y. Saad "Iterative Methods for sparse linear systems"
@@ -136,12 +230,25 @@ namespace viennacl
       return result;
     }
 
+    /** @brief Conjugate gradient solver without preconditioner for viennacl::vector. Convergence is checked every tag.check_interval() iterations. */
+    template <typename MatrixType, typename T, unsigned int A>
+    viennacl::vector<T, A> solve(const MatrixType & matrix, viennacl::vector<T, A> const & rhs, cg_tag const & tag)
+    {
+      return detail::cg_solve_on_device(matrix, rhs, tag, viennacl::linalg::no_precond());
+    }
+
     template <typename MatrixType, typename VectorType>
     VectorType solve(const MatrixType & matrix, VectorType const & rhs, cg_tag const & tag, viennacl::linalg::no_precond)
     {
       return solve(matrix, rhs, tag);
     }
 
+    template <typename MatrixType, typename T, unsigned int A>
+    viennacl::vector<T, A> solve(const MatrixType & matrix, viennacl::vector<T, A> const & rhs, cg_tag const & tag, viennacl::linalg::no_precond)
+    {
+      return solve(matrix, rhs, tag);
+    }
+
     /** @brief Implementation of the preconditioned conjugate gradient solver
     *
     * Following Algorithm 9.1 in "Iterative Methods for Sparse Linear Systems" by Y. Saad
@@ -207,6 +314,13 @@ namespace viennacl
       return result;
     }
 
+    /** @brief Preconditioned conjugate gradient solver for viennacl::vector. Convergence is checked every tag.check_interval() iterations. */
+    template <typename MatrixType, typename T, unsigned int A, typename PreconditionerType>
+    viennacl::vector<T, A> solve(const MatrixType & matrix, viennacl::vector<T, A> const & rhs, cg_tag const & tag, PreconditionerType const & precond)
+    {
+      return detail::cg_solve_on_device(matrix, rhs, tag, precond);
+    }
+
   }
 }
 
@@ -0,0 +1,122 @@
+#ifndef VIENNACL_LINALG_CHOLESKY_HPP
+#define VIENNACL_LINALG_CHOLESKY_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/cholesky.hpp
+    @brief Implementations of the Cholesky factorization for symmetric positive definite dense matrices.
+*/
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/backend/memory.hpp"
+
+#include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/host_based/cholesky_operations.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace detail
+    {
+      /** @brief Computes the Cholesky factorization of a matrix located in a memory domain other than main memory by transferring it to the host and back. */
+      template<typename SCALARTYPE, typename F>
+      bool cholesky_factorize_on_host(matrix<SCALARTYPE, F> & A)
+      {
+        matrix<SCALARTYPE, F> A_host(A.size1(), A.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+        assert(A_host.internal_size() == A.internal_size() && bool("Buffer sizes do not match"));
+
+        SCALARTYPE * data_A_host = viennacl::linalg::host_based::detail::extract_raw_pointer<SCALARTYPE>(A_host);
+        viennacl::backend::memory_read(A.handle(), 0, sizeof(SCALARTYPE) * A.internal_size(), data_A_host);
+        bool success = viennacl::linalg::host_based::cholesky_factorize(A_host);
+        viennacl::backend::memory_write(A.handle(), 0, sizeof(SCALARTYPE) * A.internal_size(), data_A_host);
+
+        return success;
+      }
+    }
+
+    /** @brief Cholesky factorization A = L * L^T of a symmetric positive definite dense matrix.
+    *
+    * Only the lower triangle of A is referenced. On the host, a blocked right-looking factorization is run directly on the matrix.
+    * For other memory domains, the matrix is factorized on the host and transferred back.
+    *
+    * @param A    The system matrix, where the lower triangular factor L is directly written to. The strictly upper triangle is set to zero.
+    * @return false if the matrix is not positive definite
+    */
+    template<typename SCALARTYPE, typename F>
+    bool cholesky_factorize(matrix<SCALARTYPE, F> & A)
+    {
+      assert(A.size1() == A.size2() && bool("Matrix must be square"));
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          return viennacl::linalg::host_based::cholesky_factorize(A);
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          return detail::cholesky_factorize_on_host(A);
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+          return detail::cholesky_factorize_on_host(A);
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
+    //
+    // Convenience layer:
+    //
+
+    /** @brief Cholesky substitution for the system L * L^T = rhs.
+    *
+    * @param L    The Cholesky factor obtained from cholesky_factorize()
+    * @param B    The matrix of load vectors, where the solution is directly written to
+    */
+    template<typename SCALARTYPE, typename F1, typename F2, unsigned int ALIGNMENT_A, unsigned int ALIGNMENT_B>
+    void cholesky_substitute(matrix<SCALARTYPE, F1, ALIGNMENT_A> const & L,
+                             matrix<SCALARTYPE, F2, ALIGNMENT_B> & B)
+    {
+      assert(L.size1() == L.size2() && bool("Matrix must be square"));
+      assert(L.size1() == B.size1() && bool("Matrix must be square"));
+      inplace_solve(L, B, lower_tag());
+      inplace_solve(trans(L), B, upper_tag());
+    }
+
+    /** @brief Cholesky substitution for the system L * L^T = rhs.
+    *
+    * @param L      The Cholesky factor obtained from cholesky_factorize()
+    * @param vec    The load vector, where the solution is directly written to
+    */
+    template<typename SCALARTYPE, typename F, unsigned int ALIGNMENT, unsigned int VEC_ALIGNMENT>
+    void cholesky_substitute(matrix<SCALARTYPE, F, ALIGNMENT> const & L,
+                             vector<SCALARTYPE, VEC_ALIGNMENT> & vec)
+    {
+      assert(L.size1() == L.size2() && bool("Matrix must be square"));
+      inplace_solve(L, vec, lower_tag());
+      inplace_solve(trans(L), vec, upper_tag());
+    }
+
+  }
+}
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef VIENNACL_LINALG_CUDA_NMF_OPERATIONS_HPP_
+#define VIENNACL_LINALG_CUDA_NMF_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/cuda/nmf_operations.hpp
+    @brief Implementations of the element-wise operations used by the nonnegative matrix factorization using CUDA.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/cuda/common.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace cuda
+    {
+
+      template <typename T>
+      __global__ void el_wise_mul_div_kernel(T * matrix1,
+                                             const T * matrix2,
+                                             const T * matrix3,
+                                             unsigned int size)
+      {
+        for (unsigned int i = blockDim.x * blockIdx.x + threadIdx.x;
+                          i < size;
+                          i += gridDim.x * blockDim.x)
+        {
+          T val = matrix1[i] * matrix2[i];
+          T divisor = matrix3[i];
+          matrix1[i] = (divisor > (T)0.00001) ? (val / divisor) : (T)0;
+        }
+      }
+
+      /** @brief Multiplicative update A = A .* B ./ C (MATLAB syntax). Entries with a denominator below 1e-5 are set to zero.
+      *
+      * The kernel runs over the full padded buffers, hence A, B and C must share the same internal layout (no ranges or slices).
+      *
+      * @param A   The matrix to be updated
+      * @param B   The numerator
+      * @param C   The denominator
+      */
+      template <typename NumericT, typename F>
+      void el_wise_mul_div(matrix_base<NumericT, F> & A,
+                           matrix_base<NumericT, F> const & B,
+                           matrix_base<NumericT, F> const & C)
+      {
+        assert(A.internal_size() == B.internal_size() && A.internal_size() == C.internal_size() && bool("Internal layouts of matrices do not match in el_wise_mul_div()"));
+
+        el_wise_mul_div_kernel<<<128, 128>>>(detail::cuda_arg<NumericT>(A),
+                                             detail::cuda_arg<NumericT>(B),
+                                             detail::cuda_arg<NumericT>(C),
+                                             static_cast<unsigned int>(A.internal_size1() * A.internal_size2()));
+        VIENNACL_CUDA_LAST_ERROR_CHECK("el_wise_mul_div_kernel");
+      }
+
+    } //namespace cuda
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -381,6 +381,35 @@ namespace viennacl
         scalar_swap_kernel<<<1, 1>>>(detail::cuda_arg<value_type>(s1),detail::cuda_arg<value_type>(s2));
       }
 
+      ///////////////// safe_div //////////////////
+
+      template <typename T>
+      __global__ void scalar_safe_div_kernel(T * s1, const T * s2, const T * s3)
+      {
+        *s1 = (*s3 != 0) ? *s2 / *s3 : 0;
+      }
+
+      /** @brief Computes s1 = s2 / s3, where s1 is set to zero if s3 is zero
+      *
+      * @param s1   The result scalar
+      * @param s2   The numerator
+      * @param s3   The denominator
+      */
+      template <typename S1, typename S2, typename S3>
+      typename viennacl::enable_if<    viennacl::is_scalar<S1>::value
+                                    && viennacl::is_scalar<S2>::value
+                                    && viennacl::is_scalar<S3>::value
+                                  >::type
+      safe_div(S1 & s1, S2 const & s2, S3 const & s3)
+      {
+        typedef typename viennacl::result_of::cpu_value_type<S1>::type        value_type;
+
+        scalar_safe_div_kernel<<<1, 1>>>(detail::cuda_arg<value_type>(s1),
+                                         detail::cuda_arg<value_type>(s2),
+                                         detail::cuda_arg<value_type>(s3));
+        VIENNACL_CUDA_LAST_ERROR_CHECK("scalar_safe_div_kernel");
+      }
+
 
 
     } //namespace single_threaded
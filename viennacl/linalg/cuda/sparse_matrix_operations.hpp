@@ -27,6 +27,7 @@
 #include "viennacl/vector.hpp"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/cuda/common.hpp"
+#include "viennacl/linalg/cuda/vector_operations.hpp"
 
 #include "viennacl/linalg/cuda/sparse_matrix_operations_solve.hpp"
 
@@ -684,6 +685,219 @@ namespace viennacl
         VIENNACL_CUDA_LAST_ERROR_CHECK("compressed_compressed_matrix_vec_mul_kernel");
       }
 
+
+      //
+      // Symmetric Compressed Matrix
+      //
+
+      namespace detail
+      {
+
+        template <typename T>
+        __global__ void symmetric_compressed_matrix_row_info_extractor_kernel(
+                  const unsigned int * row_jumper,
+                  const unsigned int * column_indices,
+                  const T * elements,
+                  const unsigned int * blocks,
+                  unsigned int block_offset,
+                  unsigned int num_blocks,
+                  unsigned int block_size,
+                  unsigned int size,
+                  T * result,
+                  unsigned int option)
+        {
+          for (unsigned int b  = blockDim.x * blockIdx.x + threadIdx.x;
+                            b  < num_blocks;
+                            b += gridDim.x * blockDim.x)
+          {
+            unsigned int row_begin = blocks[block_offset + b] * block_size;
+            unsigned int row_end   = min(row_begin + block_size, size);
+            for (unsigned int row = row_begin; row < row_end; ++row)
+            {
+              unsigned int row_stop = row_jumper[row+1];
+              for (unsigned int i = row_jumper[row]; i < row_stop; ++i)
+              {
+                unsigned int col = column_indices[i];
+                T value = elements[i];
+                switch (option)
+                {
+                  case 0: //inf-norm
+                    result[row] = max(result[row], fabs(value));
+                    if (col != row) result[col] = max(result[col], fabs(value));
+                    break;
+
+                  case 1: //1-norm
+                    result[row] += fabs(value);
+                    if (col != row) result[col] += fabs(value);
+                    break;
+
+                  case 2: //2-norm, square root is taken afterwards
+                    result[row] += value * value;
+                    if (col != row) result[col] += value * value;
+                    break;
+
+                  case 3: //diagonal entry
+                    if (col == row) result[row] = value;
+                    break;
+
+                  default:
+                    break;
+                }
+              }
+            }
+          }
+        }
+
+        template <typename T>
+        __global__ void symmetric_compressed_matrix_row_info_sqrt_kernel(T * result, unsigned int size)
+        {
+          for (unsigned int row  = blockDim.x * blockIdx.x + threadIdx.x;
+                            row  < size;
+                            row += gridDim.x * blockDim.x)
+            result[row] = sqrt(result[row]);
+        }
+
+
+        template<typename ScalarType>
+        void row_info(symmetric_compressed_matrix<ScalarType> const & mat,
+                      vector_base<ScalarType> & vec,
+                      viennacl::linalg::detail::row_info_types info_selector)
+        {
+          viennacl::linalg::cuda::vector_assign(vec, ScalarType(0));
+
+          std::vector<std::size_t> const & color_offsets = mat.color_offsets();
+          for (std::size_t color = 0; color + 1 < color_offsets.size(); ++color)
+          {
+            symmetric_compressed_matrix_row_info_extractor_kernel<<<128, 128>>>(detail::cuda_arg<unsigned int>(mat.handle1().cuda_handle()),
+                                                                                 detail::cuda_arg<unsigned int>(mat.handle2().cuda_handle()),
+                                                                                 detail::cuda_arg<ScalarType>(mat.handle().cuda_handle()),
+                                                                                 detail::cuda_arg<unsigned int>(mat.handle3().cuda_handle()),
+                                                                                 static_cast<unsigned int>(color_offsets[color]),
+                                                                                 static_cast<unsigned int>(color_offsets[color+1] - color_offsets[color]),
+                                                                                 static_cast<unsigned int>(mat.block_size()),
+                                                                                 static_cast<unsigned int>(mat.size1()),
+                                                                                 detail::cuda_arg<ScalarType>(vec),
+                                                                                 static_cast<unsigned int>(info_selector)
+                                                                                );
+            VIENNACL_CUDA_LAST_ERROR_CHECK("symmetric_compressed_matrix_row_info_extractor_kernel");
+          }
+
+          if (info_selector == viennacl::linalg::detail::SPARSE_ROW_NORM_2)
+          {
+            symmetric_compressed_matrix_row_info_sqrt_kernel<<<128, 128>>>(detail::cuda_arg<ScalarType>(vec), static_cast<unsigned int>(mat.size1()));
+            VIENNACL_CUDA_LAST_ERROR_CHECK("symmetric_compressed_matrix_row_info_sqrt_kernel");
+          }
+        }
+
+      } //namespace detail
+
+
+      /** @brief Processes all row blocks of one color. Each block is processed by threads_per_row consecutive threads of a thread block of size 128, which share the entries of each row. */
+      template <typename T>
+      __global__ void symmetric_compressed_matrix_vec_mul_kernel(
+                const unsigned int * row_jumper,
+                const unsigned int * column_indices,
+                const T * elements,
+                const unsigned int * blocks,
+                unsigned int block_offset,
+                unsigned int num_blocks,
+                unsigned int block_size,
+                unsigned int size,
+                unsigned int threads_per_row,
+                const T * x,
+                unsigned int start_x,
+                unsigned int inc_x,
+                T * result,
+                unsigned int start_result,
+                unsigned int inc_result)
+      {
+        __shared__ T shared_buffer[128];
+
+        unsigned int lane = threadIdx.x % threads_per_row;
+        unsigned int blocks_per_group = blockDim.x / threads_per_row;
+        for (unsigned int b_start  = blockIdx.x * blocks_per_group;
+                          b_start  < num_blocks;
+                          b_start += gridDim.x * blocks_per_group)
+        {
+          unsigned int b = b_start + threadIdx.x / threads_per_row;
+          unsigned int row_begin = (b < num_blocks) ? blocks[block_offset + b] * block_size : size;
+          for (unsigned int r = 0; r < block_size; ++r) // uniform trip count, since the loop contains barriers
+          {
+            unsigned int row = row_begin + r;
+            T dot_prod = T(0);
+            if (row < size)
+            {
+              T x_row = x[row * inc_x + start_x];
+              unsigned int row_stop = row_jumper[row+1];
+              for (unsigned int i = row_jumper[row] + lane; i < row_stop; i += threads_per_row)
+              {
+                unsigned int col = column_indices[i];
+                dot_prod += elements[i] * x[col * inc_x + start_x];
+                if (col != row)
+                  result[col * inc_result + start_result] += elements[i] * x_row;
+              }
+            }
+            shared_buffer[threadIdx.x] = dot_prod;
+            for (unsigned int stride = threads_per_row / 2; stride > 0; stride /= 2)
+            {
+              __syncthreads();
+              if (lane < stride)
+                shared_buffer[threadIdx.x] += shared_buffer[threadIdx.x + stride];
+            }
+            __syncthreads(); // updates of the result from preceding rows of the block are complete
+            if (lane == 0 && row < size)
+              result[row * inc_result + start_result] += shared_buffer[threadIdx.x];
+            __syncthreads();
+          }
+        }
+      }
+
+
+      /** @brief Carries out matrix-vector multiplication with a symmetric_compressed_matrix
+      *
+      * Implementation of the convenience expression result = prod(mat, vec);
+      * One kernel is launched per color of row blocks. Blocks of the same color write to disjoint entries of the result vector.
+      * Each row is processed by a group of threads, which share its entries.
+      *
+      * @param mat    The matrix
+      * @param vec    The vector
+      * @param result The result vector
+      */
+      template<class ScalarType>
+      void prod_impl(const viennacl::symmetric_compressed_matrix<ScalarType> & mat,
+                     const viennacl::vector_base<ScalarType> & vec,
+                           viennacl::vector_base<ScalarType> & result)
+      {
+        viennacl::linalg::cuda::vector_assign(result, ScalarType(0));
+
+        std::size_t threads_per_row  = mat.threads_per_row();
+        std::size_t blocks_per_group = 128 / threads_per_row;
+
+        std::vector<std::size_t> const & color_offsets = mat.color_offsets();
+        for (std::size_t color = 0; color + 1 < color_offsets.size(); ++color)
+        {
+          std::size_t num_blocks = color_offsets[color+1] - color_offsets[color];
+          unsigned int num_groups = static_cast<unsigned int>(std::min<std::size_t>((num_blocks + blocks_per_group - 1) / blocks_per_group, 1024));
+          symmetric_compressed_matrix_vec_mul_kernel<<<num_groups, 128>>>(detail::cuda_arg<unsigned int>(mat.handle1().cuda_handle()),
+                                                                          detail::cuda_arg<unsigned int>(mat.handle2().cuda_handle()),
+                                                                          detail::cuda_arg<ScalarType>(mat.handle().cuda_handle()),
+                                                                          detail::cuda_arg<unsigned int>(mat.handle3().cuda_handle()),
+                                                                          static_cast<unsigned int>(color_offsets[color]),
+                                                                          static_cast<unsigned int>(num_blocks),
+                                                                          static_cast<unsigned int>(mat.block_size()),
+                                                                          static_cast<unsigned int>(mat.size1()),
+                                                                          static_cast<unsigned int>(threads_per_row),
+                                                                          detail::cuda_arg<ScalarType>(vec),
+                                                                          static_cast<unsigned int>(vec.start()),
+                                                                          static_cast<unsigned int>(vec.stride()),
+                                                                          detail::cuda_arg<ScalarType>(result),
+                                                                          static_cast<unsigned int>(result.start()),
+                                                                          static_cast<unsigned int>(result.stride())
+                                                                         );
+          VIENNACL_CUDA_LAST_ERROR_CHECK("symmetric_compressed_matrix_vec_mul_kernel");
+        }
+      }
+
       //
       // Coordinate Matrix
       //
@@ -0,0 +1,256 @@
+#ifndef VIENNACL_LINALG_DETAIL_BLOCK_KRYLOV_HPP_
+#define VIENNACL_LINALG_DETAIL_BLOCK_KRYLOV_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/block_krylov.hpp
+    @brief Helper routines shared by the block Krylov solvers for multiple right hand sides.
+
+    The tall-skinny blocks of Krylov vectors are kept in the memory domain of the system matrix, while the small projected matrices are processed on the host.
+*/
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/matrix_operations.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace detail
+    {
+
+      /** @brief Computes the Gram matrix G = trans(A) * B and copies it to the host */
+      template <typename ScalarType, typename F>
+      void block_krylov_gram(viennacl::matrix<ScalarType, F> const & A,
+                             viennacl::matrix<ScalarType, F> const & B,
+                             std::vector< std::vector<ScalarType> > & G)
+      {
+        viennacl::matrix<ScalarType, F> G_dev(A.size2(), B.size2(), viennacl::traits::context(A));
+        viennacl::linalg::prod_impl(viennacl::trans(A), B, G_dev, ScalarType(1), ScalarType(0));
+
+        G.assign(A.size2(), std::vector<ScalarType>(B.size2()));
+        viennacl::copy(G_dev, G);
+      }
+
+      /** @brief Computes result = alpha * A * S + beta * result, where the small matrix S is supplied on the host */
+      template <typename ScalarType, typename F>
+      void block_krylov_multiply(viennacl::matrix<ScalarType, F> const & A,
+                                 std::vector< std::vector<ScalarType> > const & S,
+                                 viennacl::matrix<ScalarType, F> & result,
+                                 ScalarType alpha, ScalarType beta)
+      {
+        viennacl::matrix<ScalarType, F> S_dev(S.size(), S[0].size(), viennacl::traits::context(A));
+        viennacl::copy(S, S_dev);
+        viennacl::linalg::prod_impl(A, S_dev, result, alpha, beta);
+      }
+
+      /** @brief Returns the squared norms of the columns of a block, i.e. the diagonal of its Gram matrix */
+      template <typename ScalarType, typename F>
+      std::vector<ScalarType> block_krylov_column_norms_squared(viennacl::matrix<ScalarType, F> const & A)
+      {
+        std::vector< std::vector<ScalarType> > G;
+        block_krylov_gram(A, A, G);
+
+        std::vector<ScalarType> result(A.size2());
+        for (std::size_t j=0; j<result.size(); ++j)
+          result[j] = G[j][j];
+        return result;
+      }
+
+      /** @brief Computes the upper triangular Cholesky factor R of a symmetric positive semi-definite Gram matrix G = R^T R and the transformation T = R^{-1}.
+      *
+      *  A block V with Gram matrix G is orthonormalized by V T, such that V = (V T) R.
+      *  Columns which are numerically linearly dependent on the preceding columns are dropped, i.e. the corresponding rows of R and columns of T are zero.
+      *
+      *  @param G   The Gram matrix
+      *  @param R   The upper triangular factor (output)
+      *  @param T   The inverse of R restricted to the retained columns (output)
+      *  @return    The number of retained columns
+      */
+      template <typename ScalarType>
+      std::size_t block_krylov_cholesky(std::vector< std::vector<ScalarType> > const & G,
+                                        std::vector< std::vector<ScalarType> > & R,
+                                        std::vector< std::vector<ScalarType> > & T)
+      {
+        std::size_t k = G.size();
+        ScalarType drop_tolerance = ScalarType(100) * std::numeric_limits<ScalarType>::epsilon();
+
+        R.assign(k, std::vector<ScalarType>(k));
+        T.assign(k, std::vector<ScalarType>(k));
+        std::vector<bool> retained(k);
+        std::size_t num_retained = 0;
+
+        for (std::size_t j=0; j<k; ++j)
+        {
+          // off-diagonal entries of column j:
+          ScalarType d = G[j][j];
+          for (std::size_t i=0; i<j; ++i)
+          {
+            if (!retained[i])
+              continue;
+
+            ScalarType r_ij = G[i][j];
+            for (std::size_t l=0; l<i; ++l)
+              r_ij -= R[l][i] * R[l][j];
+            r_ij /= R[i][i];
+            R[i][j] = r_ij;
+            d -= r_ij * r_ij;
+          }
+
+          retained[j] = (G[j][j] > 0) && (d > drop_tolerance * G[j][j]);
+          if (!retained[j])
+          {
+            for (std::size_t i=0; i<j; ++i)
+              R[i][j] = 0;
+            continue;
+          }
+          R[j][j] = std::sqrt(d);
+          ++num_retained;
+
+          // column j of T = R^{-1}: T(:,j) = (e_j - sum_{i<j} T(:,i) R(i,j)) / R(j,j)
+          T[j][j] = 1;
+          for (std::size_t i=0; i<j; ++i)
+            if (retained[i] && R[i][j] != 0)
+              for (std::size_t l=0; l<=i; ++l)
+                T[l][j] -= T[l][i] * R[i][j];
+          for (std::size_t l=0; l<=j; ++l)
+            T[l][j] /= R[j][j];
+        }
+
+        return num_retained;
+      }
+
+      /** @brief Solves the least-squares problem min ||H Y - E||_F for a small dense matrix H on the host by Householder reflections.
+      *
+      *  Columns of H with negligible diagonal entry in the triangular factor yield zero rows in Y.
+      *
+      *  @param H               The m x n matrix, m >= n (destroyed)
+      *  @param E               The m x s right hand side (destroyed)
+      *  @param Y               The n x s solution (output)
+      *  @param residual_norms  The residual norms ||H Y(:,j) - E(:,j)|| for each column j (output)
+      */
+      template <typename ScalarType>
+      void block_krylov_least_squares(std::vector< std::vector<ScalarType> > & H,
+                                      std::vector< std::vector<ScalarType> > & E,
+                                      std::vector< std::vector<ScalarType> > & Y,
+                                      std::vector<ScalarType> & residual_norms)
+      {
+        std::size_t m = H.size();
+        std::size_t n = H[0].size();
+        std::size_t s = E[0].size();
+
+        std::vector<ScalarType> v(m);
+        std::vector<bool> negligible(n);
+        for (std::size_t j=0; j<n; ++j)
+        {
+          ScalarType norm_j = 0;
+          ScalarType norm_H_j = 0;
+          for (std::size_t i=0; i<m; ++i)
+            norm_H_j += H[i][j] * H[i][j];
+          for (std::size_t i=j; i<m; ++i)
+            norm_j += H[i][j] * H[i][j];
+          norm_j = std::sqrt(norm_j);
+
+          negligible[j] = (norm_j <= ScalarType(100) * std::numeric_limits<ScalarType>::epsilon() * std::sqrt(norm_H_j));
+          if (negligible[j])
+            continue;
+
+          // Householder vector v with (I - 2 v v^T / v^T v) H(j:m, j) = alpha e_1:
+          ScalarType alpha = (H[j][j] > 0) ? -norm_j : norm_j;
+          for (std::size_t i=j; i<m; ++i)
+            v[i] = H[i][j];
+          v[j] -= alpha;
+          ScalarType v_norm_squared = 0;
+          for (std::size_t i=j; i<m; ++i)
+            v_norm_squared += v[i] * v[i];
+
+          for (std::size_t l=j; l<n; ++l)
+          {
+            ScalarType ip = 0;
+            for (std::size_t i=j; i<m; ++i)
+              ip += v[i] * H[i][l];
+            ip = 2 * ip / v_norm_squared;
+            for (std::size_t i=j; i<m; ++i)
+              H[i][l] -= ip * v[i];
+          }
+          for (std::size_t l=0; l<s; ++l)
+          {
+            ScalarType ip = 0;
+            for (std::size_t i=j; i<m; ++i)
+              ip += v[i] * E[i][l];
+            ip = 2 * ip / v_norm_squared;
+            for (std::size_t i=j; i<m; ++i)
+              E[i][l] -= ip * v[i];
+          }
+        }
+
+        // back substitution:
+        Y.assign(n, std::vector<ScalarType>(s));
+        for (std::size_t l=0; l<s; ++l)
+        {
+          for (std::size_t j2=0; j2<n; ++j2)
+          {
+            std::size_t j = n - j2 - 1;
+            if (negligible[j])
+              continue;
+
+            ScalarType y = E[j][l];
+            for (std::size_t i=j+1; i<n; ++i)
+              y -= H[j][i] * Y[i][l];
+            Y[j][l] = y / H[j][j];
+          }
+        }
+
+        // residual: rows n:m of the transformed right hand side, plus the unsatisfied rows of negligible columns
+        residual_norms.assign(s, 0);
+        for (std::size_t l=0; l<s; ++l)
+        {
+          for (std::size_t i=0; i<m; ++i)
+          {
+            if (i < n && !negligible[i])
+              continue;
+
+            ScalarType r = E[i][l];
+            for (std::size_t j=i+1; j<n; ++j)
+              r -= H[i][j] * Y[j][l];
+            residual_norms[l] += r * r;
+          }
+          residual_norms[l] = std::sqrt(residual_norms[l]);
+        }
+      }
+
+      /** @brief Returns the k x k' selection matrix which extracts the given columns from a block with k columns */
+      template <typename ScalarType>
+      std::vector< std::vector<ScalarType> > block_krylov_selection(std::size_t k, std::vector<std::size_t> const & columns)
+      {
+        std::vector< std::vector<ScalarType> > S(k, std::vector<ScalarType>(columns.size()));
+        for (std::size_t j=0; j<columns.size(); ++j)
+          S[columns[j]][j] = 1;
+        return S;
+      }
+
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,405 @@
+#ifndef VIENNACL_LINALG_DETAIL_CHOW_PATEL_HPP_
+#define VIENNACL_LINALG_DETAIL_CHOW_PATEL_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/ilu/chow_patel.hpp
+  @brief Fine-grained parallel incomplete factorizations with static nonzero pattern and Jacobi-iterated triangular substitutions.
+
+  The entries of the incomplete factors are computed by a fixed-point iteration in which each nonzero is updated independently from the values of the previous sweep.
+  Refer to Edmond Chow and Aftab Patel, Fine-Grained Parallel Incomplete LU Factorization, SIAM J. Sci. Comput., 37(2), C169–C193.
+*/
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+#include <map>
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+
+#include "viennacl/linalg/host_based/common.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace detail
+    {
+      /** @brief Column-oriented (CSC) view on a subset of the entries of a CSR matrix. The row indices within each column are sorted.
+      *
+      *  position[k] holds the index of the k-th entry in the element array of the CSR matrix.
+      */
+      struct chow_patel_csc_pattern
+      {
+        std::vector<unsigned int> col_buffer;
+        std::vector<unsigned int> row_indices;
+        std::vector<unsigned int> position;
+      };
+
+      /** @brief Extracts the upper triangular part (including the diagonal) of a CSR matrix in column-oriented form */
+      inline void chow_patel_upper_pattern(unsigned int const * row_buffer, unsigned int const * col_buffer, std::size_t size, chow_patel_csc_pattern & U)
+      {
+        U.col_buffer.assign(size + 1, 0);
+        for (std::size_t i=0; i<size; ++i)
+          for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+            if (col_buffer[k] >= i)
+              ++U.col_buffer[col_buffer[k] + 1];
+
+        for (std::size_t j=0; j<size; ++j)
+          U.col_buffer[j+1] += U.col_buffer[j];
+
+        U.row_indices.resize(U.col_buffer[size]);
+        U.position.resize(U.col_buffer[size]);
+        std::vector<unsigned int> next(U.col_buffer.begin(), U.col_buffer.end() - 1);
+
+        // rows are traversed in increasing order, thus the row indices within each column end up sorted:
+        for (std::size_t i=0; i<size; ++i)
+          for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+          {
+            unsigned int j = col_buffer[k];
+            if (j >= i)
+            {
+              U.row_indices[next[j]] = static_cast<unsigned int>(i);
+              U.position[next[j]]    = k;
+              ++next[j];
+            }
+          }
+      }
+
+      /** @brief Extracts the strict lower triangular part of a CSR matrix, where the column indices within each row are sorted. The same layout as for chow_patel_csc_pattern is used with rows and columns interchanged. */
+      inline void chow_patel_strict_lower_pattern(unsigned int const * row_buffer, unsigned int const * col_buffer, std::size_t size, chow_patel_csc_pattern & L)
+      {
+        L.col_buffer.assign(size + 1, 0);
+        L.row_indices.clear();
+        L.position.clear();
+
+        std::vector<std::pair<unsigned int, unsigned int> > row_entries;
+        for (std::size_t i=0; i<size; ++i)
+        {
+          row_entries.clear();
+          for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+            if (col_buffer[k] < i)
+              row_entries.push_back(std::make_pair(col_buffer[k], k));
+          std::sort(row_entries.begin(), row_entries.end()); //Note: We do not assume that the column indices within a row are sorted
+
+          for (std::size_t k=0; k<row_entries.size(); ++k)
+          {
+            L.row_indices.push_back(row_entries[k].first);
+            L.position.push_back(row_entries[k].second);
+          }
+          L.col_buffer[i+1] = static_cast<unsigned int>(L.row_indices.size());
+        }
+      }
+
+      /** @brief Computes the sparse dot product sum_k x_k y_k over all common indices k < limit of two index-sorted sparse vectors */
+      template <typename ScalarType>
+      ScalarType chow_patel_sparse_dot(unsigned int const * x_indices, ScalarType const * x_values, unsigned int x_begin, unsigned int x_end,
+                                       unsigned int const * y_indices, ScalarType const * y_values, unsigned int y_begin, unsigned int y_end,
+                                       unsigned int limit)
+      {
+        ScalarType result = 0;
+        while (x_begin < x_end && y_begin < y_end)
+        {
+          unsigned int x_index = x_indices[x_begin];
+          unsigned int y_index = y_indices[y_begin];
+          if (x_index >= limit || y_index >= limit)
+            break;
+
+          if (x_index < y_index)
+            ++x_begin;
+          else if (x_index > y_index)
+            ++y_begin;
+          else
+            result += x_values[x_begin++] * y_values[y_begin++];
+        }
+        return result;
+      }
+
+
+      /** @brief Computes an ILU0 factorization of a CSR matrix in main memory by a fixed number of fine-grained parallel sweeps. The result is written to A as for the sequential ILU0.
+      *
+      *  @param A           The sparse matrix. On output, the strict lower part holds the unit lower triangular factor, the upper part holds the upper triangular factor.
+      *  @param num_sweeps  Number of sweeps over all nonzeros
+      */
+      template<typename ScalarType>
+      void chow_patel_ilu0(viennacl::compressed_matrix<ScalarType> & A, std::size_t num_sweeps)
+      {
+        assert( (viennacl::traits::context(A).memory_type() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ILU0") );
+
+        ScalarType         * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(A.handle());
+        unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+        unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+        std::size_t size = A.size1();
+
+        chow_patel_csc_pattern L; // row-oriented: col_buffer <-> row offsets, row_indices <-> column indices
+        chow_patel_csc_pattern U;
+        chow_patel_strict_lower_pattern(row_buffer, col_buffer, size, L);
+        chow_patel_upper_pattern(row_buffer, col_buffer, size, U);
+
+        // the diagonal is the last entry in each column of U:
+        for (std::size_t j=0; j<size; ++j)
+          assert( (U.col_buffer[j] < U.col_buffer[j+1]) && (U.row_indices[U.col_buffer[j+1] - 1] == j) && bool("Diagonal entry missing in ILU0") );
+
+        // initial guess: L = strict lower part of A scaled by the diagonal, U = upper part of A
+        std::vector<ScalarType> L_values(L.position.size());
+        std::vector<ScalarType> U_values(U.position.size());
+        for (std::size_t k=0; k<U.position.size(); ++k)
+          U_values[k] = elements[U.position[k]];
+        for (std::size_t i=0; i<size; ++i)
+          for (unsigned int k = L.col_buffer[i]; k < L.col_buffer[i+1]; ++k)
+            L_values[k] = elements[L.position[k]] / U_values[U.col_buffer[L.row_indices[k] + 1] - 1];
+
+        std::vector<ScalarType> L_values_new(L_values.size());
+        std::vector<ScalarType> U_values_new(U_values.size());
+
+        unsigned int const * L_row_buffer = L.col_buffer.size()  ? &(L.col_buffer[0])  : NULL;
+        unsigned int const * L_col_buffer = L.row_indices.size() ? &(L.row_indices[0]) : NULL;
+        unsigned int const * U_col_buffer = U.col_buffer.size()  ? &(U.col_buffer[0])  : NULL;
+        unsigned int const * U_row_buffer = U.row_indices.size() ? &(U.row_indices[0]) : NULL;
+
+        for (std::size_t sweep = 0; sweep < num_sweeps; ++sweep)
+        {
+          ScalarType const * L_old = L_values.size() ? &(L_values[0]) : NULL;
+          ScalarType const * U_old = U_values.size() ? &(U_values[0]) : NULL;
+          ScalarType       * L_new = L_values_new.size() ? &(L_values_new[0]) : NULL;
+          ScalarType       * U_new = U_values_new.size() ? &(U_values_new[0]) : NULL;
+
+          // l_ij = (a_ij - sum_{k<j} l_ik u_kj) / u_jj
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long i2=0; i2<static_cast<long>(size); ++i2)
+          {
+            std::size_t i = static_cast<std::size_t>(i2);
+            for (unsigned int k = L_row_buffer[i]; k < L_row_buffer[i+1]; ++k)
+            {
+              unsigned int j = L_col_buffer[k];
+              ScalarType s = chow_patel_sparse_dot(L_col_buffer, L_old, L_row_buffer[i], L_row_buffer[i+1],
+                                                   U_row_buffer, U_old, U_col_buffer[j], U_col_buffer[j+1], j);
+              L_new[k] = (elements[L.position[k]] - s) / U_old[U_col_buffer[j+1] - 1];
+            }
+          }
+
+          // u_ij = a_ij - sum_{k<i} l_ik u_kj
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long j2=0; j2<static_cast<long>(size); ++j2)
+          {
+            std::size_t j = static_cast<std::size_t>(j2);
+            for (unsigned int k = U_col_buffer[j]; k < U_col_buffer[j+1]; ++k)
+            {
+              unsigned int i = U_row_buffer[k];
+              ScalarType s = chow_patel_sparse_dot(L_col_buffer, L_old, L_row_buffer[i], L_row_buffer[i+1],
+                                                   U_row_buffer, U_old, U_col_buffer[j], U_col_buffer[j+1], i);
+              U_new[k] = elements[U.position[k]] - s;
+            }
+          }
+
+          L_values.swap(L_values_new);
+          U_values.swap(U_values_new);
+        }
+
+        for (std::size_t k=0; k<L.position.size(); ++k)
+          elements[L.position[k]] = L_values[k];
+        for (std::size_t k=0; k<U.position.size(); ++k)
+          elements[U.position[k]] = U_values[k];
+      }
+
+
+      /** @brief Computes an incomplete Cholesky factorization A = L L^T of a CSR matrix in main memory by a fixed number of fine-grained parallel sweeps. The result is written to A as for the sequential ICHOL0.
+      *
+      *  @param A           The symmetric sparse matrix. On output, the upper part holds the transposed factor L^T.
+      *  @param num_sweeps  Number of sweeps over all nonzeros
+      */
+      template<typename ScalarType>
+      void chow_patel_ichol0(viennacl::compressed_matrix<ScalarType> & A, std::size_t num_sweeps)
+      {
+        assert( (viennacl::traits::context(A).memory_type() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ICHOL0") );
+
+        ScalarType         * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(A.handle());
+        unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+        unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+        std::size_t size = A.size1();
+
+        // Columns of L^T are rows of L, thus all dot products are taken between two columns of the upper part:
+        chow_patel_csc_pattern U;
+        chow_patel_upper_pattern(row_buffer, col_buffer, size, U);
+
+        for (std::size_t j=0; j<size; ++j)
+          assert( (U.col_buffer[j] < U.col_buffer[j+1]) && (U.row_indices[U.col_buffer[j+1] - 1] == j) && bool("Diagonal entry missing in ICHOL0") );
+
+        // initial guess: u_ij = a_ij / sqrt(a_ii)
+        std::vector<ScalarType> U_values(U.position.size());
+        for (std::size_t j=0; j<size; ++j)
+          for (unsigned int k = U.col_buffer[j]; k < U.col_buffer[j+1]; ++k)
+          {
+            unsigned int i = U.row_indices[k];
+            U_values[k] = elements[U.position[k]] / std::sqrt(elements[U.position[U.col_buffer[i+1] - 1]]);
+          }
+
+        std::vector<ScalarType> U_values_new(U_values.size());
+
+        unsigned int const * U_col_buffer = U.col_buffer.size()  ? &(U.col_buffer[0])  : NULL;
+        unsigned int const * U_row_buffer = U.row_indices.size() ? &(U.row_indices[0]) : NULL;
+
+        for (std::size_t sweep = 0; sweep < num_sweeps; ++sweep)
+        {
+          ScalarType const * U_old = U_values.size()     ? &(U_values[0])     : NULL;
+          ScalarType       * U_new = U_values_new.size() ? &(U_values_new[0]) : NULL;
+
+          // u_ii = sqrt(a_ii - sum_{k<i} u_ki^2),  u_ij = (a_ij - sum_{k<i} u_ki u_kj) / u_ii
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long j2=0; j2<static_cast<long>(size); ++j2)
+          {
+            std::size_t j = static_cast<std::size_t>(j2);
+            for (unsigned int k = U_col_buffer[j]; k < U_col_buffer[j+1]; ++k)
+            {
+              unsigned int i = U_row_buffer[k];
+              ScalarType s = elements[U.position[k]]
+                             - chow_patel_sparse_dot(U_row_buffer, U_old, U_col_buffer[i], U_col_buffer[i+1],
+                                                     U_row_buffer, U_old, U_col_buffer[j], U_col_buffer[j+1], i);
+              if (i == j)
+                U_new[k] = std::sqrt(s);
+              else
+                U_new[k] = s / U_old[U_col_buffer[i+1] - 1];
+            }
+          }
+
+          U_values.swap(U_values_new);
+        }
+
+        for (std::size_t k=0; k<U.position.size(); ++k)
+          elements[U.position[k]] = U_values[k];
+      }
+
+
+      /** @brief Splits a CSR matrix in main memory into its strict lower part, its strict upper part and its diagonal for use with jacobi_substitute().
+      *
+      *  @param A                 The matrix holding the triangular factors
+      *  @param L                 The strict lower part (output, main memory)
+      *  @param U                 The strict upper part (output, main memory)
+      *  @param diagonal          The diagonal (output, main memory)
+      *  @param lower_from_upper  If true, L is the transpose of the strict upper part of A. This is the storage scheme used by ICHOL0.
+      */
+      template<typename ScalarType>
+      void jacobi_substitute_setup(viennacl::compressed_matrix<ScalarType> const & A,
+                                   viennacl::compressed_matrix<ScalarType> & L,
+                                   viennacl::compressed_matrix<ScalarType> & U,
+                                   viennacl::vector<ScalarType> & diagonal,
+                                   bool lower_from_upper)
+      {
+        ScalarType   const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(A.handle());
+        unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+        unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+        std::size_t size = A.size1();
+        std::vector<std::map<unsigned int, ScalarType> > L_host(size);
+        std::vector<std::map<unsigned int, ScalarType> > U_host(size);
+        std::vector<ScalarType> diag_host(size);
+
+        for (std::size_t i=0; i<size; ++i)
+          for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+          {
+            unsigned int j = col_buffer[k];
+            if (j == i)
+              diag_host[i] = elements[k];
+            else if (j > i)
+            {
+              U_host[i][j] = elements[k];
+              if (lower_from_upper)
+                L_host[j][static_cast<unsigned int>(i)] = elements[k];
+            }
+            else if (!lower_from_upper)
+              L_host[i][j] = elements[k];
+          }
+
+        viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+        viennacl::switch_memory_context(L, host_ctx);
+        viennacl::switch_memory_context(U, host_ctx);
+        viennacl::switch_memory_context(diagonal, host_ctx);
+
+        viennacl::copy(viennacl::tools::const_sparse_matrix_adapter<ScalarType, unsigned int>(L_host, size, size), L);
+        viennacl::copy(viennacl::tools::const_sparse_matrix_adapter<ScalarType, unsigned int>(U_host, size, size), U);
+        diagonal.resize(size, false);
+        viennacl::copy(diag_host, diagonal);
+      }
+
+      /** @brief Approximately solves the unit triangular system (I + R) x = b by Jacobi iteration, where R is strictly triangular.
+      *
+      *  @param R          The strict lower or strict upper triangular part of the system matrix
+      *  @param vec        On input the right hand side b, on output the approximate solution x
+      *  @param num_iters  Number of Jacobi iterations. The result is exact for a number of iterations equal to the number of levels of the triangular system.
+      */
+      template<typename ScalarType>
+      void jacobi_substitute(viennacl::compressed_matrix<ScalarType> const & R,
+                             viennacl::vector<ScalarType> & vec,
+                             std::size_t num_iters)
+      {
+        viennacl::vector<ScalarType> rhs(vec.size(), viennacl::traits::context(vec));
+        viennacl::vector<ScalarType> temp(vec.size(), viennacl::traits::context(vec));
+        rhs = vec;
+
+        // x_{k+1} = b - R x_k, starting with x_0 = b
+        for (std::size_t k=0; k<num_iters; ++k)
+        {
+          temp = viennacl::linalg::prod(R, vec);
+          vec = rhs - temp;
+        }
+      }
+
+      /** @brief Approximately solves the triangular system (D + R) x = b by Jacobi iteration, where D is diagonal and R is strictly triangular.
+      *
+      *  @param R          The strict lower or strict upper triangular part of the system matrix
+      *  @param diagonal   The diagonal D of the system matrix
+      *  @param vec        On input the right hand side b, on output the approximate solution x
+      *  @param num_iters  Number of Jacobi iterations. The result is exact for a number of iterations equal to the number of levels of the triangular system.
+      */
+      template<typename ScalarType>
+      void jacobi_substitute(viennacl::compressed_matrix<ScalarType> const & R,
+                             viennacl::vector<ScalarType> const & diagonal,
+                             viennacl::vector<ScalarType> & vec,
+                             std::size_t num_iters)
+      {
+        viennacl::vector<ScalarType> rhs(vec.size(), viennacl::traits::context(vec));
+        viennacl::vector<ScalarType> temp(vec.size(), viennacl::traits::context(vec));
+        rhs = vec;
+
+        // x_{k+1} = D^{-1} (b - R x_k), starting with x_0 = D^{-1} b
+        vec = viennacl::linalg::element_div(rhs, diagonal);
+        for (std::size_t k=0; k<num_iters; ++k)
+        {
+          temp = viennacl::linalg::prod(R, vec);
+          temp = rhs - temp;
+          vec = viennacl::linalg::element_div(temp, diagonal);
+        }
+      }
+
+    }
+  }
+}
+
+#endif
@@ -42,6 +42,7 @@
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/detail/ilu/common.hpp"
+#include "viennacl/linalg/detail/ilu/chow_patel.hpp"
 #include "viennacl/compressed_matrix.hpp"
 #include "viennacl/backend/memory.hpp"
 
@@ -59,13 +60,29 @@ namespace viennacl
     class ilu0_tag
     {
       public:
-        ilu0_tag(bool with_level_scheduling = false) : use_level_scheduling_(with_level_scheduling) {}
+        /** @brief The constructor.
+        *
+        * @param with_level_scheduling  Flag for enabling level scheduling on GPUs.
+        * @param num_sweeps             If nonzero, the factors are computed by the given number of fine-grained parallel sweeps (Chow-Patel) instead of the sequential algorithm.
+        * @param num_jacobi_iters       If nonzero, the triangular substitutions are replaced by the given number of Jacobi iterations. Takes precedence over level scheduling.
+        */
+        ilu0_tag(bool with_level_scheduling = false,
+                 std::size_t num_sweeps = 0,
+                 std::size_t num_jacobi_iters = 0) : use_level_scheduling_(with_level_scheduling), sweeps_(num_sweeps), jacobi_iters_(num_jacobi_iters) {}
 
         bool use_level_scheduling() const { return use_level_scheduling_; }
         void use_level_scheduling(bool b) { use_level_scheduling_ = b; }
 
+        std::size_t sweeps() const { return sweeps_; }
+        void sweeps(std::size_t num) { sweeps_ = num; }
+
+        std::size_t jacobi_iters() const { return jacobi_iters_; }
+        void jacobi_iters(std::size_t num) { jacobi_iters_ = num; }
+
       private:
         bool use_level_scheduling_;
+        std::size_t sweeps_;
+        std::size_t jacobi_iters_;
     };
 
 
@@ -73,11 +90,20 @@ namespace viennacl
       *
       * refer to the Algorithm in Saad's book (1996 edition)
       *
+      *  If a number of sweeps is set in the tag, the factors are computed by the fine-grained parallel algorithm instead.
+      *
       *  @param A       The sparse matrix matrix. The result is directly written to A.
+      *  @param tag     An ilu0_tag in order to dispatch among several other preconditioners.
       */
     template<typename ScalarType>
-    void precondition(viennacl::compressed_matrix<ScalarType> & A, ilu0_tag const & /* tag */)
+    void precondition(viennacl::compressed_matrix<ScalarType> & A, ilu0_tag const & tag)
     {
+      if (tag.sweeps() > 0)
+      {
+        detail::chow_patel_ilu0(A, tag.sweeps());
+        return;
+      }
+
       assert( (A.handle1().get_active_handle_id() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ILU0") );
       assert( (A.handle2().get_active_handle_id() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ILU0") );
       assert( (A.handle().get_active_handle_id() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ILU0") );
@@ -127,7 +153,7 @@ namespace viennacl
             {
               if (col_buffer[buf_index_akj] == j)
               {
-                a_kk = elements[buf_index_akj];
+                a_kj = elements[buf_index_akj];
                 break;
               }
             }
@@ -178,7 +204,7 @@ namespace viennacl
           viennacl::linalg::precondition(LU, tag_);
         }
 
-        ilu0_tag const & tag_;
+        ilu0_tag tag_;
 
         viennacl::compressed_matrix<ScalarType> LU;
     };
@@ -205,7 +231,12 @@ namespace viennacl
         void apply(vector<ScalarType> & vec) const
         {
           viennacl::context host_context(viennacl::MAIN_MEMORY);
-          if (vec.handle().get_active_handle_id() != viennacl::MAIN_MEMORY)
+          if (tag_.jacobi_iters() > 0)
+          {
+            detail::jacobi_substitute(jacobi_L_, vec, tag_.jacobi_iters());
+            detail::jacobi_substitute(jacobi_U_, jacobi_U_diagonal_, vec, tag_.jacobi_iters());
+          }
+          else if (vec.handle().get_active_handle_id() != viennacl::MAIN_MEMORY)
           {
             if (tag_.use_level_scheduling())
             {
@@ -274,6 +305,15 @@ namespace viennacl
           LU = mat;
           viennacl::linalg::precondition(LU, tag_);
 
+          if (tag_.jacobi_iters() > 0)
+          {
+            detail::jacobi_substitute_setup(LU, jacobi_L_, jacobi_U_, jacobi_U_diagonal_, false);
+            viennacl::switch_memory_context(jacobi_L_, viennacl::traits::context(mat));
+            viennacl::switch_memory_context(jacobi_U_, viennacl::traits::context(mat));
+            viennacl::switch_memory_context(jacobi_U_diagonal_, viennacl::traits::context(mat));
+            return;
+          }
+
           if (!tag_.use_level_scheduling())
             return;
 
@@ -351,9 +391,13 @@ namespace viennacl
 
         }
 
-        ilu0_tag const & tag_;
+        ilu0_tag tag_;
         viennacl::compressed_matrix<ScalarType> LU;
 
+        viennacl::compressed_matrix<ScalarType> jacobi_L_;
+        viennacl::compressed_matrix<ScalarType> jacobi_U_;
+        viennacl::vector<ScalarType> jacobi_U_diagonal_;
+
         std::list< viennacl::backend::mem_handle > multifrontal_L_row_index_arrays_;
         std::list< viennacl::backend::mem_handle > multifrontal_L_row_buffers_;
         std::list< viennacl::backend::mem_handle > multifrontal_L_col_buffers_;
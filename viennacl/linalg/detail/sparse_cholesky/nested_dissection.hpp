@@ -0,0 +1,262 @@
+#ifndef VIENNACL_LINALG_DETAIL_SPARSE_CHOLESKY_NESTED_DISSECTION_HPP_
+#define VIENNACL_LINALG_DETAIL_SPARSE_CHOLESKY_NESTED_DISSECTION_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/sparse_cholesky/nested_dissection.hpp
+    @brief Fill-reducing nested dissection ordering based on level structures, cf. A. George and J. W. H. Liu, Computer Solution of Large Sparse Positive Definite Systems, Prentice-Hall, 1981.
+*/
+
+#include <vector>
+#include <algorithm>
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace detail
+    {
+
+      /** @brief Helper class for the nested dissection ordering of the graph of a sparse symmetric matrix in CSR format.
+      *
+      *  The graph is recursively split by vertex separators taken from the middle level of a breadth-first search started at a pseudo-peripheral vertex.
+      *  Each subgraph occupies a contiguous range of the ordering, where the separator is numbered last. Small subgraphs are ordered by reverse Cuthill-McKee.
+      */
+      class nested_dissection
+      {
+        public:
+          /** @brief Sets up the ordering.
+          *
+          * @param row_jumper    Row array of the matrix in CSR format
+          * @param col_indices   Column array of the matrix in CSR format. The sparsity pattern must be symmetric. Diagonal entries are ignored.
+          * @param leaf_size     Subgraphs with at most this number of vertices are not split further
+          */
+          nested_dissection(std::vector<unsigned int> const & row_jumper,
+                            std::vector<unsigned int> const & col_indices,
+                            std::size_t leaf_size)
+            : row_jumper_(row_jumper), col_indices_(col_indices), leaf_size_(std::max<std::size_t>(leaf_size, 1)),
+              n_(row_jumper.size() - 1), owner_(n_, 0), level_(n_), next_owner_(1) {}
+
+          /** @brief Computes the ordering. perm[i] is the index of the vertex numbered i. */
+          void apply(std::vector<unsigned int> & perm)
+          {
+            perm.resize(n_);
+            for (std::size_t i=0; i<n_; ++i)
+              perm[i] = static_cast<unsigned int>(i);
+
+            // subgraphs to be processed: ranges [begin, end) in 'perm' holding the vertices of one subgraph
+            std::vector<std::size_t> stack_begin(1, 0);
+            std::vector<std::size_t> stack_end(1, n_);
+            std::vector<unsigned int> stack_owner(1, 0);
+
+            while (stack_begin.size() > 0)
+            {
+              std::size_t begin = stack_begin.back(); stack_begin.pop_back();
+              std::size_t end   = stack_end.back();   stack_end.pop_back();
+              unsigned int id   = stack_owner.back(); stack_owner.pop_back();
+
+              if (end - begin <= leaf_size_)
+              {
+                order_leaf(perm, begin, end, id);
+                continue;
+              }
+
+              // disconnected subgraph: split off the component of the first vertex
+              unsigned int root = perm[begin];
+              std::size_t num_levels = breadth_first_search(root, id);
+              if (bfs_order_.size() < end - begin)
+              {
+                std::size_t component_size = bfs_order_.size();
+                unsigned int component_id = next_owner_++;
+                for (std::size_t i=0; i<component_size; ++i)
+                  owner_[bfs_order_[i]] = component_id;
+                std::stable_partition(perm.begin() + static_cast<long>(begin), perm.begin() + static_cast<long>(end), owner_is(owner_, component_id));
+
+                push(stack_begin, stack_end, stack_owner, begin, begin + component_size, component_id);
+                push(stack_begin, stack_end, stack_owner, begin + component_size, end, id);
+                continue;
+              }
+
+              // pseudo-peripheral root: restart from a vertex of minimum degree in the last level as long as the number of levels increases
+              for (std::size_t iter = 0; iter < 5; ++iter)
+              {
+                unsigned int candidate = bfs_order_.back();
+                for (std::size_t i = bfs_order_.size(); i > 0 && level_[bfs_order_[i-1]] + 1 == num_levels; --i)
+                  if (degree(bfs_order_[i-1]) < degree(candidate))
+                    candidate = bfs_order_[i-1];
+
+                std::size_t candidate_num_levels = breadth_first_search(candidate, id);
+                if (candidate_num_levels <= num_levels)
+                {
+                  breadth_first_search(root, id);
+                  break;
+                }
+                root = candidate;
+                num_levels = candidate_num_levels;
+              }
+
+              if (num_levels < 3) //no separator available, e.g. for a (nearly) complete graph
+              {
+                order_leaf(perm, begin, end, id);
+                continue;
+              }
+
+              // middle level: first level such that the levels up to it contain at least half of the vertices
+              std::vector<std::size_t> level_sizes(num_levels);
+              for (std::size_t i=0; i<bfs_order_.size(); ++i)
+                ++level_sizes[level_[bfs_order_[i]]];
+              std::size_t middle = 0;
+              std::size_t count = 0;
+              while (middle < num_levels && 2 * (count + level_sizes[middle]) < bfs_order_.size())
+                count += level_sizes[middle++];
+              middle = std::min(std::max<std::size_t>(middle, 1), num_levels - 2);
+
+              // separator: vertices of the middle level adjacent to the next level
+              unsigned int first_id  = next_owner_++;
+              unsigned int second_id = next_owner_++;
+              unsigned int separator_id = next_owner_++;
+              for (std::size_t i=0; i<bfs_order_.size(); ++i)
+              {
+                unsigned int v = bfs_order_[i];
+                if (level_[v] < middle)
+                  owner_[v] = first_id;
+                else if (level_[v] > middle)
+                  owner_[v] = second_id;
+              }
+              for (std::size_t i=0; i<bfs_order_.size(); ++i)
+              {
+                unsigned int v = bfs_order_[i];
+                if (level_[v] != middle)
+                  continue;
+
+                bool is_separator = false;
+                for (unsigned int k = row_jumper_[v]; k < row_jumper_[v+1]; ++k)
+                  if (owner_[col_indices_[k]] == second_id)
+                    is_separator = true;
+                owner_[v] = is_separator ? separator_id : first_id;
+              }
+
+              // arrange vertices as [first part, second part, separator], each in breadth-first order:
+              std::size_t pos = begin;
+              unsigned int ids[3] = {first_id, second_id, separator_id};
+              std::size_t part_begin[3];
+              for (std::size_t p=0; p<3; ++p)
+              {
+                part_begin[p] = pos;
+                for (std::size_t i=0; i<bfs_order_.size(); ++i)
+                  if (owner_[bfs_order_[i]] == ids[p])
+                    perm[pos++] = bfs_order_[i];
+              }
+              for (std::size_t i = part_begin[2]; i < end; ++i)
+                owner_[perm[i]] = separator_id; //separator vertices are removed from all further subgraphs
+
+              push(stack_begin, stack_end, stack_owner, part_begin[1], part_begin[2], second_id);
+              push(stack_begin, stack_end, stack_owner, part_begin[0], part_begin[1], first_id);
+            }
+          }
+
+        private:
+          struct owner_is
+          {
+            owner_is(std::vector<unsigned int> const & owner, unsigned int id) : owner_(owner), id_(id) {}
+            bool operator()(unsigned int v) const { return owner_[v] == id_; }
+
+            std::vector<unsigned int> const & owner_;
+            unsigned int id_;
+          };
+
+          static void push(std::vector<std::size_t> & stack_begin, std::vector<std::size_t> & stack_end, std::vector<unsigned int> & stack_owner,
+                           std::size_t begin, std::size_t end, unsigned int id)
+          {
+            if (begin == end)
+              return;
+            stack_begin.push_back(begin);
+            stack_end.push_back(end);
+            stack_owner.push_back(id);
+          }
+
+          std::size_t degree(unsigned int v) const { return row_jumper_[v+1] - row_jumper_[v]; }
+
+          /** @brief Breadth-first search within the subgraph of vertices with the supplied owner. Fills bfs_order_ and level_, returns the number of levels. */
+          std::size_t breadth_first_search(unsigned int root, unsigned int id)
+          {
+            unsigned int visited_id = next_owner_++; //temporarily marks visited vertices
+
+            bfs_order_.clear();
+            bfs_order_.push_back(root);
+            owner_[root] = visited_id;
+            level_[root] = 0;
+            std::size_t num_levels = 1;
+            for (std::size_t i=0; i<bfs_order_.size(); ++i)
+            {
+              unsigned int v = bfs_order_[i];
+              for (unsigned int k = row_jumper_[v]; k < row_jumper_[v+1]; ++k)
+              {
+                unsigned int w = col_indices_[k];
+                if (owner_[w] == id)
+                {
+                  owner_[w] = visited_id;
+                  level_[w] = level_[v] + 1;
+                  num_levels = std::max<std::size_t>(num_levels, level_[w] + 1);
+                  bfs_order_.push_back(w);
+                }
+              }
+            }
+
+            for (std::size_t i=0; i<bfs_order_.size(); ++i)
+              owner_[bfs_order_[i]] = id;
+            return num_levels;
+          }
+
+          /** @brief Orders a small subgraph by reverse Cuthill-McKee, one connected component after another */
+          void order_leaf(std::vector<unsigned int> & perm, std::size_t begin, std::size_t end, unsigned int id)
+          {
+            unsigned int done_id = next_owner_++;
+            std::vector<unsigned int> order;
+            order.reserve(end - begin);
+            for (std::size_t i = begin; i < end; ++i)
+            {
+              if (owner_[perm[i]] != id)
+                continue;
+              breadth_first_search(perm[i], id);
+              for (std::size_t j=0; j<bfs_order_.size(); ++j)
+              {
+                owner_[bfs_order_[j]] = done_id;
+                order.push_back(bfs_order_[j]);
+              }
+            }
+            std::reverse(order.begin(), order.end());
+            std::copy(order.begin(), order.end(), perm.begin() + static_cast<long>(begin));
+          }
+
+          std::vector<unsigned int> const & row_jumper_;
+          std::vector<unsigned int> const & col_indices_;
+          std::size_t leaf_size_;
+          std::size_t n_;
+
+          std::vector<unsigned int> owner_;   //id of the subgraph each vertex belongs to
+          std::vector<unsigned int> level_;   //level in the last breadth-first search
+          std::vector<unsigned int> bfs_order_;
+          unsigned int next_owner_;
+      };
+
+    }
+  }
+}
+
+#endif
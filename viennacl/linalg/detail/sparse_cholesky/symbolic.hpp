@@ -0,0 +1,485 @@
+#ifndef VIENNACL_LINALG_DETAIL_SPARSE_CHOLESKY_SYMBOLIC_HPP_
+#define VIENNACL_LINALG_DETAIL_SPARSE_CHOLESKY_SYMBOLIC_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/sparse_cholesky/symbolic.hpp
+    @brief Symbolic analysis for the supernodal sparse Cholesky factorization: Elimination tree, column counts, supernodes and the structure of the factor.
+
+    The algorithms follow T. A. Davis, Direct Methods for Sparse Linear Systems, SIAM, 2006.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace detail
+    {
+
+      /** @brief Holds the symbolic factorization of a sparse symmetric matrix.
+      *
+      *  The columns of the permuted matrix P A P^T are grouped into supernodes [super_begin[s], super_begin[s+1]).
+      *  Supernode s is stored as a dense column-major panel with rows row_indices[row_offsets[s]], ..., row_indices[row_offsets[s+1]-1],
+      *  where the first rows are the columns of the supernode itself. The panel starts at value_offsets[s] in the array of values.
+      */
+      struct sparse_cholesky_symbolic
+      {
+        sparse_cholesky_symbolic() : size(0), nnz_A(0), max_update_size(0) {}
+
+        std::size_t num_supernodes() const { return super_begin.size() - 1; }
+
+        std::size_t size;                          //number of rows
+        std::size_t nnz_A;                         //number of nonzeros of the system matrix the analysis was carried out for
+
+        std::vector<unsigned int> perm;            //perm[i] is the row of A which becomes row i of P A P^T
+        std::vector<unsigned int> inverse_perm;
+
+        std::vector<std::size_t>  super_begin;     //first column of each supernode
+        std::vector<std::size_t>  row_offsets;     //start of the row indices of each supernode
+        std::vector<unsigned int> row_indices;
+        std::vector<std::size_t>  value_offsets;   //start of the dense panel of each supernode
+
+        // supernode s is updated by the supernodes update_sources[update_offsets[s]], ..., where the rows of the source panel starting at update_rows[...] fall into s
+        std::vector<std::size_t>  update_offsets;
+        std::vector<unsigned int> update_sources;
+        std::vector<std::size_t>  update_rows;
+
+        // supernodes grouped by their level in the supernodal elimination tree. Supernodes of the same level are independent.
+        std::vector<std::size_t>  level_offsets;
+        std::vector<unsigned int> level_supernodes;
+
+        // values of A are scattered via values[a_map_dst[k]] = elements[a_map_src[k]] for k in [a_map_offsets[s], a_map_offsets[s+1])
+        std::vector<std::size_t>  a_map_offsets;
+        std::vector<std::size_t>  a_map_src;
+        std::vector<std::size_t>  a_map_dst;
+
+        std::size_t max_update_size;               //size of the largest dense update block
+      };
+
+
+      /** @brief Computes the elimination tree of P A P^T. The entries of row k with column index smaller than k are visited via the supplied permutation. */
+      inline void sparse_cholesky_etree(std::vector<unsigned int> const & row_jumper,
+                                        std::vector<unsigned int> const & col_indices,
+                                        std::vector<unsigned int> const & perm,
+                                        std::vector<unsigned int> const & inverse_perm,
+                                        std::vector<std::size_t> & parent)
+      {
+        std::size_t n = perm.size();
+        std::size_t none = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> ancestor(n, none);
+        parent.assign(n, none);
+
+        for (std::size_t k=0; k<n; ++k)
+        {
+          unsigned int row = perm[k];
+          for (unsigned int j = row_jumper[row]; j < row_jumper[row+1]; ++j)
+          {
+            std::size_t i = inverse_perm[col_indices[j]];
+            while (i < k) //traverse from i to the root with path compression
+            {
+              std::size_t next = ancestor[i];
+              ancestor[i] = k;
+              if (next == none)
+              {
+                parent[i] = k;
+                break;
+              }
+              i = next;
+            }
+          }
+        }
+      }
+
+      /** @brief Computes a postordering of a forest given by the parent array. post[i] is the node numbered i. */
+      inline void sparse_cholesky_postorder(std::vector<std::size_t> const & parent, std::vector<std::size_t> & post)
+      {
+        std::size_t n = parent.size();
+        std::size_t none = std::numeric_limits<std::size_t>::max();
+
+        // children lists, such that children are visited in increasing order:
+        std::vector<std::size_t> head(n, none);
+        std::vector<std::size_t> next(n, none);
+        for (std::size_t j = n; j > 0; --j)
+        {
+          if (parent[j-1] == none)
+            continue;
+          next[j-1] = head[parent[j-1]];
+          head[parent[j-1]] = j-1;
+        }
+
+        post.resize(n);
+        std::vector<std::size_t> stack;
+        std::size_t k = 0;
+        for (std::size_t root = 0; root < n; ++root)
+        {
+          if (parent[root] != none)
+            continue;
+
+          stack.push_back(root);
+          while (stack.size() > 0)
+          {
+            std::size_t p = stack.back();
+            std::size_t child = head[p];
+            if (child == none)
+            {
+              stack.pop_back();
+              post[k++] = p;
+            }
+            else
+            {
+              head[p] = next[child];
+              stack.push_back(child);
+            }
+          }
+        }
+      }
+
+      /** @brief Computes the number of nonzeros in each column of the Cholesky factor (including the diagonal) by traversing the row subtrees of the elimination tree */
+      inline void sparse_cholesky_column_counts(std::vector<unsigned int> const & row_jumper,
+                                                std::vector<unsigned int> const & col_indices,
+                                                std::vector<unsigned int> const & perm,
+                                                std::vector<unsigned int> const & inverse_perm,
+                                                std::vector<std::size_t> const & parent,
+                                                std::vector<std::size_t> & col_counts)
+      {
+        std::size_t n = perm.size();
+        std::size_t none = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> mark(n, none);
+        col_counts.assign(n, 1);
+
+        for (std::size_t k=0; k<n; ++k)
+        {
+          mark[k] = k;
+          unsigned int row = perm[k];
+          for (unsigned int j = row_jumper[row]; j < row_jumper[row+1]; ++j)
+          {
+            std::size_t i = inverse_perm[col_indices[j]];
+            if (i > k)
+              continue;
+            for (; mark[i] != k; i = parent[i]) //L(k, i) is nonzero for all i on the path up to k
+            {
+              ++col_counts[i];
+              mark[i] = k;
+            }
+          }
+        }
+      }
+
+
+      /** @brief Carries out the symbolic factorization of a sparse symmetric matrix in CSR format for a given fill-reducing permutation.
+      *
+      * @param row_jumper            Row array of A
+      * @param col_indices           Column array of A. The pattern must be symmetric.
+      * @param perm                  The fill-reducing permutation. Is replaced by its composition with a postordering of the elimination tree.
+      * @param relaxed_supernodes    If true, small supernodes are merged with their parents at the expense of a few explicitly stored zeros
+      * @param symbolic              The result
+      */
+      inline void sparse_cholesky_analyze(std::vector<unsigned int> const & row_jumper,
+                                          std::vector<unsigned int> const & col_indices,
+                                          std::vector<unsigned int> const & perm,
+                                          bool relaxed_supernodes,
+                                          sparse_cholesky_symbolic & symbolic)
+      {
+        std::size_t n = perm.size();
+        std::size_t none = std::numeric_limits<std::size_t>::max();
+        symbolic.size = n;
+        symbolic.nnz_A = col_indices.size();
+
+        std::vector<unsigned int> inverse_perm(n);
+        for (std::size_t i=0; i<n; ++i)
+          inverse_perm[perm[i]] = static_cast<unsigned int>(i);
+
+        // elimination tree and postordering. The postordering yields the same fill, but makes supernodes contiguous.
+        std::vector<std::size_t> parent;
+        sparse_cholesky_etree(row_jumper, col_indices, perm, inverse_perm, parent);
+
+        std::vector<std::size_t> post;
+        sparse_cholesky_postorder(parent, post);
+
+        std::vector<std::size_t> inverse_post(n);
+        for (std::size_t i=0; i<n; ++i)
+          inverse_post[post[i]] = i;
+
+        symbolic.perm.resize(n);
+        symbolic.inverse_perm.resize(n);
+        for (std::size_t i=0; i<n; ++i)
+        {
+          symbolic.perm[i] = perm[post[i]];
+          symbolic.inverse_perm[symbolic.perm[i]] = static_cast<unsigned int>(i);
+        }
+
+        std::vector<std::size_t> post_parent(n, none);
+        for (std::size_t i=0; i<n; ++i)
+          if (parent[post[i]] != none)
+            post_parent[i] = inverse_post[parent[post[i]]];
+        parent.swap(post_parent);
+
+        std::vector<std::size_t> col_counts;
+        sparse_cholesky_column_counts(row_jumper, col_indices, symbolic.perm, symbolic.inverse_perm, parent, col_counts);
+
+        // fundamental supernodes: column j is merged with column j-1 if j is the only child of j-1 and the structures coincide
+        std::vector<std::size_t> num_children(n);
+        for (std::size_t j=0; j<n; ++j)
+          if (parent[j] != none)
+            ++num_children[parent[j]];
+
+        std::vector<std::size_t> fundamental_begin;
+        for (std::size_t j=0; j<n; ++j)
+          if (j == 0 || parent[j-1] != j || col_counts[j-1] != col_counts[j] + 1 || num_children[j] != 1)
+            fundamental_begin.push_back(j);
+        fundamental_begin.push_back(n);
+
+        // relaxed supernodes: merge a supernode into its parent if it is numbered right before it and only few explicit zeros are introduced
+        std::vector<std::size_t> & super_begin = symbolic.super_begin;
+        super_begin.clear();
+        {
+          std::size_t cur_begin = 0;
+          std::size_t cur_rows  = col_counts[0];      //number of rows of the panel
+          double      cur_zeros = 0;                  //explicit zeros in the panel
+          for (std::size_t s = 1; s + 1 < fundamental_begin.size(); ++s)
+          {
+            std::size_t begin = fundamental_begin[s];
+            std::size_t width = fundamental_begin[s+1] - begin;
+            std::size_t cur_width = begin - cur_begin;
+
+            bool merge = false;
+            double merged_zeros = 0;
+            if (relaxed_supernodes && parent[begin - 1] == begin)
+            {
+              std::size_t merged_width = cur_width + width;
+              std::size_t merged_rows  = cur_width + col_counts[begin];
+              double merged_entries = double(merged_width) * double(merged_rows) - double(merged_width) * double(merged_width - 1) / 2.0;
+              double cur_entries    = double(cur_width) * double(cur_rows) - double(cur_width) * double(cur_width - 1) / 2.0;
+              double entries        = double(width) * double(col_counts[begin]) - double(width) * double(width - 1) / 2.0;
+              merged_zeros = merged_entries - (cur_entries - cur_zeros) - entries;
+
+              double zero_fraction = merged_zeros / merged_entries;
+              if (merged_width <= 4)
+                merge = true;
+              else if (merged_width <= 16)
+                merge = zero_fraction < 0.8;
+              else if (merged_width <= 48)
+                merge = zero_fraction < 0.1;
+              else
+                merge = zero_fraction < 0.05;
+            }
+
+            if (merge)
+            {
+              cur_rows  = cur_width + col_counts[begin];
+              cur_zeros = merged_zeros;
+            }
+            else
+            {
+              super_begin.push_back(cur_begin);
+              cur_begin = begin;
+              cur_rows  = col_counts[begin];
+              cur_zeros = 0;
+            }
+          }
+          super_begin.push_back(cur_begin);
+          super_begin.push_back(n);
+        }
+        std::size_t num_super = super_begin.size() - 1;
+
+        std::vector<std::size_t> col_to_super(n);
+        for (std::size_t s=0; s<num_super; ++s)
+          for (std::size_t j = super_begin[s]; j < super_begin[s+1]; ++j)
+            col_to_super[j] = s;
+
+        std::vector<std::size_t> super_parent(num_super, none);
+        for (std::size_t s=0; s<num_super; ++s)
+          if (parent[super_begin[s+1] - 1] != none)
+            super_parent[s] = col_to_super[parent[super_begin[s+1] - 1]];
+
+        std::vector<std::size_t> child_offsets(num_super + 1);
+        for (std::size_t s=0; s<num_super; ++s)
+          if (super_parent[s] != none)
+            ++child_offsets[super_parent[s] + 1];
+        for (std::size_t s=0; s<num_super; ++s)
+          child_offsets[s+1] += child_offsets[s];
+        std::vector<std::size_t> children(child_offsets[num_super]);
+        {
+          std::vector<std::size_t> pos(child_offsets.begin(), child_offsets.end() - 1);
+          for (std::size_t s=0; s<num_super; ++s)
+            if (super_parent[s] != none)
+              children[pos[super_parent[s]]++] = s;
+        }
+
+        // row structure of each supernode: its columns, the entries of A below, and the structures of its children below
+        std::vector<std::size_t> mark(n, none);
+        symbolic.row_offsets.assign(1, 0);
+        symbolic.row_indices.clear();
+        for (std::size_t s=0; s<num_super; ++s)
+        {
+          std::size_t begin = symbolic.row_indices.size();
+          std::size_t first = super_begin[s];
+          std::size_t last  = super_begin[s+1];
+          for (std::size_t j = first; j < last; ++j)
+          {
+            mark[j] = s;
+            symbolic.row_indices.push_back(static_cast<unsigned int>(j));
+          }
+
+          for (std::size_t j = first; j < last; ++j)
+          {
+            unsigned int row = symbolic.perm[j];
+            for (unsigned int k = row_jumper[row]; k < row_jumper[row+1]; ++k)
+            {
+              std::size_t i = symbolic.inverse_perm[col_indices[k]];
+              if (i >= last && mark[i] != s)
+              {
+                mark[i] = s;
+                symbolic.row_indices.push_back(static_cast<unsigned int>(i));
+              }
+            }
+          }
+
+          for (std::size_t c = child_offsets[s]; c < child_offsets[s+1]; ++c)
+          {
+            std::size_t child = children[c];
+            for (std::size_t k = symbolic.row_offsets[child]; k < symbolic.row_offsets[child+1]; ++k)
+            {
+              std::size_t i = symbolic.row_indices[k];
+              if (i >= last && mark[i] != s)
+              {
+                mark[i] = s;
+                symbolic.row_indices.push_back(static_cast<unsigned int>(i));
+              }
+            }
+          }
+
+          std::sort(symbolic.row_indices.begin() + static_cast<long>(begin + last - first), symbolic.row_indices.end());
+          symbolic.row_offsets.push_back(symbolic.row_indices.size());
+        }
+
+        symbolic.value_offsets.resize(num_super + 1);
+        symbolic.value_offsets[0] = 0;
+        for (std::size_t s=0; s<num_super; ++s)
+        {
+          std::size_t rows  = symbolic.row_offsets[s+1] - symbolic.row_offsets[s];
+          std::size_t width = super_begin[s+1] - super_begin[s];
+          symbolic.value_offsets[s+1] = symbolic.value_offsets[s] + rows * width;
+        }
+
+        // updates: the rows of supernode k below its columns are grouped by the supernode they fall into
+        symbolic.update_offsets.assign(num_super + 1, 0);
+        for (int pass = 0; pass < 2; ++pass)
+        {
+          std::vector<std::size_t> pos;
+          if (pass == 1)
+          {
+            for (std::size_t s=0; s<num_super; ++s)
+              symbolic.update_offsets[s+1] += symbolic.update_offsets[s];
+            symbolic.update_sources.resize(symbolic.update_offsets[num_super]);
+            symbolic.update_rows.resize(symbolic.update_offsets[num_super]);
+            pos.assign(symbolic.update_offsets.begin(), symbolic.update_offsets.end() - 1);
+          }
+
+          for (std::size_t k=0; k<num_super; ++k)
+          {
+            std::size_t width = super_begin[k+1] - super_begin[k];
+            std::size_t rows_end = symbolic.row_offsets[k+1];
+            std::size_t target = none;
+            std::size_t target_begin = 0;
+            for (std::size_t r = symbolic.row_offsets[k] + width; r <= rows_end; ++r)
+            {
+              std::size_t s = (r < rows_end) ? col_to_super[symbolic.row_indices[r]] : none;
+              if (s == target)
+                continue;
+
+              if (target != none)
+              {
+                std::size_t rows_in_target = r - target_begin;
+                std::size_t rows_below     = rows_end - target_begin;
+                symbolic.max_update_size = std::max(symbolic.max_update_size, rows_in_target * rows_below);
+              }
+
+              target = s;
+              target_begin = r;
+              if (s == none)
+                break;
+
+              if (pass == 0)
+                ++symbolic.update_offsets[s+1];
+              else
+              {
+                symbolic.update_sources[pos[s]] = static_cast<unsigned int>(k);
+                symbolic.update_rows[pos[s]]    = r - symbolic.row_offsets[k];
+                ++pos[s];
+              }
+            }
+          }
+        }
+
+        // levels in the supernodal elimination tree. Children are numbered before their parents.
+        std::vector<std::size_t> level(num_super);
+        std::size_t num_levels = 0;
+        for (std::size_t s=0; s<num_super; ++s)
+        {
+          if (super_parent[s] != none)
+            level[super_parent[s]] = std::max(level[super_parent[s]], level[s] + 1);
+          num_levels = std::max(num_levels, level[s] + 1);
+        }
+        symbolic.level_offsets.assign(num_levels + 1, 0);
+        for (std::size_t s=0; s<num_super; ++s)
+          ++symbolic.level_offsets[level[s] + 1];
+        for (std::size_t l=0; l<num_levels; ++l)
+          symbolic.level_offsets[l+1] += symbolic.level_offsets[l];
+        symbolic.level_supernodes.resize(num_super);
+        {
+          std::vector<std::size_t> pos(symbolic.level_offsets.begin(), symbolic.level_offsets.end() - 1);
+          for (std::size_t s=0; s<num_super; ++s)
+            symbolic.level_supernodes[pos[level[s]]++] = static_cast<unsigned int>(s);
+        }
+
+        // destinations of the entries of A in the lower triangle of P A P^T:
+        symbolic.a_map_offsets.assign(1, 0);
+        symbolic.a_map_src.clear();
+        symbolic.a_map_dst.clear();
+        for (std::size_t s=0; s<num_super; ++s)
+        {
+          std::size_t rows  = symbolic.row_offsets[s+1] - symbolic.row_offsets[s];
+          for (std::size_t r=0; r<rows; ++r)
+            mark[symbolic.row_indices[symbolic.row_offsets[s] + r]] = r; //local row index
+
+          for (std::size_t j = super_begin[s]; j < super_begin[s+1]; ++j)
+          {
+            unsigned int row = symbolic.perm[j];
+            for (unsigned int k = row_jumper[row]; k < row_jumper[row+1]; ++k)
+            {
+              std::size_t i = symbolic.inverse_perm[col_indices[k]];
+              if (i < j)
+                continue;
+              symbolic.a_map_src.push_back(k);
+              symbolic.a_map_dst.push_back(symbolic.value_offsets[s] + (j - super_begin[s]) * rows + mark[i]);
+            }
+          }
+          symbolic.a_map_offsets.push_back(symbolic.a_map_src.size());
+        }
+      }
+
+    }
+  }
+}
+
+#endif
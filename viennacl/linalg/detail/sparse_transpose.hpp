@@ -0,0 +1,97 @@
+#ifndef VIENNACL_LINALG_DETAIL_SPARSE_TRANSPOSE_HPP_
+#define VIENNACL_LINALG_DETAIL_SPARSE_TRANSPOSE_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/sparse_transpose.hpp
+    @brief Explicit transposition of a compressed_matrix, used by algorithms requiring products with the transpose of a sparse matrix.
+*/
+
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/backend/util.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace detail
+    {
+      /** @brief Sets up the transpose At of the sparse matrix A in the memory context of At.
+      *
+      * The transposition is a counting sort carried out on the host, so it is meant to be run once per solver invocation rather than per iteration.
+      * Explicitly stored zeros (e.g. from alignment padding) are dropped.
+      *
+      * @param A   The matrix to be transposed
+      * @param At  The transpose (output), which must have been created with dimensions A.size2() x A.size1()
+      */
+      template <typename ScalarType, unsigned int ALIGNMENT, unsigned int ALIGNMENT_T>
+      void sparse_transpose(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & A,
+                            viennacl::compressed_matrix<ScalarType, ALIGNMENT_T> & At)
+      {
+        viennacl::backend::typesafe_host_array<unsigned int> row_buffer(A.handle1(), A.size1() + 1);
+        viennacl::backend::typesafe_host_array<unsigned int> col_buffer(A.handle2(), A.nnz());
+        std::vector<ScalarType> elements(A.nnz());
+
+        viennacl::backend::memory_read(A.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+        viennacl::backend::memory_read(A.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+        viennacl::backend::memory_read(A.handle(),  0, sizeof(ScalarType) * A.nnz(), &(elements[0]));
+
+        // count the nonzeros per column of A (i.e. per row of A^T):
+        std::vector<std::size_t> row_start_t(A.size2() + 1, 0);
+        for (std::size_t row = 0; row < A.size1(); ++row)
+          for (std::size_t j = row_buffer[row]; j < row_buffer[row+1]; ++j)
+            if (elements[j] != ScalarType(0))
+              row_start_t[col_buffer[j] + 1] += 1;
+        for (std::size_t i = 0; i < A.size2(); ++i)
+          row_start_t[i+1] += row_start_t[i];
+
+        std::size_t nnz_t = row_start_t[A.size2()];
+
+        viennacl::backend::typesafe_host_array<unsigned int> row_buffer_t(At.handle1(), A.size2() + 1);
+        viennacl::backend::typesafe_host_array<unsigned int> col_buffer_t(At.handle2(), (nnz_t > 0) ? nnz_t : 1);
+        std::vector<ScalarType> elements_t((nnz_t > 0) ? nnz_t : 1);
+
+        for (std::size_t i = 0; i <= A.size2(); ++i)
+          row_buffer_t.set(i, row_start_t[i]);
+
+        // row-wise traversal of A leads to sorted column indices in A^T:
+        std::vector<std::size_t> insert_pos(row_start_t.begin(), row_start_t.end() - 1);
+        for (std::size_t row = 0; row < A.size1(); ++row)
+          for (std::size_t j = row_buffer[row]; j < row_buffer[row+1]; ++j)
+          {
+            if (elements[j] != ScalarType(0))
+            {
+              std::size_t index = insert_pos[col_buffer[j]]++;
+              col_buffer_t.set(index, row);
+              elements_t[index] = elements[j];
+            }
+          }
+
+        At.set(row_buffer_t.get(), col_buffer_t.get(), &(elements_t[0]), A.size2(), A.size1(), (nnz_t > 0) ? nnz_t : 1);
+      }
+
+    } //namespace detail
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
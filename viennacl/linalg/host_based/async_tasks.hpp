@@ -0,0 +1,408 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_ASYNC_TASKS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_ASYNC_TASKS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/async_tasks.hpp
+    @brief Tasks wrapping host-based operations for the asynchronous execution by viennacl::backend::host_executor.
+
+    The host-based routine to be run is passed as a function pointer, so that this file does not depend on the implementations.
+    Vectors, dense matrices and device scalars are stored as views sharing the buffer of the argument, which keeps the buffer alive until the task has completed.
+    Sparse matrices are stored as copies sharing the buffers of the argument. Sparse matrix types for which this is not possible are not enqueued, cf. is_async_matrix.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/meta/enable_if.hpp"
+#include "viennacl/backend/mem_handle.hpp"
+#include "viennacl/backend/host_executor.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        //
+        // Arguments of tasks
+        //
+
+        inline void const * async_buffer(viennacl::backend::mem_handle const & h) { return h.ram_handle().get(); }
+
+        /** @brief A vector argument, stored as a view on the buffer of the vector */
+        template <typename T>
+        class async_vector_argument
+        {
+          public:
+            async_vector_argument(vector_base<T> const & vec) : handle_(vec.handle()), view_(handle_, vec.size(), vec.start(), vec.stride()) {}
+
+            vector_base<T> & get() { return view_; }
+            void const * buffer() const { return async_buffer(handle_); }
+
+          private:
+            viennacl::backend::mem_handle handle_;
+            vector_base<T>                view_;
+        };
+
+        /** @brief A scalar argument. Host scalars are stored by value. */
+        template <typename S>
+        class async_scalar_argument
+        {
+          public:
+            async_scalar_argument(S const & s) : value_(s) {}
+
+            S & get() { return value_; }
+            void const * buffer() const { return NULL; }
+
+          private:
+            S value_;
+        };
+
+        /** @brief A device scalar argument, stored as a scalar sharing the buffer of the argument */
+        template <typename T>
+        class async_scalar_argument< viennacl::scalar<T> >
+        {
+          public:
+            async_scalar_argument(viennacl::scalar<T> const & s) { value_.handle() = s.handle(); }
+
+            viennacl::scalar<T> & get() { return value_; }
+            void const * buffer() const { return async_buffer(value_.handle()); }
+
+          private:
+            viennacl::scalar<T> value_;
+        };
+
+        /** @brief Matrix types which can be held by a task. All buffers of the matrix are registered by an overload of register_matrix_reads().
+        *
+        * The copy constructors of the sparse matrix types listed here only copy the memory handles, so a copy shares the buffers of the original matrix.
+        * coordinate_matrix cannot be copied, hence products with it are run synchronously.
+        */
+        template <typename MatrixType>
+        struct is_async_matrix
+        {
+          enum { value = false };
+        };
+
+        template <typename T, typename F>
+        struct is_async_matrix< viennacl::matrix_base<T, F> >
+        {
+          enum { value = true };
+        };
+
+        template <typename T, unsigned int A>
+        struct is_async_matrix< viennacl::compressed_matrix<T, A> >
+        {
+          enum { value = true };
+        };
+
+        template <typename T>
+        struct is_async_matrix< viennacl::compressed_compressed_matrix<T> >
+        {
+          enum { value = true };
+        };
+
+        template <typename T>
+        struct is_async_matrix< viennacl::symmetric_compressed_matrix<T> >
+        {
+          enum { value = true };
+        };
+
+        template <typename T, unsigned int A>
+        struct is_async_matrix< viennacl::ell_matrix<T, A> >
+        {
+          enum { value = true };
+        };
+
+        template <typename T, unsigned int A>
+        struct is_async_matrix< viennacl::hyb_matrix<T, A> >
+        {
+          enum { value = true };
+        };
+
+        template <typename T, unsigned int A>
+        void register_matrix_reads(viennacl::backend::host_task & task, viennacl::compressed_matrix<T, A> const & mat)
+        {
+          task.reads(async_buffer(mat.handle1()));
+          task.reads(async_buffer(mat.handle2()));
+          task.reads(async_buffer(mat.handle()));
+        }
+
+        template <typename T>
+        void register_matrix_reads(viennacl::backend::host_task & task, viennacl::compressed_compressed_matrix<T> const & mat)
+        {
+          task.reads(async_buffer(mat.handle1()));
+          task.reads(async_buffer(mat.handle2()));
+          task.reads(async_buffer(mat.handle3()));
+          task.reads(async_buffer(mat.handle()));
+        }
+
+        template <typename T>
+        void register_matrix_reads(viennacl::backend::host_task & task, viennacl::symmetric_compressed_matrix<T> const & mat)
+        {
+          task.reads(async_buffer(mat.handle1()));
+          task.reads(async_buffer(mat.handle2()));
+          task.reads(async_buffer(mat.handle3()));
+          task.reads(async_buffer(mat.handle()));
+        }
+
+        template <typename T, unsigned int A>
+        void register_matrix_reads(viennacl::backend::host_task & task, viennacl::ell_matrix<T, A> const & mat)
+        {
+          task.reads(async_buffer(mat.handle()));
+          task.reads(async_buffer(mat.handle2()));
+        }
+
+        template <typename T, unsigned int A>
+        void register_matrix_reads(viennacl::backend::host_task & task, viennacl::hyb_matrix<T, A> const & mat)
+        {
+          task.reads(async_buffer(mat.handle()));
+          task.reads(async_buffer(mat.handle2()));
+          task.reads(async_buffer(mat.handle3()));
+          task.reads(async_buffer(mat.handle4()));
+          task.reads(async_buffer(mat.handle5()));
+        }
+
+        /** @brief A sparse matrix argument, stored as a copy sharing the buffers of the matrix. Only for types with is_async_matrix<>::value set. */
+        template <typename MatrixType>
+        class async_matrix_argument
+        {
+          public:
+            async_matrix_argument(MatrixType const & mat) : mat_(mat) {}
+
+            MatrixType const & get() { return mat_; }
+            void register_reads(viennacl::backend::host_task & task) const { register_matrix_reads(task, mat_); }
+
+          private:
+            MatrixType mat_;
+        };
+
+        /** @brief A dense matrix argument, stored as a view on the buffer of the matrix */
+        template <typename T, typename F>
+        class async_matrix_argument< viennacl::matrix_base<T, F> >
+        {
+          public:
+            async_matrix_argument(viennacl::matrix_base<T, F> const & mat)
+              : handle_(mat.handle()),
+                view_(handle_, mat.size1(), mat.start1(), mat.stride1(), mat.internal_size1(),
+                               mat.size2(), mat.start2(), mat.stride2(), mat.internal_size2()) {}
+
+            viennacl::matrix_base<T, F> const & get() { return view_; }
+            void register_reads(viennacl::backend::host_task & task) const { task.reads(async_buffer(handle_)); }
+
+          private:
+            viennacl::backend::mem_handle handle_;
+            viennacl::matrix_base<T, F>   view_;
+        };
+
+        //
+        // Tasks
+        //
+
+        /** @brief Task for vec1 = alpha * vec2 */
+        template <typename T, typename ScalarType1>
+        class av_task : public viennacl::backend::host_task
+        {
+          public:
+            typedef void (*function_type)(vector_base<T> &, vector_base<T> const &, ScalarType1 const &, std::size_t, bool, bool);
+
+            av_task(function_type f,
+                    vector_base<T> & vec1,
+                    vector_base<T> const & vec2, ScalarType1 const & alpha, std::size_t len_alpha, bool reciprocal_alpha, bool flip_sign_alpha)
+              : f_(f), vec1_(vec1), vec2_(vec2), alpha_(alpha), len_alpha_(len_alpha), reciprocal_alpha_(reciprocal_alpha), flip_sign_alpha_(flip_sign_alpha)
+            {
+              reads(vec2_.buffer());
+              reads(alpha_.buffer());
+              writes(vec1_.buffer());
+            }
+
+            void run() { f_(vec1_.get(), vec2_.get(), alpha_.get(), len_alpha_, reciprocal_alpha_, flip_sign_alpha_); }
+
+          private:
+            function_type                         f_;
+            async_vector_argument<T>              vec1_;
+            async_vector_argument<T>              vec2_;
+            async_scalar_argument<ScalarType1>    alpha_;
+            std::size_t len_alpha_;
+            bool reciprocal_alpha_, flip_sign_alpha_;
+        };
+
+        /** @brief Task for vec1 = alpha * vec2 + beta * vec3 or vec1 += alpha * vec2 + beta * vec3, depending on the function supplied */
+        template <typename T, typename ScalarType1, typename ScalarType2>
+        class avbv_task : public viennacl::backend::host_task
+        {
+          public:
+            typedef void (*function_type)(vector_base<T> &,
+                                          vector_base<T> const &, ScalarType1 const &, std::size_t, bool, bool,
+                                          vector_base<T> const &, ScalarType2 const &, std::size_t, bool, bool);
+
+            avbv_task(function_type f,
+                      vector_base<T> & vec1,
+                      vector_base<T> const & vec2, ScalarType1 const & alpha, std::size_t len_alpha, bool reciprocal_alpha, bool flip_sign_alpha,
+                      vector_base<T> const & vec3, ScalarType2 const & beta,  std::size_t len_beta,  bool reciprocal_beta,  bool flip_sign_beta)
+              : f_(f), vec1_(vec1),
+                vec2_(vec2), alpha_(alpha), len_alpha_(len_alpha), reciprocal_alpha_(reciprocal_alpha), flip_sign_alpha_(flip_sign_alpha),
+                vec3_(vec3), beta_(beta),   len_beta_(len_beta),   reciprocal_beta_(reciprocal_beta),   flip_sign_beta_(flip_sign_beta)
+            {
+              reads(vec2_.buffer());
+              reads(alpha_.buffer());
+              reads(vec3_.buffer());
+              reads(beta_.buffer());
+              writes(vec1_.buffer());
+            }
+
+            void run()
+            {
+              f_(vec1_.get(),
+                 vec2_.get(), alpha_.get(), len_alpha_, reciprocal_alpha_, flip_sign_alpha_,
+                 vec3_.get(), beta_.get(),  len_beta_,  reciprocal_beta_,  flip_sign_beta_);
+            }
+
+          private:
+            function_type                         f_;
+            async_vector_argument<T>              vec1_;
+            async_vector_argument<T>              vec2_;
+            async_scalar_argument<ScalarType1>    alpha_;
+            std::size_t len_alpha_;
+            bool reciprocal_alpha_, flip_sign_alpha_;
+            async_vector_argument<T>              vec3_;
+            async_scalar_argument<ScalarType2>    beta_;
+            std::size_t len_beta_;
+            bool reciprocal_beta_, flip_sign_beta_;
+        };
+
+        /** @brief Task for result = inner_prod(vec1, vec2) */
+        template <typename T>
+        class inner_prod_task : public viennacl::backend::host_task
+        {
+          public:
+            typedef void (*function_type)(vector_base<T> const &, vector_base<T> const &, viennacl::scalar<T> &);
+
+            inner_prod_task(function_type f, vector_base<T> const & vec1, vector_base<T> const & vec2, viennacl::scalar<T> & result)
+              : f_(f), vec1_(vec1), vec2_(vec2), result_(result)
+            {
+              reads(vec1_.buffer());
+              reads(vec2_.buffer());
+              writes(result_.buffer());
+            }
+
+            void run() { f_(vec1_.get(), vec2_.get(), result_.get()); }
+
+          private:
+            function_type                                 f_;
+            async_vector_argument<T>                      vec1_;
+            async_vector_argument<T>                      vec2_;
+            async_scalar_argument< viennacl::scalar<T> >  result_;
+        };
+
+        /** @brief Task for result = norm(vec), where the norm is given by the function supplied */
+        template <typename T>
+        class norm_task : public viennacl::backend::host_task
+        {
+          public:
+            typedef void (*function_type)(vector_base<T> const &, viennacl::scalar<T> &);
+
+            norm_task(function_type f, vector_base<T> const & vec, viennacl::scalar<T> & result)
+              : f_(f), vec_(vec), result_(result)
+            {
+              reads(vec_.buffer());
+              writes(result_.buffer());
+            }
+
+            void run() { f_(vec_.get(), result_.get()); }
+
+          private:
+            function_type                                 f_;
+            async_vector_argument<T>                      vec_;
+            async_scalar_argument< viennacl::scalar<T> >  result_;
+        };
+
+        /** @brief Task for s1 = s2 / s3 on device scalars, where s1 is set to zero if s3 is zero */
+        template <typename T>
+        class safe_div_task : public viennacl::backend::host_task
+        {
+          public:
+            typedef void (*function_type)(viennacl::scalar<T> &, viennacl::scalar<T> const &, viennacl::scalar<T> const &);
+
+            safe_div_task(function_type f, viennacl::scalar<T> & s1, viennacl::scalar<T> const & s2, viennacl::scalar<T> const & s3)
+              : f_(f), s1_(s1), s2_(s2), s3_(s3)
+            {
+              reads(s2_.buffer());
+              reads(s3_.buffer());
+              writes(s1_.buffer());
+            }
+
+            void run() { f_(s1_.get(), s2_.get(), s3_.get()); }
+
+          private:
+            function_type                                 f_;
+            async_scalar_argument< viennacl::scalar<T> >  s1_;
+            async_scalar_argument< viennacl::scalar<T> >  s2_;
+            async_scalar_argument< viennacl::scalar<T> >  s3_;
+        };
+
+        /** @brief Task for result = prod(mat, vec) */
+        template <typename MatrixType, typename T>
+        class prod_task : public viennacl::backend::host_task
+        {
+          public:
+            typedef void (*function_type)(MatrixType const &, vector_base<T> const &, vector_base<T> &);
+
+            prod_task(function_type f, MatrixType const & mat, vector_base<T> const & vec, vector_base<T> & result)
+              : f_(f), mat_(mat), vec_(vec), result_(result)
+            {
+              mat_.register_reads(*this);
+              reads(vec_.buffer());
+              writes(result_.buffer());
+            }
+
+            void run() { f_(mat_.get(), vec_.get(), result_.get()); }
+
+          private:
+            function_type                          f_;
+            async_matrix_argument<MatrixType>      mat_;
+            async_vector_argument<T>               vec_;
+            async_vector_argument<T>               result_;
+        };
+
+        /** @brief Enqueues the task result = prod(mat, vec) if the matrix can be held by a task.
+        *
+        * @return false if nothing was enqueued, in which case the caller runs the product synchronously
+        */
+        template <typename MatrixType, typename T>
+        typename viennacl::enable_if<is_async_matrix<MatrixType>::value, bool>::type
+        enqueue_prod(void (*f)(MatrixType const &, vector_base<T> const &, vector_base<T> &), MatrixType const & mat, vector_base<T> const & vec, vector_base<T> & result)
+        {
+          viennacl::backend::current_host_executor().enqueue(new prod_task<MatrixType, T>(f, mat, vec, result));
+          return true;
+        }
+
+        template <typename MatrixType, typename T>
+        typename viennacl::enable_if<!is_async_matrix<MatrixType>::value, bool>::type
+        enqueue_prod(void (*)(MatrixType const &, vector_base<T> const &, vector_base<T> &), MatrixType const &, vector_base<T> const &, vector_base<T> &)
+        {
+          return false;
+        }
+
+      } //namespace detail
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
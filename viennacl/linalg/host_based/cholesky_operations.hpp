@@ -0,0 +1,228 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_CHOLESKY_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_CHOLESKY_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/cholesky_operations.hpp
+    @brief Implementations of the blocked dense Cholesky factorization using a single CPU thread or OpenMP.
+
+    The factorization is right-looking (cf. LAPACK's xPOTRF): Each panel consists of a diagonal block and the rows below, which are obtained from a triangular solve.
+    Only the lower triangle of the trailing matrix is updated (symmetric rank-k update), tile by tile. With OpenMP, the factorization uses a look-ahead of one panel:
+    The next panel is updated first and then factorized by one thread, while the other threads update the remaining tiles of the trailing matrix.
+*/
+
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/tuning_profile.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Computes the Cholesky factor of the diagonal block [k_start, k_end) x [k_start, k_end) in place. Entry (i, j) is located at A[i * inc_row + j * inc_col].
+        *
+        * @return false if the block is not positive definite
+        */
+        template <typename NumericT>
+        bool cholesky_diagonal_block(NumericT * A, std::size_t inc_row, std::size_t inc_col, std::size_t k_start, std::size_t k_end)
+        {
+          for (std::size_t j = k_start; j < k_end; ++j)
+          {
+            NumericT * row_j = A + j * inc_row;
+
+            NumericT a_jj = row_j[j * inc_col];
+            for (std::size_t k = k_start; k < j; ++k)
+              a_jj -= row_j[k * inc_col] * row_j[k * inc_col];
+
+            if (a_jj <= NumericT(0))
+              return false;
+
+            a_jj = std::sqrt(a_jj);
+            row_j[j * inc_col] = a_jj;
+
+            for (std::size_t i = j + 1; i < k_end; ++i)
+            {
+              NumericT * row_i = A + i * inc_row;
+              NumericT a_ij = row_i[j * inc_col];
+              for (std::size_t k = k_start; k < j; ++k)
+                a_ij -= row_i[k * inc_col] * row_j[k * inc_col];
+              row_i[j * inc_col] = a_ij / a_jj;
+            }
+          }
+          return true;
+        }
+
+        /** @brief Factorizes the panel of columns [k_start, k_end) of the n x n matrix A, i.e. the diagonal block and the rows below, L_21 = A_21 * L_11^{-T}.
+        *
+        * The rows below the diagonal block are independent and are distributed among the threads unless called from within a parallel region.
+        *
+        * @return false if the diagonal block is not positive definite
+        */
+        template <typename NumericT>
+        bool cholesky_panel(NumericT * A, std::size_t inc_row, std::size_t inc_col, std::size_t n, std::size_t k_start, std::size_t k_end)
+        {
+          if (!cholesky_diagonal_block(A, inc_row, inc_col, k_start, k_end))
+            return false;
+
+          long num_rows = static_cast<long>(n - k_end);
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (num_rows * static_cast<long>(k_end - k_start) > 5000)
+#endif
+          for (long row = 0; row < num_rows; ++row)
+          {
+            NumericT * row_i = A + (k_end + static_cast<std::size_t>(row)) * inc_row;
+            for (std::size_t j = k_start; j < k_end; ++j)
+            {
+              NumericT const * row_j = A + j * inc_row;
+              NumericT a_ij = row_i[j * inc_col];
+              for (std::size_t k = k_start; k < j; ++k)
+                a_ij -= row_i[k * inc_col] * row_j[k * inc_col];
+              row_i[j * inc_col] = a_ij / row_j[j * inc_col];
+            }
+          }
+          return true;
+        }
+
+        /** @brief Subtracts L(rows, panel) * L(cols, panel)^T from the tile A([row_start, row_end), [col_start, col_end)), where the panel consists of the columns [k_start, k_end). Entries above the diagonal are not updated. */
+        template <typename NumericT>
+        void cholesky_update_tile(NumericT * A, std::size_t inc_row, std::size_t inc_col, std::size_t k_start, std::size_t k_end,
+                                  std::size_t row_start, std::size_t row_end, std::size_t col_start, std::size_t col_end)
+        {
+          for (std::size_t i = row_start; i < row_end; ++i)
+          {
+            NumericT * row_i = A + i * inc_row;
+            std::size_t j_end = std::min(col_end, i + 1);
+            for (std::size_t j = col_start; j < j_end; ++j)
+            {
+              NumericT const * row_j = A + j * inc_row;
+              NumericT temp = 0;
+              for (std::size_t k = k_start; k < k_end; ++k)
+                temp += row_i[k * inc_col] * row_j[k * inc_col];
+              row_i[j * inc_col] -= temp;
+            }
+          }
+        }
+      } //namespace detail
+
+
+      /** @brief Computes the Cholesky factorization A = L * L^T of a dense symmetric positive definite matrix.
+      *
+      * Only the lower triangle of A is referenced. On return, A holds L, the strictly upper triangle is set to zero.
+      *
+      * @param A            The matrix, where the Cholesky factor is directly written to
+      * @param block_size   Number of columns per panel. If zero, the panel width of the tuning profile is used.
+      * @return false if A is not positive definite. In this case, the content of A is undefined.
+      */
+      template <typename NumericT, typename F>
+      bool cholesky_factorize(viennacl::matrix<NumericT, F> & A, std::size_t block_size = 0)
+      {
+        if (block_size == 0)
+          block_size = std::max<std::size_t>(current_tuning_profile().cholesky_block_size, 1);
+
+        std::size_t n = A.size1();
+        if (n == 0)
+          return true;
+
+        NumericT * data_A = detail::extract_raw_pointer<NumericT>(A);
+        std::size_t inc_row = F::mem_index(1, 0, A.internal_size1(), A.internal_size2()) - F::mem_index(0, 0, A.internal_size1(), A.internal_size2());
+        std::size_t inc_col = F::mem_index(0, 1, A.internal_size1(), A.internal_size2()) - F::mem_index(0, 0, A.internal_size1(), A.internal_size2());
+
+        if (!detail::cholesky_panel(data_A, inc_row, inc_col, n, 0, std::min(block_size, n)))
+          return false;
+
+        std::vector<std::pair<std::size_t, std::size_t> > tiles;
+        for (std::size_t k_start = 0; k_start + block_size < n; k_start += block_size)
+        {
+          // panel [k_start, k_end) is factorized, the next panel is [k_end, next_end):
+          std::size_t k_end    = k_start + block_size;
+          std::size_t next_end = std::min(k_end + block_size, n);
+
+          // tiles of the trailing matrix right of the next panel, lower triangle only:
+          tiles.clear();
+          for (std::size_t col_start = next_end; col_start < n; col_start += block_size)
+            for (std::size_t row_start = col_start; row_start < n; row_start += block_size)
+              tiles.push_back(std::make_pair(row_start, col_start));
+
+          long num_next_tiles = static_cast<long>((n - k_end + block_size - 1) / block_size);
+          long num_tiles      = static_cast<long>(tiles.size());
+          bool success = true;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel if ((n - k_end) * (n - k_end) * block_size > 100000)
+#endif
+          {
+            // update the next panel with the current one:
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp for
+#endif
+            for (long tile = 0; tile < num_next_tiles; ++tile)
+            {
+              std::size_t row_start = k_end + static_cast<std::size_t>(tile) * block_size;
+              detail::cholesky_update_tile(data_A, inc_row, inc_col, k_start, k_end, row_start, std::min(row_start + block_size, n), k_end, next_end);
+            }
+
+            // factorize the next panel, while the other threads update the rest of the trailing matrix:
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp single nowait
+#endif
+            success = detail::cholesky_panel(data_A, inc_row, inc_col, n, k_end, next_end);
+
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp for schedule(dynamic)
+#endif
+            for (long tile = 0; tile < num_tiles; ++tile)
+            {
+              std::size_t row_start = tiles[static_cast<std::size_t>(tile)].first;
+              std::size_t col_start = tiles[static_cast<std::size_t>(tile)].second;
+              detail::cholesky_update_tile(data_A, inc_row, inc_col, k_start, k_end,
+                                           row_start, std::min(row_start + block_size, n),
+                                           col_start, std::min(col_start + block_size, n));
+            }
+          }
+
+          if (!success)
+            return false;
+        }
+
+        // clear strictly upper triangle:
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (n > 256)
+#endif
+        for (long i = 0; i < static_cast<long>(n); ++i)
+          for (std::size_t j = static_cast<std::size_t>(i) + 1; j < n; ++j)
+            data_A[static_cast<std::size_t>(i) * inc_row + j * inc_col] = NumericT(0);
+
+        return true;
+      }
+
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -24,6 +24,10 @@
 
 #include "viennacl/traits/handle.hpp"
 
+#ifdef VIENNACL_WITH_HOST_ASYNC
+  #include "viennacl/backend/host_executor.hpp"
+#endif
+
 namespace viennacl
 {
   namespace linalg
@@ -35,12 +39,18 @@ namespace viennacl
         template <typename T, typename VectorType>
         T * extract_raw_pointer(VectorType & vec)
         {
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          viennacl::backend::host_executor_wait(viennacl::traits::ram_handle(vec).get()); // pending asynchronous operations on the buffer
+#endif
           return reinterpret_cast<T *>(viennacl::traits::ram_handle(vec).get());
         }
 
         template <typename T, typename VectorType>
         T const * extract_raw_pointer(VectorType const & vec)
         {
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          viennacl::backend::host_executor_wait(viennacl::traits::ram_handle(vec).get());
+#endif
           return reinterpret_cast<T const *>(viennacl::traits::ram_handle(vec).get());
         }
 
@@ -22,6 +22,9 @@
     @brief Implementations of dense direct triangular solvers are found here.
 */
 
+#include <vector>
+#include <algorithm>
+
 #include "viennacl/vector.hpp"
 #include "viennacl/matrix.hpp"
 
@@ -36,34 +39,137 @@ namespace viennacl
 
       namespace detail
       {
-        //
-        // Upper solve:
-        //
+        /** @brief Block size (rows of A and columns of B) used by the blocked triangular solvers with multiple right hand sides */
+        static const std::size_t inplace_solve_block_size = 64;
+
+        /** @brief Computes B(rows, cols) -= A(rows, ks) * B(ks, cols) on the index ranges [row_begin, row_end), [k_begin, k_end) and [col_begin, col_end).
+        *
+        * The k-range is traversed in chunks. The active blocks of A and B are packed into contiguous buffers, so that the innermost loop is independent of the memory layout.
+        */
         template <typename MatrixType1, typename MatrixType2>
-        void upper_inplace_solve_matrix(MatrixType1 & A, MatrixType2 & B, std::size_t A_size, std::size_t B_size, bool unit_diagonal)
+        void inplace_solve_gemm_update(MatrixType1 & A, MatrixType2 & B,
+                                       std::size_t row_begin, std::size_t row_end,
+                                       std::size_t k_begin,   std::size_t k_end,
+                                       std::size_t col_begin, std::size_t col_end)
         {
           typedef typename MatrixType2::value_type   value_type;
 
-          for (std::size_t i = 0; i < A_size; ++i)
+          std::size_t num_cols = col_end - col_begin;
+          if (k_begin >= k_end || num_cols == 0)
+            return;
+
+          std::vector<value_type> B_packed(inplace_solve_block_size * num_cols);
+          std::vector<value_type> A_row(inplace_solve_block_size);
+          std::vector<value_type> result(num_cols);
+
+          for (std::size_t k_chunk = k_begin; k_chunk < k_end; k_chunk += inplace_solve_block_size)
           {
-            std::size_t current_row = A_size - i - 1;
+            std::size_t k_chunk_size = std::min(inplace_solve_block_size, k_end - k_chunk);
 
-            for (std::size_t j = current_row + 1; j < A_size; ++j)
+            for (std::size_t k = 0; k < k_chunk_size; ++k)
+              for (std::size_t j = 0; j < num_cols; ++j)
+                B_packed[k * num_cols + j] = B(k_chunk + k, col_begin + j);
+
+            for (std::size_t i = row_begin; i < row_end; ++i)
             {
-              value_type A_element = A(current_row, j);
-              for (std::size_t k=0; k < B_size; ++k)
-                B(current_row, k) -= A_element * B(j, k);
+              for (std::size_t k = 0; k < k_chunk_size; ++k)
+                A_row[k] = A(i, k_chunk + k);
+
+              std::fill(result.begin(), result.end(), value_type(0));
+              for (std::size_t k = 0; k < k_chunk_size; ++k)
+              {
+                value_type A_element = A_row[k];
+                value_type const * B_row = &(B_packed[k * num_cols]);
+                for (std::size_t j = 0; j < num_cols; ++j)
+                  result[j] += A_element * B_row[j];
+              }
+
+              for (std::size_t j = 0; j < num_cols; ++j)
+                B(i, col_begin + j) -= result[j];
+            }
+          }
+        }
+
+        /** @brief Substitution within the diagonal block [block_begin, block_end) for the columns [col_begin, col_end) of B */
+        template <typename MatrixType1, typename MatrixType2>
+        void inplace_solve_diagonal_block(MatrixType1 & A, MatrixType2 & B,
+                                          std::size_t block_begin, std::size_t block_end,
+                                          std::size_t col_begin, std::size_t col_end,
+                                          bool is_upper, bool unit_diagonal)
+        {
+          typedef typename MatrixType2::value_type   value_type;
+
+          for (std::size_t ii = block_begin; ii < block_end; ++ii)
+          {
+            std::size_t i = is_upper ? (block_end - 1 - (ii - block_begin)) : ii;
+            std::size_t j_begin = is_upper ? i + 1       : block_begin;
+            std::size_t j_end   = is_upper ? block_end   : i;
+
+            for (std::size_t j = j_begin; j < j_end; ++j)
+            {
+              value_type A_element = A(i, j);
+              for (std::size_t k = col_begin; k < col_end; ++k)
+                B(i, k) -= A_element * B(j, k);
             }
 
             if (!unit_diagonal)
             {
-              value_type A_diag = A(current_row, current_row);
-              for (std::size_t k=0; k < B_size; ++k)
-                B(current_row, k) /= A_diag;
+              value_type A_diag = A(i, i);
+              for (std::size_t k = col_begin; k < col_end; ++k)
+                B(i, k) /= A_diag;
+            }
+          }
+        }
+
+        /** @brief Blocked triangular solve with multiple right hand sides.
+        *
+        * The right hand sides are split into column blocks, which are processed in parallel. Within each column block, the solution proceeds by row blocks,
+        * where the contributions of all previously solved row blocks are subtracted by a matrix-matrix product prior to the substitution within the diagonal block.
+        */
+        template <typename MatrixType1, typename MatrixType2>
+        void blocked_inplace_solve_matrix(MatrixType1 & A, MatrixType2 & B, std::size_t A_size, std::size_t B_size, bool is_upper, bool unit_diagonal)
+        {
+          if (A_size == 0 || B_size == 0)
+            return;
+
+          std::size_t block_size = inplace_solve_block_size;
+          std::size_t num_row_blocks = (A_size - 1) / block_size + 1;
+          std::size_t num_col_blocks = (B_size - 1) / block_size + 1;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (num_col_blocks > 1 && A_size * A_size * B_size > 100000)
+#endif
+          for (std::size_t col_block = 0; col_block < num_col_blocks; ++col_block)
+          {
+            std::size_t col_begin = col_block * block_size;
+            std::size_t col_end   = std::min(col_begin + block_size, B_size);
+
+            for (std::size_t row_block = 0; row_block < num_row_blocks; ++row_block)
+            {
+              // upper triangular systems are solved from the bottom:
+              std::size_t block_id    = is_upper ? (num_row_blocks - 1 - row_block) : row_block;
+              std::size_t block_begin = block_id * block_size;
+              std::size_t block_end   = std::min(block_begin + block_size, A_size);
+
+              if (is_upper)
+                inplace_solve_gemm_update(A, B, block_begin, block_end, block_end, A_size, col_begin, col_end);
+              else
+                inplace_solve_gemm_update(A, B, block_begin, block_end, 0, block_begin, col_begin, col_end);
+
+              inplace_solve_diagonal_block(A, B, block_begin, block_end, col_begin, col_end, is_upper, unit_diagonal);
             }
           }
         }
 
+        //
+        // Upper solve:
+        //
+        template <typename MatrixType1, typename MatrixType2>
+        void upper_inplace_solve_matrix(MatrixType1 & A, MatrixType2 & B, std::size_t A_size, std::size_t B_size, bool unit_diagonal)
+        {
+          blocked_inplace_solve_matrix(A, B, A_size, B_size, true, unit_diagonal);
+        }
+
         template <typename MatrixType1, typename MatrixType2>
         void inplace_solve_matrix(MatrixType1 & A, MatrixType2 & B, std::size_t A_size, std::size_t B_size, viennacl::linalg::unit_upper_tag)
         {
@@ -82,24 +188,7 @@ namespace viennacl
         template <typename MatrixType1, typename MatrixType2>
         void lower_inplace_solve_matrix(MatrixType1 & A, MatrixType2 & B, std::size_t A_size, std::size_t B_size, bool unit_diagonal)
         {
-          typedef typename MatrixType2::value_type   value_type;
-
-          for (std::size_t i = 0; i < A_size; ++i)
-          {
-            for (std::size_t j = 0; j < i; ++j)
-            {
-              value_type A_element = A(i, j);
-              for (std::size_t k=0; k < B_size; ++k)
-                B(i, k) -= A_element * B(j, k);
-            }
-
-            if (!unit_diagonal)
-            {
-              value_type A_diag = A(i, i);
-              for (std::size_t k=0; k < B_size; ++k)
-                B(i, k) /= A_diag;
-            }
-          }
+          blocked_inplace_solve_matrix(A, B, A_size, B_size, false, unit_diagonal);
         }
 
         template <typename MatrixType1, typename MatrixType2>
@@ -0,0 +1,817 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_EIG_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_EIG_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/eig_operations.hpp
+    @brief Implementations of the symmetric eigenvalue decomposition using a single CPU thread or OpenMP.
+
+    If eigenvectors are requested, the matrix is reduced to tridiagonal form by blocked Householder transformations (cf. LAPACK's xSYTRD),
+    where the trailing matrix is updated by matrix-matrix products. The tridiagonal eigenproblem is solved by Cuppen's divide-and-conquer method,
+    where the eigenvectors of the rank-one modified subproblems are computed as proposed by Gu and Eisenstat and merged by matrix-matrix products.
+    Finally, the eigenvectors are transformed back by applying the Householder reflectors in blocks.
+
+    If only eigenvalues are requested, the tridiagonal reduction is carried out by inplace_tred2() from sse_kernels.hpp,
+    followed by the implicit QL method.
+*/
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/tuning_profile.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
+#include "viennacl/linalg/host_based/householder.hpp"
+#include "viennacl/linalg/host_based/svd_operations.hpp"
+#include "viennacl/linalg/host_based/sse_kernels.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Reduces the first nb columns of the trailing symmetric matrix starting at (s, s) to tridiagonal form (cf. LAPACK's xLATRD, lower triangle).
+        *
+        * The full symmetric matrix is stored. Returns the matrix W such that the trailing matrix can be updated via A22 <- A22 - V * W^T - W * V^T,
+        * where V is stored in the panel below the subdiagonal. On return, the subdiagonal entries of the panel hold ones.
+        */
+        template <typename NumericT>
+        void eig_tridiag_panel(viennacl::matrix<NumericT, viennacl::column_major> & A,
+                               std::size_t s, std::size_t nb,
+                               viennacl::matrix<NumericT, viennacl::column_major> & W,
+                               std::vector<NumericT> & d, std::vector<NumericT> & e,
+                               std::vector<NumericT> & tau)
+        {
+          std::size_t lda = A.internal_size1();
+          std::size_t ldw = W.internal_size1();
+          std::size_t nn  = A.size1() - s;
+
+          NumericT * a     = detail::extract_raw_pointer<NumericT>(A) + s + s * lda;
+          NumericT * W_ptr = detail::extract_raw_pointer<NumericT>(W);
+
+          for (std::size_t i = 0; i < nb; ++i)
+          {
+            NumericT * a_col = a + i * lda;
+            NumericT * w_col = W_ptr + i * ldw;
+
+            // update column i with the transformations of the panel so far:
+            svd_gemv(nn-i, i, NumericT(-1), a + i,     lda, W_ptr + i, ldw, NumericT(1), a_col + i, 1);
+            svd_gemv(nn-i, i, NumericT(-1), W_ptr + i, ldw, a + i,     lda, NumericT(1), a_col + i, 1);
+
+            d[s+i] = a_col[i];
+            if (i + 1 == nn)
+            {
+              tau[s+i] = 0;
+              continue;
+            }
+
+            // reflector annihilating A(i+2:nn, i):
+            std::size_t len = nn - i - 1;
+            NumericT * v = a_col + i + 1;
+            tau[s+i] = householder_generate(len, v[0], v + 1, 1);
+            e[s+i] = v[0];
+            v[0] = 1;
+
+            // w = tau * (A22 - V W^T - W V^T) * v, where the first i entries of w_col serve as scratch:
+            svd_gemv_trans(len, len, NumericT(1), a + (i+1) + (i+1) * lda, lda, v, 1, NumericT(0), w_col + i + 1, 1);
+            svd_gemv_trans(len, i,   NumericT(1),  a + i + 1,     lda, v,     1, NumericT(0), w_col,         1);
+            svd_gemv      (len, i,   NumericT(-1), W_ptr + i + 1, ldw, w_col, 1, NumericT(1), w_col + i + 1, 1);
+            svd_gemv_trans(len, i,   NumericT(1),  W_ptr + i + 1, ldw, v,     1, NumericT(0), w_col,         1);
+            svd_gemv      (len, i,   NumericT(-1), a + i + 1,     lda, w_col, 1, NumericT(1), w_col + i + 1, 1);
+
+            NumericT * w = w_col + i + 1;
+            NumericT w_dot_v = 0;
+            for (std::size_t j = 0; j < len; ++j)
+            {
+              w[j] *= tau[s+i];
+              w_dot_v += w[j] * v[j];
+            }
+            NumericT alpha = NumericT(-0.5) * tau[s+i] * w_dot_v;
+            for (std::size_t j = 0; j < len; ++j)
+              w[j] += alpha * v[j];
+          }
+        }
+
+        /** @brief Reduces the symmetric n x n column-major matrix A to tridiagonal form T = Q^T A Q (cf. LAPACK's xSYTRD, lower triangle).
+        *
+        * Reflector j is stored in A(j+2:n, j) with an implicit unit entry in row j+1.
+        */
+        template <typename NumericT>
+        void eig_tridiag(viennacl::matrix<NumericT, viennacl::column_major> & A,
+                         std::vector<NumericT> & d, std::vector<NumericT> & e, std::vector<NumericT> & tau,
+                         std::size_t block_size = 32)
+        {
+          typedef viennacl::matrix<NumericT, viennacl::column_major>   MatrixType;
+
+          std::size_t n = A.size1();
+          viennacl::context ctx(viennacl::MAIN_MEMORY);
+
+          NumericT * data_A = detail::extract_raw_pointer<NumericT>(A);
+          std::size_t lda = A.internal_size1();
+
+          MatrixType W(n, block_size, ctx);
+
+          std::size_t s = 0;
+          for (; n - s > 2 * block_size; s += block_size)
+          {
+            eig_tridiag_panel(A, s, block_size, W, d, e, tau);
+
+            // trailing update A22 <- A22 - V * W^T - W * V^T
+            std::size_t nb = block_size;
+            viennacl::matrix_range<MatrixType> A22(A, viennacl::range(s + nb, n),     viennacl::range(s + nb, n));
+            viennacl::matrix_range<MatrixType> V  (A, viennacl::range(s + nb, n),     viennacl::range(s, s + nb));
+            viennacl::matrix_range<MatrixType> W2 (W, viennacl::range(nb, n - s),     viennacl::range(0, nb));
+
+            viennacl::linalg::host_based::prod_impl(V, viennacl::trans(W2), A22, NumericT(-1), NumericT(1));
+            viennacl::linalg::host_based::prod_impl(W2, viennacl::trans(V), A22, NumericT(-1), NumericT(1));
+
+            // restore the subdiagonal entries overwritten by ones:
+            for (std::size_t j = s; j < s + nb; ++j)
+              data_A[(j+1) + j * lda] = e[j];
+          }
+
+          // remaining columns are reduced in a single panel:
+          std::size_t nb = n - s;
+          if (nb > 0)
+          {
+            MatrixType W_rest(nb, nb, ctx);
+            eig_tridiag_panel(A, s, nb, W_rest, d, e, tau);
+            for (std::size_t j = s; j + 1 < n; ++j)
+              data_A[(j+1) + j * lda] = e[j];
+          }
+        }
+
+        /** @brief Sorts the eigenvalues in d ascendingly and permutes the columns of the column-major matrix Q (if nonzero) accordingly. */
+        template <typename NumericT>
+        void eig_sort(std::size_t n, NumericT * d, NumericT * Q, std::size_t ldq)
+        {
+          for (std::size_t i = 0; i + 1 < n; ++i)
+          {
+            std::size_t k = i;
+            for (std::size_t j = i + 1; j < n; ++j)
+              if (d[j] < d[k])
+                k = j;
+
+            if (k != i)
+            {
+              std::swap(d[i], d[k]);
+              if (Q)
+                for (std::size_t r = 0; r < n; ++r)
+                  std::swap(Q[r + i * ldq], Q[r + k * ldq]);
+            }
+          }
+        }
+
+        /** @brief Computes the eigenvalues of the symmetric tridiagonal matrix with diagonal d and offdiagonal e by the implicit QL method (cf. EISPACK's tql2).
+        *
+        * The rotations are accumulated into the columns of the n x n column-major matrix Q if Q is nonzero, which must be initialized by the caller.
+        * The offdiagonal e holds n entries, where e[i] couples i and i+1 (e[n-1] is ignored), and is destroyed. On return, d holds the eigenvalues in ascending order.
+        * Throws viennacl::numerical_exception if an eigenvalue does not converge within 50 iterations.
+        */
+        template <typename NumericT>
+        void eig_tridiag_ql(std::size_t n, NumericT * d, NumericT * e, NumericT * Q, std::size_t ldq)
+        {
+          if (n == 0)
+            return;
+
+          NumericT const eps = std::numeric_limits<NumericT>::epsilon();
+          std::size_t const max_iter = 50;
+
+          e[n-1] = 0;
+
+          NumericT f = 0;
+          NumericT tst1 = 0;
+          for (std::size_t l = 0; l < n; ++l)
+          {
+            // find small subdiagonal element:
+            tst1 = std::max<NumericT>(tst1, std::fabs(d[l]) + std::fabs(e[l]));
+            std::size_t m = l;
+            while (m < n - 1)
+            {
+              if (std::fabs(e[m]) <= eps * tst1)
+                break;
+              ++m;
+            }
+
+            // if m == l, d[l] is an eigenvalue, otherwise iterate:
+            if (m > l)
+            {
+              std::size_t iter = 0;
+              do
+              {
+                if (iter >= max_iter)
+                  throw viennacl::numerical_exception("Eigenvalues: implicit QL iteration for the tridiagonal matrix did not converge");
+                ++iter;
+
+                // compute implicit shift:
+                NumericT g = d[l];
+                NumericT p = (d[l+1] - g) / (NumericT(2) * e[l]);
+                NumericT r = std::sqrt(p * p + NumericT(1));
+                if (p < 0)
+                  r = -r;
+                d[l]   = e[l] / (p + r);
+                d[l+1] = e[l] * (p + r);
+                NumericT dl1 = d[l+1];
+                NumericT h = g - d[l];
+                for (std::size_t i = l + 2; i < n; ++i)
+                  d[i] -= h;
+                f += h;
+
+                // implicit QL transformation:
+                p = d[m];
+                NumericT c = 1, c2 = 1, c3 = 1;
+                NumericT el1 = e[l+1];
+                NumericT s = 0, s2 = 0;
+                for (std::size_t ii = m; ii > l; --ii)
+                {
+                  std::size_t i = ii - 1;
+                  c3 = c2;
+                  c2 = c;
+                  s2 = s;
+                  g = c * e[i];
+                  h = c * p;
+                  r = std::sqrt(p * p + e[i] * e[i]);
+                  e[i+1] = s * r;
+                  s = e[i] / r;
+                  c = p / r;
+                  p = c * d[i] - s * g;
+                  d[i+1] = h + s * (c * g + s * d[i]);
+
+                  if (Q)
+                  {
+                    NumericT * q0 = Q + i * ldq;
+                    NumericT * q1 = q0 + ldq;
+                    for (std::size_t k = 0; k < n; ++k)
+                    {
+                      h = q1[k];
+                      q1[k] = s * q0[k] + c * h;
+                      q0[k] = c * q0[k] - s * h;
+                    }
+                  }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+              } while (std::fabs(e[l]) > eps * tst1);
+            }
+            d[l] += f;
+            e[l] = 0;
+          }
+
+          eig_sort(n, d, Q, ldq);
+        }
+
+        /** @brief Computes the root with index i of the secular equation 1/rho + sum_j w_j^2 / (dl_j - lambda) = 0 for rho > 0 and ascending dl.
+        *
+        * The root is returned as lambda = dl[origin] + tau with origin being the closer pole, so that the differences dl_j - lambda can be evaluated accurately.
+        * The rational approximation of the two neighboring poles (cf. Bunch, Nielsen, Sorensen and LAPACK's xLAED4) is safeguarded by bisection.
+        */
+        template <typename NumericT>
+        void eig_secular_root(std::size_t k, NumericT const * dl, NumericT const * w, NumericT rho, std::size_t i,
+                              std::size_t & origin, NumericT & tau)
+        {
+          NumericT const eps = std::numeric_limits<NumericT>::epsilon();
+          NumericT rho_inv = NumericT(1) / rho;
+
+          NumericT lo, hi;
+          if (i + 1 < k)
+          {
+            // decide on the closer pole by the sign of the secular function at the midpoint:
+            NumericT mid = (dl[i+1] - dl[i]) / NumericT(2);
+            NumericT f_mid = rho_inv;
+            for (std::size_t j = 0; j < k; ++j)
+              f_mid += w[j] * w[j] / ((dl[j] - dl[i]) - mid);
+
+            if (f_mid >= 0)
+            {
+              origin = i;
+              lo = 0;
+              hi = mid;
+            }
+            else
+            {
+              origin = i + 1;
+              lo = -mid;
+              hi = 0;
+            }
+          }
+          else
+          {
+            NumericT w_norm_squared = 0;
+            for (std::size_t j = 0; j < k; ++j)
+              w_norm_squared += w[j] * w[j];
+            origin = i;
+            lo = 0;
+            hi = rho * w_norm_squared * (NumericT(1) + NumericT(4) * eps);
+          }
+
+          NumericT d_origin = dl[origin];
+          tau = (lo + hi) / NumericT(2);
+          for (std::size_t iter = 0; iter < 100; ++iter)
+          {
+            NumericT psi = 0, dpsi = 0, phi = 0, dphi = 0;
+            for (std::size_t j = 0; j < k; ++j)
+            {
+              NumericT t = w[j] / ((dl[j] - d_origin) - tau);
+              if (j <= i)
+              {
+                psi  += w[j] * t;
+                dpsi += t * t;
+              }
+              else
+              {
+                phi  += w[j] * t;
+                dphi += t * t;
+              }
+            }
+            NumericT f = rho_inv + psi + phi;
+
+            NumericT error_bound = NumericT(8) * (std::fabs(psi) + std::fabs(phi)) + NumericT(2) * rho_inv + NumericT(3) * std::fabs(tau) * (dpsi + dphi);
+            if (std::fabs(f) <= eps * error_bound)
+              break;
+
+            if (f > 0)
+              hi = tau;
+            else
+              lo = tau;
+
+            // fixed weight approximation of the two neighboring poles:
+            NumericT delta_1 = (dl[i] - d_origin) - tau;
+            NumericT step;
+            bool valid_step = false;
+            if (i + 1 < k)
+            {
+              NumericT delta_2 = (dl[i+1] - d_origin) - tau;
+              NumericT c  = f - delta_1 * dpsi - delta_2 * dphi;
+              NumericT s1 = dpsi * delta_1 * delta_1;
+              NumericT s2 = dphi * delta_2 * delta_2;
+
+              // c x^2 + b x + cc = 0 for the step x:
+              NumericT b  = -(c * (delta_1 + delta_2) + s1 + s2);
+              NumericT cc = delta_1 * delta_2 * f;
+              NumericT discriminant = std::max<NumericT>(b * b - NumericT(4) * c * cc, NumericT(0));
+              NumericT q = NumericT(-0.5) * (b + ((b >= 0) ? std::sqrt(discriminant) : -std::sqrt(discriminant)));
+              if (q != 0)
+              {
+                step = cc / q;
+                valid_step = true;
+              }
+            }
+            else
+            {
+              NumericT c = f - delta_1 * dpsi;
+              if (c > 0)
+              {
+                step = delta_1 + dpsi * delta_1 * delta_1 / c;
+                valid_step = true;
+              }
+            }
+
+            NumericT tau_new = valid_step ? tau + step : (lo + hi) / NumericT(2);
+            if (!(tau_new > lo && tau_new < hi))
+              tau_new = (lo + hi) / NumericT(2);
+
+            if (tau_new == tau || hi - lo <= NumericT(2) * eps * std::max(std::fabs(lo), std::fabs(hi)))
+              break;
+            tau = tau_new;
+          }
+        }
+
+        /** @brief Merges the eigendecompositions of two adjacent tridiagonal blocks coupled by the rank-one modification rho * v * v^T (cf. LAPACK's xLAED1).
+        *
+        * On entry, d holds the eigenvalues of the two blocks of size n1 and n - n1, Q holds the block-diagonal matrix of their eigenvectors.
+        * On return, d and Q hold the eigenvalues in ascending order and the eigenvectors of the merged n x n tridiagonal matrix.
+        *
+        * @param rho   The absolute value of the coupling offdiagonal entry
+        * @param sign  The sign of the coupling offdiagonal entry
+        */
+        template <typename NumericT>
+        void eig_dc_merge(std::size_t n, std::size_t n1, NumericT * d, NumericT * Q, std::size_t ldq, NumericT rho, NumericT sign)
+        {
+          typedef viennacl::matrix<NumericT, viennacl::column_major>   MatrixType;
+
+          NumericT const eps = std::numeric_limits<NumericT>::epsilon();
+          viennacl::context ctx(viennacl::MAIN_MEMORY);
+
+          // z = blockdiag(Q1, Q2)^T v, normalized to unit length:
+          NumericT const inv_sqrt2 = NumericT(1) / std::sqrt(NumericT(2));
+          std::vector<NumericT> z(n);
+          for (std::size_t j = 0; j < n; ++j)
+            z[j] = (j < n1) ? Q[(n1 - 1) + j * ldq] * inv_sqrt2 : sign * Q[n1 + j * ldq] * inv_sqrt2;
+          rho *= NumericT(2);
+
+          // sort the poles, remembering the column of Q and whether it is nonzero only in the upper (1), lower (3), or both (2) blocks:
+          std::vector<std::pair<NumericT, std::size_t> > sorted(n);
+          for (std::size_t j = 0; j < n; ++j)
+            sorted[j] = std::make_pair(d[j], j);
+          std::stable_sort(sorted.begin(), sorted.end());
+
+          std::vector<NumericT> ds(n), zs(n);
+          std::vector<std::size_t> col(n), type(n);
+          NumericT d_max = 0, z_max = 0;
+          for (std::size_t j = 0; j < n; ++j)
+          {
+            ds[j]   = sorted[j].first;
+            col[j]  = sorted[j].second;
+            zs[j]   = z[col[j]];
+            type[j] = (col[j] < n1) ? 1 : 3;
+            d_max = std::max(d_max, std::fabs(ds[j]));
+            z_max = std::max(z_max, std::fabs(zs[j]));
+          }
+
+          // deflation of small components of z and of close poles (cf. LAPACK's xLAED2):
+          NumericT tol = NumericT(8) * eps * std::max(d_max, z_max);
+          std::vector<std::size_t> nondeflated, deflated;
+          std::size_t prev = n;
+          for (std::size_t j = 0; j < n; ++j)
+          {
+            if (rho * std::fabs(zs[j]) <= tol)
+            {
+              deflated.push_back(j);
+              continue;
+            }
+            if (prev == n)
+            {
+              prev = j;
+              continue;
+            }
+
+            NumericT s = zs[prev];
+            NumericT c = zs[j];
+            NumericT tau = std::sqrt(c * c + s * s);
+            NumericT t = ds[j] - ds[prev];
+            c /= tau;
+            s = -s / tau;
+            if (std::fabs(t * c * s) <= tol)
+            {
+              // rotate such that zs[prev] vanishes:
+              zs[j] = tau;
+              zs[prev] = 0;
+              svd_apply_givens(Q, ldq, n, col[prev], col[j], c, s);
+              if (type[prev] != type[j])
+              {
+                type[prev] = 2;
+                type[j] = 2;
+              }
+              NumericT temp = ds[prev] * c * c + ds[j] * s * s;
+              ds[j]    = ds[prev] * s * s + ds[j] * c * c;
+              ds[prev] = temp;
+              deflated.push_back(prev);
+            }
+            else
+              nondeflated.push_back(prev);
+            prev = j;
+          }
+          if (prev != n)
+            nondeflated.push_back(prev);
+
+          std::size_t k = nondeflated.size();
+
+          // solve the secular equation for the k nondeflated poles:
+          std::vector<NumericT> dl(k), w(k), lambda_tau(k);
+          std::vector<std::size_t> lambda_origin(k);
+          for (std::size_t i = 0; i < k; ++i)
+          {
+            dl[i] = ds[nondeflated[i]];
+            w[i]  = zs[nondeflated[i]];
+          }
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (k > 64)
+#endif
+          for (std::size_t i = 0; i < k; ++i)
+            eig_secular_root(k, &(dl[0]), &(w[0]), rho, i, lambda_origin[i], lambda_tau[i]);
+
+          // Gu-Eisenstat: recompute z such that the computed roots are exact eigenvalues of diag(dl) + rho * z z^T:
+          std::vector<NumericT> z_hat(k);
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (k > 64)
+#endif
+          for (std::size_t j = 0; j < k; ++j)
+          {
+            NumericT prod = ((dl[lambda_origin[j]] - dl[j]) + lambda_tau[j]) / rho;
+            for (std::size_t i = 0; i < k; ++i)
+              if (i != j)
+                prod *= ((dl[lambda_origin[i]] - dl[j]) + lambda_tau[i]) / (dl[i] - dl[j]);
+            z_hat[j] = (w[j] >= 0) ? std::sqrt(std::fabs(prod)) : -std::sqrt(std::fabs(prod));
+          }
+
+          // eigenvectors of the rank-one modified diagonal matrix:
+          MatrixType U(std::max<std::size_t>(k, 1), std::max<std::size_t>(k, 1), ctx);
+          NumericT * data_U = detail::extract_raw_pointer<NumericT>(U);
+          std::size_t ldu = U.internal_size1();
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (k > 64)
+#endif
+          for (std::size_t i = 0; i < k; ++i)
+          {
+            NumericT * u = data_U + i * ldu;
+            NumericT norm = 0;
+            for (std::size_t j = 0; j < k; ++j)
+            {
+              u[j] = z_hat[j] / ((dl[j] - dl[lambda_origin[i]]) - lambda_tau[i]);
+              norm += u[j] * u[j];
+            }
+            norm = std::sqrt(norm);
+            for (std::size_t j = 0; j < k; ++j)
+              u[j] /= norm;
+          }
+
+          // eigenvectors of the merged matrix, where the products exploit the block structure of Q:
+          MatrixType X(n, std::max<std::size_t>(k, 1), ctx);
+          NumericT * data_X = detail::extract_raw_pointer<NumericT>(X);
+          std::size_t ldx = X.internal_size1();
+          for (std::size_t part = 0; part < 2 && k > 0; ++part)
+          {
+            std::size_t row_start = (part == 0) ? 0  : n1;
+            std::size_t rows      = (part == 0) ? n1 : n - n1;
+            std::size_t excluded_type = (part == 0) ? 3 : 1;
+
+            std::vector<std::size_t> used;
+            for (std::size_t i = 0; i < k; ++i)
+              if (type[nondeflated[i]] != excluded_type)
+                used.push_back(i);
+
+            viennacl::matrix_range<MatrixType> X_part(X, viennacl::range(row_start, row_start + rows), viennacl::range(0, k));
+            if (used.size() == 0)
+            {
+              for (std::size_t i = 0; i < k; ++i)
+                for (std::size_t r = 0; r < rows; ++r)
+                  data_X[(row_start + r) + i * ldx] = 0;
+              continue;
+            }
+
+            MatrixType Q_used(rows, used.size(), ctx);
+            MatrixType U_used(used.size(), k, ctx);
+            NumericT * data_Q_used = detail::extract_raw_pointer<NumericT>(Q_used);
+            NumericT * data_U_used = detail::extract_raw_pointer<NumericT>(U_used);
+            std::size_t ldq_used = Q_used.internal_size1();
+            std::size_t ldu_used = U_used.internal_size1();
+            for (std::size_t c = 0; c < used.size(); ++c)
+            {
+              NumericT const * q = Q + row_start + col[nondeflated[used[c]]] * ldq;
+              for (std::size_t r = 0; r < rows; ++r)
+                data_Q_used[r + c * ldq_used] = q[r];
+              for (std::size_t i = 0; i < k; ++i)
+                data_U_used[c + i * ldu_used] = data_U[used[c] + i * ldu];
+            }
+
+            viennacl::linalg::host_based::prod_impl(Q_used, U_used, X_part, NumericT(1), NumericT(0));
+          }
+
+          // collect all eigenpairs and write them back in ascending order:
+          std::vector<std::pair<NumericT, std::size_t> > eigenpairs;  // index < k: column of X, otherwise deflated entry index - k
+          for (std::size_t i = 0; i < k; ++i)
+            eigenpairs.push_back(std::make_pair(dl[lambda_origin[i]] + lambda_tau[i], i));
+          for (std::size_t j = 0; j < deflated.size(); ++j)
+            eigenpairs.push_back(std::make_pair(ds[deflated[j]], k + j));
+          std::stable_sort(eigenpairs.begin(), eigenpairs.end());
+
+          MatrixType Q_deflated(n, std::max<std::size_t>(deflated.size(), 1), ctx);
+          NumericT * data_Q_deflated = detail::extract_raw_pointer<NumericT>(Q_deflated);
+          std::size_t ldq_deflated = Q_deflated.internal_size1();
+          for (std::size_t j = 0; j < deflated.size(); ++j)
+            for (std::size_t r = 0; r < n; ++r)
+              data_Q_deflated[r + j * ldq_deflated] = Q[r + col[deflated[j]] * ldq];
+
+          for (std::size_t i = 0; i < n; ++i)
+          {
+            d[i] = eigenpairs[i].first;
+            std::size_t index = eigenpairs[i].second;
+            NumericT const * src = (index < k) ? data_X + index * ldx : data_Q_deflated + (index - k) * ldq_deflated;
+            for (std::size_t r = 0; r < n; ++r)
+              Q[r + i * ldq] = src[r];
+          }
+        }
+
+        /** @brief Computes eigenvalues and eigenvectors of the n x n symmetric tridiagonal matrix with diagonal d and offdiagonal e by divide-and-conquer (cf. LAPACK's xSTEDC).
+        *
+        * e[i] couples i and i+1. The eigenvectors are written to the n x n column-major block Q, the eigenvalues in ascending order to d.
+        */
+        template <typename NumericT>
+        void eig_tridiag_dc(std::size_t n, NumericT * d, NumericT const * e, NumericT * Q, std::size_t ldq)
+        {
+          std::size_t const small_size = 32;
+
+          if (n <= small_size)
+          {
+            std::vector<NumericT> e_copy(e, e + n);
+            for (std::size_t j = 0; j < n; ++j)
+              for (std::size_t i = 0; i < n; ++i)
+                Q[i + j * ldq] = (i == j) ? NumericT(1) : NumericT(0);
+            eig_tridiag_ql(n, d, &(e_copy[0]), Q, ldq);
+            return;
+          }
+
+          // split T = blockdiag(T1, T2) + rho * v v^T with v = (0, ..., 0, 1, sign, 0, ..., 0):
+          std::size_t n1 = n / 2;
+          NumericT rho  = std::fabs(e[n1-1]);
+          NumericT sign = (e[n1-1] >= 0) ? NumericT(1) : NumericT(-1);
+          d[n1-1] -= rho;
+          d[n1]   -= rho;
+
+          eig_tridiag_dc(n1,     d,      e,      Q,                   ldq);
+          eig_tridiag_dc(n - n1, d + n1, e + n1, Q + n1 + n1 * ldq,  ldq);
+
+          for (std::size_t j = 0; j < n; ++j)
+          {
+            std::size_t r_start = (j < n1) ? n1 : 0;
+            std::size_t r_end   = (j < n1) ? n  : n1;
+            for (std::size_t r = r_start; r < r_end; ++r)
+              Q[r + j * ldq] = 0;
+          }
+
+          eig_dc_merge(n, n1, d, Q, ldq, rho, sign);
+        }
+
+        /** @brief Wrapper for the divide-and-conquer method, which scales the tridiagonal matrix to avoid over- and underflow. e has n entries, where e[n-1] is ignored. */
+        template <typename NumericT>
+        void eig_tridiag_dc(std::vector<NumericT> & d, std::vector<NumericT> & e, viennacl::matrix<NumericT, viennacl::column_major> & Q)
+        {
+          std::size_t n = d.size();
+          if (n == 0)
+            return;
+
+          NumericT * data_Q = detail::extract_raw_pointer<NumericT>(Q);
+          std::size_t ldq = Q.internal_size1();
+
+          NumericT scale = 0;
+          for (std::size_t i = 0; i < n; ++i)
+          {
+            scale = std::max(scale, std::fabs(d[i]));
+            if (i + 1 < n)
+              scale = std::max(scale, std::fabs(e[i]));
+          }
+          if (scale <= 0)
+            scale = 1;
+
+          for (std::size_t i = 0; i < n; ++i)
+          {
+            d[i] /= scale;
+            e[i] /= scale;
+          }
+
+          eig_tridiag_dc(n, &(d[0]), &(e[0]), data_Q, ldq);
+
+          for (std::size_t i = 0; i < n; ++i)
+            d[i] *= scale;
+        }
+
+      } //namespace detail
+
+
+      /** @brief Computes the eigendecomposition A = Q * diag(D) * Q^T of a symmetric matrix.
+      *
+      * @param A     The symmetric input matrix. Will be overwritten with the diagonal matrix holding the eigenvalues in ascending order
+      * @param Q     The orthogonal matrix holding the eigenvectors in its columns
+      * @param D     The eigenvalues in ascending order
+      */
+      template <typename NumericT, typename F1, typename F2>
+      void eig_sym(matrix_base<NumericT, F1> & A,
+                   matrix_base<NumericT, F2> & Q,
+                   std::vector<NumericT> & D)
+      {
+        typedef viennacl::matrix<NumericT, viennacl::column_major>   MatrixType;
+
+        std::size_t n = viennacl::traits::size1(A);
+        assert(n == viennacl::traits::size2(A) && bool("Input matrix must be square!"));
+        assert(viennacl::traits::size1(Q) == n && viennacl::traits::size2(Q) == n && bool("Size mismatch of eigenvector matrix!"));
+
+        D.resize(n);
+        if (n == 0)
+          return;
+
+        viennacl::context ctx(viennacl::MAIN_MEMORY);
+
+        // work on a column-major copy:
+        MatrixType W(n, n, ctx);
+        MatrixType Z(n, n, ctx);
+        detail::svd_setup_work_matrix(A, W, false);
+
+        std::vector<NumericT> e(n, NumericT(0)), tau(n, NumericT(0));
+        detail::eig_tridiag(W, D, e, tau);
+        detail::eig_tridiag_dc(D, e, Z);
+
+        // back-transformation: rows 1, ..., n-1 of Z are transformed by the reflectors, which are stored in W shifted by one row
+        if (n > 2)
+        {
+          NumericT * data_Z = detail::extract_raw_pointer<NumericT>(Z);
+          std::size_t ldz = Z.internal_size1();
+
+          MatrixType Z_lower(n - 1, n, ctx);
+          NumericT * data_Z_lower = detail::extract_raw_pointer<NumericT>(Z_lower);
+          std::size_t ldz_lower = Z_lower.internal_size1();
+          for (std::size_t j = 0; j < n; ++j)
+            for (std::size_t i = 1; i < n; ++i)
+              data_Z_lower[(i - 1) + j * ldz_lower] = data_Z[i + j * ldz];
+
+          NumericT const * data_W = detail::extract_raw_pointer<NumericT>(W);
+          detail::householder_apply_q(data_W + 1, W.internal_size1(), &(tau[0]), n - 2, Z_lower);
+
+          for (std::size_t j = 0; j < n; ++j)
+            for (std::size_t i = 1; i < n; ++i)
+              data_Z[i + j * ldz] = data_Z_lower[(i - 1) + j * ldz_lower];
+        }
+
+        detail::svd_copy_result(Z, Q);
+
+        // overwrite A with the diagonal matrix of eigenvalues:
+        NumericT * data_A = detail::extract_raw_pointer<NumericT>(A);
+        detail::matrix_array_wrapper<NumericT, typename F1::orientation_category, false>
+          wrapper_A(data_A,
+                    viennacl::traits::start1(A), viennacl::traits::start2(A),
+                    viennacl::traits::stride1(A), viennacl::traits::stride2(A),
+                    viennacl::traits::internal_size1(A), viennacl::traits::internal_size2(A));
+        for (std::size_t j = 0; j < n; ++j)
+          for (std::size_t i = 0; i < n; ++i)
+            wrapper_A(i, j) = (i == j) ? D[i] : NumericT(0);
+      }
+
+      /** @brief Computes the eigenvalues of a symmetric matrix without computing the eigenvectors.
+      *
+      * The tridiagonal reduction is carried out by the OpenMP-parallel inplace_tred2().
+      *
+      * @param A     The symmetric input matrix
+      * @param D     The eigenvalues in ascending order
+      */
+      template <typename NumericT, typename F>
+      void eig_sym(matrix_base<NumericT, F> const & A,
+                   std::vector<NumericT> & D)
+      {
+        std::size_t n = viennacl::traits::size1(A);
+        assert(n == viennacl::traits::size2(A) && bool("Input matrix must be square!"));
+
+        D.resize(n);
+        if (n == 0)
+          return;
+
+        NumericT const * data_A = detail::extract_raw_pointer<NumericT>(A);
+        detail::matrix_array_wrapper<NumericT const, typename F::orientation_category, false>
+          wrapper_A(data_A,
+                    viennacl::traits::start1(A), viennacl::traits::start2(A),
+                    viennacl::traits::stride1(A), viennacl::traits::stride2(A),
+                    viennacl::traits::internal_size1(A), viennacl::traits::internal_size2(A));
+
+        std::vector<NumericT> values(n * n);
+        std::vector<NumericT *> rows(n);
+        bool is_zero = true;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          rows[i] = &(values[i * n]);
+          for (std::size_t j = 0; j < n; ++j)
+          {
+            values[i * n + j] = wrapper_A(i, j);
+            is_zero = is_zero && (values[i * n + j] == NumericT(0));
+          }
+        }
+
+        std::vector<NumericT> e(n, NumericT(0));
+        if (!is_zero)  // inplace_tred2() requires at least one nonzero entry for determining the bandwidth
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          std::size_t num_threads = static_cast<std::size_t>(omp_get_max_threads());
+#else
+          std::size_t num_threads = 1;
+#endif
+          viennacl::linalg::host_based::inplace_tred2(&(rows[0]), n, std::min<std::size_t>(n, std::max<std::size_t>(current_tuning_profile().tred2_block_size, 1)), num_threads);
+
+          for (std::size_t i = 0; i < n; ++i)
+          {
+            D[i] = values[i * n + i];
+            if (i + 1 < n)
+              e[i] = values[i * n + i + 1];
+          }
+        }
+
+        detail::eig_tridiag_ql(n, &(D[0]), &(e[0]), static_cast<NumericT *>(NULL), 0);
+      }
+
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_FUSED_ELEMENTWISE_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_FUSED_ELEMENTWISE_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/fused_elementwise_operations.hpp
+    @brief Evaluation of fused element-wise expressions in a single pass over the operands using a single CPU thread or OpenMP.
+
+    The expression is supplied as a short program of element-wise instructions, which is evaluated for blocks of entries at a time.
+    Intermediate results only occupy block-sized buffers on the stack, so no temporary vectors or matrices are required.
+*/
+
+#include <cmath>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/scheduler/forwards.h"
+#include "viennacl/linalg/detail/op_applier.hpp"
+#include "viennacl/linalg/host_based/tuning_profile.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      /** @brief Operand kinds of an instruction in a fused element-wise program */
+      enum fused_operand_type
+      {
+        FUSED_REGISTER_OPERAND = 0,
+        FUSED_LEAF_OPERAND,
+        FUSED_SCALAR_OPERAND
+      };
+
+      /** @brief A program of element-wise instructions, evaluated in a single pass over all operands.
+      *
+      * Vectors and matrices are traversed as num_lines lines of line_length entries each.
+      * For a vector, there is a single line. For a matrix, the lines are the rows (row-major) or the columns (column-major).
+      */
+      template <typename NumericT>
+      struct fused_elementwise_program
+      {
+        /** @brief Maximum number of block-sized buffers, used for intermediate results and for gathering strided operands */
+        static const std::size_t max_buffers = 16;
+        /** @brief Maximum number of vector or matrix operands */
+        static const std::size_t max_leaves = 32;
+        /** @brief Maximum number of instructions */
+        static const std::size_t max_instructions = 32;
+        /** @brief Number of entries per line processed at once */
+        static const std::size_t block_size = 256;
+
+        /** @brief A vector or matrix operand. Entry j of line l is located at data[offset + l * line_stride + j * stride] */
+        struct leaf
+        {
+          NumericT const * data;
+          std::size_t offset;
+          std::size_t line_stride;
+          std::size_t stride;
+          std::size_t buffer;          //buffer for gathering the entries if stride != 1
+        };
+
+        struct operand
+        {
+          fused_operand_type type;
+          std::size_t        index;    //register or leaf index
+          NumericT           value;    //value of a scalar
+        };
+
+        struct instruction
+        {
+          viennacl::scheduler::operation_node_type op;
+          operand     lhs;
+          operand     rhs;             //unused for unary operations
+          std::size_t result;          //register
+        };
+
+        fused_elementwise_program() : num_leaves(0), num_instructions(0), num_buffers(0), num_lines(0), line_length(0) {}
+
+        leaf         leaves[max_leaves];
+        std::size_t  num_leaves;
+        instruction  instructions[max_instructions];
+        std::size_t  num_instructions;
+        std::size_t  num_buffers;
+
+        // result:
+        NumericT *   result_data;
+        std::size_t  result_offset;
+        std::size_t  result_line_stride;
+        std::size_t  result_stride;
+        std::size_t  result_register;
+        viennacl::scheduler::operation_node_type assign_op;   //one out of {=, +=, -=}
+
+        std::size_t  num_lines;
+        std::size_t  line_length;
+      };
+
+      namespace detail
+      {
+        struct fused_add { template <typename T> static T apply(T x, T y) { return x + y; } };
+        struct fused_sub { template <typename T> static T apply(T x, T y) { return x - y; } };
+        struct fused_mul { template <typename T> static T apply(T x, T y) { return x * y; } };
+        struct fused_div { template <typename T> static T apply(T x, T y) { return x / y; } };
+
+        template <typename OpT, typename NumericT>
+        void fused_binary(NumericT * result, NumericT const * x, NumericT x_value, NumericT const * y, NumericT y_value, std::size_t size)
+        {
+          if (x && y)
+            for (std::size_t i=0; i<size; ++i)
+              result[i] = OpT::apply(x[i], y[i]);
+          else if (x)
+            for (std::size_t i=0; i<size; ++i)
+              result[i] = OpT::apply(x[i], y_value);
+          else if (y)
+            for (std::size_t i=0; i<size; ++i)
+              result[i] = OpT::apply(x_value, y[i]);
+          else
+            std::fill(result, result + size, OpT::apply(x_value, y_value));
+        }
+
+        template <typename OpT, typename NumericT>
+        void fused_unary(NumericT * result, NumericT const * x, std::size_t size)
+        {
+          for (std::size_t i=0; i<size; ++i)
+            viennacl::linalg::detail::op_applier<op_element_unary<OpT> >::apply(result[i], x[i]);
+        }
+
+        /** @brief Evaluates the program for entries [begin, begin + size) of the supplied line */
+        template <typename NumericT>
+        void fused_elementwise_block(fused_elementwise_program<NumericT> const & program, std::size_t line, std::size_t begin, std::size_t size)
+        {
+          typedef fused_elementwise_program<NumericT>  program_type;
+
+          NumericT buffers[program_type::max_buffers * program_type::block_size];
+          NumericT const * leaf_data[program_type::max_leaves];
+
+          for (std::size_t k=0; k<program.num_leaves; ++k)
+          {
+            typename program_type::leaf const & leaf = program.leaves[k];
+            NumericT const * data = leaf.data + leaf.offset + line * leaf.line_stride + begin * leaf.stride;
+            if (leaf.stride == 1)
+              leaf_data[k] = data;
+            else
+            {
+              NumericT * buffer = buffers + leaf.buffer * program_type::block_size;
+              for (std::size_t i=0; i<size; ++i)
+                buffer[i] = data[i * leaf.stride];
+              leaf_data[k] = buffer;
+            }
+          }
+
+          for (std::size_t n=0; n<program.num_instructions; ++n)
+          {
+            typename program_type::instruction const & inst = program.instructions[n];
+            NumericT * result = buffers + inst.result * program_type::block_size;
+
+            NumericT const * x = NULL;
+            NumericT x_value = inst.lhs.value;
+            if (inst.lhs.type == FUSED_REGISTER_OPERAND)
+              x = buffers + inst.lhs.index * program_type::block_size;
+            else if (inst.lhs.type == FUSED_LEAF_OPERAND)
+              x = leaf_data[inst.lhs.index];
+
+            NumericT const * y = NULL;
+            NumericT y_value = inst.rhs.value;
+            if (inst.rhs.type == FUSED_REGISTER_OPERAND)
+              y = buffers + inst.rhs.index * program_type::block_size;
+            else if (inst.rhs.type == FUSED_LEAF_OPERAND)
+              y = leaf_data[inst.rhs.index];
+
+            switch (inst.op)
+            {
+              case viennacl::scheduler::OPERATION_BINARY_ADD_TYPE:          fused_binary<fused_add>(result, x, x_value, y, y_value, size); break;
+              case viennacl::scheduler::OPERATION_BINARY_SUB_TYPE:          fused_binary<fused_sub>(result, x, x_value, y, y_value, size); break;
+              case viennacl::scheduler::OPERATION_BINARY_MULT_TYPE:
+              case viennacl::scheduler::OPERATION_BINARY_ELEMENT_PROD_TYPE: fused_binary<fused_mul>(result, x, x_value, y, y_value, size); break;
+              case viennacl::scheduler::OPERATION_BINARY_DIV_TYPE:
+              case viennacl::scheduler::OPERATION_BINARY_ELEMENT_DIV_TYPE:  fused_binary<fused_div>(result, x, x_value, y, y_value, size); break;
+
+              case viennacl::scheduler::OPERATION_UNARY_ABS_TYPE:   fused_unary<op_abs>  (result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_ACOS_TYPE:  fused_unary<op_acos> (result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_ASIN_TYPE:  fused_unary<op_asin> (result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_ATAN_TYPE:  fused_unary<op_atan> (result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_CEIL_TYPE:  fused_unary<op_ceil> (result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_COS_TYPE:   fused_unary<op_cos>  (result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_COSH_TYPE:  fused_unary<op_cosh> (result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_EXP_TYPE:   fused_unary<op_exp>  (result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_FABS_TYPE:  fused_unary<op_fabs> (result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_FLOOR_TYPE: fused_unary<op_floor>(result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_LOG_TYPE:   fused_unary<op_log>  (result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_LOG10_TYPE: fused_unary<op_log10>(result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_SIN_TYPE:   fused_unary<op_sin>  (result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_SINH_TYPE:  fused_unary<op_sinh> (result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_SQRT_TYPE:  fused_unary<op_sqrt> (result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_TAN_TYPE:   fused_unary<op_tan>  (result, x, size); break;
+              case viennacl::scheduler::OPERATION_UNARY_TANH_TYPE:  fused_unary<op_tanh> (result, x, size); break;
+
+              default:
+                break; //rejected when the program is built
+            }
+          }
+
+          // write back:
+          NumericT const * value = buffers + program.result_register * program_type::block_size;
+          NumericT * result = program.result_data + program.result_offset + line * program.result_line_stride + begin * program.result_stride;
+          std::size_t stride = program.result_stride;
+          if (program.assign_op == viennacl::scheduler::OPERATION_BINARY_INPLACE_ADD_TYPE)
+            for (std::size_t i=0; i<size; ++i)
+              result[i * stride] += value[i];
+          else if (program.assign_op == viennacl::scheduler::OPERATION_BINARY_INPLACE_SUB_TYPE)
+            for (std::size_t i=0; i<size; ++i)
+              result[i * stride] -= value[i];
+          else
+            for (std::size_t i=0; i<size; ++i)
+              result[i * stride] = value[i];
+        }
+      }
+
+      /** @brief Evaluates a fused element-wise program. Blocks of entries are distributed among the threads. */
+      template <typename NumericT>
+      void fused_elementwise(fused_elementwise_program<NumericT> const & program)
+      {
+        std::size_t block_size = fused_elementwise_program<NumericT>::block_size;
+        std::size_t blocks_per_line = (program.line_length + block_size - 1) / block_size;
+        long num_blocks = static_cast<long>(program.num_lines * blocks_per_line);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (program.num_lines * program.line_length > current_tuning_profile().vector_min_size)
+#endif
+        for (long b = 0; b < num_blocks; ++b)
+        {
+          std::size_t line  = static_cast<std::size_t>(b) / blocks_per_line;
+          std::size_t begin = (static_cast<std::size_t>(b) % blocks_per_line) * block_size;
+          detail::fused_elementwise_block(program, line, begin, std::min(block_size, program.line_length - begin));
+        }
+      }
+
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,485 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_HOUSEHOLDER_HPP_
+#define VIENNACL_LINALG_HOST_BASED_HOUSEHOLDER_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/householder.hpp
+    @brief Householder reflectors and compact WY block reflectors (I - V T V^T) for host-based factorizations.
+
+    Block reflectors are applied by matrix-matrix products, so the bulk of the work is carried out by the host GEMM.
+*/
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Generates an elementary reflector H = I - tau * v * v^T such that H * [alpha; x] = [beta; 0] (cf. LAPACK's xLARFG).
+        *
+        * On return, alpha holds beta and x holds v(1:n-1). The first entry of v is one and not stored.
+        *
+        * @param n      Length of the vector [alpha; x]
+        * @param alpha  The first entry of the vector, overwritten with beta
+        * @param x      The remaining n-1 entries, overwritten with the reflector
+        * @param incx   Stride for accessing x
+        * @return The scalar factor tau. A value of zero denotes H = I.
+        */
+        template <typename NumericT>
+        NumericT householder_generate(std::size_t n, NumericT & alpha, NumericT * x, std::size_t incx)
+        {
+          if (n <= 1)
+            return NumericT(0);
+
+          NumericT x_norm = 0;
+          for (std::size_t i=0; i<n-1; ++i)
+            x_norm += x[i*incx] * x[i*incx];
+          x_norm = std::sqrt(x_norm);
+
+          if (x_norm <= NumericT(0))
+            return NumericT(0);
+
+          NumericT beta = std::sqrt(alpha * alpha + x_norm * x_norm);
+          if (alpha >= 0)
+            beta = -beta;
+
+          NumericT tau = (beta - alpha) / beta;
+          NumericT scale = NumericT(1) / (alpha - beta);
+          for (std::size_t i=0; i<n-1; ++i)
+            x[i*incx] *= scale;
+          alpha = beta;
+
+          return tau;
+        }
+
+        /** @brief Computes the upper triangular factor T of the block reflector H_0 * H_1 * ... * H_{k-1} = I - V * T * V^T (cf. LAPACK's xLARFT, forward and columnwise).
+        *
+        * @param V    Matrix holding the k reflectors in its columns, including the unit diagonal and the zeros above
+        * @param tau  The k scalar factors of the reflectors
+        * @param T    The k x k upper triangular factor (output)
+        */
+        template <typename NumericT>
+        void householder_block_factor(viennacl::matrix<NumericT, viennacl::column_major> & V,
+                                      NumericT const * tau,
+                                      viennacl::matrix<NumericT, viennacl::column_major> & T)
+        {
+          std::size_t rows = V.size1();
+          std::size_t k    = V.size2();
+
+          NumericT const * data_V = detail::extract_raw_pointer<NumericT>(V);
+          NumericT       * data_T = detail::extract_raw_pointer<NumericT>(T);
+          std::size_t ldv = V.internal_size1();
+          std::size_t ldt = T.internal_size1();
+
+          std::vector<NumericT> w(k);
+          for (std::size_t i=0; i<k; ++i)
+          {
+            for (std::size_t j=0; j<k; ++j)
+              data_T[j + i * ldt] = 0;
+
+            if (tau[i] == NumericT(0))
+              continue;
+
+            // w = -tau_i * V(:, 0:i)^T * v_i, where v_i is zero above row i:
+            for (std::size_t j=0; j<i; ++j)
+            {
+              NumericT temp = 0;
+              for (std::size_t r=i; r<rows; ++r)
+                temp += data_V[r + j * ldv] * data_V[r + i * ldv];
+              w[j] = -tau[i] * temp;
+            }
+
+            // T(0:i, i) = T(0:i, 0:i) * w:
+            for (std::size_t j=0; j<i; ++j)
+            {
+              NumericT temp = 0;
+              for (std::size_t l=j; l<i; ++l)
+                temp += data_T[j + l * ldt] * w[l];
+              data_T[j + i * ldt] = temp;
+            }
+            data_T[i + i * ldt] = tau[i];
+          }
+        }
+
+        /** @brief Applies the block reflector H = I - V * T * V^T (or its transpose) from the left to C, i.e. C <- H * C or C <- H^T * C.
+        *
+        * Uses three matrix-matrix products, so the work is dominated by the host GEMM.
+        *
+        * @param V           The reflectors (including unit diagonal and zeros above), size m x k
+        * @param T           The k x k upper triangular factor
+        * @param C           The m x n matrix to be updated
+        * @param transposed  If true, H^T is applied instead of H
+        */
+        template <typename NumericT, typename F>
+        void householder_apply_block_left(viennacl::matrix<NumericT, viennacl::column_major> const & V,
+                                          viennacl::matrix<NumericT, viennacl::column_major> const & T,
+                                          viennacl::matrix_base<NumericT, F> & C,
+                                          bool transposed)
+        {
+          if (C.size1() == 0 || C.size2() == 0 || V.size2() == 0)
+            return;
+
+          viennacl::context ctx(viennacl::MAIN_MEMORY);
+          viennacl::matrix<NumericT, viennacl::column_major> W1(V.size2(), C.size2(), ctx);
+          viennacl::matrix<NumericT, viennacl::column_major> W2(V.size2(), C.size2(), ctx);
+
+          viennacl::linalg::host_based::prod_impl(viennacl::trans(V), C, W1, NumericT(1), NumericT(0));
+          if (transposed)
+            viennacl::linalg::host_based::prod_impl(viennacl::trans(T), W1, W2, NumericT(1), NumericT(0));
+          else
+            viennacl::linalg::host_based::prod_impl(T, W1, W2, NumericT(1), NumericT(0));
+          viennacl::linalg::host_based::prod_impl(V, W2, C, NumericT(-1), NumericT(1));
+        }
+
+        /** @brief Copies the reflectors stored below the diagonal of an array with arbitrary row and column distances to V, adding the unit diagonal and the zeros above.
+        *
+        * @param data     Pointer to the diagonal entry of the first reflector
+        * @param inc_row  Distance of consecutive rows in the array
+        * @param inc_col  Distance of consecutive columns in the array
+        * @param V        The rows x k matrix of reflectors (output)
+        */
+        template <typename NumericT>
+        void householder_extract_block(NumericT const * data, std::size_t inc_row, std::size_t inc_col,
+                                       viennacl::matrix<NumericT, viennacl::column_major> & V)
+        {
+          NumericT * data_V = detail::extract_raw_pointer<NumericT>(V);
+          std::size_t ldv = V.internal_size1();
+          for (std::size_t j=0; j<V.size2(); ++j)
+            for (std::size_t i=0; i<V.size1(); ++i)
+            {
+              if (i < j)
+                data_V[i + j * ldv] = 0;
+              else if (i == j)
+                data_V[i + j * ldv] = 1;
+              else
+                data_V[i + j * ldv] = data[i * inc_row + j * inc_col];
+            }
+        }
+
+        /** @brief Copies the reflectors stored below the diagonal of a column-major array to V, adding the unit diagonal and the zeros above.
+        *
+        * @param data   Pointer to the diagonal entry of the first reflector
+        * @param ld     Leading dimension of the array
+        * @param V      The rows x k matrix of reflectors (output)
+        */
+        template <typename NumericT>
+        void householder_extract_block(NumericT const * data, std::size_t ld,
+                                       viennacl::matrix<NumericT, viennacl::column_major> & V)
+        {
+          householder_extract_block(data, 1, ld, V);
+        }
+
+        /** @brief Returns a pointer to the entry (0, 0) of a host matrix or submatrix A and the distances of consecutive rows and columns in memory. */
+        template <typename NumericT, typename F>
+        NumericT * householder_raw_pointer(viennacl::matrix_base<NumericT, F> & A, std::size_t & inc_row, std::size_t & inc_col)
+        {
+          std::size_t is1 = A.internal_size1();
+          std::size_t is2 = A.internal_size2();
+          inc_row = (F::mem_index(1, 0, is1, is2) - F::mem_index(0, 0, is1, is2)) * A.stride1();
+          inc_col = (F::mem_index(0, 1, is1, is2) - F::mem_index(0, 0, is1, is2)) * A.stride2();
+          return detail::extract_raw_pointer<NumericT>(A) + F::mem_index(A.start1(), A.start2(), is1, is2);
+        }
+
+        /** @brief Recursive Householder QR factorization of the columns [col_begin, col_end) of a host panel (cf. LAPACK's xGEQRT3).
+        *
+        * The columns 0, ..., col_begin-1 must already be factored. The reflector of column c starts in row c.
+        * The left half of the columns is factored first, then the right half is updated by a block reflector, so most of the work is carried out by the host GEMM.
+        * Narrow panels are factored column by column, where the update of the remaining columns is distributed over OpenMP threads.
+        * The panel may be of either layout and may be a submatrix of a larger matrix, so that no copies are required.
+        *
+        * @param P          The panel, where R and the reflectors are directly written to
+        * @param col_begin  First column to be factored
+        * @param col_end    One past the last column to be factored
+        * @param tau        The scalar factors of the reflectors, where tau[c] refers to column c (output)
+        */
+        template <typename NumericT, typename F>
+        void householder_panel_factor(viennacl::matrix_base<NumericT, F> & P,
+                                      std::size_t col_begin, std::size_t col_end,
+                                      NumericT * tau)
+        {
+          typedef viennacl::matrix<NumericT, viennacl::column_major>   MatrixType;
+
+          std::size_t m = P.size1();
+          std::size_t k_end = std::min(col_end, m);
+
+          std::size_t inc_row, inc_col;
+          NumericT * data_P = householder_raw_pointer(P, inc_row, inc_col);
+
+          if (k_end - std::min(col_begin, k_end) <= 8)
+          {
+            for (std::size_t i=col_begin; i<k_end; ++i)
+            {
+              NumericT * col_i = data_P + i * inc_row + i * inc_col;
+              tau[i] = householder_generate(m - i, col_i[0], col_i + inc_row, inc_row);
+              if (tau[i] == NumericT(0))
+                continue;
+
+              NumericT tau_i = tau[i];
+#ifdef VIENNACL_WITH_OPENMP
+              #pragma omp parallel for if ((m - i) * (col_end - i) > 5000)
+#endif
+              for (std::size_t l=i+1; l<col_end; ++l)
+              {
+                NumericT * col_l = data_P + i * inc_row + l * inc_col;
+                NumericT temp = col_l[0];
+                for (std::size_t r=1; r<m-i; ++r)
+                  temp += col_i[r * inc_row] * col_l[r * inc_row];
+                temp *= tau_i;
+                col_l[0] -= temp;
+                for (std::size_t r=1; r<m-i; ++r)
+                  col_l[r * inc_row] -= temp * col_i[r * inc_row];
+              }
+            }
+            return;
+          }
+
+          std::size_t col_mid = col_begin + (k_end - col_begin) / 2;
+
+          householder_panel_factor(P, col_begin, col_mid, tau);
+
+          // apply the reflectors of the left half to the right half:
+          std::size_t rows = m - col_begin;
+          std::size_t kb   = col_mid - col_begin;
+          viennacl::context ctx(viennacl::MAIN_MEMORY);
+          MatrixType V(rows, kb, ctx);
+          MatrixType T(kb, kb, ctx);
+          householder_extract_block(data_P + col_begin * inc_row + col_begin * inc_col, inc_row, inc_col, V);
+          householder_block_factor(V, tau + col_begin, T);
+
+          viennacl::matrix_base<NumericT, F> P_right(P.handle(),
+                                                     rows,                P.start1() + col_begin * P.stride1(), P.stride1(), P.internal_size1(),
+                                                     col_end - col_mid,   P.start2() + col_mid   * P.stride2(), P.stride2(), P.internal_size2());
+          householder_apply_block_left(V, T, P_right, true);
+
+          householder_panel_factor(P, col_mid, col_end, tau);
+        }
+
+        /** @brief Blocked Householder QR factorization A = Q * R of a host matrix (cf. LAPACK's xGEQRF).
+        *
+        * Each panel of block_size columns is factored recursively, then the trailing columns are updated by the block reflector I - V T^T V^T.
+        * On return, R is stored in the upper triangle of A, the reflectors are stored below the diagonal as described for householder_form_q().
+        * A may be of either layout and is factored in place.
+        *
+        * @param A           The m x n matrix to be factored
+        * @param tau         The min(m, n) scalar factors of the reflectors (output)
+        * @param block_size  Number of columns per panel
+        */
+        template <typename NumericT, typename F>
+        void householder_qr(viennacl::matrix_base<NumericT, F> & A,
+                            std::vector<NumericT> & tau,
+                            std::size_t block_size = 32)
+        {
+          typedef viennacl::matrix<NumericT, viennacl::column_major>   MatrixType;
+
+          std::size_t m = A.size1();
+          std::size_t n = A.size2();
+          std::size_t k = std::min(m, n);
+          viennacl::context ctx(viennacl::MAIN_MEMORY);
+
+          std::size_t inc_row, inc_col;
+          NumericT * data_A = householder_raw_pointer(A, inc_row, inc_col);
+
+          tau.resize(k);
+
+          for (std::size_t j=0; j<k; j += block_size)
+          {
+            std::size_t kb = std::min(block_size, k - j);
+
+            // factor the panel A(j:m, j:j+kb):
+            householder_panel_factor(A, j, j + kb, &(tau[0]));
+
+            // update the trailing columns:
+            if (j + kb < n)
+            {
+              MatrixType V(m - j, kb, ctx);
+              MatrixType T(kb, kb, ctx);
+
+              householder_extract_block(data_A + j * inc_row + j * inc_col, inc_row, inc_col, V);
+              householder_block_factor(V, &(tau[j]), T);
+
+              viennacl::matrix_base<NumericT, F> A_trailing(A.handle(),
+                                                            m - j,       A.start1() + j        * A.stride1(), A.stride1(), A.internal_size1(),
+                                                            n - j - kb,  A.start2() + (j + kb) * A.stride2(), A.stride2(), A.internal_size2());
+              householder_apply_block_left(V, T, A_trailing, true);
+            }
+          }
+        }
+
+        /** @brief Explicitly forms Q = H_0 * H_1 * ... * H_{k-1} from reflectors stored below the diagonal of a column-major array (cf. LAPACK's xORGQR).
+        *
+        * If Q has fewer columns than rows, only the leading columns of the product are formed (thin Q).
+        * Reflector j has an implicit unit entry in row j and is stored in rows j+1, ..., dim-1 of column j.
+        * The reflectors are accumulated backwards in blocks of size block_size, applying each block as I - V T V^T.
+        *
+        * @param data_V      Pointer to the column-major array holding the reflectors
+        * @param ldv         Leading dimension of the array
+        * @param tau         The k scalar factors of the reflectors
+        * @param k           Number of reflectors
+        * @param Q           The dim x ncols output matrix, where k <= ncols <= dim
+        * @param block_size  Number of reflectors per block
+        */
+        template <typename NumericT>
+        void householder_form_q(NumericT const * data_V, std::size_t ldv,
+                                NumericT const * tau, std::size_t k,
+                                viennacl::matrix<NumericT, viennacl::column_major> & Q,
+                                std::size_t block_size = 32)
+        {
+          typedef viennacl::matrix<NumericT, viennacl::column_major>   MatrixType;
+
+          std::size_t dim   = Q.size1();
+          std::size_t ncols = Q.size2();
+          viennacl::context ctx(viennacl::MAIN_MEMORY);
+
+          assert(k <= ncols && ncols <= dim && bool("Invalid number of columns of Q"));
+
+          NumericT * data_Q = detail::extract_raw_pointer<NumericT>(Q);
+          std::size_t ldq = Q.internal_size1();
+          for (std::size_t j=0; j<ncols; ++j)
+            for (std::size_t i=0; i<dim; ++i)
+              data_Q[i + j * ldq] = (i == j) ? NumericT(1) : NumericT(0);
+
+          if (k == 0)
+            return;
+
+          for (std::size_t block_start = ((k - 1) / block_size) * block_size; ; block_start -= block_size)
+          {
+            std::size_t kb   = std::min(block_size, k - block_start);
+            std::size_t rows = dim - block_start;
+
+            MatrixType V(rows, kb, ctx);
+            MatrixType T(kb, kb, ctx);
+
+            householder_extract_block(data_V + block_start + block_start * ldv, ldv, V);
+
+            householder_block_factor(V, tau + block_start, T);
+
+            // the columns 0, ..., block_start-1 of the trailing rows are still zero due to the backward accumulation:
+            viennacl::matrix_range<MatrixType> Q_sub(Q, viennacl::range(block_start, dim), viennacl::range(block_start, ncols));
+            householder_apply_block_left(V, T, Q_sub, false);
+
+            if (block_start == 0)
+              break;
+          }
+        }
+
+        /** @brief Computes C <- Q * C for Q = H_0 * H_1 * ... * H_{k-1} given by reflectors stored below the diagonal of a column-major array (cf. LAPACK's xORMQR).
+        *
+        * The reflectors are stored as described for householder_form_q(). Blocks of reflectors are applied backwards as I - V T V^T.
+        *
+        * @param data_V      Pointer to the column-major array holding the reflectors
+        * @param ldv         Leading dimension of the array
+        * @param tau         The k scalar factors of the reflectors
+        * @param k           Number of reflectors
+        * @param C           The matrix to be updated. Its number of rows must not be smaller than the length of the reflectors.
+        * @param block_size  Number of reflectors per block
+        */
+        template <typename NumericT, typename F>
+        void householder_apply_q(NumericT const * data_V, std::size_t ldv,
+                                 NumericT const * tau, std::size_t k,
+                                 viennacl::matrix<NumericT, F> & C,
+                                 std::size_t block_size = 32)
+        {
+          typedef viennacl::matrix<NumericT, viennacl::column_major>   MatrixType;
+
+          std::size_t dim = C.size1();
+          viennacl::context ctx(viennacl::MAIN_MEMORY);
+
+          if (k == 0 || C.size2() == 0)
+            return;
+
+          for (std::size_t block_start = ((k - 1) / block_size) * block_size; ; block_start -= block_size)
+          {
+            std::size_t kb   = std::min(block_size, k - block_start);
+            std::size_t rows = dim - block_start;
+
+            MatrixType V(rows, kb, ctx);
+            MatrixType T(kb, kb, ctx);
+
+            householder_extract_block(data_V + block_start + block_start * ldv, ldv, V);
+
+            householder_block_factor(V, tau + block_start, T);
+
+            viennacl::matrix_range<viennacl::matrix<NumericT, F> > C_sub(C, viennacl::range(block_start, dim), viennacl::range(0, C.size2()));
+            householder_apply_block_left(V, T, C_sub, false);
+
+            if (block_start == 0)
+              break;
+          }
+        }
+
+        /** @brief Computes C <- Q^T * C for Q = H_0 * H_1 * ... * H_{k-1} given by reflectors stored below the diagonal of a column-major array.
+        *
+        * The reflectors are stored as described for householder_form_q(). Blocks of reflectors are applied forwards as I - V T^T V^T.
+        *
+        * @param data_V      Pointer to the column-major array holding the reflectors
+        * @param ldv         Leading dimension of the array
+        * @param tau         The k scalar factors of the reflectors
+        * @param k           Number of reflectors
+        * @param C           The matrix to be updated. Its number of rows must not be smaller than the length of the reflectors.
+        * @param block_size  Number of reflectors per block
+        */
+        template <typename NumericT, typename F>
+        void householder_apply_qt(NumericT const * data_V, std::size_t ldv,
+                                  NumericT const * tau, std::size_t k,
+                                  viennacl::matrix<NumericT, F> & C,
+                                  std::size_t block_size = 32)
+        {
+          typedef viennacl::matrix<NumericT, viennacl::column_major>   MatrixType;
+
+          std::size_t dim = C.size1();
+          viennacl::context ctx(viennacl::MAIN_MEMORY);
+
+          if (C.size2() == 0)
+            return;
+
+          for (std::size_t block_start = 0; block_start < k; block_start += block_size)
+          {
+            std::size_t kb   = std::min(block_size, k - block_start);
+            std::size_t rows = dim - block_start;
+
+            MatrixType V(rows, kb, ctx);
+            MatrixType T(kb, kb, ctx);
+
+            householder_extract_block(data_V + block_start + block_start * ldv, ldv, V);
+            householder_block_factor(V, tau + block_start, T);
+
+            viennacl::matrix_range<viennacl::matrix<NumericT, F> > C_sub(C, viennacl::range(block_start, dim), viennacl::range(0, C.size2()));
+            householder_apply_block_left(V, T, C_sub, true);
+          }
+        }
+
+      } //namespace detail
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
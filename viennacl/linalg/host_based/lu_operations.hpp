@@ -0,0 +1,169 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_LU_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_LU_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/lu_operations.hpp
+    @brief Implementations of the blocked LU factorization with optional partial pivoting using a single CPU thread or OpenMP.
+
+    The factorization is right-looking: Each panel of columns is factorized in place, then the block row of U is obtained from a triangular solve
+    and the trailing matrix is updated by a matrix-matrix product. The matrix is accessed directly in its own memory layout, no intermediate buffers are used.
+*/
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/tuning_profile.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
+#include "viennacl/linalg/host_based/direct_solve.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Factorizes the panel of columns [col_start, col_start + block_size) of the m x n matrix A with optional partial pivoting.
+        *
+        * Row interchanges are applied to the full rows of A. Entry (i, j) of A is located at A[i * inc_row + j * inc_col].
+        *
+        * @param permutation   The permutation vector to be updated. No pivoting is carried out if permutation is NULL.
+        */
+        template <typename NumericT>
+        void lu_panel_factorize(NumericT * A, std::size_t inc_row, std::size_t inc_col,
+                                std::size_t m, std::size_t n,
+                                std::size_t col_start, std::size_t block_size,
+                                std::size_t * permutation)
+        {
+          std::size_t col_end = col_start + block_size;
+
+          for (std::size_t k = col_start; k < col_end; ++k)
+          {
+            // find pivot and exchange rows if necessary:
+            if (permutation)
+            {
+              std::size_t p = k;
+              NumericT pivot_abs = std::fabs(A[k * inc_row + k * inc_col]);
+              for (std::size_t i = k + 1; i < m; ++i)
+              {
+                NumericT value_abs = std::fabs(A[i * inc_row + k * inc_col]);
+                if (value_abs > pivot_abs)
+                {
+                  p = i;
+                  pivot_abs = value_abs;
+                }
+              }
+
+              if (p != k)
+              {
+                for (std::size_t j = 0; j < n; ++j)
+                  std::swap(A[k * inc_row + j * inc_col], A[p * inc_row + j * inc_col]);
+                std::swap(permutation[k], permutation[p]);
+              }
+            }
+
+            NumericT pivot = A[k * inc_row + k * inc_col];
+            if (pivot == NumericT(0))  // singular matrix, leave column as is
+              continue;
+
+            // compute column of L and update the remaining columns of the panel:
+            NumericT const * row_k = A + k * inc_row;
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp parallel for if ((m - k) * (col_end - k) > 5000)
+#endif
+            for (std::size_t row = k + 1; row < m; ++row)
+            {
+              NumericT * row_i = A + row * inc_row;
+              NumericT l_ik = row_i[k * inc_col] / pivot;
+              row_i[k * inc_col] = l_ik;
+              for (std::size_t j = k + 1; j < col_end; ++j)
+                row_i[j * inc_col] -= l_ik * row_k[j * inc_col];
+            }
+          }
+        }
+      } //namespace detail
+
+
+      /** @brief Computes the LU factorization P * A = L * U of a dense m x n matrix, where L is unit lower triangular.
+      *
+      * @param A            The matrix, where the LU factors are directly written to. The implicit unit diagonal of L is not written.
+      * @param permutation  Array of size m for the permutation, where row i of L * U corresponds to row permutation[i] of A. No pivoting is carried out if permutation is NULL.
+      * @param block_size   Number of columns per panel. If zero, the panel width of the tuning profile is used.
+      */
+      template <typename NumericT, typename F>
+      void lu_factorize(viennacl::matrix<NumericT, F> & A, std::size_t * permutation = NULL, std::size_t block_size = 0)
+      {
+        typedef viennacl::matrix<NumericT, F>   MatrixType;
+
+        if (block_size == 0)
+          block_size = std::max<std::size_t>(current_tuning_profile().lu_block_size, 1);
+
+        std::size_t m = A.size1();
+        std::size_t n = A.size2();
+        std::size_t k_max = std::min(m, n);
+
+        NumericT * data_A = detail::extract_raw_pointer<NumericT>(A);
+        std::size_t inc_row = F::mem_index(1, 0, A.internal_size1(), A.internal_size2()) - F::mem_index(0, 0, A.internal_size1(), A.internal_size2());
+        std::size_t inc_col = F::mem_index(0, 1, A.internal_size1(), A.internal_size2()) - F::mem_index(0, 0, A.internal_size1(), A.internal_size2());
+
+        if (permutation)
+          for (std::size_t i = 0; i < m; ++i)
+            permutation[i] = i;
+
+        for (std::size_t col_start = 0; col_start < k_max; col_start += block_size)
+        {
+          std::size_t current_block_size = std::min(block_size, k_max - col_start);
+          std::size_t col_end = col_start + current_block_size;
+
+          detail::lu_panel_factorize(data_A, inc_row, inc_col, m, n, col_start, current_block_size, permutation);
+
+          if (col_end < n)
+          {
+            viennacl::range     block_range(col_start, col_end);
+            viennacl::range remainder_cols(col_end, n);
+            viennacl::range remainder_rows(col_end, m);
+
+            // U_12 = L_11^{-1} A_12
+            viennacl::matrix_range<MatrixType> L_11(A, block_range, block_range);
+            viennacl::matrix_range<MatrixType> A_12(A, block_range, remainder_cols);
+            viennacl::linalg::host_based::inplace_solve(L_11, A_12, viennacl::linalg::unit_lower_tag());
+
+            // A_22 <- A_22 - L_21 * U_12
+            if (col_end < m)
+            {
+              viennacl::matrix_range<MatrixType> L_21(A, remainder_rows, block_range);
+              viennacl::matrix_range<MatrixType> A_22(A, remainder_rows, remainder_cols);
+              viennacl::linalg::host_based::prod_impl(L_21, A_12, A_22, NumericT(-1), NumericT(1));
+            }
+          }
+        }
+      }
+
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -36,6 +36,7 @@
 #include "viennacl/traits/stride.hpp"
 #include "viennacl/linalg/detail/op_applier.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/tuning_profile.hpp"
 
 namespace viennacl
 {
@@ -866,23 +867,59 @@ namespace viennacl
 
       namespace detail
       {
+        /** @brief Computes C = alpha * A * B + beta * C tile by tile.
+        *
+        * Each tile of C is accumulated in a buffer, while A and B are traversed in blocks of the same size, which keep all operands in cache.
+        * The tile size is taken from the tuning profile. The rows of tiles are distributed among the threads.
+        */
         template <typename A, typename B, typename C, typename NumericT>
         void prod(A & a, B & b, C & c,
                   std::size_t C_size1, std::size_t C_size2, std::size_t A_size2,
                   NumericT alpha, NumericT beta)
         {
-          for (std::size_t i=0; i<C_size1; ++i)
+          std::size_t block_size = std::max<std::size_t>(current_tuning_profile().gemm_block_size, 1);
+          long num_blocks1 = static_cast<long>((C_size1 + block_size - 1) / block_size);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long block1 = 0; block1 < num_blocks1; ++block1)
           {
-            for (std::size_t j=0; j<C_size2; ++j)
+            std::vector<NumericT> buffer(block_size * block_size);
+
+            std::size_t i_start = static_cast<std::size_t>(block1) * block_size;
+            std::size_t i_end   = std::min(i_start + block_size, C_size1);
+            for (std::size_t j_start = 0; j_start < C_size2; j_start += block_size)
             {
-              NumericT temp = 0;
-              for (std::size_t k=0; k<A_size2; ++k)
-                temp += a(i, k) * b(k, j);
-
-              temp *= alpha;
-              if (beta != 0)
-                temp += beta * c(i,j);
-              c(i,j) = temp;
+              std::size_t j_end = std::min(j_start + block_size, C_size2);
+              std::fill(buffer.begin(), buffer.end(), NumericT(0));
+
+              for (std::size_t k_start = 0; k_start < A_size2; k_start += block_size)
+              {
+                std::size_t k_end = std::min(k_start + block_size, A_size2);
+                for (std::size_t i = i_start; i < i_end; ++i)
+                {
+                  NumericT * buffer_row = &(buffer[(i - i_start) * block_size]);
+                  for (std::size_t k = k_start; k < k_end; ++k)
+                  {
+                    NumericT a_ik = a(i, k);
+                    for (std::size_t j = j_start; j < j_end; ++j)
+                      buffer_row[j - j_start] += a_ik * b(k, j);
+                  }
+                }
+              }
+
+              for (std::size_t i = i_start; i < i_end; ++i)
+              {
+                NumericT const * buffer_row = &(buffer[(i - i_start) * block_size]);
+                for (std::size_t j = j_start; j < j_end; ++j)
+                {
+                  NumericT temp = alpha * buffer_row[j - j_start];
+                  if (beta != 0)
+                    temp += beta * c(i,j);
+                  c(i,j) = temp;
+                }
+              }
             }
           }
         }
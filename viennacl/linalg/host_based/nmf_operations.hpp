@@ -0,0 +1,116 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_NMF_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_NMF_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/nmf_operations.hpp
+    @brief Implementations of the element-wise operations used by the nonnegative matrix factorization, using a plain single-threaded or OpenMP-enabled execution on CPU.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+
+      /** @brief Multiplicative update A = A .* B ./ C (MATLAB syntax). Entries with a denominator below 1e-5 are set to zero.
+      *
+      * @param A   The matrix to be updated
+      * @param B   The numerator
+      * @param C   The denominator
+      */
+      template <typename NumericT, typename F>
+      void el_wise_mul_div(matrix_base<NumericT, F> & A,
+                           matrix_base<NumericT, F> const & B,
+                           matrix_base<NumericT, F> const & C)
+      {
+        typedef NumericT        value_type;
+
+        value_type       * data_A = detail::extract_raw_pointer<value_type>(A);
+        value_type const * data_B = detail::extract_raw_pointer<value_type>(B);
+        value_type const * data_C = detail::extract_raw_pointer<value_type>(C);
+
+        std::size_t A_start1 = viennacl::traits::start1(A);
+        std::size_t A_start2 = viennacl::traits::start2(A);
+        std::size_t A_inc1   = viennacl::traits::stride1(A);
+        std::size_t A_inc2   = viennacl::traits::stride2(A);
+        std::size_t A_size1  = viennacl::traits::size1(A);
+        std::size_t A_size2  = viennacl::traits::size2(A);
+        std::size_t A_internal_size1  = viennacl::traits::internal_size1(A);
+        std::size_t A_internal_size2  = viennacl::traits::internal_size2(A);
+
+        std::size_t B_start1 = viennacl::traits::start1(B);
+        std::size_t B_start2 = viennacl::traits::start2(B);
+        std::size_t B_inc1   = viennacl::traits::stride1(B);
+        std::size_t B_inc2   = viennacl::traits::stride2(B);
+        std::size_t B_internal_size1  = viennacl::traits::internal_size1(B);
+        std::size_t B_internal_size2  = viennacl::traits::internal_size2(B);
+
+        std::size_t C_start1 = viennacl::traits::start1(C);
+        std::size_t C_start2 = viennacl::traits::start2(C);
+        std::size_t C_inc1   = viennacl::traits::stride1(C);
+        std::size_t C_inc2   = viennacl::traits::stride2(C);
+        std::size_t C_internal_size1  = viennacl::traits::internal_size1(C);
+        std::size_t C_internal_size2  = viennacl::traits::internal_size2(C);
+
+        detail::matrix_array_wrapper<value_type,       typename F::orientation_category, false> wrapper_A(data_A, A_start1, A_start2, A_inc1, A_inc2, A_internal_size1, A_internal_size2);
+        detail::matrix_array_wrapper<value_type const, typename F::orientation_category, false> wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
+        detail::matrix_array_wrapper<value_type const, typename F::orientation_category, false> wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
+
+        value_type const threshold = static_cast<value_type>(0.00001);
+
+        if (detail::is_row_major(typename F::orientation_category()))
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (std::size_t row = 0; row < A_size1; ++row)
+            for (std::size_t col = 0; col < A_size2; ++col)
+            {
+              value_type divisor = wrapper_C(row, col);
+              wrapper_A(row, col) = (divisor > threshold) ? wrapper_A(row, col) * wrapper_B(row, col) / divisor : 0;
+            }
+        }
+        else
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (std::size_t col = 0; col < A_size2; ++col)
+            for (std::size_t row = 0; row < A_size1; ++row)
+            {
+              value_type divisor = wrapper_C(row, col);
+              wrapper_A(row, col) = (divisor > threshold) ? wrapper_A(row, col) * wrapper_B(row, col) / divisor : 0;
+            }
+        }
+      }
+
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_RANDOM_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_RANDOM_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/random_operations.hpp
+    @brief Implementations of random number generation for vectors and matrices using a single CPU thread or OpenMP.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/rand/utils.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Provides (i, j)-access to a vector, which is treated as a column vector */
+        template <typename NumericT>
+        class random_vector_wrapper
+        {
+          public:
+            random_vector_wrapper(NumericT * data, std::size_t start, std::size_t inc) : data_(data), start_(start), inc_(inc) {}
+
+            NumericT & operator()(std::size_t i, std::size_t /*j*/) { return data_[start_ + i * inc_]; }
+
+          private:
+            NumericT * data_;
+            std::size_t start_;
+            std::size_t inc_;
+        };
+
+        /** @brief Fills the size1 x size2 object accessed through wrapper with random numbers.
+        *
+        * Uniform numbers are mapped to [p1, p2), normally distributed numbers to mean p1 and standard deviation p2.
+        * Entry (i, j) receives the value with index i * size2 + j of the random stream defined by the seed.
+        */
+        template <typename NumericT, typename WrapperT>
+        void random_fill(WrapperT & wrapper, std::size_t size1, std::size_t size2,
+                         bool gaussian, NumericT p1, NumericT p2, unsigned int seed)
+        {
+          std::size_t values_per_block = viennacl::rand::detail::philox_values_per_block<NumericT>::value;
+          std::size_t total            = size1 * size2;
+          std::size_t num_blocks       = (total + values_per_block - 1) / values_per_block;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (num_blocks > 1000)
+#endif
+          for (std::size_t block = 0; block < num_blocks; ++block)
+          {
+            NumericT values[4];
+            viennacl::rand::detail::philox_block(block, seed, gaussian, values);
+
+            for (std::size_t v = 0; v < values_per_block; ++v)
+            {
+              std::size_t k = block * values_per_block + v;
+              if (k < total)
+                wrapper(k / size2, k % size2) = gaussian ? p1 + p2 * values[v]
+                                                         : p1 + (p2 - p1) * values[v];
+            }
+          }
+        }
+
+        template <typename NumericT>
+        void random_fill(vector_base<NumericT> & vec, bool gaussian, NumericT p1, NumericT p2, unsigned int seed)
+        {
+          random_vector_wrapper<NumericT> wrapper(detail::extract_raw_pointer<NumericT>(vec), viennacl::traits::start(vec), viennacl::traits::stride(vec));
+          random_fill(wrapper, viennacl::traits::size(vec), 1, gaussian, p1, p2, seed);
+        }
+
+        template <typename NumericT, typename F>
+        void random_fill(matrix_base<NumericT, F> & mat, bool gaussian, NumericT p1, NumericT p2, unsigned int seed)
+        {
+          matrix_array_wrapper<NumericT, typename F::orientation_category, false>
+            wrapper(detail::extract_raw_pointer<NumericT>(mat),
+                    viennacl::traits::start1(mat),         viennacl::traits::start2(mat),
+                    viennacl::traits::stride1(mat),        viennacl::traits::stride2(mat),
+                    viennacl::traits::internal_size1(mat), viennacl::traits::internal_size2(mat));
+          random_fill(wrapper, viennacl::traits::size1(mat), viennacl::traits::size2(mat), gaussian, p1, p2, seed);
+        }
+      }
+
+      /** @brief Fills the vector or matrix with uniformly distributed random numbers in [a, b)
+      *
+      * @param obj   The vector or matrix to be filled
+      * @param a     Lower bound of the interval
+      * @param b     Upper bound of the interval
+      * @param seed  Seed (key) of the random stream
+      */
+      template <typename ObjectT, typename NumericT>
+      void random_uniform(ObjectT & obj, NumericT a, NumericT b, unsigned int seed)
+      {
+        detail::random_fill(obj, false, a, b, seed);
+      }
+
+      /** @brief Fills the vector or matrix with normally distributed random numbers
+      *
+      * @param obj    The vector or matrix to be filled
+      * @param mu     Mean of the distribution
+      * @param sigma  Standard deviation of the distribution
+      * @param seed   Seed (key) of the random stream
+      */
+      template <typename ObjectT, typename NumericT>
+      void random_gaussian(ObjectT & obj, NumericT mu, NumericT sigma, unsigned int seed)
+      {
+        detail::random_fill(obj, true, mu, sigma, seed);
+      }
+
+    } // namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -154,6 +154,29 @@ namespace viennacl
       }
 
 
+      /** @brief Computes s1 = s2 / s3, where s1 is set to zero if s3 is zero
+      *
+      * @param s1   The result scalar
+      * @param s2   The numerator
+      * @param s3   The denominator
+      */
+      template <typename S1, typename S2, typename S3>
+      typename viennacl::enable_if<    viennacl::is_scalar<S1>::value
+                                    && viennacl::is_scalar<S2>::value
+                                    && viennacl::is_scalar<S3>::value
+                                  >::type
+      safe_div(S1 & s1, S2 const & s2, S3 const & s3)
+      {
+        typedef typename viennacl::result_of::cpu_value_type<S1>::type        value_type;
+
+        value_type       * data_s1 = detail::extract_raw_pointer<value_type>(s1);
+        value_type const * data_s2 = detail::extract_raw_pointer<value_type>(s2);
+        value_type const * data_s3 = detail::extract_raw_pointer<value_type>(s3);
+
+        *data_s1 = (*data_s3 != 0) ? *data_s2 / *data_s3 : 0;
+      }
+
+
 
     } //namespace host_based
   } //namespace linalg
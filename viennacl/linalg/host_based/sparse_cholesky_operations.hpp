@@ -0,0 +1,388 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_SPARSE_CHOLESKY_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_SPARSE_CHOLESKY_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/sparse_cholesky_operations.hpp
+    @brief Numeric supernodal sparse Cholesky factorization and triangular solves using a single CPU thread or OpenMP.
+
+    The factorization is left-looking: Each supernode gathers the dense updates from its descendants, then its panel is factorized.
+    Supernodes on the same level of the supernodal elimination tree are independent and processed in parallel.
+    For levels with only a single supernode (i.e. the top separators), the dense kernels are parallelized instead.
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/linalg/detail/sparse_cholesky/symbolic.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Symmetric rank-k update of the lower trapezoidal part of a column-major matrix: C(i, c) -= sum_k A(i, k) * A(c, k) for c < ncols and c <= i < nrows.
+        *
+        * @param A       Column-major matrix with nrows rows and kdim columns
+        * @param lda     Leading dimension of A
+        * @param C       Column-major matrix with nrows rows and ncols columns
+        * @param ldc     Leading dimension of C
+        */
+        template <typename NumericT>
+        void sparse_cholesky_rank_update(NumericT const * A, std::size_t lda, std::size_t nrows, std::size_t kdim,
+                                         NumericT * C, std::size_t ldc, std::size_t ncols)
+        {
+          std::size_t const col_block = 4;   //columns of C updated per sweep over a column of A
+          std::size_t const row_block = 256; //rows of C kept in cache while looping over the columns of A
+
+          long num_col_blocks = static_cast<long>((ncols + col_block - 1) / col_block);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for schedule(dynamic) if (double(nrows) * double(ncols) * double(kdim) > 1e6)
+#endif
+          for (long cb = 0; cb < num_col_blocks; ++cb)
+          {
+            std::size_t c0 = static_cast<std::size_t>(cb) * col_block;
+            std::size_t nc = std::min(col_block, ncols - c0);
+
+            NumericT * C0 = C + c0 * ldc;
+            NumericT * C1 = C0 + ldc;
+            NumericT * C2 = C1 + ldc;
+            NumericT * C3 = C2 + ldc;
+
+            // triangular head:
+            for (std::size_t k=0; k<kdim; ++k)
+            {
+              NumericT const * a = A + k * lda;
+              for (std::size_t i = c0; i < std::min(c0 + nc, nrows); ++i)
+                for (std::size_t c = c0; c <= i; ++c)
+                  C[i + c * ldc] -= a[i] * a[c];
+            }
+
+            if (nc < col_block) //remainder columns
+            {
+              for (std::size_t k=0; k<kdim; ++k)
+              {
+                NumericT const * a = A + k * lda;
+                for (std::size_t c = c0; c < c0 + nc; ++c)
+                {
+                  NumericT a_c = a[c];
+                  NumericT * C_c = C + c * ldc;
+                  for (std::size_t i = c0 + nc; i < nrows; ++i)
+                    C_c[i] -= a[i] * a_c;
+                }
+              }
+              continue;
+            }
+
+            for (std::size_t i_start = c0 + col_block; i_start < nrows; i_start += row_block)
+            {
+              std::size_t i_end = std::min(i_start + row_block, nrows);
+              for (std::size_t k=0; k<kdim; ++k)
+              {
+                NumericT const * a = A + k * lda;
+                NumericT a0 = a[c0];
+                NumericT a1 = a[c0 + 1];
+                NumericT a2 = a[c0 + 2];
+                NumericT a3 = a[c0 + 3];
+                for (std::size_t i = i_start; i < i_end; ++i)
+                {
+                  NumericT a_i = a[i];
+                  C0[i] -= a_i * a0;
+                  C1[i] -= a_i * a1;
+                  C2[i] -= a_i * a2;
+                  C3[i] -= a_i * a3;
+                }
+              }
+            }
+          }
+        }
+
+        /** @brief Computes the Cholesky factorization of the diagonal block of a column-major supernode panel and the triangular solve for the rows below in place.
+        *
+        * @param L       Column-major panel with m rows and w columns, leading dimension m
+        * @return false if the diagonal block is not positive definite
+        */
+        template <typename NumericT>
+        bool sparse_cholesky_factor_panel(NumericT * L, std::size_t m, std::size_t w)
+        {
+          std::size_t const block_size = 32;
+
+          for (std::size_t jb = 0; jb < w; jb += block_size)
+          {
+            std::size_t je = std::min(jb + block_size, w);
+
+            // left-looking update of the block columns with all previous columns:
+            sparse_cholesky_rank_update(L + jb, m, m - jb, jb, L + jb + jb * m, m, je - jb);
+
+            // unblocked factorization of the block columns:
+            for (std::size_t j = jb; j < je; ++j)
+            {
+              NumericT * L_j = L + j * m;
+              for (std::size_t k = jb; k < j; ++k)
+              {
+                NumericT const * L_k = L + k * m;
+                NumericT l_jk = L_k[j];
+                for (std::size_t i = j; i < m; ++i)
+                  L_j[i] -= L_k[i] * l_jk;
+              }
+
+              if (L_j[j] <= NumericT(0))
+                return false;
+
+              NumericT l_jj = std::sqrt(L_j[j]);
+              L_j[j] = l_jj;
+              for (std::size_t i = j + 1; i < m; ++i)
+                L_j[i] /= l_jj;
+            }
+          }
+
+          return true;
+        }
+
+        /** @brief Assembles and factorizes a single supernode.
+        *
+        * @param symbolic   The symbolic factorization
+        * @param s          Index of the supernode
+        * @param elements   Values of the system matrix
+        * @param L          Values of the factor
+        * @param map        Workspace of the size of the system, used for local row indices
+        * @param buffer     Workspace for the dense update blocks
+        */
+        template <typename NumericT>
+        bool sparse_cholesky_factor_supernode(viennacl::linalg::detail::sparse_cholesky_symbolic const & symbolic, std::size_t s,
+                                              NumericT const * elements, NumericT * L,
+                                              std::vector<unsigned int> & map, std::vector<NumericT> & buffer)
+        {
+          std::size_t first = symbolic.super_begin[s];
+          std::size_t last  = symbolic.super_begin[s+1];
+          std::size_t rows  = symbolic.row_offsets[s+1] - symbolic.row_offsets[s];
+          unsigned int const * row_indices = &(symbolic.row_indices[0]) + symbolic.row_offsets[s];
+          NumericT * panel = L + symbolic.value_offsets[s];
+
+          std::fill(panel, panel + rows * (last - first), NumericT(0));
+          for (std::size_t k = symbolic.a_map_offsets[s]; k < symbolic.a_map_offsets[s+1]; ++k)
+            L[symbolic.a_map_dst[k]] = elements[symbolic.a_map_src[k]];
+
+          for (std::size_t r=0; r<rows; ++r)
+            map[row_indices[r]] = static_cast<unsigned int>(r);
+
+          // gather updates from descendants:
+          for (std::size_t u = symbolic.update_offsets[s]; u < symbolic.update_offsets[s+1]; ++u)
+          {
+            std::size_t source = symbolic.update_sources[u];
+            std::size_t source_width = symbolic.super_begin[source+1] - symbolic.super_begin[source];
+            std::size_t source_rows  = symbolic.row_offsets[source+1] - symbolic.row_offsets[source];
+            unsigned int const * source_row_indices = &(symbolic.row_indices[0]) + symbolic.row_offsets[source];
+
+            std::size_t row_begin = symbolic.update_rows[u];
+            std::size_t row_end = row_begin;
+            while (row_end < source_rows && source_row_indices[row_end] < last)
+              ++row_end;
+
+            std::size_t nr = source_rows - row_begin;
+            std::size_t nc = row_end - row_begin;
+            std::fill(buffer.begin(), buffer.begin() + static_cast<long>(nr * nc), NumericT(0));
+            sparse_cholesky_rank_update(L + symbolic.value_offsets[source] + row_begin, source_rows, nr, source_width,
+                                        &(buffer[0]), nr, nc);
+
+            // buffer holds the negative update, add to the panel:
+            for (std::size_t c=0; c<nc; ++c)
+            {
+              NumericT * panel_col = panel + (source_row_indices[row_begin + c] - first) * rows;
+              NumericT const * buffer_col = &(buffer[0]) + c * nr;
+              for (std::size_t i=c; i<nr; ++i)
+                panel_col[map[source_row_indices[row_begin + i]]] += buffer_col[i];
+            }
+          }
+
+          return sparse_cholesky_factor_panel(panel, rows, last - first);
+        }
+      }
+
+      /** @brief Computes the numeric supernodal Cholesky factorization for a given symbolic factorization.
+      *
+      * @param symbolic   The symbolic factorization
+      * @param elements   The values of the system matrix in CSR format, as the analysis was carried out for
+      * @param L          The values of the factor (output)
+      * @return false if the matrix is not positive definite
+      */
+      template <typename NumericT>
+      bool sparse_cholesky_factorize(viennacl::linalg::detail::sparse_cholesky_symbolic const & symbolic,
+                                     NumericT const * elements,
+                                     std::vector<NumericT> & L)
+      {
+        L.resize(symbolic.value_offsets.back());
+
+#ifdef VIENNACL_WITH_OPENMP
+        std::size_t num_threads = static_cast<std::size_t>(omp_get_max_threads());
+#else
+        std::size_t num_threads = 1;
+#endif
+        std::vector< std::vector<unsigned int> > maps(num_threads);
+        std::vector< std::vector<NumericT> >     buffers(num_threads);
+        maps[0].resize(symbolic.size);
+        buffers[0].resize(std::max<std::size_t>(symbolic.max_update_size, 1));
+
+        for (std::size_t level = 0; level + 1 < symbolic.level_offsets.size(); ++level)
+        {
+          std::size_t level_begin = symbolic.level_offsets[level];
+          long level_size = static_cast<long>(symbolic.level_offsets[level+1] - level_begin);
+          long failures = 0;
+
+          if (level_size > 1)
+          {
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp parallel for schedule(dynamic) reduction(+: failures)
+#endif
+            for (long i = 0; i < level_size; ++i)
+            {
+#ifdef VIENNACL_WITH_OPENMP
+              std::size_t thread_id = static_cast<std::size_t>(omp_get_thread_num());
+#else
+              std::size_t thread_id = 0;
+#endif
+              if (maps[thread_id].size() == 0) //each thread allocates its own workspace once
+              {
+                maps[thread_id].resize(symbolic.size);
+                buffers[thread_id].resize(std::max<std::size_t>(symbolic.max_update_size, 1));
+              }
+
+              if (!detail::sparse_cholesky_factor_supernode(symbolic, symbolic.level_supernodes[level_begin + static_cast<std::size_t>(i)],
+                                                            elements, &(L[0]), maps[thread_id], buffers[thread_id]))
+                ++failures;
+            }
+          }
+          else if (!detail::sparse_cholesky_factor_supernode(symbolic, symbolic.level_supernodes[level_begin], elements, &(L[0]), maps[0], buffers[0]))
+            ++failures;
+
+          if (failures > 0)
+            return false;
+        }
+
+        return true;
+      }
+
+      /** @brief Solves L L^T x = b in place for a supernodal Cholesky factor. Vector entries refer to the permuted system.
+      *
+      * Both substitutions gather contributions from previously computed entries only, so supernodes on the same level are processed in parallel.
+      */
+      template <typename NumericT>
+      void sparse_cholesky_solve(viennacl::linalg::detail::sparse_cholesky_symbolic const & symbolic,
+                                 std::vector<NumericT> const & L,
+                                 std::vector<NumericT> & x)
+      {
+        std::size_t num_levels = symbolic.level_offsets.size() - 1;
+
+        // forward substitution L y = b, leaves first:
+        for (std::size_t level = 0; level < num_levels; ++level)
+        {
+          std::size_t level_begin = symbolic.level_offsets[level];
+          long level_size = static_cast<long>(symbolic.level_offsets[level+1] - level_begin);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for schedule(dynamic, 16) if (level_size > 16)
+#endif
+          for (long l = 0; l < level_size; ++l)
+          {
+            std::size_t s = symbolic.level_supernodes[level_begin + static_cast<std::size_t>(l)];
+            std::size_t first = symbolic.super_begin[s];
+            std::size_t width = symbolic.super_begin[s+1] - first;
+            std::size_t rows  = symbolic.row_offsets[s+1] - symbolic.row_offsets[s];
+            NumericT const * panel = &(L[0]) + symbolic.value_offsets[s];
+
+            for (std::size_t u = symbolic.update_offsets[s]; u < symbolic.update_offsets[s+1]; ++u)
+            {
+              std::size_t source = symbolic.update_sources[u];
+              std::size_t source_first = symbolic.super_begin[source];
+              std::size_t source_width = symbolic.super_begin[source+1] - source_first;
+              std::size_t source_rows  = symbolic.row_offsets[source+1] - symbolic.row_offsets[source];
+              unsigned int const * source_row_indices = &(symbolic.row_indices[0]) + symbolic.row_offsets[source];
+              NumericT const * source_panel = &(L[0]) + symbolic.value_offsets[source];
+
+              std::size_t row_begin = symbolic.update_rows[u];
+              std::size_t row_end = row_begin;
+              while (row_end < source_rows && source_row_indices[row_end] < first + width)
+                ++row_end;
+
+              // the target entries belong to this supernode only, so the columns of the source panel are traversed contiguously:
+              for (std::size_t k=0; k<source_width; ++k)
+              {
+                NumericT const * source_col = source_panel + k * source_rows;
+                NumericT x_k = x[source_first + k];
+                for (std::size_t r = row_begin; r < row_end; ++r)
+                  x[source_row_indices[r]] -= source_col[r] * x_k;
+              }
+            }
+
+            for (std::size_t j=0; j<width; ++j)
+            {
+              NumericT const * panel_col = panel + j * rows;
+              NumericT x_j = x[first + j] / panel_col[j];
+              x[first + j] = x_j;
+              for (std::size_t i=j+1; i<width; ++i)
+                x[first + i] -= panel_col[i] * x_j;
+            }
+          }
+        }
+
+        // backward substitution L^T x = y, root first:
+        for (std::size_t level = num_levels; level > 0; --level)
+        {
+          std::size_t level_begin = symbolic.level_offsets[level-1];
+          long level_size = static_cast<long>(symbolic.level_offsets[level] - level_begin);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for schedule(dynamic, 16) if (level_size > 16)
+#endif
+          for (long l = 0; l < level_size; ++l)
+          {
+            std::size_t s = symbolic.level_supernodes[level_begin + static_cast<std::size_t>(l)];
+            std::size_t first = symbolic.super_begin[s];
+            std::size_t width = symbolic.super_begin[s+1] - first;
+            std::size_t rows  = symbolic.row_offsets[s+1] - symbolic.row_offsets[s];
+            unsigned int const * row_indices = &(symbolic.row_indices[0]) + symbolic.row_offsets[s];
+            NumericT const * panel = &(L[0]) + symbolic.value_offsets[s];
+
+            for (std::size_t j = width; j > 0; --j)
+            {
+              NumericT const * panel_col = panel + (j-1) * rows;
+              NumericT sum = x[first + j - 1];
+              for (std::size_t r = j; r < rows; ++r)
+                sum -= panel_col[r] * x[row_indices[r]];
+              x[first + j - 1] = sum / panel_col[j-1];
+            }
+          }
+        }
+      }
+
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
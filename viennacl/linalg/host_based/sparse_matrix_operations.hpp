@@ -23,6 +23,7 @@
 */
 
 #include <list>
+#include <vector>
 
 #include "viennacl/forwards.h"
 #include "viennacl/scalar.hpp"
@@ -30,6 +31,11 @@
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
 #include "viennacl/linalg/host_based/vector_operations.hpp"
+#include "viennacl/linalg/host_based/tuning_profile.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
 
 namespace viennacl
 {
@@ -37,12 +43,212 @@ namespace viennacl
   {
     namespace host_based
     {
+      //
+      // Sparse matrix - dense matrix products
+      //
+
+      namespace detail
+      {
+        /** @brief Raw access to a dense matrix or its transpose within sparse matrix - dense matrix products: Entry (i, j) is located at data[i * row_inc + j * col_inc] */
+        template <typename NumericT>
+        struct dense_matrix_access
+        {
+          template <typename T, typename F>
+          dense_matrix_access(NumericT * ptr, viennacl::matrix_base<T, F> const & mat, bool transposed)
+          {
+            std::size_t inc1, inc2;
+            if (is_row_major(typename F::orientation_category()))
+            {
+              data = ptr + mat.start1() * mat.internal_size2() + mat.start2();
+              inc1 = mat.stride1() * mat.internal_size2();
+              inc2 = mat.stride2();
+            }
+            else
+            {
+              data = ptr + mat.start1() + mat.start2() * mat.internal_size1();
+              inc1 = mat.stride1();
+              inc2 = mat.stride2() * mat.internal_size1();
+            }
+            row_inc = transposed ? inc2 : inc1;
+            col_inc = transposed ? inc1 : inc2;
+          }
+
+          NumericT * data;
+          std::size_t row_inc;
+          std::size_t col_inc;
+        };
+
+        /** @brief Rows of a sparse matrix given by an ELL part and a CSR part, either of which may be empty. Covers all sparse formats in sparse matrix - dense matrix products.
+        *
+        * Entry k of the ELL part of row i is located at offset i + k * ell_inc, the CSR part uses column indices csr_cols[k * csr_col_inc].
+        */
+        template <typename ScalarType>
+        struct sparse_rows
+        {
+          sparse_rows() : ell_elements(NULL), ell_cols(NULL), ell_width(0), ell_inc(0),
+                          csr_elements(NULL), csr_cols(NULL), csr_col_inc(1), csr_row_buffer(NULL) {}
+
+          /** @brief Work estimate for the rows 0, ..., row-1, used for distributing the rows among the threads */
+          std::size_t work(std::size_t row) const { return row * (1 + ell_width) + (csr_row_buffer ? csr_row_buffer[row] : 0); }
+
+          ScalarType   const * ell_elements;
+          unsigned int const * ell_cols;
+          std::size_t          ell_width;
+          std::size_t          ell_inc;
+
+          ScalarType   const * csr_elements;
+          unsigned int const * csr_cols;
+          std::size_t          csr_col_inc;
+          unsigned int const * csr_row_buffer;
+        };
+
+        /** @brief Computes the entries j_begin, ..., j_begin + width - 1 of a row of C = A * B.
+        *
+        * The accumulators for a full tile of TileWidth columns are kept in registers. For a unit column increment of B (row-major B), the updates of the accumulators are contiguous and vectorized by the compiler.
+        */
+        template <std::size_t TileWidth, bool FullTile, bool UnitColInc, typename ScalarType, typename NumericT>
+        void prod_sparse_dense_tile(sparse_rows<ScalarType> const & A, std::size_t row,
+                                    dense_matrix_access<NumericT const> const & B,
+                                    dense_matrix_access<NumericT> const & C,
+                                    std::size_t j_begin, std::size_t width)
+        {
+          std::size_t const num_cols  = FullTile ? TileWidth : width;
+          std::size_t const b_col_inc = UnitColInc ? 1 : B.col_inc;
+          NumericT const * B_tile = B.data + j_begin * b_col_inc;
+
+          NumericT acc[TileWidth];
+          for (std::size_t t = 0; t < TileWidth; ++t)
+            acc[t] = 0;
+
+          for (std::size_t k = 0; k < A.ell_width; ++k)
+          {
+            std::size_t offset = row + k * A.ell_inc;
+            NumericT a = static_cast<NumericT>(A.ell_elements[offset]);
+            if (a != 0) //skip padding
+            {
+              NumericT const * b = B_tile + A.ell_cols[offset] * B.row_inc;
+              for (std::size_t t = 0; t < num_cols; ++t)
+                acc[t] += a * b[t * b_col_inc];
+            }
+          }
+
+          if (A.csr_row_buffer)
+          {
+            std::size_t row_end = A.csr_row_buffer[row + 1];
+            for (std::size_t k = A.csr_row_buffer[row]; k < row_end; ++k)
+            {
+              NumericT a = static_cast<NumericT>(A.csr_elements[k]);
+              NumericT const * b = B_tile + A.csr_cols[k * A.csr_col_inc] * B.row_inc;
+              for (std::size_t t = 0; t < num_cols; ++t)
+                acc[t] += a * b[t * b_col_inc];
+            }
+          }
+
+          NumericT * c = C.data + row * C.row_inc + j_begin * C.col_inc;
+          for (std::size_t t = 0; t < num_cols; ++t)
+            c[t * C.col_inc] = acc[t];
+        }
+
+        template <std::size_t TileWidth, bool UnitColInc, typename ScalarType, typename NumericT>
+        void prod_sparse_dense_rows(sparse_rows<ScalarType> const & A, std::size_t row_begin, std::size_t row_end,
+                                    dense_matrix_access<NumericT const> const & B,
+                                    dense_matrix_access<NumericT> const & C,
+                                    std::size_t num_cols)
+        {
+          std::size_t full_cols = num_cols - num_cols % TileWidth;
+          if (UnitColInc) // rows of B are contiguous: all tiles of a row at once
+          {
+            for (std::size_t row = row_begin; row < row_end; ++row)
+            {
+              for (std::size_t j = 0; j < full_cols; j += TileWidth)
+                prod_sparse_dense_tile<TileWidth, true, UnitColInc>(A, row, B, C, j, TileWidth);
+              if (full_cols < num_cols)
+                prod_sparse_dense_tile<TileWidth, false, UnitColInc>(A, row, B, C, full_cols, num_cols - full_cols);
+            }
+          }
+          else // columns of B are contiguous: keep the columns of a tile in cache while processing all rows
+          {
+            for (std::size_t j = 0; j < full_cols; j += TileWidth)
+              for (std::size_t row = row_begin; row < row_end; ++row)
+                prod_sparse_dense_tile<TileWidth, true, UnitColInc>(A, row, B, C, j, TileWidth);
+            if (full_cols < num_cols)
+              for (std::size_t row = row_begin; row < row_end; ++row)
+                prod_sparse_dense_tile<TileWidth, false, UnitColInc>(A, row, B, C, full_cols, num_cols - full_cols);
+          }
+        }
+
+        /** @brief Returns the first row of part 'part' out of 'num_parts' parts of the rows with about equal work */
+        template <typename ScalarType>
+        std::size_t balanced_row_split(sparse_rows<ScalarType> const & A, std::size_t num_rows, std::size_t part, std::size_t num_parts)
+        {
+          std::size_t target = (A.work(num_rows) * part) / num_parts;
+          std::size_t lower = 0, upper = num_rows;  //binary search for the first row with work(row) >= target
+          while (lower < upper)
+          {
+            std::size_t mid = (lower + upper) / 2;
+            if (A.work(mid) < target)
+              lower = mid + 1;
+            else
+              upper = mid;
+          }
+          return lower;
+        }
+
+        /** @brief Computes C = A * B for a sparse matrix A with num_rows rows and a dense matrix (or transposed dense matrix) B with num_cols columns.
+        *
+        * The rows of C are distributed among the threads such that each thread processes about the same number of nonzeros.
+        * The columns of C are processed in tiles of 8 columns for row-major B, and in tiles of 4 columns for column-major B, where each tile is computed for all rows before moving on to the next.
+        */
+        template <typename ScalarType, typename NumericT>
+        void prod_sparse_dense(sparse_rows<ScalarType> const & A, std::size_t num_rows,
+                               dense_matrix_access<NumericT const> const & B,
+                               dense_matrix_access<NumericT> const & C,
+                               std::size_t num_cols)
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel
+#endif
+          {
+            std::size_t part = 0, num_parts = 1;
+#ifdef VIENNACL_WITH_OPENMP
+            part      = static_cast<std::size_t>(omp_get_thread_num());
+            num_parts = static_cast<std::size_t>(omp_get_num_threads());
+#endif
+            std::size_t row_begin = balanced_row_split(A, num_rows, part,     num_parts);
+            std::size_t row_end   = balanced_row_split(A, num_rows, part + 1, num_parts);
+
+            if (B.col_inc == 1)
+              prod_sparse_dense_rows<8, true >(A, row_begin, row_end, B, C, num_cols);
+            else
+              prod_sparse_dense_rows<4, false>(A, row_begin, row_end, B, C, num_cols);
+          }
+        }
+      }
+
+
       //
       // Compressed matrix
       //
 
       namespace detail
       {
+        /** @brief Returns the number of rows per OpenMP work item of a sparse matrix-vector product, cf. tuning_profile::spmv_chunk_size */
+        inline long spmv_chunk_size(std::size_t num_rows)
+        {
+          std::size_t chunk_size = current_tuning_profile().spmv_chunk_size;
+#ifdef VIENNACL_WITH_OPENMP
+          if (chunk_size == 0)
+          {
+            std::size_t num_threads = static_cast<std::size_t>(omp_get_max_threads());
+            chunk_size = (num_rows + num_threads - 1) / num_threads;
+          }
+#else
+          if (chunk_size == 0)
+            chunk_size = num_rows;
+#endif
+          return static_cast<long>(std::max<std::size_t>(chunk_size, 1));
+        }
+
         template<typename ScalarType, unsigned int MAT_ALIGNMENT>
         void row_info(compressed_matrix<ScalarType, MAT_ALIGNMENT> const & mat,
                       vector_base<ScalarType> & vec,
@@ -116,7 +322,8 @@ namespace viennacl
         unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle2());
 
 #ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
+        long chunk_size = detail::spmv_chunk_size(mat.size1());
+        #pragma omp parallel for schedule(dynamic, chunk_size)
 #endif
         for (std::size_t row = 0; row < mat.size1(); ++row)
         {
@@ -140,67 +347,17 @@ namespace viennacl
       template< class ScalarType, typename NumericT, unsigned int ALIGNMENT, typename F>
       void prod_impl(const viennacl::compressed_matrix<ScalarType, ALIGNMENT> & sp_mat,
                      const viennacl::matrix_base<NumericT, F> & d_mat,
-                           viennacl::matrix_base<NumericT, F> & result) {
-
-        ScalarType   const * sp_mat_elements   = detail::extract_raw_pointer<ScalarType>(sp_mat.handle());
-        unsigned int const * sp_mat_row_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle1());
-        unsigned int const * sp_mat_col_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
-
-        NumericT const * d_mat_data = detail::extract_raw_pointer<NumericT>(d_mat);
-        NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
-
-        std::size_t d_mat_start1 = viennacl::traits::start1(d_mat);
-        std::size_t d_mat_start2 = viennacl::traits::start2(d_mat);
-        std::size_t d_mat_inc1   = viennacl::traits::stride1(d_mat);
-        std::size_t d_mat_inc2   = viennacl::traits::stride2(d_mat);
-        std::size_t d_mat_internal_size1  = viennacl::traits::internal_size1(d_mat);
-        std::size_t d_mat_internal_size2  = viennacl::traits::internal_size2(d_mat);
-
-        std::size_t result_start1 = viennacl::traits::start1(result);
-        std::size_t result_start2 = viennacl::traits::start2(result);
-        std::size_t result_inc1   = viennacl::traits::stride1(result);
-        std::size_t result_inc2   = viennacl::traits::stride2(result);
-        std::size_t result_internal_size1  = viennacl::traits::internal_size1(result);
-        std::size_t result_internal_size2  = viennacl::traits::internal_size2(result);
-
-        detail::matrix_array_wrapper<NumericT const, typename F::orientation_category, false>
-            d_mat_wrapper(d_mat_data, d_mat_start1, d_mat_start2, d_mat_inc1, d_mat_inc2, d_mat_internal_size1, d_mat_internal_size2);
-        detail::matrix_array_wrapper<NumericT,       typename F::orientation_category, false>
-            result_wrapper(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
-
-        if ( detail::is_row_major(typename F::orientation_category()) ) {
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t row = 0; row < sp_mat.size1(); ++row) {
-            std::size_t row_start = sp_mat_row_buffer[row];
-            std::size_t row_end = sp_mat_row_buffer[row+1];
-            for (std::size_t col = 0; col < d_mat.size2(); ++col) {
-              NumericT temp = 0;
-              for (std::size_t k = row_start; k < row_end; ++k) {
-                temp += sp_mat_elements[k] * d_mat_wrapper(sp_mat_col_buffer[k], col);
-              }
-              result_wrapper(row, col) = temp;
-            }
-          }
-        }
-        else {
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t col = 0; col < d_mat.size2(); ++col) {
-            for (std::size_t row = 0; row < sp_mat.size1(); ++row) {
-              std::size_t row_start = sp_mat_row_buffer[row];
-              std::size_t row_end = sp_mat_row_buffer[row+1];
-              NumericT temp = 0;
-              for (std::size_t k = row_start; k < row_end; ++k) {
-                temp += sp_mat_elements[k] * d_mat_wrapper(sp_mat_col_buffer[k], col);
-              }
-              result_wrapper(row, col) = temp;
-            }
-          }
-        }
+                           viennacl::matrix_base<NumericT, F> & result)
+      {
+        detail::sparse_rows<ScalarType> A;
+        A.csr_elements   = detail::extract_raw_pointer<ScalarType>(sp_mat.handle());
+        A.csr_cols       = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
+        A.csr_row_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle1());
+
+        detail::dense_matrix_access<NumericT const> B(detail::extract_raw_pointer<NumericT>(d_mat), d_mat, false);
+        detail::dense_matrix_access<NumericT>       C(detail::extract_raw_pointer<NumericT>(result), result, false);
 
+        detail::prod_sparse_dense(A, sp_mat.size1(), B, C, result.size2());
       }
 
       /** @brief Carries out matrix-trans(matrix) multiplication first matrix being compressed
@@ -217,67 +374,17 @@ namespace viennacl
                 const viennacl::matrix_expression< const viennacl::matrix_base<NumericT, F>,
                                                    const viennacl::matrix_base<NumericT, F>,
                                                    viennacl::op_trans > & d_mat,
-                      viennacl::matrix_base<NumericT, F> & result) {
-
-        ScalarType   const * sp_mat_elements   = detail::extract_raw_pointer<ScalarType>(sp_mat.handle());
-        unsigned int const * sp_mat_row_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle1());
-        unsigned int const * sp_mat_col_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
-
-        NumericT const * d_mat_data = detail::extract_raw_pointer<NumericT>(d_mat.lhs());
-        NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
-
-        std::size_t d_mat_start1 = viennacl::traits::start1(d_mat.lhs());
-        std::size_t d_mat_start2 = viennacl::traits::start2(d_mat.lhs());
-        std::size_t d_mat_inc1   = viennacl::traits::stride1(d_mat.lhs());
-        std::size_t d_mat_inc2   = viennacl::traits::stride2(d_mat.lhs());
-        std::size_t d_mat_internal_size1  = viennacl::traits::internal_size1(d_mat.lhs());
-        std::size_t d_mat_internal_size2  = viennacl::traits::internal_size2(d_mat.lhs());
-
-        std::size_t result_start1 = viennacl::traits::start1(result);
-        std::size_t result_start2 = viennacl::traits::start2(result);
-        std::size_t result_inc1   = viennacl::traits::stride1(result);
-        std::size_t result_inc2   = viennacl::traits::stride2(result);
-        std::size_t result_internal_size1  = viennacl::traits::internal_size1(result);
-        std::size_t result_internal_size2  = viennacl::traits::internal_size2(result);
-
-        detail::matrix_array_wrapper<NumericT const, typename F::orientation_category, false>
-            d_mat_wrapper(d_mat_data, d_mat_start1, d_mat_start2, d_mat_inc1, d_mat_inc2, d_mat_internal_size1, d_mat_internal_size2);
-        detail::matrix_array_wrapper<NumericT,       typename F::orientation_category, false>
-            result_wrapper(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
-
-        if ( detail::is_row_major(typename F::orientation_category()) ) {
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t row = 0; row < sp_mat.size1(); ++row) {
-            std::size_t row_start = sp_mat_row_buffer[row];
-            std::size_t row_end = sp_mat_row_buffer[row+1];
-            for (std::size_t col = 0; col < d_mat.size2(); ++col) {
-              NumericT temp = 0;
-              for (std::size_t k = row_start; k < row_end; ++k) {
-                temp += sp_mat_elements[k] * d_mat_wrapper(col, sp_mat_col_buffer[k]);
-              }
-              result_wrapper(row, col) = temp;
-            }
-          }
-        }
-        else {
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t col = 0; col < d_mat.size2(); ++col) {
-            for (std::size_t row = 0; row < sp_mat.size1(); ++row) {
-              std::size_t row_start = sp_mat_row_buffer[row];
-              std::size_t row_end = sp_mat_row_buffer[row+1];
-              NumericT temp = 0;
-              for (std::size_t k = row_start; k < row_end; ++k) {
-                temp += sp_mat_elements[k] * d_mat_wrapper(col, sp_mat_col_buffer[k]);
-              }
-              result_wrapper(row, col) = temp;
-            }
-          }
-        }
+                      viennacl::matrix_base<NumericT, F> & result)
+      {
+        detail::sparse_rows<ScalarType> A;
+        A.csr_elements   = detail::extract_raw_pointer<ScalarType>(sp_mat.handle());
+        A.csr_cols       = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
+        A.csr_row_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle1());
+
+        detail::dense_matrix_access<NumericT const> B(detail::extract_raw_pointer<NumericT>(d_mat.lhs()), d_mat.lhs(), true);
+        detail::dense_matrix_access<NumericT>       C(detail::extract_raw_pointer<NumericT>(result), result, false);
 
+        detail::prod_sparse_dense(A, sp_mat.size1(), B, C, result.size2());
       }
 
 
@@ -884,6 +991,147 @@ namespace viennacl
 
 
 
+      //
+      // Symmetric Compressed Matrix
+      //
+
+      namespace detail
+      {
+        template<typename ScalarType>
+        void row_info(symmetric_compressed_matrix<ScalarType> const & mat,
+                      vector_base<ScalarType> & vec,
+                      viennacl::linalg::detail::row_info_types info_selector)
+        {
+          ScalarType         * result_buf = detail::extract_raw_pointer<ScalarType>(vec.handle());
+          ScalarType   const * elements   = detail::extract_raw_pointer<ScalarType>(mat.handle());
+          unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle1());
+          unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle2());
+
+          for (std::size_t row = 0; row < mat.size1(); ++row)
+            result_buf[row] = 0;
+
+          // each stored entry contributes to its row and (if off-diagonal) to the row given by its column index:
+          for (std::size_t row = 0; row < mat.size1(); ++row)
+          {
+            unsigned int row_end = row_buffer[row+1];
+            for (unsigned int i = row_buffer[row]; i < row_end; ++i)
+            {
+              std::size_t col = col_buffer[i];
+              ScalarType value = elements[i];
+
+              switch (info_selector)
+              {
+                case viennacl::linalg::detail::SPARSE_ROW_NORM_INF: //inf-norm
+                  result_buf[row] = std::max<ScalarType>(result_buf[row], std::fabs(value));
+                  if (col != row)
+                    result_buf[col] = std::max<ScalarType>(result_buf[col], std::fabs(value));
+                  break;
+
+                case viennacl::linalg::detail::SPARSE_ROW_NORM_1: //1-norm
+                  result_buf[row] += std::fabs(value);
+                  if (col != row)
+                    result_buf[col] += std::fabs(value);
+                  break;
+
+                case viennacl::linalg::detail::SPARSE_ROW_NORM_2: //2-norm
+                  result_buf[row] += value * value;
+                  if (col != row)
+                    result_buf[col] += value * value;
+                  break;
+
+                case viennacl::linalg::detail::SPARSE_ROW_DIAGONAL: //diagonal entry
+                  if (col == row)
+                    result_buf[row] = value;
+                  break;
+
+                default:
+                  break;
+              }
+            }
+          }
+
+          if (info_selector == viennacl::linalg::detail::SPARSE_ROW_NORM_2)
+          {
+            for (std::size_t row = 0; row < mat.size1(); ++row)
+              result_buf[row] = std::sqrt(result_buf[row]);
+          }
+        }
+
+        /** @brief Computes the contributions of the rows row_begin, ..., row_end-1 of a symmetric CSR matrix holding the upper triangular part to the result vector */
+        template<typename ScalarType>
+        void symmetric_csr_rows_prod(unsigned int const * row_buffer, unsigned int const * col_buffer, ScalarType const * elements,
+                                     std::size_t row_begin, std::size_t row_end,
+                                     ScalarType const * vec_buf, std::size_t vec_start, std::size_t vec_inc,
+                                     ScalarType * result_buf, std::size_t result_start, std::size_t result_inc)
+        {
+          for (std::size_t row = row_begin; row < row_end; ++row)
+          {
+            ScalarType x_row = vec_buf[row * vec_inc + vec_start];
+            ScalarType dot_prod = 0;
+            std::size_t row_stop = row_buffer[row+1];
+            for (std::size_t i = row_buffer[row]; i < row_stop; ++i)
+            {
+              std::size_t col = col_buffer[i];
+              dot_prod += elements[i] * vec_buf[col * vec_inc + vec_start];
+              if (col != row)
+                result_buf[col * result_inc + result_start] += elements[i] * x_row;
+            }
+            result_buf[row * result_inc + result_start] += dot_prod;
+          }
+        }
+      }
+
+      /** @brief Carries out matrix-vector multiplication with a symmetric_compressed_matrix
+      *
+      * Implementation of the convenience expression result = prod(mat, vec);
+      * Each stored entry a_ij with j > i contributes to both result_i and result_j.
+      * Row blocks of the same color write to disjoint entries of the result vector, hence they are processed in parallel without synchronization.
+      * Without OpenMP, the rows are processed in their natural order for better cache reuse.
+      *
+      * @param mat    The matrix
+      * @param vec    The vector
+      * @param result The result vector
+      */
+      template<class ScalarType>
+      void prod_impl(const viennacl::symmetric_compressed_matrix<ScalarType> & mat,
+                     const viennacl::vector_base<ScalarType> & vec,
+                           viennacl::vector_base<ScalarType> & result)
+      {
+        ScalarType         * result_buf   = detail::extract_raw_pointer<ScalarType>(result.handle());
+        ScalarType   const * vec_buf      = detail::extract_raw_pointer<ScalarType>(vec.handle());
+        ScalarType   const * elements     = detail::extract_raw_pointer<ScalarType>(mat.handle());
+        unsigned int const * row_buffer   = detail::extract_raw_pointer<unsigned int>(mat.handle1());
+        unsigned int const * col_buffer   = detail::extract_raw_pointer<unsigned int>(mat.handle2());
+
+        vector_assign(result, ScalarType(0));
+
+#ifdef VIENNACL_WITH_OPENMP
+        unsigned int const * block_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle3());
+        std::size_t rows       = mat.size1();
+        std::size_t block_size = mat.block_size();
+        std::vector<std::size_t> const & color_offsets = mat.color_offsets();
+
+        #pragma omp parallel
+        for (std::size_t color = 0; color + 1 < color_offsets.size(); ++color)
+        {
+          #pragma omp for
+          for (std::size_t block_index = color_offsets[color]; block_index < color_offsets[color+1]; ++block_index)
+          {
+            std::size_t row_begin = block_buffer[block_index] * block_size;
+            detail::symmetric_csr_rows_prod(row_buffer, col_buffer, elements, row_begin, std::min(row_begin + block_size, rows),
+                                            vec_buf, vec.start(), vec.stride(),
+                                            result_buf, result.start(), result.stride());
+          } //implicit barrier, next color starts after all blocks of this color are processed
+        }
+#else
+        detail::symmetric_csr_rows_prod(row_buffer, col_buffer, elements, 0, mat.size1(),
+                                        vec_buf, vec.start(), vec.stride(),
+                                        result_buf, result.start(), result.stride());
+#endif
+      }
+
+
+
       //
       // Coordinate Matrix
       //
@@ -973,6 +1221,29 @@ namespace viennacl
             += elements[i] * vec_buf[coord_buffer[2*i+1] * vec.stride() + vec.start()];
       }
 
+      namespace detail
+      {
+        /** @brief Returns the rows of a coordinate_matrix for sparse matrix - dense matrix products. The row offsets are computed in 'row_buffer', which requires the entries to be sorted by rows. */
+        template<class ScalarType, unsigned int ALIGNMENT>
+        sparse_rows<ScalarType> coordinate_matrix_rows(viennacl::coordinate_matrix<ScalarType, ALIGNMENT> const & mat, std::vector<unsigned int> & row_buffer)
+        {
+          unsigned int const * coords = detail::extract_raw_pointer<unsigned int>(mat.handle12());
+
+          row_buffer.assign(mat.size1() + 1, 0);
+          for (std::size_t i = 0; i < mat.nnz(); ++i)
+            ++row_buffer[coords[2*i] + 1];
+          for (std::size_t row = 0; row < mat.size1(); ++row)
+            row_buffer[row + 1] += row_buffer[row];
+
+          sparse_rows<ScalarType> rows;
+          rows.csr_elements   = detail::extract_raw_pointer<ScalarType>(mat.handle());
+          rows.csr_cols       = coords + 1;
+          rows.csr_col_inc    = 2;
+          rows.csr_row_buffer = &(row_buffer[0]);
+          return rows;
+        }
+      }
+
       /** @brief Carries out Compressed Matrix(COO)-Dense Matrix multiplication
       *
       * Implementation of the convenience expression result = prod(sp_mat, d_mat);
@@ -984,83 +1255,15 @@ namespace viennacl
       template<class ScalarType, unsigned int ALIGNMENT, class NumericT, typename F>
       void prod_impl(const viennacl::coordinate_matrix<ScalarType, ALIGNMENT> & sp_mat,
                      const viennacl::matrix_base<NumericT, F> & d_mat,
-                           viennacl::matrix_base<NumericT, F> & result) {
-
-        ScalarType   const * sp_mat_elements     = detail::extract_raw_pointer<ScalarType>(sp_mat.handle());
-        unsigned int const * sp_mat_coords       = detail::extract_raw_pointer<unsigned int>(sp_mat.handle12());
-
-        NumericT const * d_mat_data = detail::extract_raw_pointer<NumericT>(d_mat);
-        NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
-
-        std::size_t d_mat_start1 = viennacl::traits::start1(d_mat);
-        std::size_t d_mat_start2 = viennacl::traits::start2(d_mat);
-        std::size_t d_mat_inc1   = viennacl::traits::stride1(d_mat);
-        std::size_t d_mat_inc2   = viennacl::traits::stride2(d_mat);
-        std::size_t d_mat_internal_size1  = viennacl::traits::internal_size1(d_mat);
-        std::size_t d_mat_internal_size2  = viennacl::traits::internal_size2(d_mat);
-
-        std::size_t result_start1 = viennacl::traits::start1(result);
-        std::size_t result_start2 = viennacl::traits::start2(result);
-        std::size_t result_inc1   = viennacl::traits::stride1(result);
-        std::size_t result_inc2   = viennacl::traits::stride2(result);
-        std::size_t result_internal_size1  = viennacl::traits::internal_size1(result);
-        std::size_t result_internal_size2  = viennacl::traits::internal_size2(result);
-
-        detail::matrix_array_wrapper<NumericT const, typename F::orientation_category, false>
-            d_mat_wrapper(d_mat_data, d_mat_start1, d_mat_start2, d_mat_inc1, d_mat_inc2, d_mat_internal_size1, d_mat_internal_size2);
-        detail::matrix_array_wrapper<NumericT,       typename F::orientation_category, false>
-            result_wrapper(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
-
-        if ( detail::is_row_major(typename F::orientation_category()) ) {
-
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t row = 0; row < sp_mat.size1(); ++row)
-                for (std::size_t col = 0; col < d_mat.size2(); ++col)
-                  result_wrapper( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t i = 0; i < sp_mat.nnz(); ++i) {
-            NumericT x = static_cast<NumericT>(sp_mat_elements[i]);
-            unsigned int r = sp_mat_coords[2*i];
-            unsigned int c = sp_mat_coords[2*i+1];
-            for (std::size_t col = 0; col < d_mat.size2(); ++col) {
-              NumericT y = d_mat_wrapper( c, col);
-              result_wrapper(r, col) += x * y;
-            }
-          }
-        }
-
-        else {
-
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t col = 0; col < d_mat.size2(); ++col)
-            for (std::size_t row = 0; row < sp_mat.size1(); ++row)
-                result_wrapper( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t col = 0; col < d_mat.size2(); ++col) {
-
-            for (std::size_t i = 0; i < sp_mat.nnz(); ++i) {
-
-              NumericT x = static_cast<NumericT>(sp_mat_elements[i]);
-              unsigned int r = sp_mat_coords[2*i];
-              unsigned int c = sp_mat_coords[2*i+1];
-              NumericT y = d_mat_wrapper( c, col);
-
-              result_wrapper( r, col) += x*y;
-            }
+                           viennacl::matrix_base<NumericT, F> & result)
+      {
+        std::vector<unsigned int> row_buffer;
+        detail::sparse_rows<ScalarType> A = detail::coordinate_matrix_rows(sp_mat, row_buffer);
 
-          }
-        }
+        detail::dense_matrix_access<NumericT const> B(detail::extract_raw_pointer<NumericT>(d_mat), d_mat, false);
+        detail::dense_matrix_access<NumericT>       C(detail::extract_raw_pointer<NumericT>(result), result, false);
 
+        detail::prod_sparse_dense(A, sp_mat.size1(), B, C, result.size2());
       }
 
 
@@ -1077,65 +1280,15 @@ namespace viennacl
                      const viennacl::matrix_expression< const viennacl::matrix_base<NumericT, F>,
                                                         const viennacl::matrix_base<NumericT, F>,
                                                         viennacl::op_trans > & d_mat,
-                           viennacl::matrix_base<NumericT, F> & result) {
-
-        ScalarType   const * sp_mat_elements     = detail::extract_raw_pointer<ScalarType>(sp_mat.handle());
-        unsigned int const * sp_mat_coords       = detail::extract_raw_pointer<unsigned int>(sp_mat.handle12());
-
-        NumericT const * d_mat_data = detail::extract_raw_pointer<NumericT>(d_mat.lhs());
-        NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
-
-        std::size_t d_mat_start1 = viennacl::traits::start1(d_mat.lhs());
-        std::size_t d_mat_start2 = viennacl::traits::start2(d_mat.lhs());
-        std::size_t d_mat_inc1   = viennacl::traits::stride1(d_mat.lhs());
-        std::size_t d_mat_inc2   = viennacl::traits::stride2(d_mat.lhs());
-        std::size_t d_mat_internal_size1  = viennacl::traits::internal_size1(d_mat.lhs());
-        std::size_t d_mat_internal_size2  = viennacl::traits::internal_size2(d_mat.lhs());
-
-        std::size_t result_start1 = viennacl::traits::start1(result);
-        std::size_t result_start2 = viennacl::traits::start2(result);
-        std::size_t result_inc1   = viennacl::traits::stride1(result);
-        std::size_t result_inc2   = viennacl::traits::stride2(result);
-        std::size_t result_internal_size1  = viennacl::traits::internal_size1(result);
-        std::size_t result_internal_size2  = viennacl::traits::internal_size2(result);
-
-        detail::matrix_array_wrapper<NumericT const, typename F::orientation_category, false>
-            d_mat_wrapper(d_mat_data, d_mat_start1, d_mat_start2, d_mat_inc1, d_mat_inc2, d_mat_internal_size1, d_mat_internal_size2);
-        detail::matrix_array_wrapper<NumericT,       typename F::orientation_category, false>
-            result_wrapper(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
-
-        if ( detail::is_row_major(typename F::orientation_category()) ) {
-
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t row = 0; row < sp_mat.size1(); ++row)
-            for (std::size_t col = 0; col < d_mat.size2(); ++col)
-              result_wrapper( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-        }
-        else {
-
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t col = 0; col < d_mat.size2(); ++col)
-            for (std::size_t row = 0; row < sp_mat.size1(); ++row)
-              result_wrapper( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-        }
+                           viennacl::matrix_base<NumericT, F> & result)
+      {
+        std::vector<unsigned int> row_buffer;
+        detail::sparse_rows<ScalarType> A = detail::coordinate_matrix_rows(sp_mat, row_buffer);
 
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-        for (std::size_t i = 0; i < sp_mat.nnz(); ++i) {
-          NumericT x = static_cast<NumericT>(sp_mat_elements[i]);
-          unsigned int r = sp_mat_coords[2*i];
-          unsigned int c = sp_mat_coords[2*i+1];
-          for (std::size_t col = 0; col < d_mat.size2(); ++col) {
-            NumericT y = d_mat_wrapper( col, c);
-            result_wrapper(r, col) += x * y;
-          }
-        }
+        detail::dense_matrix_access<NumericT const> B(detail::extract_raw_pointer<NumericT>(d_mat.lhs()), d_mat.lhs(), true);
+        detail::dense_matrix_access<NumericT>       C(detail::extract_raw_pointer<NumericT>(result), result, false);
 
+        detail::prod_sparse_dense(A, sp_mat.size1(), B, C, result.size2());
       }
       //
       // ELL Matrix
@@ -1191,90 +1344,16 @@ namespace viennacl
                      const viennacl::matrix_base<NumericT, F> & d_mat,
                            viennacl::matrix_base<NumericT, F> & result)
       {
-        ScalarType   const * sp_mat_elements     = detail::extract_raw_pointer<ScalarType>(sp_mat.handle());
-        unsigned int const * sp_mat_coords       = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
-
-        NumericT const * d_mat_data = detail::extract_raw_pointer<NumericT>(d_mat);
-        NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
-
-        std::size_t d_mat_start1 = viennacl::traits::start1(d_mat);
-        std::size_t d_mat_start2 = viennacl::traits::start2(d_mat);
-        std::size_t d_mat_inc1   = viennacl::traits::stride1(d_mat);
-        std::size_t d_mat_inc2   = viennacl::traits::stride2(d_mat);
-        std::size_t d_mat_internal_size1  = viennacl::traits::internal_size1(d_mat);
-        std::size_t d_mat_internal_size2  = viennacl::traits::internal_size2(d_mat);
-
-        std::size_t result_start1 = viennacl::traits::start1(result);
-        std::size_t result_start2 = viennacl::traits::start2(result);
-        std::size_t result_inc1   = viennacl::traits::stride1(result);
-        std::size_t result_inc2   = viennacl::traits::stride2(result);
-        std::size_t result_internal_size1  = viennacl::traits::internal_size1(result);
-        std::size_t result_internal_size2  = viennacl::traits::internal_size2(result);
-
-        detail::matrix_array_wrapper<NumericT const, typename F::orientation_category, false>
-            d_mat_wrapper(d_mat_data, d_mat_start1, d_mat_start2, d_mat_inc1, d_mat_inc2, d_mat_internal_size1, d_mat_internal_size2);
-        detail::matrix_array_wrapper<NumericT,       typename F::orientation_category, false>
-            result_wrapper(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
-
-        if ( detail::is_row_major(typename F::orientation_category()) ) {
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for(std::size_t row = 0; row < sp_mat.size1(); ++row)
-                for (std::size_t col = 0; col < d_mat.size2(); ++col)
-                  result_wrapper( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for(unsigned int item_id = 0; item_id < sp_mat.maxnnz(); ++item_id) {
-
-            for(std::size_t row = 0; row < sp_mat.size1(); ++row) {
-
-              std::size_t offset = row + item_id * sp_mat.internal_size1();
-              NumericT sp_mat_val = static_cast<NumericT>(sp_mat_elements[offset]);
-              unsigned int sp_mat_col = sp_mat_coords[offset];
-
-              if( sp_mat_val != 0) {
-
-                for (std::size_t col = 0; col < d_mat.size2(); ++col) {
+        detail::sparse_rows<ScalarType> A;
+        A.ell_elements = detail::extract_raw_pointer<ScalarType>(sp_mat.handle());
+        A.ell_cols     = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
+        A.ell_width    = sp_mat.maxnnz();
+        A.ell_inc      = sp_mat.internal_size1();
 
-                  result_wrapper( row, col) += sp_mat_val * d_mat_wrapper( sp_mat_col, col);
-                }
-              }
-            }
-          }
-        }
-        else {
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t col = 0; col < d_mat.size2(); ++col)
-            for(std::size_t row = 0; row < sp_mat.size1(); ++row)
-                result_wrapper( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t col = 0; col < d_mat.size2(); ++col) {
-
-            for(unsigned int item_id = 0; item_id < sp_mat.maxnnz(); ++item_id) {
-
-              for(std::size_t row = 0; row < sp_mat.size1(); ++row) {
-
-                std::size_t offset = row + item_id * sp_mat.internal_size1();
-                NumericT sp_mat_val = static_cast<NumericT>(sp_mat_elements[offset]);
-                unsigned int sp_mat_col = sp_mat_coords[offset];
-
-                if( sp_mat_val != 0) {
-
-                  result_wrapper( row, col) += sp_mat_val * d_mat_wrapper( sp_mat_col, col);
-                }
-              }
-            }
-          }
-        }
+        detail::dense_matrix_access<NumericT const> B(detail::extract_raw_pointer<NumericT>(d_mat), d_mat, false);
+        detail::dense_matrix_access<NumericT>       C(detail::extract_raw_pointer<NumericT>(result), result, false);
 
+        detail::prod_sparse_dense(A, sp_mat.size1(), B, C, result.size2());
       }
 
       /** @brief Carries out matrix-trans(matrix) multiplication first matrix being sparse ell
@@ -1291,89 +1370,18 @@ namespace viennacl
                      const viennacl::matrix_expression< const viennacl::matrix_base<NumericT, F>,
                                                         const viennacl::matrix_base<NumericT, F>,
                                                         viennacl::op_trans > & d_mat,
-                           viennacl::matrix_base<NumericT, F> & result) {
-
-        ScalarType   const * sp_mat_elements     = detail::extract_raw_pointer<ScalarType>(sp_mat.handle());
-        unsigned int const * sp_mat_coords       = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
-
-        NumericT const * d_mat_data = detail::extract_raw_pointer<NumericT>(d_mat.lhs());
-        NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
-
-        std::size_t d_mat_start1 = viennacl::traits::start1(d_mat.lhs());
-        std::size_t d_mat_start2 = viennacl::traits::start2(d_mat.lhs());
-        std::size_t d_mat_inc1   = viennacl::traits::stride1(d_mat.lhs());
-        std::size_t d_mat_inc2   = viennacl::traits::stride2(d_mat.lhs());
-        std::size_t d_mat_internal_size1  = viennacl::traits::internal_size1(d_mat.lhs());
-        std::size_t d_mat_internal_size2  = viennacl::traits::internal_size2(d_mat.lhs());
-
-        std::size_t result_start1 = viennacl::traits::start1(result);
-        std::size_t result_start2 = viennacl::traits::start2(result);
-        std::size_t result_inc1   = viennacl::traits::stride1(result);
-        std::size_t result_inc2   = viennacl::traits::stride2(result);
-        std::size_t result_internal_size1  = viennacl::traits::internal_size1(result);
-        std::size_t result_internal_size2  = viennacl::traits::internal_size2(result);
-
-        detail::matrix_array_wrapper<NumericT const, typename F::orientation_category, false>
-            d_mat_wrapper(d_mat_data, d_mat_start1, d_mat_start2, d_mat_inc1, d_mat_inc2, d_mat_internal_size1, d_mat_internal_size2);
-        detail::matrix_array_wrapper<NumericT,       typename F::orientation_category, false>
-            result_wrapper(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
-
-        if ( detail::is_row_major(typename F::orientation_category()) ) {
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for(std::size_t row = 0; row < sp_mat.size1(); ++row)
-            for (std::size_t col = 0; col < d_mat.size2(); ++col)
-              result_wrapper( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-
-          for (std::size_t col = 0; col < d_mat.size2(); ++col) {
-
-            for(unsigned int item_id = 0; item_id < sp_mat.maxnnz(); ++item_id) {
-
-              for(std::size_t row = 0; row < sp_mat.size1(); ++row) {
-
-                std::size_t offset = row + item_id * sp_mat.internal_size1();
-                NumericT sp_mat_val = static_cast<NumericT>(sp_mat_elements[offset]);
-                unsigned int sp_mat_col = sp_mat_coords[offset];
-
-                if( sp_mat_val != 0) {
-
-                  result_wrapper( row, col) += sp_mat_val * d_mat_wrapper( col, sp_mat_col);
-                }
-              }
-            }
-          }
-        }
-        else {
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t col = 0; col < d_mat.size2(); ++col)
-            for(std::size_t row = 0; row < sp_mat.size1(); ++row)
-                result_wrapper( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for(unsigned int item_id = 0; item_id < sp_mat.maxnnz(); ++item_id) {
-
-            for(std::size_t row = 0; row < sp_mat.size1(); ++row) {
-
-              std::size_t offset = row + item_id * sp_mat.internal_size1();
-              NumericT sp_mat_val = static_cast<NumericT>(sp_mat_elements[offset]);
-              unsigned int sp_mat_col = sp_mat_coords[offset];
-
-              if( sp_mat_val != 0) {
-
-                for (std::size_t col = 0; col < d_mat.size2(); ++col) {
+                           viennacl::matrix_base<NumericT, F> & result)
+      {
+        detail::sparse_rows<ScalarType> A;
+        A.ell_elements = detail::extract_raw_pointer<ScalarType>(sp_mat.handle());
+        A.ell_cols     = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
+        A.ell_width    = sp_mat.maxnnz();
+        A.ell_inc      = sp_mat.internal_size1();
 
-                  result_wrapper( row, col) += sp_mat_val * d_mat_wrapper( col, sp_mat_col);
-                }
-              }
-            }
-          }
-        }
+        detail::dense_matrix_access<NumericT const> B(detail::extract_raw_pointer<NumericT>(d_mat.lhs()), d_mat.lhs(), true);
+        detail::dense_matrix_access<NumericT>       C(detail::extract_raw_pointer<NumericT>(result), result, false);
 
+        detail::prod_sparse_dense(A, sp_mat.size1(), B, C, result.size2());
       }
 
       //
@@ -1436,6 +1444,65 @@ namespace viennacl
 
       }
 
+      /** @brief Carries out sparse_matrix-matrix multiplication first matrix being hyb
+      *
+      * Implementation of the convenience expression result = prod(sp_mat, d_mat);
+      *
+      * @param sp_mat     The sparse matrix (HYB format)
+      * @param d_mat      The dense matrix
+      * @param result     The result matrix
+      */
+      template<class ScalarType, typename NumericT, unsigned int ALIGNMENT, typename F>
+      void prod_impl(const viennacl::hyb_matrix<ScalarType, ALIGNMENT> & sp_mat,
+                     const viennacl::matrix_base<NumericT, F> & d_mat,
+                           viennacl::matrix_base<NumericT, F> & result)
+      {
+        detail::sparse_rows<ScalarType> A;
+        A.ell_elements   = detail::extract_raw_pointer<ScalarType>(sp_mat.handle());
+        A.ell_cols       = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
+        A.ell_width      = sp_mat.ell_nnz();
+        A.ell_inc        = sp_mat.internal_size1();
+        A.csr_elements   = detail::extract_raw_pointer<ScalarType>(sp_mat.handle5());
+        A.csr_cols       = detail::extract_raw_pointer<unsigned int>(sp_mat.handle4());
+        A.csr_row_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle3());
+
+        detail::dense_matrix_access<NumericT const> B(detail::extract_raw_pointer<NumericT>(d_mat), d_mat, false);
+        detail::dense_matrix_access<NumericT>       C(detail::extract_raw_pointer<NumericT>(result), result, false);
+
+        detail::prod_sparse_dense(A, sp_mat.size1(), B, C, result.size2());
+      }
+
+      /** @brief Carries out matrix-trans(matrix) multiplication first matrix being sparse hyb
+      *          and the second dense transposed
+      *
+      * Implementation of the convenience expression result = prod(sp_mat, trans(d_mat));
+      *
+      * @param sp_mat     The sparse matrix (HYB format)
+      * @param d_mat      The transposed dense matrix
+      * @param result     The result matrix
+      */
+      template<class ScalarType, typename NumericT, unsigned int ALIGNMENT, typename F>
+      void prod_impl(const viennacl::hyb_matrix<ScalarType, ALIGNMENT> & sp_mat,
+                     const viennacl::matrix_expression< const viennacl::matrix_base<NumericT, F>,
+                                                        const viennacl::matrix_base<NumericT, F>,
+                                                        viennacl::op_trans > & d_mat,
+                           viennacl::matrix_base<NumericT, F> & result)
+      {
+        detail::sparse_rows<ScalarType> A;
+        A.ell_elements   = detail::extract_raw_pointer<ScalarType>(sp_mat.handle());
+        A.ell_cols       = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
+        A.ell_width      = sp_mat.ell_nnz();
+        A.ell_inc        = sp_mat.internal_size1();
+        A.csr_elements   = detail::extract_raw_pointer<ScalarType>(sp_mat.handle5());
+        A.csr_cols       = detail::extract_raw_pointer<unsigned int>(sp_mat.handle4());
+        A.csr_row_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle3());
+
+        detail::dense_matrix_access<NumericT const> B(detail::extract_raw_pointer<NumericT>(d_mat.lhs()), d_mat.lhs(), true);
+        detail::dense_matrix_access<NumericT>       C(detail::extract_raw_pointer<NumericT>(result), result, false);
+
+        detail::prod_sparse_dense(A, sp_mat.size1(), B, C, result.size2());
+      }
+
 
     } // namespace host_based
   } //namespace linalg
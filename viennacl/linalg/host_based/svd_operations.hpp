@@ -0,0 +1,653 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_SVD_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_SVD_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/svd_operations.hpp
+    @brief Implementations of the singular value decomposition using a single CPU thread or OpenMP.
+
+    The matrix is first reduced to upper bidiagonal form by blocked Householder transformations (cf. LAPACK's xGEBRD),
+    where the trailing matrix is updated by matrix-matrix products. The singular values of the bidiagonal matrix are then
+    computed by the implicit-shift QR iteration of Golub and Kahan. The Givens rotations of each QR sweep are recorded
+    and applied to the singular vectors block-row by block-row, so that each row block stays in cache during a sweep.
+*/
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
+#include "viennacl/linalg/host_based/householder.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Computes y = alpha * A * x + beta * y for a column-major block A with leading dimension lda. */
+        template <typename NumericT>
+        void svd_gemv(std::size_t rows, std::size_t cols,
+                      NumericT alpha, NumericT const * A, std::size_t lda,
+                      NumericT const * x, std::size_t incx,
+                      NumericT beta, NumericT * y, std::size_t incy)
+        {
+          std::size_t const block_size = 128;
+          std::size_t num_blocks = (rows + block_size - 1) / block_size;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (rows * cols > 20000)
+#endif
+          for (std::size_t block = 0; block < num_blocks; ++block)
+          {
+            std::size_t row_start = block * block_size;
+            std::size_t row_end   = std::min(row_start + block_size, rows);
+
+            for (std::size_t i = row_start; i < row_end; ++i)
+              y[i*incy] = (beta != 0) ? beta * y[i*incy] : NumericT(0);
+
+            for (std::size_t j = 0; j < cols; ++j)
+            {
+              NumericT temp = alpha * x[j*incx];
+              NumericT const * A_col = A + j * lda;
+              for (std::size_t i = row_start; i < row_end; ++i)
+                y[i*incy] += A_col[i] * temp;
+            }
+          }
+        }
+
+        /** @brief Computes y = alpha * A^T * x + beta * y for a column-major block A with leading dimension lda. */
+        template <typename NumericT>
+        void svd_gemv_trans(std::size_t rows, std::size_t cols,
+                            NumericT alpha, NumericT const * A, std::size_t lda,
+                            NumericT const * x, std::size_t incx,
+                            NumericT beta, NumericT * y, std::size_t incy)
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (rows * cols > 20000)
+#endif
+          for (std::size_t j = 0; j < cols; ++j)
+          {
+            NumericT temp = 0;
+            NumericT const * A_col = A + j * lda;
+            for (std::size_t i = 0; i < rows; ++i)
+              temp += A_col[i] * x[i*incx];
+
+            y[j*incy] = (beta != 0) ? alpha * temp + beta * y[j*incy] : alpha * temp;
+          }
+        }
+
+        /** @brief Reduces the first nb rows and columns of the trailing matrix starting at (s, s) to bidiagonal form (cf. LAPACK's xLABRD for M >= N).
+        *
+        * Returns the matrices X and Y such that the trailing matrix can be updated via A22 <- A22 - V * Y^T - X * U^T,
+        * where V and U^T are stored in the panel. On return, the diagonal and superdiagonal entries of the panel hold ones.
+        */
+        template <typename NumericT>
+        void svd_bidiag_panel(viennacl::matrix<NumericT, viennacl::column_major> & W,
+                              std::size_t s, std::size_t nb,
+                              viennacl::matrix<NumericT, viennacl::column_major> & X,
+                              viennacl::matrix<NumericT, viennacl::column_major> & Y,
+                              std::vector<NumericT> & d, std::vector<NumericT> & e,
+                              std::vector<NumericT> & tauq, std::vector<NumericT> & taup)
+        {
+          std::size_t lda = W.internal_size1();
+          std::size_t ldx = X.internal_size1();
+          std::size_t ldy = Y.internal_size1();
+          std::size_t mm  = W.size1() - s;
+          std::size_t nn  = W.size2() - s;
+
+          NumericT * a     = detail::extract_raw_pointer<NumericT>(W) + s + s * lda;
+          NumericT * X_ptr = detail::extract_raw_pointer<NumericT>(X);
+          NumericT * Y_ptr = detail::extract_raw_pointer<NumericT>(Y);
+
+          for (std::size_t i = 0; i < nb; ++i)
+          {
+            NumericT * a_col = a + i * lda;
+            NumericT * x_col = X_ptr + i * ldx;
+            NumericT * y_col = Y_ptr + i * ldy;
+
+            // update column i with the transformations of the panel so far:
+            svd_gemv(mm-i, i, NumericT(-1), a + i,     lda, Y_ptr + i, ldy, NumericT(1), a_col + i, 1);
+            svd_gemv(mm-i, i, NumericT(-1), X_ptr + i, ldx, a_col,     1,   NumericT(1), a_col + i, 1);
+
+            // reflector annihilating A(i+1:mm, i):
+            tauq[s+i] = householder_generate(mm-i, a_col[i], a_col + i + 1, 1);
+            d[s+i] = a_col[i];
+
+            if (i + 1 < nn)
+            {
+              a_col[i] = 1;
+
+              // column i of Y:
+              svd_gemv_trans(mm-i, nn-i-1, NumericT(1),  a + i + (i+1) * lda, lda, a_col + i, 1, NumericT(0), y_col + i + 1, 1);
+              svd_gemv_trans(mm-i, i,      NumericT(1),  a + i,               lda, a_col + i, 1, NumericT(0), y_col,         1);
+              svd_gemv      (nn-i-1, i,    NumericT(-1), Y_ptr + i + 1,       ldy, y_col,     1, NumericT(1), y_col + i + 1, 1);
+              svd_gemv_trans(mm-i, i,      NumericT(1),  X_ptr + i,           ldx, a_col + i, 1, NumericT(0), y_col,         1);
+              svd_gemv_trans(i, nn-i-1,    NumericT(-1), a + (i+1) * lda,     lda, y_col,     1, NumericT(1), y_col + i + 1, 1);
+              for (std::size_t j = i + 1; j < nn; ++j)
+                y_col[j] *= tauq[s+i];
+
+              // update row i with the transformations of the panel so far:
+              NumericT * a_row = a + i + (i+1) * lda;
+              svd_gemv      (nn-i-1, i+1, NumericT(-1), Y_ptr + i + 1,   ldy, a + i,     lda, NumericT(1), a_row, lda);
+              svd_gemv_trans(i, nn-i-1,   NumericT(-1), a + (i+1) * lda, lda, X_ptr + i, ldx, NumericT(1), a_row, lda);
+
+              // reflector annihilating A(i, i+2:nn):
+              taup[s+i] = householder_generate(nn-i-1, a_row[0], a_row + lda, lda);
+              e[s+i] = a_row[0];
+              a_row[0] = 1;
+
+              // column i of X:
+              svd_gemv      (mm-i-1, nn-i-1, NumericT(1),  a + i + 1 + (i+1) * lda, lda, a_row, lda, NumericT(0), x_col + i + 1, 1);
+              svd_gemv_trans(nn-i-1, i+1,    NumericT(1),  Y_ptr + i + 1,           ldy, a_row, lda, NumericT(0), x_col,         1);
+              svd_gemv      (mm-i-1, i+1,    NumericT(-1), a + i + 1,               lda, x_col, 1,   NumericT(1), x_col + i + 1, 1);
+              svd_gemv      (i, nn-i-1,      NumericT(1),  a + (i+1) * lda,         lda, a_row, lda, NumericT(0), x_col,         1);
+              svd_gemv      (mm-i-1, i,      NumericT(-1), X_ptr + i + 1,           ldx, x_col, 1,   NumericT(1), x_col + i + 1, 1);
+              for (std::size_t j = i + 1; j < mm; ++j)
+                x_col[j] *= taup[s+i];
+            }
+            else
+              taup[s+i] = 0;
+          }
+        }
+
+        /** @brief Reduces the M x N column-major matrix W with M >= N to upper bidiagonal form B = Q^T W P (cf. LAPACK's xGEBRD).
+        *
+        * The reflectors defining Q are stored below the diagonal, the reflectors defining P to the right of the superdiagonal.
+        */
+        template <typename NumericT>
+        void svd_bidiag(viennacl::matrix<NumericT, viennacl::column_major> & W,
+                        std::vector<NumericT> & d, std::vector<NumericT> & e,
+                        std::vector<NumericT> & tauq, std::vector<NumericT> & taup,
+                        std::size_t block_size = 32)
+        {
+          typedef viennacl::matrix<NumericT, viennacl::column_major>   MatrixType;
+
+          std::size_t M = W.size1();
+          std::size_t N = W.size2();
+          viennacl::context ctx(viennacl::MAIN_MEMORY);
+
+          MatrixType X(M, block_size, ctx);
+          MatrixType Y(N, block_size, ctx);
+
+          NumericT * data_W = detail::extract_raw_pointer<NumericT>(W);
+          std::size_t lda = W.internal_size1();
+
+          std::size_t s = 0;
+          for (; N - s > 2 * block_size; s += block_size)
+          {
+            svd_bidiag_panel(W, s, block_size, X, Y, d, e, tauq, taup);
+
+            // trailing update A22 <- A22 - V * Y^T - X * U^T
+            std::size_t nb = block_size;
+            viennacl::matrix_range<MatrixType> A22(W, viennacl::range(s + nb, M), viennacl::range(s + nb, N));
+            viennacl::matrix_range<MatrixType> V  (W, viennacl::range(s + nb, M), viennacl::range(s, s + nb));
+            viennacl::matrix_range<MatrixType> Ut (W, viennacl::range(s, s + nb), viennacl::range(s + nb, N));
+            viennacl::matrix_range<MatrixType> Y2 (Y, viennacl::range(nb, N - s), viennacl::range(0, nb));
+            viennacl::matrix_range<MatrixType> X2 (X, viennacl::range(nb, M - s), viennacl::range(0, nb));
+
+            viennacl::linalg::host_based::prod_impl(V, viennacl::trans(Y2), A22, NumericT(-1), NumericT(1));
+            viennacl::linalg::host_based::prod_impl(X2, Ut, A22, NumericT(-1), NumericT(1));
+
+            // restore the bidiagonal entries overwritten by ones:
+            for (std::size_t j = s; j < s + nb; ++j)
+            {
+              data_W[j + j * lda]     = d[j];
+              data_W[j + (j+1) * lda] = e[j];
+            }
+          }
+
+          // remaining columns are reduced in a single panel:
+          std::size_t nb = N - s;
+          if (nb > 0)
+          {
+            MatrixType X_rest(M - s, nb, ctx);
+            MatrixType Y_rest(nb, nb, ctx);
+            svd_bidiag_panel(W, s, nb, X_rest, Y_rest, d, e, tauq, taup);
+            for (std::size_t j = s; j < N; ++j)
+            {
+              data_W[j + j * lda] = d[j];
+              if (j + 1 < N)
+                data_W[j + (j+1) * lda] = e[j];
+            }
+          }
+        }
+
+        /** @brief Applies the sequence of rotations (c_j, s_j), j = j_start, ..., j_end - 1, acting on the columns (j, j+1) of the column-major matrix Q.
+        *
+        * The rows of Q are processed in blocks, where all rotations are applied to a block before moving on to the next one.
+        */
+        template <typename NumericT>
+        void svd_apply_givens_sequence(NumericT * Q, std::size_t ldq, std::size_t rows,
+                                       std::size_t j_start, std::size_t j_end,
+                                       std::vector<NumericT> const & cs, std::vector<NumericT> const & sn)
+        {
+          std::size_t const block_size = 64;
+          std::size_t num_blocks = (rows + block_size - 1) / block_size;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (rows * (j_end - j_start) > 20000)
+#endif
+          for (std::size_t block = 0; block < num_blocks; ++block)
+          {
+            std::size_t row_start = block * block_size;
+            std::size_t row_end   = std::min(row_start + block_size, rows);
+
+            for (std::size_t j = j_start; j < j_end; ++j)
+            {
+              NumericT c = cs[j];
+              NumericT s = sn[j];
+              NumericT * col0 = Q + j * ldq;
+              NumericT * col1 = col0 + ldq;
+              for (std::size_t i = row_start; i < row_end; ++i)
+              {
+                NumericT t = c * col0[i] + s * col1[i];
+                col1[i] = c * col1[i] - s * col0[i];
+                col0[i] = t;
+              }
+            }
+          }
+        }
+
+        /** @brief Applies a single rotation acting on the columns (j, k) of the column-major matrix Q */
+        template <typename NumericT>
+        void svd_apply_givens(NumericT * Q, std::size_t ldq, std::size_t rows, std::size_t j, std::size_t k, NumericT c, NumericT s)
+        {
+          NumericT * col0 = Q + j * ldq;
+          NumericT * col1 = Q + k * ldq;
+          for (std::size_t i = 0; i < rows; ++i)
+          {
+            NumericT t = c * col0[i] + s * col1[i];
+            col1[i] = c * col1[i] - s * col0[i];
+            col0[i] = t;
+          }
+        }
+
+        /** @brief Computes the singular values of the upper bidiagonal matrix with diagonal d and superdiagonal e by the implicit-shift QR method.
+        *
+        * The rotations are accumulated into the columns of U (size M x M) and V (size N x N) if the respective pointers are nonzero.
+        * On return, d holds the singular values in descending order.
+        * Throws viennacl::numerical_exception if a singular value does not converge within 75 sweeps.
+        */
+        template <typename NumericT>
+        void svd_bidiag_qr(std::vector<NumericT> & d, std::vector<NumericT> & e,
+                           viennacl::matrix<NumericT, viennacl::column_major> * U,
+                           viennacl::matrix<NumericT, viennacl::column_major> * V)
+        {
+          std::size_t n = d.size();
+          if (n == 0)
+            return;
+
+          NumericT * data_U = U ? detail::extract_raw_pointer<NumericT>(*U) : NULL;
+          NumericT * data_V = V ? detail::extract_raw_pointer<NumericT>(*V) : NULL;
+          std::size_t ldu = U ? U->internal_size1() : 0;
+          std::size_t ldv = V ? V->internal_size1() : 0;
+          std::size_t rows_U = U ? U->size1() : 0;
+          std::size_t rows_V = V ? V->size1() : 0;
+
+          std::vector<NumericT> cs_u(n), sn_u(n), cs_v(n), sn_v(n);
+
+          NumericT const eps  = std::numeric_limits<NumericT>::epsilon();
+          NumericT const tiny = std::numeric_limits<NumericT>::min() / eps;
+          std::size_t const max_iter = 75;
+
+          e.resize(n);
+          e[n-1] = 0;
+
+          std::size_t p = n;
+          std::size_t iter = 0;
+          while (p > 0)
+          {
+            // find the largest k such that e[k-1] is negligible (k == 0 if none):
+            std::size_t k = p - 1;
+            for (; k > 0; --k)
+            {
+              if (std::fabs(e[k-1]) <= tiny + eps * (std::fabs(d[k-1]) + std::fabs(d[k])))
+              {
+                e[k-1] = 0;
+                break;
+              }
+            }
+
+            if (k == p - 1)  // d[p-1] has converged
+            {
+              if (d[k] <= 0)
+              {
+                d[k] = (d[k] < 0) ? -d[k] : NumericT(0);
+                if (V)
+                  for (std::size_t i = 0; i < rows_V; ++i)
+                    data_V[i + k * ldv] = -data_V[i + k * ldv];
+              }
+              iter = 0;
+              --p;
+              continue;
+            }
+
+            // look for a negligible diagonal entry in the unreduced block d[k], ..., d[p-1]:
+            std::size_t ks = p - 1;
+            bool found_zero = false;
+            for (;; --ks)
+            {
+              NumericT t = ((ks + 1 < p) ? std::fabs(e[ks]) : NumericT(0)) + ((ks > k) ? std::fabs(e[ks-1]) : NumericT(0));
+              if (std::fabs(d[ks]) <= tiny + eps * t)
+              {
+                d[ks] = 0;
+                found_zero = true;
+                break;
+              }
+              if (ks == k)
+                break;
+            }
+
+            if (found_zero && ks == p - 1)
+            {
+              // deflate negligible d[p-1] by rotations from the right:
+              NumericT f = e[p-2];
+              e[p-2] = 0;
+              for (std::size_t j = p - 1; j-- > k; )
+              {
+                NumericT t  = std::sqrt(d[j] * d[j] + f * f);
+                NumericT c  = d[j] / t;
+                NumericT s  = f / t;
+                d[j] = t;
+                if (j != k)
+                {
+                  f = -s * e[j-1];
+                  e[j-1] = c * e[j-1];
+                }
+                if (V)
+                  svd_apply_givens(data_V, ldv, rows_V, j, p - 1, c, s);
+              }
+            }
+            else if (found_zero)
+            {
+              // split at negligible d[ks] by rotations from the left:
+              NumericT f = e[ks];
+              e[ks] = 0;
+              for (std::size_t j = ks + 1; j < p; ++j)
+              {
+                NumericT t  = std::sqrt(d[j] * d[j] + f * f);
+                NumericT c  = d[j] / t;
+                NumericT s  = f / t;
+                d[j] = t;
+                f = -s * e[j];
+                e[j] = c * e[j];
+                if (U)
+                  svd_apply_givens(data_U, ldu, rows_U, j, ks, c, s);
+              }
+            }
+            else
+            {
+              // one implicit-shift QR sweep on d[k], ..., d[p-1]:
+              if (iter >= max_iter)
+                throw viennacl::numerical_exception("SVD: implicit QR iteration for the bidiagonal matrix did not converge");
+
+              NumericT scale = std::max(std::max(std::max(std::max(std::fabs(d[p-1]), std::fabs(d[p-2])), std::fabs(e[p-2])), std::fabs(d[k])), std::fabs(e[k]));
+              NumericT sp   = d[p-1] / scale;
+              NumericT spm1 = d[p-2] / scale;
+              NumericT epm1 = e[p-2] / scale;
+              NumericT sk   = d[k] / scale;
+              NumericT ek   = e[k] / scale;
+              NumericT b = ((spm1 + sp) * (spm1 - sp) + epm1 * epm1) / NumericT(2);
+              NumericT c = (sp * epm1) * (sp * epm1);
+              NumericT shift = 0;
+              if (b != 0 || c != 0)
+              {
+                shift = std::sqrt(b * b + c);
+                if (b < 0)
+                  shift = -shift;
+                shift = c / (b + shift);
+              }
+              NumericT f = (sk + sp) * (sk - sp) + shift;
+              NumericT g = sk * ek;
+
+              // chase the bulge:
+              for (std::size_t j = k; j < p - 1; ++j)
+              {
+                NumericT t  = std::sqrt(f * f + g * g);
+                NumericT cs = f / t;
+                NumericT sn = g / t;
+                if (j != k)
+                  e[j-1] = t;
+                f      = cs * d[j] + sn * e[j];
+                e[j]   = cs * e[j] - sn * d[j];
+                g      = sn * d[j+1];
+                d[j+1] = cs * d[j+1];
+                cs_v[j] = cs;
+                sn_v[j] = sn;
+
+                t  = std::sqrt(f * f + g * g);
+                cs = f / t;
+                sn = g / t;
+                d[j]   = t;
+                f      = cs * e[j] + sn * d[j+1];
+                d[j+1] = -sn * e[j] + cs * d[j+1];
+                g      = sn * e[j+1];
+                e[j+1] = cs * e[j+1];
+                cs_u[j] = cs;
+                sn_u[j] = sn;
+              }
+              e[p-2] = f;
+              ++iter;
+
+              if (V)
+                svd_apply_givens_sequence(data_V, ldv, rows_V, k, p - 1, cs_v, sn_v);
+              if (U)
+                svd_apply_givens_sequence(data_U, ldu, rows_U, k, p - 1, cs_u, sn_u);
+            }
+          }
+
+          // sort singular values in descending order:
+          for (std::size_t i = 0; i + 1 < n; ++i)
+          {
+            std::size_t max_index = i;
+            for (std::size_t j = i + 1; j < n; ++j)
+              if (d[j] > d[max_index])
+                max_index = j;
+
+            if (max_index != i)
+            {
+              std::swap(d[i], d[max_index]);
+              if (U)
+                for (std::size_t r = 0; r < rows_U; ++r)
+                  std::swap(data_U[r + i * ldu], data_U[r + max_index * ldu]);
+              if (V)
+                for (std::size_t r = 0; r < rows_V; ++r)
+                  std::swap(data_V[r + i * ldv], data_V[r + max_index * ldv]);
+            }
+          }
+        }
+
+        /** @brief Computes the SVD W = U * diag(sigma) * V^T of the M x N column-major matrix W with M >= N. W is overwritten.
+        *
+        * If U and V are NULL, only the singular values are computed.
+        */
+        template <typename NumericT>
+        void svd_impl(viennacl::matrix<NumericT, viennacl::column_major> & W,
+                      std::vector<NumericT> & sigma,
+                      viennacl::matrix<NumericT, viennacl::column_major> * U,
+                      viennacl::matrix<NumericT, viennacl::column_major> * V)
+        {
+          typedef viennacl::matrix<NumericT, viennacl::column_major>   MatrixType;
+
+          std::size_t N = W.size2();
+
+          std::vector<NumericT> e(N), tauq(N), taup(N);
+          sigma.resize(N);
+
+          svd_bidiag(W, sigma, e, tauq, taup);
+
+          NumericT const * data_W = detail::extract_raw_pointer<NumericT>(W);
+          std::size_t ldw = W.internal_size1();
+
+          if (U)
+            householder_form_q(data_W, ldw, &(tauq[0]), N, *U);
+
+          if (V)
+          {
+            // V = [1 0; 0 P'], where the reflectors of P' are stored in the rows of W right of the superdiagonal:
+            NumericT * data_V = detail::extract_raw_pointer<NumericT>(*V);
+            std::size_t ldv = V->internal_size1();
+
+            for (std::size_t j = 0; j < N; ++j)
+              for (std::size_t i = 0; i < N; ++i)
+                data_V[i + j * ldv] = (i == j) ? NumericT(1) : NumericT(0);
+
+            if (N > 1)
+            {
+              viennacl::context ctx(viennacl::MAIN_MEMORY);
+              MatrixType P(N - 1, N - 1, ctx);
+              MatrixType reflectors(N - 1, N - 1, ctx);
+              NumericT * data_R = detail::extract_raw_pointer<NumericT>(reflectors);
+              std::size_t ldr = reflectors.internal_size1();
+              for (std::size_t j = 0; j < N - 1; ++j)
+                for (std::size_t i = j + 1; i < N - 1; ++i)
+                  data_R[i + j * ldr] = data_W[j + (i + 1) * ldw];
+
+              householder_form_q(data_R, ldr, &(taup[0]), N - 1, P);
+
+              NumericT const * data_P = detail::extract_raw_pointer<NumericT>(P);
+              std::size_t ldp = P.internal_size1();
+              for (std::size_t j = 0; j < N - 1; ++j)
+                for (std::size_t i = 0; i < N - 1; ++i)
+                  data_V[(i + 1) + (j + 1) * ldv] = data_P[i + j * ldp];
+            }
+          }
+
+          svd_bidiag_qr(sigma, e, U, V);
+        }
+
+        /** @brief Copies A into the column-major work matrix W if transposed is false, and trans(A) otherwise. */
+        template <typename NumericT, typename F>
+        void svd_setup_work_matrix(matrix_base<NumericT, F> const & A, viennacl::matrix<NumericT, viennacl::column_major> & W, bool transposed)
+        {
+          NumericT const * data_A = detail::extract_raw_pointer<NumericT>(A);
+          detail::matrix_array_wrapper<NumericT const, typename F::orientation_category, false>
+            wrapper_A(data_A, viennacl::traits::start1(A), viennacl::traits::start2(A),
+                              viennacl::traits::stride1(A), viennacl::traits::stride2(A),
+                              viennacl::traits::internal_size1(A), viennacl::traits::internal_size2(A));
+
+          NumericT * data_W = detail::extract_raw_pointer<NumericT>(W);
+          std::size_t ldw = W.internal_size1();
+
+          for (std::size_t j = 0; j < viennacl::traits::size2(A); ++j)
+            for (std::size_t i = 0; i < viennacl::traits::size1(A); ++i)
+            {
+              if (transposed)
+                data_W[j + i * ldw] = wrapper_A(i, j);
+              else
+                data_W[i + j * ldw] = wrapper_A(i, j);
+            }
+        }
+
+        /** @brief Copies the column-major matrix Q to the matrix B */
+        template <typename NumericT, typename F>
+        void svd_copy_result(viennacl::matrix<NumericT, viennacl::column_major> const & Q, matrix_base<NumericT, F> & B)
+        {
+          NumericT const * data_Q = detail::extract_raw_pointer<NumericT>(Q);
+          std::size_t ldq = Q.internal_size1();
+
+          NumericT * data_B = detail::extract_raw_pointer<NumericT>(B);
+          detail::matrix_array_wrapper<NumericT, typename F::orientation_category, false>
+            wrapper_B(data_B, viennacl::traits::start1(B), viennacl::traits::start2(B),
+                              viennacl::traits::stride1(B), viennacl::traits::stride2(B),
+                              viennacl::traits::internal_size1(B), viennacl::traits::internal_size2(B));
+
+          std::size_t size1 = std::min(Q.size1(), viennacl::traits::size1(B));
+          std::size_t size2 = std::min(Q.size2(), viennacl::traits::size2(B));
+          for (std::size_t i = 0; i < size1; ++i)
+            for (std::size_t j = 0; j < size2; ++j)
+              wrapper_B(i, j) = data_Q[i + j * ldq];
+        }
+
+      } //namespace detail
+
+
+      /** @brief Computes the singular value decomposition A = QL * Sigma * QR^T.
+      *
+      * @param A     The input matrix. Will be overwritten with the diagonal matrix Sigma holding the singular values in descending order
+      * @param QL    The left orthogonal matrix
+      * @param QR    The right orthogonal matrix
+      */
+      template <typename NumericT, typename F1, typename F2, typename F3>
+      void svd(matrix_base<NumericT, F1> & A,
+               matrix_base<NumericT, F2> & QL,
+               matrix_base<NumericT, F3> & QR)
+      {
+        typedef viennacl::matrix<NumericT, viennacl::column_major>   MatrixType;
+
+        viennacl::context ctx(viennacl::MAIN_MEMORY);
+
+        bool transposed = viennacl::traits::size1(A) < viennacl::traits::size2(A);
+        MatrixType W(std::max(viennacl::traits::size1(A), viennacl::traits::size2(A)),
+                     std::min(viennacl::traits::size1(A), viennacl::traits::size2(A)), ctx);
+        detail::svd_setup_work_matrix(A, W, transposed);
+
+        MatrixType U(W.size1(), W.size1(), ctx);
+        MatrixType V(W.size2(), W.size2(), ctx);
+        std::vector<NumericT> sigma;
+
+        detail::svd_impl(W, sigma, &U, &V);
+
+        // A^T = U Sigma V^T implies A = V Sigma^T U^T:
+        detail::svd_copy_result(transposed ? V : U, QL);
+        detail::svd_copy_result(transposed ? U : V, QR);
+
+        NumericT * data_A = detail::extract_raw_pointer<NumericT>(A);
+        detail::matrix_array_wrapper<NumericT, typename F1::orientation_category, false>
+          wrapper_A(data_A, viennacl::traits::start1(A), viennacl::traits::start2(A),
+                            viennacl::traits::stride1(A), viennacl::traits::stride2(A),
+                            viennacl::traits::internal_size1(A), viennacl::traits::internal_size2(A));
+
+        for (std::size_t i = 0; i < viennacl::traits::size1(A); ++i)
+          for (std::size_t j = 0; j < viennacl::traits::size2(A); ++j)
+            wrapper_A(i, j) = (i == j) ? sigma[i] : NumericT(0);
+      }
+
+      /** @brief Computes the singular values of A in descending order. Singular vectors are not computed.
+      *
+      * @param A                 The input matrix
+      * @param singular_values   The singular values (output)
+      */
+      template <typename NumericT, typename F>
+      void svd(matrix_base<NumericT, F> const & A,
+               std::vector<NumericT> & singular_values)
+      {
+        bool transposed = viennacl::traits::size1(A) < viennacl::traits::size2(A);
+        viennacl::matrix<NumericT, viennacl::column_major> W(std::max(viennacl::traits::size1(A), viennacl::traits::size2(A)),
+                                                             std::min(viennacl::traits::size1(A), viennacl::traits::size2(A)),
+                                                             viennacl::context(viennacl::MAIN_MEMORY));
+        detail::svd_setup_work_matrix(A, W, transposed);
+        detail::svd_impl(W, singular_values,
+                         static_cast<viennacl::matrix<NumericT, viennacl::column_major> *>(NULL),
+                         static_cast<viennacl::matrix<NumericT, viennacl::column_major> *>(NULL));
+      }
+
+    } // namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,325 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_TSQR_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_TSQR_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/tsqr_operations.hpp
+    @brief Implementations of the communication-avoiding tall-skinny QR factorization (TSQR) using a single CPU thread or OpenMP.
+
+    The rows of the matrix are split into blocks, each of which is factored independently. The resulting triangular factors are
+    combined pairwise in a binary reduction tree. The orthogonal factor is kept in implicit form as the reflectors of the blocks and of the tree nodes.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/householder.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      /** @brief Implicit representation of the orthogonal factor Q of a TSQR factorization.
+      *
+      * Q is the product of the block diagonal matrix holding the orthogonal factors of the row blocks and the orthogonal factors of the tree nodes.
+      * Factor i < num_blocks refers to row block i, factor num_blocks + j refers to tree node j. The reflectors are stored column-major as obtained from detail::householder_qr().
+      */
+      template <typename NumericT>
+      struct tsqr_factors
+      {
+        tsqr_factors() : size1(0), size2(0) {}
+
+        std::size_t size1;                                  ///< Number of rows of the factored matrix
+        std::size_t size2;                                  ///< Number of columns of the factored matrix
+        std::vector<std::size_t> block_offsets;             ///< First row of each row block, followed by size1
+        std::vector<std::size_t> node_left;                 ///< The row block holding the upper factor of each tree node. Also receives the combined factor.
+        std::vector<std::size_t> node_right;                ///< The row block holding the lower factor of each tree node
+        std::vector<std::size_t> level_offsets;             ///< First tree node of each level of the reduction tree, followed by the number of nodes
+        std::vector<std::vector<NumericT> > reflectors;     ///< Householder reflectors of the row blocks and tree nodes
+        std::vector<std::vector<NumericT> > tau;            ///< Scalar factors of the reflectors
+      };
+
+      namespace detail
+      {
+        /** @brief Copies the rows [row_start, row_start + num_rows) of the matrix at data to the rows [local_row, local_row + num_rows) of B. Entry (i, j) is located at data[i * inc_row + j * inc_col]. */
+        template <typename NumericT>
+        void tsqr_gather_rows(NumericT const * data, std::size_t inc_row, std::size_t inc_col,
+                              std::size_t row_start, std::size_t num_rows,
+                              viennacl::matrix<NumericT, viennacl::column_major> & B, std::size_t local_row)
+        {
+          NumericT * data_B = detail::extract_raw_pointer<NumericT>(B);
+          std::size_t ldb = B.internal_size1();
+          for (std::size_t j=0; j<B.size2(); ++j)
+            for (std::size_t i=0; i<num_rows; ++i)
+              data_B[local_row + i + j * ldb] = data[(row_start + i) * inc_row + j * inc_col];
+        }
+
+        /** @brief Copies the rows [local_row, local_row + num_rows) of B back to the rows [row_start, row_start + num_rows) of the matrix at data. */
+        template <typename NumericT>
+        void tsqr_scatter_rows(viennacl::matrix<NumericT, viennacl::column_major> const & B, std::size_t local_row,
+                               NumericT * data, std::size_t inc_row, std::size_t inc_col,
+                               std::size_t row_start, std::size_t num_rows)
+        {
+          NumericT const * data_B = detail::extract_raw_pointer<NumericT>(B);
+          std::size_t ldb = B.internal_size1();
+          for (std::size_t j=0; j<B.size2(); ++j)
+            for (std::size_t i=0; i<num_rows; ++i)
+              data[(row_start + i) * inc_row + j * inc_col] = data_B[local_row + i + j * ldb];
+        }
+
+        /** @brief Computes the Householder QR factorization of B and stores the reflectors as well as the n x n upper triangular factor (column-major) */
+        template <typename NumericT>
+        void tsqr_factor_block(viennacl::matrix<NumericT, viennacl::column_major> & B,
+                               std::vector<NumericT> & reflectors, std::vector<NumericT> & tau,
+                               std::vector<NumericT> & R)
+        {
+          std::size_t rows = B.size1();
+          std::size_t n    = B.size2();
+
+          viennacl::linalg::host_based::detail::householder_qr(B, tau);
+
+          NumericT const * data_B = detail::extract_raw_pointer<NumericT>(B);
+          std::size_t ldb = B.internal_size1();
+
+          reflectors.resize(rows * n);
+          for (std::size_t j=0; j<n; ++j)
+            for (std::size_t i=0; i<rows; ++i)
+              reflectors[i + j * rows] = data_B[i + j * ldb];
+
+          R.resize(n * n);
+          for (std::size_t j=0; j<n; ++j)
+            for (std::size_t i=0; i<n; ++i)
+              R[i + j * n] = (i <= j) ? data_B[i + j * ldb] : NumericT(0);
+        }
+
+        /** @brief Applies the orthogonal factor of a row block or a tree node (or its transpose) to B. */
+        template <typename NumericT>
+        void tsqr_apply_factor(std::vector<NumericT> const & reflectors, std::vector<NumericT> const & tau,
+                               viennacl::matrix<NumericT, viennacl::column_major> & B, bool transposed)
+        {
+          if (transposed)
+            householder_apply_qt(&(reflectors[0]), B.size1(), &(tau[0]), tau.size(), B);
+          else
+            householder_apply_q(&(reflectors[0]), B.size1(), &(tau[0]), tau.size(), B);
+        }
+      } //namespace detail
+
+
+      /** @brief Computes the TSQR factorization A = Q * R of a tall-skinny matrix with at least as many rows as columns.
+      *
+      * The row blocks and the nodes of each level of the reduction tree are processed in parallel if OpenMP is enabled.
+      *
+      * @param A           The m x n matrix to be factored. A is not modified.
+      * @param R           The n x n upper triangular factor (output)
+      * @param factors     The implicit representation of the m x n orthogonal factor Q (output)
+      * @param num_blocks  Number of row blocks. If zero, the number of OpenMP threads is used. Each block holds at least n rows.
+      */
+      template <typename NumericT, typename F>
+      void tsqr_factorize(viennacl::matrix<NumericT, F> const & A,
+                          viennacl::matrix<NumericT, F> & R,
+                          tsqr_factors<NumericT> & factors,
+                          std::size_t num_blocks = 0)
+      {
+        typedef viennacl::matrix<NumericT, viennacl::column_major>   HostMatrixType;
+
+        std::size_t m = A.size1();
+        std::size_t n = A.size2();
+
+        assert(m >= n && n > 0 && bool("TSQR requires at least as many rows as columns"));
+        assert(R.size1() == n && R.size2() == n && bool("Size of R does not match"));
+
+        if (num_blocks == 0)
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          num_blocks = static_cast<std::size_t>(omp_get_max_threads());
+#else
+          num_blocks = 1;
+#endif
+        }
+        std::size_t p = std::max<std::size_t>(1, std::min(num_blocks, m / n));
+
+        factors.size1 = m;
+        factors.size2 = n;
+
+        factors.block_offsets.resize(p + 1);
+        for (std::size_t i=0; i<=p; ++i)
+          factors.block_offsets[i] = i * (m / p) + std::min(i, m % p);
+
+        // binary reduction tree:
+        factors.node_left.clear();
+        factors.node_right.clear();
+        factors.level_offsets.clear();
+        for (std::size_t stride = 1; stride < p; stride *= 2)
+        {
+          factors.level_offsets.push_back(factors.node_left.size());
+          for (std::size_t i = 0; i + stride < p; i += 2 * stride)
+          {
+            factors.node_left.push_back(i);
+            factors.node_right.push_back(i + stride);
+          }
+        }
+        factors.level_offsets.push_back(factors.node_left.size());
+
+        std::size_t num_nodes = factors.node_left.size();
+        factors.reflectors.resize(p + num_nodes);
+        factors.tau.resize(p + num_nodes);
+
+        std::vector<std::vector<NumericT> > R_blocks(p);
+
+        NumericT const * data_A = detail::extract_raw_pointer<NumericT>(A);
+        std::size_t inc_row = F::mem_index(1, 0, A.internal_size1(), A.internal_size2()) - F::mem_index(0, 0, A.internal_size1(), A.internal_size2());
+        std::size_t inc_col = F::mem_index(0, 1, A.internal_size1(), A.internal_size2()) - F::mem_index(0, 0, A.internal_size1(), A.internal_size2());
+
+        // factor the row blocks:
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (p > 1)
+#endif
+        for (std::size_t i = 0; i < p; ++i)
+        {
+          std::size_t rows = factors.block_offsets[i+1] - factors.block_offsets[i];
+          HostMatrixType B(rows, n, viennacl::context(viennacl::MAIN_MEMORY));
+          detail::tsqr_gather_rows(data_A, inc_row, inc_col, factors.block_offsets[i], rows, B, 0);
+          detail::tsqr_factor_block(B, factors.reflectors[i], factors.tau[i], R_blocks[i]);
+        }
+
+        // combine the triangular factors level by level:
+        for (std::size_t level = 0; level + 1 < factors.level_offsets.size(); ++level)
+        {
+          std::size_t node_begin = factors.level_offsets[level];
+          std::size_t node_end   = factors.level_offsets[level + 1];
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (node_end - node_begin > 1)
+#endif
+          for (std::size_t node = node_begin; node < node_end; ++node)
+          {
+            std::size_t left  = factors.node_left[node];
+            std::size_t right = factors.node_right[node];
+
+            // stack the two triangular factors:
+            HostMatrixType B(2 * n, n, viennacl::context(viennacl::MAIN_MEMORY));
+            NumericT * data_B = detail::extract_raw_pointer<NumericT>(B);
+            std::size_t ldb = B.internal_size1();
+            for (std::size_t j=0; j<n; ++j)
+              for (std::size_t i=0; i<=j; ++i)
+              {
+                data_B[i     + j * ldb] = R_blocks[left][i + j * n];
+                data_B[n + i + j * ldb] = R_blocks[right][i + j * n];
+              }
+
+            detail::tsqr_factor_block(B, factors.reflectors[p + node], factors.tau[p + node], R_blocks[left]);
+          }
+        }
+
+        NumericT * data_R = detail::extract_raw_pointer<NumericT>(R);
+        std::size_t inc_row_R = F::mem_index(1, 0, R.internal_size1(), R.internal_size2()) - F::mem_index(0, 0, R.internal_size1(), R.internal_size2());
+        std::size_t inc_col_R = F::mem_index(0, 1, R.internal_size1(), R.internal_size2()) - F::mem_index(0, 0, R.internal_size1(), R.internal_size2());
+        for (std::size_t i=0; i<n; ++i)
+          for (std::size_t j=0; j<n; ++j)
+            data_R[i * inc_row_R + j * inc_col_R] = R_blocks[0][i + j * n];
+      }
+
+
+      /** @brief Computes C <- Q * C or C <- Q^T * C for the orthogonal factor Q of a TSQR factorization given in implicit form.
+      *
+      * @param factors     The implicit representation of Q as obtained from tsqr_factorize()
+      * @param C           The matrix to be updated. The number of rows must match the number of rows of the factored matrix.
+      * @param transposed  If true, Q^T is applied instead of Q
+      */
+      template <typename NumericT, typename F>
+      void tsqr_apply_q(tsqr_factors<NumericT> const & factors,
+                        viennacl::matrix<NumericT, F> & C,
+                        bool transposed)
+      {
+        typedef viennacl::matrix<NumericT, viennacl::column_major>   HostMatrixType;
+
+        assert(C.size1() == factors.size1 && bool("Size of C does not match"));
+
+        std::size_t n = factors.size2;
+        std::size_t k = C.size2();
+        std::size_t p = factors.block_offsets.size() - 1;
+        std::size_t num_levels = factors.level_offsets.size() - 1;
+
+        if (k == 0)
+          return;
+
+        NumericT * data_C = detail::extract_raw_pointer<NumericT>(C);
+        std::size_t inc_row = F::mem_index(1, 0, C.internal_size1(), C.internal_size2()) - F::mem_index(0, 0, C.internal_size1(), C.internal_size2());
+        std::size_t inc_col = F::mem_index(0, 1, C.internal_size1(), C.internal_size2()) - F::mem_index(0, 0, C.internal_size1(), C.internal_size2());
+
+        // Q = diag(Q_0, ..., Q_{p-1}) * Q_tree, so Q^T applies the row blocks first and Q applies them last:
+        for (std::size_t step = 0; step < 2; ++step)
+        {
+          if ((step == 0) == transposed)
+          {
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp parallel for if (p > 1)
+#endif
+            for (std::size_t i = 0; i < p; ++i)
+            {
+              std::size_t row_start = factors.block_offsets[i];
+              std::size_t rows      = factors.block_offsets[i+1] - row_start;
+
+              HostMatrixType B(rows, k, viennacl::context(viennacl::MAIN_MEMORY));
+              detail::tsqr_gather_rows(data_C, inc_row, inc_col, row_start, rows, B, 0);
+              detail::tsqr_apply_factor(factors.reflectors[i], factors.tau[i], B, transposed);
+              detail::tsqr_scatter_rows(B, 0, data_C, inc_row, inc_col, row_start, rows);
+            }
+          }
+          else
+          {
+            for (std::size_t l = 0; l < num_levels; ++l)
+            {
+              std::size_t level = transposed ? l : num_levels - l - 1;
+
+#ifdef VIENNACL_WITH_OPENMP
+              #pragma omp parallel for if (factors.level_offsets[level + 1] - factors.level_offsets[level] > 1)
+#endif
+              for (std::size_t node = factors.level_offsets[level]; node < factors.level_offsets[level + 1]; ++node)
+              {
+                std::size_t row_left  = factors.block_offsets[factors.node_left[node]];
+                std::size_t row_right = factors.block_offsets[factors.node_right[node]];
+
+                HostMatrixType B(2 * n, k, viennacl::context(viennacl::MAIN_MEMORY));
+                detail::tsqr_gather_rows(data_C, inc_row, inc_col, row_left,  n, B, 0);
+                detail::tsqr_gather_rows(data_C, inc_row, inc_col, row_right, n, B, n);
+                detail::tsqr_apply_factor(factors.reflectors[p + node], factors.tau[p + node], B, transposed);
+                detail::tsqr_scatter_rows(B, 0, data_C, inc_row, inc_col, row_left,  n);
+                detail::tsqr_scatter_rows(B, n, data_C, inc_row, inc_col, row_right, n);
+              }
+            }
+          }
+        }
+      }
+
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
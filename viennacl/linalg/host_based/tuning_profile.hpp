@@ -0,0 +1,174 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_TUNING_PROFILE_HPP_
+#define VIENNACL_LINALG_HOST_BASED_TUNING_PROFILE_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/tuning_profile.hpp
+    @brief Blocking and threading parameters of the host-based kernels, which can be tuned for the running machine.
+
+    The parameters are loaded from a profile file when first accessed. The file is given by the environment variable VIENNACL_HOST_PROFILE,
+    otherwise $HOME/.viennacl/host_profile_<hostname>.txt is used if it exists. Profiles are written by examples/autotuner/host_autotuning.cpp.
+    Each line of a profile holds a parameter name followed by its value. Lines starting with '#' are ignored, as are unknown parameters.
+*/
+
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+
+#ifndef _WIN32
+  #include <unistd.h>
+#endif
+
+// Minimum vector size for using OpenMP on vector operations, used unless a profile provides a different value:
+#ifndef VIENNACL_OPENMP_VECTOR_MIN_SIZE
+  #define VIENNACL_OPENMP_VECTOR_MIN_SIZE  5000
+#endif
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      /** @brief Tunable parameters of the host-based kernels. */
+      class tuning_profile
+      {
+        public:
+          tuning_profile() : vector_min_size(VIENNACL_OPENMP_VECTOR_MIN_SIZE),
+                             gemm_block_size(64),
+                             spmv_chunk_size(0),
+                             lu_block_size(32),
+                             cholesky_block_size(32),
+                             qr_block_size(32),
+                             tred2_block_size(16) {}
+
+          /** @brief Reads the parameters from the supplied file. Parameters not found in the file keep their values.
+          *
+          * @return false if the file cannot be read
+          */
+          bool load(std::string const & filename)
+          {
+            std::ifstream stream(filename.c_str());
+            if (!stream)
+              return false;
+
+            std::string line;
+            while (std::getline(stream, line))
+            {
+              std::istringstream line_stream(line);
+              std::string name;
+              std::size_t value;
+              if (!(line_stream >> name) || name[0] == '#' || !(line_stream >> value))
+                continue;
+
+              if      (name == "vector_min_size")  vector_min_size  = value;
+              else if (name == "gemm_block_size")  gemm_block_size  = value;
+              else if (name == "spmv_chunk_size")  spmv_chunk_size  = value;
+              else if (name == "lu_block_size")    lu_block_size    = value;
+              else if (name == "cholesky_block_size") cholesky_block_size = value;
+              else if (name == "qr_block_size")    qr_block_size    = value;
+              else if (name == "tred2_block_size") tred2_block_size = value;
+            }
+            filename_ = filename;
+            return true;
+          }
+
+          /** @brief Writes the parameters to the supplied file.
+          *
+          * @return false if the file cannot be written
+          */
+          bool save(std::string const & filename) const
+          {
+            std::ofstream stream(filename.c_str());
+            stream << "# ViennaCL host tuning profile" << std::endl;
+            stream << "vector_min_size "  << vector_min_size  << std::endl;
+            stream << "gemm_block_size "  << gemm_block_size  << std::endl;
+            stream << "spmv_chunk_size "  << spmv_chunk_size  << std::endl;
+            stream << "lu_block_size "    << lu_block_size    << std::endl;
+            stream << "cholesky_block_size " << cholesky_block_size << std::endl;
+            stream << "qr_block_size "    << qr_block_size    << std::endl;
+            stream << "tred2_block_size " << tred2_block_size << std::endl;
+            return stream.good();
+          }
+
+          /** @brief File the profile was loaded from. Empty if the built-in defaults are used. */
+          std::string const & filename() const { return filename_; }
+
+          /** @brief Minimum number of entries for which vector operations are run in parallel with OpenMP */
+          std::size_t vector_min_size;
+          /** @brief Edge length of the square tiles of C computed at once in dense matrix-matrix products */
+          std::size_t gemm_block_size;
+          /** @brief Number of rows per OpenMP work item in sparse matrix-vector products. If zero, the rows are split evenly among the threads. */
+          std::size_t spmv_chunk_size;
+          /** @brief Panel width of the LU factorization */
+          std::size_t lu_block_size;
+          /** @brief Panel width of the dense Cholesky factorization */
+          std::size_t cholesky_block_size;
+          /** @brief Panel width of the QR factorization of ViennaCL matrices */
+          std::size_t qr_block_size;
+          /** @brief Band width used by the reduction to tridiagonal form in the symmetric eigenvalue solver */
+          std::size_t tred2_block_size;
+
+        private:
+          std::string filename_;
+      };
+
+      /** @brief Returns the default location of the profile file of the running machine, cf. the description of this file. */
+      inline std::string default_tuning_profile_filename()
+      {
+        char const * filename = std::getenv("VIENNACL_HOST_PROFILE");
+        if (filename != NULL && *filename != '\0')
+          return filename;
+
+        char const * home = std::getenv("HOME");
+        std::string hostname = "default";
+#ifndef _WIN32
+        char buffer[256];
+        if (gethostname(buffer, sizeof(buffer)) == 0)
+        {
+          buffer[sizeof(buffer) - 1] = '\0';
+          hostname = buffer;
+        }
+#endif
+        return std::string(home ? home : ".") + "/.viennacl/host_profile_" + hostname + ".txt";
+      }
+
+      namespace detail
+      {
+        inline tuning_profile load_default_tuning_profile()
+        {
+          tuning_profile profile;
+          profile.load(default_tuning_profile_filename()); //built-in defaults are kept if there is no profile
+          return profile;
+        }
+      }
+
+      /** @brief Returns the profile used by the host-based kernels. The profile file is loaded on first use. */
+      inline tuning_profile & current_tuning_profile()
+      {
+        static tuning_profile profile = detail::load_default_tuning_profile();
+        return profile;
+      }
+
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
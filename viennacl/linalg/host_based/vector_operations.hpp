@@ -33,15 +33,11 @@
 #include "viennacl/traits/size.hpp"
 #include "viennacl/traits/start.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/tuning_profile.hpp"
 #include "viennacl/linalg/detail/op_applier.hpp"
 #include "viennacl/traits/stride.hpp"
 
 
-// Minimum vector size for using OpenMP on vector operations:
-#ifndef VIENNACL_OPENMP_VECTOR_MIN_SIZE
-  #define VIENNACL_OPENMP_VECTOR_MIN_SIZE  5000
-#endif
-
 namespace viennacl
 {
   namespace linalg
@@ -77,7 +73,7 @@ namespace viennacl
         if (reciprocal_alpha)
         {
 #ifdef VIENNACL_WITH_OPENMP
-          #pragma omp parallel for if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+          #pragma omp parallel for if (size1 > current_tuning_profile().vector_min_size)
 #endif
           for (std::size_t i = 0; i < size1; ++i)
             data_vec1[i*inc1+start1] = data_vec2[i*inc2+start2] / data_alpha;
@@ -85,7 +81,7 @@ namespace viennacl
         else
         {
 #ifdef VIENNACL_WITH_OPENMP
-          #pragma omp parallel for if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+          #pragma omp parallel for if (size1 > current_tuning_profile().vector_min_size)
 #endif
           for (std::size_t i = 0; i < size1; ++i)
             data_vec1[i*inc1+start1] = data_vec2[i*inc2+start2] * data_alpha;
@@ -127,7 +123,7 @@ namespace viennacl
           if (reciprocal_beta)
           {
 #ifdef VIENNACL_WITH_OPENMP
-            #pragma omp parallel for if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+            #pragma omp parallel for if (size1 > current_tuning_profile().vector_min_size)
 #endif
             for (std::size_t i = 0; i < size1; ++i)
               data_vec1[i*inc1+start1] = data_vec2[i*inc2+start2] / data_alpha + data_vec3[i*inc3+start3] / data_beta;
@@ -135,7 +131,7 @@ namespace viennacl
           else
           {
 #ifdef VIENNACL_WITH_OPENMP
-            #pragma omp parallel for if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+            #pragma omp parallel for if (size1 > current_tuning_profile().vector_min_size)
 #endif
             for (std::size_t i = 0; i < size1; ++i)
               data_vec1[i*inc1+start1] = data_vec2[i*inc2+start2] / data_alpha + data_vec3[i*inc3+start3] * data_beta;
@@ -146,7 +142,7 @@ namespace viennacl
           if (reciprocal_beta)
           {
 #ifdef VIENNACL_WITH_OPENMP
-            #pragma omp parallel for if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+            #pragma omp parallel for if (size1 > current_tuning_profile().vector_min_size)
 #endif
             for (std::size_t i = 0; i < size1; ++i)
               data_vec1[i*inc1+start1] = data_vec2[i*inc2+start2] * data_alpha + data_vec3[i*inc3+start3] / data_beta;
@@ -154,7 +150,7 @@ namespace viennacl
           else
           {
 #ifdef VIENNACL_WITH_OPENMP
-            #pragma omp parallel for if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+            #pragma omp parallel for if (size1 > current_tuning_profile().vector_min_size)
 #endif
             for (std::size_t i = 0; i < size1; ++i)
               data_vec1[i*inc1+start1] = data_vec2[i*inc2+start2] * data_alpha + data_vec3[i*inc3+start3] * data_beta;
@@ -197,7 +193,7 @@ namespace viennacl
           if (reciprocal_beta)
           {
 #ifdef VIENNACL_WITH_OPENMP
-            #pragma omp parallel for if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+            #pragma omp parallel for if (size1 > current_tuning_profile().vector_min_size)
 #endif
             for (std::size_t i = 0; i < size1; ++i)
               data_vec1[i*inc1+start1] += data_vec2[i*inc2+start2] / data_alpha + data_vec3[i*inc3+start3] / data_beta;
@@ -205,7 +201,7 @@ namespace viennacl
           else
           {
 #ifdef VIENNACL_WITH_OPENMP
-            #pragma omp parallel for if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+            #pragma omp parallel for if (size1 > current_tuning_profile().vector_min_size)
 #endif
             for (std::size_t i = 0; i < size1; ++i)
               data_vec1[i*inc1+start1] += data_vec2[i*inc2+start2] / data_alpha + data_vec3[i*inc3+start3] * data_beta;
@@ -216,7 +212,7 @@ namespace viennacl
           if (reciprocal_beta)
           {
 #ifdef VIENNACL_WITH_OPENMP
-            #pragma omp parallel for if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+            #pragma omp parallel for if (size1 > current_tuning_profile().vector_min_size)
 #endif
             for (std::size_t i = 0; i < size1; ++i)
               data_vec1[i*inc1+start1] += data_vec2[i*inc2+start2] * data_alpha + data_vec3[i*inc3+start3] / data_beta;
@@ -224,7 +220,7 @@ namespace viennacl
           else
           {
 #ifdef VIENNACL_WITH_OPENMP
-            #pragma omp parallel for if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+            #pragma omp parallel for if (size1 > current_tuning_profile().vector_min_size)
 #endif
             for (std::size_t i = 0; i < size1; ++i)
               data_vec1[i*inc1+start1] += data_vec2[i*inc2+start2] * data_alpha + data_vec3[i*inc3+start3] * data_beta;
@@ -256,7 +252,7 @@ namespace viennacl
         value_type data_alpha = static_cast<value_type>(alpha);
 
 #ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for if (loop_bound > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+        #pragma omp parallel for if (loop_bound > current_tuning_profile().vector_min_size)
 #endif
         for (std::size_t i = 0; i < loop_bound; ++i)
           data_vec1[i*inc1+start1] = data_alpha;
@@ -284,7 +280,7 @@ namespace viennacl
         std::size_t inc2   = viennacl::traits::stride(vec2);
 
 #ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+        #pragma omp parallel for if (size1 > current_tuning_profile().vector_min_size)
 #endif
         for (std::size_t i = 0; i < size1; ++i)
         {
@@ -324,7 +320,7 @@ namespace viennacl
         std::size_t inc3   = viennacl::traits::stride(proxy.rhs());
 
 #ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+        #pragma omp parallel for if (size1 > current_tuning_profile().vector_min_size)
 #endif
         for (std::size_t i = 0; i < size1; ++i)
           OpFunctor::apply(data_vec1[i*inc1+start1], data_vec2[i*inc2+start2], data_vec3[i*inc3+start3]);
@@ -353,7 +349,7 @@ namespace viennacl
         std::size_t inc2   = viennacl::traits::stride(proxy.lhs());
 
 #ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+        #pragma omp parallel for if (size1 > current_tuning_profile().vector_min_size)
 #endif
         for (std::size_t i = 0; i < size1; ++i)
           OpFunctor::apply(data_vec1[i*inc1+start1], data_vec2[i*inc2+start2]);
@@ -391,7 +387,7 @@ namespace viennacl
         value_type temp = 0;
 
 #ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for reduction(+: temp) if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+        #pragma omp parallel for reduction(+: temp) if (size1 > current_tuning_profile().vector_min_size)
 #endif
         for (std::size_t i = 0; i < size1; ++i)
           temp += data_vec1[i*inc1+start1] * data_vec2[i*inc2+start2];
@@ -457,7 +453,7 @@ namespace viennacl
         value_type temp = 0;
 
 #ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for reduction(+: temp) if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+        #pragma omp parallel for reduction(+: temp) if (size1 > current_tuning_profile().vector_min_size)
 #endif
         for (std::size_t i = 0; i < size1; ++i)
           temp += std::fabs(data_vec1[i*inc1+start1]);
@@ -486,7 +482,7 @@ namespace viennacl
         value_type data = 0;
 
 #ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for reduction(+: temp) private(data) if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+        #pragma omp parallel for reduction(+: temp) private(data) if (size1 > current_tuning_profile().vector_min_size)
 #endif
         for (std::size_t i = 0; i < size1; ++i)
         {
@@ -593,7 +589,7 @@ namespace viennacl
         value_type data_beta  = beta;
 
 #ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for private(temp1, temp2) if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+        #pragma omp parallel for private(temp1, temp2) if (size1 > current_tuning_profile().vector_min_size)
 #endif
         for (std::size_t i = 0; i < size1; ++i)
         {
@@ -28,6 +28,8 @@
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/compressed_matrix.hpp"
+#include "viennacl/symmetric_compressed_matrix.hpp"
+#include "viennacl/linalg/detail/ilu/chow_patel.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
 
@@ -40,7 +42,27 @@ namespace viennacl
 
     /** @brief A tag for incomplete Cholesky factorization with static pattern (ILU0)
     */
-    class ichol0_tag {};
+    class ichol0_tag
+    {
+      public:
+        /** @brief The constructor.
+        *
+        * @param num_sweeps        If nonzero, the factor is computed by the given number of fine-grained parallel sweeps (Chow-Patel) instead of the sequential algorithm.
+        * @param num_jacobi_iters  If nonzero, the triangular substitutions are replaced by the given number of Jacobi iterations.
+        */
+        ichol0_tag(std::size_t num_sweeps = 0,
+                   std::size_t num_jacobi_iters = 0) : sweeps_(num_sweeps), jacobi_iters_(num_jacobi_iters) {}
+
+        std::size_t sweeps() const { return sweeps_; }
+        void sweeps(std::size_t num) { sweeps_ = num; }
+
+        std::size_t jacobi_iters() const { return jacobi_iters_; }
+        void jacobi_iters(std::size_t num) { jacobi_iters_ = num; }
+
+      private:
+        std::size_t sweeps_;
+        std::size_t jacobi_iters_;
+    };
 
 
     /** @brief Implementation of a ILU-preconditioner with static pattern. Optimized version for CSR matrices.
@@ -48,14 +70,22 @@ namespace viennacl
       *  Refer to Chih-Jen Lin and Jorge J. Moré, Incomplete Cholesky Factorizations with Limited Memory, SIAM J. Sci. Comput., 21(1), 24–45
       *  for one of many descriptions of incomplete Cholesky Factorizations
       *
+      *  If a number of sweeps is set in the tag, the factor is computed by the fine-grained parallel algorithm instead.
+      *
       *  @param A       The input matrix in CSR format
-      *  // param tag     An ichol0_tag in order to dispatch among several other preconditioners.
+      *  @param tag     An ichol0_tag in order to dispatch among several other preconditioners.
       */
     template<typename ScalarType>
-    void precondition(viennacl::compressed_matrix<ScalarType> & A, ichol0_tag const & /* tag */)
+    void precondition(viennacl::compressed_matrix<ScalarType> & A, ichol0_tag const & tag)
     {
       assert( (viennacl::traits::context(A).memory_type() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ICHOL0") );
 
+      if (tag.sweeps() > 0)
+      {
+        detail::chow_patel_ichol0(A, tag.sweeps());
+        return;
+      }
+
       ScalarType         * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(A.handle());
       unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
       unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
@@ -159,7 +189,7 @@ namespace viennacl
           viennacl::linalg::precondition(LLT, tag_);
         }
 
-        ichol0_tag const & tag_;
+        ichol0_tag tag_;
         viennacl::compressed_matrix<ScalarType> LLT;
     };
 
@@ -184,7 +214,12 @@ namespace viennacl
 
         void apply(vector<ScalarType> & vec) const
         {
-          if (viennacl::traits::context(vec).memory_type() != viennacl::MAIN_MEMORY)
+          if (tag_.jacobi_iters() > 0)
+          {
+            detail::jacobi_substitute(jacobi_L_, jacobi_diagonal_, vec, tag_.jacobi_iters());
+            detail::jacobi_substitute(jacobi_U_, jacobi_diagonal_, vec, tag_.jacobi_iters());
+          }
+          else if (viennacl::traits::context(vec).memory_type() != viennacl::MAIN_MEMORY)
           {
             viennacl::context host_ctx(viennacl::MAIN_MEMORY);
             viennacl::context old_ctx = viennacl::traits::context(vec);
@@ -210,10 +245,98 @@ namespace viennacl
           LLT = mat;
 
           viennacl::linalg::precondition(LLT, tag_);
+
+          if (tag_.jacobi_iters() > 0)
+          {
+            detail::jacobi_substitute_setup(LLT, jacobi_L_, jacobi_U_, jacobi_diagonal_, true);
+            viennacl::switch_memory_context(jacobi_L_, viennacl::traits::context(mat));
+            viennacl::switch_memory_context(jacobi_U_, viennacl::traits::context(mat));
+            viennacl::switch_memory_context(jacobi_diagonal_, viennacl::traits::context(mat));
+          }
+        }
+
+        ichol0_tag tag_;
+        viennacl::compressed_matrix<ScalarType> LLT;
+
+        viennacl::compressed_matrix<ScalarType> jacobi_L_;
+        viennacl::compressed_matrix<ScalarType> jacobi_U_;
+        viennacl::vector<ScalarType> jacobi_diagonal_;
+    };
+
+
+    /** @brief Incomplete Cholesky preconditioner class with static pattern (ICHOL0), can be supplied to solve()-routines.
+      *
+      *  Specialization for symmetric_compressed_matrix. Since the factorization only operates on the upper triangular part, the stored entries are used directly.
+      */
+    template <typename ScalarType>
+    class ichol0_precond< symmetric_compressed_matrix<ScalarType> >
+    {
+        typedef symmetric_compressed_matrix<ScalarType>   MatrixType;
+
+      public:
+        ichol0_precond(MatrixType const & mat, ichol0_tag const & tag) : tag_(tag), LLT(mat.size1(), mat.size2(), viennacl::traits::context(mat))
+        {
+          init(mat);
+        }
+
+        void apply(vector<ScalarType> & vec) const
+        {
+          if (tag_.jacobi_iters() > 0)
+          {
+            detail::jacobi_substitute(jacobi_L_, jacobi_diagonal_, vec, tag_.jacobi_iters());
+            detail::jacobi_substitute(jacobi_U_, jacobi_diagonal_, vec, tag_.jacobi_iters());
+          }
+          else if (viennacl::traits::context(vec).memory_type() != viennacl::MAIN_MEMORY)
+          {
+            viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+            viennacl::context old_ctx = viennacl::traits::context(vec);
+
+            viennacl::switch_memory_context(vec, host_ctx);
+            viennacl::linalg::inplace_solve(trans(LLT), vec, lower_tag());
+            viennacl::linalg::inplace_solve(      LLT , vec, upper_tag());
+            viennacl::switch_memory_context(vec, old_ctx);
+          }
+          else //apply ICHOL0 directly:
+          {
+            viennacl::linalg::inplace_solve(trans(LLT), vec, lower_tag());
+            viennacl::linalg::inplace_solve(      LLT , vec, upper_tag());
+          }
+        }
+
+      private:
+        void init(MatrixType const & mat)
+        {
+          viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+          viennacl::switch_memory_context(LLT, host_ctx);
+
+          // the upper triangular part of mat is in CSR format already:
+          viennacl::backend::typesafe_host_array<unsigned int> row_buffer(mat.handle1(), mat.size1() + 1);
+          viennacl::backend::typesafe_host_array<unsigned int> col_buffer(mat.handle2(), mat.nnz());
+          std::vector<ScalarType> elements(mat.nnz());
+
+          viennacl::backend::memory_read(mat.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+          viennacl::backend::memory_read(mat.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+          viennacl::backend::memory_read(mat.handle(),  0, sizeof(ScalarType) * elements.size(), &(elements[0]));
+
+          LLT.set(row_buffer.get(), col_buffer.get(), &(elements[0]), mat.size1(), mat.size2(), mat.nnz());
+
+          viennacl::linalg::precondition(LLT, tag_);
+
+          if (tag_.jacobi_iters() > 0)
+          {
+            detail::jacobi_substitute_setup(LLT, jacobi_L_, jacobi_U_, jacobi_diagonal_, true);
+            viennacl::switch_memory_context(jacobi_L_, viennacl::traits::context(mat));
+            viennacl::switch_memory_context(jacobi_U_, viennacl::traits::context(mat));
+            viennacl::switch_memory_context(jacobi_diagonal_, viennacl::traits::context(mat));
+          }
         }
 
-        ichol0_tag const & tag_;
+        ichol0_tag tag_;
         viennacl::compressed_matrix<ScalarType> LLT;
+
+        viennacl::compressed_matrix<ScalarType> jacobi_L_;
+        viennacl::compressed_matrix<ScalarType> jacobi_U_;
+        viennacl::vector<ScalarType> jacobi_diagonal_;
     };
 
   }
@@ -33,8 +33,7 @@
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/io/matrix_market.hpp"
 #include "viennacl/linalg/bisect.hpp"
-#include <boost/random.hpp>
-#include <boost/random/mersenne_twister.hpp>
+#include "viennacl/rand/uniform.hpp"
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/matrix_proxy.hpp>
 #include <boost/numeric/ublas/matrix_expression.hpp>
@@ -111,6 +110,49 @@ namespace viennacl
 
     namespace detail
     {
+      /** @brief Host-side stream of standard normally distributed numbers based on the counter-based generator in viennacl/rand/utils.hpp */
+      template <typename NumericT>
+      class random_normal_stream
+      {
+        public:
+          random_normal_stream(unsigned int seed = 0) : seed_(seed), block_(0), num_values_(0), index_(0) {}
+
+          NumericT operator()()
+          {
+            if (index_ == num_values_)
+            {
+              num_values_ = viennacl::rand::detail::philox_block(block_++, seed_, true, values_);
+              index_ = 0;
+            }
+            return values_[index_++];
+          }
+
+        private:
+          unsigned int seed_;
+          std::size_t block_;
+          std::size_t num_values_;
+          std::size_t index_;
+          NumericT values_[4];
+      };
+
+      /** @brief Fills the start vector with uniformly distributed random numbers in [-1, 1) directly in the memory of the vector */
+      template <typename T, unsigned int A>
+      void random_start_vector(viennacl::vector<T, A> & r)
+      {
+        viennacl::rand::generate(r, viennacl::rand::uniform_tag(-1, 1));
+      }
+
+      /** @brief Fills the start vector with uniformly distributed random numbers in [-1, 1) for vector types from other libraries */
+      template <typename VectorT>
+      void random_start_vector(VectorT & r)
+      {
+        typedef typename viennacl::result_of::cpu_value_type<typename VectorT::value_type>::type    CPU_ScalarType;
+
+        viennacl::vector<CPU_ScalarType> temp(r.size(), viennacl::context(viennacl::MAIN_MEMORY));
+        viennacl::rand::generate(temp, viennacl::rand::uniform_tag(-1, 1));
+        copy_vec_to_vec(temp, r);
+      }
+
       /**
       *   @brief Implementation of the Lanczos PRO algorithm
       *
@@ -133,14 +175,7 @@ namespace viennacl
 
 
         // generation of some random numbers, used for lanczos PRO algorithm
-        boost::mt11213b mt;
-        boost::normal_distribution<CPU_ScalarType> N(0, 1);
-        boost::bernoulli_distribution<CPU_ScalarType> B(0.5);
-        boost::triangle_distribution<CPU_ScalarType> T(-1, 0, 1);
-
-        boost::variate_generator<boost::mt11213b&, boost::normal_distribution<CPU_ScalarType> >     get_N(mt, N);
-        boost::variate_generator<boost::mt11213b&, boost::bernoulli_distribution<CPU_ScalarType> >  get_B(mt, B);
-        boost::variate_generator<boost::mt11213b&, boost::triangle_distribution<CPU_ScalarType> >   get_T(mt, T);
+        random_normal_stream<CPU_ScalarType> get_N;
 
 
         long i, j, k, index, retry, reorths;
@@ -439,24 +474,11 @@ namespace viennacl
       typedef typename viennacl::result_of::cpu_value_type<ScalarType>::type    CPU_ScalarType;
       typedef typename viennacl::result_of::vector_for_matrix<MatrixT>::type    VectorT;
 
-      boost::mt11213b mt;
-      boost::normal_distribution<CPU_ScalarType> N(0, 1);
-      boost::bernoulli_distribution<CPU_ScalarType> B(0.5);
-      boost::triangle_distribution<CPU_ScalarType> T(-1, 0, 1);
-
-      boost::variate_generator<boost::mt11213b&, boost::normal_distribution<CPU_ScalarType> >     get_N(mt, N);
-      boost::variate_generator<boost::mt11213b&, boost::bernoulli_distribution<CPU_ScalarType> >  get_B(mt, B);
-      boost::variate_generator<boost::mt11213b&, boost::triangle_distribution<CPU_ScalarType> >   get_T(mt, T);
-
       std::vector<CPU_ScalarType> eigenvalues;
       std::size_t matrix_size = matrix.size1();
       VectorT r(matrix_size);
-      std::vector<CPU_ScalarType> s(matrix_size);
-
-      for(std::size_t i=0; i<s.size(); ++i)
-        s[i] = 3.0 * get_B() + get_T() - 1.5;
 
-      detail::copy_vec_to_vec(s,r);
+      detail::random_start_vector(r);
 
       std::size_t size_krylov = (matrix_size < tag.krylov_size()) ? matrix_size
                                                                   : tag.krylov_size();
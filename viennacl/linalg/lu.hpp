@@ -23,17 +23,68 @@
 */
 
 #include <algorithm>    //for std::min
+#include <vector>
 
 #include "viennacl/matrix.hpp"
 #include "viennacl/matrix_proxy.hpp"
+#include "viennacl/backend/memory.hpp"
 
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/host_based/lu_operations.hpp"
 
 namespace viennacl
 {
   namespace linalg
   {
+    namespace detail
+    {
+      /** @brief Computes the LU factorization of a matrix located in a memory domain other than main memory by transferring it to the host and back.
+      *
+      * Pivoting requires interchanges of full rows, which would otherwise lead to many small transfers per panel.
+      */
+      template<typename SCALARTYPE, typename F>
+      void lu_factorize_on_host(matrix<SCALARTYPE, F> & A, std::size_t * permutation)
+      {
+        matrix<SCALARTYPE, F> A_host(A.size1(), A.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+        assert(A_host.internal_size() == A.internal_size() && bool("Buffer sizes do not match"));
+
+        SCALARTYPE * data_A_host = viennacl::linalg::host_based::detail::extract_raw_pointer<SCALARTYPE>(A_host);
+        viennacl::backend::memory_read(A.handle(), 0, sizeof(SCALARTYPE) * A.internal_size(), data_A_host);
+        viennacl::linalg::host_based::lu_factorize(A_host, permutation);
+        viennacl::backend::memory_write(A.handle(), 0, sizeof(SCALARTYPE) * A.internal_size(), data_A_host);
+      }
+
+      /** @brief Permutes the rows of B such that row i is replaced by row permutation[i] */
+      template<typename SCALARTYPE, typename F, unsigned int ALIGNMENT>
+      void lu_permute(std::vector<std::size_t> const & permutation, matrix<SCALARTYPE, F, ALIGNMENT> & B)
+      {
+        std::vector<SCALARTYPE> buffer(B.internal_size());
+        viennacl::backend::memory_read(B.handle(), 0, sizeof(SCALARTYPE) * buffer.size(), &(buffer[0]));
+
+        std::vector<SCALARTYPE> result(buffer);
+        for (std::size_t i = 0; i < B.size1(); ++i)
+          for (std::size_t j = 0; j < B.size2(); ++j)
+            result[F::mem_index(i, j, B.internal_size1(), B.internal_size2())] = buffer[F::mem_index(permutation[i], j, B.internal_size1(), B.internal_size2())];
+
+        viennacl::backend::memory_write(B.handle(), 0, sizeof(SCALARTYPE) * result.size(), &(result[0]));
+      }
+
+      /** @brief Permutes the entries of vec such that entry i is replaced by entry permutation[i] */
+      template<typename SCALARTYPE, unsigned int ALIGNMENT>
+      void lu_permute(std::vector<std::size_t> const & permutation, vector<SCALARTYPE, ALIGNMENT> & vec)
+      {
+        std::vector<SCALARTYPE> buffer(vec.size());
+        viennacl::backend::memory_read(vec.handle(), 0, sizeof(SCALARTYPE) * buffer.size(), &(buffer[0]));
+
+        std::vector<SCALARTYPE> result(vec.size());
+        for (std::size_t i = 0; i < vec.size(); ++i)
+          result[i] = buffer[permutation[i]];
+
+        viennacl::backend::memory_write(vec.handle(), 0, sizeof(SCALARTYPE) * result.size(), &(result[0]));
+      }
+    }
+
     /** @brief LU factorization of a row-major dense matrix.
     *
     * @param A    The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
@@ -43,7 +94,13 @@ namespace viennacl
     {
       typedef matrix<SCALARTYPE, viennacl::row_major>  MatrixType;
 
-      std::size_t max_block_size = 32;
+      if (viennacl::traits::handle(A).get_active_handle_id() == viennacl::MAIN_MEMORY)
+      {
+        viennacl::linalg::host_based::lu_factorize(A);
+        return;
+      }
+
+      std::size_t max_block_size = std::max<std::size_t>(viennacl::linalg::host_based::current_tuning_profile().lu_block_size, 1);
       std::size_t num_blocks = (A.size2() - 1) / max_block_size + 1;
       std::vector<SCALARTYPE> temp_buffer(A.internal_size2() * max_block_size);
 
@@ -119,7 +176,13 @@ namespace viennacl
     {
       typedef matrix<SCALARTYPE, viennacl::column_major>  MatrixType;
 
-      std::size_t max_block_size = 32;
+      if (viennacl::traits::handle(A).get_active_handle_id() == viennacl::MAIN_MEMORY)
+      {
+        viennacl::linalg::host_based::lu_factorize(A);
+        return;
+      }
+
+      std::size_t max_block_size = std::max<std::size_t>(viennacl::linalg::host_based::current_tuning_profile().lu_block_size, 1);
       std::size_t num_blocks = (A.size1() - 1) / max_block_size + 1;
       std::vector<SCALARTYPE> temp_buffer(A.internal_size1() * max_block_size);
 
@@ -188,6 +251,43 @@ namespace viennacl
     }
 
 
+    /** @brief LU factorization with partial pivoting P * A = L * U of a dense matrix.
+    *
+    * On the host, a blocked right-looking factorization is run directly on the matrix. For other memory domains, the matrix is factorized on the host and transferred back.
+    *
+    * @param A            The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
+    * @param permutation  The permutation vector, where row i of L * U corresponds to row permutation[i] of A
+    */
+    template<typename SCALARTYPE, typename F>
+    void lu_factorize(matrix<SCALARTYPE, F> & A, std::vector<std::size_t> & permutation)
+    {
+      permutation.resize(A.size1());
+      if (A.size1() == 0)
+        return;
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::lu_factorize(A, &(permutation[0]));
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          detail::lu_factorize_on_host(A, &(permutation[0]));
+          break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+          detail::lu_factorize_on_host(A, &(permutation[0]));
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
     //
     // Convenience layer:
     //
@@ -221,6 +321,43 @@ namespace viennacl
       inplace_solve(A, vec, upper_tag());
     }
 
+    /** @brief LU substitution for the system P^T * LU = rhs, where the factorization was computed with partial pivoting.
+    *
+    * @param A            The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
+    * @param permutation  The permutation vector obtained from lu_factorize()
+    * @param B            The matrix of load vectors, where the solution is directly written to
+    */
+    template<typename SCALARTYPE, typename F1, typename F2, unsigned int ALIGNMENT_A, unsigned int ALIGNMENT_B>
+    void lu_substitute(matrix<SCALARTYPE, F1, ALIGNMENT_A> const & A,
+                       std::vector<std::size_t> const & permutation,
+                       matrix<SCALARTYPE, F2, ALIGNMENT_B> & B)
+    {
+      assert(A.size1() == A.size2() && bool("Matrix must be square"));
+      assert(A.size1() == B.size1() && bool("Matrix must be square"));
+      assert(A.size1() == permutation.size() && bool("Size of permutation vector does not match"));
+      detail::lu_permute(permutation, B);
+      inplace_solve(A, B, unit_lower_tag());
+      inplace_solve(A, B, upper_tag());
+    }
+
+    /** @brief LU substitution for the system P^T * LU = rhs, where the factorization was computed with partial pivoting.
+    *
+    * @param A            The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
+    * @param permutation  The permutation vector obtained from lu_factorize()
+    * @param vec          The load vector, where the solution is directly written to
+    */
+    template<typename SCALARTYPE, typename F, unsigned int ALIGNMENT, unsigned int VEC_ALIGNMENT>
+    void lu_substitute(matrix<SCALARTYPE, F, ALIGNMENT> const & A,
+                       std::vector<std::size_t> const & permutation,
+                       vector<SCALARTYPE, VEC_ALIGNMENT> & vec)
+    {
+      assert(A.size1() == A.size2() && bool("Matrix must be square"));
+      assert(A.size1() == permutation.size() && bool("Size of permutation vector does not match"));
+      detail::lu_permute(permutation, vec);
+      inplace_solve(A, vec, unit_lower_tag());
+      inplace_solve(A, vec, upper_tag());
+    }
+
   }
 }
 
@@ -27,6 +27,7 @@
 #include "viennacl/vector.hpp"
 #include "viennacl/vector_proxy.hpp"
 #include "viennacl/tools/tools.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/meta/enable_if.hpp"
 #include "viennacl/meta/predicate.hpp"
 #include "viennacl/meta/result_of.hpp"
@@ -37,6 +38,10 @@
 #include "viennacl/vector.hpp"
 #include "viennacl/linalg/host_based/matrix_operations.hpp"
 
+#ifdef VIENNACL_WITH_HOST_ASYNC
+  #include "viennacl/linalg/host_based/async_tasks.hpp"
+#endif
+
 #ifdef VIENNACL_WITH_OPENCL
   #include "viennacl/linalg/opencl/matrix_operations.hpp"
 #endif
@@ -55,6 +60,8 @@ namespace viennacl
     void am(matrix_base<NumericT, F> & mat1,
             matrix_base<NumericT, F> const & mat2, ScalarType1 const & alpha, std::size_t len_alpha, bool reciprocal_alpha, bool flip_sign_alpha)
     {
+      VIENNACL_PROFILE_OPERATION("am", viennacl::traits::handle(mat1), viennacl::traits::size1(mat1), viennacl::traits::size2(mat1), 2 * viennacl::traits::size1(mat1) * viennacl::traits::size2(mat1) * sizeof(NumericT), viennacl::traits::size1(mat1) * viennacl::traits::size2(mat1));
+
       switch (viennacl::traits::handle(mat1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -84,6 +91,8 @@ namespace viennacl
               matrix_base<NumericT, F> const & mat2, ScalarType1 const & alpha, std::size_t len_alpha, bool reciprocal_alpha, bool flip_sign_alpha,
               matrix_base<NumericT, F> const & mat3, ScalarType2 const & beta,  std::size_t len_beta,  bool reciprocal_beta,  bool flip_sign_beta)
     {
+      VIENNACL_PROFILE_OPERATION("ambm", viennacl::traits::handle(mat1), viennacl::traits::size1(mat1), viennacl::traits::size2(mat1), 3 * viennacl::traits::size1(mat1) * viennacl::traits::size2(mat1) * sizeof(NumericT), 3 * viennacl::traits::size1(mat1) * viennacl::traits::size2(mat1));
+
       switch (viennacl::traits::handle(mat1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -119,6 +128,8 @@ namespace viennacl
                 matrix_base<NumericT, F> const & mat2, ScalarType1 const & alpha, std::size_t len_alpha, bool reciprocal_alpha, bool flip_sign_alpha,
                 matrix_base<NumericT, F> const & mat3, ScalarType2 const & beta,  std::size_t len_beta,  bool reciprocal_beta,  bool flip_sign_beta)
     {
+      VIENNACL_PROFILE_OPERATION("ambm_m", viennacl::traits::handle(mat1), viennacl::traits::size1(mat1), viennacl::traits::size2(mat1), 4 * viennacl::traits::size1(mat1) * viennacl::traits::size2(mat1) * sizeof(NumericT), 4 * viennacl::traits::size1(mat1) * viennacl::traits::size2(mat1));
+
       switch (viennacl::traits::handle(mat1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -151,6 +162,8 @@ namespace viennacl
     template <typename NumericT, typename F>
     void matrix_assign(matrix_base<NumericT, F> & mat, NumericT s, bool clear = false)
     {
+      VIENNACL_PROFILE_OPERATION("matrix_assign", viennacl::traits::handle(mat), viennacl::traits::size1(mat), viennacl::traits::size2(mat), viennacl::traits::size1(mat) * viennacl::traits::size2(mat) * sizeof(NumericT), 0);
+
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -177,6 +190,8 @@ namespace viennacl
     template <typename NumericT, typename F>
     void matrix_diagonal_assign(matrix_base<NumericT, F> & mat, NumericT s)
     {
+      VIENNACL_PROFILE_OPERATION("matrix_diagonal_assign", viennacl::traits::handle(mat), viennacl::traits::size1(mat), viennacl::traits::size2(mat), viennacl::traits::size1(mat) * sizeof(NumericT), 0);
+
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -204,6 +219,8 @@ namespace viennacl
     template <typename NumericT, typename F>
     void matrix_diag_from_vector(const vector_base<NumericT> & v, int k, matrix_base<NumericT, F> & A)
     {
+      VIENNACL_PROFILE_OPERATION("matrix_diag_from_vector", viennacl::traits::handle(v), viennacl::traits::size1(A), viennacl::traits::size2(A), viennacl::traits::size1(A) * viennacl::traits::size2(A) * sizeof(NumericT), 0);
+
       switch (viennacl::traits::handle(v).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -230,6 +247,8 @@ namespace viennacl
     template <typename NumericT, typename F>
     void matrix_diag_to_vector(const matrix_base<NumericT, F> & A, int k, vector_base<NumericT> & v)
     {
+      VIENNACL_PROFILE_OPERATION("matrix_diag_to_vector", viennacl::traits::handle(A), viennacl::traits::size1(A), viennacl::traits::size2(A), 2 * viennacl::traits::size(v) * sizeof(NumericT), 0);
+
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -255,6 +274,8 @@ namespace viennacl
     template <typename NumericT, typename F>
     void matrix_row(const matrix_base<NumericT, F> & A, unsigned int i, vector_base<NumericT> & v)
     {
+      VIENNACL_PROFILE_OPERATION("matrix_row", viennacl::traits::handle(A), viennacl::traits::size1(A), viennacl::traits::size2(A), 2 * viennacl::traits::size(v) * sizeof(NumericT), 0);
+
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -280,6 +301,8 @@ namespace viennacl
     template <typename NumericT, typename F>
     void matrix_column(const matrix_base<NumericT, F> & A, unsigned int j, vector_base<NumericT> & v)
     {
+      VIENNACL_PROFILE_OPERATION("matrix_column", viennacl::traits::handle(A), viennacl::traits::size1(A), viennacl::traits::size2(A), 2 * viennacl::traits::size(v) * sizeof(NumericT), 0);
+
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -354,9 +377,18 @@ namespace viennacl
       assert( (viennacl::traits::size1(mat) == viennacl::traits::size(result)) && bool("Size check failed at v1 = prod(A, v2): size1(A) != size(v1)"));
       assert( (viennacl::traits::size2(mat) == viennacl::traits::size(vec))    && bool("Size check failed at v1 = prod(A, v2): size2(A) != size(v2)"));
 
+      VIENNACL_PROFILE_OPERATION("gemv", viennacl::traits::handle(mat), viennacl::traits::size1(mat), viennacl::traits::size2(mat), (viennacl::traits::size1(mat) * viennacl::traits::size2(mat) + viennacl::traits::size1(mat) + viennacl::traits::size2(mat)) * sizeof(NumericT), 2 * viennacl::traits::size1(mat) * viennacl::traits::size2(mat));
+
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          if (viennacl::backend::current_host_executor().enqueues())
+          {
+            viennacl::backend::current_host_executor().enqueue(new viennacl::linalg::host_based::detail::prod_task<matrix_base<NumericT, F>, NumericT>(&viennacl::linalg::host_based::prod_impl, mat, vec, result));
+            break;
+          }
+#endif
           viennacl::linalg::host_based::prod_impl(mat, vec, result);
           break;
 #ifdef VIENNACL_WITH_OPENCL
@@ -395,6 +427,8 @@ namespace viennacl
       assert( (viennacl::traits::size1(mat_trans.lhs()) == viennacl::traits::size(vec))    && bool("Size check failed at v1 = trans(A) * v2: size1(A) != size(v2)"));
       assert( (viennacl::traits::size2(mat_trans.lhs()) == viennacl::traits::size(result)) && bool("Size check failed at v1 = trans(A) * v2: size2(A) != size(v1)"));
 
+      VIENNACL_PROFILE_OPERATION("gemv_trans", viennacl::traits::handle(mat_trans.lhs()), viennacl::traits::size1(mat_trans.lhs()), viennacl::traits::size2(mat_trans.lhs()), (viennacl::traits::size1(mat_trans.lhs()) * viennacl::traits::size2(mat_trans.lhs()) + viennacl::traits::size1(mat_trans.lhs()) + viennacl::traits::size2(mat_trans.lhs())) * sizeof(NumericT), 2 * viennacl::traits::size1(mat_trans.lhs()) * viennacl::traits::size2(mat_trans.lhs()));
+
       switch (viennacl::traits::handle(mat_trans.lhs()).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -439,6 +473,10 @@ namespace viennacl
       assert( (viennacl::traits::size2(B) == viennacl::traits::size2(C)) && bool("Size check failed at C = prod(A, B): size2(B) != size2(C)"));
 
 
+      VIENNACL_PROFILE_OPERATION("gemm", viennacl::traits::handle(A), viennacl::traits::size1(C), viennacl::traits::size2(C),
+                                 (viennacl::traits::size1(A) * viennacl::traits::size2(A) + viennacl::traits::size1(B) * viennacl::traits::size2(B) + 2 * viennacl::traits::size1(C) * viennacl::traits::size2(C)) * sizeof(NumericT),
+                                 2 * viennacl::traits::size1(C) * viennacl::traits::size2(C) * viennacl::traits::size2(A));
+
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -481,6 +519,10 @@ namespace viennacl
       assert(viennacl::traits::size1(A.lhs()) == viennacl::traits::size1(B) && bool("Size check failed at C = prod(trans(A), B): size1(A) != size1(B)"));
       assert(viennacl::traits::size2(B)       == viennacl::traits::size2(C) && bool("Size check failed at C = prod(trans(A), B): size2(B) != size2(C)"));
 
+      VIENNACL_PROFILE_OPERATION("gemm_tn", viennacl::traits::handle(A.lhs()), viennacl::traits::size1(C), viennacl::traits::size2(C),
+                                 (viennacl::traits::size1(A.lhs()) * viennacl::traits::size2(A.lhs()) + viennacl::traits::size1(B) * viennacl::traits::size2(B) + 2 * viennacl::traits::size1(C) * viennacl::traits::size2(C)) * sizeof(NumericT),
+                                 2 * viennacl::traits::size1(C) * viennacl::traits::size2(C) * viennacl::traits::size1(A.lhs()));
+
       switch (viennacl::traits::handle(A.lhs()).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -522,6 +564,10 @@ namespace viennacl
       assert(viennacl::traits::size2(A)       == viennacl::traits::size2(B.lhs()) && bool("Size check failed at C = prod(A, trans(B)): size2(A) != size2(B)"));
       assert(viennacl::traits::size1(B.lhs()) == viennacl::traits::size2(C)       && bool("Size check failed at C = prod(A, trans(B)): size1(B) != size2(C)"));
 
+      VIENNACL_PROFILE_OPERATION("gemm_nt", viennacl::traits::handle(A), viennacl::traits::size1(C), viennacl::traits::size2(C),
+                                 (viennacl::traits::size1(A) * viennacl::traits::size2(A) + viennacl::traits::size1(B.lhs()) * viennacl::traits::size2(B.lhs()) + 2 * viennacl::traits::size1(C) * viennacl::traits::size2(C)) * sizeof(NumericT),
+                                 2 * viennacl::traits::size1(C) * viennacl::traits::size2(C) * viennacl::traits::size2(A));
+
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -562,6 +608,10 @@ namespace viennacl
       assert(viennacl::traits::size1(A.lhs()) == viennacl::traits::size2(B.lhs()) && bool("Size check failed at C = prod(trans(A), trans(B)): size1(A) != size2(B)"));
       assert(viennacl::traits::size1(B.lhs()) == viennacl::traits::size2(C)       && bool("Size check failed at C = prod(trans(A), trans(B)): size1(B) != size2(C)"));
 
+      VIENNACL_PROFILE_OPERATION("gemm_tt", viennacl::traits::handle(A.lhs()), viennacl::traits::size1(C), viennacl::traits::size2(C),
+                                 (viennacl::traits::size1(A.lhs()) * viennacl::traits::size2(A.lhs()) + viennacl::traits::size1(B.lhs()) * viennacl::traits::size2(B.lhs()) + 2 * viennacl::traits::size1(C) * viennacl::traits::size2(C)) * sizeof(NumericT),
+                                 2 * viennacl::traits::size1(C) * viennacl::traits::size2(C) * viennacl::traits::size1(A.lhs()));
+
       switch (viennacl::traits::handle(A.lhs()).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -601,6 +651,8 @@ namespace viennacl
       assert( (viennacl::traits::size1(A) == viennacl::traits::size1(proxy)) && bool("Size check failed at A = element_op(B): size1(A) != size1(B)"));
       assert( (viennacl::traits::size2(A) == viennacl::traits::size2(proxy)) && bool("Size check failed at A = element_op(B): size2(A) != size2(B)"));
 
+      VIENNACL_PROFILE_OPERATION("element_op", viennacl::traits::handle(A), viennacl::traits::size1(A), viennacl::traits::size2(A), 3 * viennacl::traits::size1(A) * viennacl::traits::size2(A) * sizeof(T), viennacl::traits::size1(A) * viennacl::traits::size2(A));
+
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -750,6 +802,8 @@ namespace viennacl
                               const vector_base<NumericT> & vec1,
                               const vector_base<NumericT> & vec2)
     {
+      VIENNACL_PROFILE_OPERATION("rank_1_update", viennacl::traits::handle(mat1), viennacl::traits::size1(mat1), viennacl::traits::size2(mat1), 2 * viennacl::traits::size1(mat1) * viennacl::traits::size2(mat1) * sizeof(NumericT), 2 * viennacl::traits::size1(mat1) * viennacl::traits::size2(mat1));
+
       switch (viennacl::traits::handle(mat1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
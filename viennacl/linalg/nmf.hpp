@@ -25,12 +25,25 @@
 */
 
 
+#include <cmath>
+#include <vector>
+
 #include "viennacl/vector.hpp"
 #include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
 #include "viennacl/linalg/prod.hpp"
-#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
 #include "viennacl/linalg/norm_frobenius.hpp"
-#include "viennacl/linalg/opencl/kernels/nmf.hpp"
+#include "viennacl/linalg/detail/sparse_transpose.hpp"
+#include "viennacl/linalg/host_based/nmf_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/opencl/nmf_operations.hpp"
+#endif
+
+#ifdef VIENNACL_WITH_CUDA
+  #include "viennacl/linalg/cuda/nmf_operations.hpp"
+#endif
 
 namespace viennacl
 {
@@ -84,6 +97,12 @@ namespace viennacl
                         viennacl::matrix<ScalarType> & H,
                         nmf_config const & conf);
 
+        template <typename ScalarType, unsigned int ALIGNMENT>
+        friend void nmf(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & V,
+                        viennacl::matrix<ScalarType> & W,
+                        viennacl::matrix<ScalarType> & H,
+                        nmf_config const & conf);
+
       private:
         double eps_;
         double stagnation_eps_;
@@ -93,101 +112,242 @@ namespace viennacl
     };
 
 
-    /** @brief The nonnegative matrix factorization (approximation) algorithm as suggested by Lee and Seung. Factorizes a matrix V with nonnegative entries into matrices W and H such that ||V - W*H|| is minimized.
-     *
-     * @param V     Input matrix
-     * @param W     First factor
-     * @param H     Second factor
-     * @param conf  A configuration object holding tolerances and the like
-     */
-    template <typename ScalarType>
-    void nmf(viennacl::matrix<ScalarType> const & V,
-             viennacl::matrix<ScalarType> & W,
-             viennacl::matrix<ScalarType> & H,
-             nmf_config const & conf)
+    namespace detail
     {
-      viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(V).context());
+      /** @brief Multiplicative update A = A .* B ./ C (MATLAB syntax), dispatched to the respective compute backend. Entries with a tiny denominator are set to zero. */
+      template <typename NumericT, typename F>
+      void el_wise_mul_div(matrix_base<NumericT, F> & A,
+                           matrix_base<NumericT, F> const & B,
+                           matrix_base<NumericT, F> const & C)
+      {
+        assert(viennacl::traits::size1(A) == viennacl::traits::size1(B) && viennacl::traits::size1(A) == viennacl::traits::size1(C) && bool("Size mismatch in el_wise_mul_div()"));
+        assert(viennacl::traits::size2(A) == viennacl::traits::size2(B) && viennacl::traits::size2(A) == viennacl::traits::size2(C) && bool("Size mismatch in el_wise_mul_div()"));
 
-      const std::string NMF_MUL_DIV_KERNEL = "el_wise_mul_div";
+        switch (viennacl::traits::handle(A).get_active_handle_id())
+        {
+          case viennacl::MAIN_MEMORY:
+            viennacl::linalg::host_based::el_wise_mul_div(A, B, C);
+            break;
+#ifdef VIENNACL_WITH_OPENCL
+          case viennacl::OPENCL_MEMORY:
+            viennacl::linalg::opencl::el_wise_mul_div(A, B, C);
+            break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+          case viennacl::CUDA_MEMORY:
+            viennacl::linalg::cuda::el_wise_mul_div(A, B, C);
+            break;
+#endif
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+            throw memory_exception("not implemented");
+        }
+      }
 
-      viennacl::linalg::opencl::kernels::nmf<ScalarType>::init(ctx);
+      /** @brief Returns the sum of all entries of A .* B, i.e. trace(trans(A) * B), by means of the (small) product trans(A) * B. */
+      template <typename ScalarType>
+      double nmf_trace_trans_prod(viennacl::matrix<ScalarType> const & A,
+                                  viennacl::matrix<ScalarType> const & B,
+                                  viennacl::matrix<ScalarType> & temp)
+      {
+        temp = viennacl::linalg::prod(trans(A), B);
 
-      assert(V.size1() == W.size1() && V.size2() == H.size2() && bool("Dimensions of W and H don't allow for V = W * H"));
-      assert(W.size2() == H.size1() && bool("Dimensions of W and H don't match, prod(W, H) impossible"));
+        std::vector< std::vector<ScalarType> > host_temp(temp.size1(), std::vector<ScalarType>(temp.size2()));
+        viennacl::copy(temp, host_temp);
 
-      std::size_t k = W.size2();
-      conf.iters_ = 0;
+        double result = 0;
+        for (std::size_t i = 0; i < host_temp.size(); ++i)
+          result += host_temp[i][i];
+        return result;
+      }
 
-      viennacl::matrix<ScalarType> wn(V.size1(), k);
-      viennacl::matrix<ScalarType> wd(V.size1(), k);
-      viennacl::matrix<ScalarType> wtmp(V.size1(), V.size2());
+      /** @brief Returns the sum of all entries of A .* B for two small matrices by evaluation on the host. */
+      template <typename ScalarType>
+      double nmf_sum_el_wise_prod(viennacl::matrix<ScalarType> const & A,
+                                  viennacl::matrix<ScalarType> const & B)
+      {
+        std::vector< std::vector<ScalarType> > host_A(A.size1(), std::vector<ScalarType>(A.size2()));
+        std::vector< std::vector<ScalarType> > host_B(B.size1(), std::vector<ScalarType>(B.size2()));
+        viennacl::copy(A, host_A);
+        viennacl::copy(B, host_B);
+
+        double result = 0;
+        for (std::size_t i = 0; i < host_A.size(); ++i)
+          for (std::size_t j = 0; j < host_A[i].size(); ++j)
+            result += double(host_A[i][j]) * double(host_B[i][j]);
+        return result;
+      }
 
-      viennacl::matrix<ScalarType> hn(k, V.size2());
-      viennacl::matrix<ScalarType> hd(k, V.size2());
-      viennacl::matrix<ScalarType> htmp(k, k);
+      /** @brief Sets up the transpose of a sparse matrix (in the same context) and returns the squared Frobenius norm of the matrix. */
+      template <typename ScalarType, unsigned int ALIGNMENT>
+      double nmf_transpose(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & V,
+                           viennacl::compressed_matrix<ScalarType> & Vt)
+      {
+        std::vector<ScalarType> elements(V.nnz());
+        viennacl::backend::memory_read(V.handle(), 0, sizeof(ScalarType) * V.nnz(), &(elements[0]));
 
-      viennacl::matrix<ScalarType> appr(V.size1(), V.size2());
-      viennacl::vector<ScalarType> diff(V.size1() * V.size2());
+        double norm_squared = 0;
+        for (std::size_t i = 0; i < elements.size(); ++i)
+          norm_squared += double(elements[i]) * double(elements[i]);
 
-      ScalarType last_diff = 0;
-      ScalarType diff_init = 0;
-      bool stagnation_flag = false;
+        viennacl::linalg::detail::sparse_transpose(V, Vt);
 
+        return norm_squared;
+      }
 
-      for (std::size_t i = 0; i < conf.max_iterations(); i++)
+      /** @brief Multiplicative update iteration of Lee and Seung, formulated such that no temporaries of the size of V are required.
+      *
+      * H is handled in transposed form Ht = trans(H), so the only products with V are V * Ht and trans(V) * W, each of which is of size m x k or n x k.
+      * The products W * (H * trans(H)) and (trans(W) * W) * H only involve k x k Gram matrices.
+      * Convergence is monitored via ||V - W*H||^2 = ||V||^2 - 2 trace(trans(W) * V * trans(H)) + sum((trans(W) * W) .* (H * trans(H))),
+      * which avoids forming V - W * H explicitly. Due to cancellation, the residual is accurate only to about sqrt(machine epsilon) relative to ||V||.
+      *
+      * @param V              The matrix to be factored (dense or sparse)
+      * @param Vt             The transpose of V (an expression for dense V, an explicit matrix for sparse V)
+      * @param norm_V_squared The squared Frobenius norm of V
+      * @param W              First factor
+      * @param Ht             Transpose of the second factor
+      * @param conf           A configuration object holding tolerances and the like
+      * @return The number of iterations
+      */
+      template <typename MatrixType, typename TransposedMatrixType, typename ScalarType>
+      std::size_t nmf_impl(MatrixType const & V,
+                           TransposedMatrixType const & Vt,
+                           double norm_V_squared,
+                           viennacl::matrix<ScalarType> & W,
+                           viennacl::matrix<ScalarType> & Ht,
+                           nmf_config const & conf)
       {
-        conf.iters_ = i + 1;
-        {
-          hn   = viennacl::linalg::prod(trans(W), V);
-          htmp = viennacl::linalg::prod(trans(W), W);
-          hd   = viennacl::linalg::prod(htmp, H);
+        viennacl::context ctx = viennacl::traits::context(W);
 
-          viennacl::ocl::kernel & mul_div_kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::nmf<ScalarType>::program_name(), NMF_MUL_DIV_KERNEL);
-          viennacl::ocl::enqueue(mul_div_kernel(H, hn, hd, cl_uint(H.internal_size1() * H.internal_size2())));
-        }
-        {
-          wn   = viennacl::linalg::prod(V, trans(H));
-          wtmp = viennacl::linalg::prod(W, H);
-          wd   = viennacl::linalg::prod(wtmp, trans(H));
+        std::size_t m = W.size1();
+        std::size_t n = Ht.size1();
+        std::size_t k = W.size2();
+        std::size_t iters = 0;
 
-          viennacl::ocl::kernel & mul_div_kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::nmf<ScalarType>::program_name(), NMF_MUL_DIV_KERNEL);
+        viennacl::matrix<ScalarType> wn(m, k, ctx);
+        viennacl::matrix<ScalarType> wd(m, k, ctx);
 
-          viennacl::ocl::enqueue(mul_div_kernel(W, wn, wd, cl_uint(W.internal_size1() * W.internal_size2())));
-        }
+        viennacl::matrix<ScalarType> hn(n, k, ctx);
+        viennacl::matrix<ScalarType> hd(n, k, ctx);
 
-        if (i % conf.check_after_steps() == 0)  //check for convergence
-        {
-          appr = viennacl::linalg::prod(W, H);
+        viennacl::matrix<ScalarType> gram_W(k, k, ctx);
+        viennacl::matrix<ScalarType> gram_H(k, k, ctx);
+        viennacl::matrix<ScalarType> temp_kk(k, k, ctx);
 
-          appr -= V;
-          ScalarType diff_val = viennacl::linalg::norm_frobenius(appr);
+        double last_diff = 0;
+        double diff_init = 0;
+        bool stagnation_flag = false;
 
-          if (i == 0)
-            diff_init = diff_val;
+        gram_W = viennacl::linalg::prod(trans(W), W);
 
-          std::cout << diff_val / diff_init << std::endl;
+        for (std::size_t i = 0; i < conf.max_iterations(); i++)
+        {
+          iters = i + 1;
 
-          // Approximation check
-          if (diff_val / diff_init < conf.tolerance())
-            break;
+          // H <- H .* (W^T V) ./ ((W^T W) H), in transposed form:
+          hn = viennacl::linalg::prod(Vt, W);
+          hd = viennacl::linalg::prod(Ht, gram_W);    // gram_W is symmetric
+          el_wise_mul_div(Ht, hn, hd);
 
-          // Stagnation check
-          if (std::fabs(diff_val - last_diff) / (diff_val * conf.check_after_steps()) < conf.stagnation_tolerance()) //avoid situations where convergence stagnates
+          // W <- W .* (V H^T) ./ (W (H H^T)):
+          wn     = viennacl::linalg::prod(V, Ht);
+          gram_H = viennacl::linalg::prod(trans(Ht), Ht);
+          wd     = viennacl::linalg::prod(W, gram_H);
+          el_wise_mul_div(W, wn, wd);
+
+          gram_W = viennacl::linalg::prod(trans(W), W);  // reused in the next iteration
+
+          if (i % conf.check_after_steps() == 0)  //check for convergence
           {
-            if (stagnation_flag)       // iteration stagnates (two iterates with no notable progress)
+            // wn holds V * H^T for the current H:
+            double cross_term     = nmf_trace_trans_prod(W, wn, temp_kk);
+            double quadratic_term = nmf_sum_el_wise_prod(gram_W, gram_H);
+            double diff_squared   = norm_V_squared - 2.0 * cross_term + quadratic_term;
+            double diff_val = (diff_squared > 0) ? std::sqrt(diff_squared) : 0;
+
+            if (i == 0)
+              diff_init = diff_val;
+
+            // Approximation check
+            if (diff_val <= conf.tolerance() * diff_init)
               break;
-            else                       // record stagnation in this iteration
-              stagnation_flag = true;
-          }
-          else                         // good progress in this iteration, so unset stagnation flag
-            stagnation_flag = false;
 
-          // prepare for next iterate:
-          last_diff = diff_val;
+            // Stagnation check
+            if (std::fabs(diff_val - last_diff) / (diff_val * conf.check_after_steps()) < conf.stagnation_tolerance()) //avoid situations where convergence stagnates
+            {
+              if (stagnation_flag)       // iteration stagnates (two iterates with no notable progress)
+                break;
+              else                       // record stagnation in this iteration
+                stagnation_flag = true;
+            }
+            else                         // good progress in this iteration, so unset stagnation flag
+              stagnation_flag = false;
+
+            // prepare for next iterate:
+            last_diff = diff_val;
+          }
         }
+
+        return iters;
       }
+    } //namespace detail
+
+
+    /** @brief The nonnegative matrix factorization (approximation) algorithm as suggested by Lee and Seung. Factorizes a matrix V with nonnegative entries into matrices W and H such that ||V - W*H|| is minimized.
+     *
+     * Runs on all compute backends. Apart from W and H, only temporaries of size m x k, k x n, and k x k are allocated.
+     *
+     * @param V     Input matrix
+     * @param W     First factor
+     * @param H     Second factor
+     * @param conf  A configuration object holding tolerances and the like
+     */
+    template <typename ScalarType>
+    void nmf(viennacl::matrix<ScalarType> const & V,
+             viennacl::matrix<ScalarType> & W,
+             viennacl::matrix<ScalarType> & H,
+             nmf_config const & conf)
+    {
+      assert(V.size1() == W.size1() && V.size2() == H.size2() && bool("Dimensions of W and H don't allow for V = W * H"));
+      assert(W.size2() == H.size1() && bool("Dimensions of W and H don't match, prod(W, H) impossible"));
+
+      conf.iters_ = 0;
+
+      ScalarType norm_V = viennacl::linalg::norm_frobenius(V);
+
+      viennacl::matrix<ScalarType> Ht = trans(H);
+      conf.iters_ = detail::nmf_impl(V, trans(V), double(norm_V) * double(norm_V), W, Ht, conf);
+      H = trans(Ht);
+    }
+
+    /** @brief The nonnegative matrix factorization (approximation) algorithm as suggested by Lee and Seung for a sparse matrix V with nonnegative entries.
+     *
+     * The transpose of V is set up once, then each iteration requires one product with V and one with trans(V) (sparse times dense).
+     *
+     * @param V     Input matrix
+     * @param W     First factor
+     * @param H     Second factor
+     * @param conf  A configuration object holding tolerances and the like
+     */
+    template <typename ScalarType, unsigned int ALIGNMENT>
+    void nmf(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & V,
+             viennacl::matrix<ScalarType> & W,
+             viennacl::matrix<ScalarType> & H,
+             nmf_config const & conf)
+    {
+      assert(V.size1() == W.size1() && V.size2() == H.size2() && bool("Dimensions of W and H don't allow for V = W * H"));
+      assert(W.size2() == H.size1() && bool("Dimensions of W and H don't match, prod(W, H) impossible"));
+
+      conf.iters_ = 0;
 
+      viennacl::compressed_matrix<ScalarType> Vt(V.size2(), V.size1(), viennacl::traits::context(V));
+      double norm_V_squared = detail::nmf_transpose(V, Vt);
 
+      viennacl::matrix<ScalarType> Ht = trans(H);
+      conf.iters_ = detail::nmf_impl(V, Vt, norm_V_squared, W, Ht, conf);
+      H = trans(Ht);
     }
   }
 }
@@ -0,0 +1,153 @@
+#ifndef VIENNACL_LINALG_OPENCL_KERNELS_RANDOM_HPP
+#define VIENNACL_LINALG_OPENCL_KERNELS_RANDOM_HPP
+
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/ocl/utils.hpp"
+
+/** @file viennacl/linalg/opencl/kernels/random.hpp
+ *  @brief OpenCL kernel file for the counter-based (Philox4x32-10) random number generation. Produces the same streams as viennacl/rand/utils.hpp */
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace opencl
+    {
+      namespace kernels
+      {
+
+        template <typename StringType>
+        void generate_random_philox(StringType & source)
+        {
+          source.append("void viennacl_philox4x32(uint * ctr, uint key0, uint key1) \n");
+          source.append("{ \n");
+          source.append("  for (uint round = 0; round < 10; ++round) \n");
+          source.append("  { \n");
+          source.append("    uint lo0 = 0xD2511F53 * ctr[0]; \n");
+          source.append("    uint hi0 = mul_hi((uint)0xD2511F53, ctr[0]); \n");
+          source.append("    uint lo1 = 0xCD9E8D57 * ctr[2]; \n");
+          source.append("    uint hi1 = mul_hi((uint)0xCD9E8D57, ctr[2]); \n");
+          source.append("    uint c0 = hi1 ^ ctr[1] ^ key0; \n");
+          source.append("    uint c2 = hi0 ^ ctr[3] ^ key1; \n");
+          source.append("    ctr[0] = c0; \n");
+          source.append("    ctr[1] = lo1; \n");
+          source.append("    ctr[2] = c2; \n");
+          source.append("    ctr[3] = lo0; \n");
+          source.append("    key0 += 0x9E3779B9; \n");
+          source.append("    key1 += 0xBB67AE85; \n");
+          source.append("  } \n");
+          source.append("} \n");
+        }
+
+        template <typename StringType>
+        void generate_random_fill(StringType & source, std::string const & numeric_string, bool gaussian)
+        {
+          bool is_float = (numeric_string == "float");
+
+          source.append("__kernel void "); source.append(gaussian ? "random_gaussian" : "random_uniform"); source.append("( \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * data, \n");
+          source.append("          unsigned int start1, unsigned int inc1, unsigned int size1, unsigned int internal_size1, \n");
+          source.append("          unsigned int start2, unsigned int inc2, unsigned int size2, unsigned int internal_size2, \n");
+          source.append("          unsigned int row_major, \n");
+          source.append("          "); source.append(numeric_string); source.append(" p1, \n");
+          source.append("          "); source.append(numeric_string); source.append(" p2, \n");
+          source.append("          unsigned int seed) \n");
+          source.append("{ \n");
+          source.append("  unsigned int values_per_block = "); source.append(is_float ? "4" : "2"); source.append("; \n");
+          source.append("  unsigned int total = size1 * size2; \n");
+          source.append("  for (unsigned int block = get_global_id(0); block * values_per_block < total; block += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    uint ctr[4]; \n");
+          source.append("    ctr[0] = block; ctr[1] = 0; ctr[2] = 0; ctr[3] = 0; \n"); //high word of the block index is zero for 32-bit indices, matching the host stream
+          source.append("    viennacl_philox4x32(ctr, seed, 0); \n");
+          source.append("    "); source.append(numeric_string); source.append(" values[4]; \n");
+
+          // conversion to uniformly distributed values in (0, 1):
+          if (is_float)
+          {
+            source.append("    for (unsigned int i = 0; i < 4; ++i) \n");
+            source.append("      values[i] = ((float)(ctr[i] >> 8) + 0.5f) * (1.0f / 16777216.0f); \n");
+          }
+          else
+          {
+            source.append("    values[0] = ((double)(ctr[0] >> 5) * 67108864.0 + (double)(ctr[1] >> 6) + 0.5) * (1.0 / 9007199254740992.0); \n");
+            source.append("    values[1] = ((double)(ctr[2] >> 5) * 67108864.0 + (double)(ctr[3] >> 6) + 0.5) * (1.0 / 9007199254740992.0); \n");
+          }
+
+          // Box-Muller transform:
+          if (gaussian)
+          {
+            source.append("    for (unsigned int i = 0; i < values_per_block; i += 2) \n");
+            source.append("    { \n");
+            source.append("      "); source.append(numeric_string); source.append(" r     = sqrt(("); source.append(numeric_string); source.append(")(-2) * log(values[i])); \n");
+            source.append("      "); source.append(numeric_string); source.append(" theta = ("); source.append(numeric_string); source.append(")(6.283185307179586476925) * values[i+1]; \n");
+            source.append("      values[i]   = r * cos(theta); \n");
+            source.append("      values[i+1] = r * sin(theta); \n");
+            source.append("    } \n");
+          }
+
+          source.append("    for (unsigned int v = 0; v < values_per_block; ++v) \n");
+          source.append("    { \n");
+          source.append("      unsigned int k = block * values_per_block + v; \n");
+          source.append("      if (k < total) \n");
+          source.append("      { \n");
+          source.append("        unsigned int row = k / size2; \n");
+          source.append("        unsigned int col = k % size2; \n");
+          source.append("        unsigned int index = row_major ? (row * inc1 + start1) * internal_size2 + col * inc2 + start2 \n");
+          source.append("                                       : (row * inc1 + start1) + (col * inc2 + start2) * internal_size1; \n");
+          if (gaussian)
+            source.append("        data[index] = p1 + p2 * values[v]; \n");
+          else
+            source.append("        data[index] = p1 + (p2 - p1) * values[v]; \n");
+          source.append("      } \n");
+          source.append("    } \n");
+          source.append("  } \n");
+          source.append("} \n");
+        }
+
+        // main kernel class
+        template <class NumericT>
+        struct random
+        {
+          static std::string program_name()
+          {
+            return viennacl::ocl::type_to_string<NumericT>::apply() + "_random";
+          }
+
+          static void init(viennacl::ocl::context & ctx)
+          {
+            viennacl::ocl::DOUBLE_PRECISION_CHECKER<NumericT>::apply(ctx);
+            std::string numeric_string = viennacl::ocl::type_to_string<NumericT>::apply();
+
+            static std::map<cl_context, bool> init_done;
+            if (!init_done[ctx.handle().get()])
+            {
+              std::string source;
+              source.reserve(8192);
+
+              viennacl::ocl::append_double_precision_pragma<NumericT>(ctx, source);
+
+              // only generate for floating points (forces error for integers)
+              if (numeric_string == "float" || numeric_string == "double")
+              {
+                generate_random_philox(source);
+                generate_random_fill(source, numeric_string, false);
+                generate_random_fill(source, numeric_string, true);
+              }
+
+              std::string prog_name = program_name();
+              #ifdef VIENNACL_BUILD_INFO
+              std::cout << "Creating program " << prog_name << std::endl;
+              #endif
+              ctx.add_program(source, prog_name);
+              init_done[ctx.handle().get()] = true;
+            } //if
+          } //init
+        };
+
+      }  // namespace kernels
+    }  // namespace opencl
+  }  // namespace linalg
+}  // namespace viennacl
+#endif
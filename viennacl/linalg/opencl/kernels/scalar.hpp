@@ -217,6 +217,18 @@ namespace viennacl
           source.append("} \n");
         }
 
+        template <typename StringType>
+        void generate_scalar_safe_div(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void safe_div( \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * s1, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * s2, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * s3) \n");
+          source.append("{ \n");
+          source.append("  *s1 = (*s3 != 0) ? *s2 / *s3 : 0; \n");
+          source.append("} \n");
+        }
+
         //////////////////////////// Part 2: Main kernel class ////////////////////////////////////
 
         // main kernel class
@@ -244,6 +256,7 @@ namespace viennacl
               // fully parametrized kernels:
               generate_asbs(source, numeric_string);
               generate_scalar_swap(source, numeric_string);
+              generate_scalar_safe_div(source, numeric_string);
 
 
               std::string prog_name = program_name();
@@ -0,0 +1,190 @@
+#ifndef VIENNACL_LINALG_OPENCL_KERNELS_SYMMETRIC_COMPRESSED_MATRIX_HPP
+#define VIENNACL_LINALG_OPENCL_KERNELS_SYMMETRIC_COMPRESSED_MATRIX_HPP
+
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/ocl/utils.hpp"
+
+/** @file viennacl/linalg/opencl/kernels/symmetric_compressed_matrix.hpp
+ *  @brief OpenCL kernel file for symmetric_compressed_matrix operations */
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace opencl
+    {
+      namespace kernels
+      {
+
+        //////////////////////////// Part 1: Kernel generation routines ////////////////////////////////////
+
+        // Processes all row blocks of one color. Blocks of the same color write to disjoint entries of the result, so no atomics are required.
+        // Each block is processed by 'threads_per_row' consecutive work items of a work group of size 128, which share the entries of each row.
+        template <typename StringType>
+        void generate_symmetric_compressed_matrix_vec_mul(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void vec_mul( \n");
+          source.append("          __global const unsigned int * row_jumper, \n");
+          source.append("          __global const unsigned int * column_indices, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * elements, \n");
+          source.append("          __global const unsigned int * blocks, \n");
+          source.append("          unsigned int block_offset, \n");
+          source.append("          unsigned int num_blocks, \n");
+          source.append("          unsigned int block_size, \n");
+          source.append("          unsigned int size, \n");
+          source.append("          unsigned int threads_per_row, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * x, \n");
+          source.append("          uint4 layout_x, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * result, \n");
+          source.append("          uint4 layout_result) \n");
+          source.append("{ \n");
+          source.append("  __local "); source.append(numeric_string); source.append(" shared_buffer[128]; \n");
+          source.append("  unsigned int lane = get_local_id(0) % threads_per_row; \n");
+          source.append("  unsigned int blocks_per_group = get_local_size(0) / threads_per_row; \n");
+          source.append("  for (unsigned int b_start = get_group_id(0) * blocks_per_group; b_start < num_blocks; b_start += get_num_groups(0) * blocks_per_group) \n");
+          source.append("  { \n");
+          source.append("    unsigned int b = b_start + get_local_id(0) / threads_per_row; \n");
+          source.append("    unsigned int row_begin = (b < num_blocks) ? blocks[block_offset + b] * block_size : size; \n");
+          source.append("    for (unsigned int r = 0; r < block_size; ++r) \n"); // uniform trip count, since the loop contains barriers
+          source.append("    { \n");
+          source.append("      unsigned int row = row_begin + r; \n");
+          source.append("      "); source.append(numeric_string); source.append(" dot_prod = 0; \n");
+          source.append("      if (row < size) \n");
+          source.append("      { \n");
+          source.append("        "); source.append(numeric_string); source.append(" x_row = x[row * layout_x.y + layout_x.x]; \n");
+          source.append("        unsigned int row_stop = row_jumper[row+1]; \n");
+          source.append("        for (unsigned int i = row_jumper[row] + lane; i < row_stop; i += threads_per_row) \n");
+          source.append("        { \n");
+          source.append("          unsigned int col = column_indices[i]; \n");
+          source.append("          dot_prod += elements[i] * x[col * layout_x.y + layout_x.x]; \n");
+          source.append("          if (col != row) \n");
+          source.append("            result[col * layout_result.y + layout_result.x] += elements[i] * x_row; \n");
+          source.append("        } \n");
+          source.append("      } \n");
+          source.append("      shared_buffer[get_local_id(0)] = dot_prod; \n");
+          source.append("      for (unsigned int stride = threads_per_row / 2; stride > 0; stride /= 2) \n");
+          source.append("      { \n");
+          source.append("        barrier(CLK_LOCAL_MEM_FENCE); \n");
+          source.append("        if (lane < stride) \n");
+          source.append("          shared_buffer[get_local_id(0)] += shared_buffer[get_local_id(0) + stride]; \n");
+          source.append("      } \n");
+          source.append("      barrier(CLK_LOCAL_MEM_FENCE | CLK_GLOBAL_MEM_FENCE); \n"); // updates of the result from preceding rows of the block are complete
+          source.append("      if (lane == 0 && row < size) \n");
+          source.append("        result[row * layout_result.y + layout_result.x] += shared_buffer[get_local_id(0)]; \n");
+          source.append("      barrier(CLK_LOCAL_MEM_FENCE | CLK_GLOBAL_MEM_FENCE); \n");
+          source.append("    } \n");
+          source.append("  } \n");
+          source.append("} \n");
+        }
+
+        // Row norms and diagonal, one color per launch. Row norms of the lower triangular part are accumulated from the stored upper triangular part.
+        template <typename StringType>
+        void generate_symmetric_compressed_matrix_row_info_extractor(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void row_info_extractor( \n");
+          source.append("          __global const unsigned int * row_jumper, \n");
+          source.append("          __global const unsigned int * column_indices, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * elements, \n");
+          source.append("          __global const unsigned int * blocks, \n");
+          source.append("          unsigned int block_offset, \n");
+          source.append("          unsigned int num_blocks, \n");
+          source.append("          unsigned int block_size, \n");
+          source.append("          unsigned int size, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * result, \n");
+          source.append("          unsigned int option \n");
+          source.append("          ) \n");
+          source.append("{ \n");
+          source.append("  for (unsigned int b = get_global_id(0); b < num_blocks; b += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    unsigned int row_begin = blocks[block_offset + b] * block_size; \n");
+          source.append("    unsigned int row_end   = min(row_begin + block_size, size); \n");
+          source.append("    for (unsigned int row = row_begin; row < row_end; ++row) \n");
+          source.append("    { \n");
+          source.append("      unsigned int row_stop = row_jumper[row+1]; \n");
+          source.append("      for (unsigned int i = row_jumper[row]; i < row_stop; ++i) \n");
+          source.append("      { \n");
+          source.append("        unsigned int col = column_indices[i]; \n");
+          source.append("        "); source.append(numeric_string); source.append(" value = elements[i]; \n");
+          source.append("        switch (option) \n");
+          source.append("        { \n");
+          source.append("          case 0: \n"); //inf-norm
+          source.append("            result[row] = max(result[row], fabs(value)); \n");
+          source.append("            if (col != row) result[col] = max(result[col], fabs(value)); \n");
+          source.append("            break; \n");
+          source.append("          case 1: \n"); //1-norm
+          source.append("            result[row] += fabs(value); \n");
+          source.append("            if (col != row) result[col] += fabs(value); \n");
+          source.append("            break; \n");
+          source.append("          case 2: \n"); //2-norm, square root is taken in row_info_sqrt
+          source.append("            result[row] += value * value; \n");
+          source.append("            if (col != row) result[col] += value * value; \n");
+          source.append("            break; \n");
+          source.append("          case 3: \n"); //diagonal entry
+          source.append("            if (col == row) result[row] = value; \n");
+          source.append("            break; \n");
+          source.append("          default: \n");
+          source.append("            break; \n");
+          source.append("        } \n");
+          source.append("      } \n");
+          source.append("    } \n");
+          source.append("  } \n");
+          source.append("} \n");
+        }
+
+        template <typename StringType>
+        void generate_symmetric_compressed_matrix_row_info_sqrt(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void row_info_sqrt( \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * result, \n");
+          source.append("          unsigned int size) \n");
+          source.append("{ \n");
+          source.append("  for (unsigned int row = get_global_id(0); row < size; row += get_global_size(0)) \n");
+          source.append("    result[row] = sqrt(result[row]); \n");
+          source.append("} \n");
+        }
+
+        //////////////////////////// Part 2: Main kernel class ////////////////////////////////////
+
+        // main kernel class
+        template <typename NumericT>
+        struct symmetric_compressed_matrix
+        {
+          static std::string program_name()
+          {
+            return viennacl::ocl::type_to_string<NumericT>::apply() + "_symmetric_compressed_matrix";
+          }
+
+          static void init(viennacl::ocl::context & ctx)
+          {
+            viennacl::ocl::DOUBLE_PRECISION_CHECKER<NumericT>::apply(ctx);
+            std::string numeric_string = viennacl::ocl::type_to_string<NumericT>::apply();
+
+            static std::map<cl_context, bool> init_done;
+            if (!init_done[ctx.handle().get()])
+            {
+              std::string source;
+              source.reserve(8192);
+
+              viennacl::ocl::append_double_precision_pragma<NumericT>(ctx, source);
+
+              // fully parametrized kernels:
+              generate_symmetric_compressed_matrix_vec_mul(source, numeric_string);
+              generate_symmetric_compressed_matrix_row_info_extractor(source, numeric_string);
+              generate_symmetric_compressed_matrix_row_info_sqrt(source, numeric_string);
+
+              std::string prog_name = program_name();
+              #ifdef VIENNACL_BUILD_INFO
+              std::cout << "Creating program " << prog_name << std::endl;
+              #endif
+              ctx.add_program(source, prog_name);
+              init_done[ctx.handle().get()] = true;
+            } //if
+          } //init
+        };
+
+      }  // namespace kernels
+    }  // namespace opencl
+  }  // namespace linalg
+}  // namespace viennacl
+#endif
@@ -0,0 +1,73 @@
+#ifndef VIENNACL_LINALG_OPENCL_NMF_OPERATIONS_HPP_
+#define VIENNACL_LINALG_OPENCL_NMF_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/opencl/nmf_operations.hpp
+    @brief Implementations of the element-wise operations used by the nonnegative matrix factorization using OpenCL.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/handle.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/opencl/kernels/nmf.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace opencl
+    {
+
+      /** @brief Multiplicative update A = A .* B ./ C (MATLAB syntax). Entries with a denominator below 1e-5 are set to zero.
+      *
+      * The kernel runs over the full padded buffers, hence A, B and C must share the same internal layout (no ranges or slices).
+      *
+      * @param A   The matrix to be updated
+      * @param B   The numerator
+      * @param C   The denominator
+      */
+      template <typename NumericT, typename F>
+      void el_wise_mul_div(matrix_base<NumericT, F> & A,
+                           matrix_base<NumericT, F> const & B,
+                           matrix_base<NumericT, F> const & C)
+      {
+        assert(viennacl::traits::opencl_handle(A).context() == viennacl::traits::opencl_handle(B).context() && bool("Matrices do not reside in the same OpenCL context. Automatic migration not yet supported!"));
+        assert(viennacl::traits::opencl_handle(A).context() == viennacl::traits::opencl_handle(C).context() && bool("Matrices do not reside in the same OpenCL context. Automatic migration not yet supported!"));
+        assert(A.internal_size() == B.internal_size() && A.internal_size() == C.internal_size() && bool("Internal layouts of matrices do not match in el_wise_mul_div()"));
+
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
+        viennacl::linalg::opencl::kernels::nmf<NumericT>::init(ctx);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::nmf<NumericT>::program_name(), "el_wise_mul_div");
+
+        viennacl::ocl::enqueue(k(viennacl::traits::opencl_handle(A),
+                                 viennacl::traits::opencl_handle(B),
+                                 viennacl::traits::opencl_handle(C),
+                                 cl_uint(A.internal_size1() * A.internal_size2())));
+      }
+
+    } //namespace opencl
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
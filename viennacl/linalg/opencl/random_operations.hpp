@@ -0,0 +1,115 @@
+#ifndef VIENNACL_LINALG_OPENCL_RANDOM_OPERATIONS_HPP_
+#define VIENNACL_LINALG_OPENCL_RANDOM_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/opencl/random_operations.hpp
+    @brief Implementations of random number generation for vectors and matrices using OpenCL.
+*/
+
+#include <string>
+
+#include "viennacl/forwards.h"
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/handle.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/meta/predicate.hpp"
+#include "viennacl/linalg/opencl/kernels/random.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace opencl
+    {
+      namespace detail
+      {
+        template <typename NumericT>
+        void random_fill(vector_base<NumericT> & vec, std::string const & kernel_name, NumericT p1, NumericT p2, unsigned int seed)
+        {
+          viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(vec).context());
+          viennacl::linalg::opencl::kernels::random<NumericT>::init(ctx);
+
+          viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::random<NumericT>::program_name(), kernel_name);
+
+          viennacl::ocl::enqueue(k(viennacl::traits::opencl_handle(vec),
+                                   cl_uint(viennacl::traits::start(vec)), cl_uint(viennacl::traits::stride(vec)),
+                                   cl_uint(viennacl::traits::size(vec)),  cl_uint(viennacl::traits::internal_size(vec)),
+                                   cl_uint(0), cl_uint(1), cl_uint(1), cl_uint(1),
+                                   cl_uint(0),
+                                   p1, p2, cl_uint(seed)
+                                  )
+                                );
+        }
+
+        template <typename NumericT, typename F>
+        void random_fill(matrix_base<NumericT, F> & mat, std::string const & kernel_name, NumericT p1, NumericT p2, unsigned int seed)
+        {
+          viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(mat).context());
+          viennacl::linalg::opencl::kernels::random<NumericT>::init(ctx);
+
+          viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::random<NumericT>::program_name(), kernel_name);
+
+          viennacl::ocl::enqueue(k(viennacl::traits::opencl_handle(mat),
+                                   cl_uint(viennacl::traits::start1(mat)), cl_uint(viennacl::traits::stride1(mat)),
+                                   cl_uint(viennacl::traits::size1(mat)),  cl_uint(viennacl::traits::internal_size1(mat)),
+                                   cl_uint(viennacl::traits::start2(mat)), cl_uint(viennacl::traits::stride2(mat)),
+                                   cl_uint(viennacl::traits::size2(mat)),  cl_uint(viennacl::traits::internal_size2(mat)),
+                                   cl_uint(viennacl::is_row_major<F>::value ? 1 : 0),
+                                   p1, p2, cl_uint(seed)
+                                  )
+                                );
+        }
+      }
+
+      /** @brief Fills the vector or matrix with uniformly distributed random numbers in [a, b)
+      *
+      * @param obj   The vector or matrix to be filled
+      * @param a     Lower bound of the interval
+      * @param b     Upper bound of the interval
+      * @param seed  Seed (key) of the random stream
+      */
+      template <typename ObjectT, typename NumericT>
+      void random_uniform(ObjectT & obj, NumericT a, NumericT b, unsigned int seed)
+      {
+        detail::random_fill(obj, "random_uniform", a, b, seed);
+      }
+
+      /** @brief Fills the vector or matrix with normally distributed random numbers
+      *
+      * @param obj    The vector or matrix to be filled
+      * @param mu     Mean of the distribution
+      * @param sigma  Standard deviation of the distribution
+      * @param seed   Seed (key) of the random stream
+      */
+      template <typename ObjectT, typename NumericT>
+      void random_gaussian(ObjectT & obj, NumericT mu, NumericT sigma, unsigned int seed)
+      {
+        detail::random_fill(obj, "random_gaussian", mu, sigma, seed);
+      }
+
+    } // namespace opencl
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
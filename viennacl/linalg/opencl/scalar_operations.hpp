@@ -202,6 +202,36 @@ namespace viennacl
       }
 
 
+      /** @brief Computes s1 = s2 / s3, where s1 is set to zero if s3 is zero
+      *
+      * @param s1   The result scalar
+      * @param s2   The numerator
+      * @param s3   The denominator
+      */
+      template <typename S1, typename S2, typename S3>
+      typename viennacl::enable_if<    viennacl::is_scalar<S1>::value
+                                    && viennacl::is_scalar<S2>::value
+                                    && viennacl::is_scalar<S3>::value
+                                  >::type
+      safe_div(S1 & s1, S2 const & s2, S3 const & s3)
+      {
+        assert( &viennacl::traits::opencl_handle(s1).context() == &viennacl::traits::opencl_handle(s2).context() && bool("Operands not in the same OpenCL context!"));
+        assert( &viennacl::traits::opencl_handle(s1).context() == &viennacl::traits::opencl_handle(s3).context() && bool("Operands not in the same OpenCL context!"));
+
+        typedef typename viennacl::result_of::cpu_value_type<S1>::type        value_type;
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(s1).context());
+        viennacl::linalg::opencl::kernels::scalar<value_type>::init(ctx);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::scalar<value_type>::program_name(), "safe_div");
+        k.local_work_size(0, 1);
+        k.global_work_size(0, 1);
+        viennacl::ocl::enqueue(k(viennacl::traits::opencl_handle(s1),
+                                 viennacl::traits::opencl_handle(s2),
+                                 viennacl::traits::opencl_handle(s3))
+                              );
+      }
+
+
 
     } //namespace opencl
   } //namespace linalg
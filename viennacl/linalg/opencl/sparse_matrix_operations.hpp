@@ -34,6 +34,8 @@
 #include "viennacl/linalg/opencl/kernels/ell_matrix.hpp"
 #include "viennacl/linalg/opencl/kernels/hyb_matrix.hpp"
 #include "viennacl/linalg/opencl/kernels/compressed_compressed_matrix.hpp"
+#include "viennacl/linalg/opencl/kernels/symmetric_compressed_matrix.hpp"
+#include "viennacl/linalg/opencl/vector_operations.hpp"
 
 
 namespace viennacl
@@ -485,6 +487,103 @@ namespace viennacl
       }
 
 
+      //
+      // Symmetric Compressed matrix
+      //
+
+      namespace detail
+      {
+        template<typename SCALARTYPE>
+        void row_info(symmetric_compressed_matrix<SCALARTYPE> const & mat,
+                      vector_base<SCALARTYPE> & vec,
+                      viennacl::linalg::detail::row_info_types info_selector)
+        {
+          viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(mat).context());
+          viennacl::linalg::opencl::kernels::symmetric_compressed_matrix<SCALARTYPE>::init(ctx);
+          viennacl::ocl::kernel & row_info_kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::symmetric_compressed_matrix<SCALARTYPE>::program_name(), "row_info_extractor");
+
+          viennacl::linalg::opencl::vector_assign(vec, SCALARTYPE(0));
+
+          std::vector<std::size_t> const & color_offsets = mat.color_offsets();
+          for (std::size_t color = 0; color + 1 < color_offsets.size(); ++color)
+          {
+            viennacl::ocl::enqueue(row_info_kernel(mat.handle1().opencl_handle(), mat.handle2().opencl_handle(), mat.handle().opencl_handle(),
+                                                   mat.handle3().opencl_handle(),
+                                                   cl_uint(color_offsets[color]),
+                                                   cl_uint(color_offsets[color+1] - color_offsets[color]),
+                                                   cl_uint(mat.block_size()),
+                                                   cl_uint(mat.size1()),
+                                                   viennacl::traits::opencl_handle(vec),
+                                                   cl_uint(info_selector)
+                                                  )
+                                  );
+          }
+
+          if (info_selector == viennacl::linalg::detail::SPARSE_ROW_NORM_2)
+          {
+            viennacl::ocl::kernel & sqrt_kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::symmetric_compressed_matrix<SCALARTYPE>::program_name(), "row_info_sqrt");
+            viennacl::ocl::enqueue(sqrt_kernel(viennacl::traits::opencl_handle(vec), cl_uint(mat.size1())));
+          }
+        }
+      }
+
+      /** @brief Carries out matrix-vector multiplication with a symmetric_compressed_matrix
+      *
+      * Implementation of the convenience expression result = prod(mat, vec);
+      * One kernel is launched per color of row blocks. Blocks of the same color write to disjoint entries of the result vector.
+      * Each row is processed by a group of work items, which share its entries.
+      *
+      * @param mat    The matrix
+      * @param vec    The vector
+      * @param result The result vector
+      */
+      template<class TYPE>
+      void prod_impl(const viennacl::symmetric_compressed_matrix<TYPE> & mat,
+                     const viennacl::vector_base<TYPE> & vec,
+                           viennacl::vector_base<TYPE> & result)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(mat).context());
+        viennacl::linalg::opencl::kernels::symmetric_compressed_matrix<TYPE>::init(ctx);
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::symmetric_compressed_matrix<TYPE>::program_name(), "vec_mul");
+
+        viennacl::ocl::packed_cl_uint layout_vec;
+        layout_vec.start  = cl_uint(viennacl::traits::start(vec));
+        layout_vec.stride = cl_uint(viennacl::traits::stride(vec));
+        layout_vec.size   = cl_uint(viennacl::traits::size(vec));
+        layout_vec.internal_size   = cl_uint(viennacl::traits::internal_size(vec));
+
+        viennacl::ocl::packed_cl_uint layout_result;
+        layout_result.start  = cl_uint(viennacl::traits::start(result));
+        layout_result.stride = cl_uint(viennacl::traits::stride(result));
+        layout_result.size   = cl_uint(viennacl::traits::size(result));
+        layout_result.internal_size   = cl_uint(viennacl::traits::internal_size(result));
+
+        viennacl::linalg::opencl::vector_assign(result, TYPE(0));
+
+        std::size_t threads_per_row  = mat.threads_per_row();
+        std::size_t blocks_per_group = 128 / threads_per_row;
+        k.local_work_size(0, 128);
+
+        std::vector<std::size_t> const & color_offsets = mat.color_offsets();
+        for (std::size_t color = 0; color + 1 < color_offsets.size(); ++color)
+        {
+          std::size_t num_blocks = color_offsets[color+1] - color_offsets[color];
+          k.global_work_size(0, 128 * std::min<std::size_t>((num_blocks + blocks_per_group - 1) / blocks_per_group, 1024));
+
+          viennacl::ocl::enqueue(k(mat.handle1().opencl_handle(), mat.handle2().opencl_handle(), mat.handle().opencl_handle(),
+                                   mat.handle3().opencl_handle(),
+                                   cl_uint(color_offsets[color]),
+                                   cl_uint(num_blocks),
+                                   cl_uint(mat.block_size()),
+                                   cl_uint(mat.size1()),
+                                   cl_uint(threads_per_row),
+                                   vec, layout_vec,
+                                   result, layout_result
+                                  ));
+        }
+      }
+
+
       //
       // Coordinate matrix
       //
@@ -360,6 +360,22 @@ namespace viennacl
 
       ///////////////////////// Norms and inner product ///////////////////
 
+      namespace detail
+      {
+        /** @brief Allocates the buffer for the partial results of the reduction kernel 'k' and returns the number of partial results.
+        *
+        * Each work group of 'k' writes exactly one entry, hence the buffer is not initialized.
+        * This saves a kernel launch for clearing the buffer on every reduction, which matters for chains of small reductions into device scalars.
+        */
+        template <typename T>
+        std::size_t create_partial_buffer(viennacl::ocl::kernel const & k, vector_base<T> const & vec, viennacl::backend::mem_handle & h)
+        {
+          std::size_t work_groups = k.global_work_size() / k.local_work_size();
+          viennacl::backend::memory_create(h, sizeof(T) * work_groups, viennacl::traits::context(vec));
+          return work_groups;
+        }
+      }
+
       /** @brief Computes the partial inner product of two vectors - implementation. Library users should call inner_prod(vec1, vec2).
       *
       * @param vec1 The first vector
@@ -424,10 +440,11 @@ namespace viennacl
         assert(viennacl::traits::opencl_handle(vec1).context() == viennacl::traits::opencl_handle(result).context() && bool("Operands do not reside in the same OpenCL context. Automatic migration not yet supported!"));
 
         viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(vec1).context());
+        viennacl::linalg::opencl::kernels::vector<T>::init(ctx);
 
-        std::size_t work_groups = 128;
-        viennacl::vector<T> temp(work_groups, viennacl::traits::context(vec1));
-        temp.resize(work_groups, ctx); // bring default-constructed vectors to the correct size:
+        viennacl::backend::mem_handle temp_handle;
+        std::size_t work_groups = detail::create_partial_buffer(ctx.get_kernel(viennacl::linalg::opencl::kernels::vector<T>::program_name(), "inner_prod1"), vec1, temp_handle);
+        viennacl::vector_base<T> temp(temp_handle, work_groups, 0, 1);
 
         // Step 1: Compute partial inner products for each work group:
         inner_prod_impl(vec1, vec2, temp);
@@ -435,8 +452,8 @@ namespace viennacl
         // Step 2: Sum partial results:
         viennacl::ocl::kernel & ksum = ctx.get_kernel(viennacl::linalg::opencl::kernels::vector<T>::program_name(), "sum");
 
-        ksum.local_work_size(0, work_groups);
-        ksum.global_work_size(0, work_groups);
+        ksum.local_work_size(0, 128);
+        ksum.global_work_size(0, 128);
         viennacl::ocl::enqueue(ksum(viennacl::traits::opencl_handle(temp),
                                     cl_uint(viennacl::traits::start(temp)),
                                     cl_uint(viennacl::traits::stride(temp)),
@@ -657,10 +674,11 @@ namespace viennacl
         assert(viennacl::traits::opencl_handle(vec1).context() == viennacl::traits::opencl_handle(vec2).context() && bool("Vectors do not reside in the same OpenCL context. Automatic migration not yet supported!"));
 
         viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(vec1).context());
+        viennacl::linalg::opencl::kernels::vector<T>::init(ctx);
 
-        std::size_t work_groups = 128;
-        viennacl::vector<T> temp(work_groups, viennacl::traits::context(vec1));
-        temp.resize(work_groups, ctx); // bring default-constructed vectors to the correct size:
+        viennacl::backend::mem_handle temp_handle;
+        std::size_t work_groups = detail::create_partial_buffer(ctx.get_kernel(viennacl::linalg::opencl::kernels::vector<T>::program_name(), "inner_prod1"), vec1, temp_handle);
+        viennacl::vector_base<T> temp(temp_handle, work_groups, 0, 1);
 
         // Step 1: Compute partial inner products for each work group:
         inner_prod_impl(vec1, vec2, temp);
@@ -724,9 +742,11 @@ namespace viennacl
         assert(viennacl::traits::opencl_handle(vec).context() == viennacl::traits::opencl_handle(result).context() && bool("Operands do not reside in the same OpenCL context. Automatic migration not yet supported!"));
 
         viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(vec).context());
+        viennacl::linalg::opencl::kernels::vector<T>::init(ctx);
 
-        std::size_t work_groups = 128;
-        viennacl::vector<T> temp(work_groups, viennacl::traits::context(vec));
+        viennacl::backend::mem_handle temp_handle;
+        std::size_t work_groups = detail::create_partial_buffer(ctx.get_kernel(viennacl::linalg::opencl::kernels::vector<T>::program_name(), "norm"), vec, temp_handle);
+        viennacl::vector_base<T> temp(temp_handle, work_groups, 0, 1);
 
         // Step 1: Compute the partial work group results
         norm_reduction_impl(vec, temp, 1);
@@ -734,8 +754,8 @@ namespace viennacl
         // Step 2: Compute the partial reduction using OpenCL
         viennacl::ocl::kernel & ksum = ctx.get_kernel(viennacl::linalg::opencl::kernels::vector<T>::program_name(), "sum");
 
-        ksum.local_work_size(0, work_groups);
-        ksum.global_work_size(0, work_groups);
+        ksum.local_work_size(0, 128);
+        ksum.global_work_size(0, 128);
         viennacl::ocl::enqueue(ksum(viennacl::traits::opencl_handle(temp),
                                     cl_uint(viennacl::traits::start(temp)),
                                     cl_uint(viennacl::traits::stride(temp)),
@@ -755,8 +775,12 @@ namespace viennacl
       void norm_1_cpu(vector_base<T> const & vec,
                       T & result)
       {
-        std::size_t work_groups = 128;
-        viennacl::vector<T> temp(work_groups, viennacl::traits::context(vec));
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(vec).context());
+        viennacl::linalg::opencl::kernels::vector<T>::init(ctx);
+
+        viennacl::backend::mem_handle temp_handle;
+        std::size_t work_groups = detail::create_partial_buffer(ctx.get_kernel(viennacl::linalg::opencl::kernels::vector<T>::program_name(), "norm"), vec, temp_handle);
+        viennacl::vector_base<T> temp(temp_handle, work_groups, 0, 1);
 
         // Step 1: Compute the partial work group results
         norm_reduction_impl(vec, temp, 1);
@@ -789,9 +813,11 @@ namespace viennacl
         assert(viennacl::traits::opencl_handle(vec).context() == viennacl::traits::opencl_handle(result).context() && bool("Operands do not reside in the same OpenCL context. Automatic migration not yet supported!"));
 
         viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(vec).context());
+        viennacl::linalg::opencl::kernels::vector<T>::init(ctx);
 
-        std::size_t work_groups = 128;
-        viennacl::vector<T> temp(work_groups, viennacl::traits::context(vec));
+        viennacl::backend::mem_handle temp_handle;
+        std::size_t work_groups = detail::create_partial_buffer(ctx.get_kernel(viennacl::linalg::opencl::kernels::vector<T>::program_name(), "norm"), vec, temp_handle);
+        viennacl::vector_base<T> temp(temp_handle, work_groups, 0, 1);
 
         // Step 1: Compute the partial work group results
         norm_reduction_impl(vec, temp, 2);
@@ -799,8 +825,8 @@ namespace viennacl
         // Step 2: Reduction via OpenCL
         viennacl::ocl::kernel & ksum = ctx.get_kernel(viennacl::linalg::opencl::kernels::vector<T>::program_name(), "sum");
 
-        ksum.local_work_size(0, work_groups);
-        ksum.global_work_size(0, work_groups);
+        ksum.local_work_size(0, 128);
+        ksum.global_work_size(0, 128);
         viennacl::ocl::enqueue( ksum(viennacl::traits::opencl_handle(temp),
                                       cl_uint(viennacl::traits::start(temp)),
                                       cl_uint(viennacl::traits::stride(temp)),
@@ -820,8 +846,12 @@ namespace viennacl
       void norm_2_cpu(vector_base<T> const & vec,
                       T & result)
       {
-        std::size_t work_groups = 128;
-        viennacl::vector<T> temp(work_groups, viennacl::traits::context(vec));
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(vec).context());
+        viennacl::linalg::opencl::kernels::vector<T>::init(ctx);
+
+        viennacl::backend::mem_handle temp_handle;
+        std::size_t work_groups = detail::create_partial_buffer(ctx.get_kernel(viennacl::linalg::opencl::kernels::vector<T>::program_name(), "norm"), vec, temp_handle);
+        viennacl::vector_base<T> temp(temp_handle, work_groups, 0, 1);
 
         // Step 1: Compute the partial work group results
         norm_reduction_impl(vec, temp, 2);
@@ -854,17 +884,19 @@ namespace viennacl
         assert(viennacl::traits::opencl_handle(vec).context() == viennacl::traits::opencl_handle(result).context() && bool("Operands do not reside in the same OpenCL context. Automatic migration not yet supported!"));
 
         viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(vec).context());
+        viennacl::linalg::opencl::kernels::vector<T>::init(ctx);
 
-        std::size_t work_groups = 128;
-        viennacl::vector<T> temp(work_groups, viennacl::traits::context(vec));
+        viennacl::backend::mem_handle temp_handle;
+        std::size_t work_groups = detail::create_partial_buffer(ctx.get_kernel(viennacl::linalg::opencl::kernels::vector<T>::program_name(), "norm"), vec, temp_handle);
+        viennacl::vector_base<T> temp(temp_handle, work_groups, 0, 1);
 
         // Step 1: Compute the partial work group results
         norm_reduction_impl(vec, temp, 0);
 
         //part 2: parallel reduction of reduced kernel:
         viennacl::ocl::kernel & ksum = ctx.get_kernel(viennacl::linalg::opencl::kernels::vector<T>::program_name(), "sum");
-        ksum.local_work_size(0, work_groups);
-        ksum.global_work_size(0, work_groups);
+        ksum.local_work_size(0, 128);
+        ksum.global_work_size(0, 128);
 
         viennacl::ocl::enqueue( ksum(viennacl::traits::opencl_handle(temp),
                                      cl_uint(viennacl::traits::start(temp)),
@@ -885,8 +917,12 @@ namespace viennacl
       void norm_inf_cpu(vector_base<T> const & vec,
                         T & result)
       {
-        std::size_t work_groups = 128;
-        viennacl::vector<T> temp(work_groups, viennacl::traits::context(vec));
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(vec).context());
+        viennacl::linalg::opencl::kernels::vector<T>::init(ctx);
+
+        viennacl::backend::mem_handle temp_handle;
+        std::size_t work_groups = detail::create_partial_buffer(ctx.get_kernel(viennacl::linalg::opencl::kernels::vector<T>::program_name(), "norm"), vec, temp_handle);
+        viennacl::vector_base<T> temp(temp_handle, work_groups, 0, 1);
 
         // Step 1: Compute the partial work group results
         norm_reduction_impl(vec, temp, 0);
@@ -20,13 +20,16 @@
 
 #include <cmath>
 
-#include "viennacl/linalg/opencl/kernels/svd.hpp"
 #include "viennacl/meta/result_of.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/matrix.hpp"
 
-#include <boost/numeric/ublas/vector.hpp>
-#include <boost/numeric/ublas/io.hpp>
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/opencl/kernels/svd.hpp"
+
+  #include <boost/numeric/ublas/vector.hpp>
+  #include <boost/numeric/ublas/io.hpp>
+#endif
 
 /** @file viennacl/linalg/qr-method-common.hpp
     @brief Common routines used for the QR method and SVD. Experimental.
@@ -100,6 +103,7 @@ namespace viennacl
         normalize(v, v.size());
       }
 
+#ifdef VIENNACL_WITH_OPENCL
       template <typename MatrixType>
       void transpose(MatrixType & A)
       {
@@ -114,7 +118,7 @@ namespace viennacl
                                      )
                               );
       }
-
+#endif
 
 
       template <typename T>
@@ -139,7 +143,7 @@ namespace viennacl
           }
       }
 
-
+#ifdef VIENNACL_WITH_OPENCL
       template <typename SCALARTYPE, unsigned int ALIGNMENT>
       void copy_vec(viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT>& A,
                     viennacl::vector<SCALARTYPE, ALIGNMENT>& V,
@@ -189,6 +193,7 @@ namespace viennacl
 
         //std::cout << "2: "  << D << "\n";
       }
+#endif
 
       template <typename SCALARTYPE, unsigned int ALIGNMENT>
       void eye(viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT>& A)
@@ -203,6 +208,7 @@ namespace viennacl
         viennacl::fast_copy(&foo[0], &foo[0] + foo.size(), A);
       }
 
+#ifdef VIENNACL_WITH_OPENCL
       template <typename SCALARTYPE, unsigned int ALIGNMENT, typename VectorType>
       void bidiag_pack(viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT>& A,
                        VectorType & dh,
@@ -227,6 +233,7 @@ namespace viennacl
         fast_copy(D, dh);
         fast_copy(S, sh);
       }
+#endif
 
     }
   }
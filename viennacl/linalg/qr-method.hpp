@@ -24,6 +24,7 @@
 #include <examples/benchmarks/benchmark-utils.hpp>
 
 #include "viennacl/linalg/qr-method-common.hpp"
+#include "viennacl/linalg/host_based/eig_operations.hpp"
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
@@ -38,6 +39,7 @@ namespace viennacl
   {
     namespace detail
     {
+#ifdef VIENNACL_WITH_OPENCL
         template<typename MatrixType, typename VectorType>
         void givens_next(MatrixType& matrix,
                         VectorType& tmp1,
@@ -922,9 +924,27 @@ namespace viennacl
 
             copy(eigen_values, A);
         }
+#endif
+
+        /** @brief Copies the eigenvalues from the host to the uBLAS vector D */
+        template <typename SCALARTYPE>
+        void copy_eigenvalues(std::vector<SCALARTYPE> const & eigenvalues,
+                              boost::numeric::ublas::vector<SCALARTYPE> & D)
+        {
+          D.resize(eigenvalues.size());
+          for (std::size_t i = 0; i < eigenvalues.size(); ++i)
+            D(i) = eigenvalues[i];
+        }
     }
 
 
+    /** @brief Computes the eigenvalues and eigenvectors of a nonsymmetric matrix. Only available with OpenCL.
+     *
+     * @param A     The input matrix. Will be overwritten with the quasi-triangular matrix of eigenvalues on return
+     * @param Q     The matrix of eigenvectors
+     * @param D     The real parts of the eigenvalues
+     * @param E     The imaginary parts of the eigenvalues
+     */
     template <typename SCALARTYPE, typename F, unsigned int ALIGNMENT>
     void qr_method_nsm(viennacl::matrix<SCALARTYPE, F, ALIGNMENT>& A,
                        viennacl::matrix<SCALARTYPE, F, ALIGNMENT>& Q,
@@ -932,18 +952,98 @@ namespace viennacl
                        boost::numeric::ublas::vector<SCALARTYPE>& E
                       )
     {
-        detail::qr_method(A, Q, D, E, false);
+#ifndef VIENNACL_WITH_OPENCL
+      (void)Q; (void)D; (void)E;
+#endif
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          detail::qr_method(A, Q, D, E, false);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
     }
 
+    /** @brief Computes the eigenvalues and eigenvectors of a symmetric matrix.
+     *
+     * On the host, the matrix is reduced to tridiagonal form by blocked Householder transformations and the tridiagonal eigenproblem is solved by divide-and-conquer.
+     *
+     * @param A     The symmetric input matrix. Will be overwritten with the diagonal matrix of eigenvalues on return
+     * @param Q     The orthogonal matrix holding the eigenvectors in its columns
+     * @param D     The eigenvalues
+     */
     template <typename SCALARTYPE, typename F, unsigned int ALIGNMENT>
     void qr_method_sym(viennacl::matrix<SCALARTYPE, F, ALIGNMENT>& A,
                        viennacl::matrix<SCALARTYPE, F, ALIGNMENT>& Q,
                        boost::numeric::ublas::vector<SCALARTYPE>& D
                       )
     {
-        boost::numeric::ublas::vector<SCALARTYPE> E(A.size1());
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+        {
+          std::vector<SCALARTYPE> eigenvalues;
+          viennacl::linalg::host_based::eig_sym(A, Q, eigenvalues);
+          detail::copy_eigenvalues(eigenvalues, D);
+          break;
+        }
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+        {
+          boost::numeric::ublas::vector<SCALARTYPE> E(A.size1());
+          detail::qr_method(A, Q, D, E, true);
+          break;
+        }
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
 
-        detail::qr_method(A, Q, D, E, true);
+    /** @brief Computes the eigenvalues of a symmetric matrix without computing the eigenvectors.
+     *
+     * On the host, the matrix is reduced to tridiagonal form by the OpenMP-parallel inplace_tred2() and the eigenvalues are computed by the implicit QL method.
+     *
+     * @param A     The symmetric input matrix
+     * @param D     The eigenvalues
+     */
+    template <typename SCALARTYPE, typename F, unsigned int ALIGNMENT>
+    void qr_method_sym(viennacl::matrix<SCALARTYPE, F, ALIGNMENT> const & A,
+                       boost::numeric::ublas::vector<SCALARTYPE>& D
+                      )
+    {
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+        {
+          std::vector<SCALARTYPE> eigenvalues;
+          viennacl::linalg::host_based::eig_sym(A, eigenvalues);
+          detail::copy_eigenvalues(eigenvalues, D);
+          break;
+        }
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+        {
+          // the OpenCL implementation always computes the eigenvectors
+          viennacl::matrix<SCALARTYPE, F, ALIGNMENT> A_copy(A);
+          viennacl::matrix<SCALARTYPE, F, ALIGNMENT> Q(A.size1(), A.size1(), viennacl::traits::context(A));
+          boost::numeric::ublas::vector<SCALARTYPE> E(A.size1());
+          detail::qr_method(A_copy, Q, D, E, true);
+          break;
+        }
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
     }
 
   }
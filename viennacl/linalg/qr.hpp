@@ -39,7 +39,11 @@
 
 #include "viennacl/matrix.hpp"
 #include "viennacl/matrix_proxy.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/backend/memory.hpp"
 #include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/host_based/householder.hpp"
+#include "viennacl/linalg/host_based/tuning_profile.hpp"
 #include "viennacl/range.hpp"
 
 namespace viennacl
@@ -312,7 +316,7 @@ namespace viennacl
       /** @brief Implementation of a OpenCL-only QR factorization for GPUs (or multi-core CPU). DEPRECATED! Use only if you're curious and interested in playing a bit with a GPU-only implementation.
       *
       * Performance is rather poor at small matrix sizes.
-      * Prefer the use of the hybrid version, which is automatically chosen using the interface function inplace_qr()
+      * Prefer the use of inplace_qr_native(), which is automatically chosen using the interface function inplace_qr()
       *
       * @param A            A dense ViennaCL matrix to be factored
       * @param block_size   The block size to be used. The number of columns of A must be a multiple of block_size
@@ -413,147 +417,160 @@ namespace viennacl
 
 
 
-      //MatrixType is ViennaCL-matrix
-      /** @brief Implementation of a hybrid QR factorization using uBLAS on the CPU and ViennaCL for GPUs (or multi-core CPU)
+      /** @brief Copies the block of A starting at (row_start, col_start) to the column-major host matrix B. The size of the block is given by the size of B.
       *
-      * Prefer the use of the convenience interface inplace_qr()
-      *
-      * @param A            A dense ViennaCL matrix to be factored
-      * @param block_size   The block size to be used. The number of columns of A must be a multiple of block_size
+      * A may reside in any memory domain. Contiguous columns (or rows) are transferred at once.
       */
-      template<typename MatrixType>
-      std::vector< typename viennacl::result_of::cpu_value_type< typename MatrixType::value_type >::type >
-      inplace_qr_hybrid(MatrixType & A, std::size_t block_size = 16)
+      template <typename T, typename F, unsigned int ALIGNMENT>
+      void qr_read_block(viennacl::matrix<T, F, ALIGNMENT> const & A, std::size_t row_start, std::size_t col_start,
+                         viennacl::matrix<T, viennacl::column_major> & B)
       {
-        typedef typename viennacl::result_of::cpu_value_type< typename MatrixType::value_type >::type   ScalarType;
+        if (B.size1() == 0 || B.size2() == 0)
+          return;
 
-        typedef viennacl::matrix_range<MatrixType>                    VCLMatrixRange;
-        typedef boost::numeric::ublas::matrix<ScalarType>             UblasMatrixType;
-        typedef boost::numeric::ublas::matrix_range<UblasMatrixType>  UblasMatrixRange;
+        std::size_t inc_row = F::mem_index(1, 0, A.internal_size1(), A.internal_size2()) - F::mem_index(0, 0, A.internal_size1(), A.internal_size2());
+        std::size_t inc_col = F::mem_index(0, 1, A.internal_size1(), A.internal_size2()) - F::mem_index(0, 0, A.internal_size1(), A.internal_size2());
 
-        std::vector<ScalarType> betas(A.size2());
-        UblasMatrixType v(A.size1(), 1);
-        UblasMatrixType matrix_1x1(1,1);
+        T * data_B = viennacl::linalg::host_based::detail::extract_raw_pointer<T>(B);
+        std::size_t ldb = B.internal_size1();
 
-        UblasMatrixType ublasW(A.size1(), block_size); ublasW.clear(); ublasW.resize(A.size1(), block_size);
-        UblasMatrixType ublasY(A.size1(), block_size); ublasY.clear(); ublasY.resize(A.size1(), block_size);
+        if (inc_row == 1)
+        {
+          for (std::size_t j=0; j<B.size2(); ++j)
+            viennacl::backend::memory_read(A.handle(), sizeof(T) * (row_start + (col_start + j) * inc_col), sizeof(T) * B.size1(), data_B + j * ldb);
+        }
+        else
+        {
+          std::vector<T> buffer(B.size2());
+          for (std::size_t i=0; i<B.size1(); ++i)
+          {
+            viennacl::backend::memory_read(A.handle(), sizeof(T) * ((row_start + i) * inc_row + col_start), sizeof(T) * B.size2(), &(buffer[0]));
+            for (std::size_t j=0; j<B.size2(); ++j)
+              data_B[i + j * ldb] = buffer[j];
+          }
+        }
+      }
 
-        UblasMatrixType ublasA(A.size1(), A.size1());
+      /** @brief Copies the column-major host matrix B to the block of A starting at (row_start, col_start). A may reside in any memory domain. */
+      template <typename T, typename F, unsigned int ALIGNMENT>
+      void qr_write_block(viennacl::matrix<T, F, ALIGNMENT> & A, std::size_t row_start, std::size_t col_start,
+                          viennacl::matrix<T, viennacl::column_major> const & B)
+      {
+        if (B.size1() == 0 || B.size2() == 0)
+          return;
 
-        MatrixType vclW(ublasW.size1(), ublasW.size2());
-        MatrixType vclY(ublasY.size1(), ublasY.size2());
+        std::size_t inc_row = F::mem_index(1, 0, A.internal_size1(), A.internal_size2()) - F::mem_index(0, 0, A.internal_size1(), A.internal_size2());
+        std::size_t inc_col = F::mem_index(0, 1, A.internal_size1(), A.internal_size2()) - F::mem_index(0, 0, A.internal_size1(), A.internal_size2());
 
+        T const * data_B = viennacl::linalg::host_based::detail::extract_raw_pointer<T>(B);
+        std::size_t ldb = B.internal_size1();
 
-        //run over A in a block-wise manner:
-        for (std::size_t j = 0; j < std::min(A.size1(), A.size2()); j += block_size)
+        if (inc_row == 1)
         {
-          std::size_t effective_block_size = std::min(std::min(A.size1(), A.size2()), j+block_size) - j;
-          UblasMatrixRange ublasA_part = boost::numeric::ublas::project(ublasA,
-                                                                        boost::numeric::ublas::range(0, A.size1()),
-                                                                        boost::numeric::ublas::range(j, j + effective_block_size));
-          viennacl::copy(viennacl::project(A,
-                                          viennacl::range(0, A.size1()),
-                                          viennacl::range(j, j+effective_block_size)),
-                         ublasA_part
-                        );
-
-          //determine Householder vectors:
-          for (std::size_t k = 0; k < effective_block_size; ++k)
+          for (std::size_t j=0; j<B.size2(); ++j)
+            viennacl::backend::memory_write(A.handle(), sizeof(T) * (row_start + (col_start + j) * inc_col), sizeof(T) * B.size1(), data_B + j * ldb);
+        }
+        else
+        {
+          std::vector<T> buffer(B.size2());
+          for (std::size_t i=0; i<B.size1(); ++i)
           {
-            betas[j+k] = detail::setup_householder_vector_ublas(ublasA, v, matrix_1x1, j+k);
-
-            for (std::size_t l = k; l < effective_block_size; ++l)
-              detail::householder_reflect_ublas(ublasA, v, matrix_1x1, betas[j+k], j+k, j+l);
-
-            detail::write_householder_to_A_ublas(ublasA, v, j+k);
+            for (std::size_t j=0; j<B.size2(); ++j)
+              buffer[j] = data_B[i + j * ldb];
+            viennacl::backend::memory_write(A.handle(), sizeof(T) * ((row_start + i) * inc_row + col_start), sizeof(T) * B.size2(), &(buffer[0]));
           }
+        }
+      }
 
-          //
-          // Setup Y:
-          //
-          ublasY.clear();  ublasY.resize(A.size1(), block_size);
-          for (std::size_t k = 0; k < effective_block_size; ++k)
-          {
-            //write Householder to Y:
-            ublasY(j+k,k) = 1.0;
-            boost::numeric::ublas::project(ublasY,
-                                           boost::numeric::ublas::range(j+k+1, A.size1()),
-                                           boost::numeric::ublas::range(k, k+1))
-              = boost::numeric::ublas::project(ublasA,
-                                               boost::numeric::ublas::range(j+k+1, A.size1()),
-                                               boost::numeric::ublas::range(j+k, j+k+1));
-          }
+      /** @brief Sets up the compact WY representation I - V T V^T of a block of reflectors in the memory domain of V and T.
+      *
+      * @param data   Pointer to the diagonal entry of the first reflector in a column-major host array
+      * @param ld     Leading dimension of the host array
+      * @param tau    The scalar factors of the reflectors
+      * @param V      The matrix of reflectors (output). Its size determines the length and the number of reflectors
+      * @param T      The upper triangular factor (output)
+      */
+      template <typename T, typename F, unsigned int ALIGNMENT>
+      void qr_setup_block_reflector(T const * data, std::size_t ld, T const * tau,
+                                    viennacl::matrix<T, F, ALIGNMENT> & V,
+                                    viennacl::matrix<T, F, ALIGNMENT> & T_factor)
+      {
+        viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+        viennacl::matrix<T, viennacl::column_major> V_host(V.size1(), V.size2(), host_ctx);
+        viennacl::matrix<T, viennacl::column_major> T_host(V.size2(), V.size2(), host_ctx);
 
-          //
-          // Setup W:
-          //
+        viennacl::linalg::host_based::detail::householder_extract_block(data, ld, V_host);
+        viennacl::linalg::host_based::detail::householder_block_factor(V_host, tau, T_host);
 
-          //first vector:
-          ublasW.clear();  ublasW.resize(A.size1(), block_size);
-          ublasW(j, 0) = -betas[j];
-          boost::numeric::ublas::project(ublasW,
-                                        boost::numeric::ublas::range(j+1, A.size1()),
-                                        boost::numeric::ublas::range(0, 1))
-            = -betas[j] * boost::numeric::ublas::project(ublasA,
-                                                          boost::numeric::ublas::range(j+1, A.size1()),
-                                                          boost::numeric::ublas::range(j, j+1));
+        qr_write_block(V, 0, 0, V_host);
+        qr_write_block(T_factor, 0, 0, T_host);
+      }
 
+      /** @brief Implementation of a blocked QR factorization operating directly on a ViennaCL matrix in any memory domain.
+      *
+      * If A resides in main memory, it is factored in place without any copies, see host_based::detail::householder_qr().
+      * Otherwise, each panel is transferred to the host and factored recursively there (using OpenMP if enabled).
+      * The trailing columns are updated in the memory domain of A by three matrix-matrix products with the block reflector in compact WY form I - V T V^T.
+      * No Boost.uBLAS types are involved. Prefer the use of the convenience interface inplace_qr()
+      *
+      * @param A            A dense ViennaCL matrix to be factored
+      * @param block_size   The number of columns per panel. The number of columns of A does not need to be a multiple of block_size. If zero, the panel width of the tuning profile is used.
+      */
+      template <typename T, typename F, unsigned int ALIGNMENT>
+      std::vector<T> inplace_qr_native(viennacl::matrix<T, F, ALIGNMENT> & A, std::size_t block_size = 0)
+      {
+        typedef viennacl::matrix<T, F, ALIGNMENT>              MatrixType;
+        typedef viennacl::matrix<T, viennacl::column_major>    HostMatrixType;
 
-          //k-th column of W is given by -beta * (Id + W*Y^T) v_k, where W and Y have k-1 columns
-          for (std::size_t k = 1; k < effective_block_size; ++k)
-          {
-            UblasMatrixRange Y_old = boost::numeric::ublas::project(ublasY,
-                                                                    boost::numeric::ublas::range(j, A.size1()),
-                                                                    boost::numeric::ublas::range(0, k));
-            UblasMatrixRange v_k   = boost::numeric::ublas::project(ublasY,
-                                                                    boost::numeric::ublas::range(j, A.size1()),
-                                                                    boost::numeric::ublas::range(k, k+1));
-            UblasMatrixRange W_old = boost::numeric::ublas::project(ublasW,
-                                                                    boost::numeric::ublas::range(j, A.size1()),
-                                                                    boost::numeric::ublas::range(0, k));
-            UblasMatrixRange z     = boost::numeric::ublas::project(ublasW,
-                                                                    boost::numeric::ublas::range(j, A.size1()),
-                                                                    boost::numeric::ublas::range(k, k+1));
-
-            UblasMatrixType YT_prod_v = boost::numeric::ublas::prod(boost::numeric::ublas::trans(Y_old), v_k);
-            z = - betas[j+k] * (v_k + prod(W_old, YT_prod_v));
-          }
+        if (block_size == 0)
+          block_size = std::max<std::size_t>(viennacl::linalg::host_based::current_tuning_profile().qr_block_size, 1);
 
+        std::size_t m = A.size1();
+        std::size_t n = A.size2();
+        std::size_t k = std::min(m, n);
 
+        viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+        viennacl::context ctx = viennacl::traits::context(A);
 
-          //
-          //apply (I+WY^T)^T = I + Y W^T to the remaining columns of A:
-          //
+        std::vector<T> betas(n);
 
-          VCLMatrixRange A_part = viennacl::project(A,
-                                                    viennacl::range(0, A.size1()),
-                                                    viennacl::range(j, j+effective_block_size));
+        if (viennacl::traits::handle(A).get_active_handle_id() == viennacl::MAIN_MEMORY)
+        {
+          viennacl::linalg::host_based::detail::householder_qr(A, betas, block_size);
+          betas.resize(n);
+          return betas;
+        }
 
-          viennacl::copy(boost::numeric::ublas::project(ublasA,
-                                                        boost::numeric::ublas::range(0, A.size1()),
-                                                        boost::numeric::ublas::range(j, j+effective_block_size)),
-                        A_part);
+        for (std::size_t j = 0; j < k; j += block_size)
+        {
+          std::size_t kb   = std::min(block_size, k - j);
+          std::size_t rows = m - j;
 
-          viennacl::copy(ublasW, vclW);
-          viennacl::copy(ublasY, vclY);
+          // factor the panel A(j:m, j:j+kb) on the host:
+          HostMatrixType P(rows, kb, host_ctx);
+          qr_read_block(A, j, j, P);
+          viennacl::linalg::host_based::detail::householder_panel_factor(P, 0, kb, &(betas[j]));
+          qr_write_block(A, j, j, P);
 
-          if (A.size2() > j + effective_block_size)
+          // apply (I - V T V^T)^T to the remaining columns of A:
+          if (j + kb < n)
           {
-
-            VCLMatrixRange A_part(A, viennacl::range(j, A.size1()), viennacl::range(j+effective_block_size, A.size2()));
-            VCLMatrixRange W_part(vclW, viennacl::range(j, A.size1()), viennacl::range(0, effective_block_size));
-            MatrixType temp = viennacl::linalg::prod(trans(W_part), A_part);
-
-            A_part += viennacl::linalg::prod(viennacl::project(vclY, viennacl::range(j, A.size1()), viennacl::range(0, vclY.size2())),
-                                             temp);
+            MatrixType V(rows, kb, ctx);
+            MatrixType T_factor(kb, kb, ctx);
+            qr_setup_block_reflector(viennacl::linalg::host_based::detail::extract_raw_pointer<T>(P), P.internal_size1(), &(betas[j]), V, T_factor);
+
+            viennacl::matrix_range<MatrixType> A_part(A, viennacl::range(j, m), viennacl::range(j + kb, n));
+            MatrixType temp1(kb, n - j - kb, ctx);
+            MatrixType temp2(kb, n - j - kb, ctx);
+            viennacl::linalg::prod_impl(trans(V), A_part, temp1, T(1), T(0));
+            viennacl::linalg::prod_impl(trans(T_factor), temp1, temp2, T(1), T(0));
+            viennacl::linalg::prod_impl(V, temp2, A_part, T(-1), T(1));
           }
         }
 
         return betas;
       }
 
-
-
     } //namespace detail
 
 
@@ -598,6 +615,88 @@ namespace viennacl
     }
 
 
+    /** @brief Generates Q and R explicitly from an inplace QR factorization of a ViennaCL matrix.
+     *
+     *  Q is accumulated backwards from blocks of reflectors I - V T V^T by matrix-matrix products in the memory domain of Q.
+     *
+     *  @param A      A matrix holding R in the upper triangular part and the Householder reflectors in the lower triangular part. Typically obtained from calling inplace_qr() on the original matrix
+     *  @param betas  The scalars beta_i for each Householder reflector (I - beta_i v_i v_i^T)
+     *  @param Q      The orthogonal matrix (output). If Q has fewer columns than rows, only the leading columns are computed.
+     *  @param R      The upper triangular matrix (output)
+     *  @param block_size  The number of reflectors per block. If zero, the panel width of the tuning profile is used.
+     */
+    template <typename T, typename F, unsigned int ALIGNMENT, typename VectorType>
+    void recoverQ(viennacl::matrix<T, F, ALIGNMENT> const & A, VectorType const & betas,
+                  viennacl::matrix<T, F, ALIGNMENT> & Q, viennacl::matrix<T, F, ALIGNMENT> & R, std::size_t block_size = 0)
+    {
+      typedef viennacl::matrix<T, F, ALIGNMENT>                MatrixType;
+      typedef viennacl::matrix<T, viennacl::column_major>      HostMatrixType;
+
+      std::size_t m = A.size1();
+      std::size_t n = A.size2();
+      std::size_t k = std::min(m, n);
+
+      if (block_size == 0)
+        block_size = std::max<std::size_t>(viennacl::linalg::host_based::current_tuning_profile().qr_block_size, 1);
+
+      assert(Q.size1() == m && Q.size2() >= k && Q.size2() <= m && bool("Size of Q does not match"));
+
+      viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+      viennacl::context ctx = viennacl::traits::context(Q);
+
+      HostMatrixType A_host(m, n, host_ctx);
+      detail::qr_read_block(A, 0, 0, A_host);
+      T const * data_A = viennacl::linalg::host_based::detail::extract_raw_pointer<T>(A_host);
+      std::size_t lda = A_host.internal_size1();
+
+      //
+      // Recover R from upper-triangular part of A:
+      //
+      HostMatrixType R_host(R.size1(), R.size2(), host_ctx);
+      T * data_R = viennacl::linalg::host_based::detail::extract_raw_pointer<T>(R_host);
+      std::size_t ldr = R_host.internal_size1();
+      for (std::size_t j=0; j<std::min(R.size2(), n); ++j)
+        for (std::size_t i=0; i<=j && i<R.size1() && i<m; ++i)
+          data_R[i + j * ldr] = data_A[i + j * lda];
+      detail::qr_write_block(R, 0, 0, R_host);
+
+      //
+      // Recover Q by applying all the block reflectors to the identity matrix:
+      //
+      HostMatrixType Q_host(Q.size1(), Q.size2(), host_ctx);
+      T * data_Q = viennacl::linalg::host_based::detail::extract_raw_pointer<T>(Q_host);
+      for (std::size_t i=0; i<Q.size2(); ++i)
+        data_Q[i + i * Q_host.internal_size1()] = T(1);
+      detail::qr_write_block(Q, 0, 0, Q_host);
+
+      if (k == 0)
+        return;
+
+      std::vector<T> tau(k);
+      for (std::size_t i=0; i<k; ++i)
+        tau[i] = betas[i];
+
+      for (std::size_t block_start = ((k - 1) / block_size) * block_size; ; block_start -= block_size)
+      {
+        std::size_t kb = std::min(block_size, k - block_start);
+
+        MatrixType V(m - block_start, kb, ctx);
+        MatrixType T_factor(kb, kb, ctx);
+        detail::qr_setup_block_reflector(data_A + block_start + block_start * lda, lda, &(tau[block_start]), V, T_factor);
+
+        // the columns 0, ..., block_start-1 of the trailing rows are still zero due to the backward accumulation:
+        viennacl::matrix_range<MatrixType> Q_part(Q, viennacl::range(block_start, m), viennacl::range(block_start, Q.size2()));
+        MatrixType temp1(kb, Q_part.size2(), ctx);
+        MatrixType temp2(kb, Q_part.size2(), ctx);
+        viennacl::linalg::prod_impl(trans(V), Q_part, temp1, T(1), T(0));
+        viennacl::linalg::prod_impl(T_factor, temp1, temp2, T(1), T(0));
+        viennacl::linalg::prod_impl(V, temp2, Q_part, T(-1), T(1));
+
+        if (block_start == 0)
+          break;
+      }
+    }
+
     /** @brief Computes Q^T b, where Q is an implicit orthogonal matrix defined via its Householder reflectors stored in A.
      *
      *  @param A      A matrix holding the Householder reflectors in the lower triangular part. Typically obtained from calling inplace_qr() on the original matrix
@@ -624,29 +723,63 @@ namespace viennacl
       }
     }
 
+    /** @brief Computes Q^T b for a ViennaCL matrix A holding the Householder reflectors, where b may reside in any memory domain.
+     *
+     *  The reflectors are applied in blocks of the form I - V T V^T, so the work is carried out by matrix-vector products in the memory domain of b.
+     *
+     *  @param A      A matrix holding the Householder reflectors in the lower triangular part. Typically obtained from calling inplace_qr() on the original matrix
+     *  @param betas  The scalars beta_i for each Householder reflector (I - beta_i v_i v_i^T)
+     *  @param b      The vector b to which the result Q^T b is directly written to
+     *  @param block_size  The number of reflectors per block. If zero, the panel width of the tuning profile is used.
+     */
     template <typename T, typename F, unsigned int ALIGNMENT, typename VectorType1, unsigned int A2>
-    void inplace_qr_apply_trans_Q(viennacl::matrix<T, F, ALIGNMENT> const & A, VectorType1 const & betas, viennacl::vector<T, A2> & b)
+    void inplace_qr_apply_trans_Q(viennacl::matrix<T, F, ALIGNMENT> const & A, VectorType1 const & betas, viennacl::vector<T, A2> & b, std::size_t block_size = 0)
     {
-      boost::numeric::ublas::matrix<T> ublas_A(A.size1(), A.size2());
-      viennacl::copy(A, ublas_A);
+      typedef viennacl::matrix<T, F, ALIGNMENT>   MatrixType;
+
+      std::size_t m = A.size1();
+      std::size_t k = std::min(A.size1(), A.size2());
+
+      if (block_size == 0)
+        block_size = std::max<std::size_t>(viennacl::linalg::host_based::current_tuning_profile().qr_block_size, 1);
+
+      viennacl::context ctx = viennacl::traits::context(b);
 
-      std::vector<T> stl_b(b.size());
-      viennacl::copy(b, stl_b);
+      viennacl::matrix<T, viennacl::column_major> A_host(m, k, viennacl::context(viennacl::MAIN_MEMORY));
+      detail::qr_read_block(A, 0, 0, A_host);
+      T const * data_A = viennacl::linalg::host_based::detail::extract_raw_pointer<T>(A_host);
+      std::size_t lda = A_host.internal_size1();
 
-      inplace_qr_apply_trans_Q(ublas_A, betas, stl_b);
+      std::vector<T> tau(k);
+      for (std::size_t i=0; i<k; ++i)
+        tau[i] = betas[i];
 
-      viennacl::copy(stl_b, b);
+      for (std::size_t block_start = 0; block_start < k; block_start += block_size)
+      {
+        std::size_t kb = std::min(block_size, k - block_start);
+
+        MatrixType V(m - block_start, kb, ctx);
+        MatrixType T_factor(kb, kb, ctx);
+        detail::qr_setup_block_reflector(data_A + block_start + block_start * lda, lda, &(tau[block_start]), V, T_factor);
+
+        viennacl::vector_range<viennacl::vector<T, A2> > b_part(b, viennacl::range(block_start, m));
+        viennacl::vector<T> temp1 = viennacl::linalg::prod(trans(V), b_part);
+        viennacl::vector<T> temp2 = viennacl::linalg::prod(trans(T_factor), temp1);
+        b_part -= viennacl::linalg::prod(V, temp2);
+      }
     }
 
     /** @brief Overload of inplace-QR factorization of a ViennaCL matrix A
+     *
+     * The factorization is carried out directly on A in its memory domain, see detail::inplace_qr_native().
      *
      * @param A            A dense ViennaCL matrix to be factored
-     * @param block_size   The block size to be used.
+     * @param block_size   The block size to be used. If zero, the panel width of the tuning profile is used.
      */
     template<typename T, typename F, unsigned int ALIGNMENT>
-    std::vector<T> inplace_qr(viennacl::matrix<T, F, ALIGNMENT> & A, std::size_t block_size = 16)
+    std::vector<T> inplace_qr(viennacl::matrix<T, F, ALIGNMENT> & A, std::size_t block_size = 0)
     {
-      return detail::inplace_qr_hybrid(A, block_size);
+      return detail::inplace_qr_native(A, block_size);
     }
 
     /** @brief Overload of inplace-QR factorization for a general Boost.uBLAS compatible matrix A
@@ -0,0 +1,303 @@
+#ifndef VIENNACL_LINALG_RANDOMIZED_SVD_HPP_
+#define VIENNACL_LINALG_RANDOMIZED_SVD_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/randomized_svd.hpp
+    @brief Randomized truncated singular value decomposition for dense and sparse matrices.
+
+    Implements the randomized range finder with power iterations of Halko, Martinsson and Tropp,
+    'Finding structure with randomness: Probabilistic algorithms for constructing approximate matrix decompositions', SIAM Review 53(2), 2011.
+*/
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/rand/gaussian.hpp"
+#include "viennacl/linalg/host_based/householder.hpp"
+#include "viennacl/linalg/host_based/svd_operations.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+#include "viennacl/linalg/detail/sparse_transpose.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    /** @brief A tag for the randomized singular value decomposition. */
+    class randomized_svd_tag
+    {
+      public:
+        /** @brief The constructor
+        *
+        * @param rank              Number of singular triplets to be computed
+        * @param oversampling      Number of additional random samples taken for the range finder. Improves accuracy at little cost.
+        * @param power_iterations  Number of power iterations with A * A^T. Required for matrices with slowly decaying singular values.
+        * @param seed              Seed for the random test matrix
+        */
+        randomized_svd_tag(std::size_t rank,
+                           std::size_t oversampling = 10,
+                           std::size_t power_iterations = 2,
+                           unsigned int seed = 0) : rank_(rank), oversampling_(oversampling), power_iterations_(power_iterations), seed_(seed) {}
+
+        /** @brief Returns the number of singular triplets to be computed */
+        std::size_t rank() const { return rank_; }
+        void rank(std::size_t r) { rank_ = r; }
+
+        /** @brief Returns the number of additional random samples */
+        std::size_t oversampling() const { return oversampling_; }
+        void oversampling(std::size_t p) { oversampling_ = p; }
+
+        /** @brief Returns the number of power iterations */
+        std::size_t power_iterations() const { return power_iterations_; }
+        void power_iterations(std::size_t q) { power_iterations_ = q; }
+
+        /** @brief Returns the seed of the random test matrix */
+        unsigned int seed() const { return seed_; }
+        void seed(unsigned int s) { seed_ = s; }
+
+      private:
+        std::size_t rank_;
+        std::size_t oversampling_;
+        std::size_t power_iterations_;
+        unsigned int seed_;
+    };
+
+
+    namespace detail
+    {
+      /** @brief Copies the buffer of a matrix to a matrix of identical dimensions and layout in another memory domain */
+      template <typename NumericT, typename F>
+      void rsvd_copy_buffer(viennacl::matrix<NumericT, F> const & src, viennacl::matrix<NumericT, F> & dst)
+      {
+        assert(src.internal_size() == dst.internal_size() && bool("Buffer sizes do not match"));
+        if (dst.memory_domain() == viennacl::MAIN_MEMORY)
+          viennacl::backend::memory_read(src.handle(), 0, sizeof(NumericT) * src.internal_size(), viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(dst));
+        else
+          viennacl::backend::memory_write(dst.handle(), 0, sizeof(NumericT) * src.internal_size(), viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(src));
+      }
+
+      /** @brief Replaces the columns of Y by an orthonormal basis of their span (thin Householder QR). Optionally returns the triangular factor R on the host.
+      *
+      * The tall and skinny factorization is carried out by the blocked host QR. For other memory domains, Y is transferred to the host and back.
+      */
+      template <typename NumericT>
+      void rsvd_orthonormalize(viennacl::matrix<NumericT, viennacl::column_major> & Y,
+                               viennacl::matrix<NumericT, viennacl::column_major> * R = NULL)
+      {
+        typedef viennacl::matrix<NumericT, viennacl::column_major>   MatrixType;
+
+        viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+        std::size_t m = Y.size1();
+        std::size_t l = Y.size2();
+
+        MatrixType Y_host(m, l, host_ctx);
+        rsvd_copy_buffer(Y, Y_host);
+
+        std::vector<NumericT> tau;
+        viennacl::linalg::host_based::detail::householder_qr(Y_host, tau);
+
+        if (R)
+        {
+          NumericT const * data_Y = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(Y_host);
+          NumericT       * data_R = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(*R);
+          std::size_t ldy = Y_host.internal_size1();
+          std::size_t ldr = R->internal_size1();
+          for (std::size_t j=0; j<l; ++j)
+            for (std::size_t i=0; i<l; ++i)
+              data_R[i + j * ldr] = (i <= j) ? data_Y[i + j * ldy] : NumericT(0);
+        }
+
+        MatrixType Q_host(m, l, host_ctx);
+        viennacl::linalg::host_based::detail::householder_form_q(viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(Y_host), Y_host.internal_size1(),
+                                                                 &(tau[0]), l, Q_host);
+        rsvd_copy_buffer(Q_host, Y);
+      }
+
+      /** @brief Computes the randomized SVD of A. At is an expression or matrix representing the transpose of A.
+      *
+      * With l = rank + oversampling random samples, the range of A is approximated by the orthonormal basis Q of (A * A^T)^q * A * Omega,
+      * where the basis is re-orthonormalized after each product. The small factorization A^T * Q = Z * R is then followed by the SVD R = U_R * Sigma * V_R^T
+      * on the host, so that A ~ (Q * V_R) * Sigma * (Z * U_R)^T. Besides the l x l matrices, only matrices with l columns are required.
+      */
+      template <typename MatrixT, typename MatrixTransT, typename NumericT, typename F>
+      void rsvd_impl(MatrixT const & A, MatrixTransT const & At,
+                     randomized_svd_tag const & tag,
+                     std::vector<NumericT> & singular_values,
+                     viennacl::matrix_base<NumericT, F> * U,
+                     viennacl::matrix_base<NumericT, F> * V)
+      {
+        typedef viennacl::matrix<NumericT, viennacl::column_major>   MatrixType;
+
+        std::size_t m = viennacl::traits::size1(A);
+        std::size_t n = viennacl::traits::size2(A);
+        std::size_t k = tag.rank();
+        std::size_t l = std::min(k + tag.oversampling(), std::min(m, n));
+
+        assert(k > 0 && k <= std::min(m, n) && bool("Rank for randomized SVD must be between 1 and min(size1(A), size2(A))"));
+        assert((!U || (viennacl::traits::size1(*U) == m && viennacl::traits::size2(*U) == k)) && bool("Size mismatch of U in randomized SVD"));
+        assert((!V || (viennacl::traits::size1(*V) == n && viennacl::traits::size2(*V) == k)) && bool("Size mismatch of V in randomized SVD"));
+
+        viennacl::context ctx = viennacl::traits::context(A);
+        viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+
+        // range finder:
+        MatrixType Omega(n, l, ctx);
+        viennacl::rand::generate(Omega, viennacl::rand::gaussian_tag(0, 1, tag.seed()));
+
+        MatrixType Y(m, l, ctx);
+        MatrixType Z(n, l, ctx);
+        Y = viennacl::linalg::prod(A, Omega);
+        rsvd_orthonormalize(Y);
+
+        for (std::size_t iter = 0; iter < tag.power_iterations(); ++iter)
+        {
+          Z = viennacl::linalg::prod(At, Y);
+          rsvd_orthonormalize(Z);
+          Y = viennacl::linalg::prod(A, Z);
+          rsvd_orthonormalize(Y);
+        }
+
+        // small problem: A^T Q = Z R, then R = U_R Sigma V_R^T:
+        MatrixType R(l, l, host_ctx);
+        Z = viennacl::linalg::prod(At, Y);
+        rsvd_orthonormalize(Z, &R);
+
+        singular_values.resize(k);
+        if (!U && !V)
+        {
+          std::vector<NumericT> sigma;
+          viennacl::linalg::host_based::svd(R, sigma);
+          std::copy(sigma.begin(), sigma.begin() + k, singular_values.begin());
+          return;
+        }
+
+        MatrixType U_R(l, l, host_ctx);
+        MatrixType V_R(l, l, host_ctx);
+        viennacl::linalg::host_based::svd(R, U_R, V_R);
+        for (std::size_t i=0; i<k; ++i)
+          singular_values[i] = R(i, i);
+
+        if (U)
+        {
+          MatrixType V_R_k(l, k, host_ctx);
+          V_R_k = viennacl::project(V_R, viennacl::range(0, l), viennacl::range(0, k));
+          MatrixType V_R_k_ctx(l, k, ctx);
+          rsvd_copy_buffer(V_R_k, V_R_k_ctx);
+          *U = viennacl::linalg::prod(Y, V_R_k_ctx);
+        }
+
+        if (V)
+        {
+          MatrixType U_R_k(l, k, host_ctx);
+          U_R_k = viennacl::project(U_R, viennacl::range(0, l), viennacl::range(0, k));
+          MatrixType U_R_k_ctx(l, k, ctx);
+          rsvd_copy_buffer(U_R_k, U_R_k_ctx);
+          *V = viennacl::linalg::prod(Z, U_R_k_ctx);
+        }
+      }
+    }
+
+
+    /** @brief Computes the leading singular triplets A ~ U * diag(sigma) * V^T of a dense matrix by the randomized range finder.
+    *
+    * @param A    The m x n matrix
+    * @param U    The m x rank matrix of left singular vectors (output)
+    * @param V    The n x rank matrix of right singular vectors (output)
+    * @param tag  Configuration of the randomized SVD
+    * @return     The leading singular values in descending order
+    */
+    template <typename NumericT, typename F1, typename F2>
+    std::vector<NumericT> svd(viennacl::matrix_base<NumericT, F1> const & A,
+                              viennacl::matrix_base<NumericT, F2> & U,
+                              viennacl::matrix_base<NumericT, F2> & V,
+                              randomized_svd_tag const & tag)
+    {
+      std::vector<NumericT> singular_values;
+      detail::rsvd_impl(A, viennacl::trans(A), tag, singular_values, &U, &V);
+      return singular_values;
+    }
+
+    /** @brief Computes the leading singular values of a dense matrix by the randomized range finder.
+    *
+    * @param A    The m x n matrix
+    * @param tag  Configuration of the randomized SVD
+    * @return     The leading singular values in descending order
+    */
+    template <typename NumericT, typename F>
+    std::vector<NumericT> svd(viennacl::matrix_base<NumericT, F> const & A,
+                              randomized_svd_tag const & tag)
+    {
+      std::vector<NumericT> singular_values;
+      detail::rsvd_impl(A, viennacl::trans(A), tag, singular_values, static_cast<viennacl::matrix_base<NumericT, F> *>(NULL), static_cast<viennacl::matrix_base<NumericT, F> *>(NULL));
+      return singular_values;
+    }
+
+    /** @brief Computes the leading singular triplets A ~ U * diag(sigma) * V^T of a sparse matrix by the randomized range finder.
+    *
+    * The transpose of A is set up once, so only sparse-times-dense products are required.
+    *
+    * @param A    The m x n sparse matrix
+    * @param U    The m x rank matrix of left singular vectors (output)
+    * @param V    The n x rank matrix of right singular vectors (output)
+    * @param tag  Configuration of the randomized SVD
+    * @return     The leading singular values in descending order
+    */
+    template <typename NumericT, unsigned int ALIGNMENT, typename F>
+    std::vector<NumericT> svd(viennacl::compressed_matrix<NumericT, ALIGNMENT> const & A,
+                              viennacl::matrix_base<NumericT, F> & U,
+                              viennacl::matrix_base<NumericT, F> & V,
+                              randomized_svd_tag const & tag)
+    {
+      viennacl::compressed_matrix<NumericT> At(A.size2(), A.size1(), viennacl::traits::context(A));
+      detail::sparse_transpose(A, At);
+
+      std::vector<NumericT> singular_values;
+      detail::rsvd_impl(A, At, tag, singular_values, &U, &V);
+      return singular_values;
+    }
+
+    /** @brief Computes the leading singular values of a sparse matrix by the randomized range finder.
+    *
+    * @param A    The m x n sparse matrix
+    * @param tag  Configuration of the randomized SVD
+    * @return     The leading singular values in descending order
+    */
+    template <typename NumericT, unsigned int ALIGNMENT>
+    std::vector<NumericT> svd(viennacl::compressed_matrix<NumericT, ALIGNMENT> const & A,
+                              randomized_svd_tag const & tag)
+    {
+      viennacl::compressed_matrix<NumericT> At(A.size2(), A.size1(), viennacl::traits::context(A));
+      detail::sparse_transpose(A, At);
+
+      std::vector<NumericT> singular_values;
+      detail::rsvd_impl(A, At, tag, singular_values, static_cast<viennacl::matrix_base<NumericT> *>(NULL), static_cast<viennacl::matrix_base<NumericT> *>(NULL));
+      return singular_values;
+    }
+
+  }
+}
+
+#endif
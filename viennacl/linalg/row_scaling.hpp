@@ -75,6 +75,12 @@ namespace viennacl
         enum { value = true };
       };
 
+      template <typename ScalarType>
+      struct row_scaling_for_viennacl< viennacl::symmetric_compressed_matrix<ScalarType> >
+      {
+        enum { value = true };
+      };
+
 
     }
 
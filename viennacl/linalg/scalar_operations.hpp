@@ -33,6 +33,10 @@
 #include "viennacl/traits/stride.hpp"
 #include "viennacl/linalg/host_based/scalar_operations.hpp"
 
+#ifdef VIENNACL_WITH_HOST_ASYNC
+  #include "viennacl/linalg/host_based/async_tasks.hpp"
+#endif
+
 #ifdef VIENNACL_WITH_OPENCL
   #include "viennacl/linalg/opencl/scalar_operations.hpp"
 #endif
@@ -236,6 +240,53 @@ namespace viennacl
     }
 
 
+    /** @brief Computes s1 = s2 / s3 on the device, where s1 is set to zero if s3 is zero
+    *
+    * Used by the iterative solvers for computing their coefficients without transferring scalars to the host.
+    * A zero denominator indicates a converged or broken down solver, which is then detected at the next convergence check.
+    *
+    * @param s1   The result scalar
+    * @param s2   The numerator
+    * @param s3   The denominator
+    */
+    template <typename S1, typename S2, typename S3>
+    typename viennacl::enable_if<    viennacl::is_scalar<S1>::value
+                                  && viennacl::is_scalar<S2>::value
+                                  && viennacl::is_scalar<S3>::value
+                                >::type
+    safe_div(S1 & s1, S2 const & s2, S3 const & s3)
+    {
+      switch (viennacl::traits::handle(s1).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          if (viennacl::backend::current_host_executor().enqueues())
+          {
+            typedef typename viennacl::result_of::cpu_value_type<S1>::type        value_type;
+            viennacl::backend::current_host_executor().enqueue(new viennacl::linalg::host_based::detail::safe_div_task<value_type>(&viennacl::linalg::host_based::safe_div<S1, S2, S3>, s1, s2, s3));
+            break;
+          }
+#endif
+          viennacl::linalg::host_based::safe_div(s1, s2, s3);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::safe_div(s1, s2, s3);
+          break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+          viennacl::linalg::cuda::safe_div(s1, s2, s3);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
   } //namespace linalg
 } //namespace viennacl
 
@@ -0,0 +1,232 @@
+#ifndef VIENNACL_LINALG_SPARSE_CHOLESKY_HPP_
+#define VIENNACL_LINALG_SPARSE_CHOLESKY_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/sparse_cholesky.hpp
+    @brief Supernodal sparse Cholesky factorization for the direct solution of symmetric positive definite systems in compressed_matrix format.
+
+    The factorization is computed on the host. The symbolic analysis (fill-reducing ordering, elimination tree, supernodes) depends on the sparsity pattern only
+    and is reused if a matrix with the same pattern but different values is refactorized.
+*/
+
+#include <vector>
+#include <cassert>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/linalg/detail/sparse_cholesky/nested_dissection.hpp"
+#include "viennacl/linalg/detail/sparse_cholesky/symbolic.hpp"
+#include "viennacl/linalg/host_based/sparse_cholesky_operations.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+
+    /** @brief Fill-reducing orderings for the sparse Cholesky factorization */
+    enum sparse_cholesky_ordering_type
+    {
+      SPARSE_CHOLESKY_NATURAL_ORDERING = 0,
+      SPARSE_CHOLESKY_NESTED_DISSECTION_ORDERING
+    };
+
+    /** @brief A tag for the supernodal sparse Cholesky factorization
+    */
+    class sparse_cholesky_tag
+    {
+      public:
+        /** @brief The constructor.
+        *
+        * @param ordering            The fill-reducing ordering applied to the rows and columns of the system matrix
+        * @param leaf_size           Subgraphs with at most this number of unknowns are not split further by nested dissection
+        * @param relaxed_supernodes  If true, small supernodes are merged at the expense of explicitly stored zeros in order to obtain larger dense blocks
+        */
+        sparse_cholesky_tag(sparse_cholesky_ordering_type ordering = SPARSE_CHOLESKY_NESTED_DISSECTION_ORDERING,
+                            std::size_t leaf_size = 64,
+                            bool relaxed_supernodes = true) : ordering_(ordering), leaf_size_(leaf_size), relaxed_supernodes_(relaxed_supernodes) {}
+
+        sparse_cholesky_ordering_type ordering() const { return ordering_; }
+        void ordering(sparse_cholesky_ordering_type new_ordering) { ordering_ = new_ordering; }
+
+        std::size_t leaf_size() const { return leaf_size_; }
+        void leaf_size(std::size_t new_size) { leaf_size_ = new_size; }
+
+        bool relaxed_supernodes() const { return relaxed_supernodes_; }
+        void relaxed_supernodes(bool b) { relaxed_supernodes_ = b; }
+
+      private:
+        sparse_cholesky_ordering_type ordering_;
+        std::size_t leaf_size_;
+        bool relaxed_supernodes_;
+    };
+
+
+    /** @brief Supernodal sparse Cholesky factorization A = P^T L L^T P of a symmetric positive definite matrix.
+    *
+    * The system matrix must hold the full (symmetric) sparsity pattern, not only a triangular part.
+    * Since apply() solves with the factorization in place, the class can also be supplied to the iterative solvers as a preconditioner.
+    */
+    template <typename NumericT>
+    class sparse_cholesky
+    {
+      public:
+        explicit sparse_cholesky(sparse_cholesky_tag const & tag = sparse_cholesky_tag()) : tag_(tag), factorized_(false) {}
+
+        /** @brief Analyzes and factorizes the supplied matrix. Check factorized() for whether the matrix was found to be positive definite. */
+        sparse_cholesky(viennacl::compressed_matrix<NumericT> const & A, sparse_cholesky_tag const & tag = sparse_cholesky_tag()) : tag_(tag), factorized_(false)
+        {
+          analyze(A);
+          factorize(A);
+        }
+
+        /** @brief Computes the fill-reducing ordering and the symbolic factorization. Depends on the sparsity pattern of A only. */
+        void analyze(viennacl::compressed_matrix<NumericT> const & A)
+        {
+          assert(A.size1() == A.size2() && bool("System matrix must be square for sparse Cholesky factorization"));
+
+          std::vector<unsigned int> row_jumper;
+          std::vector<unsigned int> col_indices;
+          read_pattern(A, row_jumper, col_indices);
+
+          std::vector<unsigned int> perm;
+          if (tag_.ordering() == SPARSE_CHOLESKY_NESTED_DISSECTION_ORDERING)
+          {
+            viennacl::linalg::detail::nested_dissection ordering(row_jumper, col_indices, tag_.leaf_size());
+            ordering.apply(perm);
+          }
+          else
+          {
+            perm.resize(A.size1());
+            for (std::size_t i=0; i<perm.size(); ++i)
+              perm[i] = static_cast<unsigned int>(i);
+          }
+
+          viennacl::linalg::detail::sparse_cholesky_analyze(row_jumper, col_indices, perm, tag_.relaxed_supernodes(), symbolic_);
+          factorized_ = false;
+        }
+
+        /** @brief Computes the numeric factorization for a matrix with the same sparsity pattern as the one supplied to analyze().
+        *
+        * @return false if the matrix is not positive definite
+        */
+        bool factorize(viennacl::compressed_matrix<NumericT> const & A)
+        {
+          assert(A.size1() == symbolic_.size && A.nnz() == symbolic_.nnz_A && bool("Sparsity pattern differs from the one supplied to analyze()"));
+
+          std::vector<NumericT> elements(A.nnz());
+          viennacl::backend::memory_read(A.handle(), 0, sizeof(NumericT) * A.nnz(), &(elements[0]));
+
+          factorized_ = viennacl::linalg::host_based::sparse_cholesky_factorize(symbolic_, &(elements[0]), L_);
+          return factorized_;
+        }
+
+        /** @brief Overwrites the supplied vector with the solution of A x = vec */
+        void apply(viennacl::vector<NumericT> & vec) const
+        {
+          assert(factorized_ && bool("Sparse Cholesky factorization not available"));
+          assert(vec.size() == symbolic_.size && bool("Size mismatch"));
+
+          std::size_t n = symbolic_.size;
+          std::vector<NumericT> b(n);
+          std::vector<NumericT> x(n);
+          viennacl::backend::memory_read(vec.handle(), 0, sizeof(NumericT) * n, &(b[0]));
+
+          for (std::size_t i=0; i<n; ++i)
+            x[i] = b[symbolic_.perm[i]];
+          viennacl::linalg::host_based::sparse_cholesky_solve(symbolic_, L_, x);
+          for (std::size_t i=0; i<n; ++i)
+            b[symbolic_.perm[i]] = x[i];
+
+          viennacl::backend::memory_write(vec.handle(), 0, sizeof(NumericT) * n, &(b[0]));
+        }
+
+        /** @brief Returns true if the last call to factorize() succeeded */
+        bool factorized() const { return factorized_; }
+
+        /** @brief Returns the number of rows of the system matrix */
+        std::size_t size() const { return symbolic_.size; }
+
+        /** @brief Returns the number of supernodes of the factor */
+        std::size_t num_supernodes() const { return symbolic_.num_supernodes(); }
+
+        /** @brief Returns the number of entries in the lower triangle of the factor, including zeros stored explicitly in relaxed supernodes */
+        std::size_t nnz() const
+        {
+          std::size_t entries = 0;
+          for (std::size_t s=0; s<symbolic_.num_supernodes(); ++s)
+          {
+            std::size_t width = symbolic_.super_begin[s+1] - symbolic_.super_begin[s];
+            std::size_t rows  = symbolic_.row_offsets[s+1] - symbolic_.row_offsets[s];
+            entries += width * rows - width * (width - 1) / 2;
+          }
+          return entries;
+        }
+
+        sparse_cholesky_tag const & tag() const { return tag_; }
+
+      private:
+        static void read_pattern(viennacl::compressed_matrix<NumericT> const & A,
+                                 std::vector<unsigned int> & row_jumper,
+                                 std::vector<unsigned int> & col_indices)
+        {
+          viennacl::backend::typesafe_host_array<unsigned int> row_buffer(A.handle1(), A.size1() + 1);
+          viennacl::backend::typesafe_host_array<unsigned int> col_buffer(A.handle2(), A.nnz());
+          viennacl::backend::memory_read(A.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+          viennacl::backend::memory_read(A.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+
+          row_jumper.resize(A.size1() + 1);
+          for (std::size_t i=0; i<row_jumper.size(); ++i)
+            row_jumper[i] = static_cast<unsigned int>(row_buffer[i]);
+          col_indices.resize(A.nnz());
+          for (std::size_t i=0; i<col_indices.size(); ++i)
+            col_indices[i] = static_cast<unsigned int>(col_buffer[i]);
+        }
+
+        sparse_cholesky_tag tag_;
+        viennacl::linalg::detail::sparse_cholesky_symbolic symbolic_;
+        std::vector<NumericT> L_;
+        bool factorized_;
+    };
+
+
+    /** @brief Solves the symmetric positive definite system A x = rhs by a sparse Cholesky factorization.
+    *
+    * For repeated solves or refactorizations with the same sparsity pattern, use the class sparse_cholesky directly.
+    * Throws viennacl::numerical_exception if the system matrix is not positive definite.
+    */
+    template <typename NumericT>
+    viennacl::vector<NumericT> solve(viennacl::compressed_matrix<NumericT> const & A,
+                                     viennacl::vector<NumericT> const & rhs,
+                                     sparse_cholesky_tag const & tag)
+    {
+      sparse_cholesky<NumericT> chol(A, tag);
+      if (!chol.factorized())
+        throw viennacl::numerical_exception("Sparse Cholesky: system matrix is not positive definite");
+
+      viennacl::vector<NumericT> result(rhs);
+      chol.apply(result);
+      return result;
+    }
+
+  }
+}
+
+#endif
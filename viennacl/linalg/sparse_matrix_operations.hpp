@@ -27,8 +27,13 @@
 #include "viennacl/vector.hpp"
 #include "viennacl/matrix.hpp"
 #include "viennacl/tools/tools.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
 
+#ifdef VIENNACL_WITH_HOST_ASYNC
+  #include "viennacl/linalg/host_based/async_tasks.hpp"
+#endif
+
 #ifdef VIENNACL_WITH_OPENCL
   #include "viennacl/linalg/opencl/sparse_matrix_operations.hpp"
 #endif
@@ -45,12 +50,24 @@ namespace viennacl
     namespace detail
     {
 
+#ifdef VIENNACL_WITH_PROFILING
+      /** @brief Number of stored entries of a sparse matrix, used for the operation counts recorded by the profiler */
+      template <typename SparseMatrixType>
+      std::size_t profiler_nnz(SparseMatrixType const & mat) { return mat.nnz(); }
+
+      template <typename ScalarType, unsigned int ALIGNMENT>
+      std::size_t profiler_nnz(viennacl::hyb_matrix<ScalarType, ALIGNMENT> const & mat) { return mat.size1() * mat.ell_nnz() + mat.csr_nnz(); }
+#endif
+
       template<typename SparseMatrixType, typename SCALARTYPE, unsigned int VEC_ALIGNMENT>
       typename viennacl::enable_if< viennacl::is_any_sparse_matrix<SparseMatrixType>::value >::type
       row_info(SparseMatrixType const & mat,
                vector<SCALARTYPE, VEC_ALIGNMENT> & vec,
                row_info_types info_selector)
       {
+        VIENNACL_PROFILE_OPERATION("row_info", viennacl::traits::handle(mat), mat.size1(), mat.size2(),
+                                   profiler_nnz(mat) * (sizeof(SCALARTYPE) + sizeof(unsigned int)) + mat.size1() * sizeof(SCALARTYPE), 0);
+
         switch (viennacl::traits::handle(mat).get_active_handle_id())
         {
           case viennacl::MAIN_MEMORY:
@@ -96,9 +113,17 @@ namespace viennacl
       assert( (mat.size1() == result.size()) && bool("Size check failed for compressed matrix-vector product: size1(mat) != size(result)"));
       assert( (mat.size2() == vec.size())    && bool("Size check failed for compressed matrix-vector product: size2(mat) != size(x)"));
 
+      VIENNACL_PROFILE_OPERATION("spmv", viennacl::traits::handle(mat), mat.size1(), mat.size2(),
+                                 detail::profiler_nnz(mat) * (sizeof(ScalarType) + sizeof(unsigned int)) + (mat.size1() + mat.size2()) * sizeof(ScalarType), 2 * detail::profiler_nnz(mat));
+
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          if (   viennacl::backend::current_host_executor().enqueues()
+              && viennacl::linalg::host_based::detail::enqueue_prod<SparseMatrixType, ScalarType>(&viennacl::linalg::host_based::prod_impl, mat, vec, result))
+            break;
+#endif
           viennacl::linalg::host_based::prod_impl(mat, vec, result);
           break;
 #ifdef VIENNACL_WITH_OPENCL
@@ -137,6 +162,9 @@ namespace viennacl
       assert( (sp_mat.size1() == result.size1()) && bool("Size check failed for compressed matrix - dense matrix product: size1(sp_mat) != size1(result)"));
       assert( (sp_mat.size2() == d_mat.size1()) && bool("Size check failed for compressed matrix - dense matrix product: size2(sp_mat) != size1(d_mat)"));
 
+      VIENNACL_PROFILE_OPERATION("spmm", viennacl::traits::handle(sp_mat), sp_mat.size1(), sp_mat.size2(),
+                                 detail::profiler_nnz(sp_mat) * (sizeof(ScalarType) + sizeof(unsigned int)) + (sp_mat.size2() + result.size1()) * result.size2() * sizeof(ScalarType), 2 * detail::profiler_nnz(sp_mat) * result.size2());
+
       switch (viennacl::traits::handle(sp_mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -179,6 +207,9 @@ namespace viennacl
       assert( (sp_mat.size1() == result.size1()) && bool("Size check failed for compressed matrix - dense matrix product: size1(sp_mat) != size1(result)"));
       assert( (sp_mat.size2() == d_mat.size1()) && bool("Size check failed for compressed matrix - dense matrix product: size2(sp_mat) != size1(d_mat)"));
 
+      VIENNACL_PROFILE_OPERATION("spmm_nt", viennacl::traits::handle(sp_mat), sp_mat.size1(), sp_mat.size2(),
+                                 detail::profiler_nnz(sp_mat) * (sizeof(ScalarType) + sizeof(unsigned int)) + (sp_mat.size2() + result.size1()) * result.size2() * sizeof(ScalarType), 2 * detail::profiler_nnz(sp_mat) * result.size2());
+
       switch (viennacl::traits::handle(sp_mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -216,6 +247,9 @@ namespace viennacl
       assert( (mat.size1() == mat.size2()) && bool("Size check failed for triangular solve on compressed matrix: size1(mat) != size2(mat)"));
       assert( (mat.size2() == vec.size())    && bool("Size check failed for compressed matrix-vector product: size2(mat) != size(x)"));
 
+      VIENNACL_PROFILE_OPERATION("sparse_trsv", viennacl::traits::handle(mat), mat.size1(), mat.size2(),
+                                 detail::profiler_nnz(mat) * (sizeof(ScalarType) + sizeof(unsigned int)) + 2 * mat.size1() * sizeof(ScalarType), 2 * detail::profiler_nnz(mat));
+
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -254,6 +288,9 @@ namespace viennacl
       assert( (mat.size1() == mat.size2()) && bool("Size check failed for triangular solve on transposed compressed matrix: size1(mat) != size2(mat)"));
       assert( (mat.size1() == vec.size())    && bool("Size check failed for transposed compressed matrix triangular solve: size1(mat) != size(x)"));
 
+      VIENNACL_PROFILE_OPERATION("sparse_trsv_trans", viennacl::traits::handle(mat.lhs()), mat.lhs().size1(), mat.lhs().size2(),
+                                 detail::profiler_nnz(mat.lhs()) * (sizeof(ScalarType) + sizeof(unsigned int)) + 2 * mat.size1() * sizeof(ScalarType), 2 * detail::profiler_nnz(mat.lhs()));
+
       switch (viennacl::traits::handle(mat.lhs()).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -292,6 +329,9 @@ namespace viennacl
         assert( (mat.size1() == mat.size2()) && bool("Size check failed for triangular solve on transposed compressed matrix: size1(mat) != size2(mat)"));
         assert( (mat.size1() == vec.size())  && bool("Size check failed for transposed compressed matrix triangular solve: size1(mat) != size(x)"));
 
+        VIENNACL_PROFILE_OPERATION("sparse_block_trsv", viennacl::traits::handle(mat.lhs()), mat.lhs().size1(), mat.lhs().size2(),
+                                   profiler_nnz(mat.lhs()) * (sizeof(ScalarType) + sizeof(unsigned int)) + 3 * mat.size1() * sizeof(ScalarType), 2 * profiler_nnz(mat.lhs()));
+
         switch (viennacl::traits::handle(mat.lhs()).get_active_handle_id())
         {
           case viennacl::MAIN_MEMORY:
@@ -24,17 +24,22 @@
     Contributed by Volodymyr Kysenko.
 */
 
-
-// Note: Boost.uBLAS is required at the moment
-#include <boost/numeric/ublas/vector.hpp>
-#include <boost/numeric/ublas/matrix.hpp>
-
-
 #include <cmath>
+#include <vector>
+#include <algorithm>
+#include <functional>
 
 #include "viennacl/matrix.hpp"
-#include "viennacl/linalg/opencl/kernels/svd.hpp"
 #include "viennacl/linalg/qr-method-common.hpp"
+#include "viennacl/linalg/host_based/svd_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  // Note: Boost.uBLAS is required by the OpenCL implementation at the moment
+  #include <boost/numeric/ublas/vector.hpp>
+  #include <boost/numeric/ublas/matrix.hpp>
+
+  #include "viennacl/linalg/opencl/kernels/svd.hpp"
+#endif
 
 namespace viennacl
 {
@@ -43,6 +48,7 @@ namespace viennacl
 
     namespace detail
     {
+#ifdef VIENNACL_WITH_OPENCL
 
       template<typename MatrixType, typename VectorType>
       void givens_prev(MatrixType & matrix,
@@ -477,6 +483,48 @@ namespace viennacl
         }
       }
 
+
+      template <typename SCALARTYPE, unsigned int ALIGNMENT>
+      void svd_opencl(viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & A,
+                      viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & QL,
+                      viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & QR)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
+        viennacl::linalg::opencl::kernels::svd<SCALARTYPE>::init(ctx);
+
+        std::size_t row_num = A.size1();
+        std::size_t col_num = A.size2();
+
+        std::size_t to = std::min(row_num, col_num);
+
+
+        //viennacl::vector<SCALARTYPE, ALIGNMENT> d(to);
+        //viennacl::vector<SCALARTYPE, ALIGNMENT> s(to + 1);
+
+        // first stage
+        detail::bidiag(A, QL, QR);
+
+        // second stage
+        //std::vector<SCALARTYPE> dh(to, 0);
+        //std::vector<SCALARTYPE> sh(to + 1, 0);
+        boost::numeric::ublas::vector<SCALARTYPE> dh(to, 0);
+        boost::numeric::ublas::vector<SCALARTYPE> sh(to + 1, 0);
+
+        detail::bidiag_pack(A, dh, sh);
+
+        detail::svd_qr_shift( QL, QR, dh, sh);
+
+        // Write resulting diagonal matrix with singular values to A:
+        boost::numeric::ublas::matrix<SCALARTYPE> h_Sigma(row_num, col_num);
+        h_Sigma.clear();
+
+        for (std::size_t i = 0; i < to; i++)
+          h_Sigma(i, i) = dh[i];
+
+        copy(h_Sigma, A);
+      }
+#endif
+
     } // namespace detail
 
 
@@ -491,39 +539,61 @@ namespace viennacl
               viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & QL,
               viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & QR)
     {
-      viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
-      viennacl::linalg::opencl::kernels::svd<SCALARTYPE>::init(ctx);
-
-      std::size_t row_num = A.size1();
-      std::size_t col_num = A.size2();
-
-      std::size_t to = std::min(row_num, col_num);
-
-
-      //viennacl::vector<SCALARTYPE, ALIGNMENT> d(to);
-      //viennacl::vector<SCALARTYPE, ALIGNMENT> s(to + 1);
-
-      // first stage
-      detail::bidiag(A, QL, QR);
-
-      // second stage
-      //std::vector<SCALARTYPE> dh(to, 0);
-      //std::vector<SCALARTYPE> sh(to + 1, 0);
-      boost::numeric::ublas::vector<SCALARTYPE> dh(to, 0);
-      boost::numeric::ublas::vector<SCALARTYPE> sh(to + 1, 0);
-
-      detail::bidiag_pack(A, dh, sh);
-
-      detail::svd_qr_shift( QL, QR, dh, sh);
-
-      // Write resulting diagonal matrix with singular values to A:
-      boost::numeric::ublas::matrix<SCALARTYPE> h_Sigma(row_num, col_num);
-      h_Sigma.clear();
-
-      for (std::size_t i = 0; i < to; i++)
-        h_Sigma(i, i) = dh[i];
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::svd(A, QL, QR);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          detail::svd_opencl(A, QL, QR);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
 
-      copy(h_Sigma, A);
+    /** @brief Computes the singular values of a matrix A in descending order without computing the singular vectors.
+     *
+     * @param A                 The input matrix
+     * @param singular_values   The singular values (output)
+     */
+    template <typename SCALARTYPE, unsigned int ALIGNMENT>
+    void svd(viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> const & A,
+             std::vector<SCALARTYPE> & singular_values)
+    {
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::svd(A, singular_values);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+        {
+          // the OpenCL implementation always computes the singular vectors
+          viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> Sigma(A);
+          viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> QL(A.size1(), A.size1(), viennacl::traits::context(A));
+          viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> QR(A.size2(), A.size2(), viennacl::traits::context(A));
+          detail::svd_opencl(Sigma, QL, QR);
+
+          std::vector<SCALARTYPE> temp(Sigma.internal_size());
+          viennacl::fast_copy(Sigma, &(temp[0]));
+
+          singular_values.resize(std::min(A.size1(), A.size2()));
+          for (std::size_t i = 0; i < singular_values.size(); ++i)
+            singular_values[i] = temp[i * Sigma.internal_size2() + i];
+          std::sort(singular_values.begin(), singular_values.end(), std::greater<SCALARTYPE>());
+          break;
+        }
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
     }
   }
 }
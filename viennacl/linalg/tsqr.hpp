@@ -0,0 +1,244 @@
+#ifndef VIENNACL_LINALG_TSQR_HPP
+#define VIENNACL_LINALG_TSQR_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/tsqr.hpp
+    @brief Provides the communication-avoiding QR factorization for tall-skinny matrices (TSQR) and a least-squares solver based on it.
+
+    The orthogonal factor Q is kept in implicit form in main memory. Matrices located in other memory domains are transferred to the host.
+*/
+
+#include <vector>
+#include <cassert>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/backend/memory.hpp"
+
+#include "viennacl/linalg/host_based/tsqr_operations.hpp"
+#include "viennacl/linalg/host_based/direct_solve.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace detail
+    {
+      /** @brief Copies a dense matrix from any memory domain to a matrix of the same size in main memory. */
+      template<typename T, typename F>
+      void tsqr_copy_to_host(matrix<T, F> const & A, matrix<T, F> & A_host)
+      {
+        assert(A_host.internal_size() == A.internal_size() && bool("Buffer sizes do not match"));
+        if (A.internal_size() > 0)
+          viennacl::backend::memory_read(A.handle(), 0, sizeof(T) * A.internal_size(), viennacl::linalg::host_based::detail::extract_raw_pointer<T>(A_host));
+      }
+
+      /** @brief Copies a dense matrix in main memory to a matrix of the same size in any memory domain. */
+      template<typename T, typename F>
+      void tsqr_copy_from_host(matrix<T, F> const & A_host, matrix<T, F> & A)
+      {
+        assert(A_host.internal_size() == A.internal_size() && bool("Buffer sizes do not match"));
+        if (A.internal_size() > 0)
+          viennacl::backend::memory_write(A.handle(), 0, sizeof(T) * A.internal_size(), viennacl::linalg::host_based::detail::extract_raw_pointer<T>(A_host));
+      }
+
+      /** @brief Computes the TSQR factorization of a matrix located in a memory domain other than main memory by transferring it to the host. */
+      template<typename T, typename F>
+      void tsqr_on_host(matrix<T, F> const & A, matrix<T, F> & R, viennacl::linalg::host_based::tsqr_factors<T> & Q, std::size_t num_blocks)
+      {
+        viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+        matrix<T, F> A_host(A.size1(), A.size2(), host_ctx);
+        matrix<T, F> R_host(R.size1(), R.size2(), host_ctx);
+
+        tsqr_copy_to_host(A, A_host);
+        viennacl::linalg::host_based::tsqr_factorize(A_host, R_host, Q, num_blocks);
+        tsqr_copy_from_host(R_host, R);
+      }
+    }
+
+    /** @brief Computes the TSQR factorization A = Q * R of a tall-skinny matrix, where Q is kept in implicit form.
+    *
+    * The rows of A are split into blocks, which are factored in parallel. The triangular factors of the blocks are then combined in a binary reduction tree.
+    *
+    * @param A           The m x n matrix to be factored, where m >= n. A is not modified.
+    * @param R           The n x n upper triangular factor (output)
+    * @param Q           The implicit representation of the m x n orthogonal factor (output), see tsqr_apply_trans_Q() and tsqr_apply_Q()
+    * @param num_blocks  Number of row blocks. If zero, the number of OpenMP threads is used.
+    */
+    template<typename T, typename F>
+    void tsqr(matrix<T, F> const & A, matrix<T, F> & R, viennacl::linalg::host_based::tsqr_factors<T> & Q, std::size_t num_blocks = 0)
+    {
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::tsqr_factorize(A, R, Q, num_blocks);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          detail::tsqr_on_host(A, R, Q, num_blocks);
+          break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+          detail::tsqr_on_host(A, R, Q, num_blocks);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Computes the upper triangular factor R of the TSQR factorization A = Q * R of a tall-skinny matrix. Q is discarded.
+    *
+    * @param A           The m x n matrix to be factored, where m >= n. A is not modified.
+    * @param R           The n x n upper triangular factor (output)
+    * @param num_blocks  Number of row blocks. If zero, the number of OpenMP threads is used.
+    */
+    template<typename T, typename F>
+    void tsqr(matrix<T, F> const & A, matrix<T, F> & R, std::size_t num_blocks = 0)
+    {
+      viennacl::linalg::host_based::tsqr_factors<T> Q;
+      tsqr(A, R, Q, num_blocks);
+    }
+
+    /** @brief Computes C <- Q * C for the orthogonal factor Q of a TSQR factorization.
+    *
+    * @param Q   The implicit representation of Q as obtained from tsqr()
+    * @param C   The matrix to be updated, which must have as many rows as the factored matrix
+    */
+    template<typename T, typename F>
+    void tsqr_apply_Q(viennacl::linalg::host_based::tsqr_factors<T> const & Q, matrix<T, F> & C)
+    {
+      if (viennacl::traits::handle(C).get_active_handle_id() == viennacl::MAIN_MEMORY)
+        viennacl::linalg::host_based::tsqr_apply_q(Q, C, false);
+      else
+      {
+        matrix<T, F> C_host(C.size1(), C.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+        detail::tsqr_copy_to_host(C, C_host);
+        viennacl::linalg::host_based::tsqr_apply_q(Q, C_host, false);
+        detail::tsqr_copy_from_host(C_host, C);
+      }
+    }
+
+    /** @brief Computes C <- Q^T * C for the orthogonal factor Q of a TSQR factorization.
+    *
+    * @param Q   The implicit representation of Q as obtained from tsqr()
+    * @param C   The matrix to be updated, which must have as many rows as the factored matrix
+    */
+    template<typename T, typename F>
+    void tsqr_apply_trans_Q(viennacl::linalg::host_based::tsqr_factors<T> const & Q, matrix<T, F> & C)
+    {
+      if (viennacl::traits::handle(C).get_active_handle_id() == viennacl::MAIN_MEMORY)
+        viennacl::linalg::host_based::tsqr_apply_q(Q, C, true);
+      else
+      {
+        matrix<T, F> C_host(C.size1(), C.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+        detail::tsqr_copy_to_host(C, C_host);
+        viennacl::linalg::host_based::tsqr_apply_q(Q, C_host, true);
+        detail::tsqr_copy_from_host(C_host, C);
+      }
+    }
+
+    /** @brief Computes b <- Q^T * b for the orthogonal factor Q of a TSQR factorization.
+    *
+    * @param Q   The implicit representation of Q as obtained from tsqr()
+    * @param b   The vector to be updated, which must have as many entries as the factored matrix has rows
+    */
+    template<typename T>
+    void tsqr_apply_trans_Q(viennacl::linalg::host_based::tsqr_factors<T> const & Q, vector_base<T> & b)
+    {
+      assert(b.size() == Q.size1 && bool("Size of b does not match"));
+
+      matrix<T, column_major> b_host(b.size(), 1, viennacl::context(viennacl::MAIN_MEMORY));
+      T * data_b = viennacl::linalg::host_based::detail::extract_raw_pointer<T>(b_host);
+
+      viennacl::copy(b.begin(), b.end(), data_b);
+      viennacl::linalg::host_based::tsqr_apply_q(Q, b_host, true);
+      viennacl::copy(data_b, data_b + b.size(), b.begin());
+    }
+
+    /** @brief Computes the TSQR factorization A = Q * R of a tall-skinny matrix with explicitly formed Q.
+    *
+    * @param A           The m x n matrix to be factored, where m >= n. A is not modified.
+    * @param Q           The m x n matrix with orthonormal columns (output)
+    * @param R           The n x n upper triangular factor (output)
+    * @param num_blocks  Number of row blocks. If zero, the number of OpenMP threads is used.
+    */
+    template<typename T, typename F>
+    void tsqr(matrix<T, F> const & A, matrix<T, F> & Q, matrix<T, F> & R, std::size_t num_blocks = 0)
+    {
+      assert(Q.size1() == A.size1() && Q.size2() == A.size2() && bool("Size of Q does not match"));
+
+      viennacl::linalg::host_based::tsqr_factors<T> Q_implicit;
+      tsqr(A, R, Q_implicit, num_blocks);
+
+      matrix<T, F> Q_host(Q.size1(), Q.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+      T * data_Q = viennacl::linalg::host_based::detail::extract_raw_pointer<T>(Q_host);
+      for (std::size_t i=0; i<Q.size2(); ++i)
+        data_Q[F::mem_index(i, i, Q_host.internal_size1(), Q_host.internal_size2())] = T(1);
+
+      viennacl::linalg::host_based::tsqr_apply_q(Q_implicit, Q_host, false);
+      detail::tsqr_copy_from_host(Q_host, Q);
+    }
+
+    /** @brief Solves the least-squares problem min ||A x - b|| for a tall-skinny matrix A with full column rank using TSQR.
+    *
+    * @param A           The m x n system matrix, where m >= n
+    * @param b           The right hand side vector with m entries
+    * @param num_blocks  Number of row blocks. If zero, the number of OpenMP threads is used.
+    * @return The least-squares solution x with n entries, located in the same memory domain as b
+    */
+    template<typename T, typename F>
+    vector<T> tsqr_least_squares(matrix<T, F> const & A, vector_base<T> const & b, std::size_t num_blocks = 0)
+    {
+      assert(b.size() == A.size1() && bool("Size of b does not match"));
+
+      std::size_t n = A.size2();
+      viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+
+      matrix<T, F> R(n, n, viennacl::traits::context(A));
+      viennacl::linalg::host_based::tsqr_factors<T> Q;
+      tsqr(A, R, Q, num_blocks);
+
+      matrix<T, F> R_host(n, n, host_ctx);
+      detail::tsqr_copy_to_host(R, R_host);
+
+      // c = Q^T b:
+      matrix<T, column_major> c(b.size(), 1, host_ctx);
+      T * data_c = viennacl::linalg::host_based::detail::extract_raw_pointer<T>(c);
+      viennacl::copy(b.begin(), b.end(), data_c);
+      viennacl::linalg::host_based::tsqr_apply_q(Q, c, true);
+
+      // R x = c(0:n):
+      vector<T> x_host(n, host_ctx);
+      T * data_x = viennacl::linalg::host_based::detail::extract_raw_pointer<T>(x_host);
+      std::copy(data_c, data_c + n, data_x);
+      viennacl::linalg::host_based::inplace_solve(R_host, x_host, viennacl::linalg::upper_tag());
+
+      vector<T> x(n, viennacl::traits::context(b));
+      viennacl::backend::memory_write(x.handle(), 0, sizeof(T) * n, data_x);
+      return x;
+    }
+
+  }
+}
+
+#endif
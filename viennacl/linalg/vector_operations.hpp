@@ -25,6 +25,7 @@
 #include "viennacl/forwards.h"
 #include "viennacl/scalar.hpp"
 #include "viennacl/tools/tools.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/meta/predicate.hpp"
 #include "viennacl/meta/enable_if.hpp"
 #include "viennacl/traits/size.hpp"
@@ -33,6 +34,10 @@
 #include "viennacl/traits/stride.hpp"
 #include "viennacl/linalg/host_based/vector_operations.hpp"
 
+#ifdef VIENNACL_WITH_HOST_ASYNC
+  #include "viennacl/linalg/host_based/async_tasks.hpp"
+#endif
+
 #ifdef VIENNACL_WITH_OPENCL
   #include "viennacl/linalg/opencl/vector_operations.hpp"
 #endif
@@ -51,9 +56,19 @@ namespace viennacl
     {
       assert(viennacl::traits::size(vec1) == viennacl::traits::size(vec2) && bool("Incompatible vector sizes in v1 = v2 @ alpha: size(v1) != size(v2)"));
 
+      VIENNACL_PROFILE_OPERATION("av", viennacl::traits::handle(vec1), viennacl::traits::size(vec1), 1, 2 * viennacl::traits::size(vec1) * sizeof(T), viennacl::traits::size(vec1));
+
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          if (viennacl::backend::current_host_executor().enqueues())
+          {
+            viennacl::backend::current_host_executor().enqueue(new viennacl::linalg::host_based::detail::av_task<T, ScalarType1>(&viennacl::linalg::host_based::av,
+                                                                                                                                  vec1, vec2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha));
+            break;
+          }
+#endif
           viennacl::linalg::host_based::av(vec1, vec2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha);
           break;
 #ifdef VIENNACL_WITH_OPENCL
@@ -82,9 +97,20 @@ namespace viennacl
       assert(viennacl::traits::size(vec1) == viennacl::traits::size(vec2) && bool("Incompatible vector sizes in v1 = v2 @ alpha + v3 @ beta: size(v1) != size(v2)"));
       assert(viennacl::traits::size(vec2) == viennacl::traits::size(vec3) && bool("Incompatible vector sizes in v1 = v2 @ alpha + v3 @ beta: size(v2) != size(v3)"));
 
+      VIENNACL_PROFILE_OPERATION("avbv", viennacl::traits::handle(vec1), viennacl::traits::size(vec1), 1, 3 * viennacl::traits::size(vec1) * sizeof(T), 3 * viennacl::traits::size(vec1));
+
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          if (viennacl::backend::current_host_executor().enqueues())
+          {
+            viennacl::backend::current_host_executor().enqueue(new viennacl::linalg::host_based::detail::avbv_task<T, ScalarType1, ScalarType2>(&viennacl::linalg::host_based::avbv, vec1,
+                                                                                                                                                  vec2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha,
+                                                                                                                                                  vec3,  beta, len_beta,  reciprocal_beta,  flip_sign_beta));
+            break;
+          }
+#endif
           viennacl::linalg::host_based::avbv(vec1,
                                                   vec2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha,
                                                   vec3,  beta, len_beta,  reciprocal_beta,  flip_sign_beta);
@@ -119,9 +145,20 @@ namespace viennacl
       assert(viennacl::traits::size(vec1) == viennacl::traits::size(vec2) && bool("Incompatible vector sizes in v1 += v2 @ alpha + v3 @ beta: size(v1) != size(v2)"));
       assert(viennacl::traits::size(vec2) == viennacl::traits::size(vec3) && bool("Incompatible vector sizes in v1 += v2 @ alpha + v3 @ beta: size(v2) != size(v3)"));
 
+      VIENNACL_PROFILE_OPERATION("avbv_v", viennacl::traits::handle(vec1), viennacl::traits::size(vec1), 1, 4 * viennacl::traits::size(vec1) * sizeof(T), 4 * viennacl::traits::size(vec1));
+
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          if (viennacl::backend::current_host_executor().enqueues())
+          {
+            viennacl::backend::current_host_executor().enqueue(new viennacl::linalg::host_based::detail::avbv_task<T, ScalarType1, ScalarType2>(&viennacl::linalg::host_based::avbv_v, vec1,
+                                                                                                                                                  vec2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha,
+                                                                                                                                                  vec3,  beta, len_beta,  reciprocal_beta,  flip_sign_beta));
+            break;
+          }
+#endif
           viennacl::linalg::host_based::avbv_v(vec1,
                                                     vec2, alpha, len_alpha, reciprocal_alpha, flip_sign_alpha,
                                                     vec3,  beta, len_beta,  reciprocal_beta,  flip_sign_beta);
@@ -157,6 +194,8 @@ namespace viennacl
     template <typename T>
     void vector_assign(vector_base<T> & vec1, const T & alpha, bool up_to_internal_size = false)
     {
+      VIENNACL_PROFILE_OPERATION("vector_assign", viennacl::traits::handle(vec1), viennacl::traits::size(vec1), 1, viennacl::traits::size(vec1) * sizeof(T), 0);
+
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -190,6 +229,8 @@ namespace viennacl
     {
       assert(viennacl::traits::size(vec1) == viennacl::traits::size(vec2) && bool("Incompatible vector sizes in vector_swap()"));
 
+      VIENNACL_PROFILE_OPERATION("vector_swap", viennacl::traits::handle(vec1), viennacl::traits::size(vec1), 1, 4 * viennacl::traits::size(vec1) * sizeof(T), 0);
+
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -228,6 +269,8 @@ namespace viennacl
     {
       assert(viennacl::traits::size(vec1) == viennacl::traits::size(proxy) && bool("Incompatible vector sizes in element_op()"));
 
+      VIENNACL_PROFILE_OPERATION("element_op", viennacl::traits::handle(vec1), viennacl::traits::size(vec1), 1, 3 * viennacl::traits::size(vec1) * sizeof(T), viennacl::traits::size(vec1));
+
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -351,9 +394,18 @@ namespace viennacl
     {
       assert( vec1.size() == vec2.size() && bool("Size mismatch") );
 
+      VIENNACL_PROFILE_OPERATION("inner_prod", viennacl::traits::handle(vec1), viennacl::traits::size(vec1), 1, 2 * viennacl::traits::size(vec1) * sizeof(T), 2 * viennacl::traits::size(vec1));
+
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          if (viennacl::backend::current_host_executor().enqueues())
+          {
+            viennacl::backend::current_host_executor().enqueue(new viennacl::linalg::host_based::detail::inner_prod_task<T>(&viennacl::linalg::host_based::inner_prod_impl, vec1, vec2, result));
+            break;
+          }
+#endif
           viennacl::linalg::host_based::inner_prod_impl(vec1, vec2, result);
           break;
 #ifdef VIENNACL_WITH_OPENCL
@@ -423,6 +475,8 @@ namespace viennacl
     {
       assert( vec1.size() == vec2.size() && bool("Size mismatch") );
 
+      VIENNACL_PROFILE_OPERATION("inner_prod_cpu", viennacl::traits::handle(vec1), viennacl::traits::size(vec1), 1, 2 * viennacl::traits::size(vec1) * sizeof(T), 2 * viennacl::traits::size(vec1));
+
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -495,6 +549,8 @@ namespace viennacl
       assert( x.size() == y_tuple.const_at(0).size() && bool("Size mismatch") );
       assert( result.size() == y_tuple.const_size() && bool("Number of elements does not match result size") );
 
+      VIENNACL_PROFILE_OPERATION("inner_prod_multiple", viennacl::traits::handle(x), viennacl::traits::size(x), y_tuple.const_size(), (1 + y_tuple.const_size()) * viennacl::traits::size(x) * sizeof(T), 2 * y_tuple.const_size() * viennacl::traits::size(x));
+
       switch (viennacl::traits::handle(x).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -527,9 +583,18 @@ namespace viennacl
     void norm_1_impl(vector_base<T> const & vec,
                      scalar<T> & result)
     {
+      VIENNACL_PROFILE_OPERATION("norm_1", viennacl::traits::handle(vec), viennacl::traits::size(vec), 1, viennacl::traits::size(vec) * sizeof(T), 2 * viennacl::traits::size(vec));
+
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          if (viennacl::backend::current_host_executor().enqueues())
+          {
+            viennacl::backend::current_host_executor().enqueue(new viennacl::linalg::host_based::detail::norm_task<T>(&viennacl::linalg::host_based::norm_1_impl, vec, result));
+            break;
+          }
+#endif
           viennacl::linalg::host_based::norm_1_impl(vec, result);
           break;
 #ifdef VIENNACL_WITH_OPENCL
@@ -574,6 +639,8 @@ namespace viennacl
     void norm_1_cpu(vector_base<T> const & vec,
                     T & result)
     {
+      VIENNACL_PROFILE_OPERATION("norm_1_cpu", viennacl::traits::handle(vec), viennacl::traits::size(vec), 1, viennacl::traits::size(vec) * sizeof(T), 2 * viennacl::traits::size(vec));
+
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -621,9 +688,18 @@ namespace viennacl
     void norm_2_impl(vector_base<T> const & vec,
                      scalar<T> & result)
     {
+      VIENNACL_PROFILE_OPERATION("norm_2", viennacl::traits::handle(vec), viennacl::traits::size(vec), 1, viennacl::traits::size(vec) * sizeof(T), 2 * viennacl::traits::size(vec));
+
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          if (viennacl::backend::current_host_executor().enqueues())
+          {
+            viennacl::backend::current_host_executor().enqueue(new viennacl::linalg::host_based::detail::norm_task<T>(&viennacl::linalg::host_based::norm_2_impl, vec, result));
+            break;
+          }
+#endif
           viennacl::linalg::host_based::norm_2_impl(vec, result);
           break;
 #ifdef VIENNACL_WITH_OPENCL
@@ -666,6 +742,8 @@ namespace viennacl
     void norm_2_cpu(vector_base<T> const & vec,
                     T & result)
     {
+      VIENNACL_PROFILE_OPERATION("norm_2_cpu", viennacl::traits::handle(vec), viennacl::traits::size(vec), 1, viennacl::traits::size(vec) * sizeof(T), 2 * viennacl::traits::size(vec));
+
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -713,9 +791,18 @@ namespace viennacl
     void norm_inf_impl(vector_base<T> const & vec,
                        scalar<T> & result)
     {
+      VIENNACL_PROFILE_OPERATION("norm_inf", viennacl::traits::handle(vec), viennacl::traits::size(vec), 1, viennacl::traits::size(vec) * sizeof(T), viennacl::traits::size(vec));
+
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          if (viennacl::backend::current_host_executor().enqueues())
+          {
+            viennacl::backend::current_host_executor().enqueue(new viennacl::linalg::host_based::detail::norm_task<T>(&viennacl::linalg::host_based::norm_inf_impl, vec, result));
+            break;
+          }
+#endif
           viennacl::linalg::host_based::norm_inf_impl(vec, result);
           break;
 #ifdef VIENNACL_WITH_OPENCL
@@ -758,6 +845,8 @@ namespace viennacl
     void norm_inf_cpu(vector_base<T> const & vec,
                       T & result)
     {
+      VIENNACL_PROFILE_OPERATION("norm_inf_cpu", viennacl::traits::handle(vec), viennacl::traits::size(vec), 1, viennacl::traits::size(vec) * sizeof(T), viennacl::traits::size(vec));
+
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -805,6 +894,8 @@ namespace viennacl
     template <typename T>
     std::size_t index_norm_inf(vector_base<T> const & vec)
     {
+      VIENNACL_PROFILE_OPERATION("index_norm_inf", viennacl::traits::handle(vec), viennacl::traits::size(vec), 1, viennacl::traits::size(vec) * sizeof(T), viennacl::traits::size(vec));
+
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -850,6 +941,8 @@ namespace viennacl
                         vector_base<T> & vec2,
                         T alpha, T beta)
     {
+      VIENNACL_PROFILE_OPERATION("plane_rotation", viennacl::traits::handle(vec1), viennacl::traits::size(vec1), 1, 4 * viennacl::traits::size(vec1) * sizeof(T), 6 * viennacl::traits::size(vec1));
+
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
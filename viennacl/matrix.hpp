@@ -31,7 +31,7 @@
 #include "viennacl/tools/matrix_size_deducer.hpp"
 #include "viennacl/meta/result_of.hpp"
 #include "viennacl/meta/enable_if.hpp"
-//#include "viennacl/rand/utils.hpp"
+#include "viennacl/rand/utils.hpp"
 #include "viennacl/traits/handle.hpp"
 
 namespace viennacl
@@ -142,12 +142,15 @@ namespace viennacl
 
 
 
-//#ifdef VIENNACL_WITH_OPENCL
-//  template<class SCALARTYPE, class DISTRIBUTION>
-//  rand::random_matrix_t<SCALARTYPE, DISTRIBUTION> random_matrix(unsigned int size1, unsigned int size2, DISTRIBUTION const & distribution){
-//      return rand::random_matrix_t<SCALARTYPE,DISTRIBUTION>(size1,size2,distribution);
-//  }
-//#endif
+  /** @brief Returns a proxy for a size1 x size2 matrix filled with random numbers from the distribution (e.g. rand::uniform_tag, rand::gaussian_tag)
+  *
+  * The header of the distribution (e.g. viennacl/rand/uniform.hpp) needs to be included.
+  */
+  template<class SCALARTYPE, class DISTRIBUTION>
+  rand::random_matrix_t<SCALARTYPE, DISTRIBUTION> random_matrix(vcl_size_t size1, vcl_size_t size2, DISTRIBUTION const & distribution, viennacl::context ctx = viennacl::context())
+  {
+    return rand::random_matrix_t<SCALARTYPE,DISTRIBUTION>(size1, size2, distribution, ctx);
+  }
 
   template <typename LHS, typename RHS, typename OP>
   class matrix_expression
@@ -362,17 +365,6 @@ namespace viennacl
         return *this;
       }
 
-      /** @brief Creates the matrix from the supplied random matrix. */
-      /*template<class DISTRIBUTION>
-      matrix(rand::random_matrix_t<SCALARTYPE, DISTRIBUTION> const & m) : rows_(m.size1), columns_(m.size2)
-      {
-        if (internal_size() > 0)
-        {
-          viennacl::backend::memory_create(elements_, sizeof(SCALARTYPE)*internal_size());
-          rand::buffer_dumper<SCALARTYPE, DISTRIBUTION>::dump(elements_,m.distribution,0,internal_size());
-        }
-      }*/
-
 
 
       /** @brief Implementation of the operation m1 = m2 @ alpha, where @ denotes either multiplication or division, and alpha is either a CPU or a GPU scalar
@@ -784,6 +776,14 @@ namespace viennacl
           base_type::operator=(m);
       }
 
+      /** @brief Creates the matrix from the supplied random matrix. */
+      template<class DISTRIBUTION>
+      matrix(rand::random_matrix_t<SCALARTYPE, DISTRIBUTION> const & m) : base_type(m.size1, m.size2, m.ctx)
+      {
+        if (base_type::internal_size() > 0)
+          rand::buffer_dumper<SCALARTYPE, DISTRIBUTION>::dump(*this, m.distribution);
+      }
+
       matrix(const base_type & other) : base_type(other.size1(), other.size2(), viennacl::traits::context(other))
       {
         base_type::operator=(other);
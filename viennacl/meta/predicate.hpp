@@ -344,6 +344,12 @@ namespace viennacl
       enum { value = true };
     };
 
+    template <typename ScalarType>
+    struct is_any_sparse_matrix<viennacl::symmetric_compressed_matrix<ScalarType> >
+    {
+      enum { value = true };
+    };
+
     template <typename ScalarType, unsigned int ALIGNMENT>
     struct is_any_sparse_matrix<viennacl::coordinate_matrix<ScalarType, ALIGNMENT> >
     {
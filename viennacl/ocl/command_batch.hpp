@@ -0,0 +1,243 @@
+#ifndef VIENNACL_OCL_COMMAND_BATCH_HPP_
+#define VIENNACL_OCL_COMMAND_BATCH_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/ocl/command_batch.hpp
+    @brief Recording and replay of sequences of kernel launches and device memory transfers
+*/
+
+#ifdef __APPLE__
+#include <OpenCL/cl.h>
+#else
+#include <CL/cl.h>
+#endif
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cstring>
+#include <cassert>
+#include <exception>
+
+#include "viennacl/ocl/forwards.h"
+#include "viennacl/ocl/handle.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/command_queue.hpp"
+#include "viennacl/tools/shared_ptr.hpp"
+
+namespace viennacl
+{
+  namespace ocl
+  {
+    class command_batch;
+
+    /** @brief Exception thrown if an operation cannot be recorded by a command batch */
+    class command_batch_exception : public std::exception
+    {
+      public:
+        command_batch_exception() : message_() {}
+        command_batch_exception(std::string message) : message_("ViennaCL: Command batch: " + message) {}
+
+        virtual const char* what() const throw() { return message_.c_str(); }
+
+        virtual ~command_batch_exception() throw() {}
+      private:
+        std::string message_;
+    };
+
+    namespace detail
+    {
+      /** @brief Returns the command batch which is currently recording, or NULL if there is none. */
+      inline viennacl::ocl::command_batch * & recording_batch()
+      {
+        static viennacl::ocl::command_batch * batch = NULL;
+        return batch;
+      }
+    }
+
+    /** @brief Records the kernel launches and device memory transfers of a sequence of operations once and replays them later on.
+    *
+    * Intended for iterative solvers on small vectors, where the host-side work for each kernel launch exceeds the kernel execution time:
+    *
+    *   viennacl::ocl::command_batch iteration;
+    *   iteration.start_recording();
+    *   ... // one iteration, operations are executed as usual
+    *   iteration.stop_recording();
+    *
+    *   for (std::size_t i=1; i<iterations; ++i)
+    *     iteration.replay();
+    *
+    * All kernel arguments are frozen at the time of recording. This includes host scalars and all buffers, which are kept alive until the batch is cleared.
+    * Reads into host memory are not recorded. Hence, a recorded sequence can only be replayed meaningfully if all data dependencies between its operations
+    * reside on the device, e.g. by using viennacl::scalar<> instead of host scalars for the coefficients of the solver.
+    */
+    class command_batch
+    {
+        struct command
+        {
+          explicit command(viennacl::ocl::command_queue const & q) : queue(q), src_offset(0), dst_offset(0), bytes(0) {}
+
+          viennacl::ocl::command_queue queue;
+
+          // kernel launch:
+          viennacl::tools::shared_ptr<viennacl::ocl::kernel> launch;
+          viennacl::tools::shared_ptr<viennacl::ocl::detail::kernel_arguments> arguments;
+          std::vector< viennacl::ocl::handle<cl_mem> > buffers;   //keeps the memory objects passed as arguments alive
+
+          // buffer copy (src set) or write from host (src not set):
+          viennacl::ocl::handle<cl_mem> src;
+          viennacl::ocl::handle<cl_mem> dst;
+          std::size_t src_offset;
+          std::size_t dst_offset;
+          std::size_t bytes;
+          std::vector<char> data;
+        };
+
+      public:
+        command_batch() : recording_(false) {}
+
+        ~command_batch()
+        {
+          if (recording_)
+            stop_recording();
+          clear();
+        }
+
+        /** @brief Starts recording. Operations are still executed while being recorded. Only one batch can record at a time. */
+        void start_recording()
+        {
+          assert(detail::recording_batch() == NULL && bool("Another command batch is already recording!"));
+          clear();
+          recording_ = true;
+          detail::recording_batch() = this;
+        }
+
+        /** @brief Stops recording */
+        void stop_recording()
+        {
+          recording_ = false;
+          if (detail::recording_batch() == this)
+            detail::recording_batch() = NULL;
+        }
+
+        /** @brief Returns true if the batch is currently recording */
+        bool recording() const { return recording_; }
+
+        /** @brief Returns the number of recorded commands */
+        std::size_t size() const { return commands_.size(); }
+
+        /** @brief Discards all recorded commands and releases the buffers kept alive by them */
+        void clear()
+        {
+          for (std::size_t i=0; i<commands_.size(); ++i)
+            if (!commands_[i].launch.get() && !commands_[i].src.get())
+              commands_[i].queue.finish();  //replayed writes are non-blocking and read from the recorded data
+          commands_.clear();
+        }
+
+        /** @brief Enqueues all recorded commands again in the command queues used at the time of recording */
+        inline void replay();    //see enqueue.hpp for implementation
+
+
+        /** @brief Records the launch of kernel 'k' with its current arguments and work sizes. Called by viennacl::ocl::enqueue().
+        *
+        * Throws command_batch_exception if an argument cannot be recorded, e.g. an OpenCL object other than a buffer.
+        */
+        void record_launch(viennacl::ocl::kernel const & k, viennacl::ocl::command_queue const & queue)
+        {
+          command cmd(queue);
+          cmd.launch = viennacl::tools::shared_ptr<viennacl::ocl::kernel>(new viennacl::ocl::kernel(k));
+          cmd.arguments = viennacl::tools::shared_ptr<viennacl::ocl::detail::kernel_arguments>(new viennacl::ocl::detail::kernel_arguments(*k.arguments_));
+
+          for (std::size_t i=0; i<cmd.arguments->size(); ++i)
+          {
+            viennacl::ocl::detail::kernel_argument const & a = (*cmd.arguments)[i];
+            if (!a.valid)
+              throw command_batch_exception("Argument " + k.name() + "[" + position_string(i) + "] cannot be recorded");
+
+            if (a.is_mem)
+            {
+              cl_mem mem;
+              std::memcpy(&mem, a.value, sizeof(cl_mem));
+              if (mem)
+              {
+                cmd.buffers.push_back(viennacl::ocl::handle<cl_mem>());
+                cmd.buffers.back() = mem;   //wraps the memory object without taking a reference
+                cmd.buffers.back().inc();
+              }
+            }
+          }
+
+          commands_.push_back(cmd);
+        }
+
+        /** @brief Records a copy between two buffers. Called by viennacl::backend::opencl::memory_copy(). */
+        void record_copy(viennacl::ocl::handle<cl_mem> const & src_buffer,
+                         viennacl::ocl::handle<cl_mem> const & dst_buffer,
+                         std::size_t src_offset,
+                         std::size_t dst_offset,
+                         std::size_t bytes_to_copy,
+                         viennacl::ocl::command_queue const & queue)
+        {
+          command cmd(queue);
+          cmd.src = src_buffer;
+          cmd.dst = dst_buffer;
+          cmd.src_offset = src_offset;
+          cmd.dst_offset = dst_offset;
+          cmd.bytes = bytes_to_copy;
+          commands_.push_back(cmd);
+        }
+
+        /** @brief Records a write from host memory. The data is copied, so 'ptr' need not remain valid. Called by viennacl::backend::opencl::memory_write() and memory_create(). */
+        void record_write(viennacl::ocl::handle<cl_mem> const & dst_buffer,
+                          std::size_t dst_offset,
+                          std::size_t bytes_to_copy,
+                          const void * ptr,
+                          viennacl::ocl::command_queue const & queue)
+        {
+          if (bytes_to_copy == 0)
+            return;
+
+          command cmd(queue);
+          cmd.dst = dst_buffer;
+          cmd.dst_offset = dst_offset;
+          cmd.bytes = bytes_to_copy;
+          cmd.data.assign(static_cast<const char *>(ptr), static_cast<const char *>(ptr) + bytes_to_copy);
+          commands_.push_back(cmd);
+        }
+
+      private:
+        command_batch(command_batch const &);
+        command_batch & operator=(command_batch const &);
+
+        static std::string position_string(std::size_t i)
+        {
+          std::ostringstream ss;
+          ss << i;
+          return ss.str();
+        }
+
+        bool recording_;
+        std::vector<command> commands_;
+    };
+
+  } //namespace ocl
+} //namespace viennacl
+
+#endif
@@ -30,6 +30,8 @@
 
 #include "viennacl/ocl/kernel.hpp"
 #include "viennacl/ocl/command_queue.hpp"
+#include "viennacl/ocl/command_batch.hpp"
+#include "viennacl/tools/profiler.hpp"
 
 namespace viennacl
 {
@@ -45,6 +47,13 @@ namespace viennacl
     template <typename KernelType>
     void enqueue(KernelType & k, viennacl::ocl::command_queue const & queue)
     {
+#ifdef VIENNACL_WITH_PROFILING
+      cl_event event;
+      cl_event * event_ptr = viennacl::tools::current_profiler().enabled() ? &event : NULL;   //kernel timing via OpenCL events
+#else
+      cl_event * event_ptr = NULL;
+#endif
+
       // 1D kernel:
       if (k.local_work_size(1) == 0)
       {
@@ -59,9 +68,9 @@ namespace viennacl
 
         cl_int err;
         if (tmp_global == 1 && tmp_local == 1)
-          err = clEnqueueTask(queue.handle().get(), k.handle().get(), 0, NULL, NULL);
+          err = clEnqueueTask(queue.handle().get(), k.handle().get(), 0, NULL, event_ptr);
         else
-          err = clEnqueueNDRangeKernel(queue.handle().get(), k.handle().get(), 1, NULL, &tmp_global, &tmp_local, 0, NULL, NULL);
+          err = clEnqueueNDRangeKernel(queue.handle().get(), k.handle().get(), 1, NULL, &tmp_global, &tmp_local, 0, NULL, event_ptr);
 
         if (err != CL_SUCCESS)
         {
@@ -88,7 +97,7 @@ namespace viennacl
         tmp_local[1] = k.local_work_size(1);
         tmp_local[2] = k.local_work_size(2);
 
-        cl_int err = clEnqueueNDRangeKernel(queue.handle().get(), k.handle().get(), (tmp_global[2] == 0) ? 2 : 3, NULL, tmp_global, tmp_local, 0, NULL, NULL);
+        cl_int err = clEnqueueNDRangeKernel(queue.handle().get(), k.handle().get(), (tmp_global[2] == 0) ? 2 : 3, NULL, tmp_global, tmp_local, 0, NULL, event_ptr);
 
         if (err != CL_SUCCESS)
         {
@@ -98,6 +107,15 @@ namespace viennacl
         }
       }
 
+#ifdef VIENNACL_WITH_PROFILING
+      if (event_ptr)
+        viennacl::tools::current_profiler().add_kernel_event(k.name(), event);
+#endif
+
+      viennacl::ocl::command_batch * batch = viennacl::ocl::detail::recording_batch();
+      if (batch)
+        batch->record_launch(k, queue);
+
       #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
       queue.finish();
       std::cout << "ViennaCL: Kernel " << k.name() << " finished!" << std::endl;
@@ -112,6 +130,37 @@ namespace viennacl
       enqueue(k, k.context().get_queue());
     }
 
+    inline void command_batch::replay()
+    {
+      assert(!recording_ && bool("Cannot replay a command batch while recording it!"));
+
+      for (std::size_t i=0; i<commands_.size(); ++i)
+      {
+        command & cmd = commands_[i];
+        if (cmd.launch.get())
+        {
+          viennacl::ocl::kernel & k = *cmd.launch;
+          for (unsigned int j=0; j<cmd.arguments->size(); ++j)
+          {
+            viennacl::ocl::detail::kernel_argument const & a = (*cmd.arguments)[j];
+            if (a.valid)
+              k.set_arg(j, a.size, a.is_local ? NULL : a.value, a.is_mem);   //arguments unchanged since the last launch are skipped
+          }
+          viennacl::ocl::enqueue(k, cmd.queue);
+        }
+        else if (cmd.src.get())
+        {
+          cl_int err = clEnqueueCopyBuffer(cmd.queue.handle().get(), cmd.src.get(), cmd.dst.get(), cmd.src_offset, cmd.dst_offset, cmd.bytes, 0, NULL, NULL);
+          VIENNACL_ERR_CHECK(err);
+        }
+        else
+        {
+          cl_int err = clEnqueueWriteBuffer(cmd.queue.handle().get(), cmd.dst.get(), CL_FALSE, cmd.dst_offset, cmd.bytes, &(cmd.data[0]), 0, NULL, NULL);
+          VIENNACL_ERR_CHECK(err);
+        }
+      }
+    }
+
     inline void enqueue(viennacl::generator::custom_operation & op, viennacl::ocl::command_queue const & queue)
     {
       generator::enqueue_custom_op(op,queue);
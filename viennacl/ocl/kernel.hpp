@@ -28,6 +28,9 @@
 #include <CL/cl.h>
 #endif
 
+#include <cstring>
+#include <vector>
+
 #include "viennacl/ocl/forwards.h"
 #include "viennacl/ocl/backend.hpp"
 #include "viennacl/ocl/handle.hpp"
@@ -35,6 +38,7 @@
 #include "viennacl/ocl/device.hpp"
 #include "viennacl/ocl/local_mem.hpp"
 #include "viennacl/ocl/infos.hpp"
+#include "viennacl/tools/shared_ptr.hpp"
 
 namespace viennacl
 {
@@ -48,9 +52,76 @@ namespace viennacl
       cl_uint internal_size;
     };
 
+    namespace detail
+    {
+      /** @brief Value of a kernel argument as last passed to clSetKernelArg() */
+      struct kernel_argument
+      {
+        enum { max_size = sizeof(packed_cl_uint) };
+
+        kernel_argument() : valid(false), is_mem(false), is_local(false), size(0) {}
+
+        bool valid;
+        bool is_mem;
+        bool is_local;
+        std::size_t size;
+        char value[max_size];   //unused for local memory
+      };
+
+      /** @brief The arguments of a kernel as last passed to clSetKernelArg().
+      *
+      * Memory objects are recorded, but never reported as unchanged: the cache does not hold a reference, so an equal cl_mem may denote a new buffer
+      * allocated after the previous one was released.
+      */
+      class kernel_arguments
+      {
+        public:
+          std::size_t size() const { return args_.size(); }
+          kernel_argument const & operator[](std::size_t i) const { return args_[i]; }
+
+          /** @brief Returns true if the argument at position 'pos' is known to hold the provided value. A NULL value denotes local memory of the given size. */
+          bool matches(unsigned int pos, std::size_t size, const void * value) const
+          {
+            if (pos >= args_.size() || !args_[pos].valid || args_[pos].is_mem || args_[pos].size != size)
+              return false;
+            if (value == NULL)
+              return args_[pos].is_local;
+            return !args_[pos].is_local && std::memcmp(args_[pos].value, value, size) == 0;
+          }
+
+          /** @brief Records the value passed to clSetKernelArg() for position 'pos'. Values too large for the cache are not recorded. */
+          void store(unsigned int pos, std::size_t size, const void * value, bool is_mem)
+          {
+            if (pos >= args_.size())
+              args_.resize(pos + 1);
+
+            kernel_argument arg;
+            arg.valid = (size <= std::size_t(kernel_argument::max_size)) || (value == NULL);
+            arg.is_mem = is_mem;
+            arg.is_local = (value == NULL);
+            arg.size = size;
+            if (arg.valid && value)
+              std::memcpy(arg.value, value, size);
+
+            args_[pos] = arg;
+          }
+
+          void invalidate(unsigned int pos)
+          {
+            if (pos < args_.size())
+              args_[pos] = kernel_argument();
+          }
+
+        private:
+          std::vector<kernel_argument> args_;
+      };
+    }
+
     /** @brief Represents an OpenCL kernel within ViennaCL */
     class kernel
     {
+      friend class command_batch;
+
       template <typename KernelType>
       friend void enqueue(KernelType & k, viennacl::ocl::command_queue const & queue);
 
@@ -64,7 +135,7 @@ namespace viennacl
     public:
       typedef std::size_t            size_type;
 
-      kernel() : handle_(), p_program_(NULL), p_context_(NULL), name_()
+      kernel() : handle_(), p_program_(NULL), p_context_(NULL), name_(), arguments_(new detail::kernel_arguments())
       {
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Creating kernel object (default CTOR)" << std::endl;
@@ -72,7 +143,7 @@ namespace viennacl
       }
 
       kernel(cl_kernel kernel_handle, viennacl::ocl::program const & kernel_program, viennacl::ocl::context const & kernel_context, std::string const & name)
-        : handle_(kernel_handle, kernel_context), p_program_(&kernel_program), p_context_(&kernel_context), name_(name)
+        : handle_(kernel_handle, kernel_context), p_program_(&kernel_program), p_context_(&kernel_context), name_(name), arguments_(new detail::kernel_arguments())
       {
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Creating kernel object (full CTOR)" << std::endl;
@@ -81,7 +152,7 @@ namespace viennacl
       }
 
       kernel(kernel const & other)
-        : handle_(other.handle_), p_program_(other.p_program_), p_context_(other.p_context_), name_(other.name_)
+        : handle_(other.handle_), p_program_(other.p_program_), p_context_(other.p_context_), name_(other.name_), arguments_(other.arguments_)
       {
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Creating kernel object (Copy CTOR)" << std::endl;
@@ -104,6 +175,7 @@ namespace viennacl
         p_program_ = other.p_program_;
         p_context_ = other.p_context_;
         name_ = other.name_;
+        arguments_ = other.arguments_;
         local_work_size_[0] = other.local_work_size_[0];
         local_work_size_[1] = other.local_work_size_[1];
         local_work_size_[2] = other.local_work_size_[2];
@@ -119,8 +191,7 @@ namespace viennacl
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Setting char kernel argument " << val << " at pos " << pos << " for kernel " << name_ << std::endl;
         #endif
-        cl_int err = clSetKernelArg(handle_.get(), pos, sizeof(cl_char), (void*)&val);
-        VIENNACL_ERR_CHECK(err);
+        set_arg(pos, sizeof(cl_char), &val);
       }
 
       /** @brief Sets a char argument at the provided position */
@@ -129,8 +200,7 @@ namespace viennacl
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Setting unsigned char kernel argument " << val << " at pos " << pos << " for kernel " << name_ << std::endl;
         #endif
-        cl_int err = clSetKernelArg(handle_.get(), pos, sizeof(cl_uchar), (void*)&val);
-        VIENNACL_ERR_CHECK(err);
+        set_arg(pos, sizeof(cl_uchar), &val);
       }
 
       /** @brief Sets a argument of type short at the provided position */
@@ -139,8 +209,7 @@ namespace viennacl
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Setting short kernel argument " << val << " at pos " << pos << " for kernel " << name_ << std::endl;
         #endif
-        cl_int err = clSetKernelArg(handle_.get(), pos, sizeof(cl_short), (void*)&val);
-        VIENNACL_ERR_CHECK(err);
+        set_arg(pos, sizeof(cl_short), &val);
       }
 
       /** @brief Sets a argument of type unsigned short at the provided position */
@@ -149,8 +218,7 @@ namespace viennacl
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Setting unsigned short kernel argument " << val << " at pos " << pos << " for kernel " << name_ << std::endl;
         #endif
-        cl_int err = clSetKernelArg(handle_.get(), pos, sizeof(cl_ushort), (void*)&val);
-        VIENNACL_ERR_CHECK(err);
+        set_arg(pos, sizeof(cl_ushort), &val);
       }
 
 
@@ -160,8 +228,7 @@ namespace viennacl
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Setting unsigned long kernel argument " << val << " at pos " << pos << " for kernel " << name_ << std::endl;
         #endif
-        cl_int err = clSetKernelArg(handle_.get(), pos, sizeof(cl_uint), (void*)&val);
-        VIENNACL_ERR_CHECK(err);
+        set_arg(pos, sizeof(cl_uint), &val);
       }
 
       /** @brief Sets four packed unsigned integers as argument at the provided position */
@@ -170,8 +237,7 @@ namespace viennacl
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Setting packed_cl_uint kernel argument (" << val.start << ", " << val.stride << ", " << val.size << ", " << val.internal_size << ") at pos " << pos << " for kernel " << name_ << std::endl;
         #endif
-        cl_int err = clSetKernelArg(handle_.get(), pos, sizeof(packed_cl_uint), (void*)&val);
-        VIENNACL_ERR_CHECK(err);
+        set_arg(pos, sizeof(packed_cl_uint), &val);
       }
 
       /** @brief Sets a single precision floating point argument at the provided position */
@@ -180,8 +246,7 @@ namespace viennacl
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Setting floating point kernel argument " << val << " at pos " << pos << " for kernel " << name_ << std::endl;
         #endif
-        cl_int err = clSetKernelArg(handle_.get(), pos, sizeof(float), (void*)&val);
-        VIENNACL_ERR_CHECK(err);
+        set_arg(pos, sizeof(float), &val);
       }
 
       /** @brief Sets a double precision floating point argument at the provided position */
@@ -190,8 +255,7 @@ namespace viennacl
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Setting double precision kernel argument " << val << " at pos " << pos << " for kernel " << name_ << std::endl;
         #endif
-        cl_int err = clSetKernelArg(handle_.get(), pos, sizeof(double), (void*)&val);
-        VIENNACL_ERR_CHECK(err);
+        set_arg(pos, sizeof(double), &val);
       }
 
       /** @brief Sets an int argument at the provided position */
@@ -200,8 +264,7 @@ namespace viennacl
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Setting int precision kernel argument " << val << " at pos " << pos << " for kernel " << name_ << std::endl;
         #endif
-        cl_int err = clSetKernelArg(handle_.get(), pos, sizeof(cl_int), (void*)&val);
-        VIENNACL_ERR_CHECK(err);
+        set_arg(pos, sizeof(cl_int), &val);
       }
 
       /** @brief Sets an unsigned long argument at the provided position */
@@ -210,8 +273,7 @@ namespace viennacl
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Setting ulong precision kernel argument " << val << " at pos " << pos << " for kernel " << name_ << std::endl;
         #endif
-        cl_int err = clSetKernelArg(handle_.get(), pos, sizeof(cl_ulong), (void*)&val);
-        VIENNACL_ERR_CHECK(err);
+        set_arg(pos, sizeof(cl_ulong), &val);
       }
 
       /** @brief Sets an unsigned long argument at the provided position */
@@ -220,8 +282,7 @@ namespace viennacl
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Setting long precision kernel argument " << val << " at pos " << pos << " for kernel " << name_ << std::endl;
         #endif
-        cl_int err = clSetKernelArg(handle_.get(), pos, sizeof(cl_long), (void*)&val);
-        VIENNACL_ERR_CHECK(err);
+        set_arg(pos, sizeof(cl_long), &val);
       }
 
       //generic handling: call .handle() member
@@ -235,11 +296,21 @@ namespace viennacl
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Setting generic kernel argument " << temp << " at pos " << pos << " for kernel " << name_ << std::endl;
         #endif
-        cl_int err = clSetKernelArg(handle_.get(), pos, sizeof(cl_mem), (void*)&temp);
-        VIENNACL_ERR_CHECK(err);
+        set_arg(pos, sizeof(cl_mem), &temp, true);
       }
 
       //forward handles directly:
+      /** @brief Sets an OpenCL memory object at the provided position */
+      void arg(unsigned int pos, viennacl::ocl::handle<cl_mem> const & h)
+      {
+        cl_mem temp = h.get();
+        #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
+        std::cout << "ViennaCL: Setting handle kernel argument " << temp << " at pos " << pos << " for kernel " << name_ << std::endl;
+        #endif
+        set_arg(pos, sizeof(cl_mem), &temp, true);
+      }
+
+
       /** @brief Sets an OpenCL object at the provided position */
       template<class CL_TYPE>
       void arg(unsigned int pos, viennacl::ocl::handle<CL_TYPE> const & h)
@@ -250,6 +321,7 @@ namespace viennacl
         #endif
         cl_int err = clSetKernelArg(handle_.get(), pos, sizeof(CL_TYPE), (void*)&temp);
         VIENNACL_ERR_CHECK(err);
+        arguments_->invalidate(pos);  //other OpenCL objects are not recorded
       }
 
 
@@ -261,8 +333,7 @@ namespace viennacl
         #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
         std::cout << "ViennaCL: Setting local memory kernel argument of size " << size << " bytes at pos " << pos << " for kernel " << name_ << std::endl;
         #endif
-        cl_int err = clSetKernelArg(handle_.get(), pos, size, 0);
-        VIENNACL_ERR_CHECK(err);
+        set_arg(pos, size, NULL);
       }
 
 
@@ -792,12 +863,24 @@ namespace viennacl
 
       inline void set_work_size_defaults();    //see context.hpp for implementation
 
+      /** @brief Passes an argument to clSetKernelArg() unless the same value has already been set at this position. A NULL value denotes local memory. */
+      void set_arg(unsigned int pos, std::size_t size, const void * value, bool is_mem = false)
+      {
+        if (arguments_->matches(pos, size, value))
+          return;
+
+        cl_int err = clSetKernelArg(handle_.get(), pos, size, value);
+        VIENNACL_ERR_CHECK(err);
+        arguments_->store(pos, size, value, is_mem);
+      }
+
       viennacl::ocl::handle<cl_kernel> handle_;
       viennacl::ocl::program const * p_program_;
       viennacl::ocl::context const * p_context_;
       std::string name_;
       size_type local_work_size_[3];
       size_type global_work_size_[3];
+      viennacl::tools::shared_ptr<detail::kernel_arguments> arguments_;   //shared by all copies, since they refer to the same OpenCL kernel
     };
 
     /** @brief Queries information about a kernel
@@ -1,31 +1,77 @@
 #ifndef VIENNACL_RAND_GAUSSIAN_HPP_
 #define VIENNACL_RAND_GAUSSIAN_HPP_
 
-#include "viennacl/backend/mem_handle.hpp"
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/rand/gaussian.hpp
+    @brief Normally distributed random numbers for vectors and matrices on all compute backends.
+*/
+
+#include "viennacl/forwards.h"
 #include "viennacl/rand/utils.hpp"
-#include "viennacl/linalg/kernels/rand_kernels.h"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/host_based/random_operations.hpp"
 
-namespace viennacl{
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/opencl/random_operations.hpp"
+#endif
 
-namespace rand{
+namespace viennacl
+{
+  namespace rand
+  {
 
-struct gaussian_tag{
-    gaussian_tag(float _mu = 0, float _sigma = 1) : mu(_mu), sigma(_sigma){ }
-    float mu;
-    float sigma;
-};
+    /** @brief Tag for normally distributed random numbers with mean mu and standard deviation sigma. Objects filled with the same seed obtain the same numbers. */
+    struct gaussian_tag
+    {
+      gaussian_tag(float _mu = 0, float _sigma = 1, unsigned int _seed = 0) : mu(_mu), sigma(_sigma), seed(_seed) { }
 
-template<class ScalarType>
-struct buffer_dumper<ScalarType, gaussian_tag>{
-    static void dump(viennacl::backend::mem_handle const & buff, gaussian_tag tag, cl_uint start, cl_uint size){
-      viennacl::ocl::kernel & k = viennacl::ocl::get_kernel(viennacl::linalg::kernels::rand<ScalarType,1>::program_name(),"dump_gaussian");
-      k.global_work_size(0, viennacl::tools::align_to_multiple<unsigned int>(size/2,k.local_work_size(0)));
-      viennacl::ocl::enqueue(k(buff.opencl_handle(), start, size, cl_float(tag.mu), cl_float(tag.sigma) , cl_uint(time(0))));
-    }
-};
+      float mu;
+      float sigma;
+      unsigned int seed;
+    };
 
-}
+    template<class ScalarType>
+    struct buffer_dumper<ScalarType, gaussian_tag>
+    {
+      template <typename ObjectT>
+      static void dump(ObjectT & obj, gaussian_tag const & tag)
+      {
+        switch (viennacl::traits::handle(obj).get_active_handle_id())
+        {
+          case viennacl::MAIN_MEMORY:
+            viennacl::linalg::host_based::random_gaussian(obj, ScalarType(tag.mu), ScalarType(tag.sigma), tag.seed);
+            break;
+#ifdef VIENNACL_WITH_OPENCL
+          case viennacl::OPENCL_MEMORY:
+            viennacl::linalg::opencl::random_gaussian(obj, ScalarType(tag.mu), ScalarType(tag.sigma), tag.seed);
+            break;
+#endif
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+            throw memory_exception("not implemented");
+        }
+      }
+    };
 
+  }
 }
 
 #endif
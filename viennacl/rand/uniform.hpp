@@ -1,34 +1,77 @@
 #ifndef VIENNACL_RAND_UNIFORM_HPP_
 #define VIENNACL_RAND_UNIFORM_HPP_
 
-#include "viennacl/backend/mem_handle.hpp"
-#include "viennacl/rand/utils.hpp"
-#include "viennacl/linalg/kernels/rand_kernels.h"
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
 
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
 
-namespace viennacl{
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
 
-namespace rand{
+   (A list of authors and contributors can be found in the PDF manual)
 
-struct uniform_tag{
-    uniform_tag(unsigned int _a = 0, unsigned int _b = 1) : a(_a), b(_b){ }
-    float a;
-    float b;
-};
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
 
-template<class ScalarType>
-struct buffer_dumper<ScalarType, uniform_tag>{
-  static void dump(viennacl::backend::mem_handle const & buff, uniform_tag tag, cl_uint start, cl_uint size){
-    viennacl::ocl::kernel & k = viennacl::ocl::get_kernel(viennacl::linalg::kernels::rand<ScalarType,1>::program_name(),"dump_uniform");
-    k.global_work_size(0, viennacl::tools::align_to_multiple<unsigned int>(size,k.local_work_size(0)));
-    viennacl::ocl::enqueue(k(buff.opencl_handle(), start, size, cl_float(tag.a), cl_float(tag.b) , cl_uint(time(0))));
-  }
-};
+/** @file viennacl/rand/uniform.hpp
+    @brief Uniformly distributed random numbers for vectors and matrices on all compute backends.
+*/
 
+#include "viennacl/forwards.h"
+#include "viennacl/rand/utils.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/host_based/random_operations.hpp"
 
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/opencl/random_operations.hpp"
+#endif
 
-}
+namespace viennacl
+{
+  namespace rand
+  {
 
+    /** @brief Tag for uniformly distributed random numbers in [a, b). Objects filled with the same seed obtain the same numbers. */
+    struct uniform_tag
+    {
+      uniform_tag(float _a = 0, float _b = 1, unsigned int _seed = 0) : a(_a), b(_b), seed(_seed) { }
+
+      float a;
+      float b;
+      unsigned int seed;
+    };
+
+    template<class ScalarType>
+    struct buffer_dumper<ScalarType, uniform_tag>
+    {
+      template <typename ObjectT>
+      static void dump(ObjectT & obj, uniform_tag const & tag)
+      {
+        switch (viennacl::traits::handle(obj).get_active_handle_id())
+        {
+          case viennacl::MAIN_MEMORY:
+            viennacl::linalg::host_based::random_uniform(obj, ScalarType(tag.a), ScalarType(tag.b), tag.seed);
+            break;
+#ifdef VIENNACL_WITH_OPENCL
+          case viennacl::OPENCL_MEMORY:
+            viennacl::linalg::opencl::random_uniform(obj, ScalarType(tag.a), ScalarType(tag.b), tag.seed);
+            break;
+#endif
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+            throw memory_exception("not implemented");
+        }
+      }
+    };
+
+  }
 }
 
 #endif
@@ -1,49 +1,188 @@
 #ifndef VIENNACL_RAND_UTILS_HPP_
 #define VIENNACL_RAND_UTILS_HPP_
 
-#ifdef VIENNACL_WITH_OPENCL
-#include "viennacl/linalg/kernels/rand_kernels.h"
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
 
-namespace viennacl{
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
 
-namespace rand{
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
 
+   (A list of authors and contributors can be found in the PDF manual)
 
-template<class SCALARTYPE, class DISTRIBUTION>
-struct random_matrix_t{
-    typedef size_t size_type;
-    random_matrix_t(size_type _size1, unsigned int _size2, DISTRIBUTION const & _distribution) : size1(_size1), size2(_size2), distribution(_distribution){
-        #ifdef VIENNACL_WITH_OPENCL
-        viennacl::linalg::kernels::rand<SCALARTYPE,1>::init();
-        #endif
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/rand/utils.hpp
+    @brief Helper types and the counter-based Philox4x32-10 generator used for filling vectors and matrices with random numbers.
+
+    The random number assigned to an entry only depends on the seed and on the position of the entry
+    (row-major numbering for matrices), but not on the compute backend, the memory layout, or the number of threads.
+*/
+
+#include <cmath>
+#include <cstddef>
+
+#include "viennacl/forwards.h"
+#include "viennacl/context.hpp"
+
+namespace viennacl
+{
+  namespace rand
+  {
+
+    /** @brief Proxy for a random matrix, which is filled by the distribution when assigned to a viennacl::matrix */
+    template<class SCALARTYPE, class DISTRIBUTION>
+    struct random_matrix_t
+    {
+      typedef std::size_t size_type;
+
+      random_matrix_t(size_type _size1, size_type _size2, DISTRIBUTION const & _distribution, viennacl::context _ctx = viennacl::context())
+        : size1(_size1), size2(_size2), distribution(_distribution), ctx(_ctx) {}
+
+      size_type size1;
+      size_type size2;
+      DISTRIBUTION distribution;
+      viennacl::context ctx;
+    };
+
+    /** @brief Proxy for a random vector, which is filled by the distribution when assigned to a viennacl::vector */
+    template<class SCALARTYPE, class DISTRIBUTION>
+    struct random_vector_t
+    {
+      typedef std::size_t size_type;
+
+      random_vector_t(size_type _size, DISTRIBUTION const & _distribution, viennacl::context _ctx = viennacl::context())
+        : size(_size), distribution(_distribution), ctx(_ctx) {}
+
+      size_type size;
+      DISTRIBUTION distribution;
+      viennacl::context ctx;
+    };
+
+    /** @brief Fills vectors and matrices according to the distribution. Specialized for each distribution tag. */
+    template<class ScalarType, class Distribution>
+    struct buffer_dumper;
+
+    /** @brief Fills the vector v with random numbers from the distribution tag (e.g. uniform_tag, gaussian_tag) */
+    template <typename NumericT, typename DistributionT>
+    void generate(vector_base<NumericT> & v, DistributionT const & tag)
+    {
+      buffer_dumper<NumericT, DistributionT>::dump(v, tag);
     }
-    size_type size1;
-    size_type size2;
-    DISTRIBUTION distribution;
-};
-
-
-template<class SCALARTYPE, class DISTRIBUTION>
-struct random_vector_t{
-    typedef size_t size_type;
-    random_vector_t(size_type _size, DISTRIBUTION const & _distribution) : size(_size), distribution(_distribution){
-        #ifdef VIENNACL_WITH_OPENCL
-        viennacl::linalg::kernels::rand<SCALARTYPE,1>::init();
-        #endif
+
+    /** @brief Fills the matrix A with random numbers from the distribution tag (e.g. uniform_tag, gaussian_tag) */
+    template <typename NumericT, typename F, typename DistributionT>
+    void generate(matrix_base<NumericT, F> & A, DistributionT const & tag)
+    {
+      buffer_dumper<NumericT, DistributionT>::dump(A, tag);
     }
-    size_type size;
-    DISTRIBUTION distribution;
-};
 
-template<class ScalarType, class Distribution>
-struct buffer_dumper;
 
+    namespace detail
+    {
+      /** @brief Returns the low 32 bits of a * b and writes the high 32 bits to hi. Does not require a 64-bit integer type. */
+      inline unsigned int philox_mulhilo(unsigned int a, unsigned int b, unsigned int & hi)
+      {
+        unsigned int a_lo = a & 0xFFFF, a_hi = a >> 16;
+        unsigned int b_lo = b & 0xFFFF, b_hi = b >> 16;
 
-}
+        unsigned int p00 = a_lo * b_lo;
+        unsigned int p01 = a_lo * b_hi;
+        unsigned int p10 = a_hi * b_lo;
+        unsigned int p11 = a_hi * b_hi;
 
-}
+        unsigned int mid = (p00 >> 16) + (p01 & 0xFFFF) + (p10 & 0xFFFF);
+        hi = p11 + (p01 >> 16) + (p10 >> 16) + (mid >> 16);
 
-#endif
+        return a * b;
+      }
+
+      /** @brief Philox4x32-10 bijection (Salmon et al., 'Parallel random numbers: As easy as 1, 2, 3', SC'11). Maps the counter ctr in place. */
+      inline void philox4x32(unsigned int * ctr, unsigned int key0, unsigned int key1)
+      {
+        for (unsigned int round = 0; round < 10; ++round)
+        {
+          unsigned int hi0, hi1;
+          unsigned int lo0 = philox_mulhilo(0xD2511F53u, ctr[0], hi0);
+          unsigned int lo1 = philox_mulhilo(0xCD9E8D57u, ctr[2], hi1);
+
+          unsigned int c0 = hi1 ^ ctr[1] ^ key0;
+          unsigned int c2 = hi0 ^ ctr[3] ^ key1;
+          ctr[0] = c0;
+          ctr[1] = lo1;
+          ctr[2] = c2;
+          ctr[3] = lo0;
+
+          key0 += 0x9E3779B9u;
+          key1 += 0xBB67AE85u;
+        }
+      }
+
+      /** @brief Number of random values generated from a single Philox invocation (one 32-bit word for float, two for double) */
+      template <typename NumericT>
+      struct philox_values_per_block
+      {
+        static const std::size_t value = 2;
+      };
+
+      template <>
+      struct philox_values_per_block<float>
+      {
+        static const std::size_t value = 4;
+      };
+
+      /** @brief Converts the four random words of a block to uniformly distributed values in the open interval (0, 1). Returns the number of values. */
+      template <typename NumericT>
+      std::size_t philox_to_uniform(unsigned int const * x, NumericT * values)
+      {
+        values[0] = (NumericT(x[0] >> 5) * NumericT(67108864.0) + NumericT(x[1] >> 6) + NumericT(0.5)) * NumericT(1.0 / 9007199254740992.0);
+        values[1] = (NumericT(x[2] >> 5) * NumericT(67108864.0) + NumericT(x[3] >> 6) + NumericT(0.5)) * NumericT(1.0 / 9007199254740992.0);
+        return 2;
+      }
 
+      template <>
+      inline std::size_t philox_to_uniform<float>(unsigned int const * x, float * values)
+      {
+        for (std::size_t i=0; i<4; ++i)
+          values[i] = (float(x[i] >> 8) + 0.5f) * (1.0f / 16777216.0f);
+        return 4;
+      }
+
+      /** @brief Computes the random values of block 'block' of the stream defined by 'seed'. If gaussian is true, the values are standard normal (Box-Muller), otherwise uniform in (0, 1).
+      *
+      * The block index occupies the two low counter words, so streams of more than 2^32 blocks do not repeat.
+      */
+      template <typename NumericT>
+      std::size_t philox_block(std::size_t block, unsigned int seed, bool gaussian, NumericT * values)
+      {
+        unsigned int ctr[4] = {static_cast<unsigned int>(block & 0xFFFFFFFFu), static_cast<unsigned int>((block >> 16) >> 16), 0, 0}; //two shifts, as std::size_t may have 32 bits
+        philox4x32(ctr, seed, 0);
+
+        std::size_t num_values = philox_to_uniform(ctr, values);
+
+        if (gaussian)
+        {
+          for (std::size_t i=0; i<num_values; i += 2)
+          {
+            NumericT r     = std::sqrt(NumericT(-2) * std::log(values[i]));
+            NumericT theta = NumericT(6.283185307179586476925) * values[i+1];
+            values[i]   = r * std::cos(theta);
+            values[i+1] = r * std::sin(theta);
+          }
+        }
+
+        return num_values;
+      }
+
+    } //namespace detail
+
+  }
+}
 
 #endif
@@ -0,0 +1,795 @@
+#ifndef VIENNACL_SCHEDULER_COMPILED_STATEMENT_HPP
+#define VIENNACL_SCHEDULER_COMPILED_STATEMENT_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/scheduler/compiled_statement.hpp
+    @brief Provides a statement which is analyzed once and then executed repeatedly without walking the expression tree again.
+
+    The expression tree is lowered into a flat sequence of steps, each of which maps to a single call of a backend routine.
+    Temporaries are allocated when the statement is compiled and reused for all executions.
+*/
+
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/scheduler/forwards.h"
+#include "viennacl/scheduler/execute.hpp"
+
+namespace viennacl
+{
+  namespace scheduler
+  {
+
+    /** @brief Kinds of steps of a compiled statement */
+    enum compiled_step_type
+    {
+      COMPILED_AX_STEP = 0,           // x1 = alpha * x2
+      COMPILED_AXBX_STEP,             // x1 = alpha * x2 + beta * x3
+      COMPILED_AXBX_X_STEP,           // x1 += alpha * x2 + beta * x3
+      COMPILED_INNER_PROD_STEP,       // x1 = inner_prod(x2, x3)
+      COMPILED_NORM_STEP,             // x1 = norm(x2)
+      COMPILED_ELEMENT_UNARY_STEP,    // x1 = op(x2)
+      COMPILED_ELEMENT_BINARY_STEP,   // x1 = op(x2, x3)
+      COMPILED_MAT_VEC_PROD_STEP,     // x1 = prod(x2, x3), where x2 might be a transposed matrix
+      COMPILED_MAT_MAT_PROD_STEP,     // x1 = alpha * prod(x2, x3) + beta * x1
+      COMPILED_FUSED_STEP             // x1 {=, +=, -=} element-wise expression in a single pass, cf. execute_fused()
+    };
+
+    /** @brief A single step of a compiled statement. Operands are referred to by their index in the operand table of the compiled statement. */
+    struct compiled_step
+    {
+      compiled_step() : type(COMPILED_AX_STEP), op(OPERATION_BINARY_ASSIGN_TYPE), x1(0), x2(0), x3(0),
+                        alpha(no_operand), beta(no_operand), alpha_value(1.0), beta_value(1.0),
+                        reciprocal_alpha(false), flip_sign_alpha(false), reciprocal_beta(false), flip_sign_beta(false),
+                        node_index(0), program(no_operand) {}
+
+      /** @brief Marks alpha and beta as constants given by alpha_value and beta_value */
+      static const std::size_t no_operand = static_cast<std::size_t>(-1);
+
+      compiled_step_type  type;
+      operation_node_type op;          //assignment, element-wise operation, or norm
+      std::size_t x1, x2, x3;
+      std::size_t alpha, beta;         //operand index of a scalar, or no_operand
+      double      alpha_value, beta_value;
+      bool reciprocal_alpha, flip_sign_alpha;
+      bool reciprocal_beta,  flip_sign_beta;
+      std::size_t node_index;          //root of the subexpression of a fused step
+      std::size_t program;             //host program of a fused step built at compilation, or no_operand
+    };
+
+
+    /** @brief A statement analyzed once, which can then be executed many times at low overhead.
+    *
+    * Operands are bound by pointer as in the statement, hence changes to the vectors and matrices are seen by later executions.
+    * Host scalars are stored by value. rebind() takes the operands from a statement with the same structure,
+    * which only copies the leaves as long as the sizes of all vectors and matrices remain the same.
+    *
+    * Usage:
+    *   compiled_statement cs(statement(x, op_assign(), alpha * y + beta * z));
+    *   for (...) { cs.rebind(statement(x, op_assign(), alpha * y + beta * z)); cs.execute(); }
+    *
+    * Element-wise expressions evaluated in a single pass on the host are compiled into a program once, cf. execute_fused().
+    * Later executions only refresh the data pointers and scalar values of the program.
+    */
+    class compiled_statement
+    {
+        struct binding
+        {
+          std::size_t operand;
+          std::size_t node_index;
+          bool        is_lhs;
+          std::size_t size1, size2;   //size of the operand when compiled, zero for scalars
+        };
+
+        struct term
+        {
+          std::size_t operand;
+          std::size_t alpha;
+          bool        reciprocal;
+        };
+
+        template <typename NumericT>
+        struct fused_program
+        {
+          viennacl::linalg::host_based::fused_elementwise_program<NumericT> program;
+          std::vector<detail::fused_operand_source>                         sources;
+        };
+
+      public:
+        compiled_statement(statement const & s) : statement_(s), uses_statement_(false) { compile(); }
+
+        ~compiled_statement() { clear(); }
+
+        /** @brief Executes the statement */
+        void execute()
+        {
+          for (std::size_t i=0; i<steps_.size(); ++i)
+            execute_step(steps_[i]);
+        }
+
+        /** @brief Takes the operands from the supplied statement. The statement is recompiled if its structure or the sizes of its operands differ. */
+        void rebind(statement const & s)
+        {
+          statement::container_type const & expr = s.array();
+          bool same_sizes = has_same_structure(s);
+          for (std::size_t i=0; i<bindings_.size() && same_sizes; ++i)
+          {
+            statement_node const & node = expr[bindings_[i].node_index];
+            lhs_rhs_element const & e = bindings_[i].is_lhs ? node.lhs : node.rhs;
+            std::size_t size1, size2;
+            get_size(e, size1, size2);
+            same_sizes = (size1 == bindings_[i].size1 && size2 == bindings_[i].size2);
+            operands_[bindings_[i].operand] = e;
+          }
+
+          if (!same_sizes)
+          {
+            clear();
+            statement_ = s;
+            compile();
+          }
+          else if (uses_statement_) // matrix products of transposed matrices and fused steps take their operands from the statement
+          {
+            statement_ = s;
+            for (std::size_t i=0; i<steps_.size(); ++i)
+              if (steps_[i].type == COMPILED_FUSED_STEP)
+                rebind_fused_program(steps_[i]);
+          }
+        }
+
+        /** @brief Number of backend calls per execution */
+        std::size_t num_steps() const { return steps_.size(); }
+
+        /** @brief Number of temporaries allocated for the statement */
+        std::size_t num_temporaries() const { return temporaries_.size(); }
+
+      private:
+        compiled_statement(compiled_statement const &);
+        compiled_statement & operator=(compiled_statement const &);
+
+        lhs_rhs_element const & element(std::size_t node_index, bool is_lhs) const
+        {
+          statement_node const & node = statement_.array()[node_index];
+          return is_lhs ? node.lhs : node.rhs;
+        }
+
+        //
+        // Operand management
+        //
+
+        std::size_t add_operand(std::size_t node_index, bool is_lhs)
+        {
+          binding b;
+          b.operand    = operands_.size();
+          b.node_index = node_index;
+          b.is_lhs     = is_lhs;
+          get_size(element(node_index, is_lhs), b.size1, b.size2);
+          bindings_.push_back(b);
+          operands_.push_back(element(node_index, is_lhs));
+          return b.operand;
+        }
+
+        /** @brief Allocates a temporary of the type and size of the supplied element */
+        std::size_t add_temporary(lhs_rhs_element const & like)
+        {
+          lhs_rhs_element temp;
+          detail::new_element(temp, like);
+          temporaries_.push_back(operands_.size());
+          operands_.push_back(temp);
+          return operands_.size() - 1;
+        }
+
+        std::size_t add_scalar_temporary(statement_node_numeric_type numeric_type)
+        {
+          lhs_rhs_element temp;
+          temp.type_family  = SCALAR_TYPE_FAMILY;
+          temp.subtype      = DEVICE_SCALAR_TYPE;
+          temp.numeric_type = numeric_type;
+          return add_temporary(temp);
+        }
+
+        void clear()
+        {
+          for (std::size_t i=0; i<temporaries_.size(); ++i)
+            detail::delete_element(operands_[temporaries_[i]]);
+          temporaries_.clear();
+          operands_.clear();
+          bindings_.clear();
+          steps_.clear();
+          fused_float_.clear();
+          fused_double_.clear();
+          uses_statement_ = false;
+        }
+
+        //
+        // Structural comparison for rebinding
+        //
+
+        static bool get_size(lhs_rhs_element const & e, std::size_t & size1, std::size_t & size2)
+        {
+          size1 = size2 = 0;
+          if (e.type_family == VECTOR_TYPE_FAMILY && e.subtype == DENSE_VECTOR_TYPE)
+          {
+            switch (e.numeric_type)
+            {
+              case FLOAT_TYPE:  size1 = e.vector_float->size();  return true;
+              case DOUBLE_TYPE: size1 = e.vector_double->size(); return true;
+              default: return false;
+            }
+          }
+          if (e.type_family == MATRIX_TYPE_FAMILY && e.subtype == DENSE_ROW_MATRIX_TYPE)
+          {
+            switch (e.numeric_type)
+            {
+              case FLOAT_TYPE:  size1 = e.matrix_row_float->size1();  size2 = e.matrix_row_float->size2();  return true;
+              case DOUBLE_TYPE: size1 = e.matrix_row_double->size1(); size2 = e.matrix_row_double->size2(); return true;
+              default: return false;
+            }
+          }
+          if (e.type_family == MATRIX_TYPE_FAMILY && e.subtype == DENSE_COL_MATRIX_TYPE)
+          {
+            switch (e.numeric_type)
+            {
+              case FLOAT_TYPE:  size1 = e.matrix_col_float->size1();  size2 = e.matrix_col_float->size2();  return true;
+              case DOUBLE_TYPE: size1 = e.matrix_col_double->size1(); size2 = e.matrix_col_double->size2(); return true;
+              default: return false;
+            }
+          }
+          return false;
+        }
+
+        static bool is_compatible(lhs_rhs_element const & a, lhs_rhs_element const & b)
+        {
+          if (a.type_family != b.type_family || a.subtype != b.subtype || a.numeric_type != b.numeric_type)
+            return false;
+          if (a.type_family == COMPOSITE_OPERATION_FAMILY)
+            return a.node_index == b.node_index;
+          return true;
+        }
+
+        /** @brief Compares the node types with the ones of the compiled statement. Only types are read from statement_, as its operands may no longer exist. */
+        bool has_same_structure(statement const & s) const
+        {
+          statement::container_type const & expr = statement_.array();
+          statement::container_type const & other = s.array();
+          if (expr.size() != other.size())
+            return false;
+
+          for (std::size_t i=0; i<expr.size(); ++i)
+          {
+            if (   expr[i].op.type_family != other[i].op.type_family
+                || expr[i].op.type        != other[i].op.type
+                || !is_compatible(expr[i].lhs, other[i].lhs)
+                || !is_compatible(expr[i].rhs, other[i].rhs))
+              return false;
+          }
+          return true;
+        }
+
+        //
+        // Lowering of the expression tree into steps. The decomposition follows the one of execute().
+        //
+
+        void compile()
+        {
+          statement_node const & root_node = statement_.array()[statement_.root()];
+
+          if (   root_node.lhs.type_family != SCALAR_TYPE_FAMILY
+              && root_node.lhs.type_family != VECTOR_TYPE_FAMILY
+              && root_node.lhs.type_family != MATRIX_TYPE_FAMILY)
+            throw statement_not_supported_exception("Unsupported lvalue encountered in head node.");
+
+          std::size_t result = add_operand(statement_.root(), true);
+          switch (root_node.rhs.type_family)
+          {
+            case COMPOSITE_OPERATION_FAMILY:
+              compile_composite(result, root_node.op.type, root_node.rhs.node_index);
+              break;
+            case SCALAR_TYPE_FAMILY:
+            case VECTOR_TYPE_FAMILY:
+            case MATRIX_TYPE_FAMILY:
+              compile_copy(result, root_node.op.type, add_operand(statement_.root(), false));
+              break;
+            default:
+              throw statement_not_supported_exception("Invalid rvalue encountered in vector assignment");
+          }
+        }
+
+        /** @brief result {=, +=, -=} x */
+        void compile_copy(std::size_t result, operation_node_type assign_op, std::size_t x)
+        {
+          compiled_step step;
+          step.x1 = result;
+          switch (assign_op)
+          {
+            case OPERATION_BINARY_ASSIGN_TYPE:
+              step.type = COMPILED_AX_STEP;
+              step.x2   = x;
+              break;
+            case OPERATION_BINARY_INPLACE_ADD_TYPE:
+            case OPERATION_BINARY_INPLACE_SUB_TYPE:
+              step.type = COMPILED_AXBX_STEP;
+              step.x2   = result;
+              step.x3   = x;
+              step.flip_sign_beta = (assign_op == OPERATION_BINARY_INPLACE_SUB_TYPE);
+              break;
+            default:
+              throw statement_not_supported_exception("Unsupported binary operator for operation in root note (should be =, +=, or -=)");
+          }
+          steps_.push_back(step);
+        }
+
+        /** @brief Returns true if execute_fused() takes care of the statement result {=, +=, -=} expr[node_index] */
+        bool is_fused(std::size_t result, operation_node_type assign_op, std::size_t node_index) const
+        {
+          lhs_rhs_element const & x = operands_[result];
+          if (   (x.type_family != VECTOR_TYPE_FAMILY && x.type_family != MATRIX_TYPE_FAMILY)
+              || (x.numeric_type != FLOAT_TYPE && x.numeric_type != DOUBLE_TYPE)
+              || (   assign_op != OPERATION_BINARY_ASSIGN_TYPE
+                  && assign_op != OPERATION_BINARY_INPLACE_ADD_TYPE
+                  && assign_op != OPERATION_BINARY_INPLACE_SUB_TYPE))
+            return false;
+
+          statement_node const & leaf = statement_.array()[node_index];
+          return detail::is_fusable_operation(leaf.op.type) && detail::needs_temporaries(statement_, leaf);
+        }
+
+        /** @brief result {=, +=, -=} expr[node_index] */
+        void compile_composite(std::size_t result, operation_node_type assign_op, std::size_t node_index)
+        {
+          statement_node const & leaf = statement_.array()[node_index];
+
+          if (is_fused(result, assign_op, node_index))
+          {
+            compiled_step step;
+            step.type       = COMPILED_FUSED_STEP;
+            step.op         = assign_op;
+            step.x1         = result;
+            step.node_index = node_index;
+            build_fused_program(step);
+            steps_.push_back(step);
+            uses_statement_ = true;
+          }
+          else if (leaf.op.type == OPERATION_BINARY_ADD_TYPE || leaf.op.type == OPERATION_BINARY_SUB_TYPE)
+            compile_axbx(result, assign_op, node_index);
+          else if (leaf.op.type == OPERATION_BINARY_MULT_TYPE || leaf.op.type == OPERATION_BINARY_DIV_TYPE)
+            compile_scaling(result, assign_op, node_index);
+          else if (   leaf.op.type == OPERATION_BINARY_INNER_PROD_TYPE
+                   || leaf.op.type == OPERATION_UNARY_NORM_1_TYPE
+                   || leaf.op.type == OPERATION_UNARY_NORM_2_TYPE
+                   || leaf.op.type == OPERATION_UNARY_NORM_INF_TYPE)
+            compile_scalar_reduction(result, assign_op, node_index);
+          else if (   (leaf.op.type_family == OPERATION_UNARY_TYPE_FAMILY && leaf.op.type != OPERATION_UNARY_TRANS_TYPE)
+                   || leaf.op.type == OPERATION_BINARY_ELEMENT_PROD_TYPE
+                   || leaf.op.type == OPERATION_BINARY_ELEMENT_DIV_TYPE)
+            compile_elementwise(result, assign_op, node_index);
+          else if (   leaf.op.type == OPERATION_BINARY_MAT_VEC_PROD_TYPE
+                   || leaf.op.type == OPERATION_BINARY_MAT_MAT_PROD_TYPE)
+            compile_matrix_prod(result, assign_op, node_index);
+          else
+            throw statement_not_supported_exception("Unsupported binary operator");
+        }
+
+        /** @brief Returns the operand holding the element, evaluating a subexpression into a temporary of the type of 'like' if necessary */
+        std::size_t compile_operand(std::size_t node_index, bool is_lhs, lhs_rhs_element const & like)
+        {
+          lhs_rhs_element const & e = element(node_index, is_lhs);
+          if (e.type_family != COMPOSITE_OPERATION_FAMILY)
+            return add_operand(node_index, is_lhs);
+
+          std::size_t temp = add_temporary(like);
+          compile_composite(temp, OPERATION_BINARY_ASSIGN_TYPE, e.node_index);
+          return temp;
+        }
+
+        /** @brief Decomposes an operand of x = y +- z into a scaled vector or matrix alpha * v, if possible without temporaries */
+        term compile_term(std::size_t result, std::size_t node_index, bool is_lhs)
+        {
+          lhs_rhs_element const & e = element(node_index, is_lhs);
+
+          term t;
+          t.alpha      = compiled_step::no_operand;
+          t.reciprocal = false;
+          if (e.type_family == COMPOSITE_OPERATION_FAMILY)
+          {
+            statement_node const & child = statement_.array()[e.node_index];
+            if (   (child.op.type == OPERATION_BINARY_MULT_TYPE || child.op.type == OPERATION_BINARY_DIV_TYPE)
+                &&  child.lhs.type_family != COMPOSITE_OPERATION_FAMILY
+                &&  child.rhs.type_family == SCALAR_TYPE_FAMILY)
+            {
+              t.operand    = add_operand(e.node_index, true);
+              t.alpha      = add_operand(e.node_index, false);
+              t.reciprocal = (child.op.type == OPERATION_BINARY_DIV_TYPE);
+              return t;
+            }
+          }
+
+          // temporary of the type of the result, as in execute_axbx():
+          lhs_rhs_element like = operands_[result];
+          t.operand = compile_operand(node_index, is_lhs, like);
+          return t;
+        }
+
+        void compile_axbx(std::size_t result, operation_node_type assign_op, std::size_t node_index)
+        {
+          bool flip_sign_z = (statement_.array()[node_index].op.type == OPERATION_BINARY_SUB_TYPE);
+
+          term y = compile_term(result, node_index, true);
+          term z = compile_term(result, node_index, false);
+
+          compiled_step step;
+          step.x1 = result;
+          step.x2 = y.operand;
+          step.x3 = z.operand;
+          step.alpha = y.alpha;
+          step.beta  = z.alpha;
+          step.reciprocal_alpha = y.reciprocal;
+          step.reciprocal_beta  = z.reciprocal;
+          switch (assign_op)
+          {
+            case OPERATION_BINARY_ASSIGN_TYPE:
+              step.type = COMPILED_AXBX_STEP;
+              step.flip_sign_beta = flip_sign_z;
+              break;
+            case OPERATION_BINARY_INPLACE_ADD_TYPE:
+              step.type = COMPILED_AXBX_X_STEP;
+              step.flip_sign_beta = flip_sign_z;
+              break;
+            case OPERATION_BINARY_INPLACE_SUB_TYPE:
+              step.type = COMPILED_AXBX_X_STEP;
+              step.flip_sign_alpha = true;
+              step.flip_sign_beta  = !flip_sign_z;
+              break;
+            default:
+              throw statement_not_supported_exception("Unsupported binary operator for operation in root note (should be =, +=, or -=)");
+          }
+          steps_.push_back(step);
+        }
+
+        /** @brief x = (y) * alpha or x = (y) / alpha */
+        void compile_scaling(std::size_t result, operation_node_type assign_op, std::size_t node_index)
+        {
+          statement_node const & leaf = statement_.array()[node_index];
+
+          std::size_t alpha;
+          if (leaf.rhs.type_family == SCALAR_TYPE_FAMILY)
+            alpha = add_operand(node_index, false);
+          else if (leaf.rhs.type_family == COMPOSITE_OPERATION_FAMILY)
+          {
+            alpha = add_scalar_temporary(operands_[result].numeric_type);
+            compile_composite(alpha, OPERATION_BINARY_ASSIGN_TYPE, leaf.rhs.node_index);
+          }
+          else
+            throw statement_not_supported_exception("Unsupported binary operator for OPERATION_BINARY_MULT_TYPE || OPERATION_BINARY_DIV_TYPE on leaf node.");
+
+          lhs_rhs_element like = operands_[result];
+          std::size_t y = compile_operand(node_index, true, like);
+
+          compiled_step step;
+          step.x1 = result;
+          if (assign_op == OPERATION_BINARY_ASSIGN_TYPE)
+          {
+            step.type  = COMPILED_AX_STEP;
+            step.x2    = y;
+            step.alpha = alpha;
+            step.reciprocal_alpha = (leaf.op.type == OPERATION_BINARY_DIV_TYPE);
+          }
+          else if (assign_op == OPERATION_BINARY_INPLACE_ADD_TYPE || assign_op == OPERATION_BINARY_INPLACE_SUB_TYPE)
+          {
+            step.type = COMPILED_AXBX_STEP;
+            step.x2   = result;
+            step.x3   = y;
+            step.beta = alpha;
+            step.reciprocal_beta = (leaf.op.type == OPERATION_BINARY_DIV_TYPE);
+            step.flip_sign_beta  = (assign_op == OPERATION_BINARY_INPLACE_SUB_TYPE);
+          }
+          else
+            throw statement_not_supported_exception("Unsupported binary operator for vector operation in root note (should be =, +=, or -=)");
+          steps_.push_back(step);
+        }
+
+        /** @brief alpha = inner_prod(x, y) or alpha = norm(x) */
+        void compile_scalar_reduction(std::size_t result, operation_node_type assign_op, std::size_t node_index)
+        {
+          statement_node const & leaf = statement_.array()[node_index];
+
+          if (operands_[result].type_family != SCALAR_TYPE_FAMILY)
+            throw statement_not_supported_exception("Inner products and norms require assignment to a scalar");
+
+          std::size_t target = result;
+          if (assign_op != OPERATION_BINARY_ASSIGN_TYPE)
+            target = add_scalar_temporary(operands_[result].numeric_type);
+
+          compiled_step step;
+          step.x1 = target;
+          step.op = leaf.op.type;
+
+          lhs_rhs_element like_x = detail::extract_representative_vector(statement_, leaf.lhs);
+          step.x2 = compile_operand(node_index, true, like_x);
+          if (leaf.op.type == OPERATION_BINARY_INNER_PROD_TYPE)
+          {
+            lhs_rhs_element like_y = detail::extract_representative_vector(statement_, leaf.rhs);
+            step.type = COMPILED_INNER_PROD_STEP;
+            step.x3   = compile_operand(node_index, false, like_y);
+          }
+          else
+            step.type = COMPILED_NORM_STEP;
+          steps_.push_back(step);
+
+          if (target != result)
+            compile_copy(result, assign_op, target);
+        }
+
+        void compile_elementwise(std::size_t result, operation_node_type assign_op, std::size_t node_index)
+        {
+          statement_node const & leaf = statement_.array()[node_index];
+
+          lhs_rhs_element like = operands_[result];
+          std::size_t target = (assign_op == OPERATION_BINARY_ASSIGN_TYPE) ? result : add_temporary(like);
+
+          compiled_step step;
+          step.x1 = target;
+          step.op = leaf.op.type;
+          step.x2 = compile_operand(node_index, true, like);
+          if (leaf.op.type == OPERATION_BINARY_ELEMENT_PROD_TYPE || leaf.op.type == OPERATION_BINARY_ELEMENT_DIV_TYPE)
+          {
+            step.type = COMPILED_ELEMENT_BINARY_STEP;
+            step.x3   = compile_operand(node_index, false, like);
+          }
+          else if (leaf.op.type_family == OPERATION_UNARY_TYPE_FAMILY)
+            step.type = COMPILED_ELEMENT_UNARY_STEP;
+          else
+            throw statement_not_supported_exception("Unsupported elementwise operation.");
+          steps_.push_back(step);
+
+          if (target != result)
+            compile_copy(result, assign_op, target);
+        }
+
+        void compile_matrix_prod(std::size_t result, operation_node_type assign_op, std::size_t node_index)
+        {
+          statement_node const & leaf = statement_.array()[node_index];
+
+          // transposed matrices are passed on as they are, all other subexpressions go to temporaries of the type of the result as in execute_matrix_prod():
+          lhs_rhs_element like = operands_[result];
+          std::size_t x = detail::matrix_prod_temporary_required(statement_, leaf.lhs) ? compile_operand(node_index, true,  like) : add_operand(node_index, true);
+          std::size_t y = detail::matrix_prod_temporary_required(statement_, leaf.rhs) ? compile_operand(node_index, false, like) : add_operand(node_index, false);
+
+          compiled_step step;
+          step.x2 = x;
+          step.x3 = y;
+          if (operands_[result].type_family == VECTOR_TYPE_FAMILY)
+          {
+            std::size_t target = (assign_op == OPERATION_BINARY_ASSIGN_TYPE) ? result : add_temporary(like);
+            step.type = COMPILED_MAT_VEC_PROD_STEP;
+            step.x1   = target;
+            steps_.push_back(step);
+            uses_statement_ = true;
+
+            if (target != result)
+              compile_copy(result, assign_op, target);
+          }
+          else
+          {
+            if (   assign_op != OPERATION_BINARY_ASSIGN_TYPE
+                && assign_op != OPERATION_BINARY_INPLACE_ADD_TYPE
+                && assign_op != OPERATION_BINARY_INPLACE_SUB_TYPE)
+              throw statement_not_supported_exception("Invalid assignment type for matrix-matrix product");
+
+            step.type = COMPILED_MAT_MAT_PROD_STEP;
+            step.x1   = result;
+            step.alpha_value = (assign_op == OPERATION_BINARY_INPLACE_SUB_TYPE) ? -1.0 : 1.0;
+            step.beta_value  = (assign_op != OPERATION_BINARY_ASSIGN_TYPE)      ?  1.0 : 0.0;
+            steps_.push_back(step);
+            uses_statement_ = true;
+          }
+        }
+
+        //
+        // Fused steps
+        //
+
+        std::vector<fused_program<float> >  & fused_programs(float)  { return fused_float_; }
+        std::vector<fused_program<double> > & fused_programs(double) { return fused_double_; }
+
+        /** @brief The root node result {=, +=, -=} expr[node_index] of a fused step */
+        statement_node fused_root_node(compiled_step const & step) const
+        {
+          statement_node root_node;
+          root_node.lhs = operands_[step.x1];
+          root_node.op.type_family = OPERATION_BINARY_TYPE_FAMILY;
+          root_node.op.type        = step.op;
+          root_node.rhs.type_family  = COMPOSITE_OPERATION_FAMILY;
+          root_node.rhs.subtype      = INVALID_SUBTYPE;
+          root_node.rhs.numeric_type = INVALID_NUMERIC_TYPE;
+          root_node.rhs.node_index   = step.node_index;
+          return root_node;
+        }
+
+        /** @brief Builds the host program of a fused step, reusing the program slot of the step if available. Operands in other memory domains or with different layouts are left to execute_fused(). */
+        template <typename NumericT>
+        void build_fused_program_impl(compiled_step & step)
+        {
+#ifdef VIENNACL_WITH_HOST_JIT
+          (void)step; // compiled kernels are looked up in the program cache by execute_fused()
+#else
+          statement_node root_node = fused_root_node(step);
+          detail::fused_elementwise_builder<NumericT> builder(statement_, root_node.lhs);
+          if (!builder.build(step.op, root_node.rhs) || builder.memory() != viennacl::MAIN_MEMORY)
+          {
+            step.program = compiled_step::no_operand;
+            return;
+          }
+
+          std::vector<fused_program<NumericT> > & programs = fused_programs(NumericT());
+          if (step.program == compiled_step::no_operand)
+          {
+            step.program = programs.size();
+            programs.push_back(fused_program<NumericT>());
+          }
+          programs[step.program].program = builder.program();
+          programs[step.program].sources = builder.sources();
+#endif
+        }
+
+        void build_fused_program(compiled_step & step)
+        {
+          if (operands_[step.x1].numeric_type == FLOAT_TYPE)
+            build_fused_program_impl<float>(step);
+          else
+            build_fused_program_impl<double>(step);
+        }
+
+        /** @brief Points the program of a fused step to the operands of the new statement. The program is only built again if the layout of an operand changed. */
+        template <typename NumericT>
+        void rebind_fused_program_impl(compiled_step & step)
+        {
+          if (step.program != compiled_step::no_operand)
+          {
+            fused_program<NumericT> & p = fused_programs(NumericT())[step.program];
+            statement_node root_node = fused_root_node(step);
+            detail::fused_elementwise_builder<NumericT> builder(statement_, root_node.lhs);
+            if (builder.bind(p.program, p.sources))
+              return;
+          }
+          build_fused_program_impl<NumericT>(step);
+        }
+
+        void rebind_fused_program(compiled_step & step)
+        {
+          if (operands_[step.x1].numeric_type == FLOAT_TYPE)
+            rebind_fused_program_impl<float>(step);
+          else
+            rebind_fused_program_impl<double>(step);
+        }
+
+        template <typename NumericT>
+        void execute_fused_program(compiled_step const & step)
+        {
+          fused_program<NumericT> & p = fused_programs(NumericT())[step.program];
+          detail::fused_elementwise_builder<NumericT>::update(statement_, operands_[step.x1], p.program, p.sources);
+          viennacl::linalg::host_based::fused_elementwise(p.program);
+        }
+
+        //
+        // Execution
+        //
+
+        template <typename ScalarType1>
+        void execute_axbx(compiled_step const & step, ScalarType1 const & alpha)
+        {
+          lhs_rhs_element & x1 = operands_[step.x1];
+          lhs_rhs_element const & x2 = operands_[step.x2];
+          lhs_rhs_element const & x3 = operands_[step.x3];
+          bool inplace = (step.type == COMPILED_AXBX_X_STEP);
+
+          if (step.beta == compiled_step::no_operand)
+          {
+            if (inplace)
+              detail::axbx_x(x1, x2, alpha, 1, step.reciprocal_alpha, step.flip_sign_alpha, x3, step.beta_value, 1, step.reciprocal_beta, step.flip_sign_beta);
+            else
+              detail::axbx  (x1, x2, alpha, 1, step.reciprocal_alpha, step.flip_sign_alpha, x3, step.beta_value, 1, step.reciprocal_beta, step.flip_sign_beta);
+          }
+          else
+          {
+            lhs_rhs_element const & beta = operands_[step.beta];
+            if (inplace)
+              detail::axbx_x(x1, x2, alpha, 1, step.reciprocal_alpha, step.flip_sign_alpha, x3, beta, 1, step.reciprocal_beta, step.flip_sign_beta);
+            else
+              detail::axbx  (x1, x2, alpha, 1, step.reciprocal_alpha, step.flip_sign_alpha, x3, beta, 1, step.reciprocal_beta, step.flip_sign_beta);
+          }
+        }
+
+        void execute_step(compiled_step const & step)
+        {
+          switch (step.type)
+          {
+            case COMPILED_AX_STEP:
+              if (step.alpha == compiled_step::no_operand)
+                detail::ax(operands_[step.x1], operands_[step.x2], step.alpha_value, 1, step.reciprocal_alpha, step.flip_sign_alpha);
+              else
+                detail::ax(operands_[step.x1], operands_[step.x2], operands_[step.alpha], 1, step.reciprocal_alpha, step.flip_sign_alpha);
+              break;
+            case COMPILED_AXBX_STEP:
+            case COMPILED_AXBX_X_STEP:
+              if (step.alpha == compiled_step::no_operand)
+                execute_axbx(step, step.alpha_value);
+              else
+                execute_axbx(step, operands_[step.alpha]);
+              break;
+            case COMPILED_INNER_PROD_STEP:
+              detail::inner_prod_impl(operands_[step.x2], operands_[step.x3], operands_[step.x1]);
+              break;
+            case COMPILED_NORM_STEP:
+              detail::norm_impl(operands_[step.x2], operands_[step.x1], step.op);
+              break;
+            case COMPILED_ELEMENT_UNARY_STEP:
+              detail::element_op(operands_[step.x1], operands_[step.x2], step.op);
+              break;
+            case COMPILED_ELEMENT_BINARY_STEP:
+              detail::element_op(operands_[step.x1], operands_[step.x2], operands_[step.x3], step.op);
+              break;
+            case COMPILED_MAT_VEC_PROD_STEP:
+              detail::matrix_vector_prod(statement_, operands_[step.x1], operands_[step.x2], operands_[step.x3]);
+              break;
+            case COMPILED_MAT_MAT_PROD_STEP:
+              detail::matrix_matrix_prod(statement_, operands_[step.x1], operands_[step.x2], operands_[step.x3], step.alpha_value, step.beta_value);
+              break;
+            case COMPILED_FUSED_STEP:
+              if (step.program != compiled_step::no_operand)
+              {
+                if (operands_[step.x1].numeric_type == FLOAT_TYPE)
+                  execute_fused_program<float>(step);
+                else
+                  execute_fused_program<double>(step);
+              }
+              else
+              {
+                statement_node root_node = fused_root_node(step);
+                if (!detail::execute_fused(statement_, root_node)) // operands with different layouts, recursive evaluation as in execute():
+                  detail::execute_composite(statement_, root_node);
+              }
+              break;
+            default:
+              throw statement_not_supported_exception("Invalid step in compiled statement");
+          }
+        }
+
+        statement                    statement_;
+        std::vector<lhs_rhs_element> operands_;
+        std::vector<binding>         bindings_;
+        std::vector<std::size_t>     temporaries_;
+        std::vector<compiled_step>   steps_;
+        std::vector<fused_program<float> >  fused_float_;
+        std::vector<fused_program<double> > fused_double_;
+        bool                         uses_statement_;
+    };
+
+    /** @brief Executes a compiled statement */
+    inline void execute(compiled_statement & s)
+    {
+      s.execute();
+    }
+
+  }
+
+} //namespace viennacl
+
+#endif
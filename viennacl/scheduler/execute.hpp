@@ -30,6 +30,7 @@
 #include "viennacl/scheduler/execute_axbx.hpp"
 #include "viennacl/scheduler/execute_elementwise.hpp"
 #include "viennacl/scheduler/execute_matrix_prod.hpp"
+#include "viennacl/scheduler/execute_fused.hpp"
 
 namespace viennacl
 {
@@ -44,6 +45,9 @@ namespace viennacl
 
         statement_node const & leaf = expr[root_node.rhs.node_index];
 
+        if (execute_fused(s, root_node)) // element-wise expressions which would otherwise require temporaries
+          return;
+
         if (leaf.op.type  == OPERATION_BINARY_ADD_TYPE || leaf.op.type  == OPERATION_BINARY_SUB_TYPE) // x = (y) +- (z)  where y and z are either data objects or expressions
         {
           execute_axbx(s, root_node);
@@ -0,0 +1,489 @@
+#ifndef VIENNACL_SCHEDULER_EXECUTE_FUSED_HPP
+#define VIENNACL_SCHEDULER_EXECUTE_FUSED_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/scheduler/execute_fused.hpp
+    @brief Single-pass evaluation of element-wise expression trees such as 'x = a*y + b*z - c*element_prod(u, v) + element_exp(w);'
+
+    Such statements would otherwise be evaluated recursively with a full-size temporary for each subexpression.
+    On the host, the tree is compiled into a program of element-wise instructions evaluated blockwise in a single loop.
+    If VIENNACL_WITH_HOST_JIT is defined, a C++ kernel is generated and compiled at runtime instead, cf. viennacl/generator/host_generate.hpp.
+    With OpenCL, a single kernel is created by the kernel generator.
+*/
+
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/scheduler/forwards.h"
+#include "viennacl/scheduler/execute_util.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/fused_elementwise_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/generator/generate.hpp"
+#endif
+
+#ifdef VIENNACL_WITH_HOST_JIT
+  #include "viennacl/generator/host_generate.hpp"
+#endif
+
+namespace viennacl
+{
+  namespace scheduler
+  {
+    namespace detail
+    {
+      /** @brief Returns true if the operation is applied entry by entry */
+      inline bool is_fusable_operation(operation_node_type op_type)
+      {
+        switch (op_type)
+        {
+          case OPERATION_BINARY_ADD_TYPE:
+          case OPERATION_BINARY_SUB_TYPE:
+          case OPERATION_BINARY_MULT_TYPE:
+          case OPERATION_BINARY_DIV_TYPE:
+          case OPERATION_BINARY_ELEMENT_PROD_TYPE:
+          case OPERATION_BINARY_ELEMENT_DIV_TYPE:
+          case OPERATION_UNARY_ABS_TYPE:
+          case OPERATION_UNARY_ACOS_TYPE:
+          case OPERATION_UNARY_ASIN_TYPE:
+          case OPERATION_UNARY_ATAN_TYPE:
+          case OPERATION_UNARY_CEIL_TYPE:
+          case OPERATION_UNARY_COS_TYPE:
+          case OPERATION_UNARY_COSH_TYPE:
+          case OPERATION_UNARY_EXP_TYPE:
+          case OPERATION_UNARY_FABS_TYPE:
+          case OPERATION_UNARY_FLOOR_TYPE:
+          case OPERATION_UNARY_LOG_TYPE:
+          case OPERATION_UNARY_LOG10_TYPE:
+          case OPERATION_UNARY_SIN_TYPE:
+          case OPERATION_UNARY_SINH_TYPE:
+          case OPERATION_UNARY_SQRT_TYPE:
+          case OPERATION_UNARY_TAN_TYPE:
+          case OPERATION_UNARY_TANH_TYPE:
+            return true;
+          default:
+            return false;
+        }
+      }
+
+      /** @brief Returns true if the recursive evaluation of the subtree rooted at 'node' introduces temporaries.
+      *
+      * Only x = a*y +- b*z and simpler expressions are mapped to a single kernel directly, cf. execute_axbx().
+      */
+      inline bool needs_temporaries(statement const & s, statement_node const & node)
+      {
+        lhs_rhs_element const * operands[2] = { &node.lhs, &node.rhs };
+        std::size_t num_operands = (node.op.type_family == OPERATION_UNARY_TYPE_FAMILY) ? 1 : 2;
+        for (std::size_t i=0; i<num_operands; ++i)
+        {
+          if (operands[i]->type_family != COMPOSITE_OPERATION_FAMILY)
+            continue;
+
+          statement_node const & child = s.array()[operands[i]->node_index];
+          bool is_scaled_leaf =    (child.op.type == OPERATION_BINARY_MULT_TYPE || child.op.type == OPERATION_BINARY_DIV_TYPE)
+                                && child.lhs.type_family != COMPOSITE_OPERATION_FAMILY
+                                && child.rhs.type_family == SCALAR_TYPE_FAMILY;
+          if (!is_scaled_leaf || (node.op.type != OPERATION_BINARY_ADD_TYPE && node.op.type != OPERATION_BINARY_SUB_TYPE))
+            return true;
+        }
+        return false;
+      }
+
+
+      template <typename NumericT> struct fused_element_accessor;
+
+      template <> struct fused_element_accessor<float>
+      {
+        static viennacl::vector_base<float> & vector(lhs_rhs_element const & e) { return *e.vector_float; }
+        static viennacl::matrix_base<float, viennacl::row_major>    & matrix_row(lhs_rhs_element const & e) { return *e.matrix_row_float; }
+        static viennacl::matrix_base<float, viennacl::column_major> & matrix_col(lhs_rhs_element const & e) { return *e.matrix_col_float; }
+        static float value(lhs_rhs_element const & e) { return convert_to_float(e); }
+      };
+
+      template <> struct fused_element_accessor<double>
+      {
+        static viennacl::vector_base<double> & vector(lhs_rhs_element const & e) { return *e.vector_double; }
+        static viennacl::matrix_base<double, viennacl::row_major>    & matrix_row(lhs_rhs_element const & e) { return *e.matrix_row_double; }
+        static viennacl::matrix_base<double, viennacl::column_major> & matrix_col(lhs_rhs_element const & e) { return *e.matrix_col_double; }
+        static double value(lhs_rhs_element const & e) { return convert_to_double(e); }
+      };
+
+
+      /** @brief Location of a vector, matrix, or scalar operand of a fused program in the statement. Used for binding the program to new operands without building it again. */
+      struct fused_operand_source
+      {
+        std::size_t node_index;
+        bool        is_lhs;
+        bool        is_scalar;
+        std::size_t index;              //leaf for vectors and matrices, instruction for scalars
+        bool        is_instruction_lhs; //scalars: lhs or rhs operand of the instruction
+      };
+
+      /** @brief Checks whether an element-wise expression tree can be fused and compiles it into a program for the host.
+      *
+      * All vector or matrix operands must have the numeric type, the size, the layout and the memory domain of the result.
+      * Scalars may only appear as plain factors or divisors.
+      */
+      template <typename NumericT>
+      class fused_elementwise_builder
+      {
+          typedef viennacl::linalg::host_based::fused_elementwise_program<NumericT>  program_type;
+          typedef fused_element_accessor<NumericT>                                    accessor;
+
+        public:
+          fused_elementwise_builder(statement const & s, lhs_rhs_element const & result)
+            : s_(s), result_(result), memory_type_(memory_type(result)), next_register_(0), max_registers_(0) {}
+
+          /** @brief Builds the program for result OP= rhs. Returns false if the statement cannot be fused. */
+          bool build(operation_node_type assign_op, lhs_rhs_element const & rhs)
+          {
+            if (memory_type_ != viennacl::MAIN_MEMORY && memory_type_ != viennacl::OPENCL_MEMORY)
+              return false;
+
+            if (!describe_leaf(result_, program_.result_offset, program_.result_line_stride, program_.result_stride))
+              return false;
+
+            typename program_type::operand result_operand;
+            if (!compile(rhs, result_operand) || result_operand.type != viennacl::linalg::host_based::FUSED_REGISTER_OPERAND)
+              return false;
+
+            // assign gather buffers for strided operands after the registers:
+            program_.num_buffers = program_.num_buffers + max_registers_;
+            for (std::size_t k=0; k<program_.num_leaves; ++k)
+              if (program_.leaves[k].stride != 1)
+                program_.leaves[k].buffer += max_registers_;
+            if (program_.num_buffers > program_type::max_buffers)
+              return false;
+
+            program_.result_register = result_operand.index;
+            program_.assign_op = assign_op;
+            program_.result_data = (memory_type_ == viennacl::MAIN_MEMORY) ? const_cast<NumericT *>(raw_pointer(result_)) : NULL;
+            return true;
+          }
+
+          program_type const & program() const { return program_; }
+
+          /** @brief Locations of the operands of the program built, cf. bind() */
+          std::vector<fused_operand_source> const & sources() const { return sources_; }
+
+          viennacl::memory_types memory() const { return memory_type_; }
+
+          /** @brief Points a host program built for a statement of the same structure to the operands of the statement supplied to the constructor.
+          *
+          * @return false if the layout of an operand differs from the one the program was built for, in which case the program has to be built again.
+          */
+          bool bind(program_type & program, std::vector<fused_operand_source> const & sources)
+          {
+            if (memory_type_ != viennacl::MAIN_MEMORY)
+              return false;
+
+            std::size_t offset, line_stride, stride;
+            if (   !describe_leaf(result_, offset, line_stride, stride)
+                || offset != program.result_offset || line_stride != program.result_line_stride || stride != program.result_stride
+                || program_.num_lines != program.num_lines || program_.line_length != program.line_length)
+              return false;
+
+            for (std::size_t i=0; i<sources.size(); ++i)
+            {
+              statement_node const & node = s_.array()[sources[i].node_index];
+              lhs_rhs_element const & e = sources[i].is_lhs ? node.lhs : node.rhs;
+              if (sources[i].is_scalar)
+                continue;
+
+              typename program_type::leaf const & leaf = program.leaves[sources[i].index];
+              if (   !describe_leaf(e, offset, line_stride, stride)
+                  || offset != leaf.offset || line_stride != leaf.line_stride || stride != leaf.stride)
+                return false;
+            }
+
+            update(s_, result_, program, sources);
+            return true;
+          }
+
+          /** @brief Refreshes the data pointers and scalar values of a host program from the operands in the statement.
+          *
+          * Only reads the leaves listed in 'sources', hence much cheaper than building the program.
+          */
+          static void update(statement const & s, lhs_rhs_element const & result, program_type & program, std::vector<fused_operand_source> const & sources)
+          {
+            for (std::size_t i=0; i<sources.size(); ++i)
+            {
+              statement_node const & node = s.array()[sources[i].node_index];
+              lhs_rhs_element const & e = sources[i].is_lhs ? node.lhs : node.rhs;
+              if (sources[i].is_scalar)
+              {
+                typename program_type::instruction & inst = program.instructions[sources[i].index];
+                (sources[i].is_instruction_lhs ? inst.lhs : inst.rhs).value = accessor::value(e);
+              }
+              else
+                program.leaves[sources[i].index].data = raw_pointer(e);
+            }
+            program.result_data = const_cast<NumericT *>(raw_pointer(result));
+          }
+
+        private:
+          static viennacl::memory_types memory_type(lhs_rhs_element const & e)
+          {
+            if (e.type_family == VECTOR_TYPE_FAMILY)
+              return viennacl::traits::active_handle_id(accessor::vector(e));
+            if (e.subtype == DENSE_ROW_MATRIX_TYPE)
+              return viennacl::traits::active_handle_id(accessor::matrix_row(e));
+            return viennacl::traits::active_handle_id(accessor::matrix_col(e));
+          }
+
+          static NumericT const * raw_pointer(lhs_rhs_element const & e)
+          {
+            if (e.type_family == VECTOR_TYPE_FAMILY)
+              return viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(accessor::vector(e));
+            if (e.subtype == DENSE_ROW_MATRIX_TYPE)
+              return viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(accessor::matrix_row(e));
+            return viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(accessor::matrix_col(e));
+          }
+
+          /** @brief Checks that a vector or matrix operand is compatible with the result and computes its line layout */
+          bool describe_leaf(lhs_rhs_element const & e, std::size_t & offset, std::size_t & line_stride, std::size_t & stride)
+          {
+            if (e.type_family != result_.type_family || e.subtype != result_.subtype || e.numeric_type != result_.numeric_type)
+              return false;
+
+            std::size_t num_lines = 1;
+            std::size_t line_length = 0;
+            if (e.subtype == DENSE_VECTOR_TYPE)
+            {
+              viennacl::vector_base<NumericT> const & vec = accessor::vector(e);
+              offset      = viennacl::traits::start(vec);
+              line_stride = 0;
+              stride      = viennacl::traits::stride(vec);
+              line_length = vec.size();
+            }
+            else if (e.subtype == DENSE_ROW_MATRIX_TYPE)
+            {
+              viennacl::matrix_base<NumericT, viennacl::row_major> const & mat = accessor::matrix_row(e);
+              offset      = viennacl::traits::start1(mat) * mat.internal_size2() + viennacl::traits::start2(mat);
+              line_stride = viennacl::traits::stride1(mat) * mat.internal_size2();
+              stride      = viennacl::traits::stride2(mat);
+              num_lines   = mat.size1();
+              line_length = mat.size2();
+            }
+            else if (e.subtype == DENSE_COL_MATRIX_TYPE)
+            {
+              viennacl::matrix_base<NumericT, viennacl::column_major> const & mat = accessor::matrix_col(e);
+              offset      = viennacl::traits::start1(mat) + viennacl::traits::start2(mat) * mat.internal_size1();
+              line_stride = viennacl::traits::stride2(mat) * mat.internal_size1();
+              stride      = viennacl::traits::stride1(mat);
+              num_lines   = mat.size2();
+              line_length = mat.size1();
+            }
+            else
+              return false;
+
+            if (&e == &result_)
+            {
+              program_.num_lines   = num_lines;
+              program_.line_length = line_length;
+              return true;
+            }
+            return num_lines == program_.num_lines && line_length == program_.line_length && memory_type(e) == memory_type_;
+          }
+
+          /** @brief Compiles the subtree or leaf 'e' into instructions. The value is available in 'result' afterwards. */
+          bool compile(lhs_rhs_element const & e, typename program_type::operand & result)
+          {
+            if (e.type_family == SCALAR_TYPE_FAMILY)
+            {
+              if (e.numeric_type != result_.numeric_type)
+                return false;
+              result.type  = viennacl::linalg::host_based::FUSED_SCALAR_OPERAND;
+              result.index = 0;
+              result.value = accessor::value(e);
+              return true;
+            }
+
+            if (e.type_family == VECTOR_TYPE_FAMILY || e.type_family == MATRIX_TYPE_FAMILY)
+            {
+              if (program_.num_leaves == program_type::max_leaves)
+                return false;
+
+              typename program_type::leaf & leaf = program_.leaves[program_.num_leaves];
+              if (!describe_leaf(e, leaf.offset, leaf.line_stride, leaf.stride))
+                return false;
+              leaf.data   = (memory_type_ == viennacl::MAIN_MEMORY) ? raw_pointer(e) : NULL;
+              leaf.buffer = 0;
+              if (leaf.stride != 1)
+                leaf.buffer = program_.num_buffers++; //offset by the number of registers later
+
+              result.type  = viennacl::linalg::host_based::FUSED_LEAF_OPERAND;
+              result.index = program_.num_leaves++;
+              result.value = 0;
+              return true;
+            }
+
+            if (e.type_family != COMPOSITE_OPERATION_FAMILY)
+              return false;
+
+            statement_node const & node = s_.array()[e.node_index];
+            if (!is_fusable_operation(node.op.type) || program_.num_instructions == program_type::max_instructions)
+              return false;
+
+            typename program_type::instruction inst;
+            inst.op = node.op.type;
+            inst.rhs.type  = viennacl::linalg::host_based::FUSED_SCALAR_OPERAND;
+            inst.rhs.index = 0;
+            inst.rhs.value = 0;
+
+            std::size_t first_register = next_register_;
+            if (!compile(node.lhs, inst.lhs))
+              return false;
+            if (node.op.type_family == OPERATION_BINARY_TYPE_FAMILY && !compile(node.rhs, inst.rhs))
+              return false;
+
+            // scalars are only supported as factors or divisors, all other operands are vectors or matrices:
+            bool lhs_is_scalar = (inst.lhs.type == viennacl::linalg::host_based::FUSED_SCALAR_OPERAND);
+            bool rhs_is_scalar = (node.op.type_family == OPERATION_BINARY_TYPE_FAMILY) && (inst.rhs.type == viennacl::linalg::host_based::FUSED_SCALAR_OPERAND);
+            if (node.op.type == OPERATION_BINARY_MULT_TYPE)
+            {
+              if (lhs_is_scalar == rhs_is_scalar)
+                return false;
+            }
+            else if (node.op.type == OPERATION_BINARY_DIV_TYPE)
+            {
+              if (lhs_is_scalar || !rhs_is_scalar)
+                return false;
+            }
+            else if (lhs_is_scalar || rhs_is_scalar)
+              return false;
+
+            record_source(e.node_index, true,  inst.lhs, lhs_is_scalar);
+            if (node.op.type_family == OPERATION_BINARY_TYPE_FAMILY)
+              record_source(e.node_index, false, inst.rhs, rhs_is_scalar);
+
+            // registers of the operands are released, the result is computed in place:
+            next_register_ = first_register;
+            inst.result = next_register_++;
+            max_registers_ = std::max(max_registers_, next_register_);
+
+            program_.instructions[program_.num_instructions++] = inst;
+
+            result.type  = viennacl::linalg::host_based::FUSED_REGISTER_OPERAND;
+            result.index = inst.result;
+            result.value = 0;
+            return true;
+          }
+
+          /** @brief Remembers where a leaf or scalar operand of the instruction to be added next is located in the statement */
+          void record_source(std::size_t node_index, bool is_lhs, typename program_type::operand const & op, bool is_scalar)
+          {
+            if (!is_scalar && op.type != viennacl::linalg::host_based::FUSED_LEAF_OPERAND)
+              return;
+
+            fused_operand_source source;
+            source.node_index         = node_index;
+            source.is_lhs             = is_lhs;
+            source.is_scalar          = is_scalar;
+            source.index              = is_scalar ? program_.num_instructions : op.index;
+            source.is_instruction_lhs = is_lhs;
+            sources_.push_back(source);
+          }
+
+          statement const & s_;
+          lhs_rhs_element const & result_;
+          viennacl::memory_types memory_type_;
+          program_type program_;
+          std::vector<fused_operand_source> sources_;
+          std::size_t next_register_;
+          std::size_t max_registers_;
+      };
+
+
+      /** @brief Evaluates x = RHS, x += RHS, or x -= RHS in a single pass if RHS is an element-wise expression which would otherwise require temporaries.
+      *
+      * @return false if the statement is not handled, in which case the caller has to evaluate it recursively
+      */
+      template <typename NumericT>
+      bool execute_fused_impl(statement const & s, statement_node const & root_node)
+      {
+        fused_elementwise_builder<NumericT> builder(s, root_node.lhs);
+        if (!builder.build(root_node.op.type, root_node.rhs))
+          return false;
+
+        if (builder.memory() == viennacl::MAIN_MEMORY)
+        {
+#ifdef VIENNACL_WITH_HOST_JIT
+          // compiled kernel, same statement structure reuses the cached shared object. If no kernel can be compiled or loaded, the statement is interpreted:
+          try
+          {
+            if (viennacl::generator::host::generate_enqueue_statement(s, root_node))
+              return true;
+          }
+          catch (viennacl::generator::host::jit_exception const &) {}
+#endif
+          viennacl::linalg::host_based::fused_elementwise(builder.program());
+          return true;
+        }
+
+#ifdef VIENNACL_WITH_OPENCL
+        if (builder.memory() == viennacl::OPENCL_MEMORY)
+        {
+          // the generator emits the whole tree into one kernel. Vectorized loads would require sizes divisible by the vector width, hence scalar loads are used.
+          viennacl::generator::code_generator gen;
+          if (root_node.lhs.type_family == VECTOR_TYPE_FAMILY)
+            gen.force_profile(std::make_pair(viennacl::generator::VECTOR_SAXPY_TYPE, sizeof(NumericT)), viennacl::generator::vector_saxpy(1, 128, 128, true));
+          if (!gen.add(s, root_node))
+            return false;
+          viennacl::generator::enqueue(gen);
+          return true;
+        }
+#endif
+
+        return false;
+      }
+
+      inline bool execute_fused(statement const & s, statement_node const & root_node)
+      {
+        if (   root_node.rhs.type_family != COMPOSITE_OPERATION_FAMILY
+            || (root_node.lhs.type_family != VECTOR_TYPE_FAMILY && root_node.lhs.type_family != MATRIX_TYPE_FAMILY)
+            || (   root_node.op.type != OPERATION_BINARY_ASSIGN_TYPE
+                && root_node.op.type != OPERATION_BINARY_INPLACE_ADD_TYPE
+                && root_node.op.type != OPERATION_BINARY_INPLACE_SUB_TYPE))
+          return false;
+
+        // statements mapped to a single kernel already are not altered:
+        statement_node const & leaf = s.array()[root_node.rhs.node_index];
+        if (!is_fusable_operation(leaf.op.type) || !needs_temporaries(s, leaf))
+          return false;
+
+        switch (root_node.lhs.numeric_type)
+        {
+          case FLOAT_TYPE:
+            return execute_fused_impl<float>(s, root_node);
+          case DOUBLE_TYPE:
+            return execute_fused_impl<double>(s, root_node);
+          default:
+            return false;
+        }
+      }
+
+    } // namespace detail
+  } // namespace scheduler
+} // namespace viennacl
+
+#endif
+
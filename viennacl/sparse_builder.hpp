@@ -0,0 +1,403 @@
+#ifndef VIENNACL_SPARSE_BUILDER_HPP_
+#define VIENNACL_SPARSE_BUILDER_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/sparse_builder.hpp
+    @brief Assembly of a compressed_matrix from (row, column, value) triplets supplied concurrently by multiple threads.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cassert>
+
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/backend/memory.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+  namespace detail
+  {
+    /** @brief Returns the number of threads available for assembly, i.e. the default number of triplet buffers of a sparse_builder */
+    inline std::size_t sparse_builder_num_threads()
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      return static_cast<std::size_t>(omp_get_max_threads());
+#else
+      return 1;
+#endif
+    }
+
+    /** @brief Returns the number of chunks for a parallel counting sort of n keys into the supplied number of buckets.
+    *
+    * Each chunk requires a histogram over all buckets, so the number of chunks is limited such that the histograms do not exceed the size of the input.
+    */
+    inline std::size_t sparse_builder_num_chunks(std::size_t n, std::size_t num_buckets)
+    {
+      return std::max<std::size_t>(1, std::min<std::size_t>(sparse_builder_num_threads(), n / std::max<std::size_t>(1, num_buckets)));
+    }
+  }
+
+
+  /** @brief Assembles a compressed_matrix from (row, column, value) triplets in coordinate (COO) format.
+  *
+  * Each thread appends triplets to its own buffer, so no synchronization is required during assembly.
+  * Triplets with the same row and column index are summed up, as is common for finite element assembly.
+  *
+  * finalize() sorts the triplets by a parallel counting sort (i.e. a single-digit radix sort) on the row indices, followed by a sort of the few entries within each row by column index.
+  * Duplicates are then summed up and written to the CSR arrays of the matrix.
+  * The resulting sparsity pattern is kept, so that a subsequent assembly with the same sequence of (row, column) indices in each buffer
+  * (e.g. a new time step of a finite element simulation) can be transferred by reassemble() without sorting again.
+  *
+  * @tparam NumericT    The floating point type (either float or double)
+  */
+  template <typename NumericT>
+  class sparse_builder
+  {
+    public:
+      /** @brief Creates a builder for a matrix with the supplied number of rows and columns.
+      *
+      * @param rows          Number of rows of the matrix
+      * @param cols          Number of columns of the matrix
+      * @param num_buffers   Number of triplet buffers. Defaults to the number of OpenMP threads, such that add() can be called from within parallel regions.
+      */
+      sparse_builder(std::size_t rows, std::size_t cols, std::size_t num_buffers = viennacl::detail::sparse_builder_num_threads())
+        : rows_(rows), cols_(cols), buffers_(std::max<std::size_t>(1, num_buffers)) {}
+
+      /** @brief Reserves memory for the supplied number of triplets in each buffer */
+      void reserve(std::size_t triplets_per_buffer)
+      {
+        for (std::size_t i=0; i<buffers_.size(); ++i)
+        {
+          buffers_[i].rows.reserve(triplets_per_buffer);
+          buffers_[i].cols.reserve(triplets_per_buffer);
+          buffers_[i].values.reserve(triplets_per_buffer);
+        }
+      }
+
+      /** @brief Adds the value to the entry (row, col) of the matrix. Within an OpenMP parallel region, the buffer of the calling thread is used. */
+      void add(unsigned int row, unsigned int col, NumericT value)
+      {
+#ifdef VIENNACL_WITH_OPENMP
+        add(static_cast<std::size_t>(omp_get_thread_num()), row, col, value);
+#else
+        add(0, row, col, value);
+#endif
+      }
+
+      /** @brief Adds the value to the entry (row, col) of the matrix using the supplied buffer. Different threads must use different buffers. */
+      void add(std::size_t buffer_id, unsigned int row, unsigned int col, NumericT value)
+      {
+        assert(buffer_id < buffers_.size() && bool("Error in sparse_builder::add(): Buffer index out of range!"));
+        assert(row < rows_ && col < cols_ && bool("Error in sparse_builder::add(): Entry index out of range!"));
+
+        triplet_buffer & buffer = buffers_[buffer_id];
+        buffer.rows.push_back(row);
+        buffer.cols.push_back(col);
+        buffer.values.push_back(value);
+      }
+
+      /** @brief Returns the number of rows */
+      std::size_t size1() const { return rows_; }
+      /** @brief Returns the number of columns */
+      std::size_t size2() const { return cols_; }
+      /** @brief Returns the number of triplet buffers */
+      std::size_t num_buffers() const { return buffers_.size(); }
+
+      /** @brief Returns the number of triplets added since the last call to finalize(), reassemble() or clear() */
+      std::size_t num_triplets() const
+      {
+        std::size_t result = 0;
+        for (std::size_t i=0; i<buffers_.size(); ++i)
+          result += buffers_[i].rows.size();
+        return result;
+      }
+
+      /** @brief Returns true if finalize() has been called, such that reassemble() can be used */
+      bool has_pattern() const { return entry_offsets_.size() > 0; }
+
+      /** @brief Returns the number of nonzeros of the sparsity pattern determined by the last call to finalize() */
+      std::size_t nnz() const { return has_pattern() ? entry_offsets_.size() - 1 : 0; }
+
+      /** @brief Discards all triplets, but keeps the sparsity pattern */
+      void clear()
+      {
+        for (std::size_t i=0; i<buffers_.size(); ++i)
+        {
+          buffers_[i].rows.clear();
+          buffers_[i].cols.clear();
+          buffers_[i].values.clear();
+        }
+      }
+
+      /** @brief Sorts the triplets, sums up duplicates and writes the result to the supplied matrix.
+      *
+      *  The sparsity pattern is stored for later use with reassemble(). All triplets are discarded afterwards.
+      */
+      void finalize(viennacl::compressed_matrix<NumericT> & gpu_matrix)
+      {
+        if (num_triplets() == 0)
+          add(0, 0, 0, NumericT(0)); //enforces nonzero array sizes
+
+        std::vector<std::size_t> buffer_offsets = get_buffer_offsets();
+        std::size_t num_triplets = buffer_offsets.back();
+        assert(num_triplets <= std::numeric_limits<unsigned int>::max() && bool("Error in sparse_builder::finalize(): Too many triplets!"));
+
+        std::size_t num_chunks = viennacl::detail::sparse_builder_num_chunks(num_triplets, rows_);
+        std::size_t chunk_size = (num_triplets - 1) / num_chunks + 1;
+
+        // histogram of row indices for each chunk:
+        std::vector<std::size_t> offsets(num_chunks * rows_);
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (num_chunks > 1)
+#endif
+        for (long c = 0; c < static_cast<long>(num_chunks); ++c)
+        {
+          std::size_t * chunk_offsets = &offsets[static_cast<std::size_t>(c) * rows_];
+          std::size_t begin = static_cast<std::size_t>(c) * chunk_size;
+          std::size_t end   = std::min<std::size_t>(num_triplets, begin + chunk_size);
+          std::size_t b = first_buffer(buffer_offsets, begin);
+          for (std::size_t i = begin; i < end; ++i)
+          {
+            while (i >= buffer_offsets[b+1])
+              ++b;
+            ++chunk_offsets[buffers_[b].rows[i - buffer_offsets[b]]];
+          }
+        }
+
+        // exclusive scan in row-major order, such that the sort is stable:
+        std::vector<std::size_t> row_begin(rows_ + 1);
+        std::size_t offset = 0;
+        for (std::size_t row = 0; row < rows_; ++row)
+        {
+          row_begin[row] = offset;
+          for (std::size_t c = 0; c < num_chunks; ++c)
+          {
+            std::size_t count = offsets[c * rows_ + row];
+            offsets[c * rows_ + row] = offset;
+            offset += count;
+          }
+        }
+        row_begin[rows_] = offset;
+
+        // scatter triplets to their rows:
+        std::vector<unsigned int> sorted_cols(num_triplets);
+        std::vector<NumericT>     sorted_values(num_triplets);
+        permutation_.resize(num_triplets);
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (num_chunks > 1)
+#endif
+        for (long c = 0; c < static_cast<long>(num_chunks); ++c)
+        {
+          std::size_t * chunk_offsets = &offsets[static_cast<std::size_t>(c) * rows_];
+          std::size_t begin = static_cast<std::size_t>(c) * chunk_size;
+          std::size_t end   = std::min<std::size_t>(num_triplets, begin + chunk_size);
+          std::size_t b = first_buffer(buffer_offsets, begin);
+          for (std::size_t i = begin; i < end; ++i)
+          {
+            while (i >= buffer_offsets[b+1])
+              ++b;
+            triplet_buffer const & buffer = buffers_[b];
+            std::size_t local_index = i - buffer_offsets[b];
+            std::size_t pos = chunk_offsets[buffer.rows[local_index]]++;
+            sorted_cols[pos]   = buffer.cols[local_index];
+            sorted_values[pos] = buffer.values[local_index];
+            permutation_[pos]  = static_cast<unsigned int>(i);
+          }
+        }
+
+        // stable insertion sort by column index within each row (rows are short), then count the distinct columns:
+        std::vector<unsigned int> row_nonzeros(rows_);
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long r = 0; r < static_cast<long>(rows_); ++r)
+        {
+          std::size_t row = static_cast<std::size_t>(r);
+          for (std::size_t i = row_begin[row] + 1; i < row_begin[row+1]; ++i)
+          {
+            unsigned int col   = sorted_cols[i];
+            NumericT     value = sorted_values[i];
+            unsigned int index = permutation_[i];
+            std::size_t j = i;
+            for (; j > row_begin[row] && sorted_cols[j-1] > col; --j)
+            {
+              sorted_cols[j]   = sorted_cols[j-1];
+              sorted_values[j] = sorted_values[j-1];
+              permutation_[j]  = permutation_[j-1];
+            }
+            sorted_cols[j]   = col;
+            sorted_values[j] = value;
+            permutation_[j]  = index;
+          }
+
+          unsigned int count = 0;
+          for (std::size_t i = row_begin[row]; i < row_begin[row+1]; ++i)
+            if (i == row_begin[row] || sorted_cols[i] != sorted_cols[i-1])
+              ++count;
+          row_nonzeros[row] = count;
+        }
+
+        // row array:
+        viennacl::backend::typesafe_host_array<unsigned int> row_buffer(gpu_matrix.handle1(), rows_ + 1);
+        std::vector<std::size_t> row_jumper(rows_ + 1);
+        for (std::size_t row = 0; row < rows_; ++row)
+        {
+          row_jumper[row+1] = row_jumper[row] + row_nonzeros[row];
+          row_buffer.set(row, row_jumper[row]);
+        }
+        row_buffer.set(rows_, row_jumper[rows_]);
+
+        std::size_t nonzeros = row_jumper[rows_];
+        assert(nonzeros <= std::numeric_limits<unsigned int>::max() && bool("Error in sparse_builder::finalize(): Too many nonzeros!"));
+
+        // column and value arrays, summing up duplicates:
+        viennacl::backend::typesafe_host_array<unsigned int> col_buffer(gpu_matrix.handle2(), nonzeros);
+        std::vector<NumericT> elements(nonzeros);
+        entry_offsets_.resize(nonzeros + 1);
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long r = 0; r < static_cast<long>(rows_); ++r)
+        {
+          std::size_t row = static_cast<std::size_t>(r);
+          std::size_t entry = row_jumper[row];
+          for (std::size_t i = row_begin[row]; i < row_begin[row+1]; ++i)
+          {
+            if (i == row_begin[row] || sorted_cols[i] != sorted_cols[i-1])
+            {
+              entry_offsets_[entry] = static_cast<unsigned int>(i);
+              col_buffer.set(entry, sorted_cols[i]);
+              elements[entry] = sorted_values[i];
+              ++entry;
+            }
+            else
+              elements[entry - 1] += sorted_values[i];
+          }
+        }
+        entry_offsets_[nonzeros] = static_cast<unsigned int>(num_triplets);
+
+        gpu_matrix.set(row_buffer.get(), col_buffer.get(), &elements[0], rows_, cols_, nonzeros);
+
+        clear();
+      }
+
+      /** @brief Sums up the triplets and writes the values to a matrix with the sparsity pattern determined by the last call to finalize().
+      *
+      *  Each buffer must hold the same sequence of (row, column) indices as during the call to finalize(), only the values may differ.
+      *  No sorting is required, the values are directly summed into the nonzeros of the matrix. All triplets are discarded afterwards.
+      */
+      void reassemble(viennacl::compressed_matrix<NumericT> & gpu_matrix)
+      {
+        assert(has_pattern() && bool("Error in sparse_builder::reassemble(): No sparsity pattern available, call finalize() first!"));
+        assert(gpu_matrix.size1() == rows_ && gpu_matrix.size2() == cols_ && gpu_matrix.nnz() == nnz() && bool("Error in sparse_builder::reassemble(): Matrix does not match sparsity pattern!"));
+
+        std::vector<std::size_t> buffer_offsets = get_buffer_offsets();
+        assert(buffer_offsets.back() == permutation_.size() && bool("Error in sparse_builder::reassemble(): Number of triplets differs from finalize()!"));
+
+        // concatenate values of all buffers:
+        std::vector<NumericT> values(buffer_offsets.back());
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long b = 0; b < static_cast<long>(buffers_.size()); ++b)
+          std::copy(buffers_[static_cast<std::size_t>(b)].values.begin(), buffers_[static_cast<std::size_t>(b)].values.end(),
+                    values.begin() + static_cast<long>(buffer_offsets[static_cast<std::size_t>(b)]));
+
+#ifndef NDEBUG
+        check_pattern(gpu_matrix, buffer_offsets);
+#endif
+
+        // each nonzero is owned by one thread, so no atomics are required:
+        std::vector<NumericT> elements(nnz());
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long e = 0; e < static_cast<long>(elements.size()); ++e)
+        {
+          NumericT sum = 0;
+          for (std::size_t i = entry_offsets_[static_cast<std::size_t>(e)]; i < entry_offsets_[static_cast<std::size_t>(e) + 1]; ++i)
+            sum += values[permutation_[i]];
+          elements[static_cast<std::size_t>(e)] = sum;
+        }
+
+        viennacl::backend::memory_write(gpu_matrix.handle(), 0, sizeof(NumericT) * elements.size(), &elements[0]);
+
+        clear();
+      }
+
+    private:
+      struct triplet_buffer
+      {
+        std::vector<unsigned int> rows;
+        std::vector<unsigned int> cols;
+        std::vector<NumericT>     values;
+      };
+
+      /** @brief Returns the offsets of the buffers when concatenated. The last entry is the total number of triplets. */
+      std::vector<std::size_t> get_buffer_offsets() const
+      {
+        std::vector<std::size_t> buffer_offsets(buffers_.size() + 1);
+        for (std::size_t i=0; i<buffers_.size(); ++i)
+          buffer_offsets[i+1] = buffer_offsets[i] + buffers_[i].rows.size();
+        return buffer_offsets;
+      }
+
+      /** @brief Returns the buffer holding the triplet with the supplied index in the concatenated buffers */
+      static std::size_t first_buffer(std::vector<std::size_t> const & buffer_offsets, std::size_t index)
+      {
+        return static_cast<std::size_t>(std::upper_bound(buffer_offsets.begin(), buffer_offsets.end(), index) - buffer_offsets.begin()) - 1;
+      }
+
+      /** @brief Checks that the row and column indices of the triplets match the sparsity pattern of the matrix (used in debug mode only) */
+      void check_pattern(viennacl::compressed_matrix<NumericT> const & gpu_matrix, std::vector<std::size_t> const & buffer_offsets) const
+      {
+        viennacl::backend::typesafe_host_array<unsigned int> row_buffer(gpu_matrix.handle1(), rows_ + 1);
+        viennacl::backend::typesafe_host_array<unsigned int> col_buffer(gpu_matrix.handle2(), nnz());
+        viennacl::backend::memory_read(gpu_matrix.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+        viennacl::backend::memory_read(gpu_matrix.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+
+        for (std::size_t row = 0; row < rows_; ++row)
+          for (std::size_t entry = row_buffer[row]; entry < row_buffer[row+1]; ++entry)
+            for (std::size_t i = entry_offsets_[entry]; i < entry_offsets_[entry+1]; ++i)
+            {
+              std::size_t b = first_buffer(buffer_offsets, permutation_[i]);
+              std::size_t local_index = permutation_[i] - buffer_offsets[b];
+              assert(buffers_[b].rows[local_index] == row && buffers_[b].cols[local_index] == col_buffer[entry]
+                     && bool("Error in sparse_builder::reassemble(): Triplet indices differ from finalize()!"));
+            }
+      }
+
+      std::size_t rows_;
+      std::size_t cols_;
+      std::vector<triplet_buffer> buffers_;
+
+      // sparsity pattern: the triplets permutation_[entry_offsets_[e]], ..., permutation_[entry_offsets_[e+1] - 1] contribute to the e-th nonzero
+      std::vector<unsigned int> permutation_;
+      std::vector<unsigned int> entry_offsets_;
+  };
+
+}
+
+#endif
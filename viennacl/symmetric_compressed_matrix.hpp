@@ -0,0 +1,583 @@
+#ifndef VIENNACL_SYMMETRIC_COMPRESSED_MATRIX_HPP_
+#define VIENNACL_SYMMETRIC_COMPRESSED_MATRIX_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/symmetric_compressed_matrix.hpp
+    @brief Implementation of the symmetric_compressed_matrix class (CSR format holding only the upper triangular part of a symmetric matrix)
+*/
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/tools/adapter.hpp"
+
+namespace viennacl
+{
+    namespace detail
+    {
+      /** @brief Returns the number of rows per row block used for the conflict-free matrix-vector product in the respective memory domain
+      *
+      * On the host, large blocks of contiguous rows preserve cache locality, while about 256 blocks still provide enough parallelism within each color.
+      * On OpenCL and CUDA devices, each row is processed by a group of threads, cf. symmetric_compressed_matrix::threads_per_row().
+      */
+      inline std::size_t symmetric_compressed_matrix_block_size(viennacl::memory_types mem_type, std::size_t rows)
+      {
+        if (mem_type == viennacl::MAIN_MEMORY)
+          return std::max<std::size_t>(256, rows / 256);
+        return 1;
+      }
+
+      /** @brief Greedy coloring of row blocks such that no two blocks of the same color write to the same entry of the result vector.
+      *
+      * A block writes to its own rows (contributions of the upper triangle) and to the rows given by the column indices of its entries (contributions of the lower triangle).
+      *
+      * @param upper            The upper triangular part of the matrix, one map per row
+      * @param block_size       Number of rows per block
+      * @param blocks_by_color  The block indices, sorted by color (output)
+      * @param color_offsets    Blocks of color c are given by blocks_by_color[color_offsets[c]], ..., blocks_by_color[color_offsets[c+1] - 1] (output)
+      */
+      template <typename SCALARTYPE>
+      void symmetric_compressed_matrix_coloring(std::vector< std::map<unsigned int, SCALARTYPE> > const & upper,
+                                                std::size_t block_size,
+                                                std::vector<unsigned int> & blocks_by_color,
+                                                std::vector<std::size_t> & color_offsets)
+      {
+        std::size_t rows = upper.size();
+        std::size_t num_blocks = (rows + block_size - 1) / block_size;
+
+        std::vector< std::vector<std::size_t> > row_colors(rows);  //colors of the blocks writing to each row
+        std::vector<std::size_t> block_color(num_blocks);
+        std::vector<std::size_t> forbidden;                        //forbidden[c] == b+1 if color c is in use by a block conflicting with block b
+        std::size_t num_colors = 0;
+
+        for (std::size_t b = 0; b < num_blocks; ++b)
+        {
+          std::size_t row_begin = b * block_size;
+          std::size_t row_end   = std::min(row_begin + block_size, rows);
+
+          for (std::size_t row = row_begin; row < row_end; ++row)
+          {
+            for (std::size_t k = 0; k < row_colors[row].size(); ++k)
+              forbidden[row_colors[row][k]] = b + 1;
+            for (typename std::map<unsigned int, SCALARTYPE>::const_iterator it = upper[row].begin(); it != upper[row].end(); ++it)
+              for (std::size_t k = 0; k < row_colors[it->first].size(); ++k)
+                forbidden[row_colors[it->first][k]] = b + 1;
+          }
+
+          std::size_t color = 0;
+          while (color < num_colors && forbidden[color] == b + 1)
+            ++color;
+          if (color == num_colors)
+          {
+            forbidden.push_back(0);
+            ++num_colors;
+          }
+          block_color[b] = color;
+
+          for (std::size_t row = row_begin; row < row_end; ++row)
+          {
+            if (row_colors[row].size() == 0 || row_colors[row].back() != color)
+              row_colors[row].push_back(color);
+            for (typename std::map<unsigned int, SCALARTYPE>::const_iterator it = upper[row].begin(); it != upper[row].end(); ++it)
+              if (row_colors[it->first].size() == 0 || row_colors[it->first].back() != color)
+                row_colors[it->first].push_back(color);
+          }
+        }
+
+        // sort blocks by color (counting sort keeps the blocks of each color in ascending order):
+        color_offsets.assign(num_colors + 1, 0);
+        for (std::size_t b = 0; b < num_blocks; ++b)
+          ++color_offsets[block_color[b] + 1];
+        for (std::size_t c = 0; c < num_colors; ++c)
+          color_offsets[c+1] += color_offsets[c];
+
+        std::vector<std::size_t> insert_pos(color_offsets.begin(), color_offsets.end() - 1);
+        blocks_by_color.resize(num_blocks);
+        for (std::size_t b = 0; b < num_blocks; ++b)
+          blocks_by_color[insert_pos[block_color[b]]++] = static_cast<unsigned int>(b);
+      }
+
+      template <typename CPU_MATRIX, typename SCALARTYPE>
+      void copy_impl(const CPU_MATRIX & cpu_matrix,
+                     symmetric_compressed_matrix<SCALARTYPE> & gpu_matrix)
+      {
+        assert( (cpu_matrix.size1() == cpu_matrix.size2()) && bool("Symmetric matrix must be square!") );
+
+        // collect upper triangular part, mirroring entries from the lower triangular part:
+        std::vector< std::map<unsigned int, SCALARTYPE> > upper(cpu_matrix.size1());
+        for (typename CPU_MATRIX::const_iterator1 row_it = cpu_matrix.begin1();
+              row_it != cpu_matrix.end1();
+              ++row_it)
+        {
+          for (typename CPU_MATRIX::const_iterator2 col_it = row_it.begin();
+                col_it != row_it.end();
+                ++col_it)
+          {
+            SCALARTYPE entry = *col_it;
+            if (entry != SCALARTYPE(0))
+            {
+              if (col_it.index2() >= col_it.index1())
+                upper[col_it.index1()][static_cast<unsigned int>(col_it.index2())] = entry;
+              else
+                upper[col_it.index2()][static_cast<unsigned int>(col_it.index1())] = entry;
+            }
+          }
+        }
+
+        std::size_t nonzeros = 0;
+        for (std::size_t i=0; i<upper.size(); ++i)
+          nonzeros += upper[i].size();
+        std::size_t num_entries = std::max<std::size_t>(nonzeros, 1); //we copy an empty matrix
+
+        std::size_t block_size = symmetric_compressed_matrix_block_size(viennacl::traits::context(gpu_matrix.handle1()).memory_type(), upper.size());
+        std::vector<unsigned int> blocks_by_color;
+        std::vector<std::size_t> color_offsets;
+        symmetric_compressed_matrix_coloring(upper, block_size, blocks_by_color, color_offsets);
+
+        viennacl::backend::typesafe_host_array<unsigned int> row_buffer(gpu_matrix.handle1(), upper.size() + 1);
+        viennacl::backend::typesafe_host_array<unsigned int> col_buffer(gpu_matrix.handle2(), num_entries);
+        viennacl::backend::typesafe_host_array<unsigned int> block_buffer(gpu_matrix.handle3(), blocks_by_color.size());
+        std::vector<SCALARTYPE> elements(num_entries);
+
+        std::size_t data_index = 0;
+        for (std::size_t i=0; i<upper.size(); ++i)
+        {
+          row_buffer.set(i, data_index);
+          for (typename std::map<unsigned int, SCALARTYPE>::const_iterator it = upper[i].begin(); it != upper[i].end(); ++it)
+          {
+            col_buffer.set(data_index, it->first);
+            elements[data_index] = it->second;
+            ++data_index;
+          }
+        }
+        row_buffer.set(upper.size(), data_index);
+
+        for (std::size_t i=0; i<blocks_by_color.size(); ++i)
+          block_buffer.set(i, blocks_by_color[i]);
+
+        gpu_matrix.set(row_buffer.get(),
+                       col_buffer.get(),
+                       &elements[0],
+                       block_buffer.get(),
+                       color_offsets,
+                       cpu_matrix.size1(),
+                       num_entries,
+                       block_size);
+      }
+    }
+
+    //provide copy-operation:
+    /** @brief Copies a symmetric sparse matrix from the host to the OpenCL device (either GPU or multi-core CPU)
+    *
+    * The host matrix may hold either both triangular parts, only the upper triangular part, or only the lower triangular part (each including the diagonal).
+    * Entries in the lower triangular part are mirrored to the upper triangular part, so the host matrix is assumed to be symmetric if both parts are present.
+    *
+    * There are some type requirements on the CPU_MATRIX type (fulfilled by e.g. boost::numeric::ublas):
+    * - .size1() returns the number of rows
+    * - .size2() returns the number of columns
+    * - const_iterator1    is a type definition for an iterator along increasing row indices
+    * - const_iterator2    is a type definition for an iterator along increasing columns indices
+    * - The const_iterator1 type provides an iterator of type const_iterator2 via members .begin() and .end() that iterates along column indices in the current row.
+    * - The types const_iterator1 and const_iterator2 provide members functions .index1() and .index2() that return the current row and column indices respectively.
+    * - Dereferenciation of an object of type const_iterator2 returns the entry.
+    *
+    * @param cpu_matrix   A sparse square matrix on the host.
+    * @param gpu_matrix   A symmetric_compressed_matrix from ViennaCL
+    */
+    template <typename CPU_MATRIX, typename SCALARTYPE>
+    void copy(const CPU_MATRIX & cpu_matrix,
+              symmetric_compressed_matrix<SCALARTYPE> & gpu_matrix )
+    {
+      assert( (gpu_matrix.size1() == 0 || cpu_matrix.size1() == gpu_matrix.size1()) && bool("Size mismatch") );
+      assert( (gpu_matrix.size2() == 0 || cpu_matrix.size2() == gpu_matrix.size2()) && bool("Size mismatch") );
+
+      if ( cpu_matrix.size1() > 0 && cpu_matrix.size2() > 0 )
+        viennacl::detail::copy_impl(cpu_matrix, gpu_matrix);
+    }
+
+
+    //adapted for std::vector< std::map < > > argument:
+    /** @brief Copies a symmetric sparse matrix in the std::vector< std::map < > > format to an OpenCL device. Either both or only one triangular part may be provided.
+    *
+    * @param cpu_matrix   A sparse square matrix on the host using STL types
+    * @param gpu_matrix   A symmetric_compressed_matrix from ViennaCL
+    */
+    template <typename SizeType, typename SCALARTYPE>
+    void copy(const std::vector< std::map<SizeType, SCALARTYPE> > & cpu_matrix,
+              symmetric_compressed_matrix<SCALARTYPE> & gpu_matrix )
+    {
+      copy(tools::const_sparse_matrix_adapter<SCALARTYPE, SizeType>(cpu_matrix, cpu_matrix.size(), cpu_matrix.size()), gpu_matrix);
+    }
+
+
+    //
+    // gpu to cpu:
+    //
+    /** @brief Copies a symmetric sparse matrix from the OpenCL device (either GPU or multi-core CPU) to the host. Both triangular parts are written.
+    *
+    * There are two type requirements on the CPU_MATRIX type (fulfilled by e.g. boost::numeric::ublas):
+    * - resize(rows, cols)  A resize function to bring the matrix into the correct size
+    * - operator(i,j)       Write new entries via the parenthesis operator
+    *
+    * @param gpu_matrix   A symmetric_compressed_matrix from ViennaCL
+    * @param cpu_matrix   A sparse matrix on the host.
+    */
+    template <typename CPU_MATRIX, typename SCALARTYPE>
+    void copy(const symmetric_compressed_matrix<SCALARTYPE> & gpu_matrix,
+              CPU_MATRIX & cpu_matrix )
+    {
+      assert( (cpu_matrix.size1() == 0 || cpu_matrix.size1() == gpu_matrix.size1()) && bool("Size mismatch") );
+      assert( (cpu_matrix.size2() == 0 || cpu_matrix.size2() == gpu_matrix.size2()) && bool("Size mismatch") );
+
+      if ( gpu_matrix.size1() > 0 && gpu_matrix.size2() > 0 )
+      {
+        if (cpu_matrix.size1() == 0 || cpu_matrix.size2() == 0)
+          cpu_matrix.resize(gpu_matrix.size1(), gpu_matrix.size2(), false);
+
+        //get raw data from memory:
+        viennacl::backend::typesafe_host_array<unsigned int> row_buffer(gpu_matrix.handle1(), gpu_matrix.size1() + 1);
+        viennacl::backend::typesafe_host_array<unsigned int> col_buffer(gpu_matrix.handle2(), gpu_matrix.nnz());
+        std::vector<SCALARTYPE> elements(gpu_matrix.nnz());
+
+        viennacl::backend::memory_read(gpu_matrix.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+        viennacl::backend::memory_read(gpu_matrix.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+        viennacl::backend::memory_read(gpu_matrix.handle(),  0, sizeof(SCALARTYPE)* gpu_matrix.nnz(), &(elements[0]));
+
+        //fill the cpu_matrix:
+        for (std::size_t row = 0; row < gpu_matrix.size1(); ++row)
+        {
+          for (std::size_t i = row_buffer[row]; i < row_buffer[row+1]; ++i)
+          {
+            if (col_buffer[i] >= gpu_matrix.size2())
+            {
+              std::cerr << "ViennaCL encountered invalid data at colbuffer[" << i << "]: " << col_buffer[i] << std::endl;
+              return;
+            }
+
+            if (elements[i] != static_cast<SCALARTYPE>(0.0))
+            {
+              cpu_matrix(row, col_buffer[i]) = elements[i];
+              cpu_matrix(col_buffer[i], row) = elements[i];
+            }
+          }
+        }
+      }
+    }
+
+
+    /** @brief Copies a symmetric sparse matrix from an OpenCL device to the host. The host type is the std::vector< std::map < > > format, both triangular parts are written.
+    *
+    * @param gpu_matrix   A symmetric_compressed_matrix from ViennaCL
+    * @param cpu_matrix   A sparse matrix on the host.
+    */
+    template <typename SCALARTYPE>
+    void copy(const symmetric_compressed_matrix<SCALARTYPE> & gpu_matrix,
+              std::vector< std::map<unsigned int, SCALARTYPE> > & cpu_matrix)
+    {
+      if (cpu_matrix.size() == 0)
+        cpu_matrix.resize(gpu_matrix.size1());
+
+      assert(cpu_matrix.size() == gpu_matrix.size1() && bool("Size mismatch"));
+
+      tools::sparse_matrix_adapter<SCALARTYPE> temp(cpu_matrix, gpu_matrix.size1(), gpu_matrix.size2());
+      copy(gpu_matrix, temp);
+    }
+
+
+    //////////////////////// symmetric_compressed_matrix //////////////////////////
+    /** @brief A sparse symmetric matrix in compressed sparse rows format, where only the upper triangular part (including the diagonal) is stored.
+    *
+    * Compared to compressed_matrix, the memory footprint and the memory traffic of a matrix-vector product are reduced by almost a factor of two.
+    * In order to avoid write conflicts when accumulating the contributions of the lower triangular part in parallel,
+    * the rows are grouped into blocks, which are colored such that blocks of the same color write to disjoint entries of the result vector.
+    * The matrix-vector product then processes one color after another, with all blocks of the same color processed in parallel.
+    *
+    * @tparam SCALARTYPE    The floating point type (either float or double, checked at compile time)
+    */
+    template<class SCALARTYPE>
+    class symmetric_compressed_matrix
+    {
+      public:
+        typedef viennacl::backend::mem_handle                                                              handle_type;
+        typedef scalar<typename viennacl::tools::CHECK_SCALAR_TEMPLATE_ARGUMENT<SCALARTYPE>::ResultType>   value_type;
+        typedef vcl_size_t                                                                                 size_type;
+
+        /** @brief Default construction of a symmetric compressed matrix. No memory is allocated */
+        symmetric_compressed_matrix() : rows_(0), nonzeros_(0), block_size_(1) {}
+
+        /** @brief Construction of a symmetric compressed matrix with the supplied number of rows and columns. No memory is allocated until the matrix entries are set via copy().
+        *
+        * @param rows     Number of rows
+        * @param cols     Number of columns (must be equal to the number of rows)
+        * @param ctx      Context in which to create the matrix. Uses the default context if omitted
+        */
+        explicit symmetric_compressed_matrix(std::size_t rows, std::size_t cols, viennacl::context ctx = viennacl::context())
+          : rows_(rows), nonzeros_(0), block_size_(1)
+        {
+          assert( (rows == cols) && bool("Symmetric matrix must be square!") );
+          (void)cols;
+          init_handles(ctx);
+        }
+
+        explicit symmetric_compressed_matrix(viennacl::context ctx) : rows_(0), nonzeros_(0), block_size_(1)
+        {
+          init_handles(ctx);
+        }
+
+        /** @brief Assignment a symmetric compressed matrix from possibly another memory domain. */
+        symmetric_compressed_matrix & operator=(symmetric_compressed_matrix const & other)
+        {
+          assert( (rows_ == 0 || rows_ == other.size1()) && bool("Size mismatch") );
+
+          rows_ = other.size1();
+          nonzeros_ = other.nnz();
+          block_size_ = other.block_size();
+          color_offsets_ = other.color_offsets();
+
+          viennacl::backend::typesafe_memory_copy<unsigned int>(other.row_buffer_,   row_buffer_);
+          viennacl::backend::typesafe_memory_copy<unsigned int>(other.col_buffer_,   col_buffer_);
+          viennacl::backend::typesafe_memory_copy<unsigned int>(other.block_buffer_, block_buffer_);
+          viennacl::backend::typesafe_memory_copy<SCALARTYPE>(other.elements_, elements_);
+
+          return *this;
+        }
+
+
+        /** @brief Sets the row, column and value arrays of the upper triangular part as well as the row block coloring
+        *
+        * @param row_jumper     Pointer to an array holding the indices of the first element of each row (starting with zero). The array length is 'rows + 1'
+        * @param col_buffer     Pointer to an array holding the column index of each entry, which must not be smaller than the row index. The array length is 'nonzeros'
+        * @param elements       Pointer to an array holding the entries of the upper triangular part. The array length is 'nonzeros'
+        * @param block_buffer   Pointer to an array holding the indices of the row blocks sorted by color. The array length is the number of row blocks
+        * @param color_offsets  The blocks of color c are given by the entries color_offsets[c], ..., color_offsets[c+1] - 1 in block_buffer
+        * @param rows           Number of rows (and columns) of the sparse matrix
+        * @param nonzeros       Total number of nonzero entries in the upper triangular part
+        * @param block_size     Number of rows per row block
+        */
+        void set(const void * row_jumper,
+                 const void * col_buffer,
+                 const SCALARTYPE * elements,
+                 const void * block_buffer,
+                 std::vector<std::size_t> const & color_offsets,
+                 std::size_t rows,
+                 std::size_t nonzeros,
+                 std::size_t block_size)
+        {
+          assert( (rows > 0)       && bool("Error in symmetric_compressed_matrix::set(): Number of rows must be larger than zero!"));
+          assert( (nonzeros > 0)   && bool("Error in symmetric_compressed_matrix::set(): Number of nonzeros must be larger than zero!"));
+          assert( (block_size > 0) && bool("Error in symmetric_compressed_matrix::set(): Block size must be larger than zero!"));
+
+          std::size_t num_blocks = (rows + block_size - 1) / block_size;
+
+          viennacl::backend::memory_create(row_buffer_,   viennacl::backend::typesafe_host_array<unsigned int>(row_buffer_).element_size() * (rows + 1),    viennacl::traits::context(row_buffer_),   row_jumper);
+          viennacl::backend::memory_create(col_buffer_,   viennacl::backend::typesafe_host_array<unsigned int>(col_buffer_).element_size() * nonzeros,      viennacl::traits::context(col_buffer_),   col_buffer);
+          viennacl::backend::memory_create(block_buffer_, viennacl::backend::typesafe_host_array<unsigned int>(block_buffer_).element_size() * num_blocks, viennacl::traits::context(block_buffer_), block_buffer);
+          viennacl::backend::memory_create(elements_, sizeof(SCALARTYPE) * nonzeros, viennacl::traits::context(elements_), elements);
+
+          rows_ = rows;
+          nonzeros_ = nonzeros;
+          block_size_ = block_size;
+          color_offsets_ = color_offsets;
+        }
+
+        /** @brief  Returns the number of rows */
+        const std::size_t & size1() const { return rows_; }
+        /** @brief  Returns the number of columns */
+        const std::size_t & size2() const { return rows_; }
+        /** @brief  Returns the number of stored nonzero entries (i.e. in the upper triangular part including the diagonal) */
+        const std::size_t & nnz() const { return nonzeros_; }
+
+        /** @brief  Returns the number of rows per row block */
+        std::size_t block_size() const { return block_size_; }
+        /** @brief  Returns the number of threads sharing the entries of a row in the matrix-vector product on OpenCL and CUDA devices.
+        *
+        * This is the smallest power of two not less than the average number of stored entries per row, at most 32.
+        */
+        std::size_t threads_per_row() const
+        {
+          std::size_t entries_per_row = (rows_ > 0) ? (nonzeros_ + rows_ - 1) / rows_ : 1;
+          std::size_t result = 1;
+          while (result < entries_per_row && result < 32)
+            result *= 2;
+          return result;
+        }
+        /** @brief  Returns the number of colors of the row blocks */
+        std::size_t num_colors() const { return color_offsets_.size() > 0 ? color_offsets_.size() - 1 : 0; }
+        /** @brief  Returns the offsets of each color in the array of row blocks referred to by handle3() */
+        std::vector<std::size_t> const & color_offsets() const { return color_offsets_; }
+
+        /** @brief  Returns the OpenCL handle to the row index array */
+        const handle_type & handle1() const { return row_buffer_; }
+        /** @brief  Returns the OpenCL handle to the column index array */
+        const handle_type & handle2() const { return col_buffer_; }
+        /** @brief  Returns the OpenCL handle to the array of row blocks sorted by color */
+        const handle_type & handle3() const { return block_buffer_; }
+        /** @brief  Returns the OpenCL handle to the matrix entry array */
+        const handle_type & handle() const { return elements_; }
+
+        /** @brief  Returns the OpenCL handle to the row index array */
+        handle_type & handle1() { return row_buffer_; }
+        /** @brief  Returns the OpenCL handle to the column index array */
+        handle_type & handle2() { return col_buffer_; }
+        /** @brief  Returns the OpenCL handle to the array of row blocks sorted by color */
+        handle_type & handle3() { return block_buffer_; }
+        /** @brief  Returns the OpenCL handle to the matrix entry array */
+        handle_type & handle() { return elements_; }
+
+        void switch_memory_context(viennacl::context new_ctx)
+        {
+          viennacl::backend::switch_memory_context<unsigned int>(row_buffer_, new_ctx);
+          viennacl::backend::switch_memory_context<unsigned int>(col_buffer_, new_ctx);
+          viennacl::backend::switch_memory_context<unsigned int>(block_buffer_, new_ctx);
+          viennacl::backend::switch_memory_context<SCALARTYPE>(elements_, new_ctx);
+        }
+
+        viennacl::memory_types memory_context() const
+        {
+          return row_buffer_.get_active_handle_id();
+        }
+
+      private:
+        void init_handles(viennacl::context ctx)
+        {
+          row_buffer_.switch_active_handle_id(ctx.memory_type());
+          col_buffer_.switch_active_handle_id(ctx.memory_type());
+          block_buffer_.switch_active_handle_id(ctx.memory_type());
+            elements_.switch_active_handle_id(ctx.memory_type());
+
+#ifdef VIENNACL_WITH_OPENCL
+          if (ctx.memory_type() == OPENCL_MEMORY)
+          {
+            row_buffer_.opencl_handle().context(ctx.opencl_context());
+            col_buffer_.opencl_handle().context(ctx.opencl_context());
+            block_buffer_.opencl_handle().context(ctx.opencl_context());
+              elements_.opencl_handle().context(ctx.opencl_context());
+          }
+#endif
+        }
+
+        std::size_t rows_;
+        std::size_t nonzeros_;
+        std::size_t block_size_;
+        std::vector<std::size_t> color_offsets_;
+        handle_type row_buffer_;
+        handle_type col_buffer_;
+        handle_type block_buffer_;
+        handle_type elements_;
+    };
+
+
+
+    //
+    // Specify available operations:
+    //
+
+    namespace linalg
+    {
+      namespace detail
+      {
+        // x = A * y
+        template <typename T>
+        struct op_executor<vector_base<T>, op_assign, vector_expression<const symmetric_compressed_matrix<T>, const vector_base<T>, op_prod> >
+        {
+            static void apply(vector_base<T> & lhs, vector_expression<const symmetric_compressed_matrix<T>, const vector_base<T>, op_prod> const & rhs)
+            {
+              // check for the special case x = A * x
+              if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+              {
+                viennacl::vector<T> temp(rhs.lhs().size1(), viennacl::traits::context(rhs));
+                viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+                lhs = temp;
+              }
+              else
+                viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), lhs);
+            }
+        };
+
+        template <typename T>
+        struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const symmetric_compressed_matrix<T>, const vector_base<T>, op_prod> >
+        {
+            static void apply(vector_base<T> & lhs, vector_expression<const symmetric_compressed_matrix<T>, const vector_base<T>, op_prod> const & rhs)
+            {
+              viennacl::vector<T> temp(rhs.lhs().size1(), viennacl::traits::context(rhs));
+              viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+              lhs += temp;
+            }
+        };
+
+        template <typename T>
+        struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const symmetric_compressed_matrix<T>, const vector_base<T>, op_prod> >
+        {
+            static void apply(vector_base<T> & lhs, vector_expression<const symmetric_compressed_matrix<T>, const vector_base<T>, op_prod> const & rhs)
+            {
+              viennacl::vector<T> temp(rhs.lhs().size1(), viennacl::traits::context(rhs));
+              viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+              lhs -= temp;
+            }
+        };
+
+
+        // x = A * vec_op
+        template <typename T, typename LHS, typename RHS, typename OP>
+        struct op_executor<vector_base<T>, op_assign, vector_expression<const symmetric_compressed_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+        {
+            static void apply(vector_base<T> & lhs, vector_expression<const symmetric_compressed_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+            {
+              viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+              viennacl::linalg::prod_impl(rhs.lhs(), temp, lhs);
+            }
+        };
+
+        // x += A * vec_op
+        template <typename T, typename LHS, typename RHS, typename OP>
+        struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const symmetric_compressed_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+        {
+            static void apply(vector_base<T> & lhs, vector_expression<const symmetric_compressed_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+            {
+              viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+              viennacl::vector<T> temp_result(lhs.size(), viennacl::traits::context(rhs));
+              viennacl::linalg::prod_impl(rhs.lhs(), temp, temp_result);
+              lhs += temp_result;
+            }
+        };
+
+        // x -= A * vec_op
+        template <typename T, typename LHS, typename RHS, typename OP>
+        struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const symmetric_compressed_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+        {
+            static void apply(vector_base<T> & lhs, vector_expression<const symmetric_compressed_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+            {
+              viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+              viennacl::vector<T> temp_result(lhs.size(), viennacl::traits::context(rhs));
+              viennacl::linalg::prod_impl(rhs.lhs(), temp, temp_result);
+              lhs -= temp_result;
+            }
+        };
+
+     } // namespace detail
+   } // namespace linalg
+}
+
+#endif
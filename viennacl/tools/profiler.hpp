@@ -0,0 +1,428 @@
+#ifndef VIENNACL_TOOLS_PROFILER_HPP_
+#define VIENNACL_TOOLS_PROFILER_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/tools/profiler.hpp
+    @brief Optional profiling of the operations dispatched to the compute backends.
+
+    Enabled by defining VIENNACL_WITH_PROFILING. Otherwise VIENNACL_PROFILE_OPERATION expands to nothing and instrumented code is unchanged.
+    With profiling compiled in, nothing is recorded until current_profiler().enable() is called, so a disabled profiler costs one branch per operation.
+
+    Each operation is recorded with its name, backend, sizes, modeled memory traffic and floating point operations, and wall time.
+    Operations on OpenCL and CUDA, as well as tasks of the asynchronous host executor, complete asynchronously: Their wall time only covers
+    the submission unless synchronize(true) is set. On OpenCL, each kernel is additionally recorded with its device time obtained from OpenCL events.
+    This requires command queues created with CL_QUEUE_PROFILING_ENABLE, which is the case for queues created by ViennaCL when profiling is compiled in.
+
+    The profiler is not thread-safe: Operations are expected to be issued from a single thread.
+*/
+
+#ifdef VIENNACL_WITH_PROFILING
+
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <ostream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/tools/timer.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+#ifdef __APPLE__
+#include <OpenCL/cl.h>
+#else
+#include <CL/cl.h>
+#endif
+#endif
+
+#ifdef VIENNACL_WITH_CUDA
+#include <cuda_runtime.h>
+#endif
+
+#ifdef VIENNACL_WITH_HOST_ASYNC
+#include "viennacl/backend/host_executor.hpp"
+#endif
+
+namespace viennacl
+{
+  namespace tools
+  {
+
+    /** @brief A recorded operation or OpenCL kernel. Traffic and operation counts are zero where no model is available. */
+    struct profiler_record
+    {
+      profiler_record() : size1(0), size2(0), bytes(0), flops(0), start(0), duration(0), depth(0) {}
+
+      std::string name;
+      std::string backend;   //"host", "opencl", "cuda", or "opencl-device" for kernels timed by OpenCL events
+      std::size_t size1;
+      std::size_t size2;
+      double bytes;
+      double flops;
+      double start;          //seconds since the last reset
+      double duration;       //seconds
+      std::size_t depth;     //nesting level, 0 for operations called directly by the user
+    };
+
+    inline std::string profiler_backend_name(viennacl::memory_types memory_type)
+    {
+      switch (memory_type)
+      {
+        case viennacl::MAIN_MEMORY:   return "host";
+        case viennacl::OPENCL_MEMORY: return "opencl";
+        case viennacl::CUDA_MEMORY:   return "cuda";
+        default:                      return "unknown";
+      }
+    }
+
+    /** @brief Collects the records of profiled operations. Use current_profiler() to obtain the instance used by ViennaCL. */
+    class profiler
+    {
+      public:
+        profiler() : enabled_(false), synchronize_(false), depth_(0) { timer_.start(); }
+
+        ~profiler() { release_events(); }
+
+        /** @brief Starts (or stops) recording */
+        void enable(bool b = true) { enabled_ = b; }
+        void disable() { enabled_ = false; }
+        bool enabled() const { return enabled_; }
+
+        /** @brief If set, each operation waits for the completion of the backend, such that the wall time includes the execution of asynchronous operations */
+        void synchronize(bool b) { synchronize_ = b; }
+        bool synchronizes() const { return synchronize_; }
+
+        /** @brief Discards all records and restarts the time line */
+        void reset()
+        {
+          release_events();
+          records_.clear();
+          timer_.start();
+        }
+
+        /** @brief Returns all records. Waits for pending OpenCL kernels. */
+        std::vector<profiler_record> const & records()
+        {
+          resolve_events(true);
+          return records_;
+        }
+
+        /** @brief Writes a table with the time spent per operation and backend, sorted by total time */
+        void dump(std::ostream & os = std::cout)
+        {
+          resolve_events(true);
+
+          entry_map entries;
+          double top_level_time = 0;
+          for (std::size_t i = 0; i < records_.size(); ++i)
+          {
+            profiler_record const & r = records_[i];
+            entries[entry_key(r.name, r.backend)].add(r);
+            if (r.depth == 0 && r.backend != "opencl-device")
+              top_level_time += r.duration;
+          }
+
+          std::vector< std::pair<double, entry_key> > order;
+          for (entry_map::const_iterator it = entries.begin(); it != entries.end(); ++it)
+            order.push_back(std::make_pair(-it->second.total, it->first));
+          std::sort(order.begin(), order.end());
+
+          std::ios::fmtflags flags = os.flags();
+          std::streamsize precision = os.precision();
+          os << "ViennaCL profile: " << records_.size() << " records, " << top_level_time * 1e3 << " ms in operations called by the user" << std::endl;
+          os << std::left << std::setw(28) << "operation" << std::setw(15) << "backend" << std::right
+             << std::setw(8) << "calls" << std::setw(13) << "total [ms]" << std::setw(12) << "mean [us]" << std::setw(12) << "min [us]" << std::setw(12) << "max [us]"
+             << std::setw(10) << "GB/s" << std::setw(10) << "GFLOP/s" << std::setw(9) << "share" << std::endl;
+          os << std::fixed;
+          for (std::size_t i = 0; i < order.size(); ++i)
+          {
+            entry const & e = entries[order[i].second];
+            os << std::left << std::setw(28) << order[i].second.first << std::setw(15) << order[i].second.second << std::right
+               << std::setw(8) << e.calls
+               << std::setw(13) << std::setprecision(3) << e.total * 1e3
+               << std::setw(12) << std::setprecision(2) << e.total / static_cast<double>(e.calls) * 1e6
+               << std::setw(12) << e.min * 1e6
+               << std::setw(12) << e.max * 1e6;
+            if (e.bytes > 0 && e.total > 0) os << std::setw(10) << e.bytes / e.total * 1e-9; else os << std::setw(10) << "-";
+            if (e.flops > 0 && e.total > 0) os << std::setw(10) << e.flops / e.total * 1e-9; else os << std::setw(10) << "-";
+            if (top_level_time > 0)         os << std::setw(8) << std::setprecision(1) << 100.0 * e.total / top_level_time << "%"; else os << std::setw(9) << "-";
+            os << std::endl;
+          }
+          os.flags(flags);
+          os.precision(precision);
+        }
+
+        /** @brief Writes all records in the Chrome trace event format (JSON), which can be loaded in chrome://tracing or Perfetto */
+        void write_chrome_trace(std::ostream & os)
+        {
+          resolve_events(true);
+
+          std::streamsize precision = os.precision();
+          os.precision(15);
+          os << "{\"traceEvents\": [" << std::endl;
+          os << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, \"args\": {\"name\": \"ViennaCL operations\"}}," << std::endl;
+          os << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 2, \"args\": {\"name\": \"OpenCL device\"}}";
+          for (std::size_t i = 0; i < records_.size(); ++i)
+          {
+            profiler_record const & r = records_[i];
+            os << "," << std::endl
+               << "{\"name\": " << json_string(r.name) << ", \"cat\": " << json_string(r.backend) << ", \"ph\": \"X\""
+               << ", \"ts\": " << r.start * 1e6 << ", \"dur\": " << r.duration * 1e6
+               << ", \"pid\": 1, \"tid\": " << (r.backend == "opencl-device" ? 2 : 1)
+               << ", \"args\": {\"size1\": " << r.size1 << ", \"size2\": " << r.size2 << ", \"bytes\": " << r.bytes << ", \"flops\": " << r.flops << "}}";
+          }
+          os << std::endl << "], \"displayTimeUnit\": \"ms\"}" << std::endl;
+          os.precision(precision);
+        }
+
+        //
+        // Interface for the instrumentation
+        //
+
+        /** @brief Seconds since the last reset */
+        double now() const { return timer_.get(); }
+
+        std::size_t enter() { return depth_++; }
+
+        void leave(profiler_record const & r)
+        {
+          --depth_;
+          records_.push_back(r);
+        }
+
+        /** @brief Waits for the completion of the operations issued to the backend */
+        void wait(viennacl::memory_types memory_type)
+        {
+          switch (memory_type)
+          {
+#ifdef VIENNACL_WITH_HOST_ASYNC
+            case viennacl::MAIN_MEMORY:
+              viennacl::backend::current_host_executor().wait_all();
+              break;
+#endif
+#ifdef VIENNACL_WITH_OPENCL
+            case viennacl::OPENCL_MEMORY:
+              if (!events_.empty())
+                clWaitForEvents(1, &(events_.back().event));
+              break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+            case viennacl::CUDA_MEMORY:
+              cudaDeviceSynchronize();
+              break;
+#endif
+            default:
+              break;
+          }
+        }
+
+#ifdef VIENNACL_WITH_OPENCL
+        /** @brief Records an enqueued OpenCL kernel. The profiler takes ownership of the event. */
+        void add_kernel_event(std::string const & name, cl_event event)
+        {
+          kernel_event e;
+          e.name = name;
+          e.event = event;
+          e.host_time = now();
+          e.depth = depth_;
+          events_.push_back(e);
+
+          if (events_.size() > 1024)  //limit the number of pending events without blocking
+            resolve_events(false);
+        }
+#endif
+
+      private:
+        struct entry
+        {
+          entry() : calls(0), total(0), min(0), max(0), bytes(0), flops(0) {}
+
+          void add(profiler_record const & r)
+          {
+            min = calls ? std::min(min, r.duration) : r.duration;
+            max = std::max(max, r.duration);
+            ++calls;
+            total += r.duration;
+            bytes += r.bytes;
+            flops += r.flops;
+          }
+
+          std::size_t calls;
+          double total, min, max, bytes, flops;
+        };
+        typedef std::pair<std::string, std::string> entry_key;   //operation and backend
+        typedef std::map<entry_key, entry>          entry_map;
+
+        static std::string json_string(std::string const & s)
+        {
+          std::string result = "\"";
+          for (std::size_t i = 0; i < s.size(); ++i)
+          {
+            if (s[i] == '"' || s[i] == '\\')
+              result += '\\';
+            if (static_cast<unsigned char>(s[i]) >= 0x20)
+              result += s[i];
+          }
+          return result + "\"";
+        }
+
+#ifdef VIENNACL_WITH_OPENCL
+        struct kernel_event
+        {
+          std::string name;
+          cl_event event;
+          double host_time;   //time of submission
+          std::size_t depth;
+        };
+
+        /** @brief Converts completed kernel events to records. Kernels are placed on the host time line relative to their submission. */
+        void resolve_events(bool wait)
+        {
+          std::vector<kernel_event> pending;
+          for (std::size_t i = 0; i < events_.size(); ++i)
+          {
+            kernel_event & e = events_[i];
+            if (wait)
+              clWaitForEvents(1, &e.event);
+            else
+            {
+              cl_int status = CL_COMPLETE;
+              clGetEventInfo(e.event, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(cl_int), &status, NULL);
+              if (status > CL_COMPLETE)
+              {
+                pending.push_back(e);
+                continue;
+              }
+            }
+
+            cl_ulong queued = 0, start = 0, end = 0;
+            if (   clGetEventProfilingInfo(e.event, CL_PROFILING_COMMAND_QUEUED, sizeof(cl_ulong), &queued, NULL) == CL_SUCCESS
+                && clGetEventProfilingInfo(e.event, CL_PROFILING_COMMAND_START,  sizeof(cl_ulong), &start,  NULL) == CL_SUCCESS
+                && clGetEventProfilingInfo(e.event, CL_PROFILING_COMMAND_END,    sizeof(cl_ulong), &end,    NULL) == CL_SUCCESS)
+            {
+              profiler_record r;
+              r.name     = e.name;
+              r.backend  = "opencl-device";
+              r.start    = e.host_time + static_cast<double>(start - queued) * 1e-9;
+              r.duration = static_cast<double>(end - start) * 1e-9;
+              r.depth    = e.depth;
+              records_.push_back(r);
+            }
+            clReleaseEvent(e.event);
+          }
+          events_.swap(pending);
+        }
+
+        void release_events()
+        {
+          for (std::size_t i = 0; i < events_.size(); ++i)
+            clReleaseEvent(events_[i].event);
+          events_.clear();
+        }
+#else
+        void resolve_events(bool) {}
+        void release_events() {}
+#endif
+
+        bool enabled_;
+        bool synchronize_;
+        std::size_t depth_;
+        viennacl::tools::timer timer_;
+        std::vector<profiler_record> records_;
+#ifdef VIENNACL_WITH_OPENCL
+        std::vector<kernel_event> events_;
+#endif
+    };
+
+    /** @brief Returns the profiler recording the operations of ViennaCL */
+    inline profiler & current_profiler()
+    {
+      static profiler p;
+      return p;
+    }
+
+    /** @brief Records an operation from construction to destruction if the profiler is enabled. Use through VIENNACL_PROFILE_OPERATION. */
+    class profiler_scope
+    {
+      public:
+        profiler_scope(char const * name, viennacl::memory_types memory_type, std::size_t size1, std::size_t size2, double bytes, double flops)
+          : profiler_(current_profiler().enabled() ? &current_profiler() : NULL), name_(name), memory_type_(memory_type),
+            size1_(size1), size2_(size2), bytes_(bytes), flops_(flops), start_(0), depth_(0)
+        {
+          if (profiler_)
+          {
+            depth_ = profiler_->enter();
+            start_ = profiler_->now();
+          }
+        }
+
+        ~profiler_scope()
+        {
+          if (!profiler_)
+            return;
+
+          if (profiler_->synchronizes())
+            profiler_->wait(memory_type_);
+
+          profiler_record r;
+          r.name     = name_;
+          r.backend  = profiler_backend_name(memory_type_);
+          r.size1    = size1_;
+          r.size2    = size2_;
+          r.bytes    = bytes_;
+          r.flops    = flops_;
+          r.start    = start_;
+          r.duration = profiler_->now() - start_;
+          r.depth    = depth_;
+          profiler_->leave(r);
+        }
+
+      private:
+        profiler_scope(profiler_scope const &);
+        profiler_scope & operator=(profiler_scope const &);
+
+        profiler * profiler_;
+        char const * name_;
+        viennacl::memory_types memory_type_;
+        std::size_t size1_;
+        std::size_t size2_;
+        double bytes_;
+        double flops_;
+        double start_;
+        std::size_t depth_;
+    };
+
+  } //namespace tools
+} //namespace viennacl
+
+/** @brief Records the enclosing scope as operation NAME on the backend of the memory handle HANDLE. BYTES and FLOPS are the modeled memory traffic and floating point operations. */
+#define VIENNACL_PROFILE_OPERATION(NAME, HANDLE, SIZE1, SIZE2, BYTES, FLOPS) \
+  viennacl::tools::profiler_scope viennacl_profiler_scope_((NAME), (HANDLE).get_active_handle_id(), (SIZE1), (SIZE2), static_cast<double>(BYTES), static_cast<double>(FLOPS))
+
+#else
+
+#define VIENNACL_PROFILE_OPERATION(NAME, HANDLE, SIZE1, SIZE2, BYTES, FLOPS)
+
+#endif
+
+#endif
@@ -36,8 +36,14 @@ namespace viennacl
       {
         public:
           count(unsigned int val) : val_(val){ }
-          void dec(){ --val_; }
+#ifdef VIENNACL_WITH_HOST_ASYNC
+          // shared pointers are copied and released concurrently by the worker threads of viennacl::backend::host_executor
+          unsigned int dec(){ return __sync_sub_and_fetch(&val_, 1u); }
+          void inc(){ __sync_add_and_fetch(&val_, 1u); }
+#else
+          unsigned int dec(){ return --val_; }
           void inc(){ ++val_; }
+#endif
           bool is_null(){ return val_ == 0; }
           unsigned int val(){ return val_; }
         private:
@@ -136,9 +142,7 @@ namespace viennacl
         {
           if(pa)
           {
-            pa->count.dec();
-
-            if(pa->count.is_null())
+            if(pa->count.dec() == 0)
             {
                 pa->destroy();
                 delete pa;
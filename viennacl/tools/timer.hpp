@@ -67,11 +67,14 @@ namespace viennacl{
 #else
 
 #include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
 
 namespace viennacl{
 
   namespace tools{
 
+    /** @brief Wall clock timer. Uses the monotonic clock where available, which is not affected by adjustments of the system time. */
     class timer
     {
     public:
@@ -81,21 +84,28 @@ namespace viennacl{
 
       void start()
       {
-        struct timeval tval;
-        gettimeofday(&tval, NULL);
-        ts = tval.tv_sec * 1000000 + tval.tv_usec;
+        ts = now();
       }
 
       double get() const
       {
+        return now() - ts;
+      }
+
+    private:
+      static double now()
+      {
+#if defined(_POSIX_TIMERS) && (_POSIX_TIMERS > 0) && defined(CLOCK_MONOTONIC)
+        struct timespec tspec;
+        clock_gettime(CLOCK_MONOTONIC, &tspec);
+        return static_cast<double>(tspec.tv_sec) + static_cast<double>(tspec.tv_nsec) / 1000000000.0;
+#else
         struct timeval tval;
         gettimeofday(&tval, NULL);
-        double end_time = tval.tv_sec * 1000000 + tval.tv_usec;
-
-        return static_cast<double>(end_time-ts) / 1000000.0;
+        return static_cast<double>(tval.tv_sec) + static_cast<double>(tval.tv_usec) / 1000000.0;
+#endif
       }
 
-    private:
       double ts;
     };
 
@@ -32,7 +32,7 @@
 #include "viennacl/linalg/detail/op_executor.hpp"
 #include "viennacl/linalg/vector_operations.hpp"
 #include "viennacl/meta/result_of.hpp"
-//#include "viennacl/rand/utils.hpp"
+#include "viennacl/rand/utils.hpp"
 #include "viennacl/context.hpp"
 #include "viennacl/traits/handle.hpp"
 
@@ -133,12 +133,15 @@ namespace viennacl
   };
 
 
-//#ifdef VIENNACL_WITH_OPENCL
-//  template<class SCALARTYPE, class DISTRIBUTION>
-//  rand::random_vector_t<SCALARTYPE, DISTRIBUTION> random_vector(unsigned int size, DISTRIBUTION const & distribution){
-//      return rand::random_vector_t<SCALARTYPE,DISTRIBUTION>(size,distribution);
-//  }
-//#endif
+  /** @brief Returns a proxy for a vector of the given size filled with random numbers from the distribution (e.g. rand::uniform_tag, rand::gaussian_tag)
+  *
+  * The header of the distribution (e.g. viennacl/rand/uniform.hpp) needs to be included.
+  */
+  template<class SCALARTYPE, class DISTRIBUTION>
+  rand::random_vector_t<SCALARTYPE, DISTRIBUTION> random_vector(vcl_size_t size, DISTRIBUTION const & distribution, viennacl::context ctx = viennacl::context())
+  {
+    return rand::random_vector_t<SCALARTYPE,DISTRIBUTION>(size, distribution, ctx);
+  }
 
 
   //
@@ -444,17 +447,6 @@ namespace viennacl
       }
 #endif
 
-      /** @brief Creates the vector from the supplied random vector. */
-      /*template<class DISTRIBUTION>
-      vector(rand::random_vector_t<SCALARTYPE, DISTRIBUTION> v) : size_(v.size)
-      {
-        if(size_ > 0)
-        {
-          viennacl::backend::memory_create(elements_, sizeof(SCALARTYPE)*internal_size());
-          rand::buffer_dumper<SCALARTYPE, DISTRIBUTION>::dump(elements_,v.distribution,0,size_);
-        }
-      } */
-
       template <typename LHS, typename RHS, typename OP>
       explicit vector_base(vector_expression<const LHS, const RHS, OP> const & proxy)
         : size_(viennacl::traits::size(proxy)), start_(0), stride_(1), internal_size_(viennacl::tools::align_to_multiple<size_type>(size_, alignment))
@@ -1072,6 +1064,14 @@ namespace viennacl
         viennacl::linalg::vector_assign(*this, v[0]);
     }
 
+    /** @brief Creates the vector from the supplied random vector. */
+    template<class DISTRIBUTION>
+    vector(rand::random_vector_t<SCALARTYPE, DISTRIBUTION> const & v) : base_type(v.size, v.ctx)
+    {
+      if (v.size > 0)
+        rand::buffer_dumper<SCALARTYPE, DISTRIBUTION>::dump(*this, v.distribution);
+    }
+
     // the following is used to circumvent an issue with Clang 3.0 when 'using base_type::operator=;' directly
     template <typename T>
     self_type & operator=(T const & other)
@@ -2289,7 +2289,8 @@ namespace viennacl
 
           if (op_aliasing_lhs || op_aliasing_rhs)
           {
-            vector_base<T> temp(proxy.lhs());
+            vector_base<T> temp(viennacl::traits::size(lhs), viennacl::traits::context(lhs)); // deep copy, temp must not share the buffer of proxy.lhs()
+            op_executor<vector_base<T>, op_assign, LHS>::apply(temp, proxy.lhs());
             op_executor<vector_base<T>, op_inplace_add, RHS>::apply(temp, proxy.rhs());
             lhs = temp;
           }
@@ -2403,7 +2404,8 @@ namespace viennacl
 
           if (op_aliasing_lhs || op_aliasing_rhs)
           {
-            vector_base<T> temp(proxy.lhs());
+            vector_base<T> temp(viennacl::traits::size(lhs), viennacl::traits::context(lhs)); // deep copy, temp must not share the buffer of proxy.lhs()
+            op_executor<vector_base<T>, op_assign, LHS>::apply(temp, proxy.lhs());
             op_executor<vector_base<T>, op_inplace_add, RHS>::apply(temp, proxy.rhs());
             lhs += temp;
           }
@@ -2526,7 +2528,8 @@ namespace viennacl
 
           if (op_aliasing_lhs || op_aliasing_rhs)
           {
-            vector_base<T> temp(proxy.lhs());
+            vector_base<T> temp(viennacl::traits::size(lhs), viennacl::traits::context(lhs)); // deep copy, temp must not share the buffer of proxy.lhs()
+            op_executor<vector_base<T>, op_assign, LHS>::apply(temp, proxy.lhs());
             op_executor<vector_base<T>, op_inplace_add, RHS>::apply(temp, proxy.rhs());
             lhs -= temp;
           }
@@ -2653,7 +2656,8 @@ namespace viennacl
 
           if (op_aliasing_lhs || op_aliasing_rhs)
           {
-            vector_base<T> temp(proxy.lhs());
+            vector_base<T> temp(viennacl::traits::size(lhs), viennacl::traits::context(lhs)); // deep copy, temp must not share the buffer of proxy.lhs()
+            op_executor<vector_base<T>, op_assign, LHS>::apply(temp, proxy.lhs());
             op_executor<vector_base<T>, op_inplace_sub, RHS>::apply(temp, proxy.rhs());
             lhs = temp;
           }
@@ -2775,7 +2779,8 @@ namespace viennacl
 
           if (op_aliasing_lhs || op_aliasing_rhs)
           {
-            vector_base<T> temp(proxy.lhs());
+            vector_base<T> temp(viennacl::traits::size(lhs), viennacl::traits::context(lhs)); // deep copy, temp must not share the buffer of proxy.lhs()
+            op_executor<vector_base<T>, op_assign, LHS>::apply(temp, proxy.lhs());
             op_executor<vector_base<T>, op_inplace_sub, RHS>::apply(temp, proxy.rhs());
             lhs += temp;
           }
@@ -2898,7 +2903,8 @@ namespace viennacl
 
           if (op_aliasing_lhs || op_aliasing_rhs)
           {
-            vector_base<T> temp(proxy.lhs());
+            vector_base<T> temp(viennacl::traits::size(lhs), viennacl::traits::context(lhs)); // deep copy, temp must not share the buffer of proxy.lhs()
+            op_executor<vector_base<T>, op_assign, LHS>::apply(temp, proxy.lhs());
             op_executor<vector_base<T>, op_inplace_sub, RHS>::apply(temp, proxy.rhs());
             lhs -= temp;
           }